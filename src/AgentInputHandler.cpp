@@ -0,0 +1,72 @@
+#include "AgentInputHandler.h"
+#include "Tank.h"
+#include <algorithm>
+
+namespace
+{
+    float Clamp(float value)
+    {
+        return std::max(-1.0f, std::min(1.0f, value));
+    }
+
+    // Full joystick deflection (32000 / 3200), see GenericJoystickInputHandler
+    constexpr float TURRET_AXIS_SCALE = 10.0f;
+}
+
+void AgentInputHandler::HandleInput(Tank& tank)
+{
+    const float move = Clamp(action.move);
+    const float rotate = Clamp(action.rotate);
+    const float turret = Clamp(action.turret) * TURRET_AXIS_SCALE;
+    const bool purple = (tank.type1 == TankType::TYPE_PURPLE || tank.type2 == TankType::TYPE_PURPLE);
+
+    if (action.fire)
+    {
+        tank.Fire(purple ? turret : 1.0f);
+    }
+
+    if (action.special)
+    {
+        tank.Special(purple ? turret : 1.0f);
+    }
+
+    if (move != 0.0f)
+    {
+        tank.Move(move);
+        if (tank.turbo)
+        {
+            tank.Move(move);
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
+        }
+    }
+
+    if (rotate != 0.0f)
+    {
+        tank.RotBody(rotate);
+        if (tank.turbo)
+        {
+            tank.RotBody(rotate);
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
+        }
+    }
+
+    if (action.jump)
+    {
+        tank.Jump();
+        if (tank.turbo)
+        {
+            tank.Jump();
+        }
+    }
+    else
+    {
+        tank.isJumping = false;
+    }
+
+    if (turret != 0.0f)
+    {
+        tank.RotTurret(turret);
+    }
+
+    tank.turbo = action.turbo && tank.energy > 0;
+}
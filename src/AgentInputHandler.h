@@ -0,0 +1,36 @@
+#pragma once
+
+#include "InputHandler.h"
+
+/**
+ * One frame of tank controls, as a bot or training agent presses them.
+ * Analog axes are in [-1, 1] and map onto the same Tank calls a joystick
+ * drives; buttons map onto the keyboard/mouse bindings. Plain data, so
+ * batches of actions can live in one contiguous array.
+ */
+struct TankAction
+{
+    float move = 0.0f;    // Forward (+) / backward (-)
+    float rotate = 0.0f;  // Body rotation: right (+) / left (-)
+    float turret = 0.0f;  // Turret rotation; also the spin of purple shots
+    bool fire = false;
+    bool special = false;
+    bool jump = false;
+    bool turbo = false;
+};
+
+/**
+ * Input handler driven by TankAction values instead of SDL devices.
+ * The owner writes the next action with SetAction() before each tick.
+ */
+class AgentInputHandler : public InputHandler
+{
+public:
+    void HandleInput(Tank& tank) override;
+
+    void SetAction(const TankAction& newAction) { action = newAction; }
+    const TankAction& GetAction() const { return action; }
+
+private:
+    TankAction action;
+};
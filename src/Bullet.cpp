@@ -19,16 +19,15 @@
 #include "Bullet.h"
 
 #include "SoundTask.h"
-#include "GlobalTimer.h"
 #include "math.h"
 #include "LevelHandler.h"
 #include "TankHandler.h"
 #include "PlayerManager.h"
 #include "Tank.h"
-#include "App.h"
-#include "events/Events.h"
-#include "events/CollisionEvents.h"
 #include "GameWorld.h"
+#include "Logger.h"
+#include "events/CollisionEvents.h"
+#include "combat/BulletSystem.h"
 
 void Bullet::CreateFX(FxType type, float x, float y, float z, float rx, float ry, float rz, float r, float g, float b, float a)
 {
@@ -40,33 +39,19 @@ void Bullet::CreateFX(FxType type, float x, float y, float z, float dx, float dy
     gameWorld->CreateFX(type, x, y, z, dx, dy, dz, rx, ry, rz, r, g, b, a);
 }
 
-void Bullet::CreateWallImpactFX(float xpp, float zpp)
+void Bullet::CreateWallImpactFX(float normalX, float normalZ)
 {
-    // Determine impact orientation based on which axis changed
-    if (static_cast<int>(x + xpp) != static_cast<int>(x) && static_cast<int>(z + zpp) == static_cast<int>(z))
+    // Orient the spark along the wall face that was hit
+    if (normalX != 0.0f)
     {
         // Horizontal wall impact (X-axis)
         CreateFX(FxType::TYPE_SMALL_SQUARE, x, y, z, 0, 0, 0, 0, 0, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
     }
-    else if (static_cast<int>(z + zpp) != static_cast<int>(z) && static_cast<int>(x + xpp) == static_cast<int>(x))
+    else if (normalZ != 0.0f)
     {
         // Vertical wall impact (Z-axis)
         CreateFX(FxType::TYPE_SMALL_SQUARE, x, y, z, 0, 0, 0, 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
     }
-    else if (static_cast<int>(x + xpp) != static_cast<int>(x) && static_cast<int>(z + zpp) != static_cast<int>(z))
-    {
-        // Corner impact - determine primary collision axis
-        if (LevelHandler::GetSingleton().PointCollision((x + xpp), y, z) && !LevelHandler::GetSingleton().PointCollision(x, y, z + zpp))
-        {
-            // X-axis primary
-            CreateFX(FxType::TYPE_SMALL_SQUARE, x, y, z, 0, 0, 0, 0, 0, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
-        }
-        else
-        {
-            // Z-axis primary
-            CreateFX(FxType::TYPE_SMALL_SQUARE, x, y, z, 0, 0, 0, 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
-        }
-    }
 }
 
 Bullet::Bullet()
@@ -133,23 +118,119 @@ Bullet::Bullet(const TankIdentity& ownerIdentity, float power,
     }
 }
 
+Bullet::Bullet(const Bullet& other)
+    : Entity(other)
+{
+    *this = other;
+}
+
+Bullet& Bullet::operator=(const Bullet& other)
+{
+    if (this == &other)
+    {
+        return *this;
+    }
+
+    if (system)
+    {
+        system->Release(this);
+    }
+
+    // Motion state comes from the source's slot if it has one
+    x = other.GetX(); y = other.GetY(); z = other.GetZ();
+    vx = other.vx; vy = other.vy; vz = other.vz;
+    rx = other.rx; ry = other.GetRY(); rz = other.rz;
+    dty = other.GetAngularVelocity();
+    primaryColor = other.primaryColor;
+    secondaryColor = other.secondaryColor;
+    moveRate = other.moveRate;
+    power = other.power;
+    isSpecial = other.isSpecial;
+    id = other.id;
+    ownerIdentity = other.ownerIdentity;
+    type1 = other.type1;
+    type2 = other.type2;
+    dT = other.GetDT();
+    maxdT = other.maxdT;
+    numbounces = other.system ? other.system->bounces[other.slot] : other.numbounces;
+    maxbounces = other.maxbounces;
+    alive = other.alive;
+    gameWorld = other.gameWorld;
+    return *this;
+}
+
+Bullet::~Bullet()
+{
+    if (system)
+    {
+        system->Release(this);
+    }
+}
+
+float Bullet::GetX() const { return system ? system->x[slot] : x; }
+float Bullet::GetY() const { return system ? system->y[slot] : y; }
+float Bullet::GetZ() const { return system ? system->z[slot] : z; }
+float Bullet::GetRY() const { return system ? system->ry[slot] : ry; }
+float Bullet::GetDT() const { return system ? system->age[slot] : dT; }
+float Bullet::GetAngularVelocity() const { return system ? system->dty[slot] : dty; }
+
+void Bullet::LoadState()
+{
+    if (!system)
+    {
+        return;
+    }
+    x = system->x[slot];
+    y = system->y[slot];
+    z = system->z[slot];
+    ry = system->ry[slot];
+    dty = system->dty[slot];
+    dT = system->age[slot];
+    numbounces = system->bounces[slot];
+}
+
+void Bullet::StoreState()
+{
+    if (!system)
+    {
+        return;
+    }
+    system->x[slot] = x;
+    system->y[slot] = y;
+    system->z[slot] = z;
+    system->ry[slot] = ry;
+    system->dty[slot] = dty;
+    system->age[slot] = dT;
+    system->bounces[slot] = numbounces;
+}
+
 void Bullet::NextFrame()
 {
-    dT += GlobalTimer::dT;
+    LoadState();
+    NextFrameState();
+    StoreState();
+}
+
+void Bullet::NextFrameState()
+{
+    const float frameTime = gameWorld->GetDeltaTime();
+    EventBus& bus = gameWorld->GetEventBus();
+
+    dT += frameTime;
 
     if (type1 == TankType::TYPE_PURPLE && isSpecial)
     {
         if (dty < 0)
         {
-            dty -= 1000 * GlobalTimer::dT;
+            dty -= 1000 * frameTime;
         }
         else
         {
-            dty += 1000 * GlobalTimer::dT;
+            dty += 1000 * frameTime;
         }
     }
 
-    ry += GlobalTimer::dT * dty;
+    ry += frameTime * dty;
 
     if (ry > 360)
     {
@@ -164,8 +245,10 @@ void Bullet::NextFrame()
         rz -= 360;
     }
 
-    float xpp = (GlobalTimer::dT * moveRate) * static_cast<float>(cos(ry * DTR));
-    float zpp = (GlobalTimer::dT * moveRate) * static_cast<float>(sin(ry * DTR));
+    float sinRy, cosRy;
+    sinCosDeg(ry, sinRy, cosRy);
+    float xpp = (frameTime * moveRate) * cosRy;
+    float zpp = (frameTime * moveRate) * sinRy;
 
     x += xpp;
     z += zpp;
@@ -174,22 +257,21 @@ void Bullet::NextFrame()
 
     // NEW: Event-based collision detection
     
-    // Check level collision first
-    PointCollisionQuery levelQuery(x, y, z, CollisionLayer::LEVEL, this);
-    Logger::Get().Write("Bullet::CheckForCollisions - Publishing PointCollisionQuery for level at (%.2f, %.2f, %.2f)\n", x, y, z);
-    Events::GetBus().Publish(levelQuery);
-    Logger::Get().Write("Bullet::CheckForCollisions - PointCollisionQuery result=%d\n", levelQuery.result);
+    // Check level collision first, swept over the whole step
+    LevelRaycastQuery levelQuery(x - xpp, y, z - zpp, x, y, z);
+    bus.Publish(levelQuery);
     
     if (levelQuery.result) {
         // Post level collision event for CombatSystem to handle
-        Events::GetBus().Post(BulletLevelCollisionEvent(this, x, y, z, xpp, zpp, ory));
+        bus.Post(BulletLevelCollisionEvent(this, x - xpp * (1.0f - levelQuery.time), y, z - zpp * (1.0f - levelQuery.time),
+                                           xpp, zpp, ory, levelQuery.normalX, levelQuery.normalZ));
         return; // Level collision handling will determine if bullet survives
     }
 
     // Check tank collisions (both players and enemies)
     // Use smaller radius to match original collision detection
     SphereCollisionQuery tankQuery(x, y, z, 0.1f, CollisionLayer::ALL_TANKS, this);
-    Events::GetBus().Publish(tankQuery);
+    bus.Publish(tankQuery);
     
     if (!tankQuery.results.empty()) {
         // Filter out the tank that fired this bullet
@@ -197,11 +279,11 @@ void Bullet::NextFrame()
             Tank* tank = dynamic_cast<Tank*>(entity);
             if (tank && tank->identity != ownerIdentity) {
                 // Found a valid target (not the firing tank)
-                Events::GetBus().Post(BulletCollisionEvent(this, tank, x, y, z));
+                bus.Post(BulletCollisionEvent(this, tank, x, y, z));
                 return; // CombatSystem will handle the collision response
             } else if (tank && tank->identity == ownerIdentity && dT > 0.5f) {
                 // Allow collision with firing tank only after 0.5 seconds (for healing/self-damage)
-                Events::GetBus().Post(BulletCollisionEvent(this, tank, x, y, z));
+                bus.Post(BulletCollisionEvent(this, tank, x, y, z));
                 return;
             }
         }
@@ -210,7 +292,7 @@ void Bullet::NextFrame()
     // Also check the previous position for fast-moving bullets
     if (xpp != 0 || zpp != 0) {
         SphereCollisionQuery prevQuery(x - xpp / 2, y, z - zpp / 2, 0.1f, CollisionLayer::ALL_TANKS, this);
-        Events::GetBus().Publish(prevQuery);
+        bus.Publish(prevQuery);
         
         if (!prevQuery.results.empty()) {
             // Filter out the tank that fired this bullet
@@ -218,11 +300,11 @@ void Bullet::NextFrame()
                 Tank* tank = dynamic_cast<Tank*>(entity);
                 if (tank && tank->identity != ownerIdentity) {
                     // Found a valid target (not the firing tank)
-                    Events::GetBus().Post(BulletCollisionEvent(this, tank, x - xpp / 2, y, z - zpp / 2));
+                    bus.Post(BulletCollisionEvent(this, tank, x - xpp / 2, y, z - zpp / 2));
                     return;
                 } else if (tank && tank->identity == ownerIdentity && dT > 0.5f) {
                     // Allow collision with firing tank only after 0.5 seconds (for healing/self-damage)
-                    Events::GetBus().Post(BulletCollisionEvent(this, tank, x - xpp / 2, y, z - zpp / 2));
+                    bus.Post(BulletCollisionEvent(this, tank, x - xpp / 2, y, z - zpp / 2));
                     return;
                 }
             }
@@ -231,16 +313,16 @@ void Bullet::NextFrame()
 
     // Check bounds
     GetLevelBoundsQuery boundsQuery;
-    Events::GetBus().Publish(boundsQuery);
+    bus.Publish(boundsQuery);
     
     if (x >= boundsQuery.sizeX || x <= 0 || z >= boundsQuery.sizeZ || z <= 0) {
-        Events::GetBus().Post(BulletOutOfBoundsEvent(this, x, y, z));
+        bus.Post(BulletOutOfBoundsEvent(this, x, y, z));
         return;
     }
     
     // Check timeout
     if (dT >= maxdT) {
-        Events::GetBus().Post(BulletTimeoutEvent(this, dT));
+        bus.Post(BulletTimeoutEvent(this, dT));
         return;
     }
 }
@@ -249,49 +331,76 @@ void Bullet::NextFrame()
 
 // Legacy HandlePlayerCollision method removed - collision handling now done by CombatSystem
 
-void Bullet::HandleLevelCollision(float xpp, float zpp, float ory)
+void Bullet::HandleLevelCollision(float xpp, float zpp, float ory, float normalX, float normalZ)
+{
+    LoadState();
+    HandleLevelCollisionState(xpp, zpp, ory, normalX, normalZ);
+    StoreState();
+}
+
+void Bullet::InferWallNormal(float xpp, float zpp, float& normalX, float& normalZ)
+{
+    // Which cell boundary the step crossed (x, z are the step's start);
+    // on a diagonal step, probe which neighbour is the wall
+    normalX = 0.0f;
+    normalZ = 0.0f;
+    const bool crossedX = static_cast<int>(x + xpp) != static_cast<int>(x);
+    const bool crossedZ = static_cast<int>(z + zpp) != static_cast<int>(z);
+    if (crossedX && crossedZ)
+    {
+        if (gameWorld->GetLevelHandler().PointCollision((x + xpp), y, z) && !gameWorld->GetLevelHandler().PointCollision(x, y, z + zpp))
+        {
+            normalX = xpp > 0 ? -1.0f : 1.0f;
+        }
+        else
+        {
+            normalZ = zpp > 0 ? -1.0f : 1.0f;
+        }
+    }
+    else if (crossedX)
+    {
+        normalX = xpp > 0 ? -1.0f : 1.0f;
+    }
+    else if (crossedZ)
+    {
+        normalZ = zpp > 0 ? -1.0f : 1.0f;
+    }
+}
+
+void Bullet::HandleLevelCollisionState(float xpp, float zpp, float ory, float normalX, float normalZ)
 {
     x -= xpp;
     z -= zpp;
+    if (normalX == 0.0f && normalZ == 0.0f)
+    {
+        InferWallNormal(xpp, zpp, normalX, normalZ);
+    }
+
     if (numbounces < maxbounces)
     {
-        if (static_cast<int>(x + xpp) != static_cast<int>(x) && static_cast<int>(z + zpp) == static_cast<int>(z))
+        // Mirror the heading in the wall that was hit
+        if (normalX != 0.0f)
         {
             ry = -ry + 180;
         }
-
-        if (static_cast<int>(z + zpp) != static_cast<int>(z) && static_cast<int>(x + xpp) == static_cast<int>(x))
+        else if (normalZ != 0.0f)
         {
             ry = -ry;
         }
 
-        if (static_cast<int>(x + xpp) != static_cast<int>(x) && static_cast<int>(z + zpp) != static_cast<int>(z))
-        {
-            if (LevelHandler::GetSingleton().PointCollision((x + xpp), y, z) && !LevelHandler::GetSingleton().PointCollision(x, y, z + zpp))
-            {
-                ry = -ry + 180;
-            }
-            else
-            {
-                ry = -ry;
-            }
-        }
-
         // Get player tank from PlayerManager for audio volume calculation
-        auto playerTanks = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerTanks();
+        auto playerTanks = gameWorld->GetPlayerManager().GetPlayerTanks();
         Tank* player0 = playerTanks[0];
         int dist = 128; // Default max distance
         if (player0) {
-            dist = static_cast<int>(sqrt((x - player0->x) * (x - player0->x) + (z - player0->z) * (z - player0->z)));
+            dist = static_cast<int>(fastSqrt((x - player0->x) * (x - player0->x) + (z - player0->z) * (z - player0->z)));
         }
 
         if (dist > 128)
         {
             dist = 128;
         }
-        Mix_Volume(9, 128 - dist);
-
-        App::GetSingleton().soundTask->PlayChannel(9);
+        gameWorld->GetEventBus().Publish(PlaySoundEvent::WithVolume(9, 128 - dist));
 
         if (numbounces < 1)
         {
@@ -354,9 +463,9 @@ void Bullet::HandleLevelCollision(float xpp, float zpp, float ory)
                     temp.ry = ry;
                     temp.rz = rz;
 
-                    temp.x = x + (.2 + i * .2 + numbounces * .2) * static_cast<float>(cos((ry + 90) * DTR));
+                    temp.x = x + (.2 + i * .2 + numbounces * .2) * cosDeg(ry + 90);
                     temp.y = y;
-                    temp.z = z + (.2 + i * .2 + numbounces * .2) * static_cast<float>(sin((ry + 90) * DTR));
+                    temp.z = z + (.2 + i * .2 + numbounces * .2) * sinDeg(ry + 90);
 
                     temp.power = power;
 
@@ -443,10 +552,10 @@ void Bullet::HandleLevelCollision(float xpp, float zpp, float ory)
 
         if (ownerIdentity.IsPlayer())
         {
-            App::GetSingleton().gameTask->GetPlayerManager()->ResetHitComboByTankId(ownerIdentity.GetLegacyId());
+            gameWorld->GetPlayerManager().ResetHitComboByTankId(ownerIdentity.GetLegacyId());
         }
 
-        CreateWallImpactFX(xpp, zpp);
+        CreateWallImpactFX(normalX, normalZ);
     }
 }
 
@@ -6,11 +6,13 @@
 
 #pragma once
 
+#include <cstddef>
 #include "Entity.h"
 #include "Color.h"
 #include "TankIdentity.h"
 
 class Tank;
+class BulletSystem;
 enum class TankType;
 enum class FxType;
 
@@ -27,7 +29,10 @@ public:
            const Color& secondaryColor,
            float x, float y, float z,
            float rx, float ry, float rz);
-    ~Bullet() = default;
+    // Copies are detached snapshots (they never join the owner's BulletSystem)
+    Bullet(const Bullet& other);
+    Bullet& operator=(const Bullet& other);
+    ~Bullet();
     
     // Entity interface implementation
     void Update() override { NextFrame(); }
@@ -35,27 +40,29 @@ public:
     void OnDestroy() override {}
     void Kill() override { alive = false; }
     
-    // Legacy methods for compatibility
+    // Scalar per-bullet update (reference path; worlds advance their
+    // bullets in batch through BulletSystem)
     void NextFrame();
 
     // Accessor methods for alive member
     void SetAlive(bool isAlive) { alive = isAlive; }
 
-    // Accessor methods for rendering data extraction
-    float GetX() const { return x; }
-    float GetY() const { return y; }
-    float GetZ() const { return z; }
+    // Accessor methods for rendering data extraction (a bullet in a world
+    // keeps its motion state in that world's BulletSystem)
+    float GetX() const;
+    float GetY() const;
+    float GetZ() const;
     float GetVX() const { return vx; }
     float GetVY() const { return vy; }
     float GetVZ() const { return vz; }
     float GetRX() const { return rx; }
-    float GetRY() const { return ry; }
+    float GetRY() const;
     
     // GameWorld access for FX creation
     void SetGameWorld(class GameWorld* world) { gameWorld = world; }
     
     // Descriptive FX helper methods (encapsulate effect creation logic)
-    void CreateWallImpactFX(float xpp, float zpp);
+    void CreateWallImpactFX(float normalX, float normalZ);
     
     // Low-level FX creation (used by helper methods)
     void CreateFX(FxType type, float x, float y, float z, float rx, float ry, float rz, float r, float g, float b, float a);
@@ -77,16 +84,29 @@ public:
     int GetTankId() const { return ownerIdentity.GetLegacyId(); }  // Backward compatibility
     float GetMoveRate() const { return moveRate; }
     int GetBounces() const { return maxbounces; }
-    float GetDT() const { return dT; }
+    float GetDT() const;
     bool GetIsSpecial() const { return isSpecial; }
+    float GetAngularVelocity() const;
     
     // Setters needed by CombatSystem
     void SetPower(float newPower) { power = newPower; }
     
     // Collision handling methods (level collision still needed for bullet physics)
-    void HandleLevelCollision(float xpp, float zpp, float ory);
+    // normalX/Z: wall face hit, or zero to work it out from the step
+    void HandleLevelCollision(float xpp, float zpp, float ory, float normalX = 0.0f, float normalZ = 0.0f);
 
 private:
+    friend class BulletSystem;
+
+    // Copy the motion state between the BulletSystem slot and the fields
+    // below, around code that works on the fields (no-ops when detached)
+    void LoadState();
+    void StoreState();
+    void NextFrameState();
+    void HandleLevelCollisionState(float xpp, float zpp, float ory, float normalX, float normalZ);
+    void InferWallNormal(float xpp, float zpp, float& normalX, float& normalZ);
+
+    // Motion state (authoritative only while detached)
     float x = 0.0f, y = 0.0f, z = 0.0f;
     float vx = 0.0f, vy = 0.0f, vz = 0.0f;
     float rx = 0.0f, ry = 0.0f, rz = 0.0f;
@@ -115,4 +135,7 @@ private:
     bool alive = true;
     
     class GameWorld* gameWorld = nullptr;
+
+    BulletSystem* system = nullptr;     // Owner of the motion state, if any
+    size_t slot = 0;                    // Index into the system's arrays
 };
@@ -15,6 +15,7 @@
 #endif
 
 #include "DisplayList.h"
+#include "rendering/GLProfile.h"
 
 DisplayList::DisplayList(int num)
 {
@@ -67,7 +68,7 @@ void DisplayList::EndList()
     enumIdx++;
 }
 
-void DisplayList::Call(int i)
+void DisplayList::Call(int i) const
 {
     glCallList(idx + i);
 }
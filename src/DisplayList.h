@@ -10,7 +10,7 @@ public:
     void ResetList();
     void NewList();
     void EndList();
-    void Call(int i);
+    void Call(int i) const;
     void Close();
 
 private:
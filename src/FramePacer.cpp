@@ -0,0 +1,109 @@
+//
+//  FramePacer.cpp
+//  tankgame
+//
+//
+
+#include "FramePacer.h"
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    // Weight kept by the spin margin per sleep that woke up on time
+    const float SPIN_MARGIN_DECAY = 0.99f;
+
+    float Milliseconds(std::chrono::steady_clock::duration duration)
+    {
+        return std::chrono::duration<float, std::milli>(duration).count();
+    }
+}
+
+constexpr float FramePacer::MIN_SPIN_MARGIN_MS;
+constexpr float FramePacer::MAX_SPIN_MARGIN_MS;
+
+FramePacer::Mode FramePacer::ModeFromSetting(int value)
+{
+    switch (value)
+    {
+    case 1:
+        return Mode::ADAPTIVE_VSYNC;
+    case 2:
+        return Mode::UNCAPPED;
+    case 3:
+        return Mode::CAPPED;
+    default:
+        return Mode::VSYNC;
+    }
+}
+
+const char* FramePacer::GetModeName(Mode mode)
+{
+    switch (mode)
+    {
+    case Mode::ADAPTIVE_VSYNC:
+        return "adaptive vsync";
+    case Mode::UNCAPPED:
+        return "uncapped";
+    case Mode::CAPPED:
+        return "capped";
+    default:
+        return "vsync";
+    }
+}
+
+void FramePacer::Configure(Mode newMode, float newCapFps)
+{
+    mode = newMode;
+    capFps = std::max(newCapFps, 10.0f);
+    period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / capFps));
+    scheduled = false;
+}
+
+void FramePacer::WaitForNextFrame()
+{
+    if (mode != Mode::CAPPED)
+    {
+        return;
+    }
+
+    // First frame, or more than a frame behind: restart the schedule
+    // rather than rush through frames to catch up
+    const Clock::time_point now = Clock::now();
+    if (!scheduled || now > deadline + period)
+    {
+        deadline = now + period;
+        scheduled = true;
+        return;
+    }
+
+    SleepUntil(deadline);
+    deadline += period;
+}
+
+void FramePacer::SleepUntil(Clock::time_point wakeUp)
+{
+    const auto margin = [this]() {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float, std::milli>(spinMarginMs));
+    };
+
+    Clock::time_point now = Clock::now();
+    while (wakeUp - now > margin())
+    {
+        const Clock::duration request = wakeUp - now - margin();
+        std::this_thread::sleep_for(request);
+        const Clock::time_point woke = Clock::now();
+
+        // Late wake-ups widen the margin at once; it narrows again slowly
+        const float lateMs = Milliseconds(woke - now - request);
+        spinMarginMs = std::min(std::max(spinMarginMs * SPIN_MARGIN_DECAY, lateMs * 1.5f),
+                                MAX_SPIN_MARGIN_MS);
+        spinMarginMs = std::max(spinMarginMs, MIN_SPIN_MARGIN_MS);
+        now = woke;
+    }
+
+    while (Clock::now() < wakeUp)
+    {
+        std::this_thread::yield();
+    }
+}
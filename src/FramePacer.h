@@ -0,0 +1,58 @@
+//
+//  FramePacer.h
+//  tankgame
+//
+//
+
+#pragma once
+
+#include <chrono>
+
+/**
+ * Frame pacing of the main loop (settings file).
+ *
+ * VSYNC and ADAPTIVE_VSYNC leave the pace to the swap; adaptive tears
+ * instead of waiting a whole refresh when a frame is late. UNCAPPED runs
+ * flat out. CAPPED turns vsync off and ends every frame in
+ * WaitForNextFrame(), which sleeps while the OS can be trusted to wake it
+ * in time and spins the last stretch. The spin margin follows how late
+ * sleeps actually return, so coarse timers cost a little more spinning
+ * rather than missed deadlines.
+ *
+ * The wait sits between the swap and the next frame's input sampling, so
+ * the time spent waiting never adds to the input-to-present latency.
+ */
+class FramePacer
+{
+public:
+    enum class Mode { VSYNC, ADAPTIVE_VSYNC, UNCAPPED, CAPPED };
+
+    static constexpr float MIN_SPIN_MARGIN_MS = 0.25f;
+    static constexpr float MAX_SPIN_MARGIN_MS = 4.0f;
+
+    // Settings file value (0 to 3); anything else is VSYNC
+    static Mode ModeFromSetting(int value);
+    static const char* GetModeName(Mode mode);
+
+    // capFps is only used in CAPPED mode (clamped to at least 10)
+    void Configure(Mode mode, float capFps);
+    Mode GetMode() const { return mode; }
+    float GetCapFps() const { return capFps; }
+
+    // CAPPED: block until the next frame is due; other modes return at once
+    void WaitForNextFrame();
+
+    float GetSpinMarginMs() const { return spinMarginMs; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void SleepUntil(Clock::time_point deadline);
+
+    Mode mode = Mode::VSYNC;
+    float capFps = 120.0f;
+    Clock::duration period = Clock::duration::zero();
+    Clock::time_point deadline;
+    bool scheduled = false;
+    float spinMarginMs = 1.0f;
+};
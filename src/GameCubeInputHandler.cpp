@@ -8,11 +8,11 @@
 void GameCubeInputHandler::HandleInput(Tank& tank)
 {
     // Fire controls
-    if (InputTask::GetButton(tank.jid, 0) || InputTask::GetButton(tank.jid, 7) || InputTask::GetAxis(tank.jid, 3) > -5000)
+    if (InputTask::GetButton(tank.Cold().jid, 0) || InputTask::GetButton(tank.Cold().jid, 7) || InputTask::GetAxis(tank.Cold().jid, 3) > -5000)
     {
         if (tank.type1 == TankType::TYPE_PURPLE || tank.type2 == TankType::TYPE_PURPLE)
         {
-            tank.Fire((float)InputTask::GetAxis(tank.jid, 2) / (float)6400);
+            tank.Fire((float)InputTask::GetAxis(tank.Cold().jid, 2) / (float)6400);
         }
         else
         {
@@ -21,11 +21,11 @@ void GameCubeInputHandler::HandleInput(Tank& tank)
     }
 
     // Special controls
-    if (InputTask::GetButton(tank.jid, 5) || InputTask::GetButton(tank.jid, 6))
+    if (InputTask::GetButton(tank.Cold().jid, 5) || InputTask::GetButton(tank.Cold().jid, 6))
     {
         if (tank.type1 == TankType::TYPE_PURPLE || tank.type2 == TankType::TYPE_PURPLE)
         {
-            tank.Special((float)InputTask::GetAxis(tank.jid, 2) / (float)6000);
+            tank.Special((float)InputTask::GetAxis(tank.Cold().jid, 2) / (float)6000);
         }
         else
         {
@@ -34,37 +34,37 @@ void GameCubeInputHandler::HandleInput(Tank& tank)
     }
 
     // Movement controls
-    if (InputTask::GetAxis(tank.jid, 1) < -4000)
+    if (InputTask::GetAxis(tank.Cold().jid, 1) < -4000)
     {
-        tank.Move(-1.0f * (float)InputTask::GetAxis(tank.jid, 1) / (float)18000);
+        tank.Move(-1.0f * (float)InputTask::GetAxis(tank.Cold().jid, 1) / (float)18000);
         if (tank.turbo)
         {
             tank.Move(true);
-            tank.energy -= tank.jumpCost * GlobalTimer::dT;
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
         }
     }
     
-    if (InputTask::GetAxis(tank.jid, 0) < -8000)
+    if (InputTask::GetAxis(tank.Cold().jid, 0) < -8000)
     {
-        tank.RotBody((float)InputTask::GetAxis(tank.jid, 0) / (float)28000);
+        tank.RotBody((float)InputTask::GetAxis(tank.Cold().jid, 0) / (float)28000);
     }
-    if (InputTask::GetAxis(tank.jid, 0) > 8000)
+    if (InputTask::GetAxis(tank.Cold().jid, 0) > 8000)
     {
-        tank.RotBody((float)InputTask::GetAxis(tank.jid, 0) / (float)28000);
+        tank.RotBody((float)InputTask::GetAxis(tank.Cold().jid, 0) / (float)28000);
     }
     
-    if (InputTask::GetAxis(tank.jid, 1) > 8000)
+    if (InputTask::GetAxis(tank.Cold().jid, 1) > 8000)
     {
         tank.Move(false);
         if (tank.turbo)
         {
             tank.Move(false);
-            tank.energy -= tank.jumpCost * GlobalTimer::dT;
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
         }
     }
 
     // Jump controls
-    if (InputTask::GetButton(tank.jid, 1))
+    if (InputTask::GetButton(tank.Cold().jid, 1))
     {
         tank.Jump();
         if (tank.turbo)
@@ -74,17 +74,17 @@ void GameCubeInputHandler::HandleInput(Tank& tank)
     }
 
     // Turret rotation
-    if (InputTask::GetAxis(tank.jid, 2) < -6000)
+    if (InputTask::GetAxis(tank.Cold().jid, 2) < -6000)
     {
-        tank.RotTurret((float)InputTask::GetAxis(tank.jid, 2) / (float)2500);
+        tank.RotTurret((float)InputTask::GetAxis(tank.Cold().jid, 2) / (float)2500);
     }
-    if (InputTask::GetAxis(tank.jid, 2) > 6000)
+    if (InputTask::GetAxis(tank.Cold().jid, 2) > 6000)
     {
-        tank.RotTurret((float)InputTask::GetAxis(tank.jid, 2) / (float)2500);
+        tank.RotTurret((float)InputTask::GetAxis(tank.Cold().jid, 2) / (float)2500);
     }
 
     // Additional jump control via axis 4
-    if (InputTask::GetAxis(tank.jid, 4) > 5000)
+    if (InputTask::GetAxis(tank.Cold().jid, 4) > 5000)
     {
         tank.Jump();
         if (tank.turbo)
@@ -94,7 +94,7 @@ void GameCubeInputHandler::HandleInput(Tank& tank)
     }
 
     // Turbo controls
-    if (tank.energy > 0 && (InputTask::GetButton(tank.jid, 3) || InputTask::GetButton(tank.jid, 2)))
+    if (tank.energy > 0 && (InputTask::GetButton(tank.Cold().jid, 3) || InputTask::GetButton(tank.Cold().jid, 2)))
     {
         tank.turbo = true;
     }
@@ -103,24 +103,29 @@ void GameCubeInputHandler::HandleInput(Tank& tank)
         tank.turbo = false;
     }
 
-    // Camera controls via hat switch
+    // Camera controls via hat switch (no cameras when running headless)
+    if (!App::GetSingleton().graphicsTask)
+    {
+        return;
+    }
     auto& cam = App::GetSingleton().graphicsTask->cams[tank.identity.GetPlayerIndex()];
-    if (SDL_JoystickGetHat(InputTask::joysticks[tank.jid], 0) == SDL_HAT_UP)
+    const unsigned char hat = InputTask::GetHat(tank.Cold().jid, 0);
+    if (hat == SDL_HAT_UP)
     {
         cam.ydist = 0.8;
         cam.xzdist = 1.0;
     }
-    else if (SDL_JoystickGetHat(InputTask::joysticks[tank.jid], 0) == SDL_HAT_DOWN)
+    else if (hat == SDL_HAT_DOWN)
     {
         cam.ydist = 1.2;
         cam.xzdist = 2;
     }
-    else if (SDL_JoystickGetHat(InputTask::joysticks[tank.jid], 0) == SDL_HAT_LEFT)
+    else if (hat == SDL_HAT_LEFT)
     {
         cam.ydist = 3.2;
         cam.xzdist = 2.2;
     }
-    else if (SDL_JoystickGetHat(InputTask::joysticks[tank.jid], 0) == SDL_HAT_RIGHT)
+    else if (hat == SDL_HAT_RIGHT)
     {
         cam.ydist = 20.2;
         cam.xzdist = 0.2;
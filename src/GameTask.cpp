@@ -8,26 +8,29 @@
 #include "GameWorld.h"
 #include "PlayerManager.h"
 #include "Logger.h"
-#include "events/Events.h"
+#include "events/CollisionEvents.h"
+#include "memory/AllocationTracker.h"
+#include "profiling/FrameStats.h"
+#include "profiling/QualityGovernor.h"
 
 void GameTask::SetUpGame()
 {
     Logger::Get().Write("GameTask: Setting up new game...\n");
     
     // Clear any pending events from previous level/game
-    Events::Clear();
+    gameWorld.GetEventBus().Clear();
     Logger::Get().Write("GameTask: Cleared event queue\n");
     
-    LevelHandler::GetSingleton().Init();
-    if (!LevelHandler::GetSingleton().Load("levels/level0@@.txt"))
+    gameWorld.GetLevelHandler().Init();
+    if (!gameWorld.GetLevelHandler().Load("levels/level0@@.txt"))
     {
         Logger::Get().Write("LevelHandler failed to load level.\n");
     }
-    TankHandler::GetSingleton().Init();
+    gameWorld.GetTankHandler().Init();
     
     // Spawn player tanks through PlayerManager
     Logger::Get().Write("GameTask: Spawning player tanks via PlayerManager...\n");
-    playerManager.SpawnPlayerTanks();
+    gameWorld.GetPlayerManager().SpawnPlayerTanks();
     Logger::Get().Write("GameTask: Player tanks spawned\n");
     
     Logger::Get().Write("GameTask: Game setup complete\n");
@@ -59,27 +62,39 @@ bool GameTask::Start()
     }
     App::GetSingleton().graphicsTask->drawHUD = false;
 
-    LevelHandler::GetSingleton().Load("./levels/title@@.txt");
+    gameWorld.GetLevelHandler().Load("./levels/title@@.txt");
 
     paused = false;
     debug = false;
+    gameWorld.SetDebugMode(debug);
     
     // Initialize GameWorld with collision and combat systems
     gameWorld.Initialize();
+
+    // The interactive world is the only one that makes noise
+    gameWorld.GetEventBus().Subscribe<PlaySoundEvent>([](const PlaySoundEvent& event) {
+        App::GetSingleton().soundTask->PlayEvent(event);
+    });
     
     // Pass GameWorld to GraphicsTask and recreate SceneDataBuilder
     // (GraphicsTask starts before GameTask, so initial creation had nullptr gameWorld)
     App::GetSingleton().graphicsTask->SetGameWorld(&gameWorld);
-    
-    // Connect handlers to GameWorld (singletons are now initialized)
-    TankHandler::GetSingleton().SetGameWorld(&gameWorld);
-    LevelHandler::GetSingleton().SetGameWorld(&gameWorld);
+
+    if (replaySettings.IsReplaying())
+    {
+        replayLoaded = replay.Open(replaySettings.replayPath);
+    }
 
     return true;
 }
 
 void GameTask::Stop()
 {
+    recorder.Close();
+    if (replaying)
+    {
+        StopReplay();
+    }
     gameWorld.Shutdown();
 }
 
@@ -90,9 +105,9 @@ void GameTask::Visible(bool visible)
 void GameTask::OnResume()
 {
     Logger::Get().Write("GameTask: OnResume - Initializing systems...\n");
-    TankHandler::GetSingleton().Init();
+    gameWorld.GetTankHandler().Init();
     Logger::Get().Write("GameTask: Initializing PlayerManager...\n");
-    playerManager.Initialize(&gameWorld);
+    gameWorld.GetPlayerManager().Initialize(&gameWorld);
     
     Logger::Get().Write("GameTask: OnResume complete\n");
 }
@@ -104,7 +119,13 @@ void GameTask::OnSuspend()
 
 void GameTask::Update()
 {
+    AllocationScope allocations("game");
     HandleCommonState();
+
+    // Recordings and replays must tick exactly alike, so their matches keep
+    // the full budget whatever this machine's frame time
+    gameWorld.SetQualityBudget((recorder.IsOpen() || replaying) ? QualityGovernor::GetLevelBudget(0)
+                                                                : QualityGovernor::Get().GetBudget());
      
     switch (currentState)
     {
@@ -123,9 +144,12 @@ void GameTask::Update()
     static int debugCounter = 0;
     
     if (++debugCounter % 60 == 0) { // Log every 60 frames (~1 second at 60fps)
-        Logger::Get().Write("GameWorld entities - Tanks: %zu, Bullets: %zu, Items: %zu, Effects: %zu | FPS: %.1f\n", 
+        const FrameTimeSummary frames = FrameStats::Get().Summarize();
+        Logger::Get().Write("GameWorld entities - Tanks: %zu, Bullets: %zu, Items: %zu, Effects: %zu | FPS: %.1f"
+                           " | Frame ms p50 %.1f p95 %.1f p99 %.1f max %.1f\n", 
                            gameWorld.GetTanks().size(), gameWorld.GetBullets().size(), 
-                           gameWorld.GetItems().size(), gameWorld.GetFX().size(), GlobalTimer::GetFPS());
+                           gameWorld.GetItemCount(), gameWorld.GetParticles().GetCount(), GlobalTimer::GetFPS(),
+                           frames.p50Ms, frames.p95Ms, frames.p99Ms, frames.maxMs);
     }
 }
 
@@ -135,6 +159,11 @@ void GameTask::HandleCommonState()
     {
         App::GetSingleton().soundTask->PauseMusic();
     }
+
+    if (InputTask::KeyDown(SDL_SCANCODE_F3))
+    {
+        FrameStats::Get().ToggleOverlay();
+    }
 }
 
 void GameTask::HandleMenuState()
@@ -143,32 +172,46 @@ void GameTask::HandleMenuState()
     // Update GameWorld for menu effects (now handles FX through GameWorld)
     gameWorld.Update();
 
+    // A loaded recording starts straight away, with the recorded settings
+    if (replayLoaded && !replaying)
+    {
+        StartReplay();
+        return;
+    }
+
     if (InputTask::KeyDown(SDL_SCANCODE_RETURN) || InputTask::MouseDown(1))
     {
         // isInputJoy managed by PlayerManager
-        playerManager.SetInputJoystick(false);
+        gameWorld.GetPlayerManager().SetInputJoystick(false);
         if (menuState > 0)
         {
-            playerManager.SetNumPlayers(2);
+            gameWorld.GetPlayerManager().SetNumPlayers(2);
         }
         // Immediately clamp to prevent array bounds issues
-        int currentPlayers = playerManager.GetNumPlayers();
-        playerManager.SetNumPlayers(std::min(currentPlayers, 2));
+        int currentPlayers = gameWorld.GetPlayerManager().GetNumPlayers();
+        gameWorld.GetPlayerManager().SetNumPlayers(std::min(currentPlayers, 2));
         versus = (menuState == 2);
+        gameWorld.SetVersusMode(versus);
         SetUpGame();
         gameStarted = true;
         TransitionToState(GameState::PLAYING);
+
+        if (replaySettings.IsRecording())
+        {
+            StartRecording();
+        }
     }
 
     if (InputTask::KeyDown(SDL_SCANCODE_I))
     {
         debug = true;
+        gameWorld.SetDebugMode(debug);
         App::GetSingleton().soundTask->PlayChannel(1);
     }
 
     if (InputTask::KeyDown(SDL_SCANCODE_2))
     {
-        playerManager.SetNumPlayers(2);
+        gameWorld.GetPlayerManager().SetNumPlayers(2);
     }
 
     if (menuState == 0)
@@ -209,33 +252,32 @@ void GameTask::HandleMenuState()
 
 void GameTask::HandlePlayingState()
 {
+    // Input for this tick (live, or the next recorded frame); a finished
+    // replay returns to the menu
+    const float dT = NextTickInput();
+    if (currentState != GameState::PLAYING)
+    {
+        return;
+    }
+
     if (debug)
     {
         if (InputTask::KeyDown(SDL_SCANCODE_H))
         {
-            LevelHandler::GetSingleton().NextLevel(true);
+            gameWorld.GetLevelHandler().NextLevel(true);
         }
         if (InputTask::KeyDown(SDL_SCANCODE_L))
         {
-            LevelHandler::GetSingleton().NextLevel(false);
+            gameWorld.GetLevelHandler().NextLevel(false);
         }
     }
 
     App::GetSingleton().graphicsTask->drawHUD = true;
     App::GetSingleton().graphicsTask->drawMenu = false;
 
-    // Process events first (handles collision queries, notifications, etc.)
-    Events::ProcessQueuedEvents();
-    
-    // New unified update replaces individual handler updates
-    gameWorld.Update();
-    
-    // Player management through PlayerManager
-    playerManager.NextFrame();
-    
-    // Item management (TODO: move to GameWorld or ItemManager)
-    LevelHandler::GetSingleton().UpdateItems();
-    LevelHandler::GetSingleton().ItemCollision();
+    // Events, entities, players and items for one frame
+    gameWorld.Simulate(dT);
+    AfterTick();
 
     if (InputTask::KeyDown(SDL_SCANCODE_ESCAPE))
     {
@@ -256,7 +298,100 @@ void GameTask::HandleGameOverState()
     }
 }
 
+void GameTask::StartRecording()
+{
+    ReplayHeader header;
+    header.levelPath = "levels/level0@@.txt";
+    header.versus = versus;
+    header.debug = debug;
+    header.numPlayers = gameWorld.GetPlayerManager().GetNumPlayers();
+    for (int i = 0; i < PlayerManager::MAX_PLAYERS; i++)
+    {
+        header.inputModes[i] = gameWorld.GetPlayerManager().GetPlayerInputMode(i);
+    }
+    header.hashInterval = replaySettings.hashInterval;
+    InputTask::CaptureFrame(header.initialState);
+
+    recorder.Open(replaySettings.recordPath, header, gameWorld);
+
+    // One game per recording
+    replaySettings.recordPath.clear();
+}
+
+void GameTask::StartReplay()
+{
+    const ReplayHeader& header = replay.GetHeader();
+    versus = header.versus;
+    debug = header.debug;
+
+    InputReplay::SetUpMatch(gameWorld, header);
+    InputTask::BeginPlayback(header.initialState);
+    if (replaySettings.verify)
+    {
+        replay.VerifyTick(gameWorld);
+    }
+
+    replaying = true;
+    gameStarted = true;
+    TransitionToState(GameState::PLAYING);
+}
+
+void GameTask::StopReplay()
+{
+    InputTask::EndPlayback();
+    replaying = false;
+    replayLoaded = false;
+    Logger::Get().Write("GameTask: replay finished after %lu ticks; %d hashes checked, %d mismatches\n",
+                        replay.GetTick(), replay.GetHashesChecked(), replay.GetMismatches());
+}
+
+float GameTask::NextTickInput()
+{
+    if (replaying)
+    {
+        InputFrame frame;
+        if (!replay.NextTick(frame))
+        {
+            TransitionToState(GameState::MENU);
+            return 0.0f;
+        }
+        InputTask::ApplyFrame(frame);
+        return frame.dT;
+    }
+
+    if (recorder.IsOpen())
+    {
+        InputFrame frame;
+        InputTask::CaptureFrame(frame);
+        frame.dT = GlobalTimer::dT;
+        recorder.RecordTick(frame);
+    }
+    return GlobalTimer::dT;
+}
+
+void GameTask::AfterTick()
+{
+    if (replaying && replaySettings.verify)
+    {
+        replay.VerifyTick(gameWorld);
+    }
+    else if (recorder.IsOpen())
+    {
+        recorder.AfterTick(gameWorld);
+    }
+}
+
 void GameTask::TransitionToState(GameState newState)
 {
+    // Recordings and replays cover one game: leaving play ends them
+    if (currentState == GameState::PLAYING && newState != GameState::PLAYING)
+    {
+        recorder.Close();
+        if (replaying)
+        {
+            StopReplay();
+        }
+    }
+
     currentState = newState;
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 
 #include "ITask.h"
 #include "GameWorld.h"
-#include "PlayerManager.h"
+#include "simulation/InputRecording.h"
 
 class GameTask : public ITask
 {
@@ -23,9 +23,14 @@ public:
     bool IsVersusMode() const { return versus; }
     int GetMenuState() const { return menuState; }
     
-    // Access to player management
-    PlayerManager* GetPlayerManager() { return &playerManager; }
-    const PlayerManager* GetPlayerManager() const { return &playerManager; }
+    // Access to the interactive match and its players
+    GameWorld* GetGameWorld() { return &gameWorld; }
+    const GameWorld* GetGameWorld() const { return &gameWorld; }
+    PlayerManager* GetPlayerManager() { return &gameWorld.GetPlayerManager(); }
+    const PlayerManager* GetPlayerManager() const { return &gameWorld.GetPlayerManager(); }
+
+    // Record the next game, or play a recording back (set before Start)
+    void SetReplaySettings(const ReplaySettings& settings) { replaySettings = settings; }
 
 private:
     enum class GameState { MENU, PLAYING, GAME_OVER };
@@ -39,11 +44,23 @@ private:
     void SetUpGame();
     void TransitionToState(GameState newState);
 
+    void StartRecording();
+    void StartReplay();
+    void StopReplay();
+    float NextTickInput();
+    void AfterTick();
+
     void Visible(bool visible);
 
-    // Phase 1: Add GameWorld alongside existing systems
+    // The interactive match (owns level, enemies and players)
     GameWorld gameWorld;
-    PlayerManager playerManager;
+
+    // Session recording / playback
+    ReplaySettings replaySettings;
+    InputRecorder recorder;
+    InputReplay replay;
+    bool replayLoaded = false;
+    bool replaying = false;
 
     bool paused;
     bool debug;
@@ -3,17 +3,47 @@
 #include "Bullet.h"
 #include "Item.h"
 #include "Logger.h"
-#include "events/Events.h"
+#include "GlobalTimer.h"
 #include "events/CollisionEvents.h"
+#include "memory/AllocationTracker.h"
+#include <chrono>
 
-GameWorld::GameWorld() = default;
+namespace {
+    // Adds the lifetime of the scope to *target (free when target is null)
+    // and charges its heap allocations to the phase
+    class PhaseTimer {
+    public:
+        PhaseTimer(double* target, const char* phase) : target(target), allocations(phase) {
+            if (target) {
+                start = std::chrono::steady_clock::now();
+            }
+        }
+        ~PhaseTimer() {
+            if (target) {
+                *target += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+        }
+
+    private:
+        double* target;
+        std::chrono::steady_clock::time_point start;
+        AllocationScope allocations;
+    };
+}
+
+GameWorld::GameWorld() {
+    levelHandler.SetGameWorld(this);
+    tankHandler.SetGameWorld(this);
+    particles.SetLevel(&levelHandler);
+    particles.SetBudget(&qualityBudget);
+}
 
 void GameWorld::Initialize() {
     Logger::Get().Write("GameWorld::Initialize() - Starting\n");
     
     // Initialize systems
-    collisionSystem.Initialize();
-    combatSystem.Initialize();
+    collisionSystem.Initialize(this);
+    combatSystem.Initialize(this);
     
     // Set up event handlers
     SetupEventHandlers();
@@ -27,20 +57,125 @@ void GameWorld::Shutdown() {
 }
 
 void GameWorld::Update() {
+    Update(GlobalTimer::dT);
+}
+
+void GameWorld::Update(float dT) {
+    frameArenas.Flip();
+    deltaTime = dT;
+    elapsedTime += dT;
+    tickCount++;
+
     // Update collision system first
-    collisionSystem.Update();
+    {
+        PhaseTimer timer(profile ? &profile->collision : nullptr, "collision");
+        collisionSystem.Update();
+    }
     
     // Update all entity types with collision system cleanup
-    UpdateEntitiesWithCleanup(tanks);
-    UpdateEntitiesWithCleanup(bullets);
-    UpdateEntitiesWithCleanup(effects);
-    UpdateEntitiesWithCleanup(items);
+    {
+        PhaseTimer timer(profile ? &profile->tanks : nullptr, "tanks");
+        UpdateEntitiesWithCleanup(tanks);
+    }
+    {
+        // Bullets advance in one batch, then the dead ones leave both stores
+        PhaseTimer timer(profile ? &profile->bullets : nullptr, "bullets");
+        bulletSystem.Update(*this, dT);
+        RemoveDeadEntities(bullets);
+        bulletSystem.Compact();
+    }
+    {
+        PhaseTimer timer(profile ? &profile->effects : nullptr, "effects");
+        particles.Update(dT);
+    }
+    {
+        PhaseTimer timer(profile ? &profile->items : nullptr, "items");
+        Item::RemoveCollected(registry);
+        Item::UpdateAll(registry);
+    }
 
     // Handle interactions
+    PhaseTimer timer(profile ? &profile->collision : nullptr, "collision");
     HandleCollisions();
     HandleItemCollection();
 }
 
+void GameWorld::Simulate(float dT) {
+    // Process events first (handles collision queries, notifications, etc.)
+    {
+        PhaseTimer timer(profile ? &profile->events : nullptr, "events");
+        eventBus.ProcessQueuedEvents();
+    }
+
+    Update(dT);
+
+    // Player management through PlayerManager
+    {
+        PhaseTimer timer(profile ? &profile->players : nullptr, "players");
+        playerManager.NextFrame();
+    }
+
+    // Item management
+    PhaseTimer timer(profile ? &profile->items : nullptr, "items");
+    levelHandler.UpdateItems();
+    levelHandler.ItemCollision();
+
+    if (profile) {
+        profile->ticks++;
+    }
+}
+
+namespace {
+    // FNV-1a over the raw bytes of each value (bit-exact, so -0.0f != 0.0f)
+    class StateHasher {
+    public:
+        template<typename T>
+        void Add(const T& value) {
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&value);
+            for (size_t i = 0; i < sizeof(T); i++) {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        }
+        uint64_t Get() const { return hash; }
+
+    private:
+        uint64_t hash = 14695981039346656037ull;
+    };
+}
+
+uint64_t GameWorld::ComputeStateHash() const {
+    StateHasher hasher;
+    hasher.Add(levelHandler.levelNumber);
+
+    for (const auto& tank : tanks.GetEntities()) {
+        hasher.Add(tank->alive);
+        hasher.Add(tank->x);
+        hasher.Add(tank->y);
+        hasher.Add(tank->z);
+        hasher.Add(tank->ry);
+        hasher.Add(tank->rty);
+        hasher.Add(tank->health);
+        hasher.Add(tank->energy);
+        hasher.Add(tank->type1);
+        hasher.Add(tank->type2);
+    }
+    for (const auto& bullet : bullets.GetEntities()) {
+        hasher.Add(bullet->GetX());
+        hasher.Add(bullet->GetY());
+        hasher.Add(bullet->GetZ());
+        hasher.Add(bullet->GetRY());
+    }
+    registry.ForEachChunk<Position, ItemPickup>([&hasher](size_t count, const Position* position, const ItemPickup* pickup) {
+        for (size_t i = 0; i < count; i++) {
+            hasher.Add(pickup[i].collected);
+            hasher.Add(position[i].x);
+            hasher.Add(position[i].z);
+            hasher.Add(pickup[i].type);
+        }
+    });
+    return hasher.Get();
+}
+
 void GameWorld::Clear() {
     // Unregister all entities from collision system before clearing
     for (const auto& tank : tanks.GetEntities()) {
@@ -53,17 +188,16 @@ void GameWorld::Clear() {
             collisionSystem.UnregisterEntity(bullet.get());
         }
     }
-    for (const auto& item : items.GetEntities()) {
-        if (item) {
-            collisionSystem.UnregisterEntity(item.get());
-        }
-    }
     
+    // Queued events may point at the entities about to be destroyed
+    eventBus.Clear();
+
     // Clear all entity collections
     tanks.Clear();
     bullets.Clear(); 
-    effects.Clear();
-    items.Clear();
+    bulletSystem.Compact();
+    particles.Clear();
+    registry.Clear();
 }
 
 Bullet* GameWorld::CreateBullet(const TankIdentity& ownerIdentity, float attack, TankType type1, TankType type2, int bounces, float dTpressed, 
@@ -76,7 +210,9 @@ Bullet* GameWorld::CreateBullet(const TankIdentity& ownerIdentity, float attack,
     // Set GameWorld reference so bullet can create FX
     if (bullet) {
         bullet->SetGameWorld(this);
-        collisionSystem.RegisterEntity(bullet, CollisionShape3D(CollisionShape3D::SPHERE, 0.3f), CollisionLayer::BULLETS);
+        // Bullets are tested in batch by the BulletSystem, not through the
+        // collision registry (which every tank query would have to walk)
+        bulletSystem.Attach(bullet);
     }
     
     return bullet;
@@ -97,23 +233,22 @@ Tank* GameWorld::CreateTank() {
     return tank;
 }
 
-FX* GameWorld::CreateFX(FxType type, float x, float y, float z, float rx, float ry, float rz, float r, float g, float b, float a) {
-    return effects.Create(type, x, y, z, rx, ry, rz, Color(r, g, b, a));
+void GameWorld::CreateFX(FxType type, float x, float y, float z, float rx, float ry, float rz, float r, float g, float b, float a) {
+    particles.Spawn(type, x, y, z, 0.0f, 0.0f, 0.0f, rx, ry, rz, Color(r, g, b, a));
 }
 
-FX* GameWorld::CreateFX(FxType type, float x, float y, float z, float dx, float dy, float dz, float rx, float ry, float rz, float r, float g, float b, float a) {
-    return effects.Create(type, x, y, z, dx, dy, dz, rx, ry, rz, Color(r, g, b, a));
+void GameWorld::CreateFX(FxType type, float x, float y, float z, float dx, float dy, float dz, float rx, float ry, float rz, float r, float g, float b, float a) {
+    particles.Spawn(type, x, y, z, dx, dy, dz, rx, ry, rz, Color(r, g, b, a));
 }
 
-Item* GameWorld::CreateItem(float x, float y, float z, TankType type) {
-    Item* item = items.Create(x, y, z, type);
-    
-    // Register item with collision system for player pickup detection
-    if (item) {
-        collisionSystem.RegisterEntity(item, CollisionShape3D(CollisionShape3D::SPHERE, 0.3f), CollisionLayer::ITEMS);
-    }
-    
-    return item;
+Item GameWorld::CreateItem(float x, float y, float z, TankType type) {
+    // Pickup is a point test against the player tanks (LevelHandler /
+    // Player), so items are not registered with the collision system
+    return Item(registry, Item::Create(registry, x, y, z, type));
+}
+
+size_t GameWorld::GetItemCount() const {
+    return registry.Count<ItemPickup>();
 }
 
 void GameWorld::ReregisterTankCollision(Tank* tank) {
@@ -141,7 +276,7 @@ void GameWorld::HandleItemCollection() {
 
 void GameWorld::SetupEventHandlers() {
     // Handle FX creation events from combat system
-    Events::GetBus().Subscribe<CreateFXEvent>([this](const CreateFXEvent& event) {
+    eventBus.Subscribe<CreateFXEvent>([this](const CreateFXEvent& event) {
         OnCreateFXEvent(event);
     });
 }
@@ -170,7 +305,14 @@ void GameWorld::UpdateEntitiesWithCleanup(EntityManager<T>& manager) {
             entity->Update();
         }
     }
-    
+
+    RemoveDeadEntities(manager);
+}
+
+template<typename T>
+void GameWorld::RemoveDeadEntities(EntityManager<T>& manager) {
+    auto& entities = const_cast<std::vector<std::unique_ptr<T>>&>(manager.GetEntities());
+
     // Remove dead entities and unregister from collision system
     entities.erase(
         std::remove_if(entities.begin(), entities.end(),
@@ -1,11 +1,21 @@
 #pragma once
 
+#include <cstdint>
 #include "Entity.h"
 #include "EntityManager.h"
 #include "collision/CollisionSystem.h"
+#include "combat/BulletSystem.h"
 #include "combat/CombatSystem.h"
 #include "Color.h"
-#include "FX.h"
+#include "Item.h"
+#include "ecs/ArchetypeRegistry.h"
+#include "effects/ParticleSystem.h"
+#include "events/EventBus.h"
+#include "LevelHandler.h"
+#include "memory/FrameArena.h"
+#include "TankHandler.h"
+#include "PlayerManager.h"
+#include "profiling/QualityGovernor.h"
 
 // Forward declarations for existing classes
 class Tank;
@@ -13,17 +23,43 @@ class Bullet;
 class Item;
 enum class TankType;
 
+/**
+ * Wall time (seconds) spent in each phase of GameWorld::Simulate,
+ * accumulated over the ticks simulated while attached (see SetProfile).
+ */
+struct SimulationProfile {
+    double events = 0.0;        // Queued event dispatch
+    double collision = 0.0;     // Spatial grid update, tank/bullet and item pickup tests
+    double tanks = 0.0;         // Tank movement and enemy AI (incl. their terrain queries)
+    double bullets = 0.0;       // Bullet movement, level bounces and hit queries
+    double effects = 0.0;       // Particle update
+    double items = 0.0;         // Item update and level item handling
+    double players = 0.0;       // PlayerManager::NextFrame
+    unsigned long ticks = 0;
+
+    double Total() const { return events + collision + tanks + bullets + effects + items + players; }
+};
+
 /**
  * Central game world manager.
  * Owns EntityManager instances for all entity types and coordinates their lifecycle.
  * Handlers now serve as interfaces to GameWorld rather than managing entities directly.
+ *
+ * A GameWorld is a self-contained match: it owns its own event bus, clock,
+ * level, enemy handler and players, so several worlds can run side by side
+ * (see simulation/BatchSimulator).
  */
 class GameWorld {
 public:
     GameWorld();
     ~GameWorld() = default;
     
+    // Advance entities by the global frame time (interactive game loop)
     void Update();
+    // Advance entities by an explicit time step (headless / fixed-step simulation)
+    void Update(float dT);
+    // One complete gameplay tick: queued events, entities, players, items
+    void Simulate(float dT);
     void Clear();
 
     // Entity creation interfaces (for handlers to use)
@@ -31,9 +67,9 @@ public:
     Bullet* CreateBullet(const TankIdentity& ownerIdentity, float attack, TankType type1, TankType type2, int bounces, float dTpressed, 
                         const Color& primaryColor, const Color& secondaryColor,
                         float x, float y, float z, float rx, float ry, float rz);
-    FX* CreateFX(FxType type, float x, float y, float z, float rx, float ry, float rz, float r, float g, float b, float a);
-    FX* CreateFX(FxType type, float x, float y, float z, float dx, float dy, float dz, float rx, float ry, float rz, float r, float g, float b, float a);
-    Item* CreateItem(float x, float y, float z, TankType type);
+    void CreateFX(FxType type, float x, float y, float z, float rx, float ry, float rz, float r, float g, float b, float a);
+    void CreateFX(FxType type, float x, float y, float z, float dx, float dy, float dz, float rx, float ry, float rz, float r, float g, float b, float a);
+    Item CreateItem(float x, float y, float z, TankType type);
     
     // Tank collision layer management
     void ReregisterTankCollision(Tank* tank);
@@ -41,8 +77,12 @@ public:
     // Access for rendering and other systems
     const auto& GetTanks() const { return tanks.GetEntities(); }
     const auto& GetBullets() const { return bullets.GetEntities(); }
-    const auto& GetFX() const { return effects.GetEntities(); }
-    const auto& GetItems() const { return items.GetEntities(); }
+    const ParticleSystem& GetParticles() const { return particles; }
+    // fn(Item&) for every item not yet picked up, straight off the registry
+    // rows (nothing is allocated); fn returns false to stop early
+    template<typename Fn>
+    void ForEachItem(Fn&& fn);
+    size_t GetItemCount() const;
 
     // Initialize/shutdown systems
     void Initialize();
@@ -50,12 +90,72 @@ public:
     
     // System accessors
     CollisionSystem& GetCollisionSystem() { return collisionSystem; }
+    const CollisionSystem& GetCollisionSystem() const { return collisionSystem; }
+    BulletSystem& GetBulletSystem() { return bulletSystem; }
+    // Component storage of the entity kinds that live in the ECS (items)
+    ArchetypeRegistry& GetRegistry() { return registry; }
+    const ArchetypeRegistry& GetRegistry() const { return registry; }
+    EventBus& GetEventBus() { return eventBus; }
+    LevelHandler& GetLevelHandler() { return levelHandler; }
+    const LevelHandler& GetLevelHandler() const { return levelHandler; }
+    TankHandler& GetTankHandler() { return tankHandler; }
+    const TankHandler& GetTankHandler() const { return tankHandler; }
+    PlayerManager& GetPlayerManager() { return playerManager; }
+    const PlayerManager& GetPlayerManager() const { return playerManager; }
+
+    // Scratch memory for this tick's transient data (query results, views);
+    // it stays valid through the next tick, then is reused
+    FrameArena& GetFrameArena() { return frameArenas.Current(); }
+    const DoubleFrameArena& GetFrameArenas() const { return frameArenas; }
+
+    // Per-world clock (replaces GlobalTimer::dT inside the simulation)
+    float GetDeltaTime() const { return deltaTime; }
+    float GetElapsedTime() const { return elapsedTime; }
+    unsigned long GetTickCount() const { return tickCount; }
+
+    // Fingerprint of the gameplay state (level, tanks, bullets, items);
+    // equal in two runs exactly when they have not diverged. Effects are
+    // cosmetic and excluded.
+    uint64_t ComputeStateHash() const;
+
+    // Accumulate per-phase timings of Simulate into profile (nullptr = off)
+    void SetProfile(SimulationProfile* target) { profile = target; }
+
+    // Optional simulation work (particle caps and spawn rates, AI decision
+    // rate). Full quality unless the owner hands it another: GameTask does
+    // each frame from the QualityGovernor, headless worlds never do
+    void SetQualityBudget(const QualityBudget& budget) { qualityBudget = budget; }
+    const QualityBudget& GetQualityBudget() const { return qualityBudget; }
+
+    // Match rules
+    void SetVersusMode(bool enabled) { versusMode = enabled; }
+    bool IsVersusMode() const { return versusMode; }
+    void SetDebugMode(bool enabled) { debugMode = enabled; }
+    bool IsDebugMode() const { return debugMode; }
 
 private:
+    // Per-match context (declared first so entities and systems can use it)
+    EventBus eventBus;
+    LevelHandler levelHandler;
+    TankHandler tankHandler;
+    PlayerManager playerManager;
+
+    float deltaTime = 0.0f;
+    float elapsedTime = 0.0f;
+    unsigned long tickCount = 0;
+    bool versusMode = false;
+    bool debugMode = false;
+    QualityBudget qualityBudget = QualityGovernor::GetLevelBudget(0);
+    SimulationProfile* profile = nullptr;
+    DoubleFrameArena frameArenas;
+
+    // Bullet motion state (declared before the bullets that point into it)
+    BulletSystem bulletSystem;
+
     EntityManager<Tank> tanks;
     EntityManager<Bullet> bullets;
-    EntityManager<FX> effects;
-    EntityManager<Item> items;
+    ParticleSystem particles;
+    ArchetypeRegistry registry;
     
     // Game systems
     CollisionSystem collisionSystem;
@@ -71,4 +171,17 @@ private:
     // Helper for updating entities with collision cleanup
     template<typename T>
     void UpdateEntitiesWithCleanup(EntityManager<T>& manager);
+    template<typename T>
+    void RemoveDeadEntities(EntityManager<T>& manager);
 };
+
+template<typename Fn>
+void GameWorld::ForEachItem(Fn&& fn) {
+    bool more = true;
+    registry.ForEach<ItemPickup>([this, &fn, &more](EntityHandle entity, ItemPickup& pickup) {
+        if (more && !pickup.collected) {
+            Item item(registry, entity);
+            more = fn(item);
+        }
+    });
+}
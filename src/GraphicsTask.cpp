@@ -25,6 +25,9 @@
 #include "rendering/ResourceManager.h"
 #include "rendering/SceneDataBuilder.h"
 #include "rendering/RenderingPipeline.h"
+#include "rendering/GLStateCache.h"
+#include "rendering/core/CoreRenderingPipeline.h"
+#include "memory/AllocationTracker.h"
 #include <stdlib.h>
 #include <sys/types.h>
 #include <iostream>
@@ -39,10 +42,20 @@
 #include "VideoTask.h"
 #include "GlobalTimer.h"
 #include "math.h"
+#include "rendering/GLProfile.h"
 
 typedef unsigned short WORD;
 typedef unsigned char byte;
 
+namespace
+{
+    // The interactive match (owned by GameTask, which exists before any task starts)
+    GameWorld& InteractiveWorld()
+    {
+        return *App::GetSingleton().gameTask->GetGameWorld();
+    }
+}
+
 GraphicsTask::GraphicsTask()
 {
     TTF_Init();
@@ -63,6 +76,15 @@ bool GraphicsTask::Start()
     // Initialize viewport manager
     viewportManager.SetupSinglePlayer(VideoTask::scrWidth, VideoTask::scrHeight);
 
+    // The core-profile backend owns all of its GL state; none of the
+    // fixed-function setup, textures, display lists or legacy renderers apply
+    if (UsingCoreProfile())
+    {
+        InitializeNewRenderingPipeline();
+        Logger::Get().Write("GraphicsTask::Started (core profile)\n");
+        return renderingPipeline != nullptr;
+    }
+
     // Essential OpenGL setup (required for proper rendering)
     glClearColor(0.0f, 0.0f, 0.1f, 1.0f);
 
@@ -167,6 +189,11 @@ void GraphicsTask::Stop()
     CleanupNewRenderingPipeline();
 
     // Cleanup legacy renderers
+    if (UsingCoreProfile())
+    {
+        Logger::Get().Write("GraphicsTask: Stopped \n");
+        return;
+    }
     terrainRenderer.Cleanup();
     bulletRenderer.Cleanup();
     effectRenderer.Cleanup();
@@ -176,8 +203,13 @@ void GraphicsTask::Stop()
 
 void GraphicsTask::Update()
 {
-    // Essential buffer clearing and basic setup
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    const bool coreProfile = UsingCoreProfile();
+
+    // Essential buffer clearing and basic setup (the core backend clears itself)
+    if (!coreProfile)
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    }
 
     static int lastnumPlayers = 1; // Default to 1, will be updated dynamically
     
@@ -214,14 +246,19 @@ void GraphicsTask::Update()
         lastnumPlayers = numPlayers;
     }
 
-    // Basic OpenGL state setup for both pipelines
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
-
-    glEnable(GL_NORMALIZE);
-    glShadeModel(GL_SMOOTH);
+    // Basic fixed-function state for the legacy pipeline
+    if (!coreProfile)
+    {
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
 
-    glDisable(GL_LIGHTING);
+        // Anything outside the renderers (setup, text) may have used raw GL
+        GLStateCache &state = GLStateCache::Get();
+        state.Invalidate();
+        state.Enable(GL_NORMALIZE);
+        state.ShadeModel(GL_SMOOTH);
+        state.Disable(GL_LIGHTING);
+    }
 
     if (App::GetSingleton().gameTask->IsGameStarted())
     {
@@ -265,20 +302,31 @@ void GraphicsTask::InitializeNewRenderingPipeline()
         // Note: GameWorld is nullptr at this point (GameTask starts after GraphicsTask)
         // Will be set via SetGameWorld() once GameWorld is initialized
         sceneDataBuilder = std::make_unique<SceneDataBuilder>(
-            TankHandler::GetSingleton(),
-            LevelHandler::GetSingleton(),
+            InteractiveWorld().GetTankHandler(),
+            InteractiveWorld().GetLevelHandler(),
             gameWorld,
             App::GetSingleton().gameTask ? App::GetSingleton().gameTask->GetPlayerManager() : nullptr);
 
-        // Create RenderingPipeline with references to managers
-        renderingPipeline = std::make_unique<RenderingPipeline>(
-            viewportManager,
-            cameraManager,
-            *resourceManager);
+        // Create the backend VideoTask made a context for, with references to managers
+        if (UsingCoreProfile())
+        {
+            renderingPipeline = std::make_unique<CoreRenderingPipeline>(
+                viewportManager,
+                cameraManager,
+                *resourceManager);
+        }
+        else
+        {
+            renderingPipeline = std::make_unique<RenderingPipeline>(
+                viewportManager,
+                cameraManager,
+                *resourceManager);
+        }
 
         if (!renderingPipeline->Initialize())
         {
             Logger::Get().Write("ERROR: Failed to initialize RenderingPipeline\n");
+            renderingPipeline.reset();
             return;
         }
 
@@ -299,8 +347,8 @@ void GraphicsTask::SetGameWorld(GameWorld* world)
     gameWorld = world;
     
     sceneDataBuilder = std::make_unique<SceneDataBuilder>(
-        TankHandler::GetSingleton(),
-        LevelHandler::GetSingleton(),
+        world->GetTankHandler(),
+        world->GetLevelHandler(),
         gameWorld,
         App::GetSingleton().gameTask ? App::GetSingleton().gameTask->GetPlayerManager() : nullptr);
 }
@@ -338,6 +386,7 @@ void GraphicsTask::RenderWithNewPipeline()
     try
     {
         // Build scene data from current game state
+        AllocationScope sceneAllocations("scene data");
         SceneData sceneData = sceneDataBuilder->BuildScene();
         
         // Extract camera data for split-screen support
@@ -349,6 +398,7 @@ void GraphicsTask::RenderWithNewPipeline()
         sceneData.debugMode = App::GetSingleton().gameTask->IsDebugMode();
 
         // Render the complete scene using the centralized pipeline
+        AllocationScope renderAllocations("render");
         renderingPipeline->RenderAllPlayerViews(sceneData);
         
         // UI rendering is now handled by the RenderingPipeline
@@ -521,8 +571,8 @@ void GraphicsTask::DrawHUD(Tank &player)
     // Fire cost indicator line
     glColor3f(0.5f, 1.0f, 1.0f);
 
-    glVertex3f(-0.51f + 0.29f * player.fireCost / player.maxEnergy, 0.32f, 0);
-    glVertex3f(-0.51f + 0.29f * player.fireCost / player.maxEnergy, 0.29f, 0);
+    glVertex3f(-0.51f + 0.29f * player.Cold().fireCost / player.maxEnergy, 0.32f, 0);
+    glVertex3f(-0.51f + 0.29f * player.Cold().fireCost / player.maxEnergy, 0.29f, 0);
 
     glEnd();
 
@@ -586,7 +636,7 @@ void GraphicsTask::DrawHUD(Tank &player)
     }
 
     // Make energy bar visible with proper alpha - was 0.02f (invisible!)
-    float alpha = (player.energy < player.fireCost) ? 0.6f : 1.0f;
+    float alpha = (player.energy < player.Cold().fireCost) ? 0.6f : 1.0f;
     glColor4f(0.5f, rper, 1.0f, alpha);
 
     glVertex3f(-0.51f, 0.32f, 0);
@@ -611,7 +661,7 @@ void GraphicsTask::DrawHUD(Tank &player)
     Player* currentPlayer = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerByTankId(player.identity.GetLegacyId());
     if (!currentPlayer) return; // Safety check
     
-    if (currentPlayer->GetSpecialCharge() < player.fireCost / 5)
+    if (currentPlayer->GetSpecialCharge() < player.Cold().fireCost / 5)
         glEnable(GL_BLEND);
 
     glBegin(GL_QUADS);
@@ -639,7 +689,7 @@ void GraphicsTask::DrawHUD(Tank &player)
 
     glEnd();
 
-    float costspec = (player.fireCost / 500);
+    float costspec = (player.Cold().fireCost / 500);
 
     int nspec = (int)(spec / costspec);
 
@@ -805,7 +855,7 @@ void GraphicsTask::DrawHUD(Tank &player)
      float bangM=((float)player.dist/50);
      if(bangM>1)bangM=1;
 
-     if(TankHandler::GetSingleton().GetAllEnemyTanks().size()>0)
+     if(InteractiveWorld().GetTankHandler().GetAllEnemyTanks().size()>0)
      {
      glColor4f(1.0f,bangM,0.1f,0.0);
 
@@ -834,7 +884,7 @@ void GraphicsTask::DrawHUD(Tank &player)
      glEnable(GL_BLEND);
      glBlendFunc(GL_ONE, GL_ONE);
 
-     if(TankHandler::GetSingleton().GetAllEnemyTanks().size()>0)
+     if(InteractiveWorld().GetTankHandler().GetAllEnemyTanks().size()>0)
      {
      glPushMatrix();
      glLoadIdentity();
@@ -966,7 +1016,7 @@ void GraphicsTask::DrawHUD(Tank &player)
     // Ones of enemy tanks left:
     glTranslatef(-0.04, 0.0, 0.0);
 
-    glBindTexture(GL_TEXTURE_2D, textureHandler.GetTextureArray()[TankHandler::GetSingleton().GetAllEnemyTanks().size() % 10]);
+    glBindTexture(GL_TEXTURE_2D, textureHandler.GetTextureArray()[InteractiveWorld().GetTankHandler().GetAllEnemyTanks().size() % 10]);
 
     glBegin(GL_QUADS);
     glTexCoord2f(0, 1);
@@ -985,7 +1035,7 @@ void GraphicsTask::DrawHUD(Tank &player)
     // Tens of enemy tanks left:
     glTranslatef(-0.04, 0.0, 0.0);
 
-    glBindTexture(GL_TEXTURE_2D, textureHandler.GetTextureArray()[(int)TankHandler::GetSingleton().GetAllEnemyTanks().size() / 10]);
+    glBindTexture(GL_TEXTURE_2D, textureHandler.GetTextureArray()[(int)InteractiveWorld().GetTankHandler().GetAllEnemyTanks().size() / 10]);
 
     glBegin(GL_QUADS);
 
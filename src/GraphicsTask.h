@@ -41,7 +41,7 @@
 #include "VideoTask.h"
 #include "rendering/ResourceManager.h"
 #include "rendering/SceneDataBuilder.h"
-#include "rendering/RenderingPipeline.h"
+#include "rendering/IRenderingPipeline.h"
 
 class GraphicsTask : public ITask
 {
@@ -59,7 +59,7 @@ public:
     // Phase 4: New Centralized Rendering Pipeline Components
     std::unique_ptr<ResourceManager> resourceManager;      // Centralized resource management
     std::unique_ptr<SceneDataBuilder> sceneDataBuilder;    // Scene data extraction and building
-    std::unique_ptr<RenderingPipeline> renderingPipeline;  // Centralized rendering orchestration
+    std::unique_ptr<IRenderingPipeline> renderingPipeline; // Centralized rendering orchestration (legacy or core backend)
     
     // Legacy specialized renderers (will be managed by RenderingPipeline)
     TerrainRenderer terrainRenderer;  // Handles all terrain rendering
@@ -118,4 +118,5 @@ private:
     void FixMesh(igtl_QGLMesh& mesh);
     void PrepareMesh(igtl_QGLMesh& mesh, const char* fileName);
     void RenderLegacyUIElements();  // Legacy HUD/UI rendering
+    bool UsingCoreProfile() const { return VideoTask::activeBackend == VideoTask::RenderBackend::CORE; }
 };
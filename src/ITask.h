@@ -13,6 +13,8 @@ public:
     {
         canKill = false;
         priority = 5000;
+        name = "task";
+        presents = false;
     }
     virtual ~ITask() {};
     virtual bool Start() = 0;
@@ -23,4 +25,6 @@ public:
 
     bool canKill;
     long priority;
+    const char* name;   // Stage name in the frame stats overlay
+    bool presents;      // Update() waits for the display; not counted as work
 };
@@ -21,6 +21,12 @@ int InputTask::jdA[MAX_JOYSTICKS][MAX_JOYSTICKS] = {0};
 unsigned int InputTask::buttons = 0;
 unsigned int InputTask::oldButtons = 0;
 
+std::chrono::steady_clock::time_point InputTask::sampleTime;
+bool InputTask::playingBack = false;
+bool InputTask::ownsPlaybackKeys = false;
+InputFrame InputTask::playbackFrame;
+InputFrame InputTask::previousPlaybackFrame;
+
 InputTask::InputTask()
 {
 }
@@ -51,6 +57,7 @@ bool InputTask::Start()
 
 void InputTask::Update()
 {
+    sampleTime = std::chrono::steady_clock::now();
     SDL_PumpEvents();
     oldButtons = buttons;
     buttons = SDL_GetRelativeMouseState(&dX, &dY);
@@ -73,7 +80,12 @@ void InputTask::Update()
 int InputTask::GetAxis(int joystickId, int axis)
 {
     int ret;
-    if (joystickId < 0 || joystickId >= MAX_JOYSTICKS || joysticks[joystickId] == NULL)
+    if (playingBack)
+    {
+        bool valid = joystickId >= 0 && joystickId < InputFrame::MAX_JOYSTICKS && axis >= 0 && axis < InputFrame::MAX_AXES;
+        ret = valid ? playbackFrame.axes[joystickId][axis] : -1;
+    }
+    else if (joystickId < 0 || joystickId >= MAX_JOYSTICKS || joysticks[joystickId] == NULL)
     {
         ret = -1;
     }
@@ -88,7 +100,12 @@ int InputTask::GetAxis(int joystickId, int axis)
 unsigned char InputTask::GetButton(int joystickId, int bid)
 {
     unsigned char ret;
-    if (joystickId < 0 || joystickId >= MAX_JOYSTICKS || joysticks[joystickId] == NULL)
+    if (playingBack)
+    {
+        bool valid = joystickId >= 0 && joystickId < InputFrame::MAX_JOYSTICKS && bid >= 0 && bid < InputFrame::MAX_BUTTONS;
+        ret = valid ? (playbackFrame.joystickButtons[joystickId] >> bid) & 1 : 0;
+    }
+    else if (joystickId < 0 || joystickId >= MAX_JOYSTICKS || joysticks[joystickId] == NULL)
     {
         ret = 0;
     }
@@ -100,6 +117,102 @@ unsigned char InputTask::GetButton(int joystickId, int bid)
     return ret;
 }
 
+unsigned char InputTask::GetHat(int joystickId, int hat)
+{
+    unsigned char ret;
+    if (playingBack)
+    {
+        bool valid = joystickId >= 0 && joystickId < InputFrame::MAX_JOYSTICKS && hat == 0;
+        ret = valid ? playbackFrame.hats[joystickId] : SDL_HAT_CENTERED;
+    }
+    else if (joystickId < 0 || joystickId >= MAX_JOYSTICKS || joysticks[joystickId] == NULL)
+    {
+        ret = SDL_HAT_CENTERED;
+    }
+    else
+    {
+        ret = SDL_JoystickGetHat(joysticks[joystickId], hat);
+    }
+
+    return ret;
+}
+
+void InputTask::CaptureFrame(InputFrame& frame)
+{
+    frame = InputFrame();
+    for (int i = 0; keys && i < keyCount && i < InputFrame::KEY_COUNT; i++)
+    {
+        frame.SetKey(i, keys[i] != 0);
+    }
+    frame.mouseDX = dX;
+    frame.mouseDY = dY;
+    frame.mouseButtons = buttons;
+
+    for (int j = 0; j < InputFrame::MAX_JOYSTICKS; j++)
+    {
+        for (int a = 0; a < InputFrame::MAX_AXES; a++)
+        {
+            frame.axes[j][a] = static_cast<int16_t>(GetAxis(j, a));
+        }
+        for (int b = 0; b < InputFrame::MAX_BUTTONS; b++)
+        {
+            if (GetButton(j, b))
+            {
+                frame.joystickButtons[j] |= 1u << b;
+            }
+        }
+        frame.hats[j] = GetHat(j, 0);
+    }
+}
+
+void InputTask::BeginPlayback(const InputFrame& initialState)
+{
+    // Headless runs never called Start(): give the handlers key arrays to read
+    if (!keys)
+    {
+        keyCount = InputFrame::KEY_COUNT;
+        keys = new Uint8[keyCount]();
+        oldKeys = new Uint8[keyCount]();
+        ownsPlaybackKeys = true;
+    }
+
+    playingBack = true;
+    playbackFrame = initialState;
+    previousPlaybackFrame = initialState;
+}
+
+void InputTask::ApplyFrame(const InputFrame& frame)
+{
+    // Edges (KeyDown, MouseDown) are relative to the previous recorded tick,
+    // not to whatever the live devices did in between
+    previousPlaybackFrame = playbackFrame;
+    playbackFrame = frame;
+
+    for (int i = 0; i < keyCount && i < InputFrame::KEY_COUNT; i++)
+    {
+        oldKeys[i] = previousPlaybackFrame.KeyPressed(i);
+        keys[i] = frame.KeyPressed(i);
+    }
+    oldButtons = previousPlaybackFrame.mouseButtons;
+    buttons = frame.mouseButtons;
+    dX = frame.mouseDX;
+    dY = frame.mouseDY;
+}
+
+void InputTask::EndPlayback()
+{
+    playingBack = false;
+    if (ownsPlaybackKeys)
+    {
+        delete[] keys;
+        delete[] oldKeys;
+        keys = 0;
+        oldKeys = 0;
+        keyCount = 0;
+        ownsPlaybackKeys = false;
+    }
+}
+
 void InputTask::Stop()
 {
     for (int i = 0; i < SDL_NumJoysticks(); i++)
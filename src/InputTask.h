@@ -6,12 +6,44 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 using namespace std;
 
 #include <SDL2/SDL.h>
 #include "ITask.h"
 
+/**
+ * Device state for one simulation tick: everything the input handlers read
+ * from InputTask. Captured while recording a session and applied again on
+ * replay, so the handlers see exactly what they saw live.
+ */
+struct InputFrame {
+    static const int KEY_COUNT = SDL_NUM_SCANCODES;
+    static const int MAX_JOYSTICKS = 4;
+    static const int MAX_AXES = 6;
+    static const int MAX_BUTTONS = 32;
+
+    float dT = 0.0f;                                   // Simulation step of this tick
+    uint8_t keys[KEY_COUNT / 8] = {};                  // Pressed scancodes (bitset)
+    int32_t mouseDX = 0;
+    int32_t mouseDY = 0;
+    uint32_t mouseButtons = 0;
+    int16_t axes[MAX_JOYSTICKS][MAX_AXES] = {};        // GetAxis values (-1 without a device)
+    uint32_t joystickButtons[MAX_JOYSTICKS] = {};      // GetButton bits
+    uint8_t hats[MAX_JOYSTICKS] = {};                  // Hat 0 position
+
+    bool KeyPressed(int scancode) const { return (keys[scancode >> 3] >> (scancode & 7)) & 1; }
+    void SetKey(int scancode, bool pressed)
+    {
+        if (pressed)
+            keys[scancode >> 3] |= static_cast<uint8_t>(1 << (scancode & 7));
+        else
+            keys[scancode >> 3] &= static_cast<uint8_t>(~(1 << (scancode & 7)));
+    }
+};
+
 class InputTask : public ITask
 {
 private:
@@ -34,8 +66,20 @@ public:
     static Uint8 *oldKeys;
     static int keyCount;
 
+    // When Update() last read the devices (input-to-present latency)
+    static std::chrono::steady_clock::time_point GetSampleTime() { return sampleTime; }
+
     static int GetAxis(int joystickId, int axis);
     static unsigned char GetButton(int joystickId, int bid);
+    static unsigned char GetHat(int joystickId, int hat);
+
+    // Record/replay: while playing back, keys, mouse and joystick queries
+    // answer from the applied InputFrame instead of the live devices
+    static void CaptureFrame(InputFrame& frame);
+    static void BeginPlayback(const InputFrame& initialState);
+    static void ApplyFrame(const InputFrame& frame);
+    static void EndPlayback();
+    static bool IsPlayingBack() { return playingBack; }
 
     static int dX, dY;
     static unsigned int buttons;
@@ -57,4 +101,11 @@ public:
     static bool inline MouseStillDown(int button) { return (CurMouse(button)) && (OldMouse(button)); }
     static bool inline MouseUp(int button) { return (!CurMouse(button)) && (OldMouse(button)); }
     static bool inline MouseStillUp(int button) { return (!CurMouse(button)) && (!OldMouse(button)); }
+
+private:
+    static std::chrono::steady_clock::time_point sampleTime;
+    static bool playingBack;
+    static bool ownsPlaybackKeys;       // Headless playback has no SDL keyboard state
+    static InputFrame playbackFrame;
+    static InputFrame previousPlaybackFrame;
 };
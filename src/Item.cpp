@@ -1,59 +1,86 @@
-#ifdef _WIN32
-// If building in windows:
-#include <windows.h>
-#include <GL/gl.h>
-#elif __APPLE__
-// If building on macOS:
-#include <OpenGL/gl.h>
-#else
-// If building on Linux:
-#include <GL/gl.h>
-#endif
-
 #include "Item.h"
-#include "App.h"
 
-Item::Item()
+Item::Item(ArchetypeRegistry& registry, EntityHandle handle)
+    : registry(&registry), handle(handle)
 {
-    x = y = z = 0;
-    rx = ry = rz = 0;
-    color = Color(0.5f, 0.5f, 0.5f, 1.0f);  // Default grey
-    alive = true;
 }
 
-Item::Item(float nx, float ny, float nz, TankType ntype)
+EntityHandle Item::Create(ArchetypeRegistry& registry, float x, float y, float z, TankType type)
 {
-    x = nx;
-    y = ny;
-    z = nz;
-    rx = ry = rz = 0;
-    type = ntype;
-    alive = true;
+    return registry.Create(Position{x, y, z}, Rotation{0.0f, 0.0f, 0.0f},
+                           ItemPickup{type, ColorForType(type), false});
+}
 
-    switch (ntype)
+Color Item::ColorForType(TankType type)
+{
+    switch (type)
     {
     case TankType::TYPE_GREY:
-        color = Color(0.5f, 0.5f, 0.5f, 1.0f);
-        break;
+        return Color(0.5f, 0.5f, 0.5f, 1.0f);
     case TankType::TYPE_RED:
-        color = Color(1.0f, 0.0f, 0.0f, 1.0f);
-        break;
+        return Color(1.0f, 0.0f, 0.0f, 1.0f);
     case TankType::TYPE_BLUE:
-        color = Color(0.0f, 0.0f, 1.0f, 1.0f);
-        break;
+        return Color(0.0f, 0.0f, 1.0f, 1.0f);
     case TankType::TYPE_YELLOW:
-        color = Color(1.0f, 1.0f, 0.0f, 1.0f);
-        break;
+        return Color(1.0f, 1.0f, 0.0f, 1.0f);
     case TankType::TYPE_PURPLE:
-        color = Color(1.0f, 0.0f, 1.0f, 1.0f);
-        break;
+        return Color(1.0f, 0.0f, 1.0f, 1.0f);
     default:
-        color = Color(0.5f, 0.5f, 0.5f, 1.0f);
+        return Color(0.5f, 0.5f, 0.5f, 1.0f);
+    }
+}
+
+void Item::UpdateAll(ArchetypeRegistry& registry)
+{
+    // Spinning animation
+    registry.ForEachChunk<Rotation, ItemPickup>([](size_t count, Rotation* rotation, ItemPickup*) {
+        for (size_t i = 0; i < count; i++)
+        {
+            rotation[i].ry++;
+        }
+    });
+}
+
+void Item::RemoveCollected(ArchetypeRegistry& registry)
+{
+    std::vector<EntityHandle> collected;
+    registry.ForEach<ItemPickup>([&collected](EntityHandle entity, ItemPickup& pickup) {
+        if (pickup.collected)
+        {
+            collected.push_back(entity);
+        }
+    });
+    for (EntityHandle entity : collected)
+    {
+        registry.Destroy(entity);
+    }
+}
+
+bool Item::IsAlive() const
+{
+    const ItemPickup* pickup = registry->Get<ItemPickup>(handle);
+    return pickup && !pickup->collected;
+}
+
+void Item::Kill()
+{
+    if (ItemPickup* pickup = registry->Get<ItemPickup>(handle))
+    {
+        pickup->collected = true;
     }
 }
 
-void Item::Update()
+float Item::GetRY() const
 {
-    // Update rotation for spinning animation
-    ry++;
-}
\ No newline at end of file
+    return registry->Get<Rotation>(handle)->ry;
+}
+
+const Position& Item::GetPosition() const
+{
+    return *registry->Get<Position>(handle);
+}
+
+const ItemPickup& Item::GetPickup() const
+{
+    return *registry->Get<ItemPickup>(handle);
+}
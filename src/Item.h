@@ -1,26 +1,50 @@
 #pragma once
 
-#include "Entity.h"
 #include "Tank.h"
 #include "Color.h"
+#include "ecs/ArchetypeRegistry.h"
+#include "ecs/Components.h"
 
-class Item : public Entity
+/**
+ * Power-up lying on the level.
+ *
+ * Items are rows of the world's ArchetypeRegistry (Position, Rotation,
+ * ItemPickup); an Item is a lightweight view of one of them for gameplay
+ * code. Systems and renderers that visit every item iterate the component
+ * columns directly instead.
+ */
+class Item
 {
 public:
-    Item();
-    Item(float nx, float ny, float nz, TankType ntype);
-
-    bool alive;
-    float x, y, z;        // Position
-    float rx, ry, rz;     // Rotation
-
-    Color color;          // Color
-
-    TankType type;
-    
-    // Entity interface implementation
-    void Update() override;
-    bool IsAlive() const override { return alive; }
-    void OnDestroy() override {}
-    void Kill() override { alive = false; }
-};
\ No newline at end of file
+    Item(ArchetypeRegistry& registry, EntityHandle handle);
+
+    // Components of a new item entity
+    static EntityHandle Create(ArchetypeRegistry& registry, float x, float y, float z, TankType type);
+    static Color ColorForType(TankType type);
+
+    // Spin every item one step (one degree per update)
+    static void UpdateAll(ArchetypeRegistry& registry);
+    // Destroy the items that were picked up
+    static void RemoveCollected(ArchetypeRegistry& registry);
+
+    EntityHandle GetHandle() const { return handle; }
+
+    // Not yet picked up
+    bool IsAlive() const;
+    // Picked up; removed at the next world update
+    void Kill();
+
+    float GetX() const { return GetPosition().x; }
+    float GetY() const { return GetPosition().y; }
+    float GetZ() const { return GetPosition().z; }
+    float GetRY() const;
+    TankType GetType() const { return GetPickup().type; }
+    const Color& GetColor() const { return GetPickup().color; }
+
+private:
+    const Position& GetPosition() const;
+    const ItemPickup& GetPickup() const;
+
+    ArchetypeRegistry* registry;
+    EntityHandle handle;
+};
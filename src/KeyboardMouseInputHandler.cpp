@@ -2,7 +2,7 @@
 #include "Tank.h"
 #include "InputTask.h"
 #include "App.h"
-#include "LevelHandler.h"
+#include "GameWorld.h"
 #include "GlobalTimer.h"
 #include <SDL2/SDL.h>
 
@@ -12,7 +12,7 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
 
     if ((tank.type1 == TankType::TYPE_PURPLE || tank.type2 == TankType::TYPE_PURPLE) && InputTask::MouseStillDown(1))
     {
-        tank.Fire(InputTask::dX * GlobalTimer::dT);
+        tank.Fire(InputTask::dX * tank.GetDeltaTime());
     }
     else if (InputTask::MouseStillDown(1))
     {
@@ -21,7 +21,7 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
 
     if ((tank.type1 == TankType::TYPE_PURPLE || tank.type2 == TankType::TYPE_PURPLE) && InputTask::MouseStillDown(3))
     {
-        tank.Special(InputTask::dX * GlobalTimer::dT);
+        tank.Special(InputTask::dX * tank.GetDeltaTime());
     }
     else if (InputTask::MouseStillDown(3))
     {
@@ -31,9 +31,9 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
     if (InputTask::KeyDown(SDL_SCANCODE_T))
     {
         float oldy = tank.y;
-        LevelHandler::GetSingleton().NextLevel(true);
-        tank.x = LevelHandler::GetSingleton().start[0];
-        tank.z = LevelHandler::GetSingleton().start[1];
+        tank.GetGameWorld()->GetLevelHandler().NextLevel(true);
+        tank.x = tank.GetGameWorld()->GetLevelHandler().start[0];
+        tank.z = tank.GetGameWorld()->GetLevelHandler().start[1];
         tank.y = oldy;
     }
 
@@ -43,7 +43,7 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
         if (tank.turbo)
         {
             tank.Move(true);
-            tank.energy -= tank.jumpCost * GlobalTimer::dT;
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
         }
     }
     if (InputTask::KeyStillDown(SDL_SCANCODE_A))
@@ -52,7 +52,7 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
         if (tank.turbo)
         {
             tank.RotBody(false);
-            tank.energy -= tank.jumpCost * GlobalTimer::dT;
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
         }
     }
     if (InputTask::KeyStillDown(SDL_SCANCODE_D))
@@ -61,7 +61,7 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
         if (tank.turbo)
         {
             tank.RotBody(true);
-            tank.energy -= tank.jumpCost * GlobalTimer::dT;
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
         }
     }
     if (InputTask::KeyStillDown(SDL_SCANCODE_S))
@@ -70,7 +70,7 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
         if (tank.turbo)
         {
             tank.Move(false);
-            tank.energy -= tank.jumpCost * GlobalTimer::dT;
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
         }
     }
 
@@ -89,20 +89,20 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
     
     if (InputTask::KeyStillDown(SDL_SCANCODE_LEFT))
     {
-        tank.RotTurret(-200.0f * GlobalTimer::dT);
+        tank.RotTurret(-200.0f * tank.GetDeltaTime());
         if (tank.turbo)
         {
-            tank.RotTurret(-300.0f * GlobalTimer::dT);
-            tank.energy -= tank.jumpCost * GlobalTimer::dT;
+            tank.RotTurret(-300.0f * tank.GetDeltaTime());
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
         }
     }
     if (InputTask::KeyStillDown(SDL_SCANCODE_RIGHT))
     {
-        tank.RotTurret(200.0f * GlobalTimer::dT);
+        tank.RotTurret(200.0f * tank.GetDeltaTime());
         if (tank.turbo)
         {
-            tank.RotTurret(300.0f * GlobalTimer::dT);
-            tank.energy -= tank.jumpCost * GlobalTimer::dT;
+            tank.RotTurret(300.0f * tank.GetDeltaTime());
+            tank.energy -= tank.Cold().jumpCost * tank.GetDeltaTime();
         }
     }
 
@@ -113,7 +113,11 @@ void KeyboardMouseInputHandler::HandleInput(Tank& tank)
     else
         tank.turbo = false;
 
-    // Camera controls
+    // Camera controls (no cameras when running headless)
+    if (!App::GetSingleton().graphicsTask)
+    {
+        return;
+    }
     if (InputTask::KeyStillDown(SDL_SCANCODE_UP))
     {
         App::GetSingleton().graphicsTask->cams[tank.identity.GetPlayerIndex()].ydist += 10 * GlobalTimer::dT;
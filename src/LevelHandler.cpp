@@ -12,17 +12,21 @@
 #endif
 
 #include <cmath>
+#include <cstring>
 #include "LevelHandler.h"
 #include "GameWorld.h"
 #include "TankHandler.h"
 #include "PlayerManager.h"
 #include "App.h"
 #include "Logger.h"
+#include "events/CollisionEvents.h"
 #include "rendering/RenderData.h"
 #include <nlohmann/json.hpp>
 #include <iostream>
 #include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <limits>
 
 void LevelHandler::CreateFX(FxType type, float x, float y, float z, float rx, float ry, float rz, float r, float g, float b, float a)
 {
@@ -62,6 +66,29 @@ LevelHandler::LevelHandler() : drawFloor(true), drawWalls(false), drawTop(false)
 {
 }
 
+void LevelHandler::BumpTerrainRevision()
+{
+    static std::atomic<unsigned long> nextRevision(1);
+    terrainRevision = nextRevision.fetch_add(1);
+}
+
+void LevelHandler::SaveLayout(Layout &layout) const
+{
+    std::memcpy(layout.t, t, sizeof(t));
+    std::memcpy(layout.f, f, sizeof(f));
+    std::memcpy(layout.start, start, sizeof(start));
+    std::memcpy(layout.enemy, enemy, sizeof(enemy));
+}
+
+void LevelHandler::RestoreLayout(const Layout &layout)
+{
+    std::memcpy(t, layout.t, sizeof(t));
+    std::memcpy(f, layout.f, sizeof(f));
+    std::memcpy(start, layout.start, sizeof(start));
+    std::memcpy(enemy, layout.enemy, sizeof(enemy));
+    BumpTerrainRevision();
+}
+
 void LevelHandler::Init()
 {
     levelNumber = 48;
@@ -181,7 +208,7 @@ bool LevelHandler::Load(const char filePath[])
 
                         if (t[i][j] == -1)
                         {
-                            if (App::GetSingleton().gameTask->IsVersusMode())
+                            if (gameWorld && gameWorld->IsVersusMode())
                             {
                                 t[i][j] = 10;
                             }
@@ -204,6 +231,7 @@ bool LevelHandler::Load(const char filePath[])
 
             Logger::Get().Write("LevelHandler: finished loading file: %s  \n", filePath);
             fclose(filein);
+            BumpTerrainRevision();
             return true;
         }
     }
@@ -273,7 +301,7 @@ void LevelHandler::NextLevel(bool forb)
         }
     }
 
-    TankHandler::GetSingleton().Init();
+    gameWorld->GetTankHandler().Init();
 
     return;
 }
@@ -291,6 +319,7 @@ void LevelHandler::Flatten(int height)
         }
         i++;
     }
+    BumpTerrainRevision();
 }
 
 bool LevelHandler::FloatCollision(float x, float y, float z)
@@ -356,27 +385,21 @@ void LevelHandler::ItemCollision()
         return;
     }
 
-    const auto& gameWorldItems = gameWorld->GetItems();
-    for (const auto& itemPtr : gameWorldItems)
-    {
-        if (!itemPtr->IsAlive()) continue;
-        
-        const Item& item = *itemPtr; // Dereference the unique_ptr
-        
-        // Check item collision with player tanks from PlayerManager
-        auto playerTanks = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerTanks();
-        int numPlayers = App::GetSingleton().gameTask->GetPlayerManager()->GetNumPlayers();
-        
+    // Check item collision with player tanks from PlayerManager
+    const auto playerTanks = gameWorld->GetPlayerManager().GetPlayerTanks();
+    const int numPlayers = gameWorld->GetPlayerManager().GetNumPlayers();
+
+    gameWorld->ForEachItem([&](Item& item) {
         for (int i = 0; i < numPlayers && i < 2; i++)
         {
             Tank* playerTank = playerTanks[i];
             if (!playerTank) continue;
             
-            if (playerTank->PointCollision(item.x, item.y, item.z))
+            if (playerTank->PointCollision(item.GetX(), item.GetY(), item.GetZ()))
             {
-                playerTank->SetType(item.type, playerTank->type1);
+                playerTank->SetType(item.GetType(), playerTank->type1);
 
-                if (item.type == playerTank->type1)
+                if (item.GetType() == playerTank->type1)
                     playerTank->energy += playerTank->maxEnergy;
                 else
                     playerTank->energy += playerTank->maxEnergy / 2;
@@ -384,16 +407,17 @@ void LevelHandler::ItemCollision()
                 if (playerTank->energy > playerTank->maxEnergy)
                     playerTank->energy = playerTank->maxEnergy;
 
-                CreateItemCollectionFX(item.x, item.y, item.z, item.color);
+                CreateItemCollectionFX(item.GetX(), item.GetY(), item.GetZ(), item.GetColor());
 
-                App::GetSingleton().soundTask->PlayChannel(3);
+                gameWorld->GetEventBus().Publish(PlaySoundEvent(3));
                 
-                // Mark item for removal using Entity interface
-                itemPtr->Kill();
+                // Mark item for removal at the next world update
+                item.Kill();
                 break;  // Exit the player loop since item is collected
             }
         }
-    }
+        return true;
+    });
 }
 
 bool LevelHandler::PointCollision(float x, float y, float z)
@@ -424,7 +448,142 @@ bool LevelHandler::PointCollision(float x, float y, float z)
     return (ret);
 }
 
-int LevelHandler::GetTerrainHeight(int x, int z)
+bool LevelHandler::ColumnHit(int cellX, int cellZ, float y0, float dy, float enter, float exit, float& time) const
+{
+    // Solid spans of a column: the terrain below t, and the floating block [f - 1, f)
+    const int terrain = t[cellX][cellZ];
+    const int floatTop = f[cellX][cellZ];
+    if (dy == 0.0f)
+    {
+        // Level segment (bullets, most sight lines): PointCollision's test
+        time = enter;
+        return y0 < terrain || (floatTop > 0 && y0 >= floatTop - 1 && y0 < floatTop);
+    }
+
+    const float never = std::numeric_limits<float>::infinity();
+    const float spans[2][2] = {
+        {-never, terrain > 0 ? static_cast<float>(terrain) : -never},
+        {static_cast<float>(floatTop - 1), floatTop > 0 ? static_cast<float>(floatTop) : -never},
+    };
+
+    bool found = false;
+    time = never;
+    for (const auto& span : spans)
+    {
+        const float low = span[0];
+        const float high = span[1];
+        if (high <= low)
+        {
+            continue;
+        }
+
+        // y is in [low, high) for times between the two crossings
+        float first;
+        if (dy > 0.0f)
+        {
+            first = std::max(enter, (low - y0) / dy);
+            if (first > exit || first >= (high - y0) / dy)
+            {
+                continue;
+            }
+        }
+        else
+        {
+            first = std::max(enter, (high - y0) / dy);
+            if (first > exit || first > (low - y0) / dy)
+            {
+                continue;
+            }
+        }
+
+        if (first < time)
+        {
+            time = first;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool LevelHandler::Raycast(float x0, float y0, float z0, float x1, float y1, float z1, LevelRayHit& hit) const
+{
+    const float never = std::numeric_limits<float>::infinity();
+    const float dx = x1 - x0;
+    const float dy = y1 - y0;
+    const float dz = z1 - z0;
+
+    int cellX = static_cast<int>(std::floor(x0));
+    int cellZ = static_cast<int>(std::floor(z0));
+    const int stepX = dx > 0.0f ? 1 : -1;
+    const int stepZ = dz > 0.0f ? 1 : -1;
+
+    // Segment time to cross one cell on each axis, and to reach the next boundary
+    const float deltaX = dx != 0.0f ? 1.0f / std::fabs(dx) : never;
+    const float deltaZ = dz != 0.0f ? 1.0f / std::fabs(dz) : never;
+    float nextX = dx != 0.0f ? (dx > 0.0f ? cellX + 1 - x0 : x0 - cellX) * deltaX : never;
+    float nextZ = dz != 0.0f ? (dz > 0.0f ? cellZ + 1 - z0 : z0 - cellZ) * deltaZ : never;
+
+    float enter = 0.0f;
+    float normalX = 0.0f;
+    float normalZ = 0.0f;
+    while (true)
+    {
+        const float exit = std::min(1.0f, std::min(nextX, nextZ));
+
+        bool solid = cellX < 0 || cellZ < 0 || cellX >= sizeX || cellZ >= sizeZ;
+        float time = enter;
+        if (!solid)
+        {
+            solid = ColumnHit(cellX, cellZ, y0, dy, enter, exit, time);
+        }
+
+        if (solid)
+        {
+            hit.time = time;
+            hit.x = x0 + dx * time;
+            hit.y = y0 + dy * time;
+            hit.z = z0 + dz * time;
+            hit.cellX = cellX;
+            hit.cellZ = cellZ;
+            // Hit later than the column was entered: came through its top or bottom
+            const bool vertical = time > enter;
+            hit.normalX = vertical ? 0.0f : normalX;
+            hit.normalY = vertical ? (dy < 0.0f ? 1.0f : -1.0f) : 0.0f;
+            hit.normalZ = vertical ? 0.0f : normalZ;
+            return true;
+        }
+
+        if (exit >= 1.0f)
+        {
+            return false;
+        }
+
+        if (nextX < nextZ)
+        {
+            cellX += stepX;
+            enter = nextX;
+            nextX += deltaX;
+            normalX = static_cast<float>(-stepX);
+            normalZ = 0.0f;
+        }
+        else
+        {
+            cellZ += stepZ;
+            enter = nextZ;
+            nextZ += deltaZ;
+            normalX = 0.0f;
+            normalZ = static_cast<float>(-stepZ);
+        }
+    }
+}
+
+bool LevelHandler::LineOfSight(float x0, float y0, float z0, float x1, float y1, float z1) const
+{
+    LevelRayHit hit;
+    return !Raycast(x0, y0, z0, x1, y1, z1, hit);
+}
+
+int LevelHandler::GetTerrainHeight(int x, int z) const
 {
     if (x < 0 || x > 127 || z < 0 || z > 127)
     {
@@ -436,7 +595,7 @@ int LevelHandler::GetTerrainHeight(int x, int z)
     }
 }
 
-int LevelHandler::GetFloatHeight(int x, int z)
+int LevelHandler::GetFloatHeight(int x, int z) const
 {
     if (x < 0 || x > 127 || z < 0 || z > 127)
     {
@@ -457,6 +616,7 @@ bool LevelHandler::SetTerrainHeight(int x, int z, int height)
     else
     {
         t[x][z] = height;
+        BumpTerrainRevision();
         return true;
     }
 }
@@ -557,6 +717,7 @@ void LevelHandler::GenerateTerrain()
             t[i][j] = 2;
         }
     }
+    BumpTerrainRevision();
 }
 
 void LevelHandler::populateTerrainRenderData(TerrainRenderData &renderData) const
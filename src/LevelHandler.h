@@ -10,7 +10,6 @@
 #include <string>
 using namespace std;
 #include "Item.h"
-#include "Singleton.h"
 #include "rendering/RenderData.h"
 
 // Forward declarations
@@ -40,7 +39,19 @@ struct LevelMetadata {
     } gameplay;
 };
 
-class LevelHandler : public Singleton<LevelHandler>
+/**
+ * First solid cell along a segment (see LevelHandler::Raycast).
+ */
+struct LevelRayHit {
+    float time = 0.0f;                  // Fraction of the segment, 0..1
+    float x = 0.0f, y = 0.0f, z = 0.0f; // Hit point
+    int cellX = 0, cellZ = 0;           // Column that was hit (may be outside the map)
+    // Face the segment entered through: one axis is +-1, or all zero when
+    // the segment starts inside the solid
+    float normalX = 0.0f, normalY = 0.0f, normalZ = 0.0f;
+};
+
+class LevelHandler
 {
 public:
     LevelHandler();
@@ -57,12 +68,20 @@ public:
     int start[2];
     int enemy[16][2];
 
-    char fileName[18];
+    char fileName[32];
     int sizeX;
     int sizeZ;
 
     void Flatten(int height);
     bool PointCollision(float x, float y, float z);
+
+    // Walk the grid cells the segment (x0, y0, z0) -> (x1, y1, z1) passes
+    // through (Amanatides-Woo) and report the first point where it is solid
+    // by PointCollision's rules (terrain columns, floating blocks, outside
+    // the map) for y >= 0. Costs one step per crossed cell, with no gaps
+    // for thin walls or corners to slip through.
+    bool Raycast(float x0, float y0, float z0, float x1, float y1, float z1, LevelRayHit& hit) const;
+    bool LineOfSight(float x0, float y0, float z0, float x1, float y1, float z1) const;
     void ItemCollision();
     void UpdateItems();  // Updates item states (rotation animations)
     void AddItem(float x, float y, float z, TankType type);
@@ -79,11 +98,21 @@ public:
     bool HandlePointCollision(float &x, float &y, float &z, float &vx, float &vz);
     bool FallCollision(float x, float y, float z);
     bool FloatCollision(float x, float y, float z);
-    int GetTerrainHeight(int x, int z);
-    int GetFloatHeight(int x, int z);
+    int GetTerrainHeight(int x, int z) const;
+    int GetFloatHeight(int x, int z) const;
     bool SetTerrainHeight(int x, int z, int height);
     void GenerateTerrain();
 
+    // Changes whenever the height or float maps change; unique across all
+    // LevelHandlers, so caches keyed on it never alias between worlds
+    unsigned long GetTerrainRevision() const { return terrainRevision; }
+
+    // The loaded terrain and spawn points. Play changes the terrain, so a
+    // match restarts from a saved layout instead of reading the file again.
+    struct Layout;
+    void SaveLayout(Layout& layout) const;
+    void RestoreLayout(const Layout& layout);
+
     // Rendering data extraction for new rendering pipeline
     void populateTerrainRenderData(struct TerrainRenderData& renderData) const;
 
@@ -113,6 +142,12 @@ private:
 
     int t[MAX_SIZE_X][MAX_SIZE_Z];
     int f[MAX_SIZE_X][MAX_SIZE_Z];
+    unsigned long terrainRevision = 0;
+    void BumpTerrainRevision();
+
+    // Earliest time in [enter, exit] at which y0 + dy * time is inside column
+    // (cellX, cellZ); false if the segment stays clear of it
+    bool ColumnHit(int cellX, int cellZ, float y0, float dy, float enter, float exit, float& time) const;
     
     // JSON metadata support
     LevelMetadata metadata;
@@ -123,4 +158,11 @@ private:
     void PrintMetadata() const;
 
     GameWorld* gameWorld = nullptr; // Pointer to the GameWorld instance
-};
\ No newline at end of file
+};
+
+struct LevelHandler::Layout {
+    int t[MAX_SIZE_X][MAX_SIZE_Z];
+    int f[MAX_SIZE_X][MAX_SIZE_Z];
+    int start[2];
+    int enemy[16][2];
+};
@@ -32,10 +32,16 @@ bool Logger::Init()
 
 void Logger::Write(const char *msg, ...)
 {
+    if (!enabled)
+        return;
+
     va_list args;
     va_start(args, msg);
     char szBuf[1024];
-    vsprintf(szBuf, msg, args);
+    vsnprintf(szBuf, sizeof(szBuf), msg, args);
+    va_end(args);
+
+    std::lock_guard<std::mutex> lock(writeMutex);
     appLog << szBuf;
     std::cout << szBuf;
 #ifdef DEBUG
@@ -8,6 +8,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <mutex>
+#include <atomic>
 
 class Logger
 {
@@ -19,6 +21,8 @@ protected:
     Logger();
 
     std::ofstream appLog;
+    std::mutex writeMutex;              // Write may be called from several simulation threads
+    std::atomic<bool> enabled{true};
 
     bool LoadStrings();
 
@@ -28,4 +32,8 @@ public:
     bool Init();
 
     void Write(const char *msg, ...);
+
+    // Silence logging (e.g. during batch simulation, where it dominates the frame time)
+    void SetEnabled(bool enable) { enabled = enable; }
+    bool IsEnabled() const { return enabled; }
 };
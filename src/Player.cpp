@@ -5,14 +5,10 @@
 #include "TankHandler.h" // For respawn delay constants
 #include "Logger.h"
 #include "InputHandlerFactory.h"
-#include "GlobalTimer.h"
-#include "App.h"
 #include "FX.h"        // For FxType enum
-#include "SoundTask.h" // For sound playback
 
 // Static constexpr definitions (required in C++14 when ODR-used by std::min/max)
 constexpr float Player::SPECIAL_CHARGE_MAX;
-#include "events/Events.h"
 #include "events/CollisionEvents.h"
 #include <cmath>
 
@@ -123,7 +119,7 @@ void Player::UseSpecialCharge(float cost)
 
 void Player::HandleInput()
 {
-    static int inputLogCounter = 0;
+    static thread_local int inputLogCounter = 0;
 
     if (!controlledTank || !controlledTank->alive || !inputHandler)
     {
@@ -163,46 +159,37 @@ void Player::CheckItemCollisions()
         return;
     }
 
-    // Get all items from GameWorld
-    const auto &items = gameWorld->GetItems();
-
-    for (const auto &itemPtr : items)
-    {
-        if (!itemPtr->IsAlive())
-            continue;
-
-        const Item &item = *itemPtr;
-
+    // One item per frame at most
+    gameWorld->ForEachItem([this](Item &item) {
         // Check collision with controlled tank
-        if (controlledTank->PointCollision(item.x, item.y, item.z))
+        if (!controlledTank->PointCollision(item.GetX(), item.GetY(), item.GetZ()))
         {
-            ApplyItemEffect(&item);
+            return true;
+        }
 
-            // Create pickup effect
-            Events::GetBus().Post(CreateFXEvent(
-                static_cast<int>(FxType::TYPE_THREE),
-                item.x, item.y, item.z,
-                90, 0, 90,
-                item.color.r, item.color.g, item.color.b, 1.0f));
+        ApplyItemEffect(&item);
 
-            // Play pickup sound
-            if (App::GetSingleton().soundTask)
-            {
-                App::GetSingleton().soundTask->PlayChannel(3);
-            }
+        // Create pickup effect
+        gameWorld->GetEventBus().Post(CreateFXEvent(
+            static_cast<int>(FxType::TYPE_THREE),
+            item.GetX(), item.GetY(), item.GetZ(),
+            90, 0, 90,
+            item.GetColor().r, item.GetColor().g, item.GetColor().b, 1.0f));
 
-            // Remove item
-            itemPtr->Kill();
+        // Play pickup sound
+        gameWorld->GetEventBus().Publish(PlaySoundEvent(3));
 
-            Logger::Get().Write("Player %d collected item\n", playerIndex);
-            break; // Only collect one item per frame
-        }
-    }
+        // Remove item
+        item.Kill();
+
+        Logger::Get().Write("Player %d collected item\n", playerIndex);
+        return false;
+    });
 }
 
 void Player::Update()
 {
-    static int logCounter = 0;
+    static thread_local int logCounter = 0;
 
     // Update combo decay
     UpdateComboDecay();
@@ -238,7 +225,7 @@ void Player::Update()
 
             // Check respawn timing
             bool shouldRespawn = false;
-            if (App::GetSingleton().gameTask->IsVersusMode())
+            if (gameWorld->IsVersusMode())
             {
                 if (controlledTank->deadtime > VERSUS_RESPAWN_DELAY)
                 {
@@ -246,7 +233,7 @@ void Player::Update()
                     shouldRespawn = true;
                     ReleaseTank(); // Release before NextLevel to avoid dangling pointer
                     Logger::Get().Write("Player %d: Tank released, controlledTank is now null\n", playerIndex);
-                    LevelHandler::GetSingleton().NextLevel(true);
+                    gameWorld->GetLevelHandler().NextLevel(true);
                     Logger::Get().Write("Player %d: NextLevel(true) completed\n", playerIndex);
                 }
             }
@@ -258,7 +245,7 @@ void Player::Update()
                     shouldRespawn = true;
                     ReleaseTank(); // Release before NextLevel to avoid dangling pointer
                     Logger::Get().Write("Player %d: Tank released, controlledTank is now null\n", playerIndex);
-                    LevelHandler::GetSingleton().NextLevel(false);
+                    gameWorld->GetLevelHandler().NextLevel(false);
                     Logger::Get().Write("Player %d: NextLevel(false) completed\n", playerIndex);
                 }
             }
@@ -266,7 +253,7 @@ void Player::Update()
             // Only increment deadtime and log if we didn't respawn (tank still exists)
             if (!shouldRespawn && controlledTank)
             {
-                controlledTank->deadtime += GlobalTimer::dT;
+                controlledTank->deadtime += gameWorld->GetDeltaTime();
 
                 if (logCounter % 60 == 0)
                 { // Log every 1 second
@@ -317,9 +304,9 @@ void Player::Respawn()
     }
 
     // Get spawn position from LevelHandler
-    float spawnX = LevelHandler::GetSingleton().start[0];
-    float spawnZ = LevelHandler::GetSingleton().start[1];
-    float spawnY = LevelHandler::GetSingleton().GetTerrainHeight(static_cast<int>(spawnX), static_cast<int>(spawnZ));
+    float spawnX = gameWorld->GetLevelHandler().start[0];
+    float spawnZ = gameWorld->GetLevelHandler().start[1];
+    float spawnY = gameWorld->GetLevelHandler().GetTerrainHeight(static_cast<int>(spawnX), static_cast<int>(spawnZ));
 
     Logger::Get().Write("Player %d spawning at position (%.2f, %.2f, %.2f)\n", playerIndex, spawnX, spawnY, spawnZ);
 
@@ -372,7 +359,7 @@ void Player::UpdateComboDecay()
 {
     if (combo > 0.0f)
     {
-        combo -= COMBO_DECAY_RATE * GlobalTimer::dT;
+        combo -= COMBO_DECAY_RATE * gameWorld->GetDeltaTime();
         if (combo <= 0.0f)
         {
             ResetCombo();
@@ -386,10 +373,10 @@ void Player::ApplyItemEffect(const Item *item)
         return;
 
     // Set tank type based on item
-    controlledTank->SetType(item->type, controlledTank->type1);
+    controlledTank->SetType(item->GetType(), controlledTank->type1);
 
     // Restore energy based on item type match
-    if (item->type == controlledTank->type1)
+    if (item->GetType() == controlledTank->type1)
     {
         // Full energy for matching type
         controlledTank->energy += controlledTank->maxEnergy;
@@ -419,5 +406,5 @@ void Player::SetupTankForPlayer(Tank *tank)
     tank->identity = TankIdentity::Player(playerIndex);
 
     // Set up input handler ID for tank
-    tank->jid = playerIndex; // Joystick ID matches player index
+    tank->Cold().jid = playerIndex; // Joystick ID matches player index
 }
\ No newline at end of file
@@ -5,8 +5,6 @@
 #include "InputHandlerFactory.h"
 #include "TankHandler.h"
 #include "Logger.h"
-#include "App.h"
-#include "GlobalTimer.h"
 #include <algorithm>
 #include <cmath>
 #include <SDL2/SDL.h>
@@ -128,7 +126,7 @@ void PlayerManager::EnsurePlayerTankSetup() {
                 // Ensure tank has correct identity
                 tank->identity = TankIdentity::Player(i);
                 tank->isPlayer = true;
-                tank->jid = i;
+                tank->Cold().jid = i;
                 Logger::Get().Write("PlayerManager: Re-validated tank ID for Player %d (id=%d)\n", i, tank->identity.GetLegacyId());
             }
         }
@@ -152,7 +150,7 @@ void PlayerManager::Update() {
 
 void PlayerManager::NextFrame() {
     // Update all players
-    static int frameCounter = 0;
+    static thread_local int frameCounter = 0;
     static constexpr float PLAYER_RESPAWN_DELAY = 0.5f;
     static constexpr float VERSUS_RESPAWN_DELAY = 1.5f;
     
@@ -185,13 +183,13 @@ void PlayerManager::NextFrame() {
                     }
                     
                     // Increment deadtime FIRST, before checking respawn
-                    tank->deadtime += GlobalTimer::dT;
+                    tank->deadtime += gameWorld->GetDeltaTime();
                     tank->Die();
                     
                     if (versusMode) {
                         if (tank->deadtime > VERSUS_RESPAWN_DELAY) {
                             Logger::Get().Write("PlayerManager: Calling NextLevel for versus mode (deadtime=%.2f)\n", tank->deadtime);
-                            LevelHandler::GetSingleton().NextLevel(true);
+                            gameWorld->GetLevelHandler().NextLevel(true);
                             // Tank pointer is now invalid after NextLevel - don't use it again
                             break; // Exit the loop to avoid using stale pointers
                         }
@@ -202,7 +200,7 @@ void PlayerManager::NextFrame() {
                             // Release the old dead tank before NextLevel clears it
                             players[i]->ReleaseTank();
                             
-                            LevelHandler::GetSingleton().NextLevel(false);
+                            gameWorld->GetLevelHandler().NextLevel(false);
                             
                             // After NextLevel, create new player tank at spawn position
                             Logger::Get().Write("PlayerManager: Creating new player tank after respawn\n");
@@ -431,8 +429,20 @@ void PlayerManager::SetupPlayerInputHandler(int playerIndex) {
         Logger::Get().Write("PlayerManager: Player %d using generic joystick input mode\n", playerIndex);
     }
     
+    SetPlayerInputMode(playerIndex, inputMode);
+}
+
+InputMode PlayerManager::GetPlayerInputMode(int playerIndex) const {
+    if (playerIndex < 0 || playerIndex >= MAX_PLAYERS) return InputMode::MODE_KEYBOARD_MOUSE;
+    return inputModes[playerIndex];
+}
+
+void PlayerManager::SetPlayerInputMode(int playerIndex, InputMode mode) {
+    if (playerIndex < 0 || playerIndex >= MAX_PLAYERS || !players[playerIndex]) return;
+    inputModes[playerIndex] = mode;
+
     // Create input handler
-    auto inputHandler = InputHandlerFactory::CreateInputHandler(inputMode);
+    auto inputHandler = InputHandlerFactory::CreateInputHandler(mode);
     if (inputHandler) {
         Logger::Get().Write("PlayerManager: Input handler created successfully for player %d\n", playerIndex);
         players[playerIndex]->SetInputHandler(std::move(inputHandler));
@@ -493,9 +503,9 @@ void PlayerManager::SetPlayerSpawnPosition(Player* player, int playerIndex) {
     if (!player) return;
     
     // Use default spawn position from LevelHandler
-    float spawnX = LevelHandler::GetSingleton().start[0];
-    float spawnZ = LevelHandler::GetSingleton().start[1];
-    float spawnY = LevelHandler::GetSingleton().GetTerrainHeight(static_cast<int>(spawnX), static_cast<int>(spawnZ));
+    float spawnX = gameWorld->GetLevelHandler().start[0];
+    float spawnZ = gameWorld->GetLevelHandler().start[1];
+    float spawnY = gameWorld->GetLevelHandler().GetTerrainHeight(static_cast<int>(spawnX), static_cast<int>(spawnZ));
     
     player->CreatePlayerTank(spawnX, spawnY, spawnZ);
 }
@@ -507,14 +517,14 @@ void PlayerManager::SetPlayerVersusPosition(Player* player, int playerIndex) {
     float spawnX, spawnZ;
     
     if (playerIndex == 0) {
-        spawnX = LevelHandler::GetSingleton().enemy[8][0]; // VERSUS_ENEMY_POSITION_2
-        spawnZ = LevelHandler::GetSingleton().enemy[8][1];
+        spawnX = gameWorld->GetLevelHandler().enemy[8][0]; // VERSUS_ENEMY_POSITION_2
+        spawnZ = gameWorld->GetLevelHandler().enemy[8][1];
     } else {
-        spawnX = LevelHandler::GetSingleton().enemy[9][0]; // VERSUS_ENEMY_POSITION_1  
-        spawnZ = LevelHandler::GetSingleton().enemy[9][1];
+        spawnX = gameWorld->GetLevelHandler().enemy[9][0]; // VERSUS_ENEMY_POSITION_1  
+        spawnZ = gameWorld->GetLevelHandler().enemy[9][1];
     }
     
-    float spawnY = LevelHandler::GetSingleton().GetTerrainHeight(static_cast<int>(spawnX), static_cast<int>(spawnZ));
+    float spawnY = gameWorld->GetLevelHandler().GetTerrainHeight(static_cast<int>(spawnX), static_cast<int>(spawnZ));
     
     player->CreatePlayerTank(spawnX, spawnY, spawnZ);
 }
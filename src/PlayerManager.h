@@ -44,6 +44,8 @@ public:
     // Input handling
     void HandleInput();
     void SetupPlayerControls();
+    InputMode GetPlayerInputMode(int playerIndex) const;
+    void SetPlayerInputMode(int playerIndex, InputMode mode);  // Replaces the player's input handler
     
     // Game state updates
     void Update();
@@ -104,6 +106,7 @@ private:
     // Controller management
     bool isInputJoy = false;
     std::array<int, MAX_PLAYERS> assignedJoysticks = {-1, -1};
+    std::array<InputMode, MAX_PLAYERS> inputModes = {InputMode::MODE_KEYBOARD_MOUSE, InputMode::MODE_JOYSTICK_GENERIC};
     
     // Helper methods
     void CreatePlayer(int index);
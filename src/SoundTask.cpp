@@ -4,6 +4,7 @@
 
 #include "SoundTask.h"
 #include "Logger.h"
+#include "events/CollisionEvents.h"
 #include <iostream>
 #include <SDL2/SDL.h>
 
@@ -105,6 +106,23 @@ void SoundTask::OnResume()
 {
 }
 
+void SoundTask::PlayEvent(const PlaySoundEvent& event)
+{
+    switch (event.mixing)
+    {
+    case PlaySoundEvent::Mixing::POSITION:
+        Mix_SetPosition(event.channel, event.angle, event.distance);
+        break;
+    case PlaySoundEvent::Mixing::VOLUME:
+        Mix_Volume(event.channel, event.volume);
+        break;
+    default:
+        break;
+    }
+
+    PlayChannel(event.channel);
+}
+
 void SoundTask::PlayChannel(int ID)
 {
     if (!disable)
@@ -3,6 +3,8 @@
 #include <SDL2/SDL_mixer.h>
 #include "ITask.h"
 
+struct PlaySoundEvent;
+
 class SoundTask : public ITask
 {
 public:
@@ -16,6 +18,7 @@ public:
     void Stop();
 
     void PlayChannel(int ID);
+    void PlayEvent(const PlaySoundEvent& event);  // Applies positioning/volume, then plays
     void PlayMusic(int ID);
     void PauseMusic();
 
@@ -14,6 +14,7 @@
 
 #include <cmath>
 #include "App.h"
+#include "events/CollisionEvents.h"
 #include "GameWorld.h"
 #include "LevelHandler.h"
 #include "TankHandler.h"
@@ -23,6 +24,29 @@
 #include "TankCollisionHelper.h"
 #include "InputHandlerFactory.h"
 #include "Logger.h"
+#include "profiling/QualityGovernor.h"
+
+#include <utility>
+
+namespace {
+    // Heading from a tank toward a target dx, dz away (dx = tank.x - target.x),
+    // in the [-90, 270) range the AI turn thresholds were tuned for
+    float HeadingFromOffset(float dx, float dz)
+    {
+        const float heading = atan2Deg(-dz, -dx);
+        return (heading < -90.0f) ? heading + 360.0f : heading;
+    }
+}
+
+float Tank::GetDeltaTime() const
+{
+    return gameWorld ? gameWorld->GetDeltaTime() : GlobalTimer::dT;
+}
+
+const QualityBudget& Tank::GetQualityBudget() const
+{
+    return gameWorld ? gameWorld->GetQualityBudget() : QualityGovernor::GetLevelBudget(0);
+}
 
 void Tank::CreateFX(FxType type, float x, float y, float z, float rx, float ry, float rz, float r, float g, float b, float a)
 {
@@ -76,7 +100,7 @@ void Tank::SetType(TankType t1, TankType t2)
 
     // Common initialization
     movRate = 5;
-    jumpCost = 250;
+    cold->jumpCost = 250;
     jumpRate = 18.0f;
     fallRate = 16.0f;
 
@@ -86,9 +110,9 @@ void Tank::SetType(TankType t1, TankType t2)
     attack = config.attack;
     maxEnergy = config.maxEnergy;        // Now consistently named
     energyRegen = config.energyRegen;    // Now consistently named
-    moveCost = config.moveCost;
-    fireCost = config.maxEnergy / 10.0f;  // Using consistent field name
-    specialCost = config.specialCost;     // Now consistently named
+    cold->moveCost = config.moveCost;
+    cold->fireCost = config.maxEnergy / 10.0f;  // Using consistent field name
+    cold->specialCost = config.specialCost;     // Now consistently named
     bounces = config.bounces;
 
     // Colors are now handled dynamically via TankTypeManager
@@ -98,8 +122,8 @@ void Tank::SetType(TankType t1, TankType t2)
 
 void Tank::SetInputMode(InputMode mode)
 {
-    inputMode = mode;
-    inputHandler = InputHandlerFactory::CreateInputHandler(mode);
+    cold->inputMode = mode;
+    cold->inputHandler = InputHandlerFactory::CreateInputHandler(mode);
 }
 
 void Tank::Die()
@@ -109,28 +133,28 @@ void Tank::Die()
     {
         if (identity.IsPlayer())
         {
-            App::GetSingleton().soundTask->PlayChannel(7);
+            gameWorld->GetEventBus().Publish(PlaySoundEvent(7));
         }
         else
         {
-            App::GetSingleton().soundTask->PlayChannel(6);
+            gameWorld->GetEventBus().Publish(PlaySoundEvent(6));
         }
     }
 
-    TankHandler::GetSingleton().numAttackingTanks--;
+    gameWorld->GetTankHandler().numAttackingTanks--;
 
-    if (TankHandler::GetSingleton().GetAllEnemyTanks().size() != 1 && identity.IsEnemy())
+    if (gameWorld->GetTankHandler().GetAllEnemyTanks().size() != 1 && identity.IsEnemy())
     {
-        LevelHandler::GetSingleton().AddItem(x, y + .2, z, type1);
+        gameWorld->GetLevelHandler().AddItem(x, y + .2, z, type1);
     }
 
     if (deadtime < 0.01)
     {
         CreateDeathExplosionFX();
     }
-    if (TankHandler::GetSingleton().GetAllEnemyTanks().size() == 1 && identity.IsEnemy())
+    if (gameWorld->GetTankHandler().GetAllEnemyTanks().size() == 1 && identity.IsEnemy())
     {
-        LevelHandler::GetSingleton().SetTerrainHeight(static_cast<int>(x), static_cast<int>(z), -20);
+        gameWorld->GetLevelHandler().SetTerrainHeight(static_cast<int>(x), static_cast<int>(z), -20);
     }
 }
 
@@ -152,60 +176,44 @@ void Tank::Fire(float dTpressed)
         return;
     }
     
-    if (energy >= fireCost && fireTimer > fireRate)
+    if (energy >= cold->fireCost && fireTimer > fireRate)
     {
         Logger::Get().Write("Tank::Fire - id=%d, creating bullet at (%.2f, %.2f, %.2f)\n", identity.GetLegacyId(), x, y, z);
         
         // Get player tank from PlayerManager for audio positioning
-        auto playerTanks = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerTanks();
+        auto playerTanks = gameWorld->GetPlayerManager().GetPlayerTanks();
         Tank* player0 = playerTanks[0];
         
         // Calculate audio positioning if player tank exists and is alive
         if (player0 && player0->alive) {
             float dx = x - player0->x;
             float dz = z - player0->z;
-            float ryp;
-            
-            // Safety: Check for division by zero
-            if (std::abs(dx) < 0.001f) {
-                // Vertically aligned - angle is 90 or -90 degrees
-                ryp = (dz > 0.0f ? 90.0f : -90.0f);
-            } else {
-                float ratio = dz / dx;
-                ryp = toDegrees(atan(ratio));
-
-                if (player0->x < x)
-                {
-                    ryp += 180;
-                }
-            }
+            float ryp = HeadingFromOffset(dx, dz);
 
             ryp -= (player0->ry + player0->rty);
 
-            float dist = sqrt(dx * dx + dz * dz);
+            float dist = fastSqrt(dx * dx + dz * dz);
 
-            Mix_SetPosition(2, ryp, 10 * static_cast<int>(dist));
+            gameWorld->GetEventBus().Publish(PlaySoundEvent::Positioned(2, ryp, 10 * static_cast<int>(dist)));
         } else {
             // No valid player tank - use default audio positioning
-            Mix_SetPosition(2, 0, 0);
+            gameWorld->GetEventBus().Publish(PlaySoundEvent::Positioned(2, 0, 0));
         }
 
-        App::GetSingleton().soundTask->PlayChannel(2);
-
         float bulletMovRate = 33.0f;
 
         Color primaryColor = GetPrimaryColor();
         Color secondaryColor = GetSecondaryColor();
         gameWorld->CreateBullet(identity, attack, type1, type2, bounces,
                     dTpressed, primaryColor, secondaryColor,
-                    x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                    x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                     y + .25,
-                    z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                    z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                     rtx + rx, rty + ry, rtz + rz);
 
         fireTimer = 0;
 
-        energy -= fireCost;
+        energy -= cold->fireCost;
     }
 }
 
@@ -234,43 +242,28 @@ void Tank::Special(float dTpressed)
     
     // Safety: Validate array index for TankHandler::special (size 2)
     // Get player from PlayerManager
-    Player* player = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerByTankId(identity.GetLegacyId());
+    Player* player = gameWorld->GetPlayerManager().GetPlayerByTankId(identity.GetLegacyId());
     if (!player) {
         Logger::Get().Write("WARNING: Tank::Special - no player found for tank id=%d\n", identity.GetLegacyId());
         return;
     }
 
-    if (player->CanUseSpecial(fireCost / 5) && fireTimer > fireRate)
+    if (player->CanUseSpecial(cold->fireCost / 5) && fireTimer > fireRate)
     {
         // Get player tank from PlayerManager for audio positioning
-        auto playerTanks = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerTanks();
+        auto playerTanks = gameWorld->GetPlayerManager().GetPlayerTanks();
         Tank* player0 = playerTanks[0];
         if (!player0 || !player0->alive) return; // No valid player tank available
         
         float dx = x - player0->x;
         float dz = z - player0->z;
-        float ryp;
-        
-        // Safety: Check for division by zero
-        if (std::abs(dx) < 0.001f) {
-            ryp = (dz > 0.0f ? 90.0f : -90.0f);
-        } else {
-            float ratio = dz / dx;
-            ryp = toDegrees(atan(ratio));
-
-            if (player0->x < x)
-            {
-                ryp += 180;
-            }
-        }
+        float ryp = HeadingFromOffset(dx, dz);
 
         ryp -= (player0->ry + player0->rty);
 
-        float dist = sqrt(dx * dx + dz * dz);
+        float dist = fastSqrt(dx * dx + dz * dz);
 
-        Mix_SetPosition(2, ryp, 10 * static_cast<int>(dist));
-
-        App::GetSingleton().soundTask->PlayChannel(2);
+        gameWorld->GetEventBus().Publish(PlaySoundEvent::Positioned(2, ryp, 10 * static_cast<int>(dist)));
 
         float bulletMovRate = 33.0f;
 
@@ -281,9 +274,9 @@ void Tank::Special(float dTpressed)
         Bullet temp(identity, attack, type1, type2, bounces,
                     dTpressed,
                     primaryColor, secondaryColor,
-                    x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                    x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                     y + .25,
-                    z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                    z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                     rtx + rx, rty + ry, rtz + rz);
 
         if (type1 == TankType::TYPE_RED)
@@ -307,25 +300,25 @@ void Tank::Special(float dTpressed)
             CreateBullet(identity, attack, type1, type2, bounces,
                         dTpressed,
                         primaryColor, secondaryColor,
-                        x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                        x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                         y + .25,
-                        z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                        z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                         rtx + rx, rty + ry, rtz + rz);
             
             CreateBullet(identity, attack, type1, type2, bounces,
                         dTpressed,
                         primaryColor, secondaryColor,
-                        x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                        x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                         y + .25,
-                        z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                        z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                         rtx + rx, rty + ry - 10, rtz + rz);
 
             CreateBullet(identity, attack, type1, type2, bounces,
                          dTpressed,
                          primaryColor, secondaryColor,
-                         x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                         x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                          y + .25,
-                         z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                         z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                          rtx + rx, rty + ry + 20, rtz + rz);
         }
         if (type1 == TankType::TYPE_BLUE)
@@ -338,18 +331,18 @@ void Tank::Special(float dTpressed)
                 CreateBullet(identity, attack, type1, type2, bounces,
                             dTpressed,
                             primaryColor, secondaryColor,
-                            x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                            x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                             y + .50,
-                            z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                            z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                             rtx + rx, rty + ry, rtz + rz);
             }
 
             CreateBullet(identity, attack, type1, type2, bounces,
                         dTpressed,
                         primaryColor, secondaryColor,
-                        x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR) + .2 * std::cosf((rty + ry + 90) * DTR),
+                        x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry) + .2 * cosDeg(rty + ry + 90),
                         y + .25,
-                        z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR) + .2 * std::sinf((rty + ry + 90) * DTR),
+                        z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry) + .2 * sinDeg(rty + ry + 90),
                         rtx + rx, rty + ry, rtz + rz);
         }
 
@@ -363,9 +356,9 @@ void Tank::Special(float dTpressed)
                 CreateBullet(identity, attack, type1, type2, 4,
                             dTpressed,
                             primaryColor, secondaryColor,
-                            x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                            x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                             y + .25,
-                            z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                            z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                             rtx + rx, rty + ry, rtz + rz);
             }
 
@@ -373,9 +366,9 @@ void Tank::Special(float dTpressed)
             CreateBullet(identity, attack, type1, type2, 4,
                         dTpressed,
                         primaryColor, secondaryColor,
-                        x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                        x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                         y + .25,
-                        z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                        z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                         rtx + rx, rty + ry, rtz + rz);
         }
 
@@ -387,39 +380,39 @@ void Tank::Special(float dTpressed)
             CreateBullet(identity, attack, type1, type2, bounces,
                         dTpressed,
                         primaryColor, secondaryColor,
-                        x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                        x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                         y + .25,
-                        z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                        z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                         rtx + rx, rty + ry, rtz + rz);
 
             CreateBullet(identity, attack, type1, type2, bounces,
                          dTpressed,
                          primaryColor, secondaryColor,
-                         x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                         x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                          y + .25,
-                         z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                         z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                          rtx + rx, rty + ry - 90, rtz + rz);
 
             CreateBullet(identity, attack, type1, type2, bounces,
                          dTpressed,
                          primaryColor, secondaryColor,
-                         x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                         x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                          y + .25,
-                         z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                         z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                          rtx + rx, rty + ry + 180, rtz + rz);
 
             CreateBullet(identity, attack, type1, type2, bounces,
                          dTpressed,
                          primaryColor, secondaryColor,
-                         x + (GlobalTimer::dT * bulletMovRate) * std::cosf((rty + ry) * DTR),
+                         x + (GetDeltaTime() * bulletMovRate) * cosDeg(rty + ry),
                          y + .25,
-                         z + (GlobalTimer::dT * bulletMovRate) * std::sinf((rty + ry) * DTR),
+                         z + (GetDeltaTime() * bulletMovRate) * sinDeg(rty + ry),
                          rtx + rx, rty + ry + 90, rtz + rz);
         }
 
         fireTimer = 0;
 
-        player->UseSpecialCharge(fireCost / 5);
+        player->UseSpecialCharge(cold->fireCost / 5);
     }
 }
 
@@ -428,7 +421,8 @@ bool Tank::PointCollision(float cx, float cy, float cz) const
     bool result = false;
     if ((cy - y) < 0.3f && (y - cy) < 0)
     {
-        if (sqrt((cx - x) * (cx - x) + (cz - z) * (cz - z)) < collisionRadius * 2)
+        const float reach = collisionRadius * 2;
+        if ((cx - x) * (cx - x) + (cz - z) * (cz - z) < reach * reach)
         {
             result = true;
         }
@@ -439,25 +433,25 @@ bool Tank::PointCollision(float cx, float cy, float cz) const
 void Tank::Fall()
 {
 
-    vy -= (fallRate * GlobalTimer::dT);
+    vy -= (fallRate * GetDeltaTime());
 
-    float dy = vy * GlobalTimer::dT;
+    float dy = vy * GetDeltaTime();
     
     // Debug logging for player tanks (only log occasionally)
-    static int fallLogCounter = 0;
+    static thread_local int fallLogCounter = 0;
     if (identity.IsPlayer() && fallLogCounter++ % 60 == 0 && !isGrounded) {
         Logger::Get().Write("Tank %d FALL: y=%.3f vy=%.3f dy=%.3f isJumping=%d\n", 
                           identity.GetLegacyId(), y, vy, dy, isJumping);
     }
 
-    if (dy > 10.0f * GlobalTimer::dT)
+    if (dy > 10.0f * GetDeltaTime())
     {
-        dy = 10.0f * GlobalTimer::dT;
+        dy = 10.0f * GetDeltaTime();
     }
 
-    if (dy < -15.0f * GlobalTimer::dT)
+    if (dy < -15.0f * GetDeltaTime())
     {
-        dy = -15.0f * GlobalTimer::dT;
+        dy = -15.0f * GetDeltaTime();
     }
 
     y += dy;
@@ -491,7 +485,7 @@ void Tank::Fall()
             }
             if (identity.IsPlayer())
             {
-                App::GetSingleton().soundTask->PlayChannel(5);
+                gameWorld->GetEventBus().Publish(PlaySoundEvent(5));
             }
         }
         isJumping = false;
@@ -509,9 +503,9 @@ void Tank::Fall()
 
         if (highest < -10 && identity.IsPlayer())
         {
-            LevelHandler::GetSingleton().NextLevel(true);
-            x = LevelHandler::GetSingleton().start[0];
-            z = LevelHandler::GetSingleton().start[1];
+            gameWorld->GetLevelHandler().NextLevel(true);
+            x = gameWorld->GetLevelHandler().start[0];
+            z = gameWorld->GetLevelHandler().start[1];
             y = 24;
         }
         else
@@ -520,7 +514,7 @@ void Tank::Fall()
             if (!isGrounded)
             {
                 if (identity.IsPlayer())
-                    App::GetSingleton().soundTask->PlayChannel(5);
+                    gameWorld->GetEventBus().Publish(PlaySoundEvent(5));
             }
         }
         if (!isGrounded)
@@ -541,8 +535,8 @@ void Tank::Fall()
 }
 
 Tank::Tank()
+    : cold(new TankColdData())
 {
-    x = y = z = 0.0f;
     vx = vy = vz = 0.0f;
     rx = ry = rz = 0.0f;
     rtx = rty = rtz = 0.0f;
@@ -550,8 +544,6 @@ Tank::Tank()
     rr = 0.0f;
     // Color fields removed - now handled dynamically via TankTypeManager
 
-    jid = 0;
-    inputMode = InputMode::MODE_KEYBOARD_MOUSE;
     identity = TankIdentity::Enemy(0);  // Default to enemy, will be overridden
     hitNum = 0;
     hitAlpha = 0.0f;
@@ -576,12 +568,7 @@ Tank::Tank()
     energy = 100.0f;        // Was: charge (now clearly for actions)
     maxEnergy = 100.0f;     // Was: maxCharge
     energyRegen = 2.0f;     // Fast energy regeneration
-    
-    // Action costs
-    fireCost = 10.0f;       // Energy cost to fire
-    jumpCost = 15.0f;       // Energy cost to jump
-    moveCost = 0.1f;        // Energy cost for movement
-    specialCost = 25.0f;    // Energy cost for special abilities
+    // Action costs and wall probes start at the TankColdData defaults
 
     collisionRadius = 0.0f;
     rotRate = 0.0f;
@@ -591,17 +578,14 @@ Tank::Tank()
     fireRate = 0.0f;
     fallRate = 0.0f;
     dist = 0.0f;
-    control = 0;
     bounces = 0.0f;
     // Color fields removed - now handled dynamically via TankTypeManager
     attack = 0.0f;
     alive = true;
     isPlayer = false;
 
-    collisionPoints[21] = {0};
-    
     // Initialize input handler after setting inputMode
-    inputHandler = InputHandlerFactory::CreateInputHandler(inputMode);
+    cold->inputHandler = InputHandlerFactory::CreateInputHandler(cold->inputMode);
 }
 
 Tank::~Tank()
@@ -620,103 +604,93 @@ void Tank::CreateBullet(const TankIdentity& ownerIdentity, float attack, TankTyp
 }
 
 Tank::Tank(Tank&& other) noexcept
-    : isPlayer(other.isPlayer),
+    : vx(other.vx), vy(other.vy), vz(other.vz),
+      rx(other.rx), ry(other.ry), rz(other.rz), rr(other.rr), rrl(other.rrl),
+      rtx(other.rtx), rty(other.rty), rtz(other.rtz),
       health(other.health),
       maxHealth(other.maxHealth),
       healthRegen(other.healthRegen),
       energy(other.energy),
       maxEnergy(other.maxEnergy),
       energyRegen(other.energyRegen),
-      fireCost(other.fireCost),
-      jumpCost(other.jumpCost),
-      moveCost(other.moveCost),
-      specialCost(other.specialCost),
       fireTimer(other.fireTimer),
       fireRate(other.fireRate),
-      bounces(other.bounces),
-      attack(other.attack),
-      alive(other.alive),
-      identity(other.identity),
-      x(other.x), y(other.y), z(other.z),
-      vx(other.vx), vy(other.vy), vz(other.vz),
-      collisionRadius(other.collisionRadius),
-      control(other.control),
-      inputMode(other.inputMode),
-      jid(other.jid),
-      inputHandler(std::move(other.inputHandler)),
-      rx(other.rx), ry(other.ry), rz(other.rz), rr(other.rr), rrl(other.rrl),
-      rtx(other.rtx), rty(other.rty), rtz(other.rtz),
       rotRate(other.rotRate), movRate(other.movRate), jumpRate(other.jumpRate),
       fallRate(other.fallRate),
+      collisionRadius(other.collisionRadius),
+      dist(other.dist),
+      jumpTime(other.jumpTime),
+      bonusTime(other.bonusTime),
+      deadtime(other.deadtime),
+      hitAlpha(other.hitAlpha),
+      bonus(other.bonus),
+      hitNum(other.hitNum),
+      bounces(other.bounces),
+      attack(other.attack),
       type1(other.type1),
       type2(other.type2),
       // Color fields removed - now handled dynamically via TankTypeManager
-      dist(other.dist),
+      identity(other.identity),
+      alive(other.alive),
+      isPlayer(other.isPlayer),
       isJumping(other.isJumping),
       isGrounded(other.isGrounded),
-      jumpTime(other.jumpTime),
       turbo(other.turbo),
-      bonus(other.bonus),
-      bonusTime(other.bonusTime),
-      deadtime(other.deadtime),
-      hitAlpha(other.hitAlpha),
-      hitNum(other.hitNum)
+      smokeEmitter(other.smokeEmitter),
+      jumpEmitter(other.jumpEmitter),
+      aiState(other.aiState),
+      aiTargetsPlayer1(other.aiTargetsPlayer1),
+      aiTicksUntilDecision(other.aiTicksUntilDecision),
+      cold(std::move(other.cold))
 {
-    // Copy collision points array
-    for (int i = 0; i < 21; ++i) {
-        collisionPoints[i] = other.collisionPoints[i];
-    }
+    // The moved-from tank is left without cold data: nothing is allocated here
+    x = other.x; y = other.y; z = other.z;
 }
 
 Tank& Tank::operator=(Tank&& other) noexcept
 {
     if (this != &other) {
-        isPlayer = other.isPlayer;
+        x = other.x; y = other.y; z = other.z;
+        vx = other.vx; vy = other.vy; vz = other.vz;
+        rx = other.rx; ry = other.ry; rz = other.rz; rr = other.rr; rrl = other.rrl;
+        rtx = other.rtx; rty = other.rty; rtz = other.rtz;
         health = other.health;
         maxHealth = other.maxHealth;
         healthRegen = other.healthRegen;
         energy = other.energy;
         maxEnergy = other.maxEnergy;
         energyRegen = other.energyRegen;
-        fireCost = other.fireCost;
-        jumpCost = other.jumpCost;
-        moveCost = other.moveCost;
-        specialCost = other.specialCost;
         fireTimer = other.fireTimer;
         fireRate = other.fireRate;
-        bounces = other.bounces;
-        attack = other.attack;
-        alive = other.alive;
-        identity = other.identity;
-        x = other.x; y = other.y; z = other.z;
-        vx = other.vx; vy = other.vy; vz = other.vz;
-        collisionRadius = other.collisionRadius;
-        control = other.control;
-        inputMode = other.inputMode;
-        jid = other.jid;
-        inputHandler = std::move(other.inputHandler);
-        rx = other.rx; ry = other.ry; rz = other.rz; rr = other.rr; rrl = other.rrl;
-        rtx = other.rtx; rty = other.rty; rtz = other.rtz;
         rotRate = other.rotRate; movRate = other.movRate; jumpRate = other.jumpRate;
         fallRate = other.fallRate;
-        type1 = other.type1;
-        type2 = other.type2;
-        // Color fields removed - now handled dynamically via TankTypeManager
+        collisionRadius = other.collisionRadius;
         dist = other.dist;
-        isJumping = other.isJumping;
-        isGrounded = other.isGrounded;
         jumpTime = other.jumpTime;
-        turbo = other.turbo;
-        bonus = other.bonus;
         bonusTime = other.bonusTime;
         deadtime = other.deadtime;
         hitAlpha = other.hitAlpha;
+        bonus = other.bonus;
         hitNum = other.hitNum;
-        
-        // Copy collision points array
-        for (int i = 0; i < 21; ++i) {
-            collisionPoints[i] = other.collisionPoints[i];
-        }
+        bounces = other.bounces;
+        attack = other.attack;
+        type1 = other.type1;
+        type2 = other.type2;
+        // Color fields removed - now handled dynamically via TankTypeManager
+        identity = other.identity;
+        alive = other.alive;
+        isPlayer = other.isPlayer;
+        isJumping = other.isJumping;
+        isGrounded = other.isGrounded;
+        turbo = other.turbo;
+        smokeEmitter = other.smokeEmitter;
+        jumpEmitter = other.jumpEmitter;
+        aiState = other.aiState;
+        aiTargetsPlayer1 = other.aiTargetsPlayer1;
+        aiTicksUntilDecision = other.aiTicksUntilDecision;
+
+        // Cold data (costs, probes, input handler) changes hands as a whole
+        std::swap(cold, other.cold);
     }
     return *this;
 }
@@ -746,46 +720,46 @@ void Tank::Init()
     maxEnergy = 100;
     energyRegen = 50;
 
-    moveCost = 0;
-    jumpCost = 150;
-    fireCost = maxEnergy / 2;
-    specialCost = 200;
+    cold->moveCost = 0;
+    cold->jumpCost = 150;
+    cold->fireCost = maxEnergy / 2;
+    cold->specialCost = 200;
 
     bounces = 2;
 
     collisionRadius = 0.2;
 
-    collisionPoints[0] = collisionRadius;
-    collisionPoints[1] = 0;
-    collisionPoints[2] = collisionRadius;
+    cold->collisionPoints[0] = collisionRadius;
+    cold->collisionPoints[1] = 0;
+    cold->collisionPoints[2] = collisionRadius;
 
-    collisionPoints[3] = -1 * collisionRadius;
-    collisionPoints[4] = 0;
-    collisionPoints[5] = -1 * collisionRadius;
+    cold->collisionPoints[3] = -1 * collisionRadius;
+    cold->collisionPoints[4] = 0;
+    cold->collisionPoints[5] = -1 * collisionRadius;
 
-    collisionPoints[6] = -1 * collisionRadius;
-    collisionPoints[7] = 0;
-    collisionPoints[8] = collisionRadius;
+    cold->collisionPoints[6] = -1 * collisionRadius;
+    cold->collisionPoints[7] = 0;
+    cold->collisionPoints[8] = collisionRadius;
 
-    collisionPoints[9] = collisionRadius;
-    collisionPoints[10] = 0;
-    collisionPoints[11] = -1 * collisionRadius;
+    cold->collisionPoints[9] = collisionRadius;
+    cold->collisionPoints[10] = 0;
+    cold->collisionPoints[11] = -1 * collisionRadius;
 
-    collisionPoints[12] = 0;
-    collisionPoints[13] = 0;
-    collisionPoints[14] = 0;
+    cold->collisionPoints[12] = 0;
+    cold->collisionPoints[13] = 0;
+    cold->collisionPoints[14] = 0;
 
-    collisionPoints[15] = 0;
-    collisionPoints[16] = 0;
-    collisionPoints[17] = 0;
+    cold->collisionPoints[15] = 0;
+    cold->collisionPoints[16] = 0;
+    cold->collisionPoints[17] = 0;
 
-    collisionPoints[18] = 0;
-    collisionPoints[19] = 0;
-    collisionPoints[20] = 0;
+    cold->collisionPoints[18] = 0;
+    cold->collisionPoints[19] = 0;
+    cold->collisionPoints[20] = 0;
 
-    x = LevelHandler::GetSingleton().start[0];
+    x = gameWorld->GetLevelHandler().start[0];
     y = 24;
-    z = LevelHandler::GetSingleton().start[1];
+    z = gameWorld->GetLevelHandler().start[1];
     ;
     rx = 0;
     ry = 0;
@@ -818,24 +792,24 @@ void Tank::RotBody(float rate)
         rate = -1;
     }
 
-    ry += rate * rotRate * GlobalTimer::dT;
+    ry += rate * rotRate * GetDeltaTime();
 }
 
 void Tank::RotBody(bool forb)
 {
     if (forb)
     {
-        ry += rotRate * GlobalTimer::dT;
+        ry += rotRate * GetDeltaTime();
     }
     else
     {
-        ry -= rotRate * GlobalTimer::dT;
+        ry -= rotRate * GetDeltaTime();
     }
 }
 
 void Tank::RotTurret(float rate)
 {
-    float rtplus = rate * 10 * GlobalTimer::dT;
+    float rtplus = rate * 10 * GetDeltaTime();
 
     if (rtplus > 2.5)
     {
@@ -869,17 +843,17 @@ void Tank::Jump()
             }
         }
         
-        jumpTime += GlobalTimer::dT;
-        energy -= jumpCost * GlobalTimer::dT;
+        jumpTime += GetDeltaTime();
+        energy -= cold->jumpCost * GetDeltaTime();
         
         // Continue jump if we have energy
         if (energy > 5)
         {
             // Add slight upward boost during jump for height control
-            vy += (jumpRate * GlobalTimer::dT);
+            vy += (jumpRate * GetDeltaTime());
         }
 
-        // y += vy*GlobalTimer::dT;
+        // y += vy*GetDeltaTime();
 
         // Check for float collision with upward offset during jump
         if (TankCollisionHelper::CheckFourPointFloatCollision(*this, 0.2f))
@@ -890,10 +864,13 @@ void Tank::Jump()
 
         // Jump damn it
         Color primaryColor = GetPrimaryColor();
-        CreateFX(FxType::TYPE_JUMP, x, y - .2, z, 0, .5 * vy * GlobalTimer::dT, 0, rx, ry, rz, primaryColor.r, primaryColor.g, primaryColor.b, 1);
+        for (int i = jumpEmitter.Advance(GetDeltaTime(), GetQualityBudget().particleSpawnScale); i > 0; i--)
+        {
+            CreateFX(FxType::TYPE_JUMP, x, y - .2, z, 0, .5 * vy * GetDeltaTime(), 0, rx, ry, rz, primaryColor.r, primaryColor.g, primaryColor.b, 1);
+        }
         if (!isJumping && identity.IsPlayer())
         {
-            App::GetSingleton().soundTask->PlayChannel(4);
+            gameWorld->GetEventBus().Publish(PlaySoundEvent(4));
         }
         isJumping = true;
     }
@@ -905,9 +882,10 @@ void Tank::NextFrame()
     if (!isJumping)
     {
         jumpTime = 0.0f;
+        jumpEmitter.Reset();
     }
 
-    bonusTime += GlobalTimer::dT;
+    bonusTime += GetDeltaTime();
     if (bonusTime > 1)
     {
         bonus = 0;
@@ -915,12 +893,12 @@ void Tank::NextFrame()
 
     if (hitAlpha > 0)
     {
-        hitAlpha -= 1 * GlobalTimer::dT;
+        hitAlpha -= 1 * GetDeltaTime();
     }
 
     // Safety: Only update hitCombo for player tanks
     if (identity.IsPlayer()) {
-        Player* player = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerByTankId(identity.GetLegacyId());
+        Player* player = gameWorld->GetPlayerManager().GetPlayerByTankId(identity.GetLegacyId());
         if (player) {
             int currentHitCombo = player->GetHitCombo();
             if (currentHitCombo != hitNum)
@@ -934,13 +912,13 @@ void Tank::NextFrame()
     // === REFACTORED: Update health and energy systems ===
     
     // Clamp health to valid range
-    if (health > maxHealth && !App::GetSingleton().gameTask->IsDebugMode())
+    if (health > maxHealth && !gameWorld->IsDebugMode())
     {
         health = maxHealth;
     }
     
     // Clamp energy to valid range
-    if (energy > maxEnergy && !App::GetSingleton().gameTask->IsDebugMode())
+    if (energy > maxEnergy && !gameWorld->IsDebugMode())
     {
         energy = maxEnergy;
     }
@@ -948,7 +926,14 @@ void Tank::NextFrame()
     // Smoke effect when health is low (was energy < maxEnergy / 2)
     if (health < maxHealth / 2)
     {
-        CreateFX(FxType::TYPE_SMOKE, x, y + .1, z, 0, .01, 0, 0, ry + rty, 90, .2, .2, .2, 1);
+        for (int i = smokeEmitter.Advance(GetDeltaTime(), GetQualityBudget().particleSpawnScale); i > 0; i--)
+        {
+            CreateFX(FxType::TYPE_SMOKE, x, y + .1, z, 0, .01, 0, 0, ry + rty, 90, .2, .2, .2, 1);
+        }
+    }
+    else
+    {
+        smokeEmitter.Reset();
     }
 
     // Boundary checks
@@ -968,10 +953,10 @@ void Tank::NextFrame()
     if (health <= 0 && alive)
     {
         alive = false;
-        if (identity.IsPlayer() && App::GetSingleton().gameTask->IsVersusMode())
+        if (identity.IsPlayer() && gameWorld->IsVersusMode())
         {
             // Award win to the other player in versus mode
-            Player* player = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerByTankId(identity.GetLegacyId());
+            Player* player = gameWorld->GetPlayerManager().GetPlayerByTankId(identity.GetLegacyId());
             if (player) {
                 player->AddWin();
             }
@@ -979,12 +964,12 @@ void Tank::NextFrame()
     }
     else
     {
-        fireTimer += GlobalTimer::dT;
+        fireTimer += GetDeltaTime();
         Fall();
         
         // Health regeneration (slow, for survival)
         if (health < maxHealth && alive) {
-            health += healthRegen * GlobalTimer::dT;
+            health += healthRegen * GetDeltaTime();
             if (health > maxHealth) {
                 health = maxHealth;
             }
@@ -992,7 +977,7 @@ void Tank::NextFrame()
         
         // Energy regeneration (faster, for actions)
         if (energy < maxEnergy) {
-            energy += energyRegen * GlobalTimer::dT;
+            energy += energyRegen * GetDeltaTime();
             if (energy > maxEnergy) {
                 energy = maxEnergy;
             }
@@ -1002,6 +987,8 @@ void Tank::NextFrame()
 
 bool Tank::Move(float rate)
 {
+    const float* collisionPoints = cold->collisionPoints;
+
     if (rate > 1.25)
     {
         rate = 1.25;
@@ -1016,8 +1003,10 @@ bool Tank::Move(float rate)
 
     bool moved = true;
 
-    vx = rate * (GlobalTimer::dT * movRate) * std::cosf(ry * DTR);
-    vz = rate * (GlobalTimer::dT * movRate) * std::sinf(ry * DTR);
+    float sinRy, cosRy;
+    sinCosDeg(ry, sinRy, cosRy);
+    vx = rate * (GetDeltaTime() * movRate) * cosRy;
+    vz = rate * (GetDeltaTime() * movRate) * sinRy;
 
     x += vx;
     z += vz;
@@ -1046,22 +1035,22 @@ bool Tank::Move(float rate)
         else
         {
             // Fallback to manual checking if helper doesn't find the point
-            if (LevelHandler::GetSingleton().PointCollision(x + collisionPoints[0], y, z + collisionPoints[2]))
+            if (gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[0], y, z + collisionPoints[2]))
             {
                 CreateFX(FxType::TYPE_SMOKE, x - vx + collisionPoints[0], y, z - vz + collisionPoints[2], 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
                 which = 0;
             }
-            else if (LevelHandler::GetSingleton().PointCollision(x + collisionPoints[3], y, z + collisionPoints[5]))
+            else if (gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[3], y, z + collisionPoints[5]))
             {
                 CreateFX(FxType::TYPE_SMOKE, x - vx + collisionPoints[3], y, z - vz + collisionPoints[5], 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
                 which = 1;
             }
-            else if (LevelHandler::GetSingleton().PointCollision(x + collisionPoints[6], y, z + collisionPoints[8]))
+            else if (gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[6], y, z + collisionPoints[8]))
             {
                 CreateFX(FxType::TYPE_SMOKE, x - vx + collisionPoints[6], y, z - vz + collisionPoints[8], 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
                 which = 2;
             }
-            else if (LevelHandler::GetSingleton().PointCollision(x + collisionPoints[9], y, z + collisionPoints[11]))
+            else if (gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[9], y, z + collisionPoints[11]))
             {
                 CreateFX(FxType::TYPE_SMOKE, x - vx + collisionPoints[9], y, z - vz + collisionPoints[11], 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
                 which = 3;
@@ -1086,7 +1075,7 @@ bool Tank::Move(float rate)
         // else
         if (static_cast<int>(x + collisionPoints[kx] + vx) != static_cast<int>(x + collisionPoints[kx]) && static_cast<int>(z + collisionPoints[kz] + vz) != static_cast<int>(z + collisionPoints[kz]))
         {
-            if (LevelHandler::GetSingleton().PointCollision((x + vx + collisionPoints[kx]), y, z + collisionPoints[kz]) && !LevelHandler::GetSingleton().PointCollision(x + collisionPoints[kx], y, z + vz + collisionPoints[kz]))
+            if (gameWorld->GetLevelHandler().PointCollision((x + vx + collisionPoints[kx]), y, z + collisionPoints[kz]) && !gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[kx], y, z + vz + collisionPoints[kz]))
             {
                 z += vz / 2;
             }
@@ -1106,7 +1095,7 @@ bool Tank::Move(float rate)
         moved = false;
     }
 
-    energy -= rate * moveCost * GlobalTimer::dT;
+    energy -= rate * cold->moveCost * GetDeltaTime();
 
     if (x >= 128 || x <= 0 || z >= 128 || z <= 0)
     {
@@ -1119,11 +1108,14 @@ bool Tank::Move(float rate)
 
 bool Tank::Move(bool forb)
 {
+    const float* collisionPoints = cold->collisionPoints;
     Color primaryColor = GetPrimaryColor();
     bool moved;
 
-    vx = (GlobalTimer::dT * movRate) * std::cosf(ry * DTR);
-    vz = (GlobalTimer::dT * movRate) * std::sinf(ry * DTR);
+    float sinRy, cosRy;
+    sinCosDeg(ry, sinRy, cosRy);
+    vx = (GetDeltaTime() * movRate) * cosRy;
+    vz = (GetDeltaTime() * movRate) * sinRy;
 
     if (forb)
     {
@@ -1154,19 +1146,19 @@ bool Tank::Move(bool forb)
 
     if (isPlayer && isGrounded)
     {
-        float treadPointX = 0.25f * std::cosf((ry + 45) * DTR);
-        float treadPointZ = 0.25f * std::sinf((ry + 45) * DTR);
+        float treadPointX = 0.25f * cosDeg(ry + 45);
+        float treadPointZ = 0.25f * sinDeg(ry + 45);
 
         CreateFX(FxType::TYPE_SMALL_RECTANGLE, x - vx + treadPointX, y - 0.18, z - vz + treadPointZ, 0, ry, 0, primaryColor.r, primaryColor.g, primaryColor.b, 1);
 
-        treadPointX = 0.25f * std::cosf((ry + 315) * DTR);
-        treadPointZ = 0.25f * std::sinf((ry + 315) * DTR);
+        treadPointX = 0.25f * cosDeg(ry + 315);
+        treadPointZ = 0.25f * sinDeg(ry + 315);
 
         CreateFX(FxType::TYPE_SMALL_RECTANGLE, x - vx + treadPointX, y - 0.18, z - vz + treadPointZ, 0, ry, 0, primaryColor.r, primaryColor.g, primaryColor.b, 1);
     }
 
     // Check for collision using helper (includes center point + four corner points)
-    if (LevelHandler::GetSingleton().PointCollision(x, y, z) || TankCollisionHelper::CheckFourPointCollision(*this))
+    if (gameWorld->GetLevelHandler().PointCollision(x, y, z) || TankCollisionHelper::CheckFourPointCollision(*this))
     {
         if (!forb)
         {
@@ -1188,22 +1180,22 @@ bool Tank::Move(bool forb)
         else
         {
             // Fallback to manual checking if helper doesn't find the point
-            if (LevelHandler::GetSingleton().PointCollision(x + collisionPoints[0], y, z + collisionPoints[2]))
+            if (gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[0], y, z + collisionPoints[2]))
             {
                 CreateFX(FxType::TYPE_SMOKE, x - vx + collisionPoints[0], y, z - vz + collisionPoints[2], 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
                 which = 0;
             }
-            else if (LevelHandler::GetSingleton().PointCollision(x + collisionPoints[3], y, z + collisionPoints[5]))
+            else if (gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[3], y, z + collisionPoints[5]))
             {
                 CreateFX(FxType::TYPE_SMOKE, x - vx + collisionPoints[3], y, z - vz + collisionPoints[5], 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
                 which = 1;
             }
-            else if (LevelHandler::GetSingleton().PointCollision(x + collisionPoints[6], y, z + collisionPoints[8]))
+            else if (gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[6], y, z + collisionPoints[8]))
             {
                 CreateFX(FxType::TYPE_SMOKE, x - vx + collisionPoints[6], y, z - vz + collisionPoints[8], 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
                 which = 2;
             }
-            else if (LevelHandler::GetSingleton().PointCollision(x + collisionPoints[9], y, z + collisionPoints[11]))
+            else if (gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[9], y, z + collisionPoints[11]))
             {
                 CreateFX(FxType::TYPE_SMOKE, x - vx + collisionPoints[9], y, z - vz + collisionPoints[11], 0, 90, 90, primaryColor.r, primaryColor.g, primaryColor.b, 1);
                 which = 3;
@@ -1226,7 +1218,7 @@ bool Tank::Move(bool forb)
         }
         if (static_cast<int>(x + collisionPoints[kx] + vx) != static_cast<int>(x + collisionPoints[kx]) && static_cast<int>(z + collisionPoints[kz] + vz) != static_cast<int>(z + collisionPoints[kz]))
         {
-            if (LevelHandler::GetSingleton().PointCollision((x + vx + collisionPoints[kx]), y, z + collisionPoints[kz]) && !LevelHandler::GetSingleton().PointCollision(x + collisionPoints[kx], y, z + vz + collisionPoints[kz]))
+            if (gameWorld->GetLevelHandler().PointCollision((x + vx + collisionPoints[kx]), y, z + collisionPoints[kz]) && !gameWorld->GetLevelHandler().PointCollision(x + collisionPoints[kx], y, z + vz + collisionPoints[kz]))
             {
                 z += vz / 2;
             }
@@ -1252,45 +1244,45 @@ bool Tank::Move(bool forb)
         z = 64;
     }
 
-    energy -= moveCost * GlobalTimer::dT;
+    energy -= cold->moveCost * GetDeltaTime();
 
     return moved;
 }
 
 void Tank::HandleInput()
 {
-    static int inputLogCounter = 0;
+    static thread_local int inputLogCounter = 0;
     
     // Use the appropriate input handler based on current input mode
-    if (inputHandler)
+    if (cold->inputHandler)
     {
         if (inputLogCounter % 180 == 0 && isPlayer) { // Log every 3 seconds for players only
             Logger::Get().Write("Tank::HandleInput() - Player tank %d processing input via LEGACY TankHandler path\n", identity.GetLegacyId());
         }
-        inputHandler->HandleInput(*this);
+        cold->inputHandler->HandleInput(*this);
     }
     
     inputLogCounter++;
 
     // Common debug controls that apply to all input modes
-    if (InputTask::KeyDown(SDL_SCANCODE_I) && App::GetSingleton().gameTask->IsDebugMode())
+    if (InputTask::KeyDown(SDL_SCANCODE_I) && gameWorld->IsDebugMode())
     {
-        Player* player = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayer(0);
+        Player* player = gameWorld->GetPlayerManager().GetPlayer(0);
         if (player) player->AddSpecialCharge(100);
         health += maxHealth * 20;
         energy += maxEnergy * 20;
     }
 
-    if (InputTask::KeyDown(SDL_SCANCODE_HOME) && App::GetSingleton().gameTask->IsDebugMode())
+    if (InputTask::KeyDown(SDL_SCANCODE_HOME) && gameWorld->IsDebugMode())
     {
-        Player* player = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayer(0);
+        Player* player = gameWorld->GetPlayerManager().GetPlayer(0);
         if (player) player->SetSpecialCharge(10);
         health = maxHealth;
         energy = maxEnergy;
     }
 
     // Allow switching to keyboard/mouse mode from other input modes
-    if (InputTask::KeyDown(SDL_SCANCODE_K) && inputMode != InputMode::MODE_KEYBOARD_MOUSE)
+    if (InputTask::KeyDown(SDL_SCANCODE_K) && cold->inputMode != InputMode::MODE_KEYBOARD_MOUSE)
     {
         SetInputMode(InputMode::MODE_KEYBOARD_MOUSE);
     }
@@ -1298,66 +1290,78 @@ void Tank::HandleInput()
 
 void Tank::AI()
 {
-    static EnemyState state = EnemyState::STATE_TURN;
-
-    bool p2target = false;
-
     // Get player tanks from PlayerManager for AI targeting
-    auto playerTanks = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerTanks();
+    auto playerTanks = gameWorld->GetPlayerManager().GetPlayerTanks();
     Tank* player0 = playerTanks[0];
     Tank* player1 = playerTanks[1];
     
     if (!player0 || !player0->alive) return; // No valid player tank to target
 
-    float dist = sqrt((x - player0->x) * (x - player0->x) + (z - player0->z) * (z - player0->z));
+    // Decide on a state and target every aiDecisionInterval ticks and keep
+    // carrying the last decision out in between
+    if (--aiTicksUntilDecision <= 0)
+    {
+        aiTicksUntilDecision = GetQualityBudget().aiDecisionInterval;
 
-    dist = sqrt((x - player0->x) * (x - player0->x) + (z - player0->z) * (z - player0->z));
+        EnemyState state = EnemyState::STATE_TURN;
+        bool p2target = false;
 
-    int numPlayers = App::GetSingleton().gameTask->GetPlayerManager()->GetNumPlayers();
-    if (numPlayers > 1 && player1 && player1->alive)
-    {
-        float dist2 = sqrt((x - player1->x) * (x - player1->x) + (z - player1->z) * (z - player1->z));
+        float dist = fastSqrt((x - player0->x) * (x - player0->x) + (z - player0->z) * (z - player0->z));
 
-        if (dist2 < dist || !player0->alive)
+        dist = fastSqrt((x - player0->x) * (x - player0->x) + (z - player0->z) * (z - player0->z));
+
+        int numPlayers = gameWorld->GetPlayerManager().GetNumPlayers();
+        if (numPlayers > 1 && player1 && player1->alive)
         {
-            p2target = true;
-            dist = dist2;
+            float dist2 = fastSqrt((x - player1->x) * (x - player1->x) + (z - player1->z) * (z - player1->z));
+
+            if (dist2 < dist || !player0->alive)
+            {
+                p2target = true;
+                dist = dist2;
+            }
         }
-    }
 
-    if (!player1 || !player1->alive)
-        p2target = false;
+        if (!player1 || !player1->alive)
+            p2target = false;
 
-    if (dist > (15 + 3 * (LevelHandler::GetSingleton().levelNumber - 48)))
-    {
-        state = EnemyState::STATE_WANDER;
-    }
-    else
-    {
-        if (energy > (maxEnergy / 2) && !App::GetSingleton().gameTask->IsVersusMode())
+        if (dist > (15 + 3 * (gameWorld->GetLevelHandler().levelNumber - 48)))
         {
-            state = EnemyState::STATE_HUNT;
+            state = EnemyState::STATE_WANDER;
         }
         else
         {
-            if ((LevelHandler::GetSingleton().levelNumber - 48) < 2)
+            if (energy > (maxEnergy / 2) && !gameWorld->IsVersusMode())
             {
-                state = EnemyState::STATE_FEAR;
+                state = EnemyState::STATE_HUNT;
             }
             else
             {
-                state = EnemyState::STATE_HUNT;
+                if ((gameWorld->GetLevelHandler().levelNumber - 48) < 2)
+                {
+                    state = EnemyState::STATE_FEAR;
+                }
+                else
+                {
+                    state = EnemyState::STATE_HUNT;
+                }
             }
         }
-    }
 
-    if (TankHandler::GetSingleton().GetAllEnemyTanks().size() == 1 || (TankHandler::GetSingleton().numAttackingTanks < (LevelHandler::GetSingleton().levelNumber - 47) && !App::GetSingleton().gameTask->IsVersusMode()))
-    {
-        state = EnemyState::STATE_HUNT;
-        TankHandler::GetSingleton().numAttackingTanks++;
+        if (gameWorld->GetTankHandler().GetAllEnemyTanks().size() == 1 || (gameWorld->GetTankHandler().numAttackingTanks < (gameWorld->GetLevelHandler().levelNumber - 47) && !gameWorld->IsVersusMode()))
+        {
+            state = EnemyState::STATE_HUNT;
+            gameWorld->GetTankHandler().numAttackingTanks++;
+        }
+
+        aiState = state;
+        aiTargetsPlayer1 = p2target;
     }
 
-    switch (state)
+    // The second player may have died since the decision
+    const bool p2target = aiTargetsPlayer1 && player1 && player1->alive;
+
+    switch (aiState)
     {
     case EnemyState::STATE_WANDER:
         Wander();
@@ -1387,17 +1391,17 @@ void Tank::Wander()
 {
     float angle = 20;
     float frames = 15;
-    float xpp = x + (GlobalTimer::dT * frames * movRate) * std::cosf((ry - angle) * DTR);
-    float zpp = z + (GlobalTimer::dT * frames * movRate) * std::sinf((ry - angle) * DTR);
+    float xpp = x + (GetDeltaTime() * frames * movRate) * cosDeg(ry - angle);
+    float zpp = z + (GetDeltaTime() * frames * movRate) * sinDeg(ry - angle);
 
-    float xpp2 = x + (GlobalTimer::dT * frames * movRate) * std::cosf((ry + angle) * DTR);
-    float zpp2 = z + (GlobalTimer::dT * frames * movRate) * std::sinf((ry + angle) * DTR);
+    float xpp2 = x + (GetDeltaTime() * frames * movRate) * cosDeg(ry + angle);
+    float zpp2 = z + (GetDeltaTime() * frames * movRate) * sinDeg(ry + angle);
 
     Move(true);
 
-    if (LevelHandler::GetSingleton().PointCollision(xpp, y, zpp) || LevelHandler::GetSingleton().PointCollision(xpp2, y, zpp2))
+    if (gameWorld->GetLevelHandler().PointCollision(xpp, y, zpp) || gameWorld->GetLevelHandler().PointCollision(xpp2, y, zpp2))
     {
-        if (LevelHandler::GetSingleton().GetTerrainHeight((unsigned int)xpp, (unsigned int)zpp) < (y + vy + 3) && energy > (maxEnergy / 4) && LevelHandler::GetSingleton().GetTerrainHeight((unsigned int)x, (unsigned int)z) > (int)(y - 7))
+        if (gameWorld->GetLevelHandler().GetTerrainHeight((unsigned int)xpp, (unsigned int)zpp) < (y + vy + 3) && energy > (maxEnergy / 4) && gameWorld->GetLevelHandler().GetTerrainHeight((unsigned int)x, (unsigned int)z) > (int)(y - 7))
         {
             Jump();
         }
@@ -1413,29 +1417,14 @@ void Tank::Fear()
     // Note: recharge flag removed - energy regeneration is now automatic
 
     // Get player tank from PlayerManager
-    auto playerTanks = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayerTanks();
+    auto playerTanks = gameWorld->GetPlayerManager().GetPlayerTanks();
     Tank* player0 = playerTanks[0];
     if (!player0 || !player0->alive) return; // No valid player tank to fear
 
-    double ratio;
     float dx = x - player0->x;
     float dz = z - player0->z;
-    float ryp;
-    
-    // Safety: Check for division by zero
-    if (std::abs(dx) < 0.001f) {
-        ryp = (dz > 0.0f ? 90.0f : -90.0f);
-    } else {
-        ratio = (double)dz / (double)dx;
-        ryp = toDegrees(atan(ratio));
-
-        if (player0->x < x)
-        {
-            ryp += 180;
-        }
-    }
-
-    ryp -= 180;
+    const float towardPlayer = HeadingFromOffset(dx, dz);
+    float ryp = towardPlayer - 180;
 
     if (ryp < (ry - 5))
     {
@@ -1449,41 +1438,20 @@ void Tank::Fear()
         }
     }
 
-    // Calculate turret rotation using already calculated dx/dz
-    if (std::abs(dx) < 0.001f) {
-        // Tanks are vertically aligned - point directly up or down
-        float rtyp = (dz > 0.0f ? 90.0f : -90.0f) - ry;
-        rty = rtyp;
-    } else {
-        ratio = (double)dz / (double)dx;
-        float rtyp = toDegrees(atan(ratio)) - ry;
-
-        if (player0->x < x)
-        {
-            rtyp += 180;
-        }
-
-        rty = rtyp;
-        
-        // Validate result
-        if (std::isnan(rty)) {
-            Logger::Get().Write("ERROR: Tank %d Fear calculated NaN rty! dx=%.2f, dz=%.2f, ratio=%.4f, rtyp=%.2f\n",
-                identity.GetLegacyId(), dx, dz, ratio, rtyp);
-            rty = 0.0f; // Fallback to safe value
-        }
-    }
+    // Turret keeps pointing at the player
+    rty = towardPlayer - ry;
 
     float angle = 30;
     float frames = 20;
-    float xpp = x + (GlobalTimer::dT * frames * movRate) * std::cosf((ry - angle) * DTR);
-    float zpp = z + (GlobalTimer::dT * frames * movRate) * std::sinf((ry - angle) * DTR);
+    float xpp = x + (GetDeltaTime() * frames * movRate) * cosDeg(ry - angle);
+    float zpp = z + (GetDeltaTime() * frames * movRate) * sinDeg(ry - angle);
 
-    float xpp2 = x + (GlobalTimer::dT * frames * movRate) * std::cosf((ry + angle) * DTR);
-    float zpp2 = z + (GlobalTimer::dT * frames * movRate) * std::sinf((ry + angle) * DTR);
+    float xpp2 = x + (GetDeltaTime() * frames * movRate) * cosDeg(ry + angle);
+    float zpp2 = z + (GetDeltaTime() * frames * movRate) * sinDeg(ry + angle);
 
-    if (LevelHandler::GetSingleton().PointCollision(xpp, y, zpp) || LevelHandler::GetSingleton().PointCollision(xpp2, y, zpp2))
+    if (gameWorld->GetLevelHandler().PointCollision(xpp, y, zpp) || gameWorld->GetLevelHandler().PointCollision(xpp2, y, zpp2))
     {
-        if (LevelHandler::GetSingleton().GetTerrainHeight((int)xpp, (int)zpp) < (y + 3) && energy > (maxEnergy / 4))
+        if (gameWorld->GetLevelHandler().GetTerrainHeight((int)xpp, (int)zpp) < (y + 3) && energy > (maxEnergy / 4))
         {
             Jump();
         }
@@ -1506,17 +1474,10 @@ void Tank::Hunt(Tank &player)
 
     // Note: recharge flag removed - energy regeneration is now automatic
 
-    double ratio;
     float xpp;
     float zpp;
 
-    ratio = (double)(z - player.z) / (double)(x - player.x);
-    float ryp = toDegrees(atan(ratio));
-
-    if (player.x < x)
-    {
-        ryp += 180;
-    }
+    float ryp = HeadingFromOffset(x - player.x, z - player.z);
 
     if (ryp < (ry - 5))
     {
@@ -1528,39 +1489,15 @@ void Tank::Hunt(Tank &player)
             RotBody(true);
     }
 
-    // Safety: Check for division by zero
-    float dx = x - player.x;
-    float dz = z - player.z;
-    
-    if (std::abs(dx) < 0.001f) {
-        // Tanks are vertically aligned - point directly up or down
-        float rtyp = (dz > 0.0f ? 90.0f : -90.0f) - ry;
-        rty = rtyp;
-    } else {
-        ratio = (double)dz / (double)dx;
-        float rtyp = toDegrees(atan(ratio)) - ry;
-
-        if (player.x < x)
-        {
-            rtyp += 180;
-        }
-
-        rty = rtyp;
-        
-        // Validate result
-        if (std::isnan(rty)) {
-            Logger::Get().Write("ERROR: Tank %d Hunt calculated NaN rty! dx=%.2f, dz=%.2f, ratio=%.4f, rtyp=%.2f\n",
-                identity.GetLegacyId(), dx, dz, ratio, rtyp);
-            rty = 0.0f; // Fallback to safe value
-        }
-    }
+    // Turret keeps pointing at the player
+    rty = ryp - ry;
 
-    xpp = x + (GlobalTimer::dT * 10 * movRate) * std::cosf(ry * DTR);
-    zpp = z + (GlobalTimer::dT * 10 * movRate) * std::sinf(ry * DTR);
+    xpp = x + (GetDeltaTime() * 10 * movRate) * cosDeg(ry);
+    zpp = z + (GetDeltaTime() * 10 * movRate) * sinDeg(ry);
 
-    if (LevelHandler::GetSingleton().PointCollision(xpp, y, zpp))
+    if (gameWorld->GetLevelHandler().PointCollision(xpp, y, zpp))
     {
-        if (LevelHandler::GetSingleton().GetTerrainHeight((int)xpp, (int)zpp) < (y + 5) && energy > (maxEnergy / 4))
+        if (gameWorld->GetLevelHandler().GetTerrainHeight((int)xpp, (int)zpp) < (y + 5) && energy > (maxEnergy / 4))
         {
             Jump();
         }
@@ -1583,7 +1520,9 @@ void Tank::Hunt(Tank &player)
     }
     else
     {
-        if (energy >= (maxEnergy / 2) && (int)player.y == (int)y)
+        // Only shoot along a clear line at barrel height
+        if (energy >= (maxEnergy / 2) && (int)player.y == (int)y &&
+            gameWorld->GetLevelHandler().LineOfSight(x, y + 0.25f, z, player.x, player.y + 0.25f, player.z))
         {
             Fire(1);
         }
@@ -4,6 +4,7 @@
 #include "igtl_qmesh.h"
 #include "TankTypeManager.h"
 #include "TankIdentity.h"
+#include "effects/ParticleSystem.h"
 
 #include <vector>
 #include <queue>
@@ -15,6 +16,7 @@ using namespace std;
 class TankRenderer;
 class InputHandler;
 class GameWorld;
+struct QualityBudget;
 enum class FxType;
 
 enum class EnemyState
@@ -51,6 +53,38 @@ enum class InputMode
 // Forward declaration for helper class
 class TankCollisionHelper;
 
+/**
+ * Configuration and ownership data of a tank that the per-frame update
+ * does not touch: kept out of line so a sweep over many tanks only pulls
+ * their hot state through the cache.
+ */
+struct TankColdData
+{
+    // Action costs (how much energy each action consumes)
+    float fireCost = 10.0f;     // Energy cost to fire
+    float jumpCost = 15.0f;     // Energy cost to jump
+    float moveCost = 0.1f;      // Energy cost for movement (if applicable)
+    float specialCost = 25.0f;  // Was: chargeCost (for special abilities)
+
+    // Wall probe offsets (x, y, z triples) from collisionRadius; read by
+    // the collision checks only
+    float collisionPoints[21] = {};
+
+    // Input ownership
+    int control = 0;
+    InputMode inputMode = InputMode::MODE_KEYBOARD_MOUSE;
+    unsigned int jid = 0;
+    std::unique_ptr<InputHandler> inputHandler;
+};
+
+/**
+ * Tank entity.
+ *
+ * The data members are ordered hot first: everything NextFrame, AI and the
+ * input handlers read or write every frame sits in the first cache lines
+ * of the object. Action costs, wall probes and input ownership live in a
+ * TankColdData side record.
+ */
 class Tank : public Entity
 {
     // Allow the collision helper to access private members
@@ -68,7 +102,11 @@ public:
     Tank(Tank&&) noexcept;
     Tank& operator=(Tank&&) noexcept;
 
-    bool isPlayer;
+    // === Hot state (per frame) ===
+    // Position (x, y, z) is inherited from Entity
+    float vx, vy, vz;
+    float rx, ry, rz, rr, rrl;
+    float rtx, rty, rtz;
 
     // === REFACTORED: Clear two-concept system ===
     // 1. HEALTH - Tank's structural integrity (survival)
@@ -80,22 +118,54 @@ public:
     float energy;           // Was: charge (now clearly for actions)
     float maxEnergy;        // Was: maxCharge
     float energyRegen;      // Was: chargeRegen (energy regeneration rate)
-    
-    // Action costs (how much energy each action consumes)
-    float fireCost;         // Energy cost to fire
-    float jumpCost;         // Energy cost to jump
-    float moveCost;         // Energy cost for movement (if applicable)
-    float specialCost;      // Was: chargeCost (for special abilities)
+
 
     float fireTimer;
     float fireRate;
+    float rotRate, movRate, jumpRate;
+    float fallRate;
+    float collisionRadius;
+    float dist;
+    float jumpTime;
+    float bonusTime;
+    float deadtime;
+    float hitAlpha;
+    int bonus;
+    int hitNum;
     int bounces;
     int attack;
 
+    TankType type1;
+    TankType type2;
+    TankIdentity identity;
+
     bool alive;
+    bool isPlayer;
+    bool isJumping;
+    bool isGrounded;
+    bool turbo;         // Turbo mode flag (consumes extra energy)
+
+    // Continuous effects (particles per second)
+    ParticleEmitter smokeEmitter{60.0f};    // While health is below half
+    ParticleEmitter jumpEmitter{60.0f};     // While jumping
+
+    // Enemy AI: the last state and target decision, carried out until the
+    // next one (the quality budget may space decisions several ticks apart)
+    EnemyState aiState = EnemyState::STATE_TURN;
+    bool aiTargetsPlayer1 = false;
+    int aiTicksUntilDecision = 0;
+
+private:
+    GameWorld* gameWorld = nullptr;
+    std::unique_ptr<TankColdData> cold;
+
+public:
+    // === Cold data (costs, wall probes, input ownership) ===
+    // A moved-from tank has none left and may only be destroyed or assigned to
+    TankColdData& Cold() { return *cold; }
+    const TankColdData& Cold() const { return *cold; }
+    bool HasColdData() const { return cold != nullptr; }
 
-    TankIdentity identity;
-    
     // Backward-compatible accessor for gradual migration
     int GetId() const { return identity.GetLegacyId(); }
     
@@ -115,22 +185,8 @@ public:
 
     void Init();
 
-    float x, y, z;
-    float vx, vy, vz;
     void SetPosition(float _x, float _y, float _z);
 
-    float collisionPoints[21];
-    float collisionRadius;
-
-    int control;
-    InputMode inputMode;
-    unsigned int jid;
-    std::unique_ptr<InputHandler> inputHandler;
-
-    float rx, ry, rz, rr, rrl;
-    float rtx, rty, rtz;
-    float rotRate, movRate, jumpRate;
-    float fallRate;
     void Fall();
     void Jump();
     void HandleInput();
@@ -153,9 +209,6 @@ public:
     void SetType(TankType t1, TankType t2);
     void SetInputMode(InputMode mode);
 
-    TankType type1;
-    TankType type2;
-
     // Dynamic color methods - replace hardcoded r,g,b fields
     Color GetPrimaryColor() const { return TankTypeManager::GetTankTypeColor(type1); }
     Color GetSecondaryColor() const { return TankTypeManager::GetTankTypeColor(type2); }
@@ -168,19 +221,19 @@ public:
         TankTypeManager::GetTankTypeColor(type2, r, g, b); 
     }
 
-    float dist;
-
-    bool isJumping;
-    bool isGrounded;
-    float jumpTime;
-    bool turbo;         // Turbo mode flag (consumes extra energy)
-
     bool PointCollision(float cx, float cy, float cz) const;
 
     void NextFrame();
     
     // GameWorld access for bullet and FX creation
     void SetGameWorld(GameWorld* world) { gameWorld = world; }
+    GameWorld* GetGameWorld() const { return gameWorld; }
+
+    // Frame time of the owning world (falls back to the global timer)
+    float GetDeltaTime() const;
+
+    // Quality budget of the owning world (full quality without one)
+    const QualityBudget& GetQualityBudget() const;
     
     // Descriptive FX helper methods (encapsulate effect creation logic)
     void CreateDeathExplosionFX();
@@ -204,13 +257,4 @@ public:
     // Old "charge" field is now energy  
     [[deprecated("Use energy instead")]] float& GetOldChargeRef() { return energy; }
     [[deprecated("Use maxEnergy instead")]] float& GetOldMaxChargeRef() { return maxEnergy; }
-
-    int bonus;
-    float bonusTime;
-    float deadtime;
-    float hitAlpha;
-    int hitNum;
-
-private:
-    GameWorld* gameWorld = nullptr;
 };
@@ -15,7 +15,6 @@
 #include "LevelHandler.h"
 #include "GlobalTimer.h"
 #include "math.h"
-#include "App.h"
 #include "GameWorld.h"
 #include "Logger.h"
 #include <string>
@@ -31,8 +30,9 @@ TankHandler::TankHandler()
 
 void TankHandler::Init()
 {
-    TankTypeManager::Initialize();
-    
+    // Tank type tables are built once by TankTypeManager's static initializer;
+    // rebuilding them here would race between concurrently running worlds.
+
     // Initialize enemy tanks only
     // Player tanks are managed by PlayerManager
     InitializeEnemyTanks();
@@ -42,7 +42,8 @@ void TankHandler::Init()
 
 void TankHandler::InitializeEnemyTanks()
 {
-    int enemyCount = LevelHandler::GetSingleton().GetEnemyCountForLevel(LevelHandler::GetSingleton().levelNumber);
+    const LevelHandler& level = gameWorld->GetLevelHandler();
+    int enemyCount = level.GetEnemyCountForLevel(level.levelNumber);
     
     for (int i = 0; i < enemyCount; ++i)
     {
@@ -54,7 +55,7 @@ void TankHandler::InitializeEnemyTanks()
             newTank->identity = TankIdentity::Enemy(i);
             SetEnemyPosition(*newTank, i);
             SetEnemyType(*newTank, i);
-            newTank->jumpCost = 0; // Enemy tanks don't pay jump cost
+            newTank->Cold().jumpCost = 0; // Enemy tanks don't pay jump cost
         }
     }
 }
@@ -67,7 +68,7 @@ Tank TankHandler::CreateEnemyTank(int index)
     SetEnemyPosition(tank, index);
     SetEnemyType(tank, index);
     
-    tank.jumpCost = 0;
+    tank.Cold().jumpCost = 0;
     
     // Set GameWorld reference
     tank.SetGameWorld(gameWorld);
@@ -77,25 +78,27 @@ Tank TankHandler::CreateEnemyTank(int index)
 
 void TankHandler::SetEnemyPosition(Tank& tank, int index)
 {
+    LevelHandler& level = gameWorld->GetLevelHandler();
+
     if (index < MAX_ENEMY_SPAWN_POSITIONS)
     {
-        tank.x = LevelHandler::GetSingleton().enemy[index][0];
-        tank.z = LevelHandler::GetSingleton().enemy[index][1];
+        tank.x = level.enemy[index][0];
+        tank.z = level.enemy[index][1];
     }
     else
     {
-        tank.x = LevelHandler::GetSingleton().enemy[index % MAX_ENEMY_SPAWN_POSITIONS][0] + index % 2;
-        tank.z = LevelHandler::GetSingleton().enemy[index % MAX_ENEMY_SPAWN_POSITIONS][1] + index % 2;
+        tank.x = level.enemy[index % MAX_ENEMY_SPAWN_POSITIONS][0] + index % 2;
+        tank.z = level.enemy[index % MAX_ENEMY_SPAWN_POSITIONS][1] + index % 2;
     }
     
-    tank.y = LevelHandler::GetSingleton().GetTerrainHeight((int)tank.x, (int)tank.z);
+    tank.y = level.GetTerrainHeight((int)tank.x, (int)tank.z);
     tank.ry = index * ROTATION_STEP_DEGREES;
     tank.identity = TankIdentity::Enemy(index);
 }
 
 void TankHandler::SetEnemyType(Tank& tank, int index)
 {
-    int levelOffset = LevelHandler::GetSingleton().levelNumber - 48;
+    int levelOffset = gameWorld->GetLevelHandler().levelNumber - 48;
     
     if (levelOffset == 0)
     {
@@ -126,9 +129,9 @@ void TankHandler::SetEnemyType(Tank& tank, int index)
 // - UpdatePlayerCombos/States/Targeting/VersusMode() - Handled by PlayerManager
 // - UpdateEnemyTanks() - Handled by GameWorld's EntityManager
 
-std::vector<const Tank*> TankHandler::GetAllEnemyTanks() const {
+FrameVector<const Tank*> TankHandler::GetAllEnemyTanks() const {
     // Return enemy tanks from GameWorld
-    std::vector<const Tank*> enemyTanks;
+    FrameVector<const Tank*> enemyTanks(ArenaAllocator<const Tank*>(&gameWorld->GetFrameArena()));
     
     const auto& worldTanks = gameWorld->GetTanks();
     enemyTanks.reserve(worldTanks.size());
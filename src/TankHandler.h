@@ -3,9 +3,9 @@
 #include <array>
 #include <vector>
 #include "Tank.h"
-#include "Singleton.h"
+#include "memory/FrameArena.h"
 
-class TankHandler : public Singleton<TankHandler>
+class TankHandler
 {
 public:
     TankHandler();
@@ -33,15 +33,14 @@ public:
     // Interface to GameWorld (for enemy tanks only)
     void SetGameWorld(class GameWorld* world);
     
-    // Get all enemy tanks for rendering
-    std::vector<const Tank*> GetAllEnemyTanks() const;
+    // Get all enemy tanks for rendering (in the world's frame arena)
+    FrameVector<const Tank*> GetAllEnemyTanks() const;
 
     // Enemy tank configuration
     int numAttackingTanks = 0;
 
 private:
     class GameWorld* gameWorld = nullptr;
-    mutable std::vector<const Tank*> unifiedEnemyView; // Mutable for const GetAllEnemyTanks()
     
     // Enemy tank initialization and management
     void InitializeEnemyTanks();
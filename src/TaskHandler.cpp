@@ -5,7 +5,19 @@
 //
 
 #include "TaskHandler.h"
+#include "memory/AllocationTracker.h"
+#include "profiling/FrameStats.h"
+#include "profiling/QualityGovernor.h"
 #include <algorithm>
+#include <chrono>
+
+namespace
+{
+    float MillisecondsBetween(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end)
+    {
+        return std::chrono::duration<float, std::milli>(end - start).count();
+    }
+}
 
 TaskHandler::TaskHandler()
 {
@@ -16,13 +28,24 @@ TaskHandler::TaskHandler()
 
 int TaskHandler::Execute()
 {
+    FrameStats& frameStats = FrameStats::Get();
+    auto frameStart = std::chrono::steady_clock::now();
+    float workMs = 0.0f;
+
     while(!taskList.empty())
     {
         for(auto* task : taskList)
         {
             if(!task->canKill)
             {
+                const auto taskStart = std::chrono::steady_clock::now();
                 task->Update();
+                const float taskMs = MillisecondsBetween(taskStart, std::chrono::steady_clock::now());
+                frameStats.AddStageTime(task->name, taskMs);
+                if (!task->presents)
+                {
+                    workMs += taskMs;
+                }
             }
         }
         
@@ -39,6 +62,14 @@ int TaskHandler::Execute()
                 ++it;
             }
         }
+
+        // One pass over the tasks is one frame
+        AllocationTracker::Get().EndFrame();
+        const auto frameEnd = std::chrono::steady_clock::now();
+        frameStats.EndFrame(MillisecondsBetween(frameStart, frameEnd));
+        QualityGovernor::Get().AddFrame(workMs);
+        frameStart = frameEnd;
+        workMs = 0.0f;
     }
     
     return 0;
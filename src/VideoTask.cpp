@@ -5,19 +5,86 @@
 #include "VideoTask.h"
 #include "TankHandler.h"
 #include "App.h"
+#include "rendering/core/CoreGL.h"
+#include "profiling/FrameStats.h"
+#include "profiling/QualityGovernor.h"
+#include "InputTask.h"
 
 #include <SDL2/SDL.h>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 int VideoTask::scrWidth = 800;
 int VideoTask::scrHeight = 600;
 int VideoTask::scrBPP = 32;
 int VideoTask::difficultySetting = 1; // Default to normal difficulty
+float VideoTask::targetFrameMs = 0.0f;
+float VideoTask::minResolutionScale = 0.5f;
+FramePacer::Mode VideoTask::pacingMode = FramePacer::Mode::VSYNC;
+float VideoTask::frameCapFps = 120.0f;
+VideoTask::RenderBackend VideoTask::requestedBackend = VideoTask::RenderBackend::LEGACY;
+VideoTask::RenderBackend VideoTask::activeBackend = VideoTask::RenderBackend::LEGACY;
 
 VideoTask::VideoTask()
 {
 }
 
+bool VideoTask::ParseCommandLine(int argc, char* argv[])
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--renderer") == 0)
+        {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "core") == 0)
+            {
+                requestedBackend = RenderBackend::CORE;
+            }
+            else if (std::strcmp(name, "legacy") == 0)
+            {
+                requestedBackend = RenderBackend::LEGACY;
+            }
+            else
+            {
+                Logger::Get().Write("VideoTask: unknown renderer '%s', using legacy\n", name);
+                requestedBackend = RenderBackend::LEGACY;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool VideoTask::CreateCoreContext()
+{
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+#ifdef __APPLE__
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, SDL_GL_CONTEXT_FORWARD_COMPATIBLE_FLAG);
+#endif
+
+    glContext = SDL_GL_CreateContext(window);
+    if (!glContext)
+    {
+        Logger::Get().Write("VideoTask: no OpenGL 3.3 core context (%s)\n", SDL_GetError());
+    }
+    else if (SDL_GL_MakeCurrent(window, glContext) != 0 || !CoreGL::Load())
+    {
+        Logger::Get().Write("VideoTask: OpenGL 3.3 core context is unusable\n");
+        SDL_GL_DeleteContext(glContext);
+        glContext = nullptr;
+    }
+
+    // Leave the attributes as the legacy context expects them
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, 0);
+    SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, 0);
+    return glContext != nullptr;
+}
+
 bool VideoTask::Start()
 {
 
@@ -112,30 +179,101 @@ bool VideoTask::Start()
         fgets(line, 64, filein);
 
         App::GetSingleton().soundTask->disable = (bool)(line[0] - 48);
+
+        // Optional: older settings files stop here and keep the defaults
+        if (fgets(line, 64, filein) && fgets(line, 64, filein))
+        {
+            targetFrameMs = static_cast<float>(atof(line));
+        }
+        if (fgets(line, 64, filein) && fgets(line, 64, filein))
+        {
+            minResolutionScale = static_cast<float>(atof(line));
+        }
+        if (fgets(line, 64, filein) && fgets(line, 64, filein))
+        {
+            pacingMode = FramePacer::ModeFromSetting(atoi(line));
+        }
+        if (fgets(line, 64, filein) && fgets(line, 64, filein))
+        {
+            frameCapFps = static_cast<float>(atof(line));
+        }
         fclose(filein);
     }
 
+    // The same budget sheds optional work when the CPU side runs long
+    QualityGovernor::Get().SetTargetFrameMs(targetFrameMs);
+
     window = SDL_CreateWindow("tankgame", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, scrWidth, scrHeight, flags);
     // sdlRenderer = SDL_CreateRenderer(window, -1, 0);
-    glContext = SDL_GL_CreateContext(window);
-    
+    activeBackend = RenderBackend::LEGACY;
+    if (requestedBackend == RenderBackend::CORE && window && CreateCoreContext())
+    {
+        activeBackend = RenderBackend::CORE;
+        Logger::Get().Write("VideoTask: using the core-profile renderer\n");
+    }
+    else
+    {
+        if (requestedBackend == RenderBackend::CORE)
+        {
+            Logger::Get().Write("VideoTask: falling back to the legacy renderer\n");
+        }
+        glContext = SDL_GL_CreateContext(window);
+    }
+
     // Ensure the OpenGL context is current (important for macOS)
     SDL_GL_MakeCurrent(window, glContext);
 
-    SDL_GL_SetSwapInterval(1);
-
     if (!window)
     {
         Logger::Get().Write("VideoTask::Start: SDL_CreateWindow failed.\n");
         return false;
     }
 
+    ApplyFramePacing();
     return true;
 }
 
+void VideoTask::ApplyFramePacing()
+{
+    int interval = 1;
+    switch (pacingMode)
+    {
+    case FramePacer::Mode::ADAPTIVE_VSYNC:
+        interval = -1;
+        break;
+    case FramePacer::Mode::UNCAPPED:
+    case FramePacer::Mode::CAPPED:
+        interval = 0;
+        break;
+    default:
+        break;
+    }
+
+    if (SDL_GL_SetSwapInterval(interval) != 0 && interval == -1)
+    {
+        Logger::Get().Write("VideoTask: adaptive vsync unsupported, using vsync\n");
+        pacingMode = FramePacer::Mode::VSYNC;
+        SDL_GL_SetSwapInterval(1);
+    }
+
+    framePacer.Configure(pacingMode, frameCapFps);
+    Logger::Get().Write("VideoTask: frame pacing %s\n", FramePacer::GetModeName(pacingMode));
+}
+
 void VideoTask::Update()
 {
     SDL_GL_SwapWindow(window);
+
+    // From this frame's input sampling to the frame being handed to the display
+    const auto sampled = InputTask::GetSampleTime();
+    if (sampled.time_since_epoch().count() != 0)
+    {
+        const auto latency = std::chrono::steady_clock::now() - sampled;
+        FrameStats::Get().SetInputLatency(std::chrono::duration<float, std::milli>(latency).count());
+    }
+
+    // Capped mode: wait here, before the next frame samples its input
+    framePacer.WaitForNextFrame();
 }
 
 void VideoTask::Stop()
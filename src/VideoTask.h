@@ -2,6 +2,7 @@
 
 #include <SDL2/SDL.h>
 #include "ITask.h"
+#include "FramePacer.h"
 
 class VideoTask : public ITask
 {
@@ -12,6 +13,23 @@ public:
     static int scrWidth, scrHeight, scrBPP;
     static int difficultySetting; // 0=easy, 1=normal, 2=hard (read from settings file)
 
+    // Frame time budget (settings file) for dynamic resolution and the
+    // quality governor, 0 for neither, and the smallest scene scale
+    static float targetFrameMs;
+    static float minResolutionScale;
+
+    // Frame pacing (settings file) and the frame rate of the capped mode
+    static FramePacer::Mode pacingMode;
+    static float frameCapFps;
+
+    // Rendering backend: the fixed-function pipeline on a GL 2.1 context, or
+    // the shader pipeline on a 3.3 core profile (falls back to legacy)
+    enum class RenderBackend { LEGACY, CORE };
+    static RenderBackend requestedBackend;  // --renderer legacy|core
+    static RenderBackend activeBackend;     // What the created context supports
+
+    static bool ParseCommandLine(int argc, char* argv[]);
+
     bool Start();
     void Update();
     void Stop();
@@ -21,4 +39,8 @@ protected:
     SDL_Window *window;
     SDL_Renderer *sdlRenderer;
     SDL_GLContext glContext;
+    FramePacer framePacer;
+
+    bool CreateCoreContext();
+    void ApplyFramePacing();
 };
@@ -1,7 +1,5 @@
 #include "CollisionSystem.h"
-#include "../events/Events.h"
-#include "../LevelHandler.h"
-#include "../TankHandler.h"
+#include "../GameWorld.h"
 #include "../Item.h"
 #include "../Bullet.h"
 #include "../Tank.h"
@@ -11,19 +9,25 @@
 CollisionSystem::CollisionSystem() {
 }
 
-void CollisionSystem::Initialize() {
+void CollisionSystem::Initialize(GameWorld* world) {
     Logger::Get().Write("CollisionSystem::Initialize() - Subscribing to collision query events\n");
+    gameWorld = world;
+    EventBus& bus = gameWorld->GetEventBus();
     
     // Subscribe to collision query events
-    Events::GetBus().Subscribe<PointCollisionQuery>([this](const PointCollisionQuery& query) {
+    bus.Subscribe<PointCollisionQuery>([this](const PointCollisionQuery& query) {
         OnPointCollisionQuery(query);
     });
     
-    Events::GetBus().Subscribe<SphereCollisionQuery>([this](const SphereCollisionQuery& query) {
+    bus.Subscribe<SphereCollisionQuery>([this](const SphereCollisionQuery& query) {
         OnSphereCollisionQuery(query);
     });
     
-    Events::GetBus().Subscribe<GetLevelBoundsQuery>([this](const GetLevelBoundsQuery& query) {
+    bus.Subscribe<LevelRaycastQuery>([this](const LevelRaycastQuery& query) {
+        OnLevelRaycastQuery(query);
+    });
+    
+    bus.Subscribe<GetLevelBoundsQuery>([this](const GetLevelBoundsQuery& query) {
         OnGetLevelBoundsQuery(query);
     });
     
@@ -99,8 +103,8 @@ bool CollisionSystem::CheckPointCollision(float x, float y, float z, CollisionLa
     return false;
 }
 
-std::vector<Entity*> CollisionSystem::CheckSphereCollision(float x, float y, float z, float radius, CollisionLayer layerMask, Entity* exclude) const {
-    std::vector<Entity*> results;
+FrameVector<Entity*> CollisionSystem::CheckSphereCollision(float x, float y, float z, float radius, CollisionLayer layerMask, Entity* exclude) const {
+    FrameVector<Entity*> results(ArenaAllocator<Entity*>(gameWorld ? &gameWorld->GetFrameArena() : nullptr));
     
     // Check registered entities
     for (const auto& pair : registeredEntities) {
@@ -130,6 +134,15 @@ std::vector<Entity*> CollisionSystem::CheckSphereCollision(float x, float y, flo
     return results;
 }
 
+bool CollisionSystem::GetTankRadius(const Entity* entity, float& radius) const {
+    auto it = registeredEntities.find(const_cast<Entity*>(entity));
+    if (it == registeredEntities.end() || (it->second.layer & CollisionLayer::ALL_TANKS) == CollisionLayer::NONE) {
+        return false;
+    }
+    radius = it->second.shape.radius;
+    return true;
+}
+
 void CollisionSystem::OnPointCollisionQuery(const PointCollisionQuery& query) {
     Logger::Get().Write("CollisionSystem::OnPointCollisionQuery - pos=(%.2f, %.2f, %.2f)\n", query.x, query.y, query.z);
     
@@ -165,10 +178,20 @@ void CollisionSystem::OnSphereCollisionQuery(const SphereCollisionQuery& query)
     Logger::Get().Write("CollisionSystem::OnSphereCollisionQuery - found %zu entities\n", query.results.size());
 }
 
+void CollisionSystem::OnLevelRaycastQuery(const LevelRaycastQuery& query) {
+    LevelRayHit hit;
+    query.result = gameWorld->GetLevelHandler().Raycast(query.x0, query.y0, query.z0, query.x1, query.y1, query.z1, hit);
+    if (query.result) {
+        query.time = hit.time;
+        query.normalX = hit.normalX;
+        query.normalZ = hit.normalZ;
+    }
+}
+
 void CollisionSystem::OnGetLevelBoundsQuery(const GetLevelBoundsQuery& query) {
     if (!boundsValid) {
-        cachedSizeX = LevelHandler::GetSingleton().sizeX;
-        cachedSizeZ = LevelHandler::GetSingleton().sizeZ;
+        cachedSizeX = gameWorld->GetLevelHandler().sizeX;
+        cachedSizeZ = gameWorld->GetLevelHandler().sizeZ;
         boundsValid = true;
     }
     
@@ -177,7 +200,7 @@ void CollisionSystem::OnGetLevelBoundsQuery(const GetLevelBoundsQuery& query) {
 }
 
 bool CollisionSystem::CheckLevelCollision(float x, float y, float z) const {
-    return LevelHandler::GetSingleton().PointCollision(x, y, z);
+    return gameWorld->GetLevelHandler().PointCollision(x, y, z);
 }
 
 bool CollisionSystem::PointVsPoint(float x1, float y1, float z1, float x2, float y2, float z2, float threshold) const {
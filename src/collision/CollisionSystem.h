@@ -5,6 +5,8 @@
 #include <unordered_map>
 #include <vector>
 
+class GameWorld;
+
 /**
  * Shape information for collision detection.
  */
@@ -24,7 +26,7 @@ public:
     CollisionSystem();
     ~CollisionSystem() = default;
     
-    void Initialize();
+    void Initialize(GameWorld* world);
     void Update();  // Update spatial grid and detect collisions
     void Shutdown();
     
@@ -35,7 +37,11 @@ public:
     
     // Direct collision queries (for immediate results)
     bool CheckPointCollision(float x, float y, float z, CollisionLayer layerMask, Entity* exclude = nullptr) const;
-    std::vector<Entity*> CheckSphereCollision(float x, float y, float z, float radius, CollisionLayer layerMask, Entity* exclude = nullptr) const;
+    // Results live in the world's frame arena
+    FrameVector<Entity*> CheckSphereCollision(float x, float y, float z, float radius, CollisionLayer layerMask, Entity* exclude = nullptr) const;
+
+    // Collision radius of a registered tank; false if entity is not one
+    bool GetTankRadius(const Entity* entity, float& radius) const;
 
 private:
     struct CollisionEntry {
@@ -45,11 +51,13 @@ private:
         float lastX, lastY, lastZ;  // Cached position
     };
     
+    GameWorld* gameWorld = nullptr;  // Owning world (event bus, level)
     std::unordered_map<Entity*, CollisionEntry> registeredEntities;
     
     // Event handlers
     void OnPointCollisionQuery(const PointCollisionQuery& query);
     void OnSphereCollisionQuery(const SphereCollisionQuery& query);
+    void OnLevelRaycastQuery(const LevelRaycastQuery& query);
     void OnGetLevelBoundsQuery(const GetLevelBoundsQuery& query);
     
     // Collision detection algorithms
@@ -0,0 +1,196 @@
+#include "NarrowphaseGrid.h"
+#include "../math.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__)
+#define NARROWPHASE_AVX2 1
+#include <immintrin.h>
+#elif defined(MATH_SSE2)
+#define NARROWPHASE_SSE2 1
+#endif
+
+namespace {
+    // Padding lanes sit far outside every sphere (their distance overflows
+    // to infinity, which never compares <= a finite reach)
+    const float FAR_AWAY = 1.0e30f;
+
+    uint32_t PaddedSize(uint32_t n)
+    {
+        return static_cast<uint32_t>((n + NarrowphaseGrid::LANES - 1) / NarrowphaseGrid::LANES * NarrowphaseGrid::LANES);
+    }
+
+    inline void EmitLanes(int mask, const uint32_t* ids, uint32_t sphere, std::vector<NarrowphaseHit>& hits)
+    {
+        for (int lane = 0; mask != 0; lane++, mask >>= 1)
+        {
+            if (mask & 1)
+            {
+                hits.push_back({ids[lane], sphere});
+            }
+        }
+    }
+}
+
+void NarrowphaseGrid::Reset(float sizeX, float sizeZ)
+{
+    cellsX = std::max(1, static_cast<int>(std::ceil(sizeX / CELL_SIZE)));
+    cellsZ = std::max(1, static_cast<int>(std::ceil(sizeZ / CELL_SIZE)));
+
+    pointX.clear();
+    pointY.clear();
+    pointZ.clear();
+    pointCell.clear();
+    sphereX.clear();
+    sphereY.clear();
+    sphereZ.clear();
+    sphereReach.clear();
+}
+
+int NarrowphaseGrid::CellX(float x) const
+{
+    const float cell = std::floor(x / CELL_SIZE);
+    return !(cell > 0.0f) ? 0 : (cell >= cellsX - 1 ? cellsX - 1 : static_cast<int>(cell));
+}
+
+int NarrowphaseGrid::CellZ(float z) const
+{
+    const float cell = std::floor(z / CELL_SIZE);
+    return !(cell > 0.0f) ? 0 : (cell >= cellsZ - 1 ? cellsZ - 1 : static_cast<int>(cell));
+}
+
+void NarrowphaseGrid::AddPoint(float x, float y, float z)
+{
+    pointX.push_back(x);
+    pointY.push_back(y);
+    pointZ.push_back(z);
+    pointCell.push_back(static_cast<uint32_t>(CellZ(z) * cellsX + CellX(x)));
+}
+
+void NarrowphaseGrid::AddSphere(float x, float y, float z, float reach)
+{
+    sphereX.push_back(x);
+    sphereY.push_back(y);
+    sphereZ.push_back(z);
+    sphereReach.push_back(reach);
+}
+
+void NarrowphaseGrid::Run(std::vector<NarrowphaseHit>& hits)
+{
+    hits.clear();
+    if (pointX.empty() || sphereX.empty())
+    {
+        return;
+    }
+
+    // Counting sort of the points into padded per-cell runs
+    const size_t numCells = static_cast<size_t>(cellsX) * cellsZ;
+    cellFill.assign(numCells, 0);
+    for (uint32_t cell : pointCell)
+    {
+        cellFill[cell]++;
+    }
+    cellStart.resize(numCells + 1);
+    cellStart[0] = 0;
+    for (size_t c = 0; c < numCells; c++)
+    {
+        cellStart[c + 1] = cellStart[c] + PaddedSize(cellFill[c]);
+        cellFill[c] = cellStart[c];
+    }
+
+    const size_t packed = cellStart[numCells];
+    packedX.assign(packed, FAR_AWAY);
+    packedY.assign(packed, FAR_AWAY);
+    packedZ.assign(packed, FAR_AWAY);
+    packedIds.assign(packed, 0);
+    for (size_t i = 0; i < pointX.size(); i++)
+    {
+        const uint32_t slot = cellFill[pointCell[i]]++;
+        packedX[slot] = pointX[i];
+        packedY[slot] = pointY[i];
+        packedZ[slot] = pointZ[i];
+        packedIds[slot] = static_cast<uint32_t>(i);
+    }
+
+    for (size_t s = 0; s < sphereX.size(); s++)
+    {
+        const float reach = sphereReach[s];
+        const int minX = CellX(sphereX[s] - reach);
+        const int maxX = CellX(sphereX[s] + reach);
+        const int minZ = CellZ(sphereZ[s] - reach);
+        const int maxZ = CellZ(sphereZ[s] + reach);
+        for (int cz = minZ; cz <= maxZ; cz++)
+        {
+            for (int cx = minX; cx <= maxX; cx++)
+            {
+                const size_t c = static_cast<size_t>(cz) * cellsX + cx;
+                const uint32_t begin = cellStart[c];
+                const uint32_t end = cellStart[c + 1];
+                if (begin != end)
+                {
+                    TestSphere(&packedX[begin], &packedY[begin], &packedZ[begin], &packedIds[begin], end - begin,
+                               sphereX[s], sphereY[s], sphereZ[s], reach, static_cast<uint32_t>(s), hits);
+                }
+            }
+        }
+    }
+
+    std::sort(hits.begin(), hits.end(), [](const NarrowphaseHit& a, const NarrowphaseHit& b) {
+        return a.point != b.point ? a.point < b.point : a.sphere < b.sphere;
+    });
+}
+
+void NarrowphaseGrid::TestSphere(const float* x, const float* y, const float* z, const uint32_t* ids, size_t count,
+                                 float cx, float cy, float cz, float reach, uint32_t sphere,
+                                 std::vector<NarrowphaseHit>& hits)
+{
+    const float reachSq = reach * reach;
+
+#if defined(NARROWPHASE_AVX2)
+    const __m256 vcx = _mm256_set1_ps(cx);
+    const __m256 vcy = _mm256_set1_ps(cy);
+    const __m256 vcz = _mm256_set1_ps(cz);
+    const __m256 vReachSq = _mm256_set1_ps(reachSq);
+    for (size_t i = 0; i < count; i += 8)
+    {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), vcx);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), vcy);
+        const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), vcz);
+        // Separate multiplies and adds: no fused rounding, same as scalar
+        const __m256 distSq = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+        const int mask = _mm256_movemask_ps(_mm256_cmp_ps(distSq, vReachSq, _CMP_LE_OQ));
+        if (mask != 0)
+        {
+            EmitLanes(mask, ids + i, sphere, hits);
+        }
+    }
+#elif defined(NARROWPHASE_SSE2)
+    const __m128 vcx = _mm_set1_ps(cx);
+    const __m128 vcy = _mm_set1_ps(cy);
+    const __m128 vcz = _mm_set1_ps(cz);
+    const __m128 vReachSq = _mm_set1_ps(reachSq);
+    for (size_t i = 0; i < count; i += 4)
+    {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), vcx);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), vcy);
+        const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), vcz);
+        const __m128 distSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+        const int mask = _mm_movemask_ps(_mm_cmple_ps(distSq, vReachSq));
+        if (mask != 0)
+        {
+            EmitLanes(mask, ids + i, sphere, hits);
+        }
+    }
+#else
+    for (size_t i = 0; i < count; i++)
+    {
+        const float dx = x[i] - cx;
+        const float dy = y[i] - cy;
+        const float dz = z[i] - cz;
+        if (dx * dx + dy * dy + dz * dz <= reachSq)
+        {
+            hits.push_back({ids[i], sphere});
+        }
+    }
+#endif
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * A point that lies inside a sphere (indices in the order they were added).
+ */
+struct NarrowphaseHit {
+    uint32_t point;
+    uint32_t sphere;
+};
+
+/**
+ * Batch point-in-sphere tests, used for bullets against tank hit volumes.
+ *
+ * Points are binned into a uniform grid over the XZ plane and packed per
+ * cell as structure of arrays, padded to whole vectors. Run() tests each
+ * sphere against the points of every cell its bounding square touches,
+ * a vector of points per compare (AVX2 eight lanes, SSE2 four, scalar
+ * otherwise). A point lives in exactly one cell, so each pair is tested at
+ * most once. Coordinates outside the grid are clamped to the border cells,
+ * which keeps them testable.
+ *
+ * The test is dx * dx + dy * dy + dz * dz <= reach * reach, evaluated in
+ * that order on every path, so the hits match the scalar sphere test bit
+ * for bit.
+ */
+class NarrowphaseGrid {
+public:
+    static constexpr size_t LANES = 8;
+    static constexpr float CELL_SIZE = 8.0f;
+
+    // Drop all points and spheres and cover [0, sizeX) x [0, sizeZ)
+    void Reset(float sizeX, float sizeZ);
+
+    void AddPoint(float x, float y, float z);
+    void AddSphere(float x, float y, float z, float reach);
+
+    size_t GetNumPoints() const { return pointX.size(); }
+    size_t GetNumSpheres() const { return sphereX.size(); }
+
+    // Replace hits with every overlapping pair, sorted by point then sphere
+    void Run(std::vector<NarrowphaseHit>& hits);
+
+    // The kernel: count points (a multiple of LANES) against one sphere
+    static void TestSphere(const float* x, const float* y, const float* z, const uint32_t* ids, size_t count,
+                           float cx, float cy, float cz, float reach, uint32_t sphere,
+                           std::vector<NarrowphaseHit>& hits);
+
+private:
+    int CellX(float x) const;
+    int CellZ(float z) const;
+
+    int cellsX = 1;
+    int cellsZ = 1;
+
+    // As added
+    std::vector<float> pointX, pointY, pointZ;
+    std::vector<uint32_t> pointCell;
+    std::vector<float> sphereX, sphereY, sphereZ, sphereReach;
+
+    // Points packed by cell; cell c owns [cellStart[c], cellStart[c + 1])
+    std::vector<uint32_t> cellStart;
+    std::vector<uint32_t> cellFill;
+    std::vector<float> packedX, packedY, packedZ;
+    std::vector<uint32_t> packedIds;
+};
@@ -0,0 +1,438 @@
+#include "BulletSystem.h"
+#include "../Bullet.h"
+#include "../GameWorld.h"
+#include "../Logger.h"
+#include "../Tank.h"
+#include "../TankTypeManager.h"
+#include "../math.h"
+#include "../events/CollisionEvents.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <random>
+
+// The kernel builds on the SSE2 helpers of math.h
+#ifdef MATH_SSE2
+#define BULLET_SYSTEM_SSE2 1
+#endif
+
+namespace {
+    const uint8_t EXPIRED = 1;
+    const uint8_t OUT_OF_BOUNDS = 2;
+
+    // Bullet hit radius used by the tank tests (as in Bullet::NextFrame)
+    const float BULLET_RADIUS = 0.1f;
+
+    size_t PaddedSize(size_t n)
+    {
+        return (n + BulletSystem::LANES - 1) / BulletSystem::LANES * BulletSystem::LANES;
+    }
+
+    // Reference lane of the kernel: identical arithmetic to the SSE2 path
+    inline void IntegrateLane(float dT, float& x, float& z, float& ry, float& dty, float spinUp,
+                              float& age, float maxAge, float moveRate, float boundsX, float boundsZ,
+                              float& xpp, float& zpp, uint8_t& flags)
+    {
+        age += dT;
+
+        const float spin = spinUp * dT;
+        dty += (dty < 0.0f) ? -spin : spin;
+        ry += dT * dty;
+        ry = (ry > 360.0f) ? ry - 360.0f : ry;
+
+        float t, tc;
+        degreesToTurns(ry, t, tc);
+
+        const float step = dT * moveRate;
+        xpp = step * sinTurns(tc);
+        zpp = step * sinTurns(t);
+        x += xpp;
+        z += zpp;
+
+        flags = 0;
+        flags |= (age >= maxAge) ? EXPIRED : 0;
+        flags |= (x >= boundsX || x <= 0.0f || z >= boundsZ || z <= 0.0f) ? OUT_OF_BOUNDS : 0;
+    }
+}
+
+BulletSystem::~BulletSystem()
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (owners[i])
+        {
+            Release(owners[i]);
+        }
+    }
+}
+
+void BulletSystem::Resize(size_t newCount)
+{
+    const size_t padded = PaddedSize(newCount);
+    if (padded != x.size())
+    {
+        for (auto* array : {&x, &y, &z, &ry, &dty, &spinUp, &age, &maxAge, &moveRate, &xpp, &zpp})
+        {
+            array->resize(padded, 0.0f);
+        }
+        bounces.resize(padded, 0);
+        maxBounces.resize(padded, 0);
+        flags.resize(padded, 0);
+        owners.resize(padded, nullptr);
+    }
+    count = newCount;
+}
+
+void BulletSystem::Attach(Bullet* bullet)
+{
+    if (!bullet || bullet->system)
+    {
+        return;
+    }
+
+    const size_t i = count;
+    Resize(count + 1);
+
+    x[i] = bullet->x;
+    y[i] = bullet->y;
+    z[i] = bullet->z;
+    ry[i] = bullet->ry;
+    dty[i] = bullet->dty;
+    spinUp[i] = (bullet->type1 == TankType::TYPE_PURPLE && bullet->isSpecial) ? 1000.0f : 0.0f;
+    age[i] = bullet->dT;
+    maxAge[i] = bullet->maxdT;
+    moveRate[i] = bullet->moveRate;
+    xpp[i] = 0.0f;
+    zpp[i] = 0.0f;
+    bounces[i] = bullet->numbounces;
+    maxBounces[i] = bullet->maxbounces;
+    flags[i] = 0;
+    owners[i] = bullet;
+
+    bullet->system = this;
+    bullet->slot = i;
+
+    // The per-bullet path wrapped rz a turn per tick; rx and rz never change
+    // afterwards, so settle it once here
+    while (bullet->rz > 360)
+    {
+        bullet->rz -= 360;
+    }
+}
+
+void BulletSystem::Release(Bullet* bullet)
+{
+    if (!bullet || bullet->system != this)
+    {
+        return;
+    }
+
+    bullet->LoadState();
+    owners[bullet->slot] = nullptr;
+    bullet->system = nullptr;
+    bullet->slot = 0;
+    hasGaps = true;
+}
+
+void BulletSystem::Compact()
+{
+    if (!hasGaps)
+    {
+        return;
+    }
+
+    size_t out = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!owners[i])
+        {
+            continue;
+        }
+        if (out != i)
+        {
+            x[out] = x[i];
+            y[out] = y[i];
+            z[out] = z[i];
+            ry[out] = ry[i];
+            dty[out] = dty[i];
+            spinUp[out] = spinUp[i];
+            age[out] = age[i];
+            maxAge[out] = maxAge[i];
+            moveRate[out] = moveRate[i];
+            xpp[out] = xpp[i];
+            zpp[out] = zpp[i];
+            bounces[out] = bounces[i];
+            maxBounces[out] = maxBounces[i];
+            flags[out] = flags[i];
+            owners[out] = owners[i];
+            owners[out]->slot = out;
+            owners[i] = nullptr;
+        }
+        out++;
+    }
+    Resize(out);
+    hasGaps = false;
+}
+
+void BulletSystem::Integrate(float dT)
+{
+    const size_t padded = PaddedSize(count);
+
+#ifdef BULLET_SYSTEM_SSE2
+    const __m128 vdT = _mm_set1_ps(dT);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 full = _mm_set1_ps(360.0f);
+    const __m128 vBoundsX = _mm_set1_ps(boundsX);
+    const __m128 vBoundsZ = _mm_set1_ps(boundsZ);
+
+    for (size_t i = 0; i < padded; i += LANES)
+    {
+        const __m128 vAge = _mm_add_ps(_mm_loadu_ps(&age[i]), vdT);
+
+        // Special purple bullets spin up away from zero
+        __m128 vDty = _mm_loadu_ps(&dty[i]);
+        __m128 spin = _mm_mul_ps(_mm_loadu_ps(&spinUp[i]), vdT);
+        spin = _mm_xor_ps(spin, _mm_and_ps(_mm_cmplt_ps(vDty, zero), signBit));
+        vDty = _mm_add_ps(vDty, spin);
+
+        __m128 vRy = _mm_add_ps(_mm_loadu_ps(&ry[i]), _mm_mul_ps(vdT, vDty));
+        vRy = selectPs(_mm_cmpgt_ps(vRy, full), _mm_sub_ps(vRy, full), vRy);
+
+        // Heading in turns, wrapped to [-0.5, 0.5]; cosine is a quarter turn ahead
+        __m128 t, tc;
+        degreesToTurns4(vRy, t, tc);
+
+        const __m128 step = _mm_mul_ps(vdT, _mm_loadu_ps(&moveRate[i]));
+        const __m128 vXpp = _mm_mul_ps(step, sinTurns4(tc));
+        const __m128 vZpp = _mm_mul_ps(step, sinTurns4(t));
+        const __m128 vX = _mm_add_ps(_mm_loadu_ps(&x[i]), vXpp);
+        const __m128 vZ = _mm_add_ps(_mm_loadu_ps(&z[i]), vZpp);
+
+        _mm_storeu_ps(&age[i], vAge);
+        _mm_storeu_ps(&dty[i], vDty);
+        _mm_storeu_ps(&ry[i], vRy);
+        _mm_storeu_ps(&xpp[i], vXpp);
+        _mm_storeu_ps(&zpp[i], vZpp);
+        _mm_storeu_ps(&x[i], vX);
+        _mm_storeu_ps(&z[i], vZ);
+
+        const int expired = _mm_movemask_ps(_mm_cmpge_ps(vAge, _mm_loadu_ps(&maxAge[i])));
+        const __m128 outside = _mm_or_ps(_mm_or_ps(_mm_cmpge_ps(vX, vBoundsX), _mm_cmple_ps(vX, zero)),
+                                         _mm_or_ps(_mm_cmpge_ps(vZ, vBoundsZ), _mm_cmple_ps(vZ, zero)));
+        const int outOfBounds = _mm_movemask_ps(outside);
+        for (size_t lane = 0; lane < LANES; lane++)
+        {
+            flags[i + lane] = static_cast<uint8_t>((((expired >> lane) & 1) ? EXPIRED : 0) |
+                                                   (((outOfBounds >> lane) & 1) ? OUT_OF_BOUNDS : 0));
+        }
+    }
+#else
+    for (size_t i = 0; i < padded; i++)
+    {
+        IntegrateLane(dT, x[i], z[i], ry[i], dty[i], spinUp[i], age[i], maxAge[i], moveRate[i],
+                      boundsX, boundsZ, xpp[i], zpp[i], flags[i]);
+    }
+#endif
+}
+
+void BulletSystem::Update(GameWorld& world, float dT)
+{
+    Compact();
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Same bounds the per-bullet path asked the collision system for
+    GetLevelBoundsQuery boundsQuery;
+    world.GetEventBus().Publish(boundsQuery);
+    boundsX = boundsQuery.sizeX;
+    boundsZ = boundsQuery.sizeZ;
+
+    Integrate(dT);
+    TestCollisions(world);
+}
+
+void BulletSystem::TestCollisions(GameWorld& world)
+{
+    // Tanks do not move while bullets update: snapshot them once
+    narrowphase.Reset(boundsX, boundsZ);
+    tankPtr.clear();
+    const CollisionSystem& collision = world.GetCollisionSystem();
+    for (const auto& tank : world.GetTanks())
+    {
+        float radius = 0.0f;
+        if (tank->IsAlive() && collision.GetTankRadius(tank.get(), radius))
+        {
+            narrowphase.AddSphere(tank->x, tank->y, tank->z, BULLET_RADIUS + radius);
+            tankPtr.push_back(tank.get());
+        }
+    }
+
+    // Point i is bullet i's position; point count + i is halfway back along
+    // its step, the extra probe for fast-moving bullets
+    for (size_t i = 0; i < count; i++)
+    {
+        narrowphase.AddPoint(x[i], y[i], z[i]);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        narrowphase.AddPoint(x[i] - xpp[i] / 2, y[i], z[i] - zpp[i] / 2);
+    }
+    narrowphase.Run(tankHits);
+
+    // Each point's hits come in tank order, so the first one a bullet may take is the
+    // tank the scalar scan would find: anyone but its owner, or the owner
+    // itself once the bullet is half a second old
+    targets.assign(count * 2, -1);
+    for (const NarrowphaseHit& hit : tankHits)
+    {
+        const size_t i = hit.point % count;
+        if (targets[hit.point] < 0 && owners[i] &&
+            (tankPtr[hit.sphere]->identity != owners[i]->ownerIdentity || age[i] > 0.5f))
+        {
+            targets[hit.point] = static_cast<int32_t>(hit.sphere);
+        }
+    }
+
+    LevelHandler& level = world.GetLevelHandler();
+    EventBus& bus = world.GetEventBus();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        Bullet* bullet = owners[i];
+        if (!bullet || !bullet->alive)
+        {
+            continue;
+        }
+
+        // Sweep the whole step, so no wall or corner is skipped at low tick rates
+        LevelRayHit hit;
+        if (level.Raycast(x[i] - xpp[i], y[i], z[i] - zpp[i], x[i], y[i], z[i], hit))
+        {
+            // Bullet::HandleLevelCollision bounces or destroys it
+            bus.Post(BulletLevelCollisionEvent(bullet, hit.x, hit.y, hit.z, xpp[i], zpp[i], ry[i], hit.normalX, hit.normalZ));
+            continue;
+        }
+
+        if (targets[i] >= 0)
+        {
+            bus.Post(BulletCollisionEvent(bullet, tankPtr[targets[i]], x[i], y[i], z[i]));
+            continue;
+        }
+
+        // Also check halfway back along the step for fast-moving bullets
+        if (targets[count + i] >= 0)
+        {
+            bus.Post(BulletCollisionEvent(bullet, tankPtr[targets[count + i]], x[i] - xpp[i] / 2, y[i], z[i] - zpp[i] / 2));
+            continue;
+        }
+
+        if (flags[i] & OUT_OF_BOUNDS)
+        {
+            bus.Post(BulletOutOfBoundsEvent(bullet, x[i], y[i], z[i]));
+        }
+        else if (flags[i] & EXPIRED)
+        {
+            bus.Post(BulletTimeoutEvent(bullet, age[i]));
+        }
+    }
+}
+
+void BulletSystem::RunBenchmark(int numBullets, int ticks)
+{
+    const bool wasLogging = Logger::Get().IsEnabled();
+    Logger::Get().SetEnabled(false);
+
+    // An open arena with a wall ring, so bullets bounce forever
+    GameWorld world;
+    world.Initialize();
+    LevelHandler& level = world.GetLevelHandler();
+    level.Flatten(0);
+    for (int i = 0; i < level.sizeX; i++)
+    {
+        level.SetTerrainHeight(i, 0, 4);
+        level.SetTerrainHeight(i, level.sizeZ - 1, 4);
+    }
+    for (int i = 0; i < level.sizeZ; i++)
+    {
+        level.SetTerrainHeight(0, i, 4);
+        level.SetTerrainHeight(level.sizeX - 1, i, 4);
+    }
+
+    std::mt19937 rng(1);
+    const Color color = TankTypeManager::GetTankTypeColor(TankType::TYPE_PURPLE);
+    for (int i = 0; i < numBullets; i++)
+    {
+        const float bx = 2.0f + (rng() % 1000) * (level.sizeX - 4) / 1000.0f;
+        const float bz = 2.0f + (rng() % 1000) * (level.sizeZ - 4) / 1000.0f;
+        // Every fourth bullet is a purple spiral
+        const float dTpressed = (i % 4 == 0) ? 0.5f : 0.0f;
+        world.CreateBullet(TankIdentity::Enemy(i % 8), 1.0f, (i % 4 == 0) ? TankType::TYPE_PURPLE : TankType::TYPE_RED,
+                           TankType::TYPE_GREY, 1 << 30, dTpressed, color, color,
+                           bx, 0.25f, bz, 0.0f, static_cast<float>(rng() % 360), 0.0f);
+    }
+
+    const float dT = 1.0f / 60.0f;
+    world.Update(dT);   // Sets the world clock the per-bullet path reads
+
+    // Per-bullet reference path (virtual update, scalar trig, bus queries)
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; tick++)
+    {
+        for (const auto& bullet : world.GetBullets())
+        {
+            bullet->NextFrame();
+        }
+        world.GetEventBus().ProcessQueuedEvents();
+    }
+    const double legacySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    BulletSystem& system = world.GetBulletSystem();
+    start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; tick++)
+    {
+        system.Update(world, dT);
+        world.GetEventBus().ProcessQueuedEvents();
+    }
+    const double batchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < ticks; tick++)
+    {
+        system.Integrate(dT);
+    }
+    const double integrateSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const size_t alive = system.GetCount();
+    world.Shutdown();
+    Logger::Get().SetEnabled(wasLogging);
+
+    const double perBullet = 1.0e9 / (static_cast<double>(numBullets) * std::max(1, ticks));
+    Logger::Get().Write("BulletSystem: %d bullets x %d ticks (%zu left): per-bullet %.1f ns, batch %.1f ns, integrate only %.2f ns per bullet-tick (%.1fx)\n",
+                        numBullets, ticks, alive, legacySeconds * perBullet, batchSeconds * perBullet,
+                        integrateSeconds * perBullet, batchSeconds > 0.0 ? legacySeconds / batchSeconds : 0.0);
+}
+
+bool BulletSystem::ParseCommandLine(int argc, char* argv[], int& numBullets, int& ticks)
+{
+    bool benchmark = false;
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--bullet-benchmark") == 0 && hasValue)
+        {
+            benchmark = true;
+            numBullets = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue)
+        {
+            ticks = std::atoi(argv[++i]);
+        }
+    }
+    return benchmark;
+}
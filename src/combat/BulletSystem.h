@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../collision/NarrowphaseGrid.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Bullet;
+class GameWorld;
+class Tank;
+
+/**
+ * Motion state of every bullet in a world, stored as structure of arrays.
+ *
+ * Bullet objects keep their cold data (colors, owner, power, types) and a
+ * slot index into these arrays. Each tick Update() first integrates all
+ * bullets in one vectorized pass (age, spiral spin-up, heading, position,
+ * lifetime and bounds flags; SSE2 where available, four lanes at a time
+ * either way), then tests level and tanks in a batch against a snapshot of
+ * the tanks, posting the same events Bullet::NextFrame would. Tank hits
+ * come from one NarrowphaseGrid pass over every bullet's end point and
+ * step midpoint. Bounces stay
+ * with Bullet::HandleLevelCollision, driven by those events.
+ *
+ * Released slots (destroyed bullets) are dropped by Compact(), which keeps
+ * the remaining bullets in creation order.
+ */
+class BulletSystem {
+public:
+    static constexpr size_t LANES = 4;
+
+    BulletSystem() = default;
+    ~BulletSystem();
+
+    BulletSystem(const BulletSystem&) = delete;
+    BulletSystem& operator=(const BulletSystem&) = delete;
+
+    // Move a detached bullet's motion state into a new slot
+    void Attach(Bullet* bullet);
+    // Copy the state back into the bullet and free its slot
+    void Release(Bullet* bullet);
+    // Close the gaps left by released bullets
+    void Compact();
+
+    size_t GetCount() const { return count; }
+
+    // One tick for every attached bullet of world
+    void Update(GameWorld& world, float dT);
+
+    // Only the vectorized integration step (benchmarking)
+    void Integrate(float dT);
+
+    // Time legacy per-bullet updates against the batch path on a level
+    static void RunBenchmark(int numBullets, int ticks);
+
+    // Parses --bullet-benchmark <bullets> [--ticks <n>]; returns false
+    // when the benchmark was not requested
+    static bool ParseCommandLine(int argc, char* argv[], int& numBullets, int& ticks);
+
+private:
+    friend class Bullet;
+
+    void Resize(size_t newCount);
+    void TestCollisions(GameWorld& world);
+
+    size_t count = 0;
+    bool hasGaps = false;
+
+    // Per bullet, padded to a multiple of LANES
+    std::vector<float> x, y, z;
+    std::vector<float> ry;          // Heading (degrees)
+    std::vector<float> dty;         // Angular velocity (degrees/s), purple spiral
+    std::vector<float> spinUp;      // |d(dty)/dt| for special purple bullets, else 0
+    std::vector<float> age;         // Seconds since fired
+    std::vector<float> maxAge;
+    std::vector<float> moveRate;
+    std::vector<float> xpp, zpp;    // Last step (needed by bounces and swept hits)
+    std::vector<int32_t> bounces;
+    std::vector<int32_t> maxBounces;
+    std::vector<uint8_t> flags;     // Kernel output: EXPIRED / OUT_OF_BOUNDS
+    std::vector<Bullet*> owners;    // Null for released slots
+
+    float boundsX = 0.0f;
+    float boundsZ = 0.0f;
+
+    // Tank snapshot and scratch for the batch hit tests
+    std::vector<Tank*> tankPtr;
+    NarrowphaseGrid narrowphase;
+    std::vector<NarrowphaseHit> tankHits;
+    std::vector<int32_t> targets;   // First tank hit per tested point, or -1
+};
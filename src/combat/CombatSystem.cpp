@@ -1,27 +1,30 @@
 #include "CombatSystem.h"
-#include "../events/Events.h"
+#include "../GameWorld.h"
 #include "../Bullet.h"
 #include "../Tank.h"
 #include "../TankHandler.h"
 #include "../PlayerManager.h"
-#include "../App.h"
+#include "../Logger.h"
 #include <cmath>
 
-void CombatSystem::Initialize() {
+void CombatSystem::Initialize(GameWorld* world) {
+    gameWorld = world;
+    EventBus& bus = gameWorld->GetEventBus();
+
     // Subscribe to collision events
-    Events::GetBus().Subscribe<BulletCollisionEvent>([this](const BulletCollisionEvent& event) {
+    bus.Subscribe<BulletCollisionEvent>([this](const BulletCollisionEvent& event) {
         OnBulletCollision(event);
     });
     
-    Events::GetBus().Subscribe<BulletLevelCollisionEvent>([this](const BulletLevelCollisionEvent& event) {
+    bus.Subscribe<BulletLevelCollisionEvent>([this](const BulletLevelCollisionEvent& event) {
         OnBulletLevelCollision(event);
     });
     
-    Events::GetBus().Subscribe<BulletOutOfBoundsEvent>([this](const BulletOutOfBoundsEvent& event) {
+    bus.Subscribe<BulletOutOfBoundsEvent>([this](const BulletOutOfBoundsEvent& event) {
         OnBulletOutOfBounds(event);
     });
     
-    Events::GetBus().Subscribe<BulletTimeoutEvent>([this](const BulletTimeoutEvent& event) {
+    bus.Subscribe<BulletTimeoutEvent>([this](const BulletTimeoutEvent& event) {
         OnBulletTimeout(event);
     });
 }
@@ -54,7 +57,7 @@ void CombatSystem::OnBulletLevelCollision(const BulletLevelCollisionEvent& event
     if (!bullet) return;
     
     // Delegate to bullet's existing level collision logic for now
-    bullet->HandleLevelCollision(event.xMovement, event.zMovement, event.originalAngle);
+    bullet->HandleLevelCollision(event.xMovement, event.zMovement, event.originalAngle, event.normalX, event.normalZ);
 }
 
 void CombatSystem::OnBulletOutOfBounds(const BulletOutOfBoundsEvent& event) {
@@ -118,7 +121,7 @@ void CombatSystem::HandleBulletPlayerCollision(Bullet* bullet, Tank* player) {
     if (bullet->GetOwnerIdentity() == player->identity) {
         // Self-collision
         if (bullet->GetDT() > 0.5f) {
-            App::GetSingleton().soundTask->PlayChannel(3);
+            gameWorld->GetEventBus().Publish(PlaySoundEvent(3));
             if (player->health < player->maxHealth) {
                 player->health += bullet->GetPower() / 2;
             } else if (player->energy < player->maxEnergy) {
@@ -128,9 +131,9 @@ void CombatSystem::HandleBulletPlayerCollision(Bullet* bullet, Tank* player) {
         return;
     }
     
-    if (bullet->GetOwnerIdentity().IsPlayer() && !App::GetSingleton().gameTask->IsVersusMode()) {
+    if (bullet->GetOwnerIdentity().IsPlayer() && !gameWorld->IsVersusMode()) {
         // Friendly fire in non-versus mode (healing)
-        App::GetSingleton().soundTask->PlayChannel(3);
+        gameWorld->GetEventBus().Publish(PlaySoundEvent(3));
         if (player->health < player->maxHealth * 2) {
             player->health += bullet->GetPower() / 2;
         } else if (player->energy < player->maxEnergy * 2) {
@@ -141,14 +144,14 @@ void CombatSystem::HandleBulletPlayerCollision(Bullet* bullet, Tank* player) {
         ApplyTankDamage(player, bullet->GetPower(), bullet);
         
         // Create star effects for player hits
-        Events::GetBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_STAR), 
+        gameWorld->GetEventBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_STAR), 
             bullet->GetX(), bullet->GetY(), bullet->GetZ(), 0, .01f, 0, 0, player->ry, 90, 
             bullet->GetR(), bullet->GetG(), bullet->GetB(), 1));
-        Events::GetBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_STAR), 
+        gameWorld->GetEventBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_STAR), 
             bullet->GetX(), bullet->GetY(), bullet->GetZ(), 0, .01f, 2, 0, bullet->GetRY(), 90, 
             bullet->GetR(), bullet->GetG(), bullet->GetB(), 1));
         
-        App::GetSingleton().soundTask->PlayChannel(8);
+        gameWorld->GetEventBus().Publish(PlaySoundEvent(8));
         
         // Update attacker combos
         if (bullet->GetOwnerIdentity().IsEnemy()) {  // Enemy bullet hit player
@@ -161,7 +164,7 @@ void CombatSystem::ApplyTankDamage(Tank* tank, float damage, Bullet* source) {
     tank->health -= damage;
     
     // Post damage event
-    Events::GetBus().Post(TankDamagedEvent(tank, source, damage, tank->health, tank->health <= 0));
+    gameWorld->GetEventBus().Post(TankDamagedEvent(tank, source, damage, tank->health, tank->health <= 0));
 }
 
 void CombatSystem::UpdatePlayerCombos(int playerIndex, Tank* target, Bullet* bullet) {
@@ -175,7 +178,7 @@ void CombatSystem::UpdatePlayerCombos(int playerIndex, Tank* target, Bullet* bul
                        playerIndex, bullet->GetTankId(), target->health);
     
     // Get player from PlayerManager
-    Player* player = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayer(playerIndex);
+    Player* player = gameWorld->GetPlayerManager().GetPlayer(playerIndex);
     if (!player) {
         Logger::Get().Write("WARNING: UpdatePlayerCombos - no player found for index=%d\n", playerIndex);
         return;
@@ -202,7 +205,7 @@ void CombatSystem::UpdatePlayerCombos(int playerIndex, Tank* target, Bullet* bul
             player->AddCombo(player->GetComboNumber() / 2.0f, player->GetComboNumber());
             playerTank->bonus = 23;
             playerTank->bonusTime = 0;
-            Events::GetBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE),
+            gameWorld->GetEventBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE),
                 playerTank->x, playerTank->y, playerTank->z,
                 0, .01f, 0, 0, 0, 90, 0.5f, 0.5f, 0, 1));
         }
@@ -211,7 +214,7 @@ void CombatSystem::UpdatePlayerCombos(int playerIndex, Tank* target, Bullet* bul
             player->AddCombo(dist / 10.0f, player->GetComboNumber());
             playerTank->bonus = 21;
             playerTank->bonusTime = 0;
-            Events::GetBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE),
+            gameWorld->GetEventBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE),
                 playerTank->x, playerTank->y, playerTank->z,
                 0, .01f, 0, 0, 0, 90, 0, 1, 1, 1));
         }
@@ -220,7 +223,7 @@ void CombatSystem::UpdatePlayerCombos(int playerIndex, Tank* target, Bullet* bul
             player->AddCombo(1 + bullet->GetDT() / 2.0f, player->GetComboNumber());
             playerTank->bonus = 22;
             playerTank->bonusTime = 0;
-            Events::GetBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE),
+            gameWorld->GetEventBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE),
                 playerTank->x, playerTank->y, playerTank->z,
                 0, .01f, 0, 0, 0, 90, 0.5f, 0.5f, 0, 1));
         }
@@ -240,15 +243,15 @@ void CombatSystem::UpdatePlayerCombos(int playerIndex, Tank* target, Bullet* bul
 }
 
 void CombatSystem::CreateCollisionEffects(float x, float y, float z, float r, float g, float b, float angle) {
-    Events::GetBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE), 
+    gameWorld->GetEventBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE), 
         x, y, z, 0, .01f, 0, 0, angle, 90, r, g, b, 1));
-    Events::GetBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE), 
+    gameWorld->GetEventBus().Post(CreateFXEvent(static_cast<int>(FxType::TYPE_SMALL_SQUARE), 
         x, y, z, 0, .01f, 2, 0, angle + 180, 90, r, g, b, 1));
 }
 
 void CombatSystem::ResetPlayerCombo(int playerIndex) {
     if (playerIndex < 0 || playerIndex >= 4) return;
-    Player* player = App::GetSingleton().gameTask->GetPlayerManager()->GetPlayer(playerIndex);
+    Player* player = gameWorld->GetPlayerManager().GetPlayer(playerIndex);
     if (player) {
         player->ResetHitCombo();
     }
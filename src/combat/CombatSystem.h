@@ -6,6 +6,8 @@
 #include "../Bullet.h"
 #include "../Item.h"
 
+class GameWorld;
+
 /**
  * Handles combat-related collision responses.
  * Processes collision events and applies appropriate game logic.
@@ -15,10 +17,12 @@ public:
     CombatSystem() = default;
     ~CombatSystem() = default;
     
-    void Initialize();
+    void Initialize(GameWorld* world);
     void Shutdown();
     
 private:
+    GameWorld* gameWorld = nullptr;  // Owning world (event bus, players, rules)
+
     // Event handlers for different collision types
     void OnBulletCollision(const BulletCollisionEvent& event);
     void OnBulletLevelCollision(const BulletLevelCollisionEvent& event);
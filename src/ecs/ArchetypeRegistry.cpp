@@ -0,0 +1,186 @@
+#include "ArchetypeRegistry.h"
+#include <algorithm>
+
+namespace {
+    size_t AlignUp(size_t value, size_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+Archetype::Archetype(const ComponentMask& mask, std::vector<ComponentInfo> components)
+    : mask(mask), components(std::move(components))
+{
+    std::fill(std::begin(slotOfComponent), std::end(slotOfComponent), -1);
+
+    // Leave room for aligning every column, then fit as many rows as possible
+    size_t rowBytes = 0;
+    size_t padding = 0;
+    for (size_t i = 0; i < this->components.size(); i++)
+    {
+        rowBytes += this->components[i].size;
+        padding += this->components[i].alignment;
+        slotOfComponent[this->components[i].id] = static_cast<int>(i);
+    }
+    rowsPerChunk = rowBytes > 0 ? std::max<size_t>(1, (CHUNK_BYTES - padding) / rowBytes) : CHUNK_BYTES;
+
+    size_t offset = 0;
+    for (const ComponentInfo& component : this->components)
+    {
+        offset = AlignUp(offset, component.alignment);
+        columnOffsets.push_back(offset);
+        offset += component.size * rowsPerChunk;
+    }
+}
+
+size_t Archetype::GetChunkRowCount(size_t chunk) const
+{
+    const size_t first = chunk * rowsPerChunk;
+    return count > first ? std::min(rowsPerChunk, count - first) : 0;
+}
+
+void* Archetype::GetColumn(size_t chunk, size_t componentId)
+{
+    const int slot = componentId < MAX_COMPONENT_TYPES ? slotOfComponent[componentId] : -1;
+    if (slot < 0)
+    {
+        return nullptr;
+    }
+    return reinterpret_cast<unsigned char*>(chunks[chunk].get()) + columnOffsets[slot];
+}
+
+const void* Archetype::GetColumn(size_t chunk, size_t componentId) const
+{
+    return const_cast<Archetype*>(this)->GetColumn(chunk, componentId);
+}
+
+void* Archetype::GetComponent(size_t row, size_t componentId)
+{
+    const int slot = componentId < MAX_COMPONENT_TYPES ? slotOfComponent[componentId] : -1;
+    if (slot < 0)
+    {
+        return nullptr;
+    }
+    unsigned char* column = reinterpret_cast<unsigned char*>(chunks[row / rowsPerChunk].get()) + columnOffsets[slot];
+    return column + (row % rowsPerChunk) * components[slot].size;
+}
+
+size_t Archetype::AddRow(EntityHandle entity)
+{
+    if (count == chunks.size() * rowsPerChunk)
+    {
+        const size_t words = (CHUNK_BYTES + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+        chunks.emplace_back(new std::max_align_t[words]);
+    }
+    entities.push_back(entity);
+    return count++;
+}
+
+EntityHandle Archetype::RemoveRow(size_t row)
+{
+    const size_t last = count - 1;
+    EntityHandle moved;
+    if (row != last)
+    {
+        for (const ComponentInfo& component : components)
+        {
+            std::memcpy(GetComponent(row, component.id), GetComponent(last, component.id), component.size);
+        }
+        entities[row] = entities[last];
+        moved = entities[row];
+    }
+    entities.pop_back();
+    count--;
+
+    // Keep one spare chunk so an add/remove at a boundary does not thrash
+    const size_t needed = (count + rowsPerChunk - 1) / rowsPerChunk;
+    while (chunks.size() > needed + 1)
+    {
+        chunks.pop_back();
+    }
+    return moved;
+}
+
+void Archetype::Clear()
+{
+    count = 0;
+    entities.clear();
+    chunks.clear();
+}
+
+void ArchetypeRegistry::Destroy(EntityHandle handle)
+{
+    if (!IsAlive(handle))
+    {
+        return;
+    }
+
+    Record& record = records[handle.index];
+    const EntityHandle moved = record.archetype->RemoveRow(record.row);
+    if (moved.IsValid())
+    {
+        records[moved.index].row = record.row;
+    }
+
+    record.archetype = nullptr;
+    record.generation++;
+    freeIndices.push_back(handle.index);
+}
+
+bool ArchetypeRegistry::IsAlive(EntityHandle handle) const
+{
+    return handle.index < records.size() &&
+           records[handle.index].archetype != nullptr &&
+           records[handle.index].generation == handle.generation;
+}
+
+void ArchetypeRegistry::Clear()
+{
+    for (const auto& archetype : archetypes)
+    {
+        archetype->Clear();
+    }
+
+    // Keep the generations so old handles stay dead
+    freeIndices.clear();
+    for (uint32_t index = 0; index < records.size(); index++)
+    {
+        Record& record = records[index];
+        if (record.archetype)
+        {
+            record.archetype = nullptr;
+            record.generation++;
+        }
+        freeIndices.push_back(index);
+    }
+}
+
+Archetype& ArchetypeRegistry::FindOrCreateArchetype(const ComponentMask& mask, std::vector<Archetype::ComponentInfo> infos)
+{
+    for (const auto& archetype : archetypes)
+    {
+        if (archetype->GetMask() == mask)
+        {
+            return *archetype;
+        }
+    }
+    archetypes.emplace_back(new Archetype(mask, std::move(infos)));
+    return *archetypes.back();
+}
+
+EntityHandle ArchetypeRegistry::AllocateHandle()
+{
+    EntityHandle handle;
+    if (!freeIndices.empty())
+    {
+        handle.index = freeIndices.back();
+        freeIndices.pop_back();
+    }
+    else
+    {
+        handle.index = static_cast<uint32_t>(records.size());
+        records.emplace_back();
+    }
+    handle.generation = records[handle.index].generation;
+    return handle;
+}
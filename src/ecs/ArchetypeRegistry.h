@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Generation-checked reference to a row of an ArchetypeRegistry. Stays
+ * valid while the entity lives even though its row moves; a handle to a
+ * destroyed entity never resolves again, even after its index is reused.
+ */
+struct EntityHandle {
+    static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    uint32_t index = INVALID_INDEX;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != INVALID_INDEX; }
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+constexpr size_t MAX_COMPONENT_TYPES = 32;
+using ComponentMask = std::bitset<MAX_COMPONENT_TYPES>;
+
+// Process-wide dense id per component type (assigned on first use, which
+// may happen on several simulation threads at once)
+inline size_t NextComponentTypeId()
+{
+    static std::atomic<size_t> next(0);
+    return next.fetch_add(1);
+}
+
+template<typename T>
+size_t ComponentTypeId()
+{
+    static const size_t id = NextComponentTypeId();
+    return id;
+}
+
+/**
+ * All entities with exactly one set of component types. Rows live in fixed
+ * size chunks; inside a chunk each component type has its own contiguous
+ * column, so a system touching two components of a ten-component entity
+ * streams just those two arrays. Removing a row moves the chunk's last row
+ * into the hole, keeping every column dense.
+ */
+class Archetype {
+public:
+    static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+    struct ComponentInfo {
+        size_t id;
+        size_t size;
+        size_t alignment;
+    };
+
+    Archetype(const ComponentMask& mask, std::vector<ComponentInfo> components);
+
+    const ComponentMask& GetMask() const { return mask; }
+    size_t GetCount() const { return count; }
+    size_t GetChunkCount() const { return chunks.size(); }
+    size_t GetRowsPerChunk() const { return rowsPerChunk; }
+    size_t GetChunkRowCount(size_t chunk) const;
+
+    // Column of component type id in a chunk (nullptr if not in this archetype)
+    void* GetColumn(size_t chunk, size_t componentId);
+    const void* GetColumn(size_t chunk, size_t componentId) const;
+
+    void* GetComponent(size_t row, size_t componentId);
+    EntityHandle GetEntity(size_t row) const { return entities[row]; }
+
+    // Append an uninitialized row for entity and return its index
+    size_t AddRow(EntityHandle entity);
+    // Fill the hole with the last row; returns the entity that moved into
+    // row (invalid if row was the last one)
+    EntityHandle RemoveRow(size_t row);
+    void Clear();
+
+private:
+    ComponentMask mask;
+    std::vector<ComponentInfo> components;
+    std::vector<size_t> columnOffsets;          // Parallel to components
+    int slotOfComponent[MAX_COMPONENT_TYPES];   // Component id -> index in components, -1 if absent
+    size_t rowsPerChunk = 1;
+    size_t count = 0;
+    std::vector<std::unique_ptr<std::max_align_t[]>> chunks;
+    std::vector<EntityHandle> entities;         // Per row
+};
+
+/**
+ * Archetype-based entity storage: an entity is a row of plain components
+ * (trivially copyable structs) in the archetype for its exact component
+ * set. Systems iterate with ForEachChunk, which hands them raw column
+ * pointers for only the components they name, across every archetype that
+ * has them.
+ *
+ * The component set is fixed when an entity is created. Creating or
+ * destroying entities while iterating is not allowed; collect the handles
+ * and destroy them afterwards.
+ */
+class ArchetypeRegistry {
+public:
+    ArchetypeRegistry() = default;
+    ArchetypeRegistry(const ArchetypeRegistry&) = delete;
+    ArchetypeRegistry& operator=(const ArchetypeRegistry&) = delete;
+
+    template<typename... Components>
+    EntityHandle Create(const Components&... components)
+    {
+        ComponentMask mask;
+        std::vector<Archetype::ComponentInfo> infos;
+        int describe[] = {0, (Describe<Components>(mask, infos), 0)...};
+        (void)describe;
+
+        Archetype& archetype = FindOrCreateArchetype(mask, std::move(infos));
+        const EntityHandle handle = AllocateHandle();
+        const size_t row = archetype.AddRow(handle);
+        Record& record = records[handle.index];
+        record.archetype = &archetype;
+        record.row = row;
+
+        int store[] = {0, (Store(archetype, row, components), 0)...};
+        (void)store;
+        return handle;
+    }
+
+    void Destroy(EntityHandle handle);
+    bool IsAlive(EntityHandle handle) const;
+    void Clear();
+
+    // Component of a live entity (nullptr if dead or without it)
+    template<typename T>
+    T* Get(EntityHandle handle)
+    {
+        if (!IsAlive(handle)) {
+            return nullptr;
+        }
+        const Record& record = records[handle.index];
+        return static_cast<T*>(record.archetype->GetComponent(record.row, ComponentTypeId<T>()));
+    }
+
+    template<typename T>
+    const T* Get(EntityHandle handle) const
+    {
+        return const_cast<ArchetypeRegistry*>(this)->Get<T>(handle);
+    }
+
+    // fn(size_t count, Components*... columns) once per non-empty chunk of
+    // every archetype that has all of Components
+    template<typename... Components, typename Fn>
+    void ForEachChunk(Fn&& fn)
+    {
+        const ComponentMask required = MaskOf<Components...>();
+        for (const auto& archetype : archetypes) {
+            if ((archetype->GetMask() & required) != required) {
+                continue;
+            }
+            for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++) {
+                const size_t rows = archetype->GetChunkRowCount(chunk);
+                if (rows > 0) {
+                    fn(rows, static_cast<Components*>(archetype->GetColumn(chunk, ComponentTypeId<Components>()))...);
+                }
+            }
+        }
+    }
+
+    template<typename... Components, typename Fn>
+    void ForEachChunk(Fn&& fn) const
+    {
+        const ComponentMask required = MaskOf<Components...>();
+        for (const auto& archetype : archetypes) {
+            if ((archetype->GetMask() & required) != required) {
+                continue;
+            }
+            for (size_t chunk = 0; chunk < archetype->GetChunkCount(); chunk++) {
+                const size_t rows = archetype->GetChunkRowCount(chunk);
+                if (rows > 0) {
+                    const Archetype& view = *archetype;
+                    fn(rows, static_cast<const Components*>(view.GetColumn(chunk, ComponentTypeId<Components>()))...);
+                }
+            }
+        }
+    }
+
+    // fn(EntityHandle, Components&...) for every entity that has all of Components
+    template<typename... Components, typename Fn>
+    void ForEach(Fn&& fn)
+    {
+        const ComponentMask required = MaskOf<Components...>();
+        for (const auto& archetype : archetypes) {
+            if ((archetype->GetMask() & required) != required) {
+                continue;
+            }
+            for (size_t row = 0; row < archetype->GetCount(); row++) {
+                fn(archetype->GetEntity(row),
+                   *static_cast<Components*>(archetype->GetComponent(row, ComponentTypeId<Components>()))...);
+            }
+        }
+    }
+
+    // Entities that have all of Components
+    template<typename... Components>
+    size_t Count() const
+    {
+        const ComponentMask required = MaskOf<Components...>();
+        size_t total = 0;
+        for (const auto& archetype : archetypes) {
+            if ((archetype->GetMask() & required) == required) {
+                total += archetype->GetCount();
+            }
+        }
+        return total;
+    }
+
+    size_t GetArchetypeCount() const { return archetypes.size(); }
+
+private:
+    struct Record {
+        Archetype* archetype = nullptr;     // Null while the index is free
+        size_t row = 0;
+        uint32_t generation = 0;
+    };
+
+    template<typename T>
+    static void Describe(ComponentMask& mask, std::vector<Archetype::ComponentInfo>& infos)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Components are moved with memcpy");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned components are not supported");
+        const size_t id = ComponentTypeId<T>();
+        if (!mask.test(id)) {
+            mask.set(id);
+            infos.push_back({id, sizeof(T), alignof(T)});
+        }
+    }
+
+    template<typename T>
+    static void Store(Archetype& archetype, size_t row, const T& component)
+    {
+        new (archetype.GetComponent(row, ComponentTypeId<T>())) T(component);
+    }
+
+    template<typename... Components>
+    static ComponentMask MaskOf()
+    {
+        ComponentMask mask;
+        int set[] = {0, (mask.set(ComponentTypeId<Components>()), 0)...};
+        (void)set;
+        return mask;
+    }
+
+    Archetype& FindOrCreateArchetype(const ComponentMask& mask, std::vector<Archetype::ComponentInfo> infos);
+    EntityHandle AllocateHandle();
+
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::vector<Record> records;            // Indexed by EntityHandle::index
+    std::vector<uint32_t> freeIndices;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "../Color.h"
+
+enum class TankType;
+
+/**
+ * Plain component types stored in the world's ArchetypeRegistry.
+ * Keep them trivially copyable: rows are moved with memcpy.
+ */
+
+struct Position {
+    float x, y, z;
+};
+
+struct Rotation {
+    float rx, ry, rz;
+};
+
+// Power-up lying on the level
+struct ItemPickup {
+    TankType type;
+    Color color;
+    bool collected;             // Picked up; destroyed at the next world update
+};
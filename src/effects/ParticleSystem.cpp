@@ -0,0 +1,292 @@
+#include "ParticleSystem.h"
+#include "../LevelHandler.h"
+#include "../profiling/QualityGovernor.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+    const float NO_HEIGHT = -std::numeric_limits<float>::infinity();
+    const size_t INITIAL_STORAGE = 64;
+}
+
+ParticlePool::ParticlePool(FxType type, size_t capacity)
+    : type(type),
+      capacity(std::max<size_t>(capacity, 1)),
+      maxTime(ParticleSystem::GetLifetime(type))
+{
+}
+
+void ParticlePool::Grow()
+{
+    const size_t size = data[X].size();
+    const size_t newSize = std::min(std::max(size * 2, INITIAL_STORAGE), capacity);
+
+    // Unroll the ring so the oldest particle lands in slot 0
+    for (std::vector<float>& field : data)
+    {
+        std::vector<float> grown(newSize);
+        for (size_t i = 0; i < count; i++)
+        {
+            grown[i] = field[(head + i) % size];
+        }
+        field.swap(grown);
+    }
+    head = 0;
+}
+
+size_t ParticlePool::Spawn(float x, float y, float z, float vx, float vy, float vz,
+                           float rx, float ry, float rz, const Color& color)
+{
+    if (count == data[X].size())
+    {
+        if (data[X].size() < capacity)
+        {
+            Grow();
+        }
+        else
+        {
+            // Full: recycle the oldest particle
+            head = (head + 1) % capacity;
+            count--;
+        }
+    }
+
+    const size_t slot = (head + count) % data[X].size();
+    count++;
+
+    data[X][slot] = x;
+    data[Y][slot] = y;
+    data[Z][slot] = z;
+    data[VX][slot] = vx;
+    data[VY][slot] = vy;
+    data[VZ][slot] = vz;
+    data[RX][slot] = rx;
+    data[RY][slot] = ry;
+    data[RZ][slot] = rz;
+    data[R][slot] = color.r;
+    data[G][slot] = color.g;
+    data[B][slot] = color.b;
+    data[A][slot] = color.a;
+    data[TIME][slot] = 0.0f;
+    data[FLOOR][slot] = NO_HEIGHT;
+    data[FLOAT_TOP][slot] = NO_HEIGHT;
+    return slot;
+}
+
+void ParticlePool::SetJumpFloor(size_t slot, float floor, float floatTop)
+{
+    data[FLOOR][slot] = floor;
+    data[FLOAT_TOP][slot] = floatTop;
+}
+
+void ParticlePool::Update(float dT)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    const size_t size = data[X].size();
+    const size_t end = head + count;
+    UpdateRange(head, std::min(end, size), dT);
+    if (end > size)
+    {
+        UpdateRange(0, end - size, dT);
+    }
+
+    // Equal lifetimes: the expired particles are exactly the oldest ones
+    while (count > 0 && data[TIME][head] > maxTime)
+    {
+        head = (head + 1) % size;
+        count--;
+    }
+}
+
+void ParticlePool::UpdateRange(size_t begin, size_t end, float dT)
+{
+    float* x = data[X].data();
+    float* y = data[Y].data();
+    float* z = data[Z].data();
+    const float* vx = data[VX].data();
+    const float* vy = data[VY].data();
+    const float* vz = data[VZ].data();
+    float* a = data[A].data();
+    float* time = data[TIME].data();
+
+    // One pass per field so each loop vectorizes
+    const float fade = (type == FxType::TYPE_SMALL_RECTANGLE ? 0.2f : 2.0f) * dT;
+    for (size_t i = begin; i < end; i++)
+    {
+        time[i] += dT;
+    }
+    for (size_t i = begin; i < end; i++)
+    {
+        a[i] -= fade;
+    }
+    for (size_t i = begin; i < end; i++)
+    {
+        x[i] += vx[i] * dT;
+    }
+    for (size_t i = begin; i < end; i++)
+    {
+        y[i] += vy[i] * dT;
+    }
+    for (size_t i = begin; i < end; i++)
+    {
+        z[i] += vz[i] * dT;
+    }
+
+    if (type == FxType::TYPE_DEATH)
+    {
+        // Debris only tumbles while its heading is an even whole number
+        // of degrees, as the FX entity did (few particles; stays scalar)
+        float* rx = data[RX].data();
+        float* ry = data[RY].data();
+        float* rz = data[RZ].data();
+        for (size_t i = begin; i < end; i++)
+        {
+            if (static_cast<int>(ry[i]) % 2 == 0)
+            {
+                ry[i] += 120.0f * dT;
+                rx[i] += 300.0f * dT;
+            }
+            rz[i] += 150.0f * dT;
+        }
+    }
+    else if (type == FxType::TYPE_THREE)
+    {
+        float* rz = data[RZ].data();
+        for (size_t i = begin; i < end; i++)
+        {
+            rz[i] += 300.0f * dT;
+        }
+    }
+    else if (type == FxType::TYPE_JUMP)
+    {
+        // Sink and darken while above the ground; the column heights were
+        // looked up at spawn (jump particles never move sideways), so this
+        // is LevelHandler::PointCollision without touching the level
+        const float* floor = data[FLOOR].data();
+        const float* floatTop = data[FLOAT_TOP].data();
+        float* r = data[R].data();
+        float* g = data[G].data();
+        float* b = data[B].data();
+        for (size_t i = begin; i < end; i++)
+        {
+            const bool grounded = static_cast<float>(static_cast<int>(y[i])) < floor[i] ||
+                                  (y[i] < floatTop[i] && y[i] >= floatTop[i] - 1.0f);
+            const float sink = grounded ? 0.0f : dT;
+            y[i] -= 5.0f * sink;
+            r[i] -= 0.5f * sink;
+            g[i] -= 0.5f * sink;
+            b[i] -= 0.5f * sink;
+        }
+    }
+}
+
+ParticleView ParticlePool::Get(size_t index) const
+{
+    const size_t slot = (head + index) % data[X].size();
+    ParticleView view;
+    view.x = data[X][slot];
+    view.y = data[Y][slot];
+    view.z = data[Z][slot];
+    view.vx = data[VX][slot];
+    view.vy = data[VY][slot];
+    view.vz = data[VZ][slot];
+    view.rx = data[RX][slot];
+    view.ry = data[RY][slot];
+    view.rz = data[RZ][slot];
+    view.color = Color(data[R][slot], data[G][slot], data[B][slot], data[A][slot]);
+    view.time = data[TIME][slot];
+    view.maxTime = maxTime;
+    return view;
+}
+
+ParticleSystem::ParticleSystem(size_t capacityPerType)
+{
+    pools.reserve(static_cast<size_t>(FxType::FX_TYPE_COUNT));
+    for (int type = 0; type < static_cast<int>(FxType::FX_TYPE_COUNT); type++)
+    {
+        pools.emplace_back(static_cast<FxType>(type), capacityPerType);
+    }
+}
+
+void ParticleSystem::Spawn(FxType type, float x, float y, float z, float dx, float dy, float dz,
+                           float rx, float ry, float rz, const Color& color)
+{
+    const int index = static_cast<int>(type);
+    if (index < 0 || index >= static_cast<int>(FxType::FX_TYPE_COUNT))
+    {
+        return;
+    }
+
+    ParticlePool& pool = pools[index];
+    // A full pool recycles its oldest particle; a budget below that drops new ones
+    if (budget && budget->maxParticlesPerType < pool.GetCapacity()
+        && pool.GetCount() >= budget->maxParticlesPerType)
+    {
+        return;
+    }
+    const size_t slot = pool.Spawn(x, y, z, dx, dy * REFERENCE_FRAME_RATE, dz, rx, ry, rz, color);
+
+    if (type == FxType::TYPE_JUMP)
+    {
+        // Without a level nothing is ground and the particle never sinks
+        float floor = std::numeric_limits<float>::infinity();
+        float floatTop = NO_HEIGHT;
+        if (level && x >= 0 && z >= 0 && x < level->sizeX && z < level->sizeZ)
+        {
+            const int cellX = static_cast<int>(x);
+            const int cellZ = static_cast<int>(z);
+            floor = static_cast<float>(level->GetTerrainHeight(cellX, cellZ));
+            const int top = level->GetFloatHeight(cellX, cellZ);
+            if (top > 0)
+            {
+                floatTop = static_cast<float>(top);
+            }
+        }
+        pool.SetJumpFloor(slot, floor, floatTop);
+    }
+}
+
+void ParticleSystem::Update(float dT)
+{
+    for (ParticlePool& pool : pools)
+    {
+        pool.Update(dT);
+    }
+}
+
+void ParticleSystem::Clear()
+{
+    for (ParticlePool& pool : pools)
+    {
+        pool.Clear();
+    }
+}
+
+size_t ParticleSystem::GetCount() const
+{
+    size_t total = 0;
+    for (const ParticlePool& pool : pools)
+    {
+        total += pool.GetCount();
+    }
+    return total;
+}
+
+float ParticleSystem::GetLifetime(FxType type)
+{
+    switch (type)
+    {
+    case FxType::TYPE_SMALL_SQUARE:
+        return 0.2f;
+    case FxType::TYPE_DEATH:
+        return 0.4f;
+    case FxType::TYPE_SMALL_RECTANGLE:
+        return 2.5f;
+    default:
+        return 0.3f;
+    }
+}
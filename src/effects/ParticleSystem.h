@@ -0,0 +1,142 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+#include "../Color.h"
+#include "../FX.h"
+
+class LevelHandler;
+struct QualityBudget;
+
+/**
+ * Continuous particle source with a spawn rate in particles per second.
+ * The fractional remainder carries over between ticks, so the number of
+ * particles over time is the same at any frame rate.
+ */
+struct ParticleEmitter {
+    float rate = 0.0f;          // Particles per second
+    float accumulator = 0.0f;
+
+    ParticleEmitter() = default;
+    explicit ParticleEmitter(float rate) : rate(rate) {}
+
+    // Particles due after dT more seconds of emission, at rateScale times
+    // the nominal rate (the quality budget's spawn scale)
+    int Advance(float dT, float rateScale = 1.0f)
+    {
+        accumulator += rate * rateScale * dT;
+        const int due = static_cast<int>(accumulator);
+        accumulator -= static_cast<float>(due);
+        return due;
+    }
+
+    // Forget the remainder (emission stopped)
+    void Reset() { accumulator = 0.0f; }
+};
+
+/**
+ * Read-only copy of one live particle (rendering, tests).
+ */
+struct ParticleView {
+    float x, y, z;
+    float vx, vy, vz;           // Units per second
+    float rx, ry, rz;
+    Color color;
+    float time;                 // Seconds since spawned
+    float maxTime;
+};
+
+/**
+ * Fixed-capacity ring of particles of one FxType, stored as structure of
+ * arrays. Every particle of a type lives equally long, so particles expire
+ * in spawn order: the live range is always one contiguous run of the ring
+ * (two when it wraps) and expiry just advances the tail. Storage grows on
+ * demand up to the capacity; spawning into a full pool recycles the oldest
+ * particle.
+ */
+class ParticlePool {
+public:
+    enum Field {
+        X, Y, Z,
+        VX, VY, VZ,
+        RX, RY, RZ,
+        R, G, B, A,
+        TIME,
+        FLOOR,                  // Jump particles: terrain height of the column
+        FLOAT_TOP,              // Jump particles: floating block top (-inf if none)
+        FIELD_COUNT
+    };
+
+    ParticlePool(FxType type, size_t capacity);
+
+    FxType GetType() const { return type; }
+    size_t GetCount() const { return count; }
+    size_t GetCapacity() const { return capacity; }
+
+    // Add a particle (velocity in units per second) and return its slot
+    size_t Spawn(float x, float y, float z, float vx, float vy, float vz,
+                 float rx, float ry, float rz, const Color& color);
+    void SetJumpFloor(size_t slot, float floor, float floatTop);
+
+    void Update(float dT);
+    void Clear() { head = 0; count = 0; }
+
+    // index 0 = oldest live particle
+    ParticleView Get(size_t index) const;
+
+private:
+    void Grow();
+    void UpdateRange(size_t begin, size_t end, float dT);
+
+    FxType type;
+    size_t capacity;
+    float maxTime;
+    size_t head = 0;            // Slot of the oldest particle
+    size_t count = 0;
+    std::array<std::vector<float>, FIELD_COUNT> data;
+};
+
+/**
+ * All short-lived visual effects of a world (smoke, jump trails, death
+ * debris, impact sparks, tread marks): one ParticlePool per FxType, updated
+ * in tight per-field loops with no per-particle allocation, virtual call or
+ * level query. Particles only affect the picture; they are not entities and
+ * take no part in collisions.
+ *
+ * Motion matches the former FX entities at REFERENCE_FRAME_RATE: the
+ * per-frame vertical drift those took is converted to units per second at
+ * spawn, so it is now frame-rate independent.
+ */
+class ParticleSystem {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 4096;    // Per FxType
+    static constexpr float REFERENCE_FRAME_RATE = 60.0f;
+
+    explicit ParticleSystem(size_t capacityPerType = DEFAULT_CAPACITY);
+
+    // Level used to resolve where jump particles stop sinking
+    void SetLevel(const LevelHandler* level) { this->level = level; }
+
+    // Quality budget whose particle cap applies (none: capacity only)
+    void SetBudget(const QualityBudget* budget) { this->budget = budget; }
+
+    // dy is per reference frame, dx/dz per second (the FX conventions).
+    // Dropped when the type already has the quality budget's live maximum.
+    void Spawn(FxType type, float x, float y, float z, float dx, float dy, float dz,
+               float rx, float ry, float rz, const Color& color);
+
+    void Update(float dT);
+    void Clear();
+
+    size_t GetCount() const;
+    const ParticlePool& GetPool(FxType type) const { return pools[static_cast<size_t>(type)]; }
+
+    // Lifetime of every particle of a type (seconds)
+    static float GetLifetime(FxType type);
+
+private:
+    const LevelHandler* level = nullptr;
+    const QualityBudget* budget = nullptr;
+    std::vector<ParticlePool> pools;    // Indexed by FxType
+};
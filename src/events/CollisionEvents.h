@@ -2,6 +2,7 @@
 
 #include "Event.h"
 #include "../Entity.h"
+#include "../memory/FrameArena.h"
 #include <vector>
 
 // Collision layer flags for filtering
@@ -57,13 +58,29 @@ struct SphereCollisionQuery : public EventBase<SphereCollisionQuery> {
     CollisionLayer layerMask;
     Entity* excludeEntity;
     
-    // Results (filled by collision system)
-    mutable std::vector<Entity*> results;
+    // Results (filled by collision system; valid for this frame and the next)
+    mutable FrameVector<Entity*> results;
     
     SphereCollisionQuery(float x, float y, float z, float radius, CollisionLayer layers, Entity* exclude = nullptr)
         : x(x), y(y), z(z), radius(radius), layerMask(layers), excludeEntity(exclude) {}
 };
 
+/**
+ * Query for the first level hit along a segment (swept bullets).
+ */
+struct LevelRaycastQuery : public EventBase<LevelRaycastQuery> {
+    float x0, y0, z0;
+    float x1, y1, z1;
+
+    // Results (filled by collision system)
+    mutable bool result = false;
+    mutable float time = 0.0f;                  // Fraction of the segment
+    mutable float normalX = 0.0f, normalZ = 0.0f;
+
+    LevelRaycastQuery(float x0, float y0, float z0, float x1, float y1, float z1)
+        : x0(x0), y0(y0), z0(z0), x1(x1), y1(y1), z1(z1) {}
+};
+
 /**
  * Query to get level boundaries.
  */
@@ -117,9 +134,12 @@ struct BulletLevelCollisionEvent : public EventBase<BulletLevelCollisionEvent> {
     float x, y, z;
     float xMovement, zMovement;  // Movement delta that caused collision
     float originalAngle;
+    float normalX, normalZ;      // Wall face that was hit; zero if unknown
     
-    BulletLevelCollisionEvent(Entity* bullet, float x, float y, float z, float xpp, float zpp, float angle)
-        : bullet(bullet), x(x), y(y), z(z), xMovement(xpp), zMovement(zpp), originalAngle(angle) {}
+    BulletLevelCollisionEvent(Entity* bullet, float x, float y, float z, float xpp, float zpp, float angle,
+                              float normalX = 0.0f, float normalZ = 0.0f)
+        : bullet(bullet), x(x), y(y), z(z), xMovement(xpp), zMovement(zpp), originalAngle(angle),
+          normalX(normalX), normalZ(normalZ) {}
 };
 
 // === GAME EVENTS FOR REACTIONS ===
@@ -159,3 +179,37 @@ struct TankDamagedEvent : public EventBase<TankDamagedEvent> {
     TankDamagedEvent(Entity* tank, Entity* source, float damage, float newHealth, bool dead)
         : tank(tank), source(source), damage(damage), newHealth(newHealth), isDead(dead) {}
 };
+
+/**
+ * Event for playing a sound effect.
+ * Published synchronously on the owning world's bus; the interactive game
+ * forwards it to SoundTask, while headless worlds have no subscriber and
+ * stay silent.
+ */
+struct PlaySoundEvent : public EventBase<PlaySoundEvent> {
+    enum class Mixing { NONE, POSITION, VOLUME };
+
+    int channel;
+    Mixing mixing;
+    float angle;   // POSITION: stereo angle in degrees
+    int distance;  // POSITION: attenuation distance
+    int volume;    // VOLUME: channel volume (0-128)
+
+    explicit PlaySoundEvent(int channel)
+        : channel(channel), mixing(Mixing::NONE), angle(0), distance(0), volume(0) {}
+
+    static PlaySoundEvent Positioned(int channel, float angle, int distance) {
+        PlaySoundEvent event(channel);
+        event.mixing = Mixing::POSITION;
+        event.angle = angle;
+        event.distance = distance;
+        return event;
+    }
+
+    static PlaySoundEvent WithVolume(int channel, int volume) {
+        PlaySoundEvent event(channel);
+        event.mixing = Mixing::VOLUME;
+        event.volume = volume;
+        return event;
+    }
+};
@@ -24,8 +24,13 @@
 #include "InputTask.h"
 #include "GlobalTimer.h"
 
-#include "TankHandler.h"
-#include "LevelHandler.h"
+#include "simulation/BatchSimulator.h"
+#include "simulation/VectorEnv.h"
+#include "simulation/InputRecording.h"
+#include "simulation/StressScenario.h"
+#include "combat/BulletSystem.h"
+#include "memory/AllocationTracker.h"
+#include "profiling/GLCounters.h"
 
 void App::Run(int argc, char *argv[])
 {
@@ -42,33 +47,90 @@ void App::Run(int argc, char *argv[])
     Logger::Get().Write("But we are linking against SDL version %d.%d.%d.\n",
            linked.major, linked.minor, linked.patch);
 
+    // Per-frame allocation budget and call-site tracking (debug overlay)
+    AllocationTracker::ParseCommandLine(argc, argv);
+
+    // GL call counts per frame, view and renderer, written as JSON at exit
+    GLCounters::ParseCommandLine(argc, argv);
+
+    // Rendering backend (the context itself is created by VideoTask)
+    VideoTask::ParseCommandLine(argc, argv);
+
+    // Headless batch simulation: no window, GL context or audio
+    BatchSettings batchSettings;
+    if (BatchSimulator::ParseCommandLine(argc, argv, batchSettings))
+    {
+        BatchSimulator(batchSettings).Run();
+        return;
+    }
+
+    // Entity-count scaling sweep (headless, writes a CSV)
+    StressSettings stressSettings;
+    if (StressScenario::ParseCommandLine(argc, argv, stressSettings))
+    {
+        StressScenario(stressSettings).Run();
+        return;
+    }
+
+    // Bullet update throughput: per-bullet path vs batch kernel
+    int benchmarkBullets = 10000;
+    int benchmarkTicks = 600;
+    if (BulletSystem::ParseCommandLine(argc, argv, benchmarkBullets, benchmarkTicks))
+    {
+        BulletSystem::RunBenchmark(benchmarkBullets, benchmarkTicks);
+        return;
+    }
+
+    // Agent environment throughput benchmark (random actions, headless)
+    EnvSettings envSettings;
+    int envSteps = 1000;
+    if (VectorEnv::ParseCommandLine(argc, argv, envSettings, envSteps))
+    {
+        VectorEnv::RunBenchmark(envSettings, envSteps, 1);
+        return;
+    }
+
+    // Session recording / replay (headless replays skip window and audio)
+    ReplaySettings replaySettings;
+    InputReplay::ParseCommandLine(argc, argv, replaySettings);
+    if (replaySettings.IsReplaying() && replaySettings.headless)
+    {
+        InputReplay::RunHeadless(replaySettings.replayPath, replaySettings.verify);
+        return;
+    }
+
     videoTask = new VideoTask;
     graphicsTask = new GraphicsTask;
     soundTask = new SoundTask;
     gameTask = new GameTask;
+    gameTask->SetReplaySettings(replaySettings);
     globalTimer = new GlobalTimer;
     inputTask = new InputTask;
 
-    new TankHandler();
-    new LevelHandler();
-
     new TaskHandler();
 
+    videoTask->name = "video";
+    videoTask->presents = true;
     videoTask->priority = 100;
     TaskHandler::GetSingleton().AddTask(videoTask);
 
-    inputTask->priority = 90;
+    inputTask->name = "input";
+    inputTask->priority = 50;     // Sampled right before the game ticks, not after rendering
     TaskHandler::GetSingleton().AddTask(inputTask);
 
+    graphicsTask->name = "graphics";
     graphicsTask->priority = 80;
     TaskHandler::GetSingleton().AddTask(graphicsTask);
 
+    soundTask->name = "sound";
     soundTask->priority = 70;
     TaskHandler::GetSingleton().AddTask(soundTask);
 
+    gameTask->name = "game";
     gameTask->priority = 60;
     TaskHandler::GetSingleton().AddTask(gameTask);
 
+    globalTimer->name = "timer";
     globalTimer->priority = 10;
     TaskHandler::GetSingleton().AddTask(globalTimer);
 
@@ -80,9 +142,7 @@ void App::Run(int argc, char *argv[])
 
     Logger::Get().Write("Initialization complete. About to enter TaskHandler Execute Loop. \n");
     TaskHandler::GetSingleton().Execute();
-
-    delete TankHandler::GetSingletonPtr();
-    delete LevelHandler::GetSingletonPtr();
+    GLCounters::Get().WriteReport();
 
     delete TaskHandler::GetSingletonPtr();
 }
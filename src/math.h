@@ -204,3 +204,199 @@ float inline toDegrees(float val)
 {
     return val / (PI / 180);
 }
+
+// === Fast angle math ===
+// The game measures angles in degrees and converts them with DTR; the
+// functions below use the same factor, so sinDeg(a) tracks sin(a * DTR).
+// They avoid libm calls and data-dependent branches so loops over many
+// headings stay in registers (and vectorize in the batch variants).
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+const float TWO_PI = 6.2831853f;
+const float TURNS_PER_DEGREE = DTR / TWO_PI;
+const float DEGREES_PER_RADIAN = 57.295780f;
+
+// Taylor coefficients of sin on [-pi/2, pi/2] (error < 1e-7)
+const float SIN_C3 = -1.6666667e-1f;
+const float SIN_C5 = 8.3333333e-3f;
+const float SIN_C7 = -1.9841270e-4f;
+const float SIN_C9 = 2.7557319e-6f;
+const float SIN_C11 = -2.5052108e-8f;
+
+// Minimax coefficients of atan on [0, 1] (error < 2e-6 rad, about 1e-4 degrees)
+const float ATAN_C1 = 0.99997726f;
+const float ATAN_C3 = -0.33262347f;
+const float ATAN_C5 = 0.19354346f;
+const float ATAN_C7 = -0.11643287f;
+const float ATAN_C9 = 0.05265332f;
+const float ATAN_C11 = -0.01172120f;
+
+// Nearest whole number, ties to even (one instruction with SSE2)
+float inline roundNearest(float val)
+{
+#ifdef MATH_SSE2
+    return static_cast<float>(_mm_cvtss_si32(_mm_set_ss(val)));
+#else
+    return std::nearbyint(val);
+#endif
+}
+
+// sin(2 pi u) for u in [-0.5, 0.5] turns
+float inline sinTurns(float u)
+{
+    u = (u > 0.25f) ? 0.5f - u : u;
+    u = (u < -0.25f) ? -0.5f - u : u;
+    const float a = u * TWO_PI;
+    const float a2 = a * a;
+    return a * (1.0f + a2 * (SIN_C3 + a2 * (SIN_C5 + a2 * (SIN_C7 + a2 * (SIN_C9 + a2 * SIN_C11)))));
+}
+
+// Degrees -> turns wrapped to [-0.5, 0.5], and the matching cosine phase
+void inline degreesToTurns(float degrees, float& sinPhase, float& cosPhase)
+{
+    const float turns = degrees * TURNS_PER_DEGREE;
+    sinPhase = turns - roundNearest(turns);
+    cosPhase = sinPhase + 0.25f;
+    cosPhase = (cosPhase > 0.5f) ? cosPhase - 1.0f : cosPhase;
+}
+
+void inline sinCosDeg(float degrees, float& s, float& c)
+{
+    float sinPhase, cosPhase;
+    degreesToTurns(degrees, sinPhase, cosPhase);
+    s = sinTurns(sinPhase);
+    c = sinTurns(cosPhase);
+}
+
+float inline sinDeg(float degrees)
+{
+    const float turns = degrees * TURNS_PER_DEGREE;
+    return sinTurns(turns - roundNearest(turns));
+}
+
+float inline cosDeg(float degrees)
+{
+    float sinPhase, cosPhase;
+    degreesToTurns(degrees, sinPhase, cosPhase);
+    return sinTurns(cosPhase);
+}
+
+// Angle in [0, 360)
+float inline wrapDegrees(float degrees)
+{
+    const float wrapped = degrees - 360.0f * std::floor(degrees * (1.0f / 360.0f));
+    return (wrapped >= 360.0f) ? wrapped - 360.0f : wrapped;
+}
+
+// Angle in [-180, 180)
+float inline wrapDegreesSigned(float degrees)
+{
+    return degrees - 360.0f * roundNearest(degrees * (1.0f / 360.0f));
+}
+
+// atan2 in degrees, (-180, 180]; defined everywhere, atan2Deg(0, 0) == 0
+float inline atan2Deg(float y, float x)
+{
+    const float ax = std::fabs(x);
+    const float ay = std::fabs(y);
+    const float hi = (ax > ay) ? ax : ay;
+    const float lo = (ax > ay) ? ay : ax;
+    const float t = (hi > 0.0f) ? lo / hi : 0.0f;
+    const float t2 = t * t;
+    float r = t * (ATAN_C1 + t2 * (ATAN_C3 + t2 * (ATAN_C5 + t2 * (ATAN_C7 + t2 * (ATAN_C9 + t2 * ATAN_C11)))));
+    r *= DEGREES_PER_RADIAN;
+    r = (ay > ax) ? 90.0f - r : r;
+    r = (x < 0.0f) ? 180.0f - r : r;
+    return (y < 0.0f) ? -r : r;
+}
+
+// 1 / sqrt(val) to about 1e-6 relative error; val must be > 0
+float inline fastInvSqrt(float val)
+{
+#ifdef MATH_SSE2
+    const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(val)));
+    return estimate * (1.5f - 0.5f * val * estimate * estimate);
+#else
+    uint32_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    bits = 0x5f375a86u - (bits >> 1);
+    float estimate;
+    std::memcpy(&estimate, &bits, sizeof(estimate));
+    estimate *= 1.5f - 0.5f * val * estimate * estimate;
+    return estimate * (1.5f - 0.5f * val * estimate * estimate);
+#endif
+}
+
+// sqrt(val) through fastInvSqrt; 0 for val <= 0
+float inline fastSqrt(float val)
+{
+    return (val > 0.0f) ? val * fastInvSqrt(val) : 0.0f;
+}
+
+#ifdef MATH_SSE2
+inline __m128 selectPs(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+// Four lanes of sinTurns, identical arithmetic
+inline __m128 sinTurns4(__m128 u)
+{
+    u = selectPs(_mm_cmpgt_ps(u, _mm_set1_ps(0.25f)), _mm_sub_ps(_mm_set1_ps(0.5f), u), u);
+    u = selectPs(_mm_cmplt_ps(u, _mm_set1_ps(-0.25f)), _mm_sub_ps(_mm_set1_ps(-0.5f), u), u);
+
+    const __m128 a = _mm_mul_ps(u, _mm_set1_ps(TWO_PI));
+    const __m128 a2 = _mm_mul_ps(a, a);
+    __m128 p = _mm_add_ps(_mm_set1_ps(SIN_C9), _mm_mul_ps(a2, _mm_set1_ps(SIN_C11)));
+    p = _mm_add_ps(_mm_set1_ps(SIN_C7), _mm_mul_ps(a2, p));
+    p = _mm_add_ps(_mm_set1_ps(SIN_C5), _mm_mul_ps(a2, p));
+    p = _mm_add_ps(_mm_set1_ps(SIN_C3), _mm_mul_ps(a2, p));
+    p = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(a2, p));
+    return _mm_mul_ps(a, p);
+}
+
+// Four lanes of degreesToTurns, identical arithmetic
+inline void degreesToTurns4(__m128 degrees, __m128& sinPhase, __m128& cosPhase)
+{
+    const __m128 turns = _mm_mul_ps(degrees, _mm_set1_ps(TURNS_PER_DEGREE));
+    sinPhase = _mm_sub_ps(turns, _mm_cvtepi32_ps(_mm_cvtps_epi32(turns)));
+    cosPhase = _mm_add_ps(sinPhase, _mm_set1_ps(0.25f));
+    cosPhase = selectPs(_mm_cmpgt_ps(cosPhase, _mm_set1_ps(0.5f)), _mm_sub_ps(cosPhase, _mm_set1_ps(1.0f)), cosPhase);
+}
+#endif
+
+// s[i], c[i] = sinCosDeg(degrees[i]); results equal the scalar version
+void inline sinCosDegBatch(const float* degrees, float* s, float* c, size_t count)
+{
+    size_t i = 0;
+#ifdef MATH_SSE2
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 sinPhase, cosPhase;
+        degreesToTurns4(_mm_loadu_ps(degrees + i), sinPhase, cosPhase);
+        _mm_storeu_ps(s + i, sinTurns4(sinPhase));
+        _mm_storeu_ps(c + i, sinTurns4(cosPhase));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        sinCosDeg(degrees[i], s[i], c[i]);
+    }
+}
+
+// out[i] = atan2Deg(y[i], x[i]); branch-free, so the loop auto-vectorizes
+void inline atan2DegBatch(const float* y, const float* x, float* out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = atan2Deg(y[i], x[i]);
+    }
+}
@@ -0,0 +1,419 @@
+#include "AllocationTracker.h"
+#include "../Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#if defined(__GNUC__) && (defined(__unix__) || defined(__APPLE__))
+#define ALLOCATION_TRACKER_DLADDR 1
+#include <cxxabi.h>
+#include <dlfcn.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define ALLOCATION_CALL_SITE() _ReturnAddress()
+#elif defined(__GNUC__)
+#define ALLOCATION_CALL_SITE() __builtin_return_address(0)
+#else
+#define ALLOCATION_CALL_SITE() nullptr
+#endif
+
+namespace {
+    // Zero-initialized before any dynamic initialization, so the hook can
+    // count allocations made by other static constructors
+    AllocationTracker tracker;
+
+    std::mutex scopeMutex;
+
+    // Log the report on the first frame over budget, then every this many
+    const unsigned long REPORT_INTERVAL = 300;
+
+    bool Busier(const AllocationTracker::Entry& a, const AllocationTracker::Entry& b)
+    {
+        return a.counts.allocations != b.counts.allocations ? a.counts.allocations > b.counts.allocations
+                                                            : a.counts.bytes > b.counts.bytes;
+    }
+}
+
+thread_local size_t AllocationTracker::currentScope = 0;
+
+AllocationTracker& AllocationTracker::Get()
+{
+    return tracker;
+}
+
+bool AllocationTracker::IsAvailable()
+{
+#ifdef TANKGAME_TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationCounts AllocationTracker::Counter::Take()
+{
+    AllocationCounts counts;
+    counts.allocations = allocations.exchange(0, std::memory_order_relaxed);
+    counts.bytes = bytes.exchange(0, std::memory_order_relaxed);
+    counts.frees = frees.exchange(0, std::memory_order_relaxed);
+    return counts;
+}
+
+AllocationCounts AllocationTracker::Counter::Load() const
+{
+    AllocationCounts counts;
+    counts.allocations = allocations.load(std::memory_order_relaxed);
+    counts.bytes = bytes.load(std::memory_order_relaxed);
+    counts.frees = frees.load(std::memory_order_relaxed);
+    return counts;
+}
+
+void AllocationTracker::RecordAllocation(size_t size, const void* site)
+{
+    current.allocations.fetch_add(1, std::memory_order_relaxed);
+    current.bytes.fetch_add(size, std::memory_order_relaxed);
+    total.allocations.fetch_add(1, std::memory_order_relaxed);
+    total.bytes.fetch_add(size, std::memory_order_relaxed);
+
+    Counter& scope = scopeCurrent[currentScope];
+    scope.allocations.fetch_add(1, std::memory_order_relaxed);
+    scope.bytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (!trackCallSites.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    // Open addressing on the address; a full table folds into "other"
+    const uintptr_t key = reinterpret_cast<uintptr_t>(site);
+    size_t slot = static_cast<size_t>((key >> 2) * 0x9E3779B97F4A7C15ull >> 32) % MAX_CALL_SITES;
+    CallSite* entry = &otherCallSites;
+    for (size_t probe = 0; probe < 16; probe++, slot = (slot + 1) % MAX_CALL_SITES)
+    {
+        const void* expected = callSites[slot].address.load(std::memory_order_relaxed);
+        if (expected == site)
+        {
+            entry = &callSites[slot];
+            break;
+        }
+        if (expected == nullptr &&
+            (callSites[slot].address.compare_exchange_strong(expected, site, std::memory_order_relaxed) || expected == site))
+        {
+            entry = &callSites[slot];
+            break;
+        }
+    }
+    entry->counter.allocations.fetch_add(1, std::memory_order_relaxed);
+    entry->counter.bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+void AllocationTracker::RecordFree()
+{
+    current.frees.fetch_add(1, std::memory_order_relaxed);
+    total.frees.fetch_add(1, std::memory_order_relaxed);
+    scopeCurrent[currentScope].frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationCounts AllocationTracker::GetCurrent() const
+{
+    return current.Load();
+}
+
+AllocationCounts AllocationTracker::GetTotal() const
+{
+    return total.Load();
+}
+
+void AllocationTracker::EndFrame()
+{
+    lastFrame = current.Take();
+    for (size_t i = 0; i < MAX_SCOPES; i++)
+    {
+        scopeFrame[i] = scopeCurrent[i].Take();
+    }
+    for (size_t i = 0; i < MAX_CALL_SITES; i++)
+    {
+        callSiteFrameAddress[i] = callSites[i].address.load(std::memory_order_relaxed);
+        callSiteFrame[i] = callSites[i].counter.Take();
+    }
+    otherCallSitesFrame = otherCallSites.counter.Take();
+    frameIndex++;
+
+    if (frameBudget > 0 && lastFrame.allocations > frameBudget)
+    {
+        if (framesOverBudget % REPORT_INTERVAL == 0)
+        {
+            Logger::Get().Write("AllocationTracker: frame %lu made %llu allocations (budget %llu), %lu frames over budget so far\n",
+                                frameIndex, static_cast<unsigned long long>(lastFrame.allocations),
+                                static_cast<unsigned long long>(frameBudget), framesOverBudget + 1);
+            LogFrameReport();
+        }
+        framesOverBudget++;
+    }
+}
+
+size_t AllocationTracker::RegisterScope(const char* name)
+{
+    const size_t known = numScopes.load(std::memory_order_acquire);
+    for (size_t i = 1; i < known; i++)
+    {
+        const char* existing = scopeNames[i].load(std::memory_order_relaxed);
+        if (existing == name || std::strcmp(existing, name) == 0)
+        {
+            return i;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(scopeMutex);
+    size_t count = numScopes.load(std::memory_order_relaxed);
+    if (count == 0)
+    {
+        scopeNames[0].store("other", std::memory_order_relaxed);
+        count = 1;
+    }
+    for (size_t i = 1; i < count; i++)
+    {
+        if (std::strcmp(scopeNames[i].load(std::memory_order_relaxed), name) == 0)
+        {
+            return i;
+        }
+    }
+    if (count == MAX_SCOPES)
+    {
+        return 0;
+    }
+    scopeNames[count].store(name, std::memory_order_relaxed);
+    numScopes.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+std::vector<AllocationTracker::Entry> AllocationTracker::GetFrameScopes() const
+{
+    std::vector<Entry> entries;
+    const size_t count = std::max<size_t>(1, numScopes.load(std::memory_order_acquire));
+    for (size_t i = 0; i < count; i++)
+    {
+        if (scopeFrame[i].allocations > 0 || scopeFrame[i].frees > 0)
+        {
+            Entry entry;
+            entry.scope = (i == 0) ? "other" : scopeNames[i].load(std::memory_order_relaxed);
+            entry.counts = scopeFrame[i];
+            entries.push_back(entry);
+        }
+    }
+    std::sort(entries.begin(), entries.end(), Busier);
+    return entries;
+}
+
+std::vector<AllocationTracker::Entry> AllocationTracker::GetFrameCallSites(size_t maxEntries) const
+{
+    std::vector<Entry> entries;
+    for (size_t i = 0; i < MAX_CALL_SITES; i++)
+    {
+        if (callSiteFrame[i].allocations > 0)
+        {
+            Entry entry;
+            entry.site = callSiteFrameAddress[i];
+            entry.counts = callSiteFrame[i];
+            entries.push_back(entry);
+        }
+    }
+    if (otherCallSitesFrame.allocations > 0)
+    {
+        Entry entry;
+        entry.counts = otherCallSitesFrame;
+        entries.push_back(entry);
+    }
+    std::sort(entries.begin(), entries.end(), Busier);
+    if (entries.size() > maxEntries)
+    {
+        entries.resize(maxEntries);
+    }
+    return entries;
+}
+
+std::string AllocationTracker::DescribeCallSite(const void* site)
+{
+    char buffer[512];
+    if (!site)
+    {
+        return "other";
+    }
+
+#ifdef ALLOCATION_TRACKER_DLADDR
+    Dl_info info;
+    if (dladdr(site, &info) != 0)
+    {
+        if (info.dli_sname)
+        {
+            int status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            std::snprintf(buffer, sizeof(buffer), "%s+0x%lx", status == 0 && demangled ? demangled : info.dli_sname,
+                          static_cast<unsigned long>(static_cast<const char*>(site) - static_cast<const char*>(info.dli_saddr)));
+            std::free(demangled);
+            return buffer;
+        }
+        if (info.dli_fname)
+        {
+            // Unexported symbol: module offset, for addr2line
+            const char* slash = std::strrchr(info.dli_fname, '/');
+            std::snprintf(buffer, sizeof(buffer), "%s+0x%lx", slash ? slash + 1 : info.dli_fname,
+                          static_cast<unsigned long>(static_cast<const char*>(site) - static_cast<const char*>(info.dli_fbase)));
+            return buffer;
+        }
+    }
+#endif
+
+    std::snprintf(buffer, sizeof(buffer), "%p", site);
+    return buffer;
+}
+
+void AllocationTracker::LogFrameReport() const
+{
+    Logger& log = Logger::Get();
+    log.Write("AllocationTracker: frame %lu: %llu allocations, %llu bytes, %llu frees\n", frameIndex,
+              static_cast<unsigned long long>(lastFrame.allocations), static_cast<unsigned long long>(lastFrame.bytes),
+              static_cast<unsigned long long>(lastFrame.frees));
+    for (const Entry& entry : GetFrameScopes())
+    {
+        log.Write("  scope %-16s %8llu allocs %10llu bytes\n", entry.scope,
+                  static_cast<unsigned long long>(entry.counts.allocations), static_cast<unsigned long long>(entry.counts.bytes));
+    }
+    for (const Entry& entry : GetFrameCallSites(16))
+    {
+        log.Write("  site  %8llu allocs %10llu bytes  %s\n", static_cast<unsigned long long>(entry.counts.allocations),
+                  static_cast<unsigned long long>(entry.counts.bytes), DescribeCallSite(entry.site).c_str());
+    }
+}
+
+bool AllocationTracker::ParseCommandLine(int argc, char* argv[])
+{
+    bool any = false;
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--alloc-budget") == 0 && hasValue)
+        {
+            tracker.SetFrameBudget(std::strtoull(argv[++i], nullptr, 10));
+            any = true;
+        }
+        else if (std::strcmp(argv[i], "--alloc-sites") == 0)
+        {
+            tracker.SetCallSiteTracking(true);
+            any = true;
+        }
+    }
+    if (any && !IsAvailable())
+    {
+        Logger::Get().Write("AllocationTracker: built without TRACK_ALLOCATIONS, counters stay zero\n");
+    }
+    return any;
+}
+
+AllocationScope::AllocationScope(const char* name)
+    : previous(AllocationTracker::currentScope)
+{
+    AllocationTracker::currentScope = AllocationTracker::Get().RegisterScope(name);
+}
+
+AllocationScope::~AllocationScope()
+{
+    AllocationTracker::currentScope = previous;
+}
+
+#ifdef TANKGAME_TRACK_ALLOCATIONS
+
+// Replacement global allocation functions (C++14 set: plain, array,
+// nothrow and sized deletes). They must never allocate themselves.
+namespace {
+    void* TrackedAllocate(std::size_t size, const void* site)
+    {
+        void* memory = std::malloc(size ? size : 1);
+        if (memory)
+        {
+            tracker.RecordAllocation(size, site);
+        }
+        return memory;
+    }
+
+    void* TrackedAllocateOrThrow(std::size_t size, const void* site)
+    {
+        void* memory;
+        while ((memory = TrackedAllocate(size, site)) == nullptr)
+        {
+            std::new_handler handler = std::get_new_handler();
+            if (!handler)
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+        }
+        return memory;
+    }
+
+    void TrackedFree(void* memory)
+    {
+        if (memory)
+        {
+            tracker.RecordFree();
+            std::free(memory);
+        }
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return TrackedAllocateOrThrow(size, ALLOCATION_CALL_SITE());
+}
+
+void* operator new[](std::size_t size)
+{
+    return TrackedAllocateOrThrow(size, ALLOCATION_CALL_SITE());
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size, ALLOCATION_CALL_SITE());
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return TrackedAllocate(size, ALLOCATION_CALL_SITE());
+}
+
+void operator delete(void* memory) noexcept
+{
+    TrackedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    TrackedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    TrackedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    TrackedFree(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    TrackedFree(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    TrackedFree(memory);
+}
+
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Heap allocation counters.
+ */
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;                 // Requested bytes
+    uint64_t frees = 0;
+};
+
+/**
+ * Counts C++ heap allocations per frame, per subsystem scope and per call
+ * site.
+ *
+ * The counting hook is a replacement of the global operator new/delete,
+ * compiled in with TANKGAME_TRACK_ALLOCATIONS (CMake option
+ * TRACK_ALLOCATIONS; always on for the tests). Without it IsAvailable() is
+ * false and every counter stays zero. Allocations made directly with
+ * malloc (SDL, SDL_ttf, drivers) are not seen.
+ *
+ * Every allocation is charged to the innermost AllocationScope active on
+ * the allocating thread (scope 0, "other", outside any). Call sites are the
+ * return addresses of operator new, i.e. the function that allocated, and
+ * are only recorded while SetCallSiteTracking(true). EndFrame() closes a
+ * frame: its counts become the "last frame" figures read by the debug
+ * overlay, and a frame above the budget is counted and, now and then,
+ * logged with its busiest scopes and call sites.
+ *
+ * The hook itself never allocates; scopes and call sites live in fixed
+ * tables (overflowing call sites are folded into one "other" entry).
+ */
+class AllocationTracker {
+public:
+    static constexpr size_t MAX_SCOPES = 32;
+    static constexpr size_t MAX_CALL_SITES = 1024;
+
+    struct Entry {
+        const char* scope = nullptr;    // Scope name, or null for call sites
+        const void* site = nullptr;     // Call site address (null: other)
+        AllocationCounts counts;
+    };
+
+    static AllocationTracker& Get();
+
+    // True when the operator new hook is compiled in
+    static bool IsAvailable();
+
+    // Running counts of the current frame, and since startup
+    AllocationCounts GetCurrent() const;
+    AllocationCounts GetTotal() const;
+
+    // Close the current frame
+    void EndFrame();
+    const AllocationCounts& GetLastFrame() const { return lastFrame; }
+    unsigned long GetFrameIndex() const { return frameIndex; }
+
+    // Allocations per frame above which a frame counts as over budget (0 = none)
+    void SetFrameBudget(uint64_t maxAllocations) { frameBudget = maxAllocations; }
+    uint64_t GetFrameBudget() const { return frameBudget; }
+    unsigned long GetFramesOverBudget() const { return framesOverBudget; }
+
+    void SetCallSiteTracking(bool enable) { trackCallSites.store(enable, std::memory_order_relaxed); }
+    bool IsTrackingCallSites() const { return trackCallSites.load(std::memory_order_relaxed); }
+
+    // Last frame's scopes and call sites that allocated, busiest first
+    std::vector<Entry> GetFrameScopes() const;
+    std::vector<Entry> GetFrameCallSites(size_t maxEntries) const;
+
+    // Symbol (or module) and offset of a call site, for reports
+    static std::string DescribeCallSite(const void* site);
+
+    // Write the last frame's counts, scopes and top call sites to the log
+    void LogFrameReport() const;
+
+    // Index of a scope name (registered on first use; "other" when full)
+    size_t RegisterScope(const char* name);
+
+    // Parses [--alloc-budget <n>] [--alloc-sites]; returns true if any was given
+    static bool ParseCommandLine(int argc, char* argv[]);
+
+    // Called by the operator new/delete hook
+    void RecordAllocation(size_t bytes, const void* site);
+    void RecordFree();
+
+private:
+    friend class AllocationScope;
+
+    struct Counter {
+        std::atomic<uint64_t> allocations;
+        std::atomic<uint64_t> bytes;
+        std::atomic<uint64_t> frees;
+
+        AllocationCounts Take();
+        AllocationCounts Load() const;
+    };
+
+    struct CallSite {
+        std::atomic<const void*> address;
+        Counter counter;
+    };
+
+    Counter current;
+    Counter total;
+
+    std::atomic<size_t> numScopes;
+    std::atomic<const char*> scopeNames[MAX_SCOPES];
+    Counter scopeCurrent[MAX_SCOPES];
+    AllocationCounts scopeFrame[MAX_SCOPES];
+
+    std::atomic<bool> trackCallSites;
+    CallSite callSites[MAX_CALL_SITES];
+    CallSite otherCallSites;
+    AllocationCounts callSiteFrame[MAX_CALL_SITES];
+    const void* callSiteFrameAddress[MAX_CALL_SITES];
+    AllocationCounts otherCallSitesFrame;
+
+    AllocationCounts lastFrame;
+    unsigned long frameIndex;
+    uint64_t frameBudget;
+    unsigned long framesOverBudget;
+
+    static thread_local size_t currentScope;
+};
+
+/**
+ * Charges the allocations of its lifetime (on this thread) to a named
+ * scope. name must outlive the program (a string literal).
+ */
+class AllocationScope {
+public:
+    explicit AllocationScope(const char* name);
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+private:
+    size_t previous;
+};
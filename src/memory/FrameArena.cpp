@@ -0,0 +1,133 @@
+#include "FrameArena.h"
+#include "../Logger.h"
+#include <cstring>
+#include <utility>
+
+namespace {
+#ifdef NDEBUG
+    const bool POISON_BY_DEFAULT = false;
+#else
+    const bool POISON_BY_DEFAULT = true;
+#endif
+
+    inline uintptr_t AlignUp(uintptr_t address, size_t alignment)
+    {
+        return (address + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+    }
+
+    size_t GrownCapacity(size_t capacity, size_t needed)
+    {
+        while (capacity < needed)
+        {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+}
+
+constexpr size_t FrameArena::DEFAULT_CAPACITY;
+constexpr unsigned char FrameArena::POISON;
+
+FrameArena::FrameArena(size_t initialCapacity)
+    : block(new unsigned char[initialCapacity > 0 ? initialCapacity : 1])
+    , capacity(initialCapacity > 0 ? initialCapacity : 1)
+    , poisoning(POISON_BY_DEFAULT)
+{
+}
+
+FrameArena::~FrameArena()
+{
+    RunDestructors();
+    for (void* memory : overflowBlocks)
+    {
+        ::operator delete(memory);
+    }
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t alignment)
+{
+    const uintptr_t base = reinterpret_cast<uintptr_t>(block.get());
+    const uintptr_t start = AlignUp(base + used, alignment);
+    if (start + bytes <= base + capacity)
+    {
+        used = static_cast<size_t>(start + bytes - base);
+        return reinterpret_cast<void*>(start);
+    }
+    return AllocateOverflow(bytes, alignment);
+}
+
+void* FrameArena::AllocateOverflow(size_t bytes, size_t alignment)
+{
+    // Over-allocate so any alignment fits; freed at Reset()
+    void* memory = ::operator new(bytes + alignment);
+    overflowBlocks.push_back(memory);
+
+    stats.overflows++;
+    stats.overflowBytes += bytes;
+    frameOverflowBytes += bytes + alignment;
+    return reinterpret_cast<void*>(AlignUp(reinterpret_cast<uintptr_t>(memory), alignment));
+}
+
+void FrameArena::RunDestructors()
+{
+    for (Destructor* entry = destructors; entry; entry = entry->next)
+    {
+        entry->destroy(entry->object);
+    }
+    destructors = nullptr;
+}
+
+void FrameArena::Reset()
+{
+    RunDestructors();
+
+    const size_t frameBytes = used + frameOverflowBytes;
+    if (frameBytes > stats.peakBytes)
+    {
+        stats.peakBytes = frameBytes;
+    }
+
+    if (!overflowBlocks.empty())
+    {
+        for (void* memory : overflowBlocks)
+        {
+            ::operator delete(memory);
+        }
+        overflowBlocks.clear();
+        stats.framesOverflowed++;
+
+        // Make room for a frame like this one
+        capacity = GrownCapacity(capacity, frameBytes);
+        block.reset(new unsigned char[capacity]);
+        stats.grows++;
+        Logger::Get().Write("FrameArena: frame needed %zu bytes, block grown to %zu\n", frameBytes, capacity);
+        used = capacity;                // Poison all of the fresh block
+    }
+
+    if (poisoning && used > 0)
+    {
+        std::memset(block.get(), POISON, used);
+    }
+    used = 0;
+    frameOverflowBytes = 0;
+}
+
+DoubleFrameArena::DoubleFrameArena(size_t capacity)
+    : front(capacity)
+    , back(capacity)
+    , current(&front)
+    , previous(&back)
+{
+}
+
+void DoubleFrameArena::Flip()
+{
+    std::swap(current, previous);
+    current->Reset();
+}
+
+void DoubleFrameArena::SetPoisoning(bool enable)
+{
+    front.SetPoisoning(enable);
+    back.SetPoisoning(enable);
+}
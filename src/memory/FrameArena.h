@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Overflow and size figures of a frame arena.
+ */
+struct FrameArenaStats {
+    size_t peakBytes = 0;               // Most bytes one frame asked for
+    unsigned long overflows = 0;        // Allocations that did not fit the block
+    size_t overflowBytes = 0;
+    unsigned long framesOverflowed = 0;
+    unsigned long grows = 0;            // Block reallocations at Reset()
+};
+
+/**
+ * Bump allocator for data that lives for one frame.
+ *
+ * Allocate() hands out the next aligned bytes of one block; individual
+ * frees are no-ops and everything comes back at once in Reset(). A frame
+ * that does not fit spills into heap allocations, which are counted and
+ * released at Reset(), and the block is then grown to that frame's peak so
+ * the steady state stays in the block. Objects made with New() have their
+ * destructors run at Reset(), newest first.
+ *
+ * With poisoning on (the default in builds without NDEBUG) Reset() fills
+ * the used bytes with 0xDD, so data read after its frame has ended shows up
+ * as garbage rather than as last frame's values.
+ */
+class FrameArena {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024;
+    static constexpr unsigned char POISON = 0xDD;
+
+    explicit FrameArena(size_t capacity = DEFAULT_CAPACITY);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* Allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    void Deallocate(void*, size_t) {}
+
+    // Construct an object whose destructor runs at Reset()
+    template<typename T, typename... Args>
+    T* New(Args&&... args);
+
+    // End the frame: run destructors, free overflow, grow, poison, rewind
+    void Reset();
+
+    size_t GetCapacity() const { return capacity; }
+    // Bytes handed out this frame (block and overflow)
+    size_t GetUsed() const { return used + frameOverflowBytes; }
+    const FrameArenaStats& GetStats() const { return stats; }
+
+    void SetPoisoning(bool enable) { poisoning = enable; }
+    bool IsPoisoning() const { return poisoning; }
+
+private:
+    struct Destructor {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    template<typename T>
+    static void Destroy(void* object) { static_cast<T*>(object)->~T(); }
+
+    void* AllocateOverflow(size_t bytes, size_t alignment);
+    void RunDestructors();
+
+    std::unique_ptr<unsigned char[]> block;
+    size_t capacity;
+    size_t used = 0;
+    size_t frameOverflowBytes = 0;
+    std::vector<void*> overflowBlocks;
+    Destructor* destructors = nullptr;
+    FrameArenaStats stats;
+    bool poisoning;
+};
+
+template<typename T, typename... Args>
+T* FrameArena::New(Args&&... args)
+{
+    void* memory = Allocate(sizeof(T), alignof(T));
+    T* object = new (memory) T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value)
+    {
+        Destructor* entry = static_cast<Destructor*>(Allocate(sizeof(Destructor), alignof(Destructor)));
+        entry->destroy = &Destroy<T>;
+        entry->object = object;
+        entry->next = destructors;
+        destructors = entry;
+    }
+    return object;
+}
+
+/**
+ * Two frame arenas used in turn. Flip() resets the older one and makes it
+ * current, so what was built during the previous frame stays valid while
+ * the next one is built: render data extracted after a tick survives the
+ * following tick, and a consumer holding last frame's data across a
+ * rebuild never sees it poisoned.
+ */
+class DoubleFrameArena {
+public:
+    explicit DoubleFrameArena(size_t capacity = FrameArena::DEFAULT_CAPACITY);
+
+    DoubleFrameArena(const DoubleFrameArena&) = delete;
+    DoubleFrameArena& operator=(const DoubleFrameArena&) = delete;
+
+    FrameArena& Current() { return *current; }
+    const FrameArena& Current() const { return *current; }
+    FrameArena& Previous() { return *previous; }
+    const FrameArena& Previous() const { return *previous; }
+
+    void Flip();
+
+    void SetPoisoning(bool enable);
+
+private:
+    FrameArena front;
+    FrameArena back;
+    FrameArena* current;
+    FrameArena* previous;
+};
+
+/**
+ * Standard allocator over a FrameArena, for containers holding per-frame
+ * data. A default-constructed allocator (no arena) uses the heap, so the
+ * same container types work outside a frame. Allocators propagate on
+ * assignment and swap: assigning an arena-backed container adopts its
+ * storage instead of copying the elements to the heap.
+ */
+template<typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(FrameArena* owner) noexcept : arena(owner) {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.GetArena()) {}
+
+    T* allocate(size_t n)
+    {
+        if (arena)
+        {
+            return static_cast<T*>(arena->Allocate(n * sizeof(T), alignof(T)));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        if (arena)
+        {
+            arena->Deallocate(p, n * sizeof(T));
+        }
+        else
+        {
+            ::operator delete(p);
+        }
+    }
+
+    FrameArena* GetArena() const { return arena; }
+
+private:
+    FrameArena* arena = nullptr;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.GetArena() == b.GetArena(); }
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.GetArena() != b.GetArena(); }
+
+// Vector of per-frame data (on the heap when made without an arena)
+template<typename T>
+using FrameVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,120 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    FrameStats frameStats;
+
+    // Weight of the newest frame in a stage's smoothed time
+    const float STAGE_SMOOTHING = 1.0f / 60.0f;
+
+    float NearestRank(const float* sorted, size_t count, float percentile)
+    {
+        size_t rank = static_cast<size_t>(std::ceil(percentile * count));
+        return sorted[std::min(std::max<size_t>(rank, 1), count) - 1];
+    }
+}
+
+constexpr size_t FrameStats::WINDOW;
+constexpr size_t FrameStats::MAX_STAGES;
+
+FrameStats& FrameStats::Get()
+{
+    return frameStats;
+}
+
+void FrameStats::AddStageTime(const char* name, float ms)
+{
+    for (size_t i = 0; i < numStages; i++)
+    {
+        if (stages[i].name == name || std::strcmp(stages[i].name, name) == 0)
+        {
+            stageCurrent[i] += ms;
+            return;
+        }
+    }
+    if (numStages < MAX_STAGES)
+    {
+        stages[numStages].name = name;
+        stageCurrent[numStages] = ms;
+        numStages++;
+    }
+}
+
+void FrameStats::EndFrame(float frameMs)
+{
+    frameTimes[nextFrame] = frameMs;
+    nextFrame = (nextFrame + 1) % WINDOW;
+    numFrames = std::min(numFrames + 1, WINDOW);
+
+    for (size_t i = 0; i < numStages; i++)
+    {
+        Stage& stage = stages[i];
+        stage.lastMs = stageCurrent[i];
+        stage.averageMs += (stage.lastMs - stage.averageMs) * STAGE_SMOOTHING;
+        stageCurrent[i] = 0.0f;
+    }
+}
+
+FrameTimeSummary FrameStats::Summarize() const
+{
+    FrameTimeSummary summary;
+    summary.frames = numFrames;
+    if (numFrames == 0)
+    {
+        return summary;
+    }
+
+    std::array<float, WINDOW> sorted;
+    const size_t count = CopyHistory(sorted.data(), WINDOW);
+    std::sort(sorted.begin(), sorted.begin() + count);
+
+    float total = 0.0f;
+    for (size_t i = 0; i < count; i++)
+    {
+        total += sorted[i];
+    }
+    summary.p50Ms = NearestRank(sorted.data(), count, 0.50f);
+    summary.p95Ms = NearestRank(sorted.data(), count, 0.95f);
+    summary.p99Ms = NearestRank(sorted.data(), count, 0.99f);
+    summary.maxMs = sorted[count - 1];
+    summary.averageMs = total / count;
+    return summary;
+}
+
+void FrameStats::SetInputLatency(float ms)
+{
+    // The first sample seeds the average instead of climbing from zero
+    inputLatencyAverageMs = inputLatencyMs > 0.0f
+        ? inputLatencyAverageMs + (ms - inputLatencyAverageMs) * STAGE_SMOOTHING
+        : ms;
+    inputLatencyMs = ms;
+}
+
+size_t FrameStats::CopyHistory(float* out, size_t maxCount) const
+{
+    const size_t count = std::min(maxCount, numFrames);
+    size_t index = (nextFrame + WINDOW - count) % WINDOW;
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = frameTimes[index];
+        index = (index + 1) % WINDOW;
+    }
+    return count;
+}
+
+void FrameStats::Clear()
+{
+    nextFrame = 0;
+    numFrames = 0;
+    for (size_t i = 0; i < numStages; i++)
+    {
+        stages[i] = Stage();
+        stageCurrent[i] = 0.0f;
+    }
+    numStages = 0;
+    objectsDrawn = 0;
+    inputLatencyMs = 0.0f;
+    inputLatencyAverageMs = 0.0f;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * Frame-time percentiles over the window.
+ */
+struct FrameTimeSummary {
+    float p50Ms = 0.0f;
+    float p95Ms = 0.0f;
+    float p99Ms = 0.0f;
+    float maxMs = 0.0f;
+    float averageMs = 0.0f;
+    size_t frames = 0;
+};
+
+/**
+ * Rolling window of frame times and per-stage timings, read by the frame
+ * stats overlay (toggled with F3).
+ *
+ * TaskHandler reports each task's Update() as a stage and closes the frame
+ * after every pass over the tasks; the renderer reports how many objects it
+ * drew. Recording is a few stores per stage and frame; the percentiles are
+ * only computed (a sort of WINDOW floats) when somebody asks, i.e. while the
+ * overlay is visible.
+ */
+class FrameStats {
+public:
+    static constexpr size_t WINDOW = 240;       // Four seconds at 60 FPS
+    static constexpr size_t MAX_STAGES = 8;
+
+    struct Stage {
+        const char* name = nullptr;     // Must outlive the program (a literal)
+        float lastMs = 0.0f;            // Last frame's total
+        float averageMs = 0.0f;         // Smoothed over roughly the last second
+    };
+
+    static FrameStats& Get();
+
+    // Add time to a stage of the current frame (registered on first use;
+    // stages past MAX_STAGES are dropped)
+    void AddStageTime(const char* name, float ms);
+
+    // Close the frame that took frameMs
+    void EndFrame(float frameMs);
+
+    // Percentiles (nearest rank) over the frames in the window
+    FrameTimeSummary Summarize() const;
+
+    // Copy up to maxCount of the latest frame times, oldest first
+    size_t CopyHistory(float* out, size_t maxCount) const;
+
+    size_t GetStageCount() const { return numStages; }
+    const Stage& GetStage(size_t index) const { return stages[index]; }
+
+    // Objects the renderer submitted last frame (all views)
+    void SetObjectsDrawn(int count) { objectsDrawn = count; }
+    int GetObjectsDrawn() const { return objectsDrawn; }
+
+    // Input sampling to the swap returning, last frame and smoothed
+    void SetInputLatency(float ms);
+    float GetInputLatency() const { return inputLatencyMs; }
+    float GetAverageInputLatency() const { return inputLatencyAverageMs; }
+
+    void SetOverlayVisible(bool visible) { overlayVisible = visible; }
+    bool IsOverlayVisible() const { return overlayVisible; }
+    void ToggleOverlay() { overlayVisible = !overlayVisible; }
+
+    void Clear();
+
+private:
+    std::array<float, WINDOW> frameTimes{};
+    size_t nextFrame = 0;
+    size_t numFrames = 0;
+
+    Stage stages[MAX_STAGES];
+    float stageCurrent[MAX_STAGES] = {};
+    size_t numStages = 0;
+
+    int objectsDrawn = 0;
+    float inputLatencyMs = 0.0f;
+    float inputLatencyAverageMs = 0.0f;
+    bool overlayVisible = false;
+};
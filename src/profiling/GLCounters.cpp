@@ -0,0 +1,200 @@
+#include "GLCounters.h"
+#include "../Logger.h"
+#include <cstring>
+
+namespace {
+    GLCounters counters;
+
+    // Indexed by GLCall; also the JSON keys
+    const char* const CALL_NAMES[] = {
+        "drawCalls",
+        "beginEnd",
+        "listCalls",
+        "textureBinds",
+        "matrixPushes",
+        "stateChanges",
+    };
+
+    // Indexed by RenderSource
+    const char* const SOURCE_NAMES[] = {
+        "other",
+        "sky",
+        "terrain",
+        "tanks",
+        "bullets",
+        "effects",
+        "items",
+        "hud",
+        "menu",
+    };
+
+    void WriteAverages(std::FILE* file, const GLCallCounts& totals, unsigned long frames)
+    {
+        const double scale = 1.0 / (frames ? frames : 1);
+        std::fprintf(file, "{");
+        for (int i = 0; i < static_cast<int>(GLCall::COUNT); i++)
+        {
+            std::fprintf(file, "%s\"%s\": %.2f", i ? ", " : "", CALL_NAMES[i], totals.calls[i] * scale);
+        }
+        std::fprintf(file, ", \"total\": %.2f}", totals.Total() * scale);
+    }
+}
+
+constexpr int GLCounters::MAX_VIEWS;
+constexpr int GLCounters::NO_VIEW;
+
+int GLCallCounts::Total() const
+{
+    int total = 0;
+    for (int count : calls)
+    {
+        total += count;
+    }
+    return total;
+}
+
+GLCallCounts& GLCallCounts::operator+=(const GLCallCounts& other)
+{
+    for (int i = 0; i < static_cast<int>(GLCall::COUNT); i++)
+    {
+        calls[i] += other.calls[i];
+    }
+    return *this;
+}
+
+GLCounters& GLCounters::Get()
+{
+    return counters;
+}
+
+bool GLCounters::IsAvailable()
+{
+#ifdef TANKGAME_PROFILE_GL
+    return true;
+#else
+    return false;
+#endif
+}
+
+const char* GLCounters::GetCallName(GLCall call)
+{
+    return CALL_NAMES[static_cast<int>(call)];
+}
+
+const char* GLCounters::GetSourceName(RenderSource source)
+{
+    return SOURCE_NAMES[static_cast<int>(source)];
+}
+
+void GLCounters::SetView(int newView)
+{
+    view = (newView >= 0 && newView < MAX_VIEWS) ? newView : NO_VIEW;
+}
+
+void GLCounters::BeginFrame()
+{
+    for (GLCallCounts& counts : sourceCounts)
+    {
+        counts = GLCallCounts();
+    }
+    for (GLCallCounts& counts : viewCounts)
+    {
+        counts = GLCallCounts();
+    }
+    view = NO_VIEW;
+}
+
+void GLCounters::EndFrame()
+{
+    view = NO_VIEW;
+    if (reportPath.empty())
+    {
+        return;
+    }
+
+    for (int i = 0; i < static_cast<int>(RenderSource::COUNT); i++)
+    {
+        sourceTotals[i] += sourceCounts[i];
+    }
+    for (int i = 0; i < MAX_VIEWS; i++)
+    {
+        viewTotals[i] += viewCounts[i];
+    }
+    reportFrames++;
+}
+
+GLCallCounts GLCounters::GetFrame() const
+{
+    GLCallCounts frame = GLCallCounts();
+    for (const GLCallCounts& counts : sourceCounts)
+    {
+        frame += counts;
+    }
+    return frame;
+}
+
+bool GLCounters::ParseCommandLine(int argc, char* argv[])
+{
+    bool any = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--gl-stats") == 0 && i + 1 < argc)
+        {
+            counters.SetReportPath(argv[++i]);
+            any = true;
+        }
+    }
+    if (any && !IsAvailable())
+    {
+        Logger::Get().Write("GLCounters: built without PROFILE_GL, counters stay zero\n");
+    }
+    return any;
+}
+
+bool GLCounters::WriteReport() const
+{
+    if (reportPath.empty())
+    {
+        return false;
+    }
+
+    std::FILE* file = std::fopen(reportPath.c_str(), "w");
+    if (!file)
+    {
+        Logger::Get().Write("GLCounters: could not write %s\n", reportPath.c_str());
+        return false;
+    }
+    WriteJson(file);
+    std::fclose(file);
+    Logger::Get().Write("GLCounters: %lu frames written to %s\n", reportFrames, reportPath.c_str());
+    return true;
+}
+
+void GLCounters::WriteJson(std::FILE* file) const
+{
+    // Every figure is an average per frame
+    GLCallCounts frameTotals = GLCallCounts();
+    for (const GLCallCounts& totals : sourceTotals)
+    {
+        frameTotals += totals;
+    }
+
+    std::fprintf(file, "{\n  \"profiled\": %s,\n  \"frames\": %lu,\n  \"perFrame\": ",
+                 IsAvailable() ? "true" : "false", reportFrames);
+    WriteAverages(file, frameTotals, reportFrames);
+
+    std::fprintf(file, ",\n  \"views\": [");
+    for (int i = 0; i < MAX_VIEWS; i++)
+    {
+        std::fprintf(file, "%s\n    ", i ? "," : "");
+        WriteAverages(file, viewTotals[i], reportFrames);
+    }
+
+    std::fprintf(file, "\n  ],\n  \"renderers\": {");
+    for (int i = 0; i < static_cast<int>(RenderSource::COUNT); i++)
+    {
+        std::fprintf(file, "%s\n    \"%s\": ", i ? "," : "", SOURCE_NAMES[i]);
+        WriteAverages(file, sourceTotals[i], reportFrames);
+    }
+    std::fprintf(file, "\n  }\n}\n");
+}
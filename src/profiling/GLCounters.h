@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+/**
+ * Kinds of GL call that cost driver time.
+ */
+enum class GLCall : uint8_t {
+    DRAW,               // glDrawArrays / glDrawElements and friends
+    BEGIN_END,          // glBegin/glEnd pairs (counted at glBegin)
+    LIST_CALL,          // glCallList / glCallLists
+    TEXTURE_BIND,       // glBindTexture
+    MATRIX_PUSH,        // glPushMatrix
+    STATE_CHANGE,       // Capability toggles, blend, depth, face and shade state
+    COUNT
+};
+
+/**
+ * Who issued a call. Packets of the render queue are charged to the
+ * renderer that submitted them; setup the pipeline does itself is OTHER.
+ */
+enum class RenderSource : uint8_t {
+    OTHER,
+    SKY,
+    TERRAIN,
+    TANKS,
+    BULLETS,
+    EFFECTS,
+    ITEMS,
+    HUD,
+    MENU,
+    COUNT
+};
+
+/**
+ * GL calls of one frame, view or renderer.
+ */
+struct GLCallCounts {
+    int calls[static_cast<int>(GLCall::COUNT)];
+
+    int Get(GLCall call) const { return calls[static_cast<int>(call)]; }
+    int Total() const;
+    GLCallCounts& operator+=(const GLCallCounts& other);
+};
+
+/**
+ * Counts the GL calls of a frame per renderer and per view.
+ *
+ * The counting hooks are the wrappers of rendering/GLProfile.h, compiled
+ * in with TANKGAME_PROFILE_GL (CMake option PROFILE_GL; always on for the
+ * tests). Without it IsAvailable() is false and every count stays zero.
+ *
+ * A call is charged to the current source (set with GLCounterScope) and,
+ * while a view is set, to that view; the frame figures are the sum over
+ * the sources. Calls replayed from display lists happen in the driver and
+ * are not seen: a list call counts once whatever it draws.
+ *
+ * With --gl-stats <file> every frame is also added to running totals, and
+ * WriteReport() writes their per-frame averages as JSON at exit.
+ */
+class GLCounters {
+public:
+    static constexpr int MAX_VIEWS = 4;     // IRenderingPipeline::MAX_VIEWS
+    static constexpr int NO_VIEW = -1;
+
+    static GLCounters& Get();
+
+    // True when the wrappers are compiled in
+    static bool IsAvailable();
+
+    static const char* GetCallName(GLCall call);
+    static const char* GetSourceName(RenderSource source);
+
+    // Called by the wrappers
+    void Add(GLCall call)
+    {
+        sourceCounts[static_cast<int>(source)].calls[static_cast<int>(call)]++;
+        if (view != NO_VIEW)
+        {
+            viewCounts[view].calls[static_cast<int>(call)]++;
+        }
+    }
+
+    RenderSource GetSource() const { return source; }
+    void SetSource(RenderSource newSource) { source = newSource; }
+
+    // View the following calls belong to (NO_VIEW for window-wide work)
+    void SetView(int newView);
+    int GetView() const { return view; }
+
+    // Zero the current frame's counts
+    void BeginFrame();
+
+    // Close the frame: add it to the report totals when one was asked for
+    void EndFrame();
+
+    // Counts of the current (or just ended) frame
+    GLCallCounts GetFrame() const;
+    const GLCallCounts& GetView(int index) const { return viewCounts[index]; }
+    const GLCallCounts& GetSource(RenderSource from) const { return sourceCounts[static_cast<int>(from)]; }
+
+    // Parses [--gl-stats <file>]; returns true if it was given
+    static bool ParseCommandLine(int argc, char* argv[]);
+
+    void SetReportPath(const std::string& path) { reportPath = path; }
+    unsigned long GetReportFrames() const { return reportFrames; }
+
+    // Per-frame averages since startup as JSON; false without a report path
+    // or when the file cannot be written
+    bool WriteReport() const;
+    void WriteJson(std::FILE* file) const;
+
+private:
+    RenderSource source = RenderSource::OTHER;
+    int view = NO_VIEW;
+
+    GLCallCounts sourceCounts[static_cast<int>(RenderSource::COUNT)] = {};
+    GLCallCounts viewCounts[MAX_VIEWS] = {};
+
+    std::string reportPath;
+    unsigned long reportFrames = 0;
+    GLCallCounts sourceTotals[static_cast<int>(RenderSource::COUNT)] = {};
+    GLCallCounts viewTotals[MAX_VIEWS] = {};
+};
+
+/**
+ * Charges the calls made during its lifetime to a source.
+ */
+class GLCounterScope {
+public:
+    explicit GLCounterScope(RenderSource source)
+        : previous(GLCounters::Get().GetSource())
+    {
+        GLCounters::Get().SetSource(source);
+    }
+
+    ~GLCounterScope() { GLCounters::Get().SetSource(previous); }
+
+    GLCounterScope(const GLCounterScope&) = delete;
+    GLCounterScope& operator=(const GLCounterScope&) = delete;
+
+private:
+    RenderSource previous;
+};
+
+// Counting and scoping compile to nothing outside profiling builds
+#ifdef TANKGAME_PROFILE_GL
+#define GL_COUNT(call) GLCounters::Get().Add(GLCall::call)
+#define GL_COUNTER_SCOPE(source) GLCounterScope glCounterScope(source)
+#define GL_COUNTER_VIEW(index) GLCounters::Get().SetView(index)
+#else
+#define GL_COUNT(call) ((void)0)
+#define GL_COUNTER_SCOPE(source) ((void)0)
+#define GL_COUNTER_VIEW(index) ((void)0)
+#endif
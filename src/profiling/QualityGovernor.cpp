@@ -0,0 +1,104 @@
+#include "QualityGovernor.h"
+#include "../Logger.h"
+#include <algorithm>
+
+namespace {
+    // Full quality first; level 0's particle cap is ParticleSystem's default capacity
+    const QualityBudget LEVELS[QualityGovernor::LEVEL_COUNT] = {
+        { 4096, 1.0f,   0.0f, 1, 1 },
+        { 1024, 0.5f,  96.0f, 2, 2 },
+        {  512, 0.35f, 64.0f, 3, 3 },
+        {  256, 0.25f, 48.0f, 4, 4 },
+    };
+
+    QualityGovernor governor;
+}
+
+constexpr int QualityGovernor::LEVEL_COUNT;
+constexpr size_t QualityGovernor::EVALUATE_INTERVAL;
+constexpr float QualityGovernor::OVER_BUDGET;
+constexpr float QualityGovernor::UNDER_BUDGET;
+constexpr int QualityGovernor::RECOVER_EVALUATIONS;
+
+QualityGovernor& QualityGovernor::Get()
+{
+    return governor;
+}
+
+const QualityBudget& QualityGovernor::GetLevelBudget(int level)
+{
+    return LEVELS[std::min(std::max(level, 0), LEVEL_COUNT - 1)];
+}
+
+void QualityGovernor::SetTargetFrameMs(float targetFrameMs)
+{
+    targetMs = targetFrameMs;
+    Reset();
+}
+
+void QualityGovernor::Reset()
+{
+    frames = 0;
+    headroomEvaluations = 0;
+    level = 0;
+    ApplyLevel();
+}
+
+void QualityGovernor::SetLevel(int newLevel)
+{
+    level = std::min(std::max(newLevel, 0), LEVEL_COUNT - 1);
+    headroomEvaluations = 0;
+    ApplyLevel();
+}
+
+void QualityGovernor::ApplyLevel()
+{
+    budget = LEVELS[level];
+}
+
+bool QualityGovernor::AddFrame(float workMs)
+{
+    if (targetMs <= 0.0f)
+    {
+        return false;
+    }
+
+    window[frames++] = workMs;
+    if (frames < EVALUATE_INTERVAL)
+    {
+        return false;
+    }
+    frames = 0;
+
+    // 90th percentile: the occasional hitch is not worth shedding work for
+    const size_t rank = EVALUATE_INTERVAL * 9 / 10;
+    std::nth_element(window.begin(), window.begin() + rank, window.end());
+    const float p90Ms = window[rank];
+
+    const int previous = level;
+    if (p90Ms > targetMs * OVER_BUDGET)
+    {
+        headroomEvaluations = 0;
+        level = std::min(level + 1, LEVEL_COUNT - 1);
+    }
+    else if (p90Ms < targetMs * UNDER_BUDGET)
+    {
+        if (++headroomEvaluations >= RECOVER_EVALUATIONS)
+        {
+            headroomEvaluations = 0;
+            level = std::max(level - 1, 0);
+        }
+    }
+    else
+    {
+        headroomEvaluations = 0;
+    }
+
+    if (level == previous)
+    {
+        return false;
+    }
+    ApplyLevel();
+    Logger::Get().Write("QualityGovernor: level %d (p90 work %.1f ms, target %.1f ms)\n", level, p90Ms, targetMs);
+    return true;
+}
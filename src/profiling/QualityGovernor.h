@@ -0,0 +1,67 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * How much optional work the game does this frame. The renderers read the
+ * governor's current budget; the simulation reads the one its GameWorld
+ * was handed, so headless, recorded and replayed matches stay at level 0.
+ */
+struct QualityBudget {
+    size_t maxParticlesPerType;     // Live particles per FxType; further spawns are dropped
+    float particleSpawnScale;       // Multiplier on continuous emitter rates (smoke, jump trails)
+    float terrainDrawDistance;      // Terrain chunks further from the eye are skipped (0 = no limit)
+    int hudUpdateInterval;          // Frames the players' HUD data is held before re-extracting
+    int aiDecisionInterval;         // Ticks an enemy keeps its state and target between decisions
+};
+
+/**
+ * Steps the QualityBudget down when frames run over the target time and
+ * back up when there is headroom again.
+ *
+ * TaskHandler feeds it the work time of every frame: the tasks' time
+ * without the wait for the display, so a vsynced frame that finishes early
+ * still shows its headroom. Every EVALUATE_INTERVAL frames the 90th
+ * percentile is compared with the target. One window over budget drops a
+ * level; climbing back needs RECOVER_EVALUATIONS windows in a row well
+ * under it, so a level that only just fits does not flip back and forth.
+ *
+ * Without a target (the default, and every headless tool) it stays at
+ * full quality.
+ */
+class QualityGovernor {
+public:
+    static constexpr int LEVEL_COUNT = 4;               // 0 = full quality
+    static constexpr size_t EVALUATE_INTERVAL = 30;     // Frames per decision
+    static constexpr float OVER_BUDGET = 1.0f;          // Share of the target that steps down
+    static constexpr float UNDER_BUDGET = 0.7f;         // Share of the target that counts as headroom
+    static constexpr int RECOVER_EVALUATIONS = 4;       // Windows of headroom before stepping up
+
+    static QualityGovernor& Get();
+
+    // targetFrameMs <= 0 stops governing and restores full quality
+    void SetTargetFrameMs(float targetFrameMs);
+    float GetTargetFrameMs() const { return targetMs; }
+
+    // Record one frame's work time; true when the level changed
+    bool AddFrame(float workMs);
+
+    int GetLevel() const { return level; }
+    void SetLevel(int newLevel);
+    const QualityBudget& GetBudget() const { return budget; }
+    static const QualityBudget& GetLevelBudget(int level);
+
+    // Full quality, nothing recorded (the target is kept)
+    void Reset();
+
+private:
+    void ApplyLevel();
+
+    std::array<float, EVALUATE_INTERVAL> window{};
+    size_t frames = 0;
+    float targetMs = 0.0f;
+    int level = 0;
+    int headroomEvaluations = 0;
+    QualityBudget budget = GetLevelBudget(0);
+};
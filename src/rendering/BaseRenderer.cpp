@@ -1,6 +1,7 @@
 #include "BaseRenderer.h"
 #include "../Logger.h"
 #include <iostream>
+#include "GLProfile.h"
 
 bool BaseRenderer::Initialize()
 {
@@ -61,19 +62,19 @@ void BaseRenderer::CleanupRenderState()
 void BaseRenderer::Setup3DRenderState()
 {
     // Enable depth testing for proper 3D rendering
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().DepthFunc(GL_LESS);
     
     // Enable face culling for performance
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
-    glFrontFace(GL_CW);
+    GLStateCache::Get().Enable(GL_CULL_FACE);
+    GLStateCache::Get().CullFace(GL_BACK);
+    GLStateCache::Get().FrontFace(GL_CW);
     
     // Enable smooth shading
-    glShadeModel(GL_SMOOTH);
+    GLStateCache::Get().ShadeModel(GL_SMOOTH);
     
     // Disable blending by default (can be enabled per-object)
-    glDisable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_BLEND);
     
     CheckGLError("BaseRenderer::Setup3DRenderState");
 }
@@ -81,13 +82,13 @@ void BaseRenderer::Setup3DRenderState()
 void BaseRenderer::Setup2DRenderState()
 {
     // Disable depth testing for UI rendering
-    glDisable(GL_DEPTH_TEST);
+    GLStateCache::Get().Disable(GL_DEPTH_TEST);
     
     // Enable blending for transparency
     SetBlending(true);
     
     // Disable face culling for 2D quads
-    glDisable(GL_CULL_FACE);
+    GLStateCache::Get().Disable(GL_CULL_FACE);
     
     CheckGLError("BaseRenderer::Setup2DRenderState");
 }
@@ -95,10 +96,10 @@ void BaseRenderer::Setup2DRenderState()
 void BaseRenderer::SetLighting(bool enable)
 {
     if (enable) {
-        glEnable(GL_LIGHTING);
-        glEnable(GL_NORMALIZE); // Normalize normals after scaling
+        GLStateCache::Get().Enable(GL_LIGHTING);
+        GLStateCache::Get().Enable(GL_NORMALIZE); // Normalize normals after scaling
     } else {
-        glDisable(GL_LIGHTING);
+        GLStateCache::Get().Disable(GL_LIGHTING);
     }
     
     CheckGLError("BaseRenderer::SetLighting");
@@ -107,10 +108,10 @@ void BaseRenderer::SetLighting(bool enable)
 void BaseRenderer::SetBlending(bool enable)
 {
     if (enable) {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::Get().Enable(GL_BLEND);
+        GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     } else {
-        glDisable(GL_BLEND);
+        GLStateCache::Get().Disable(GL_BLEND);
     }
     
     CheckGLError("BaseRenderer::SetBlending");
@@ -130,15 +131,10 @@ void BaseRenderer::PopMatrix()
 
 void BaseRenderer::StoreRenderState()
 {
-    // Store current OpenGL state
-    previousState.depthTestEnabled = glIsEnabled(GL_DEPTH_TEST);
-    previousState.lightingEnabled = glIsEnabled(GL_LIGHTING);
-    previousState.blendEnabled = glIsEnabled(GL_BLEND);
-    previousState.cullFaceEnabled = glIsEnabled(GL_CULL_FACE);
-    glGetIntegerv(GL_MATRIX_MODE, &previousState.matrixMode);
+    // Save the shadowed state; nothing is read back from GL
+    GLStateCache::Get().PushState();
     
     stateStored = true;
-    CheckGLError("BaseRenderer::StoreRenderState");
 }
 
 void BaseRenderer::RestoreRenderState()
@@ -147,32 +143,9 @@ void BaseRenderer::RestoreRenderState()
         return;
     }
     
-    // Restore previous OpenGL state
-    if (previousState.depthTestEnabled) {
-        glEnable(GL_DEPTH_TEST);
-    } else {
-        glDisable(GL_DEPTH_TEST);
-    }
-    
-    if (previousState.lightingEnabled) {
-        glEnable(GL_LIGHTING);
-    } else {
-        glDisable(GL_LIGHTING);
-    }
-    
-    if (previousState.blendEnabled) {
-        glEnable(GL_BLEND);
-    } else {
-        glDisable(GL_BLEND);
-    }
-    
-    if (previousState.cullFaceEnabled) {
-        glEnable(GL_CULL_FACE);
-    } else {
-        glDisable(GL_CULL_FACE);
-    }
-    
-    glMatrixMode(previousState.matrixMode);
+    // Re-issues only the states that changed since StoreRenderState
+    GLStateCache::Get().PopState();
+    glMatrixMode(GL_MODELVIEW);
     
     stateStored = false;
     CheckGLError("BaseRenderer::RestoreRenderState");
@@ -2,15 +2,7 @@
 #define BASERENDERER_H
 
 #include "IRenderer.h"
-
-#ifdef _WIN32
-#include <windows.h>
-#include <GL/gl.h>
-#elif __APPLE__
-#include <OpenGL/gl.h>
-#else
-#include <GL/gl.h>
-#endif
+#include "GLStateCache.h"
 
 /**
  * Base implementation class for common renderer functionality
@@ -19,7 +11,7 @@
  * renderers will need, reducing code duplication across renderer classes.
  * 
  * Features:
- * - Common OpenGL state management
+ * - Common OpenGL state management through GLStateCache
  * - Initialization state tracking
  * - Helper methods for common operations
  * - Default render state setup/cleanup
@@ -96,24 +88,15 @@ protected:
     void PopMatrix();
     
 private:
-    // Store previous OpenGL state for restoration
-    struct RenderState {
-        GLboolean depthTestEnabled;
-        GLboolean lightingEnabled;
-        GLboolean blendEnabled;
-        GLboolean cullFaceEnabled;
-        GLint matrixMode;
-    } previousState;
-    
     bool stateStored = false;
     
     /**
-     * Store current OpenGL state for later restoration
+     * Store current OpenGL state for later restoration (GLStateCache::PushState)
      */
     void StoreRenderState();
     
     /**
-     * Restore previously stored OpenGL state
+     * Restore previously stored OpenGL state (GLStateCache::PopState)
      */
     void RestoreRenderState();
 };
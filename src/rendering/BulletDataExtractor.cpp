@@ -2,17 +2,15 @@
 #include "../Bullet.h"
 #include <cmath>
 
-std::vector<BulletRenderData> BulletDataExtractor::ExtractBulletRenderData(const std::vector<Bullet>& bullets) {
-    std::vector<BulletRenderData> renderData;
-    renderData.reserve(bullets.size());
+void BulletDataExtractor::ExtractBulletRenderData(const std::vector<std::unique_ptr<Bullet>>& bullets,
+                                                  FrameVector<BulletRenderData>& renderData) {
+    renderData.reserve(renderData.size() + bullets.size());
     
-    for (const Bullet& bullet : bullets) {
-        if (bullet.IsAlive()) {
-            renderData.push_back(ExtractSingleBulletData(bullet));
+    for (const auto& bullet : bullets) {
+        if (bullet && bullet->IsAlive()) {
+            renderData.push_back(ExtractSingleBulletData(*bullet));
         }
     }
-    
-    return renderData;
 }
 
 BulletRenderData BulletDataExtractor::ExtractSingleBulletData(const Bullet& bullet) {
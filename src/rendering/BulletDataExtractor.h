@@ -1,6 +1,7 @@
 #ifndef BULLETDATAEXTRACTOR_H
 #define BULLETDATAEXTRACTOR_H
 
+#include <memory>
 #include <vector>
 #include "RenderData.h"
 
@@ -14,11 +15,12 @@ class Bullet;
 class BulletDataExtractor {
 public:
     /**
-     * Extract rendering data from a vector of Bullet objects
-     * @param bullets Vector of bullet objects to extract data from
-     * @return Vector of BulletRenderData for rendering
+     * Extract rendering data from the live bullets of an entity list
+     * @param bullets Bullet entities to extract data from (read in place)
+     * @param renderData Vector the BulletRenderData is appended to
      */
-    static std::vector<BulletRenderData> ExtractBulletRenderData(const std::vector<Bullet>& bullets);
+    static void ExtractBulletRenderData(const std::vector<std::unique_ptr<Bullet>>& bullets,
+                                        FrameVector<BulletRenderData>& renderData);
     
     /**
      * Extract rendering data from a single Bullet object
@@ -11,6 +11,7 @@
 #include "RenderData.h"
 #include "../App.h"
 #include "../Logger.h"
+#include "GLProfile.h"
 
 BulletRenderer::BulletRenderer() : 
     BaseRenderer(),
@@ -36,7 +37,7 @@ void BulletRenderer::Cleanup() {
     Logger::Get().Write("BulletRenderer cleaned up\n");
 }
 
-void BulletRenderer::RenderBullets(const std::vector<BulletRenderData>& bullets) {
+void BulletRenderer::RenderBullets(const FrameVector<BulletRenderData>& bullets) {
     if (!IsReady()) {
         Logger::Get().Write("ERROR: BulletRenderer not initialized\n");
         return;
@@ -71,27 +72,65 @@ void BulletRenderer::RenderBullets(const std::vector<BulletRenderData>& bullets)
     CleanupRenderState();
 }
 
+namespace {
+    // Geometry pieces: y offset, z offset, x rotation, z scale
+    struct BulletPiece {
+        float yOffset;
+        float zOffset;
+        float rotationX;
+        float scaleZ;
+    };
+
+    // Blue bullets: main body and two angled parts
+    const BulletPiece BLUE_PIECES[] = {
+        { -0.07f,  0.0f,    0.0f, 0.15f },
+        {  0.03f, -0.06f, -60.0f, 0.2f },
+        {  0.03f,  0.06f,  60.0f, 0.2f },
+    };
+    const BulletPiece STANDARD_PIECE = { -0.05f, 0.0f, 0.0f, 0.2f };
+
+    // Holds the pieces and their glow
+    const float BOUNDING_RADIUS = 1.0f;
+
+    // Packet items: bullet index, piece and outline/glow pass
+    const uint32_t PIECE_BITS = 2;
+    const uint32_t PASS_BITS = 1;
+
+    const BulletPiece* GetPieces(const BulletRenderData& bullet, int& count) {
+        if (bullet.type1 == TankType::TYPE_BLUE) {
+            count = 3;
+            return BLUE_PIECES;
+        }
+        count = 1;
+        return &STANDARD_PIECE;
+    }
+}
+
 void BulletRenderer::RenderBlueBullet(const BulletRenderData& bullet) {
-    // Blue bullets render 3 geometric pieces: main body and two angled parts
-    
-    // Main body (center)
-    RenderBulletGeometry(bullet, -0.07f, 0.0f, 0.0f, 0.15f);
-    
-    // First angled part
-    RenderBulletGeometry(bullet, 0.03f, -0.06f, -60.0f, 0.2f);
-    
-    // Second angled part  
-    RenderBulletGeometry(bullet, 0.03f, 0.06f, 60.0f, 0.2f);
+    for (const BulletPiece& piece : BLUE_PIECES) {
+        RenderBulletGeometry(bullet, piece.yOffset, piece.zOffset, piece.rotationX, piece.scaleZ);
+    }
 }
 
 void BulletRenderer::RenderStandardBullet(const BulletRenderData& bullet) {
     // Standard bullets render as a single geometric piece
-    RenderBulletGeometry(bullet, -0.05f, 0.0f, 0.0f, 0.2f);
+    const BulletPiece& piece = STANDARD_PIECE;
+    RenderBulletGeometry(bullet, piece.yOffset, piece.zOffset, piece.rotationX, piece.scaleZ);
 }
 
 void BulletRenderer::RenderBulletGeometry(const BulletRenderData& bullet, float yOffset, float zOffset, float rotationX, float scaleZ) {
     glPushMatrix();
-    
+    ApplyPieceTransform(bullet, yOffset, zOffset, rotationX, scaleZ);
+    DrawOutline(bullet);
+
+    SetupBlendMode();
+    DrawGlow(bullet);
+    RestoreBlendMode();
+
+    glPopMatrix();
+}
+
+void BulletRenderer::ApplyPieceTransform(const BulletRenderData& bullet, float yOffset, float zOffset, float rotationX, float scaleZ) {
     // Position the bullet
     glTranslatef(bullet.position.x, bullet.position.y + yOffset, bullet.position.z);
     
@@ -110,18 +149,18 @@ void BulletRenderer::RenderBulletGeometry(const BulletRenderData& bullet, float
         glRotatef(rotationX, 1, 0, 0);
     }
     
-    // Set primary color and render outline
-    glColor3f(bullet.primaryColor.r, bullet.primaryColor.g, bullet.primaryColor.b);
     glScalef(1, 1, scaleZ);
-    
-    // Render the bullet outline using the square display list
+}
+
+void BulletRenderer::DrawOutline(const BulletRenderData& bullet) {
+    // Render the bullet outline with the primary color using the square display list
+    glColor3f(bullet.primaryColor.r, bullet.primaryColor.g, bullet.primaryColor.b);
     if (App::GetSingleton().graphicsTask) {
         App::GetSingleton().graphicsTask->squarelist2.Call(0);
     }
-    
-    // Render the glowing effect with secondary color
-    SetupBlendMode();
-    
+}
+
+void BulletRenderer::DrawGlow(const BulletRenderData& bullet) {
     // Calculate alpha based on power (matching original logic)
     float alpha = 0.1f;
     if (bullet.type1 == TankType::TYPE_BLUE) {
@@ -130,21 +169,51 @@ void BulletRenderer::RenderBulletGeometry(const BulletRenderData& bullet, float
         alpha += bullet.power / 1000.0f;
     }
     
+    // Render the glowing inner part with the secondary color
     glColor4f(bullet.secondaryColor.r, bullet.secondaryColor.g, bullet.secondaryColor.b, alpha);
-    
-    // Render the glowing inner part
     if (App::GetSingleton().graphicsTask) {
         App::GetSingleton().graphicsTask->squarelist.Call(0);
     }
-    
-    RestoreBlendMode();
-    
+}
+
+void BulletRenderer::Prepare(const FrameVector<BulletRenderData>& bullets, RenderList& list) {
+    submittedBullets = &bullets;
+    for (size_t i = 0; i < bullets.size(); i++) {
+        const BulletRenderData& bullet = bullets[i];
+        const uint32_t material = static_cast<uint32_t>(bullet.type1);
+        list.BeginObject(bullet.position, BOUNDING_RADIUS);
+
+        int pieceCount = 0;
+        GetPieces(bullet, pieceCount);
+        for (int piece = 0; piece < pieceCount; piece++) {
+            const uint32_t item = ((static_cast<uint32_t>(i) << PIECE_BITS | piece) << PASS_BITS);
+            list.Add(RenderLayer::OPAQUE, DrawState::LIT, 0, material, this, item);
+            list.Add(RenderLayer::TRANSPARENT, DrawState::ADDITIVE_CULLED, 0, material, this, item | 1);
+        }
+    }
+}
+
+void BulletRenderer::DrawPacket(uint32_t item) {
+    const bool glow = (item & 1) != 0;
+    const int piece = (item >> PASS_BITS) & ((1 << PIECE_BITS) - 1);
+    const BulletRenderData& bullet = (*submittedBullets)[item >> (PASS_BITS + PIECE_BITS)];
+
+    int pieceCount = 0;
+    const BulletPiece& geometry = GetPieces(bullet, pieceCount)[piece];
+
+    glPushMatrix();
+    ApplyPieceTransform(bullet, geometry.yOffset, geometry.zOffset, geometry.rotationX, geometry.scaleZ);
+    if (glow) {
+        DrawGlow(bullet);
+    } else {
+        DrawOutline(bullet);
+    }
     glPopMatrix();
 }
 
 void BulletRenderer::SetupBulletRendering() {
     // Disable textures for bullet rendering
-    glDisable(GL_TEXTURE_2D);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
     texturesEnabled = false;
 }
 
@@ -155,19 +224,19 @@ void BulletRenderer::CleanupBulletRendering() {
 
 void BulletRenderer::SetupBlendMode() {
     if (!blendEnabled) {
-        glEnable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        glDepthMask(GL_FALSE);
+        GLStateCache::Get().Enable(GL_BLEND);
+        GLStateCache::Get().Enable(GL_DEPTH_TEST);
+        GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
+        GLStateCache::Get().DepthMask(GL_FALSE);
         blendEnabled = true;
     }
 }
 
 void BulletRenderer::RestoreBlendMode() {
     if (blendEnabled) {
-        glDisable(GL_BLEND);
-        glDepthMask(GL_TRUE);
-        glEnable(GL_CULL_FACE);
+        GLStateCache::Get().Disable(GL_BLEND);
+        GLStateCache::Get().DepthMask(GL_TRUE);
+        GLStateCache::Get().Enable(GL_CULL_FACE);
         blendEnabled = false;
     }
 }
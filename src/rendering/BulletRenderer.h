@@ -2,6 +2,9 @@
 #define NEWBULLETRENDERER_H
 
 #include "BaseRenderer.h"
+#include "RenderQueue.h"
+#include "RenderList.h"
+#include "../memory/FrameArena.h"
 #include <vector>
 
 // Forward declaration
@@ -16,7 +19,7 @@ struct BulletRenderData;
  * 
  * Named "BulletRenderer" to avoid conflicts during migration.
  */
-class BulletRenderer : public BaseRenderer {
+class BulletRenderer : public BaseRenderer, public IQueuedRenderer {
 public:
     BulletRenderer();
     virtual ~BulletRenderer() = default;
@@ -26,7 +29,14 @@ public:
     virtual void Cleanup() override;
     
     // Bullet-specific rendering method
-    void RenderBullets(const std::vector<BulletRenderData>& bullets);
+    void RenderBullets(const FrameVector<BulletRenderData>& bullets);
+
+    // Add an opaque outline and an additive glow packet per bullet piece to
+    // the frame's render list. The bullets must stay alive until the last
+    // view has executed.
+    void Prepare(const FrameVector<BulletRenderData>& bullets, RenderList& list);
+    void DrawPacket(uint32_t item) override;
+    RenderSource GetRenderSource() const override { return RenderSource::BULLETS; }
 
 private:
     // Main rendering functions for different bullet types
@@ -37,12 +47,17 @@ private:
     void SetupBulletRendering();
     void CleanupBulletRendering();
     void RenderBulletGeometry(const BulletRenderData& bullet, float yOffset, float zOffset, float rotationX, float scaleZ);
+    void ApplyPieceTransform(const BulletRenderData& bullet, float yOffset, float zOffset, float rotationX, float scaleZ);
+    void DrawOutline(const BulletRenderData& bullet);
+    void DrawGlow(const BulletRenderData& bullet);
     void SetupBlendMode();
     void RestoreBlendMode();
     
     // Cached state to avoid redundant OpenGL calls
     bool blendEnabled;
     bool texturesEnabled;
+
+    const FrameVector<BulletRenderData>* submittedBullets = nullptr;
 };
 
 #endif // NEWBULLETRENDERER_H
@@ -90,23 +90,25 @@ void CameraManager::UpdateOverheadCamera(int playerId, const Tank& tank) {
 
 void CameraManager::CalculateCameraPosition(const Tank& tank, float xzDistance, float yDistance,
                                            float& camX, float& camY, float& camZ) const {
-    // Calculate combined rotation (body + turret)
-    float totalRotation = (tank.ry + tank.rty) * DTR;
+    // Combined rotation (body + turret)
+    float sinRotation, cosRotation;
+    sinCosDeg(tank.ry + tank.rty, sinRotation, cosRotation);
     
     // Position camera behind the tank
-    camX = tank.x - xzDistance * std::cos(totalRotation);
+    camX = tank.x - xzDistance * cosRotation;
     camY = tank.y + yDistance;
-    camZ = tank.z - xzDistance * std::sin(totalRotation);
+    camZ = tank.z - xzDistance * sinRotation;
 }
 
 void CameraManager::CalculateFocusPosition(const Tank& tank, float& focusX, float& focusY, float& focusZ) const {
-    // Calculate combined rotation (body + turret)
-    float totalRotation = (tank.ry + tank.rty) * DTR;
+    // Combined rotation (body + turret)
+    float sinRotation, cosRotation;
+    sinCosDeg(tank.ry + tank.rty, sinRotation, cosRotation);
     
     // Focus point in front of the tank
-    focusX = tank.x + std::cos(totalRotation);
+    focusX = tank.x + cosRotation;
     focusY = tank.y + FOCUS_HEIGHT_OFFSET;
-    focusZ = tank.z + std::sin(totalRotation);
+    focusZ = tank.z + sinRotation;
 }
 
 Camera& CameraManager::GetCamera(int playerId) {
@@ -0,0 +1,54 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+DynamicResolution::DynamicResolution(float targetFrameMs, float minScale)
+    : targetMs(0.0f), minScale(1.0f), scale(1.0f), accumulatedMs(0.0f), frames(0)
+{
+    Configure(targetFrameMs, minScale);
+}
+
+void DynamicResolution::Configure(float targetFrameMs, float minimumScale) {
+    targetMs = targetFrameMs;
+    minScale = std::min(std::max(minimumScale, 0.1f), 1.0f);
+    Reset();
+}
+
+void DynamicResolution::Reset() {
+    scale = 1.0f;
+    accumulatedMs = 0.0f;
+    frames = 0;
+}
+
+bool DynamicResolution::AddFrame(float frameMs) {
+    if (!IsEnabled()) {
+        return false;
+    }
+
+    accumulatedMs += frameMs;
+    if (++frames < ADJUST_INTERVAL) {
+        return false;
+    }
+
+    const float averageMs = accumulatedMs / frames;
+    accumulatedMs = 0.0f;
+    frames = 0;
+
+    float next = scale;
+    if (averageMs > targetMs) {
+        // Cost follows the pixel count, so the side shrinks with the root
+        next = scale * std::sqrt(targetMs / averageMs);
+    } else if (averageMs < targetMs * HEADROOM) {
+        next = scale + SCALE_STEP;
+    }
+    next = std::min(std::max(next, minScale), 1.0f);
+
+    const bool changed = std::fabs(next - scale) > 0.001f;
+    scale = next;
+    return changed;
+}
+
+int DynamicResolution::Scale(int pixels) const {
+    return std::max(1, static_cast<int>(std::lround(pixels * scale)));
+}
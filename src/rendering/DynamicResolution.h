@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * Picks the scale the 3D scene is rendered at from how long it took.
+ *
+ * Frame times are averaged over ADJUST_INTERVAL frames before the scale
+ * moves, so a single spike does not make the picture pump. Over budget the
+ * scale drops at once to what should fit (pixel cost grows with the square
+ * of the scale); comfortably under budget it climbs back in small steps.
+ * The band in between keeps it from oscillating around the target.
+ *
+ * Pure arithmetic so it can be tested without a context; the pipeline
+ * feeds it and applies the scale to the scene's viewports.
+ */
+class DynamicResolution {
+public:
+    static constexpr int ADJUST_INTERVAL = 8;      // Frames per decision
+    static constexpr float SCALE_STEP = 0.05f;     // Upward step per decision
+    static constexpr float HEADROOM = 0.8f;        // Climb only below this share of the budget
+
+    // targetFrameMs <= 0 disables scaling (the scale stays 1)
+    DynamicResolution(float targetFrameMs = 0.0f, float minScale = 0.5f);
+
+    void Configure(float targetFrameMs, float minScale);
+
+    // Record one frame; true when the scale changed
+    bool AddFrame(float frameMs);
+
+    float GetScale() const { return scale; }
+    bool IsEnabled() const { return targetMs > 0.0f; }
+
+    // A window dimension at the current scale, never below one pixel
+    int Scale(int pixels) const;
+
+    void Reset();
+
+private:
+    float targetMs;
+    float minScale;
+    float scale;
+
+    float accumulatedMs;
+    int frames;
+};
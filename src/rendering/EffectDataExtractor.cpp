@@ -1,23 +1,22 @@
 #include "EffectDataExtractor.h"
+#include "../effects/ParticleSystem.h"
 
-std::vector<EffectRenderData> EffectDataExtractor::ExtractEffectRenderData(const std::vector<FX>& effects) {
-    std::vector<EffectRenderData> renderData;
-    renderData.reserve(effects.size());
+void EffectDataExtractor::ExtractEffectRenderData(const ParticleSystem& particles, FrameVector<EffectRenderData>& renderData) {
+    renderData.reserve(renderData.size() + particles.GetCount());
     
-    for (const FX& effect : effects) {
-        if (effect.alive) {
-            renderData.push_back(ExtractSingleEffectData(effect));
+    for (int type = 0; type < static_cast<int>(FxType::FX_TYPE_COUNT); type++) {
+        const ParticlePool& pool = particles.GetPool(static_cast<FxType>(type));
+        for (size_t i = 0; i < pool.GetCount(); i++) {
+            renderData.push_back(ExtractSingleEffectData(pool.GetType(), pool.Get(i)));
         }
     }
-    
-    return renderData;
 }
 
-EffectRenderData EffectDataExtractor::ExtractSingleEffectData(const FX& effect) {
+EffectRenderData EffectDataExtractor::ExtractSingleEffectData(FxType type, const ParticleView& effect) {
     EffectRenderData data;
     
     // Basic properties
-    data.type = effect.type;
+    data.type = type;
     
     // Position
     data.position.x = effect.x;
@@ -30,9 +29,9 @@ EffectRenderData EffectDataExtractor::ExtractSingleEffectData(const FX& effect)
     data.rotation.z = effect.rz;
     
     // Velocity (movement direction)
-    data.velocity.x = effect.dx;
-    data.velocity.y = effect.dy;
-    data.velocity.z = effect.dz;
+    data.velocity.x = effect.vx;
+    data.velocity.y = effect.vy;
+    data.velocity.z = effect.vz;
     
     // Visual properties
     data.r = effect.color.r;
@@ -43,7 +42,7 @@ EffectRenderData EffectDataExtractor::ExtractSingleEffectData(const FX& effect)
     // Scale calculation based on time progression (from original FX::Draw logic)
     float timeRatio = (effect.maxTime > 0) ? (effect.time / effect.maxTime) : 1.0f;
     
-    switch (effect.type) {
+    switch (type) {
         case FxType::TYPE_ZERO:
             data.scale = 5.0f * timeRatio;
             break;
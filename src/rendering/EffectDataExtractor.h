@@ -5,7 +5,8 @@
 #include "RenderData.h"
 
 // Forward declarations
-class FX;
+class ParticleSystem;
+struct ParticleView;
 
 /**
  * Utility class for extracting rendering data from effect objects
@@ -14,18 +15,19 @@ class FX;
 class EffectDataExtractor {
 public:
     /**
-     * Extract rendering data from a vector of FX objects
-     * @param effects Vector of FX objects to extract data from
-     * @return Vector of EffectRenderData for rendering
+     * Extract rendering data from every live particle, grouped by type
+     * @param particles Particle system to extract data from
+     * @param renderData Vector the EffectRenderData is appended to
      */
-    static std::vector<EffectRenderData> ExtractEffectRenderData(const std::vector<FX>& effects);
+    static void ExtractEffectRenderData(const ParticleSystem& particles, FrameVector<EffectRenderData>& renderData);
     
     /**
-     * Extract rendering data from a single FX object
-     * @param effect FX object to extract data from
+     * Extract rendering data from a single particle
+     * @param type Effect type of the particle's pool
+     * @param particle Particle to extract data from
      * @return EffectRenderData for rendering
      */
-    static EffectRenderData ExtractSingleEffectData(const FX& effect);
+    static EffectRenderData ExtractSingleEffectData(FxType type, const ParticleView& particle);
 };
 
 #endif // EFFECTDATAEXTRACTOR_H
@@ -11,6 +11,8 @@
 #include "RenderData.h"
 #include "../App.h"
 #include "../Logger.h"
+#include <algorithm>
+#include "GLProfile.h"
 
 EffectRenderer::EffectRenderer() : 
     BaseRenderer(),
@@ -38,7 +40,7 @@ void EffectRenderer::Cleanup() {
     Logger::Get().Write("EffectRenderer cleaned up\n");
 }
 
-void EffectRenderer::RenderEffects(const std::vector<EffectRenderData>& effects) {
+void EffectRenderer::RenderEffects(const FrameVector<EffectRenderData>& effects) {
     if (!isInitialized) {
         Logger::Get().Write("ERROR: EffectRenderer not initialized\n");
         return;
@@ -69,25 +71,40 @@ void EffectRenderer::RenderEffects(const std::vector<EffectRenderData>& effects)
     CleanupRenderState();
 }
 
+namespace {
+    // TextureHandler slot of an effect type, 0 when untextured
+    unsigned int GetEffectTexture(const EffectRenderData& effect) {
+        switch (effect.type) {
+            case FxType::TYPE_THREE:
+                return 16;
+            case FxType::TYPE_STAR:
+                return 19;
+            default:
+                // No texture needed for other effect types
+                return 0;
+        }
+    }
+
+    bool HasOutline(const EffectRenderData& effect) {
+        return effect.type == FxType::TYPE_DEATH || effect.type == FxType::TYPE_ZERO;
+    }
+
+    // Generous: the unit geometry scaled by the largest ApplyEffectScale factor
+    float GetBoundingRadius(const EffectRenderData& effect) {
+        return 1.5f * std::max(effect.scale, 1.0f);
+    }
+}
+
 void EffectRenderer::RenderEffect(const EffectRenderData& effect) {
     glPushMatrix();
     
-    // Position the effect
-    glTranslatef(effect.position.x, effect.position.y + 0.2f, effect.position.z);
-    
-    // Apply rotations
-    glRotatef(effect.rotation.x, 1, 0, 0);
-    glRotatef(-effect.rotation.y, 0, 1, 0);
-    glRotatef(effect.rotation.z, 0, 0, 1);
-    
     // Set up textures for specific effect types
     SetupEffectTexture(effect);
     
     // Disable face culling for effects
-    glDisable(GL_CULL_FACE);
+    GLStateCache::Get().Disable(GL_CULL_FACE);
     
-    // Apply effect-specific scaling
-    ApplyEffectScale(effect);
+    ApplyEffectTransform(effect);
     
     // Set primary color for outline/base
     glColor3f(effect.r, effect.g, effect.b);
@@ -97,45 +114,80 @@ void EffectRenderer::RenderEffect(const EffectRenderData& effect) {
     
     // Render glowing effect with alpha blending
     SetupBlendMode();
-    glColor4f(effect.r, effect.g, effect.b, effect.alpha);
-    
-    // Render the glowing inner part
-    if (App::GetSingleton().graphicsTask) {
-        App::GetSingleton().graphicsTask->squarelist.Call(0);
-    }
-    
+    DrawGlow(effect);
     RestoreBlendMode();
     
     // Clean up textures and face culling
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_CULL_FACE);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_CULL_FACE);
     
     glPopMatrix();
 }
 
-void EffectRenderer::SetupEffectTexture(const EffectRenderData& effect) {
-    unsigned int textureId = 0;
+void EffectRenderer::ApplyEffectTransform(const EffectRenderData& effect) {
+    // Position the effect
+    glTranslatef(effect.position.x, effect.position.y + 0.2f, effect.position.z);
     
-    switch (effect.type) {
-        case FxType::TYPE_THREE:
-            textureId = 16;
-            break;
-        case FxType::TYPE_STAR:
-            textureId = 19;
-            break;
-        default:
-            // No texture needed for other effect types
-            return;
+    // Apply rotations
+    glRotatef(effect.rotation.x, 1, 0, 0);
+    glRotatef(-effect.rotation.y, 0, 1, 0);
+    glRotatef(effect.rotation.z, 0, 0, 1);
+    
+    // Apply effect-specific scaling
+    ApplyEffectScale(effect);
+}
+
+void EffectRenderer::DrawGlow(const EffectRenderData& effect) {
+    glColor4f(effect.r, effect.g, effect.b, effect.alpha);
+    
+    // Render the glowing inner part
+    if (App::GetSingleton().graphicsTask) {
+        App::GetSingleton().graphicsTask->squarelist.Call(0);
     }
+}
+
+void EffectRenderer::SetupEffectTexture(const EffectRenderData& effect) {
+    const unsigned int textureId = GetEffectTexture(effect);
     
     if (textureId != 0 && App::GetSingleton().graphicsTask) {
-        glEnable(GL_TEXTURE_2D);
-        glBindTexture(GL_TEXTURE_2D, App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[textureId]);
+        GLStateCache::Get().Enable(GL_TEXTURE_2D);
+        GLStateCache::Get().BindTexture(App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[textureId]);
         texturesEnabled = true;
         currentTexture = textureId;
     }
 }
 
+void EffectRenderer::Prepare(const FrameVector<EffectRenderData>& effects, RenderList& list) {
+    submittedEffects = &effects;
+    for (size_t i = 0; i < effects.size(); i++) {
+        const EffectRenderData& effect = effects[i];
+        const unsigned int textureId = GetEffectTexture(effect);
+        const uint32_t texture = textureId != 0 ? textureId + 1 : 0;
+        const uint32_t material = static_cast<uint32_t>(effect.type);
+        const uint32_t item = static_cast<uint32_t>(i) << 1;
+
+        list.BeginObject(effect.position, GetBoundingRadius(effect));
+        if (HasOutline(effect)) {
+            list.Add(RenderLayer::OPAQUE, DrawState::UNCULLED, texture, material, this, item);
+        }
+        list.Add(RenderLayer::TRANSPARENT, DrawState::ADDITIVE, texture, material, this, item | 1);
+    }
+}
+
+void EffectRenderer::DrawPacket(uint32_t item) {
+    const EffectRenderData& effect = (*submittedEffects)[item >> 1];
+
+    glPushMatrix();
+    ApplyEffectTransform(effect);
+    if (item & 1) {
+        DrawGlow(effect);
+    } else {
+        glColor3f(effect.r, effect.g, effect.b);
+        RenderEffectGeometry(effect);
+    }
+    glPopMatrix();
+}
+
 void EffectRenderer::ApplyEffectScale(const EffectRenderData& effect) {
     switch (effect.type) {
         case FxType::TYPE_ZERO:
@@ -164,7 +216,7 @@ void EffectRenderer::ApplyEffectScale(const EffectRenderData& effect) {
 
 void EffectRenderer::RenderEffectGeometry(const EffectRenderData& effect) {
     // Render base geometry for specific effect types
-    if (effect.type == FxType::TYPE_DEATH || effect.type == FxType::TYPE_ZERO) {
+    if (HasOutline(effect)) {
         if (App::GetSingleton().graphicsTask) {
             App::GetSingleton().graphicsTask->squarelist2.Call(0);
         }
@@ -181,25 +233,25 @@ void EffectRenderer::SetupEffectRendering() {
 void EffectRenderer::CleanupEffectRendering() {
     // Restore any global state if needed
     if (texturesEnabled) {
-        glDisable(GL_TEXTURE_2D);
+        GLStateCache::Get().Disable(GL_TEXTURE_2D);
         texturesEnabled = false;
     }
 }
 
 void EffectRenderer::SetupBlendMode() {
     if (!blendEnabled) {
-        glEnable(GL_BLEND);
-        glEnable(GL_DEPTH_TEST);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        glDepthMask(GL_FALSE);
+        GLStateCache::Get().Enable(GL_BLEND);
+        GLStateCache::Get().Enable(GL_DEPTH_TEST);
+        GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
+        GLStateCache::Get().DepthMask(GL_FALSE);
         blendEnabled = true;
     }
 }
 
 void EffectRenderer::RestoreBlendMode() {
     if (blendEnabled) {
-        glDisable(GL_BLEND);
-        glDepthMask(GL_TRUE);
+        GLStateCache::Get().Disable(GL_BLEND);
+        GLStateCache::Get().DepthMask(GL_TRUE);
         blendEnabled = false;
     }
 }
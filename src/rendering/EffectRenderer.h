@@ -2,6 +2,9 @@
 #define EFFECTRENDERER_H
 
 #include "BaseRenderer.h"
+#include "RenderQueue.h"
+#include "RenderList.h"
+#include "../memory/FrameArena.h"
 #include <vector>
 
 // Forward declaration
@@ -15,7 +18,7 @@ struct EffectRenderData;
  * 
  * Supports all effect types: explosions, smoke, stars, death effects, etc.
  */
-class EffectRenderer : public BaseRenderer {
+class EffectRenderer : public BaseRenderer, public IQueuedRenderer {
 public:
     EffectRenderer();
     virtual ~EffectRenderer() = default;
@@ -25,12 +28,21 @@ public:
     virtual void Cleanup() override;
     
     // Effect-specific rendering method
-    void RenderEffects(const std::vector<EffectRenderData>& effects);
+    void RenderEffects(const FrameVector<EffectRenderData>& effects);
+
+    // Add the outline (death and zero effects) and the additive glow of each
+    // effect to the frame's render list. The effects must stay alive until
+    // the last view has executed.
+    void Prepare(const FrameVector<EffectRenderData>& effects, RenderList& list);
+    void DrawPacket(uint32_t item) override;
+    RenderSource GetRenderSource() const override { return RenderSource::EFFECTS; }
 
 private:
     // Main rendering functions for different effect types
     void RenderEffect(const EffectRenderData& effect);
     void SetupEffectTexture(const EffectRenderData& effect);
+    void ApplyEffectTransform(const EffectRenderData& effect);
+    void DrawGlow(const EffectRenderData& effect);
     void ApplyEffectScale(const EffectRenderData& effect);
     void RenderEffectGeometry(const EffectRenderData& effect);
     
@@ -44,6 +56,8 @@ private:
     bool blendEnabled;
     bool texturesEnabled;
     unsigned int currentTexture;
+
+    const FrameVector<EffectRenderData>* submittedEffects = nullptr;
 };
 
 #endif // EFFECTRENDERER_H
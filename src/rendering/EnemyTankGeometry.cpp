@@ -0,0 +1,56 @@
+#include "EnemyTankGeometry.h"
+
+namespace {
+    // Hull
+    const MeshTriangle BODY_TRIANGLES[] = {
+        {{0.894427f, -0.447214f, 0.000000f}, {{0.24f, 0.0f, -0.24f}, {0.24f, 0.0f, 0.24f}, {0.3f, 0.12f, 0.18f}}},
+        {{0.894427f, -0.447214f, 0.000000f}, {{0.24f, 0.0f, -0.24f}, {0.3f, 0.12f, 0.18f}, {0.3f, 0.12f, -0.18f}}},
+        {{-0.894427f, -0.447214f, 0.000000f}, {{-0.24f, 0.0f, -0.24f}, {-0.3f, 0.12f, -0.3f}, {-0.3f, 0.12f, 0.3f}}},
+        {{-0.894427f, -0.447214f, 0.000000f}, {{-0.24f, 0.0f, -0.24f}, {-0.3f, 0.12f, 0.3f}, {-0.24f, 0.0f, 0.24f}}},
+        {{0.182574f, 0.365148f, -0.912871f}, {{0.24f, 0.0f, -0.24f}, {0.3f, 0.12f, -0.18f}, {-0.3f, 0.12f, -0.3f}}},
+        {{0.000000f, -0.447214f, -0.894427f}, {{0.24f, 0.0f, -0.24f}, {-0.3f, 0.12f, -0.3f}, {-0.24f, 0.0f, -0.24f}}},
+        {{0.000000f, -0.447214f, 0.894427f}, {{0.24f, 0.0f, 0.24f}, {-0.24f, 0.0f, 0.24f}, {-0.3f, 0.12f, 0.3f}}},
+        {{0.182574f, 0.365148f, 0.912871f}, {{0.24f, 0.0f, 0.24f}, {-0.3f, 0.12f, 0.3f}, {0.3f, 0.12f, 0.18f}}},
+        {{0.000000f, 1.000000f, 0.000000f}, {{0.3f, 0.12f, -0.18f}, {0.3f, 0.12f, 0.18f}, {-0.3f, 0.12f, 0.3f}}},
+        {{0.000000f, 1.000000f, 0.000000f}, {{0.3f, 0.12f, -0.18f}, {-0.3f, 0.12f, 0.3f}, {-0.3f, 0.12f, -0.3f}}},
+        {{0.000000f, -1.000000f, 0.000000f}, {{0.24f, 0.0f, -0.24f}, {-0.24f, 0.0f, -0.24f}, {-0.24f, 0.0f, 0.24f}}},
+        {{0.000000f, -1.000000f, 0.000000f}, {{0.24f, 0.0f, -0.24f}, {-0.24f, 0.0f, 0.24f}, {0.24f, 0.0f, 0.24f}}},
+    };
+
+    // Block on the hull, turned with the turret
+    const MeshTriangle BARREL_TRIANGLES[] = {
+        {{0.163846f, -0.081923f, 0.983078f}, {{0.3f, 0.2f, 0.2f}, {-0.3f, 0.2f, 0.3f}, {-0.2f, 0.4f, 0.3f}}},
+        {{0.180156f, -0.041001f, 0.982783f}, {{0.3f, 0.2f, 0.2f}, {-0.2f, 0.4f, 0.3f}, {0.3f, 0.4f, 0.2f}}},
+        {{0.196116f, 0.000000f, -0.980581f}, {{0.3f, 0.2f, -0.2f}, {0.3f, 0.4f, -0.2f}, {-0.2f, 0.4f, -0.3f}}},
+        {{0.180156f, -0.041001f, -0.982783f}, {{0.3f, 0.2f, -0.2f}, {-0.2f, 0.4f, -0.3f}, {-0.3f, 0.2f, -0.3f}}},
+        {{1.000000f, 0.000000f, 0.000000f}, {{0.3f, 0.2f, 0.2f}, {0.3f, 0.4f, 0.2f}, {0.3f, 0.4f, -0.2f}}},
+        {{1.000000f, 0.000000f, 0.000000f}, {{0.3f, 0.2f, 0.2f}, {0.3f, 0.4f, -0.2f}, {0.3f, 0.2f, -0.2f}}},
+        {{-0.894427f, 0.447214f, 0.000000f}, {{-0.3f, 0.2f, 0.3f}, {-0.3f, 0.2f, -0.3f}, {-0.2f, 0.4f, -0.3f}}},
+        {{-0.894427f, 0.447214f, 0.000000f}, {{-0.3f, 0.2f, 0.3f}, {-0.2f, 0.4f, -0.3f}, {-0.2f, 0.4f, 0.3f}}},
+        {{0.000000f, 1.000000f, 0.000000f}, {{0.3f, 0.4f, 0.2f}, {-0.2f, 0.4f, 0.3f}, {-0.2f, 0.4f, -0.3f}}},
+        {{0.000000f, 1.000000f, 0.000000f}, {{0.3f, 0.4f, 0.2f}, {-0.2f, 0.4f, -0.3f}, {0.3f, 0.4f, -0.2f}}},
+        {{0.000000f, -1.000000f, 0.000000f}, {{0.3f, 0.2f, 0.2f}, {0.3f, 0.2f, -0.2f}, {-0.3f, 0.2f, -0.3f}}},
+        {{0.000000f, -1.000000f, 0.000000f}, {{0.3f, 0.2f, 0.2f}, {-0.3f, 0.2f, -0.3f}, {-0.3f, 0.2f, 0.3f}}},
+    };
+
+    // Gun, offset 0.1 along the turret x axis by the renderer
+    const MeshTriangle TURRET_TRIANGLES[] = {
+        {{0.000000f, 1.000000f, 0.000000f}, {{-0.3f, 0.4f, -0.025f}, {0.5f, 0.4f, -0.025f}, {0.5f, 0.4f, 0.025f}}},
+        {{0.000000f, 1.000000f, 0.000000f}, {{-0.3f, 0.4f, -0.025f}, {0.5f, 0.4f, 0.025f}, {-0.3f, 0.4f, 0.025f}}},
+        {{0.000000f, -0.707107f, -0.707107f}, {{-0.3f, 0.4f, -0.025f}, {-0.3f, 0.3f, 0.0f}, {0.5f, 0.3f, 0.0f}}},
+        {{0.000000f, -0.707107f, -0.707107f}, {{-0.3f, 0.4f, -0.025f}, {0.5f, 0.3f, 0.0f}, {0.5f, 0.4f, -0.025f}}},
+        {{-1.000000f, 0.000000f, 0.000000f}, {{-0.3f, 0.4f, -0.025f}, {-0.3f, 0.4f, 0.025f}, {-0.3f, 0.3f, 0.0f}}},
+        {{1.000000f, 0.000000f, 0.000000f}, {{0.5f, 0.4f, -0.025f}, {0.5f, 0.3f, 0.0f}, {0.5f, 0.4f, 0.025f}}},
+        {{0.000000f, -0.707107f, 0.707107f}, {{-0.3f, 0.4f, 0.025f}, {0.5f, 0.4f, 0.025f}, {0.5f, 0.3f, 0.0f}}},
+        {{0.000000f, -0.707107f, 0.707107f}, {{-0.3f, 0.4f, 0.025f}, {0.5f, 0.3f, 0.0f}, {-0.3f, 0.3f, 0.0f}}},
+    };
+
+    const MeshData PARTS[EnemyTankGeometry::PART_COUNT] = {
+        {BODY_TRIANGLES, sizeof(BODY_TRIANGLES) / sizeof(BODY_TRIANGLES[0])},
+        {BARREL_TRIANGLES, sizeof(BARREL_TRIANGLES) / sizeof(BARREL_TRIANGLES[0])},
+        {TURRET_TRIANGLES, sizeof(TURRET_TRIANGLES) / sizeof(TURRET_TRIANGLES[0])}};
+}
+
+const MeshData& EnemyTankGeometry::Get(Part part) {
+    return PARTS[part];
+}
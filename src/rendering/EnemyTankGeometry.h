@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * One flat-shaded triangle: face normal and three corners.
+ */
+struct MeshTriangle {
+    float normal[3];
+    float positions[3][3];
+};
+
+struct MeshData {
+    const MeshTriangle* triangles;
+    int triangleCount;
+};
+
+/**
+ * Geometry of the enemy tank, formerly emitted vertex by vertex each frame
+ * by TankRenderer. Positions carry the part scale (0.06 for the body, 0.1
+ * for the others), so the parts are drawn without a glScalef. Texture
+ * coordinates are left out: enemy tanks are drawn untextured.
+ *
+ * The names follow the legacy renderer: BARREL is the block on top of the
+ * body, TURRET the gun drawn 0.1 further along the turret's x axis.
+ */
+namespace EnemyTankGeometry {
+    enum Part {
+        BODY,
+        BARREL,
+        TURRET,
+        PART_COUNT
+    };
+
+    const MeshData& Get(Part part);
+}
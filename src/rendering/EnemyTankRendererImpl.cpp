@@ -9,6 +9,8 @@
 #include <GL/gl.h>
 #endif
 
+#include "GLProfile.h"
+
 EnemyTankRendererImpl::EnemyTankRendererImpl() {
 }
 
@@ -45,19 +47,18 @@ void EnemyTankRendererImpl::Render(const TankRenderData& data) {
 void EnemyTankRendererImpl::SetupRenderState() {
     BaseRenderer::SetupRenderState();
     
-    // Enemy tank render state (optimized for performance)
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-    glEnable(GL_LIGHTING);
-    glDisable(GL_BLEND);
-    glDisable(GL_TEXTURE_2D);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
-    glFrontFace(GL_CW);
+    // Enemy tank render state (optimized for performance); the base class
+    // saved the previous state
+    GLStateCache::Get().Enable(GL_LIGHTING);
+    GLStateCache::Get().Disable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
+    GLStateCache::Get().DepthMask(GL_TRUE);
+    GLStateCache::Get().DepthFunc(GL_LESS);
+    GLStateCache::Get().FrontFace(GL_CW);
 }
 
 void EnemyTankRendererImpl::CleanupRenderState() {
     // Restore OpenGL state
-    glPopAttrib();
     BaseRenderer::CleanupRenderState();
 }
 
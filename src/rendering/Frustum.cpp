@@ -0,0 +1,53 @@
+#include "Frustum.h"
+#include <cmath>
+
+Frustum::Frustum() {
+    for (float* plane : planes) {
+        plane[0] = plane[1] = plane[2] = 0.0f;
+        plane[3] = 1.0f;
+    }
+}
+
+void Frustum::Extract(const float viewProjection[16]) {
+    // Row i of the matrix is m[i], m[4 + i], m[8 + i], m[12 + i]; the planes
+    // are row 3 plus or minus rows 0 (left, right), 1 (bottom, top) and
+    // 2 (near, far)
+    const float* m = viewProjection;
+    for (int i = 0; i < 6; i++) {
+        const int row = i / 2;
+        const float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+        float* plane = planes[i];
+        for (int column = 0; column < 4; column++) {
+            plane[column] = m[column * 4 + 3] + sign * m[column * 4 + row];
+        }
+
+        const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f) {
+            for (int column = 0; column < 4; column++) {
+                plane[column] /= length;
+            }
+        }
+    }
+}
+
+bool Frustum::IntersectsSphere(const Vector3& center, float radius) const {
+    for (const float* plane : planes) {
+        if (plane[0] * center.x + plane[1] * center.y + plane[2] * center.z + plane[3] < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Frustum::IntersectsBox(const Vector3& boxMin, const Vector3& boxMax) const {
+    for (const float* plane : planes) {
+        // The corner furthest along the plane normal
+        const float x = plane[0] >= 0.0f ? boxMax.x : boxMin.x;
+        const float y = plane[1] >= 0.0f ? boxMax.y : boxMin.y;
+        const float z = plane[2] >= 0.0f ? boxMax.z : boxMin.z;
+        if (plane[0] * x + plane[1] * y + plane[2] * z + plane[3] < 0.0f) {
+            return false;
+        }
+    }
+    return true;
+}
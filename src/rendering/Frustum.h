@@ -0,0 +1,27 @@
+#pragma once
+
+#include "RenderData.h"
+
+/**
+ * The six clip planes of a view, for culling on the CPU.
+ *
+ * Extracted from a column-major view-projection matrix (Gribb/Hartmann),
+ * so it matches whatever gluPerspective/gluLookAt or Mat4 set up. Plane
+ * normals point inward; a point is inside when it is on the positive side
+ * of all six. The tests are conservative: volumes straddling a plane
+ * count as visible.
+ */
+class Frustum {
+public:
+    // Everything is visible until Extract() is called
+    Frustum();
+
+    void Extract(const float viewProjection[16]);
+
+    bool IntersectsSphere(const Vector3& center, float radius) const;
+    bool IntersectsBox(const Vector3& boxMin, const Vector3& boxMax) const;
+
+private:
+    // a, b, c, d of ax + by + cz + d >= 0, normalized
+    float planes[6][4];
+};
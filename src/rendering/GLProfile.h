@@ -0,0 +1,41 @@
+#pragma once
+
+// The GL declarations come first so the wrappers below never rename them;
+// include this header after every other GL header of the file
+#ifdef _WIN32
+#include <windows.h>
+#include <GL/gl.h>
+#elif __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include "../profiling/GLCounters.h"
+
+/**
+ * Counting wrappers of the GL calls the renderers pay for.
+ *
+ * In profiling builds (TANKGAME_PROFILE_GL) the calls below are charged to
+ * GLCounters before they reach GL; the function names inside the macros
+ * are not expanded again, so they still call GL. Otherwise nothing is
+ * defined and the calls are untouched. Entry points loaded at run time
+ * (CoreGL) are counted at their call sites with GL_COUNT.
+ */
+#ifdef TANKGAME_PROFILE_GL
+#define glDrawArrays(mode, first, count) (GL_COUNT(DRAW), glDrawArrays(mode, first, count))
+#define glDrawElements(mode, count, type, indices) (GL_COUNT(DRAW), glDrawElements(mode, count, type, indices))
+#define glBegin(mode) (GL_COUNT(BEGIN_END), glBegin(mode))
+#define glCallList(list) (GL_COUNT(LIST_CALL), glCallList(list))
+#define glCallLists(n, type, lists) (GL_COUNT(LIST_CALL), glCallLists(n, type, lists))
+#define glBindTexture(target, texture) (GL_COUNT(TEXTURE_BIND), glBindTexture(target, texture))
+#define glPushMatrix() (GL_COUNT(MATRIX_PUSH), glPushMatrix())
+#define glEnable(cap) (GL_COUNT(STATE_CHANGE), glEnable(cap))
+#define glDisable(cap) (GL_COUNT(STATE_CHANGE), glDisable(cap))
+#define glBlendFunc(source, destination) (GL_COUNT(STATE_CHANGE), glBlendFunc(source, destination))
+#define glDepthMask(flag) (GL_COUNT(STATE_CHANGE), glDepthMask(flag))
+#define glDepthFunc(func) (GL_COUNT(STATE_CHANGE), glDepthFunc(func))
+#define glCullFace(mode) (GL_COUNT(STATE_CHANGE), glCullFace(mode))
+#define glFrontFace(mode) (GL_COUNT(STATE_CHANGE), glFrontFace(mode))
+#define glShadeModel(mode) (GL_COUNT(STATE_CHANGE), glShadeModel(mode))
+#endif
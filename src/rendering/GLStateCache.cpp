@@ -0,0 +1,207 @@
+#include "GLStateCache.h"
+#include "GLProfile.h"
+
+namespace {
+    // Indexed by GLStateCache::Cap
+    const GLenum TRACKED_CAPS[] = {
+        GL_DEPTH_TEST,
+        GL_CULL_FACE,
+        GL_BLEND,
+        GL_LIGHTING,
+        GL_TEXTURE_2D,
+        GL_COLOR_MATERIAL,
+        GL_NORMALIZE,
+        GL_LIGHT0,
+        GL_LINE_STIPPLE,
+    };
+}
+
+GLStateCache& GLStateCache::Get()
+{
+    static GLStateCache instance;
+    return instance;
+}
+
+GLStateCache::GLStateCache()
+{
+    Invalidate();
+}
+
+int GLStateCache::GetCapIndex(GLenum cap)
+{
+    for (int i = 0; i < CAP_COUNT; i++)
+    {
+        if (TRACKED_CAPS[i] == cap)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool GLStateCache::Changes(GLenum& shadowed, GLenum wanted)
+{
+    if (shadowed == wanted)
+    {
+        counters.elided++;
+        return false;
+    }
+    shadowed = wanted;
+    counters.issued++;
+    return true;
+}
+
+void GLStateCache::Set(GLenum cap, bool enabled)
+{
+    const int index = GetCapIndex(cap);
+    if (index >= 0 && !Changes(current.caps[index], enabled ? GL_TRUE : GL_FALSE))
+    {
+        return;
+    }
+    if (index < 0)
+    {
+        counters.issued++;
+    }
+
+    if (enabled)
+    {
+        glEnable(cap);
+    }
+    else
+    {
+        glDisable(cap);
+    }
+}
+
+void GLStateCache::BindTexture(GLuint texture)
+{
+    if (Changes(current.texture, texture))
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+}
+
+void GLStateCache::BlendFunc(GLenum sourceFactor, GLenum destinationFactor)
+{
+    if (current.blendSource == sourceFactor && current.blendDestination == destinationFactor)
+    {
+        counters.elided++;
+        return;
+    }
+    current.blendSource = sourceFactor;
+    current.blendDestination = destinationFactor;
+    counters.issued++;
+    glBlendFunc(sourceFactor, destinationFactor);
+}
+
+void GLStateCache::FrontFace(GLenum mode)
+{
+    if (Changes(current.frontFace, mode))
+    {
+        glFrontFace(mode);
+    }
+}
+
+void GLStateCache::CullFace(GLenum mode)
+{
+    if (Changes(current.cullFace, mode))
+    {
+        glCullFace(mode);
+    }
+}
+
+void GLStateCache::DepthMask(GLboolean flag)
+{
+    if (Changes(current.depthMask, flag ? GL_TRUE : GL_FALSE))
+    {
+        glDepthMask(flag);
+    }
+}
+
+void GLStateCache::DepthFunc(GLenum func)
+{
+    if (Changes(current.depthFunc, func))
+    {
+        glDepthFunc(func);
+    }
+}
+
+void GLStateCache::ShadeModel(GLenum mode)
+{
+    if (Changes(current.shadeModel, mode))
+    {
+        glShadeModel(mode);
+    }
+}
+
+void GLStateCache::PushState()
+{
+    stack.push_back(current);
+}
+
+void GLStateCache::PopState()
+{
+    if (stack.empty())
+    {
+        return;
+    }
+    const Shadow saved = stack.back();
+    stack.pop_back();
+
+    // Re-issue what differs. Fields unknown at push cannot be restored and
+    // become unknown again.
+    for (int i = 0; i < CAP_COUNT; i++)
+    {
+        if (saved.caps[i] == UNKNOWN)
+        {
+            current.caps[i] = UNKNOWN;
+        }
+        else
+        {
+            Set(TRACKED_CAPS[i], saved.caps[i] == GL_TRUE);
+        }
+    }
+
+    if (saved.texture == UNKNOWN) current.texture = UNKNOWN;
+    else BindTexture(saved.texture);
+
+    if (saved.blendSource == UNKNOWN) current.blendSource = current.blendDestination = UNKNOWN;
+    else BlendFunc(saved.blendSource, saved.blendDestination);
+
+    if (saved.frontFace == UNKNOWN) current.frontFace = UNKNOWN;
+    else FrontFace(saved.frontFace);
+
+    if (saved.cullFace == UNKNOWN) current.cullFace = UNKNOWN;
+    else CullFace(saved.cullFace);
+
+    if (saved.depthMask == UNKNOWN) current.depthMask = UNKNOWN;
+    else DepthMask(saved.depthMask == GL_TRUE);
+
+    if (saved.depthFunc == UNKNOWN) current.depthFunc = UNKNOWN;
+    else DepthFunc(saved.depthFunc);
+
+    if (saved.shadeModel == UNKNOWN) current.shadeModel = UNKNOWN;
+    else ShadeModel(saved.shadeModel);
+}
+
+void GLStateCache::Invalidate()
+{
+    for (GLenum& cap : current.caps)
+    {
+        cap = UNKNOWN;
+    }
+    current.texture = UNKNOWN;
+    current.blendSource = UNKNOWN;
+    current.blendDestination = UNKNOWN;
+    current.frontFace = UNKNOWN;
+    current.cullFace = UNKNOWN;
+    current.depthMask = UNKNOWN;
+    current.depthFunc = UNKNOWN;
+    current.shadeModel = UNKNOWN;
+}
+
+void GLStateCache::ResetCounters()
+{
+    counters.issued = 0;
+    counters.elided = 0;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#include <GL/gl.h>
+#elif __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * CPU-side shadow of the fixed-function GL state the renderers touch.
+ *
+ * The wrappers compare against the shadow and skip calls that would not
+ * change anything, so a renderer can state everything it needs without
+ * knowing what ran before it. PushState()/PopState() save and restore the
+ * shadow in place of glPushAttrib/glPopAttrib: only the differences are
+ * issued on pop, and the driver never copies its whole attribute block.
+ *
+ * State starts unknown (the first call always goes through). Call
+ * Invalidate() after anything changes these states behind the cache's
+ * back, e.g. raw GL calls or glPopAttrib. Legacy (compatibility) context
+ * only; the core backend keeps its own state.
+ */
+class GLStateCache {
+public:
+    struct Counters {
+        uint64_t issued;    // Calls that reached GL
+        uint64_t elided;    // Calls skipped as no-ops
+    };
+
+    static GLStateCache& Get();
+
+    // Capabilities. Ones the cache does not track are passed through.
+    void Enable(GLenum cap) { Set(cap, true); }
+    void Disable(GLenum cap) { Set(cap, false); }
+    void Set(GLenum cap, bool enabled);
+
+    // GL_TEXTURE_2D on the active unit
+    void BindTexture(GLuint texture);
+    void BlendFunc(GLenum sourceFactor, GLenum destinationFactor);
+    void FrontFace(GLenum mode);
+    void CullFace(GLenum mode);
+    void DepthMask(GLboolean flag);
+    void DepthFunc(GLenum func);
+    void ShadeModel(GLenum mode);
+
+    void PushState();
+    void PopState();
+    void Invalidate();
+
+    const Counters& GetCounters() const { return counters; }
+    void ResetCounters();
+
+private:
+    enum Cap {
+        CAP_DEPTH_TEST,
+        CAP_CULL_FACE,
+        CAP_BLEND,
+        CAP_LIGHTING,
+        CAP_TEXTURE_2D,
+        CAP_COLOR_MATERIAL,
+        CAP_NORMALIZE,
+        CAP_LIGHT0,
+        CAP_LINE_STIPPLE,
+        CAP_COUNT
+    };
+
+    static const GLenum UNKNOWN = 0xFFFFFFFFu;
+
+    // UNKNOWN in any field means the next call for it is always issued
+    struct Shadow {
+        GLenum caps[CAP_COUNT];     // GL_TRUE, GL_FALSE or UNKNOWN
+        GLenum texture;
+        GLenum blendSource;
+        GLenum blendDestination;
+        GLenum frontFace;
+        GLenum cullFace;
+        GLenum depthMask;
+        GLenum depthFunc;
+        GLenum shadeModel;
+    };
+
+    Shadow current;
+    std::vector<Shadow> stack;
+    Counters counters = {0, 0};
+
+    GLStateCache();
+
+    static int GetCapIndex(GLenum cap);
+    bool Changes(GLenum& shadowed, GLenum wanted);
+};
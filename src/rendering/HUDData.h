@@ -1,9 +1,11 @@
 #ifndef HUDDATA_H
 #define HUDDATA_H
 
+#include <array>
 #include <vector>
 #include <string>
 #include "RenderData.h"  // For Vector3
+#include "../profiling/FrameStats.h"
 
 /**
  * HUD Rendering Data Structures
@@ -162,6 +164,13 @@ struct DebugRenderData {
     int renderCallCount;                // Number of render calls this frame
     int triangleCount;                  // Number of triangles rendered
     
+    // Heap allocations of the last frame (memory/AllocationTracker)
+    bool showAllocationStats;           // Tracker compiled in
+    unsigned long allocationsPerFrame;
+    unsigned long allocatedBytesPerFrame;
+    unsigned long allocationBudget;     // 0 = no budget
+    std::vector<std::string> allocationScopes;  // Busiest scopes, "name: count"
+    
     // Debug colors
     Vector3 debugTextColor;             // Color for debug text
     Vector3 performanceColor;           // Color for performance text
@@ -174,12 +183,61 @@ struct DebugRenderData {
         averageFPS(60.0f),
         renderCallCount(0),
         triangleCount(0),
+        showAllocationStats(false),
+        allocationsPerFrame(0),
+        allocatedBytesPerFrame(0),
+        allocationBudget(0),
         debugTextColor(1.0f, 1.0f, 0.0f),
         performanceColor(0.0f, 1.0f, 1.0f)
     {
     }
 };
 
+/**
+ * Data for the frame stats overlay (profiling/FrameStats, toggled with F3)
+ */
+struct FrameStatsRenderData {
+    bool visible;
+    FrameTimeSummary summary;
+    float targetFrameMs;                // Reference line of the graph
+    
+    // Frame times of the window, oldest first
+    std::array<float, FrameStats::WINDOW> history;
+    size_t historyCount;
+    
+    // Per-task time of the last frame and its smoothed average
+    std::array<FrameStats::Stage, FrameStats::MAX_STAGES> stages;
+    size_t stageCount;
+    
+    // Scene contents and renderer output
+    int tanks;
+    int bullets;
+    int effects;
+    int items;
+    int objectsDrawn;                   // Last frame, all views
+    
+    // Input sampling to present, and how frames are paced
+    float inputLatencyMs;
+    float inputLatencyAverageMs;
+    const char* pacingMode;
+    
+    FrameStatsRenderData() :
+        visible(false),
+        targetFrameMs(1000.0f / 60.0f),
+        historyCount(0),
+        stageCount(0),
+        tanks(0),
+        bullets(0),
+        effects(0),
+        items(0),
+        objectsDrawn(0),
+        inputLatencyMs(0.0f),
+        inputLatencyAverageMs(0.0f),
+        pacingMode("")
+    {
+    }
+};
+
 /**
  * Complete UI rendering data for all players
  */
@@ -187,6 +245,7 @@ struct UIRenderData {
     std::vector<HUDRenderData> playerHUDs;  // HUD data for each player
     MenuRenderData menu;                     // Current menu state
     DebugRenderData debug;                   // Debug information
+    FrameStatsRenderData frameStats;         // Frame time overlay
     
     // Global UI state
     bool gameStarted;                        // Whether game has started
@@ -3,10 +3,14 @@
 #include "../TankHandler.h"
 #include "../PlayerManager.h"
 #include "../App.h"
+#include "../VideoTask.h"
 #include "../GlobalTimer.h"
 #include "RenderData.h"
+#include "../memory/AllocationTracker.h"
+#include "../profiling/FrameStats.h"
 
 #include <cmath>
+#include <cstdio>
 #include <array>
 
 HUDRenderData HUDDataExtractor::ExtractPlayerHUD(const Tank& player, int playerId) {
@@ -25,10 +29,10 @@ HUDRenderData HUDDataExtractor::ExtractPlayerHUD(const Tank& player, int playerI
     // Energy data (actions)
     hudData.energy = player.energy;           // Now properly using energy field (was charge)
     hudData.maxEnergy = player.maxEnergy;     // Now properly using maxEnergy field (was maxCharge)
-    hudData.fireCost = player.fireCost;
+    hudData.fireCost = player.Cold().fireCost;
     
     // Calculate firing ability (energy-based)
-    hudData.canFire = (player.energy >= player.fireCost);
+    hudData.canFire = (player.energy >= player.Cold().fireCost);
     
     // Extract combo and special data
     ExtractComboAndSpecialData(player, playerId, hudData);
@@ -79,12 +83,13 @@ UIRenderData HUDDataExtractor::ExtractCompleteUIData(
     bool isPaused,
     bool showMenu,
     int menuState,
-    bool showDebug) {
+    bool showDebug,
+    const std::vector<HUDRenderData>* heldHUDs) {
     
     UIRenderData uiData;
     
     // Extract player HUD data from PlayerManager
-    uiData.playerHUDs = ExtractAllPlayerHUDs(playerMgr.GetPlayerTanks(), playerMgr.GetNumPlayers());
+    uiData.playerHUDs = heldHUDs ? *heldHUDs : ExtractAllPlayerHUDs(playerMgr.GetPlayerTanks(), playerMgr.GetNumPlayers());
     uiData.numPlayers = playerMgr.GetNumPlayers();
     
     // Extract menu data
@@ -92,6 +97,7 @@ UIRenderData HUDDataExtractor::ExtractCompleteUIData(
     
     // Extract debug data
     uiData.debug = ExtractDebugData(showDebug);
+    uiData.frameStats = ExtractFrameStatsData();
     
     // Set global UI state
     uiData.gameStarted = gameStarted;
@@ -149,6 +155,23 @@ DebugRenderData HUDDataExtractor::ExtractDebugData(bool showDebug) {
         // TODO: Extract render stats from rendering pipeline when available
         debugData.renderCallCount = 0;
         debugData.triangleCount = 0;
+
+        const AllocationTracker& allocations = AllocationTracker::Get();
+        debugData.showAllocationStats = AllocationTracker::IsAvailable();
+        if (debugData.showAllocationStats) {
+            const AllocationCounts& frame = allocations.GetLastFrame();
+            debugData.allocationsPerFrame = static_cast<unsigned long>(frame.allocations);
+            debugData.allocatedBytesPerFrame = static_cast<unsigned long>(frame.bytes);
+            debugData.allocationBudget = static_cast<unsigned long>(allocations.GetFrameBudget());
+            for (const auto& scope : allocations.GetFrameScopes()) {
+                if (debugData.allocationScopes.size() == 4) {
+                    break;
+                }
+                char line[64];
+                snprintf(line, sizeof(line), "%s: %llu", scope.scope, static_cast<unsigned long long>(scope.counts.allocations));
+                debugData.allocationScopes.push_back(line);
+            }
+        }
     }
     
     return debugData;
@@ -240,3 +263,26 @@ void HUDDataExtractor::ExtractPerformanceData(HUDRenderData& hudData) {
         hudData.currentFPS = 999.0f;
     }
 }
+
+FrameStatsRenderData HUDDataExtractor::ExtractFrameStatsData() {
+    FrameStatsRenderData statsData;
+    
+    const FrameStats& stats = FrameStats::Get();
+    statsData.visible = stats.IsOverlayVisible();
+    if (!statsData.visible) {
+        return statsData;
+    }
+    
+    statsData.summary = stats.Summarize();
+    statsData.historyCount = stats.CopyHistory(statsData.history.data(), statsData.history.size());
+    statsData.stageCount = stats.GetStageCount();
+    for (size_t i = 0; i < statsData.stageCount; i++) {
+        statsData.stages[i] = stats.GetStage(i);
+    }
+    statsData.objectsDrawn = stats.GetObjectsDrawn();
+    statsData.inputLatencyMs = stats.GetInputLatency();
+    statsData.inputLatencyAverageMs = stats.GetAverageInputLatency();
+    statsData.pacingMode = FramePacer::GetModeName(VideoTask::pacingMode);
+    
+    return statsData;
+}
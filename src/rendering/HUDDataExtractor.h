@@ -43,6 +43,7 @@ public:
      * @param showMenu Whether menu should be displayed
      * @param menuState Current menu state
      * @param showDebug Whether debug info should be displayed
+     * @param heldHUDs Player HUDs to reuse instead of extracting them (nullptr extracts)
      * @return Complete UI render data
      */
     static UIRenderData ExtractCompleteUIData(
@@ -51,7 +52,8 @@ public:
         bool isPaused = false,
         bool showMenu = false,
         int menuState = 0,
-        bool showDebug = false);
+        bool showDebug = false,
+        const std::vector<HUDRenderData>* heldHUDs = nullptr);
     
     /**
      * Extract menu data
@@ -67,6 +69,14 @@ public:
      * @return Debug render data
      */
     static DebugRenderData ExtractDebugData(bool showDebug);
+    
+    /**
+     * Extract the frame stats overlay data (timings only; the scene's
+     * entity counts are filled in by the SceneDataBuilder).
+     * Cheap when the overlay is hidden.
+     * @return FrameStatsRenderData for the overlay
+     */
+    static FrameStatsRenderData ExtractFrameStatsData();
 
 private:
     /**
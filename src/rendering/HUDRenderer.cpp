@@ -1,7 +1,9 @@
 #include "HUDRenderer.h"
 #include "RenderData.h"
 #include "../App.h"
+#include "../Logger.h"
 #include "../TextureHandler.h"
+#include <SDL2/SDL_ttf.h>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -15,10 +17,22 @@
 #include <GL/glu.h>
 #endif
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
+#include "GLProfile.h"
 
-HUDRenderer::HUDRenderer() : texturesLoaded(false) {
+namespace {
+    const char* const HUD_FONT_PATH = "./fonts/DroidSansMono.ttf";
+    const int HUD_FONT_POINTS = 32;
+    const char FIRST_GLYPH = ' ';
+    const char LAST_GLYPH = '~';
+    const int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+    const float TEXT_HEIGHT = 0.035f;   // Line height in HUD units (lines are 0.04-0.05 apart)
+}
+
+HUDRenderer::HUDRenderer()
+    : texturesLoaded(false), fontTexture(0), glyphU(0.0f), glyphAspect(0.0f), textAspect(1.0f) {
     // Initialize texture array
     for (int i = 0; i < TEXTURE_COUNT; ++i) {
         hudTextures[i] = 0;
@@ -31,11 +45,15 @@ bool HUDRenderer::Initialize() {
     // Load HUD-specific textures
     success &= LoadHUDTextures();
     
+    // Without the font the overlays still draw their graphs, just no figures
+    LoadFontAtlas();
+    
     return success;
 }
 
 void HUDRenderer::Cleanup() {
     CleanupHUDTextures();
+    CleanupFontAtlas();
 }
 
 void HUDRenderer::RenderPlayerHUD(const HUDRenderData& hudData) {
@@ -154,16 +172,145 @@ void HUDRenderer::RenderDebugInfo(const DebugRenderData& debugData) {
         RenderHUDText(buffer, -0.9f, 0.75f, debugData.debugTextColor);
     }
     
+    // Render allocation stats, red while over budget
+    if (debugData.showAllocationStats) {
+        char buffer[64];
+        const bool overBudget = debugData.allocationBudget > 0 && debugData.allocationsPerFrame > debugData.allocationBudget;
+        const Vector3 color = overBudget ? Vector3(1.0f, 0.2f, 0.2f) : debugData.debugTextColor;
+        if (debugData.allocationBudget > 0) {
+            sprintf(buffer, "Allocs: %lu/%lu (%lu KB)", debugData.allocationsPerFrame, debugData.allocationBudget,
+                    debugData.allocatedBytesPerFrame / 1024);
+        } else {
+            sprintf(buffer, "Allocs: %lu (%lu KB)", debugData.allocationsPerFrame, debugData.allocatedBytesPerFrame / 1024);
+        }
+        RenderHUDText(buffer, -0.9f, 0.7f, color);
+        
+        float y = 0.65f;
+        for (const std::string& line : debugData.allocationScopes) {
+            RenderHUDText(line.c_str(), -0.85f, y, debugData.debugTextColor);
+            y -= 0.05f;
+        }
+    }
+    
     CleanupTextRenderState();
     RestoreGameProjection();
 }
 
+void HUDRenderer::RenderFrameStats(const FrameStatsRenderData& statsData) {
+    if (!statsData.visible) {
+        return;
+    }
+    
+    // Panel in the top right corner; the graph spans twice the target frame
+    // time, or the worst frame if that is longer. The percentile line sits
+    // above the graph, the task bar below it, then one line per task, the
+    // counts line and the input latency line
+    const float left = 0.40f, right = 0.95f, bottom = 0.55f, top = 0.90f;
+    const float lineStep = 0.04f, firstLineY = 0.42f;
+    const int figureLines = static_cast<int>(statsData.stageCount) + 2;
+    const float panelBottom = firstLineY - lineStep * (figureLines - 1) - 0.02f;
+    const float panelTop = 0.92f + TEXT_HEIGHT + 0.01f;
+    const float target = statsData.targetFrameMs;
+    const float scaleMs = std::max(2.0f * target, statsData.summary.maxMs);
+    auto graphY = [&](float ms) { return bottom + (top - bottom) * std::min(ms / scaleMs, 1.0f); };
+    
+    SetupHUDProjection();
+    SetupHUDRenderState();
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
+    
+    glBegin(GL_QUADS);
+    ApplyColor(Vector3(0.0f, 0.0f, 0.0f), 0.5f);
+    glVertex3f(left - 0.02f, panelBottom, 0);
+    glVertex3f(right + 0.02f, panelBottom, 0);
+    glVertex3f(right + 0.02f, panelTop, 0);
+    glVertex3f(left - 0.02f, panelTop, 0);
+    glEnd();
+    
+    // Target and twice-target reference lines
+    glBegin(GL_LINES);
+    ApplyColor(Vector3(0.2f, 0.6f, 0.2f));
+    glVertex3f(left, graphY(target), 0);
+    glVertex3f(right, graphY(target), 0);
+    ApplyColor(Vector3(0.6f, 0.6f, 0.2f));
+    glVertex3f(left, graphY(2.0f * target), 0);
+    glVertex3f(right, graphY(2.0f * target), 0);
+    glEnd();
+    
+    // Frame times, oldest on the left, coloured by how far over target
+    if (statsData.historyCount > 1) {
+        const float step = (right - left - 0.03f) / (FrameStats::WINDOW - 1);
+        glBegin(GL_LINE_STRIP);
+        for (size_t i = 0; i < statsData.historyCount; i++) {
+            const float ms = statsData.history[i];
+            ApplyColor(ms <= target ? Vector3(0.3f, 1.0f, 0.3f)
+                       : ms <= 2.0f * target ? Vector3(1.0f, 1.0f, 0.3f) : Vector3(1.0f, 0.3f, 0.3f));
+            glVertex3f(left + step * (FrameStats::WINDOW - statsData.historyCount + i), graphY(ms), 0);
+        }
+        glEnd();
+    }
+    
+    // p50, p95, p99 and max as ticks at the right edge
+    const float percentileMs[] = {statsData.summary.p50Ms, statsData.summary.p95Ms,
+                                  statsData.summary.p99Ms, statsData.summary.maxMs};
+    const Vector3 percentileColors[] = {Vector3(1.0f, 1.0f, 1.0f), Vector3(1.0f, 1.0f, 0.3f),
+                                        Vector3(1.0f, 0.6f, 0.2f), Vector3(1.0f, 0.3f, 0.3f)};
+    glBegin(GL_LINES);
+    for (int i = 0; i < 4; i++) {
+        ApplyColor(percentileColors[i]);
+        glVertex3f(right - 0.025f, graphY(percentileMs[i]), 0);
+        glVertex3f(right, graphY(percentileMs[i]), 0);
+    }
+    glEnd();
+    
+    // Per-task share of the frame as one stacked bar (smoothed times)
+    const Vector3 stageColors[] = {Vector3(0.9f, 0.4f, 0.4f), Vector3(0.4f, 0.9f, 0.4f), Vector3(0.4f, 0.5f, 1.0f),
+                                   Vector3(0.9f, 0.9f, 0.4f), Vector3(0.9f, 0.4f, 0.9f), Vector3(0.4f, 0.9f, 0.9f),
+                                   Vector3(0.9f, 0.6f, 0.3f), Vector3(0.7f, 0.7f, 0.7f)};
+    float x = left;
+    for (size_t i = 0; i < statsData.stageCount; i++) {
+        const float width = (right - left) * std::min(statsData.stages[i].averageMs / scaleMs, 1.0f);
+        RenderQuad(x, 0.48f, std::min(width, right - x), 0.03f, stageColors[i % 8]);
+        x = std::min(x + width, right);
+    }
+    
+    CleanupHUDRenderState();
+    
+    // Figures
+    SetupTextRenderState();
+    char buffer[96];
+    snprintf(buffer, sizeof(buffer), "p50 %.1f  p95 %.1f  p99 %.1f  max %.1f ms",
+             statsData.summary.p50Ms, statsData.summary.p95Ms, statsData.summary.p99Ms, statsData.summary.maxMs);
+    RenderHUDText(buffer, left, 0.92f, Vector3(1.0f, 1.0f, 1.0f));
+    float y = firstLineY;
+    for (size_t i = 0; i < statsData.stageCount; i++) {
+        snprintf(buffer, sizeof(buffer), "%s: %.2f ms (avg %.2f)", statsData.stages[i].name,
+                 statsData.stages[i].lastMs, statsData.stages[i].averageMs);
+        RenderHUDText(buffer, left, y, stageColors[i % 8]);
+        y -= lineStep;
+    }
+    snprintf(buffer, sizeof(buffer), "Tanks %d  Bullets %d  FX %d  Items %d  Drawn %d",
+             statsData.tanks, statsData.bullets, statsData.effects, statsData.items, statsData.objectsDrawn);
+    RenderHUDText(buffer, left, y, Vector3(1.0f, 1.0f, 1.0f));
+    y -= lineStep;
+    // No sample until a frame sampled input and presented
+    if (statsData.inputLatencyMs > 0.0f) {
+        snprintf(buffer, sizeof(buffer), "Input to present %.1f ms (avg %.1f)  %s",
+                 statsData.inputLatencyMs, statsData.inputLatencyAverageMs, statsData.pacingMode);
+    } else {
+        snprintf(buffer, sizeof(buffer), "Input to present: no sample  %s", statsData.pacingMode);
+    }
+    RenderHUDText(buffer, left, y, Vector3(1.0f, 1.0f, 1.0f));
+    CleanupTextRenderState();
+    
+    RestoreGameProjection();
+}
+
 void HUDRenderer::RenderTargetingLine(const HUDRenderData& hudData) {
     glPushMatrix();
     
-    glDisable(GL_LIGHTING);
-    glEnable(GL_COLOR_MATERIAL);
-    glDisable(GL_TEXTURE_2D);
+    GLStateCache::Get().Disable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_COLOR_MATERIAL);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
     
     // Set targeting line color
     ApplyColor(hudData.targetingColor);
@@ -220,14 +367,14 @@ void HUDRenderer::RenderHealthBar(const HUDRenderData& hudData)
     glEnd();
     
     // Health icon
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_ONE, GL_ONE);
     if (texturesLoaded) {
         float iconX = healthBarX - 0.04f;  // Position icon to the left of the bar
         RenderTexturedQuad(iconX, healthBarY, 0.03f, healthBarHeight, 
                           hudTextures[TEXTURE_HEALTH_ICON], Vector3(1.0f, 0.6f, 0.6f));
     }
-    glDisable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_BLEND);
 }
 
 void HUDRenderer::RenderEnergyBar(const HUDRenderData& hudData) {
@@ -258,15 +405,15 @@ void HUDRenderer::RenderEnergyBar(const HUDRenderData& hudData) {
     glVertex3f(energyBarX, energyBarY, 0);
     glEnd();
     
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_ONE, GL_ONE);
     // Energy icon
     if (texturesLoaded) {
         float iconX = energyBarX - 0.04f;  // Position icon to the left of the bar
         RenderTexturedQuad(iconX, energyBarY, 0.03f, energyBarHeight, 
                           hudTextures[TEXTURE_ENERGY_ICON], Vector3(0.6f, 0.6f, 1.0f));
     }
-    glDisable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_BLEND);
 }
 
 void HUDRenderer::RenderActionCostIndicators(const HUDRenderData& hudData) {
@@ -319,8 +466,8 @@ void HUDRenderer::RenderSpecialMeter(const HUDRenderData& hudData) {
     
     // Enable blending if special not available
     if (!hudData.hasSpecialAvailable) {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        GLStateCache::Get().Enable(GL_BLEND);
+        GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     }
     
     glBegin(GL_QUADS);
@@ -349,7 +496,7 @@ void HUDRenderer::RenderSpecialMeter(const HUDRenderData& hudData) {
     glEnd();
     
     if (!hudData.hasSpecialAvailable) {
-        glDisable(GL_BLEND);
+        GLStateCache::Get().Disable(GL_BLEND);
     }
 }
 
@@ -364,8 +511,8 @@ void HUDRenderer::RenderFPSCounter(const HUDRenderData& hudData) {
 
 void HUDRenderer::RenderMenuBackground(const MenuRenderData& menuData) {
     // Simple semi-transparent background
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     
     glBegin(GL_QUADS);
     ApplyColor(menuData.backgroundColor, menuData.fadeAlpha * 0.8f);
@@ -375,7 +522,7 @@ void HUDRenderer::RenderMenuBackground(const MenuRenderData& menuData) {
     glVertex3f(-1.0f, 1.0f, 0);
     glEnd();
     
-    glDisable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_BLEND);
 }
 
 void HUDRenderer::RenderMenuOptions(const MenuRenderData& menuData) {
@@ -420,11 +567,11 @@ void HUDRenderer::SetupHUDProjection() {
     glLoadIdentity();
     glTranslated(0, 0, -1);
     
-    glDisable(GL_DEPTH_TEST);
+    GLStateCache::Get().Disable(GL_DEPTH_TEST);
 }
 
 void HUDRenderer::RestoreGameProjection() {
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
     
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
@@ -434,29 +581,36 @@ void HUDRenderer::RestoreGameProjection() {
 }
 
 void HUDRenderer::SetupHUDRenderState() {
-    glDisable(GL_LIGHTING);
-    glEnable(GL_COLOR_MATERIAL);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // Use proper alpha blending instead of additive
-    glDisable(GL_CULL_FACE);  // Disable face culling for 2D HUD elements
+    GLStateCache::Get().Disable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_COLOR_MATERIAL);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  // Use proper alpha blending instead of additive
+    GLStateCache::Get().Disable(GL_CULL_FACE);  // Disable face culling for 2D HUD elements
 }
 
 void HUDRenderer::CleanupHUDRenderState() {
-    glDisable(GL_BLEND);
-    glDisable(GL_COLOR_MATERIAL);
-    glEnable(GL_LIGHTING);
-    glEnable(GL_CULL_FACE);  // Restore face culling
+    GLStateCache::Get().Disable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_COLOR_MATERIAL);
+    GLStateCache::Get().Enable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_CULL_FACE);  // Restore face culling
 }
 
 void HUDRenderer::SetupTextRenderState() {
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::Get().Disable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    
+    // HUD units stretch with the view; keep the glyphs' proportions
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    textAspect = viewport[2] > 0 ? static_cast<float>(viewport[3]) / viewport[2] : 1.0f;
 }
 
 void HUDRenderer::CleanupTextRenderState() {
-    glDisable(GL_BLEND);
-    glDisable(GL_TEXTURE_2D);
+    GLStateCache::Get().Disable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_LIGHTING);
 }
 
 void HUDRenderer::ApplyColor(const Vector3& color, float alpha) {
@@ -464,12 +618,12 @@ void HUDRenderer::ApplyColor(const Vector3& color, float alpha) {
 }
 
 void HUDRenderer::SetupStippledLine(float animationTime) {
-    glEnable(GL_LINE_STIPPLE);
+    GLStateCache::Get().Enable(GL_LINE_STIPPLE);
     glLineStipple(16, static_cast<int>(animationTime));
 }
 
 void HUDRenderer::CleanupStippledLine() {
-    glDisable(GL_LINE_STIPPLE);
+    GLStateCache::Get().Disable(GL_LINE_STIPPLE);
 }
 
 void HUDRenderer::RenderQuad(float x, float y, float width, float height, const Vector3& color) {
@@ -484,8 +638,8 @@ void HUDRenderer::RenderQuad(float x, float y, float width, float height, const
 
 void HUDRenderer::RenderTexturedQuad(float x, float y, float width, float height, 
                                     unsigned int textureId, const Vector3& color) {
-    glEnable(GL_TEXTURE_2D);
-    glBindTexture(GL_TEXTURE_2D, textureId);
+    GLStateCache::Get().Enable(GL_TEXTURE_2D);
+    GLStateCache::Get().BindTexture(textureId);
     
     glBegin(GL_QUADS);
     ApplyColor(color);
@@ -499,12 +653,91 @@ void HUDRenderer::RenderTexturedQuad(float x, float y, float width, float height
     glVertex3f(x, y, 0);
     glEnd();
     
-    glDisable(GL_TEXTURE_2D);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
 }
 
 void HUDRenderer::RenderHUDText(const char* text, float x, float y, const Vector3& color) {
-    // TODO: Implement when TextRenderer is available in Step 22
-    // For now, this is a placeholder
+    if (!fontTexture) {
+        return;
+    }
+    
+    // One quad per glyph from the atlas, the whole line in one batch;
+    // (x, y) is the bottom left corner of the line
+    const float width = TEXT_HEIGHT * glyphAspect * textAspect;
+    GLStateCache::Get().BindTexture(fontTexture);
+    glBegin(GL_QUADS);
+    ApplyColor(color);
+    for (const char* c = text; *c; c++, x += width) {
+        if (*c <= FIRST_GLYPH || *c > LAST_GLYPH) {
+            continue;   // Blank cell
+        }
+        const float u0 = (*c - FIRST_GLYPH) * glyphU;
+        const float u1 = u0 + glyphU;
+        glTexCoord2f(u0, 1);
+        glVertex3f(x, y, 0);
+        glTexCoord2f(u1, 1);
+        glVertex3f(x + width, y, 0);
+        glTexCoord2f(u1, 0);
+        glVertex3f(x + width, y + TEXT_HEIGHT, 0);
+        glTexCoord2f(u0, 0);
+        glVertex3f(x, y + TEXT_HEIGHT, 0);
+    }
+    glEnd();
+}
+
+bool HUDRenderer::LoadFontAtlas() {
+    if (!TTF_WasInit() && TTF_Init() != 0) {
+        Logger::Get().Write("HUDRenderer: SDL_ttf unavailable, HUD text disabled\n");
+        return false;
+    }
+    TTF_Font* font = TTF_OpenFont(HUD_FONT_PATH, HUD_FONT_POINTS);
+    if (!font) {
+        Logger::Get().Write("HUDRenderer: failed loading font %s, HUD text disabled\n", HUD_FONT_PATH);
+        return false;
+    }
+    
+    // The font is monospaced: with kerning off every glyph advances by the
+    // same amount, so glyph i sits in cell i of the rendered row
+    TTF_SetFontKerning(font, 0);
+    char glyphs[GLYPH_COUNT + 1];
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        glyphs[i] = static_cast<char>(FIRST_GLYPH + i);
+    }
+    glyphs[GLYPH_COUNT] = '\0';
+    int advance = 0;
+    TTF_GlyphMetrics(font, 'M', nullptr, nullptr, nullptr, nullptr, &advance);
+    const SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* surface = TTF_RenderText_Blended(font, glyphs, white);
+    TTF_CloseFont(font);
+    if (!surface || advance <= 0) {
+        Logger::Get().Write("HUDRenderer: failed rendering the HUD font atlas\n");
+        if (surface) {
+            SDL_FreeSurface(surface);
+        }
+        return false;
+    }
+    
+    // Blended text is 32-bit with coverage in alpha; the glyphs are white,
+    // so the colour channel order does not matter and glColor tints them
+    glGenTextures(1, &fontTexture);
+    GLStateCache::Get().BindTexture(fontTexture);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, surface->pitch / 4);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, surface->w, surface->h, 0, GL_RGBA, GL_UNSIGNED_BYTE, surface->pixels);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    
+    glyphU = static_cast<float>(advance) / surface->w;
+    glyphAspect = static_cast<float>(advance) / surface->h;
+    SDL_FreeSurface(surface);
+    return true;
+}
+
+void HUDRenderer::CleanupFontAtlas() {
+    if (fontTexture) {
+        glDeleteTextures(1, &fontTexture);
+        fontTexture = 0;
+    }
 }
 
 bool HUDRenderer::LoadHUDTextures() {
@@ -60,6 +60,13 @@ public:
      * @param debugData Debug rendering data
      */
     void RenderDebugInfo(const DebugRenderData& debugData);
+    
+    /**
+     * Render the frame stats overlay: frame-time graph with percentile
+     * marks, per-task time bar and counts
+     * @param statsData Frame stats rendering data
+     */
+    void RenderFrameStats(const FrameStatsRenderData& statsData);
 
 private:
     // Individual HUD element rendering methods
@@ -103,6 +110,11 @@ private:
     bool LoadHUDTextures();
     void CleanupHUDTextures();
     
+    // Font atlas for RenderHUDText: the printable ASCII range of the
+    // monospaced HUD font rendered once into a single row
+    bool LoadFontAtlas();
+    void CleanupFontAtlas();
+    
     // HUD texture IDs
     enum HUDTextures {
         TEXTURE_HEALTH_ICON = 0,
@@ -113,6 +125,11 @@ private:
     
     unsigned int hudTextures[TEXTURE_COUNT];
     bool texturesLoaded;
+    
+    unsigned int fontTexture;   // 0 while no atlas is loaded (text is then skipped)
+    float glyphU;               // Atlas width of one glyph cell, in texture units
+    float glyphAspect;          // Glyph cell width over height, in pixels
+    float textAspect;           // Viewport height over width, set by SetupTextRenderState
 };
 
 #endif // HUDRENDERER_H
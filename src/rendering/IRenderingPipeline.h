@@ -0,0 +1,88 @@
+#pragma once
+
+#include "IRenderer.h"
+#include "RenderData.h"
+#include "../profiling/GLCounters.h"
+
+/**
+ * Contract of a complete rendering backend, as driven by GraphicsTask.
+ *
+ * RenderingPipeline implements it with the fixed-function renderers;
+ * CoreRenderingPipeline with shaders and retained buffers on a core-profile
+ * context. Both consume the same SceneData, so the choice between them is
+ * made once at startup and nothing upstream of the renderer changes.
+ */
+class IRenderingPipeline : public IRenderer {
+public:
+    static const int MAX_VIEWS = 4;
+    static_assert(MAX_VIEWS == GLCounters::MAX_VIEWS, "GL counters are kept for every view");
+
+    /**
+     * Frustum culling results of one view.
+     */
+    struct ViewStats {
+        int objectsVisible;     // Tanks, bullets, effects and items inside the frustum
+        int objectsTotal;
+        int chunksVisible;      // Terrain chunks inside the frustum
+        int chunksTotal;
+        GLCallCounts glCalls;   // World and HUD of the view (profiling builds)
+    };
+
+    /**
+     * Rendering statistics of the last frame.
+     * Useful for performance monitoring and debugging.
+     */
+    struct RenderStats {
+        int tanksRendered;
+        int bulletsRendered;
+        int effectsRendered;
+        int itemsRendered;
+        float renderTime;
+        int objectsDrawn;       // Last RenderAllPlayerViews, all views
+        int packetsDrawn;       // Render queue packets, all views
+        int glStateIssued;      // GLStateCache calls that reached GL, all views
+        int glStateElided;      // GLStateCache calls skipped as no-ops, all views
+        float resolutionScale;  // Scene render target scale of the last frame, 1 at window size
+        int viewCount;          // Views rendered by the last RenderAllPlayerViews
+        ViewStats views[MAX_VIEWS];
+        GLCallCounts glCalls;   // Whole frame, views and window-wide passes (profiling builds)
+        GLCallCounts rendererGLCalls[static_cast<int>(RenderSource::COUNT)];    // Indexed by RenderSource
+    };
+
+    virtual ~IRenderingPipeline() = default;
+
+    /**
+     * Renders scenes for all players (split-screen support).
+     *
+     * @param scene Complete scene data containing all objects to render
+     */
+    virtual void RenderAllPlayerViews(const SceneData& scene) = 0;
+
+    /**
+     * Configure viewports for the given number of players.
+     *
+     * @param numPlayers Number of active players (1 to 4)
+     * @param screenWidth Screen width in pixels
+     * @param screenHeight Screen height in pixels
+     */
+    virtual void ConfigureViewports(int numPlayers, int screenWidth, int screenHeight) = 0;
+
+    virtual const RenderStats& GetRenderStats() const = 0;
+
+protected:
+    // Copies the frame's GL call counts into stats and closes the frame
+    static void EndGLCounterFrame(RenderStats& stats)
+    {
+        GLCounters& counters = GLCounters::Get();
+        stats.glCalls = counters.GetFrame();
+        for (int i = 0; i < MAX_VIEWS; ++i)
+        {
+            stats.views[i].glCalls = counters.GetView(i);
+        }
+        for (int i = 0; i < static_cast<int>(RenderSource::COUNT); ++i)
+        {
+            stats.rendererGLCalls[i] = counters.GetSource(static_cast<RenderSource>(i));
+        }
+        counters.EndFrame();
+    }
+};
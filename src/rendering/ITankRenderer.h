@@ -1,6 +1,8 @@
 #pragma once
 
 #include "RenderData.h"
+#include "RenderQueue.h"
+#include "RenderList.h"
 #include <vector>
 
 /**
@@ -49,7 +51,7 @@ public:
      * 
      * @param tanks Vector of TankRenderData for all tanks to render
      */
-    virtual void RenderMultiple(const std::vector<TankRenderData>& tanks) {
+    virtual void RenderMultiple(const FrameVector<TankRenderData>& tanks) {
         for (const auto& tank : tanks) {
             if (tank.alive) {
                 Render(tank);
@@ -57,6 +59,26 @@ public:
         }
     }
     
+    // Radius of a sphere around the tank origin that holds the whole model
+    static constexpr float BOUNDING_RADIUS = 2.0f;
+
+    static bool IsVisible(const TankRenderData& tank, const Frustum& frustum) {
+        return tank.alive && frustum.IntersectsSphere(tank.position, BOUNDING_RADIUS);
+    }
+    
+    /**
+     * Adds the tanks to the frame's render list instead of drawing them.
+     * The tanks must stay alive until the last view has executed.
+     * 
+     * @return false if this renderer does not queue; the caller then
+     *         draws the visible tanks with RenderMultiple() in every view
+     */
+    virtual bool Prepare(const FrameVector<TankRenderData>& tanks, RenderList& list) {
+        (void)tanks;
+        (void)list;
+        return false;
+    }
+    
     /**
      * Set up OpenGL render state for tank rendering.
      * Called before rendering tanks, allows renderer to configure
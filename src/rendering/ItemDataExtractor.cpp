@@ -4,29 +4,48 @@ ItemRenderData ItemDataExtractor::ExtractRenderData(const Item& item) {
     ItemRenderData data;
     
     // Extract position
-    data.position = Vector3(item.x, item.y, item.z);
+    data.position = Vector3(item.GetX(), item.GetY(), item.GetZ());
     
     // Extract item type for mesh selection
-    data.itemType = item.type;
+    data.itemType = item.GetType();
     
     // Extract rotation for spinning animation
-    data.rotationY = item.ry;
+    data.rotationY = item.GetRY();
     
     // Set visibility based on alive status
-    data.visible = item.alive;
+    data.visible = item.IsAlive();
     
     return data;
 }
 
-std::vector<ItemRenderData> ItemDataExtractor::ExtractRenderData(const std::vector<Item>& items) {
-    std::vector<ItemRenderData> renderData;
-    renderData.reserve(items.size());
-    
-    for (const auto& item : items) {
-        if (item.alive) {
-            renderData.push_back(ExtractRenderData(item));
-        }
+namespace {
+    template<typename Vector>
+    void AppendRenderData(const ArchetypeRegistry& registry, Vector& renderData) {
+        renderData.reserve(renderData.size() + registry.Count<Position, Rotation, ItemPickup>());
+        
+        registry.ForEachChunk<Position, Rotation, ItemPickup>(
+            [&renderData](size_t count, const Position* position, const Rotation* rotation, const ItemPickup* pickup) {
+                for (size_t i = 0; i < count; i++) {
+                    if (pickup[i].collected) {
+                        continue;
+                    }
+                    ItemRenderData data;
+                    data.position = Vector3(position[i].x, position[i].y, position[i].z);
+                    data.rotationY = rotation[i].ry; // Use only Y rotation for spinning
+                    data.itemType = pickup[i].type;
+                    data.visible = true;
+                    renderData.push_back(data);
+                }
+            });
     }
-    
+}
+
+std::vector<ItemRenderData> ItemDataExtractor::ExtractRenderData(const ArchetypeRegistry& registry) {
+    std::vector<ItemRenderData> renderData;
+    AppendRenderData(registry, renderData);
     return renderData;
 }
+
+void ItemDataExtractor::ExtractRenderData(const ArchetypeRegistry& registry, FrameVector<ItemRenderData>& renderData) {
+    AppendRenderData(registry, renderData);
+}
@@ -18,10 +18,18 @@ public:
     static ItemRenderData ExtractRenderData(const Item& item);
     
     /**
-     * Extracts rendering data from a collection of Item objects.
-     * Only extracts data from alive items.
-     * @param items Vector of Item objects to process
+     * Extracts rendering data for every item in a registry, reading the
+     * Position, Rotation and ItemPickup columns directly.
+     * Only extracts data from items not yet picked up.
+     * @param registry Component storage holding the items
      * @return Vector of ItemRenderData structures for rendering
      */
-    static std::vector<ItemRenderData> ExtractRenderData(const std::vector<Item>& items);
+    static std::vector<ItemRenderData> ExtractRenderData(const ArchetypeRegistry& registry);
+    
+    /**
+     * As above, appending to a per-frame vector.
+     * @param registry Component storage holding the items
+     * @param renderData Vector the ItemRenderData is appended to
+     */
+    static void ExtractRenderData(const ArchetypeRegistry& registry, FrameVector<ItemRenderData>& renderData);
 };
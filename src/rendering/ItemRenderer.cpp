@@ -9,6 +9,12 @@
 
 #include "ItemRenderer.h"
 #include "../App.h"
+#include "GLProfile.h"
+
+namespace {
+    // Holds the spinning power-up model
+    const float BOUNDING_RADIUS = 1.0f;
+}
 
 ItemRenderer::ItemRenderer() {
     // Constructor - base class handles initialization
@@ -18,17 +24,17 @@ void ItemRenderer::SetupRenderState() {
     BaseRenderer::SetupRenderState();
     
     // Set up OpenGL state for item rendering
-    glFrontFace(GL_CCW);
+    GLStateCache::Get().FrontFace(GL_CCW);
 }
 
 void ItemRenderer::CleanupRenderState() {
     // Restore OpenGL state
-    glFrontFace(GL_CW);
+    GLStateCache::Get().FrontFace(GL_CW);
     
     BaseRenderer::CleanupRenderState();
 }
 
-void ItemRenderer::RenderItems(const std::vector<ItemRenderData>& items) {
+void ItemRenderer::RenderItems(const FrameVector<ItemRenderData>& items) {
     if (items.empty()) {
         return;
     }
@@ -66,6 +72,23 @@ void ItemRenderer::RenderItem(const ItemRenderData& item) {
     glPopMatrix();
 }
 
+void ItemRenderer::Prepare(const FrameVector<ItemRenderData>& items, RenderList& list) {
+    submittedItems = &items;
+    for (size_t i = 0; i < items.size(); i++) {
+        const ItemRenderData& item = items[i];
+        if (!item.visible) {
+            continue;
+        }
+        list.BeginObject(item.position, BOUNDING_RADIUS);
+        list.Add(RenderLayer::OPAQUE, DrawState::LIT_CCW, 0, static_cast<uint32_t>(item.itemType),
+                 this, static_cast<uint32_t>(i));
+    }
+}
+
+void ItemRenderer::DrawPacket(uint32_t item) {
+    RenderItem((*submittedItems)[item]);
+}
+
 void ItemRenderer::SetItemColor(TankType itemType) {
     // Set color based on item type (same logic as Item constructor)
     switch (itemType) {
@@ -2,13 +2,15 @@
 
 #include "BaseRenderer.h"
 #include "RenderData.h"
+#include "RenderQueue.h"
+#include "RenderList.h"
 #include <vector>
 
 /**
  * Handles rendering of all game items (power-ups).
  * Follows the new rendering architecture by accepting render data instead of game objects.
  */
-class ItemRenderer : public BaseRenderer {
+class ItemRenderer : public BaseRenderer, public IQueuedRenderer {
 public:
     ItemRenderer();
     virtual ~ItemRenderer() = default;
@@ -17,13 +19,21 @@ public:
      * Renders all items using the provided render data.
      * @param items Vector of ItemRenderData containing all necessary rendering information
      */
-    void RenderItems(const std::vector<ItemRenderData>& items);
+    void RenderItems(const FrameVector<ItemRenderData>& items);
     
     /**
      * Renders a single item using the provided render data.
      * @param item ItemRenderData containing rendering information for one item
      */
     void RenderItem(const ItemRenderData& item);
+
+    /**
+     * Adds one opaque packet per visible item to the frame's render list.
+     * The items must stay alive until the last view has executed.
+     */
+    void Prepare(const FrameVector<ItemRenderData>& items, RenderList& list);
+    void DrawPacket(uint32_t item) override;
+    RenderSource GetRenderSource() const override { return RenderSource::ITEMS; }
     
 protected:
     void SetupRenderState() override;
@@ -35,4 +45,6 @@ private:
      * @param itemType The type of item/power-up
      */
     void SetItemColor(TankType itemType);
+
+    const FrameVector<ItemRenderData>* submittedItems = nullptr;
 };
@@ -13,6 +13,11 @@
 #include <GL/glu.h>
 #endif
 
+#include "GLProfile.h"
+
+constexpr float MenuRenderer::SELECTED_LINE_COLOR[3];
+constexpr float MenuRenderer::SELECTED_FILL_COLOR[4];
+
 MenuRenderer::MenuRenderer() {
 }
 
@@ -47,27 +52,27 @@ void MenuRenderer::RenderMenu(const MenuRenderData& menuData) {
 
 void MenuRenderer::SetupMenuProjection() {
     glLoadIdentity();
-    glDisable(GL_DEPTH_TEST);
+    GLStateCache::Get().Disable(GL_DEPTH_TEST);
     // Treat 3D like 2D (matching original implementation)
     glTranslated(0, 0, -1);
 }
 
 void MenuRenderer::RestoreGameProjection() {
-    glEnable(GL_DEPTH_TEST);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
 }
 
 void MenuRenderer::SetupMenuRenderState() {
     glPushMatrix();
-    glDisable(GL_LIGHTING);
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
+    GLStateCache::Get().Disable(GL_LIGHTING);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_ONE, GL_ONE);
 }
 
 void MenuRenderer::CleanupMenuRenderState() {
     glPopMatrix();
-    glEnable(GL_LIGHTING);
-    glDisable(GL_BLEND);
+    GLStateCache::Get().Enable(GL_LIGHTING);
+    GLStateCache::Get().Disable(GL_BLEND);
 }
 
 void MenuRenderer::RenderMenuBackground(const MenuRenderData& menuData) {
@@ -31,6 +31,15 @@ public:
      */
     void RenderMenu(const MenuRenderData& menuData);
 
+    /**
+     * Menu-space rectangle of an option (shared with the core-profile backend)
+     */
+    static void GetOptionPosition(int optionIndex, float& x, float& y, float& width, float& height);
+
+    // Menu colors (from original code)
+    static constexpr float SELECTED_LINE_COLOR[3] = {0.0f, 1.0f, 1.0f}; // Cyan
+    static constexpr float SELECTED_FILL_COLOR[4] = {0.0f, 0.4f, 0.4f, 0.1f}; // Semi-transparent cyan
+
 private:
     // Menu rendering methods
     void SetupMenuProjection();
@@ -45,7 +54,6 @@ private:
     void RenderNormalOption(int optionIndex, const MenuRenderData& menuData);
     
     // Utility methods
-    void GetOptionPosition(int optionIndex, float& x, float& y, float& width, float& height);
     void ApplyColor(const Vector3& color, float alpha = 1.0f);
     void RenderOptionQuad(float x, float y, float width, float height, 
                          const Vector3& color, float alpha, bool filled = true);
@@ -56,10 +64,6 @@ private:
     static constexpr float MENU_OPTION_SPACING = 0.10f;   // Vertical spacing between options
     static constexpr float MENU_START_X = -0.52f;         // 0.03f - 0.55f from original
     static constexpr float MENU_START_Y = -0.19f;         // -0.06f - 0.13f from original
-    
-    // Menu colors (from original code)
-    static constexpr float SELECTED_LINE_COLOR[3] = {0.0f, 1.0f, 1.0f}; // Cyan
-    static constexpr float SELECTED_FILL_COLOR[4] = {0.0f, 0.4f, 0.4f, 0.1f}; // Semi-transparent cyan
 };
 
 #endif // MENURENDERER_H
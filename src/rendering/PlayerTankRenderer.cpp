@@ -1,7 +1,9 @@
 #include "PlayerTankRenderer.h"
+#include "GLStateCache.h"
 #include "../Tank.h"
 #include "../App.h"
 #include "../GlobalTimer.h"
+#include "GLProfile.h"
 
 void PlayerTankRenderer::DrawPlayerTanks(const std::array<Tank, TankHandler::MAX_PLAYERS>& players,
                                         const std::array<float, TankHandler::MAX_PLAYERS>& special,
@@ -53,7 +55,7 @@ void PlayerTankRenderer::DrawPlayerEffects(const Tank& player,
     glTranslatef(TEXTURE_DRIFT_SPEED * drift, 0, 0);
     glMatrixMode(GL_MODELVIEW);
 
-    glBindTexture(GL_TEXTURE_2D, App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[17]);
+    GLStateCache::Get().BindTexture(App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[17]);
     Color primaryColor = player.GetPrimaryColor();
     glColor3f(primaryColor.r, primaryColor.g, primaryColor.b);
 
@@ -66,7 +68,7 @@ void PlayerTankRenderer::DrawPlayerEffects(const Tank& player,
     glPopMatrix();
     glMatrixMode(GL_MODELVIEW);
 
-    glDepthMask(GL_TRUE);
+    GLStateCache::Get().DepthMask(GL_TRUE);
     glPopMatrix();
 }
 
@@ -80,7 +82,7 @@ void PlayerTankRenderer::DrawTargetingUI(const Tank& player, float drift)
 
     RenderTargetingIndicator(player);
     
-    if (player.fireTimer > player.fireRate && player.fireCost < player.energy)
+    if (player.fireTimer > player.fireRate && player.Cold().fireCost < player.energy)
     {
         RenderReadyIndicator(player, drift);
     }
@@ -95,42 +97,42 @@ void PlayerTankRenderer::DrawTargetingUI(const Tank& player, float drift)
 
 void PlayerTankRenderer::SetupPlayerTankRenderState()
 {
-    glDisable(GL_TEXTURE_2D);
-    glEnable(GL_LIGHTING);
-    glEnable(GL_COLOR_MATERIAL);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_COLOR_MATERIAL);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().DepthMask(GL_TRUE);
+    GLStateCache::Get().DepthFunc(GL_LESS);
 }
 
 void PlayerTankRenderer::SetupPlayerEffectsRenderState()
 {
     glPushMatrix();
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
-    glDepthFunc(GL_LEQUAL);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    GLStateCache::Get().Enable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().DepthMask(GL_FALSE);
+    GLStateCache::Get().DepthFunc(GL_LEQUAL);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
 }
 
 void PlayerTankRenderer::SetupTargetingUIRenderState()
 {
-    glDisable(GL_LIGHTING);
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    glDepthMask(GL_FALSE);
+    GLStateCache::Get().Disable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
+    GLStateCache::Get().DepthMask(GL_FALSE);
 }
 
 void PlayerTankRenderer::RestoreRenderState()
 {
-    glDisable(GL_BLEND);
-    glDisable(GL_TEXTURE_2D);
-    glDepthMask(GL_TRUE);
-    glEnable(GL_CULL_FACE);
-    glEnable(GL_LIGHTING);
+    GLStateCache::Get().Disable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
+    GLStateCache::Get().DepthMask(GL_TRUE);
+    GLStateCache::Get().Enable(GL_CULL_FACE);
+    GLStateCache::Get().Enable(GL_LIGHTING);
 }
 
 void PlayerTankRenderer::RenderTankBody(const Tank& player)
@@ -141,7 +143,7 @@ void PlayerTankRenderer::RenderTankBody(const Tank& player)
     glRotatef(-player.ry - 90, 0, 1, 0);
     glRotatef(player.rz, 0, 0, 1);
 
-    glFrontFace(GL_CCW);
+    GLStateCache::Get().FrontFace(GL_CCW);
     Color secondaryColor = player.GetSecondaryColor();
     glColor3f(secondaryColor.r, secondaryColor.g, secondaryColor.b);
     App::GetSingleton().graphicsTask->bodylist.Call(0);
@@ -159,19 +161,19 @@ void PlayerTankRenderer::RenderTankTurret(const Tank& player)
     glColor3f(primaryColor.r, primaryColor.g, primaryColor.b);
     App::GetSingleton().graphicsTask->turretlist.Call(0);
 
-    glFrontFace(GL_CW);
+    GLStateCache::Get().FrontFace(GL_CW);
     glPopMatrix();
 }
 
 void PlayerTankRenderer::RenderEffectBody(const Tank& player)
 {
-    glDisable(GL_LIGHTING);
+    GLStateCache::Get().Disable(GL_LIGHTING);
     glTranslatef(player.x, player.y + TANK_HEIGHT_OFFSET, player.z);
     glRotatef(player.rx, 1, 0, 0);
     glRotatef(-player.ry - 90, 0, 1, 0);
     glRotatef(player.rz, 0, 0, 1);
 
-    glFrontFace(GL_CCW);
+    GLStateCache::Get().FrontFace(GL_CCW);
     App::GetSingleton().graphicsTask->bodylist.Call(0);
 }
 
@@ -188,17 +190,17 @@ void PlayerTankRenderer::RenderEffectTurret(const Tank& player,
     Color secondaryColor = player.GetSecondaryColor();
     glColor3f(secondaryColor.r, secondaryColor.g, secondaryColor.b);
 
-    if (special[playerIndex] >= player.fireCost / SPECIAL_CHARGE_THRESHOLD_DIVISOR)
+    if (special[playerIndex] >= player.Cold().fireCost / SPECIAL_CHARGE_THRESHOLD_DIVISOR)
     {
         App::GetSingleton().graphicsTask->turretlist.Call(0);
     }
 
-    glFrontFace(GL_CW);
+    GLStateCache::Get().FrontFace(GL_CW);
 }
 
 void PlayerTankRenderer::RenderTargetingIndicator(const Tank& player)
 {
-    glBindTexture(GL_TEXTURE_2D, App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[20]);
+    GLStateCache::Get().BindTexture(App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[20]);
     glColor4f(1.0f, player.dist / DISTANCE_COLOR_FACTOR, 0.1f, 1.0);
     App::GetSingleton().graphicsTask->squarelist.Call(0);
 }
@@ -208,7 +210,7 @@ void PlayerTankRenderer::RenderReadyIndicator(const Tank& player, float drift)
     glTranslatef(0, +TARGETING_EFFECT_OFFSET, 0);
     glRotatef(ROTATION_EFFECT_SPEED * drift, 0, 1, 0);
 
-    glBindTexture(GL_TEXTURE_2D, App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[17]);
+    GLStateCache::Get().BindTexture(App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[17]);
     glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 
     glScalef(EFFECT_SCALE_FACTOR, EFFECT_SCALE_FACTOR, EFFECT_SCALE_FACTOR);
@@ -240,7 +242,7 @@ void PlayerTankRenderer::RenderPlayerEffects(const TankRenderData& tank, float d
     glTranslatef(TEXTURE_DRIFT_SPEED * drift, 0, 0);
     glMatrixMode(GL_MODELVIEW);
 
-    glBindTexture(GL_TEXTURE_2D, App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[17]);
+    GLStateCache::Get().BindTexture(App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[17]);
     glColor3f(tank.primaryColor.r, tank.primaryColor.g, tank.primaryColor.b);
 
     glPushMatrix();
@@ -252,7 +254,7 @@ void PlayerTankRenderer::RenderPlayerEffects(const TankRenderData& tank, float d
     glPopMatrix();
     glMatrixMode(GL_MODELVIEW);
 
-    glDepthMask(GL_TRUE);
+    GLStateCache::Get().DepthMask(GL_TRUE);
     glPopMatrix();
 }
 
@@ -289,7 +291,7 @@ void PlayerTankRenderer::RenderTankBody(const TankRenderData& tank)
     glRotatef(-tank.bodyRotation.y - 90, 0, 1, 0);
     glRotatef(tank.bodyRotation.z, 0, 0, 1);
 
-    glFrontFace(GL_CCW);
+    GLStateCache::Get().FrontFace(GL_CCW);
     glColor3f(tank.secondaryColor.r, tank.secondaryColor.g, tank.secondaryColor.b);
     App::GetSingleton().graphicsTask->bodylist.Call(0);
 }
@@ -305,19 +307,19 @@ void PlayerTankRenderer::RenderTankTurret(const TankRenderData& tank)
     glColor3f(tank.primaryColor.r, tank.primaryColor.g, tank.primaryColor.b);
     App::GetSingleton().graphicsTask->turretlist.Call(0);
 
-    glFrontFace(GL_CW);
+    GLStateCache::Get().FrontFace(GL_CW);
     glPopMatrix();
 }
 
 void PlayerTankRenderer::RenderEffectBody(const TankRenderData& tank)
 {
-    glDisable(GL_LIGHTING);
+    GLStateCache::Get().Disable(GL_LIGHTING);
     glTranslatef(tank.position.x, tank.position.y + TANK_HEIGHT_OFFSET, tank.position.z);
     glRotatef(tank.bodyRotation.x, 1, 0, 0);
     glRotatef(-tank.bodyRotation.y - 90, 0, 1, 0);
     glRotatef(tank.bodyRotation.z, 0, 0, 1);
 
-    glFrontFace(GL_CCW);
+    GLStateCache::Get().FrontFace(GL_CCW);
     App::GetSingleton().graphicsTask->bodylist.Call(0);
 }
 
@@ -336,12 +338,12 @@ void PlayerTankRenderer::RenderEffectTurret(const TankRenderData& tank)
         App::GetSingleton().graphicsTask->turretlist.Call(0);
     }
 
-    glFrontFace(GL_CW);
+    GLStateCache::Get().FrontFace(GL_CW);
 }
 
 void PlayerTankRenderer::RenderTargetingIndicator(const TankRenderData& tank)
 {
-    glBindTexture(GL_TEXTURE_2D, App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[20]);
+    GLStateCache::Get().BindTexture(App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[20]);
     glColor4f(1.0f, tank.health / 50.0f, 0.1f, 1.0); // Use health as distance approximation
     App::GetSingleton().graphicsTask->squarelist.Call(0);
 }
@@ -351,7 +353,7 @@ void PlayerTankRenderer::RenderReadyIndicator(const TankRenderData& tank, float
     glTranslatef(0, +TARGETING_EFFECT_OFFSET, 0);
     glRotatef(ROTATION_EFFECT_SPEED * drift, 0, 1, 0);
 
-    glBindTexture(GL_TEXTURE_2D, App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[17]);
+    GLStateCache::Get().BindTexture(App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[17]);
     glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
 
     glScalef(EFFECT_SCALE_FACTOR, EFFECT_SCALE_FACTOR, EFFECT_SCALE_FACTOR);
@@ -64,33 +64,33 @@ void PlayerTankRendererImpl::RenderTargetingUI(const TankRenderData& tank, bool
 
 void PlayerTankRendererImpl::SetupPlayerTankRenderState() {
     // Standard player tank rendering state
-    glEnable(GL_LIGHTING);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
-    glDisable(GL_BLEND);
-    glDisable(GL_TEXTURE_2D);
-    glFrontFace(GL_CW);
+    GLStateCache::Get().Enable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().DepthMask(GL_TRUE);
+    GLStateCache::Get().DepthFunc(GL_LESS);
+    GLStateCache::Get().Disable(GL_BLEND);
+    GLStateCache::Get().Disable(GL_TEXTURE_2D);
+    GLStateCache::Get().FrontFace(GL_CW);
 }
 
 void PlayerTankRendererImpl::SetupPlayerEffectsRenderState() {
     // Effects rendering state (from PlayerTankRenderer)
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_FALSE);
-    glDepthFunc(GL_LEQUAL);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    GLStateCache::Get().Enable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().DepthMask(GL_FALSE);
+    GLStateCache::Get().DepthFunc(GL_LEQUAL);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
 }
 
 void PlayerTankRendererImpl::SetupTargetingUIRenderState() {
     // Targeting UI rendering state (from PlayerTankRenderer)
-    glDisable(GL_LIGHTING);
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    glDepthMask(GL_FALSE);
+    GLStateCache::Get().Disable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_TEXTURE_2D);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
+    GLStateCache::Get().DepthMask(GL_FALSE);
 }
 
 // TODO: Implement individual rendering methods when fully separating from static PlayerTankRenderer
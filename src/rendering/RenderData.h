@@ -9,6 +9,7 @@
 #include "../Tank.h"
 // Include FX.h for FxType enum
 #include "../FX.h"
+#include "../memory/FrameArena.h"
 
 // Forward declaration for UI data
 struct UIRenderData;
@@ -256,20 +257,20 @@ struct CameraData {
  * This structure separates rendering data from game logic
  */
 struct SceneData {
-    // Renderable objects
-    std::vector<TankRenderData> tanks;
-    std::vector<BulletRenderData> bullets;
-    std::vector<EffectRenderData> effects;
-    std::vector<ItemRenderData> items;
+    // Renderable objects (in the builder's frame arena)
+    FrameVector<TankRenderData> tanks;
+    FrameVector<BulletRenderData> bullets;
+    FrameVector<EffectRenderData> effects;
+    FrameVector<ItemRenderData> items;
     TerrainRenderData terrain;
     
     // Sky rendering (special case for level 48)
     bool drawSky;
     
     // Camera information for split-screen rendering
-    std::vector<CameraData> cameras;
+    FrameVector<CameraData> cameras;
     
-    // UI rendering data (menus, HUD, debug info)
+    // UI rendering data (menus, HUD, debug info); owned by the frame arena
     UIRenderData* uiData;           // Pointer to avoid circular includes
     
     // Game state needed for rendering decisions
@@ -279,9 +280,14 @@ struct SceneData {
     bool versusMode;            // Whether in versus mode
     bool debugMode;             // Whether to show debug info (FPS, etc.)
     
-    // Constructor with defaults
-    SceneData()
-        : drawSky(false)
+    // Constructor with defaults; without an arena the vectors use the heap
+    explicit SceneData(FrameArena* arena = nullptr)
+        : tanks(ArenaAllocator<TankRenderData>(arena))
+        , bullets(ArenaAllocator<BulletRenderData>(arena))
+        , effects(ArenaAllocator<EffectRenderData>(arena))
+        , items(ArenaAllocator<ItemRenderData>(arena))
+        , drawSky(false)
+        , cameras(ArenaAllocator<CameraData>(arena))
         , uiData(nullptr)
         , numPlayers(1)
         , gameStarted(false)
@@ -289,7 +295,7 @@ struct SceneData {
         , versusMode(false)
         , debugMode(false)
     {
-        cameras.reserve(2);  // Reserve space for up to 2 player cameras
+        cameras.reserve(4);  // Reserve space for up to 4 player cameras
         tanks.reserve(10);   // Reserve reasonable space for tanks
         bullets.reserve(50); // Reserve space for bullets
         effects.reserve(20); // Reserve space for effects
@@ -0,0 +1,37 @@
+#include "RenderList.h"
+#include <cassert>
+
+void RenderList::Clear() {
+    objects.clear();
+    packets.clear();
+}
+
+void RenderList::BeginObject(const Vector3& center, float radius) {
+    Object object = { center, radius, static_cast<uint32_t>(packets.size()), 0 };
+    objects.push_back(object);
+}
+
+void RenderList::Add(RenderLayer layer, DrawState state, uint32_t texture, uint32_t material,
+                     IQueuedRenderer* drawer, uint32_t item) {
+    assert(!objects.empty());
+    RenderQueue::Packet packet = { RenderQueue::MakeKey(layer, state, texture, 0.0f, material), drawer, item };
+    packets.push_back(packet);
+    objects.back().packetCount++;
+}
+
+int RenderList::Submit(RenderQueue& queue, const Vector3& eye, const Frustum& frustum) const {
+    int queued = 0;
+    for (const Object& object : objects) {
+        if (!frustum.IntersectsSphere(object.center, object.radius)) {
+            continue;
+        }
+        queued++;
+
+        const float distance = RenderQueue::Distance(eye, object.center.x, object.center.y, object.center.z);
+        for (uint32_t i = object.firstPacket; i < object.firstPacket + object.packetCount; i++) {
+            const RenderQueue::Packet& packet = packets[i];
+            queue.Submit(RenderQueue::SetDistance(packet.key, distance), packet.drawer, packet.item);
+        }
+    }
+    return queued;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "RenderQueue.h"
+#include "Frustum.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * The packets of a frame's objects, built once and queued by every view.
+ *
+ * An object is a bounding sphere and the packets added after it. Layer,
+ * state, texture and material are worked out when the list is built; a
+ * view only tests the spheres against its frustum and fills in the depth
+ * of the packets it keeps. Items refer to the drawers' own data, which
+ * must stay alive until the last view has executed.
+ */
+class RenderList {
+public:
+    void Clear();
+
+    // Packets added until the next BeginObject belong to this object
+    void BeginObject(const Vector3& center, float radius);
+    void Add(RenderLayer layer, DrawState state, uint32_t texture, uint32_t material,
+             IQueuedRenderer* drawer, uint32_t item);
+
+    // Queue the packets of the objects inside the frustum, sorted by their
+    // distance from the eye. Returns the number of objects queued.
+    int Submit(RenderQueue& queue, const Vector3& eye, const Frustum& frustum) const;
+
+    int GetObjectCount() const { return static_cast<int>(objects.size()); }
+
+private:
+    struct Object {
+        Vector3 center;
+        float radius;
+        uint32_t firstPacket;
+        uint32_t packetCount;
+    };
+
+    // Kept across frames to reuse capacity; keys are made at distance 0
+    std::vector<Object> objects;
+    std::vector<RenderQueue::Packet> packets;
+};
@@ -0,0 +1,190 @@
+#include "RenderQueue.h"
+#include "GLStateCache.h"
+#include <algorithm>
+#include <cmath>
+
+const float RenderQueue::MAX_DEPTH = 1024.0f;
+
+namespace {
+    const uint64_t DEPTH_MASK = (1ull << RenderQueue::DEPTH_BITS) - 1;
+    const uint64_t TEXTURE_MASK = (1ull << RenderQueue::TEXTURE_BITS) - 1;
+    const uint64_t MATERIAL_MASK = (1ull << RenderQueue::MATERIAL_BITS) - 1;
+
+    // Bit offsets of the fields, see RenderQueue.h
+    const int LAYER_SHIFT = 60;
+    const int OPAQUE_STATE_SHIFT = 56;
+    const int OPAQUE_TEXTURE_SHIFT = 44;
+    const int OPAQUE_DEPTH_SHIFT = 20;
+    const int BLENDED_DEPTH_SHIFT = 36;
+    const int BLENDED_STATE_SHIFT = 32;
+    const int BLENDED_TEXTURE_SHIFT = 20;
+
+    struct StateDesc {
+        bool cull;
+        bool frontFaceCCW;
+        bool additive;
+    };
+
+    const StateDesc STATE_DESCS[] = {
+        { true,  false, false },    // LIT
+        { true,  true,  false },    // LIT_CCW
+        { false, false, false },    // UNCULLED
+        { true,  false, true  },    // ADDITIVE_CULLED
+        { false, false, true  },    // ADDITIVE
+        { true,  false, false },    // CUSTOM (not applied)
+    };
+
+    uint64_t QuantizeDepth(float distance) {
+        if (!(distance > 0.0f)) {
+            return 0;
+        }
+        if (distance >= RenderQueue::MAX_DEPTH) {
+            return DEPTH_MASK;
+        }
+        return static_cast<uint64_t>(distance / RenderQueue::MAX_DEPTH * DEPTH_MASK);
+    }
+}
+
+uint64_t RenderQueue::MakeKey(RenderLayer layer, DrawState state, uint32_t texture, float distance, uint32_t material) {
+    const uint64_t depth = QuantizeDepth(distance);
+    uint64_t key = static_cast<uint64_t>(layer) << LAYER_SHIFT;
+    key |= material & MATERIAL_MASK;
+
+    if (layer == RenderLayer::OPAQUE) {
+        key |= static_cast<uint64_t>(state) << OPAQUE_STATE_SHIFT;
+        key |= (texture & TEXTURE_MASK) << OPAQUE_TEXTURE_SHIFT;
+        key |= depth << OPAQUE_DEPTH_SHIFT;
+    } else {
+        key |= (DEPTH_MASK - depth) << BLENDED_DEPTH_SHIFT;
+        key |= static_cast<uint64_t>(state) << BLENDED_STATE_SHIFT;
+        key |= (texture & TEXTURE_MASK) << BLENDED_TEXTURE_SHIFT;
+    }
+    return key;
+}
+
+uint64_t RenderQueue::SetDistance(uint64_t key, float distance) {
+    const uint64_t depth = QuantizeDepth(distance);
+    if (GetLayer(key) == RenderLayer::OPAQUE) {
+        return (key & ~(DEPTH_MASK << OPAQUE_DEPTH_SHIFT)) | depth << OPAQUE_DEPTH_SHIFT;
+    }
+    return (key & ~(DEPTH_MASK << BLENDED_DEPTH_SHIFT)) | (DEPTH_MASK - depth) << BLENDED_DEPTH_SHIFT;
+}
+
+DrawState RenderQueue::GetState(uint64_t key) {
+    const int shift = GetLayer(key) == RenderLayer::OPAQUE ? OPAQUE_STATE_SHIFT : BLENDED_STATE_SHIFT;
+    return static_cast<DrawState>((key >> shift) & 0xF);
+}
+
+uint32_t RenderQueue::GetTexture(uint64_t key) {
+    const int shift = GetLayer(key) == RenderLayer::OPAQUE ? OPAQUE_TEXTURE_SHIFT : BLENDED_TEXTURE_SHIFT;
+    return static_cast<uint32_t>((key >> shift) & TEXTURE_MASK);
+}
+
+float RenderQueue::Distance(const Vector3& eye, float x, float y, float z) {
+    const float dx = x - eye.x;
+    const float dy = y - eye.y;
+    const float dz = z - eye.z;
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+void RenderQueue::Clear() {
+    packets.clear();
+    stats.packets = 0;
+}
+
+void RenderQueue::Submit(uint64_t key, IQueuedRenderer* drawer, uint32_t item) {
+    Packet packet = { key, drawer, item };
+    packets.push_back(packet);
+}
+
+void RenderQueue::Sort() {
+    const size_t count = packets.size();
+    if (count < 2) {
+        return;
+    }
+    scratch.resize(count);
+
+    // Bytes that differ between any two keys; passes over the others are no-ops
+    uint64_t varying = 0;
+    for (size_t i = 1; i < count; i++) {
+        varying |= packets[i].key ^ packets[0].key;
+    }
+
+    Packet* source = packets.data();
+    Packet* target = scratch.data();
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFF) == 0) {
+            continue;
+        }
+
+        size_t offsets[256] = {};
+        for (size_t i = 0; i < count; i++) {
+            offsets[(source[i].key >> shift) & 0xFF]++;
+        }
+        size_t total = 0;
+        for (size_t& offset : offsets) {
+            const size_t bucket = offset;
+            offset = total;
+            total += bucket;
+        }
+        for (size_t i = 0; i < count; i++) {
+            target[offsets[(source[i].key >> shift) & 0xFF]++] = source[i];
+        }
+        std::swap(source, target);
+    }
+
+    if (source != packets.data()) {
+        packets.swap(scratch);
+    }
+}
+
+void RenderQueue::ApplyState(DrawState state) {
+    const StateDesc& desc = STATE_DESCS[static_cast<int>(state)];
+    GLStateCache& cache = GLStateCache::Get();
+
+    cache.Set(GL_CULL_FACE, desc.cull);
+    if (desc.cull) {
+        cache.CullFace(GL_BACK);
+    }
+    cache.FrontFace(desc.frontFaceCCW ? GL_CCW : GL_CW);
+    cache.Set(GL_BLEND, desc.additive);
+    if (desc.additive) {
+        cache.BlendFunc(GL_SRC_ALPHA, GL_ONE);
+    }
+    cache.DepthMask(desc.additive ? GL_FALSE : GL_TRUE);
+}
+
+void RenderQueue::ApplyTexture(uint32_t texture, const unsigned int* textureNames) {
+    GLStateCache& cache = GLStateCache::Get();
+    cache.Set(GL_TEXTURE_2D, texture != 0);
+    if (texture != 0) {
+        cache.BindTexture(textureNames ? textureNames[texture - 1] : 0);
+    }
+}
+
+void RenderQueue::Execute(RenderLayer layer, const unsigned int* textureNames) {
+    // Packets are sorted, so a layer is one contiguous run
+    const uint64_t layerStart = static_cast<uint64_t>(layer) << LAYER_SHIFT;
+    auto first = std::lower_bound(packets.begin(), packets.end(), layerStart,
+        [](const Packet& packet, uint64_t key) { return packet.key < key; });
+
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    for (auto it = first; it != packets.end() && GetLayer(it->key) == layer; ++it) {
+        // The packet's state and texture changes are charged to its drawer
+        GL_COUNTER_SCOPE(it->drawer->GetRenderSource());
+        const DrawState state = GetState(it->key);
+        if (state != DrawState::CUSTOM) {
+            ApplyState(state);
+            ApplyTexture(GetTexture(it->key), textureNames);
+        }
+
+        it->drawer->DrawPacket(it->item);
+        stats.packets++;
+    }
+
+    // Leave the state the immediate-mode renderers expect
+    ApplyState(DrawState::LIT);
+    ApplyTexture(0, textureNames);
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "RenderData.h"
+#include "../profiling/GLCounters.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Layers execute in order; within a layer packets are sorted by key.
+ */
+enum class RenderLayer : uint8_t {
+    OPAQUE = 0,         // Depth-written geometry, front to back
+    TRANSPARENT = 1     // Blended geometry, back to front
+};
+
+/**
+ * Fixed-function state bundles a packet is drawn with (the "shader" of
+ * the fixed pipeline). Lighting, color material and depth testing are on
+ * for all of them.
+ */
+enum class DrawState : uint8_t {
+    LIT = 0,                // Back faces culled, clockwise front faces
+    LIT_CCW,                // Back faces culled, counter-clockwise front faces
+    UNCULLED,               // No face culling
+    ADDITIVE_CULLED,        // Additive blend, no depth writes, clockwise culling
+    ADDITIVE,               // Additive blend, no depth writes, no culling
+    CUSTOM,                 // The drawer sets (and may leave) its own state
+    COUNT
+};
+
+/**
+ * Draws the packets it submitted to a RenderQueue. The item value is the
+ * drawer's own: typically an index into data it kept at submit time.
+ */
+class IQueuedRenderer {
+public:
+    virtual ~IQueuedRenderer() = default;
+    virtual void DrawPacket(uint32_t item) = 0;
+
+    // Renderer the packet's GL calls are charged to in profiling builds
+    virtual RenderSource GetRenderSource() const { return RenderSource::OTHER; }
+};
+
+/**
+ * Per-view queue of draw packets with 64-bit sort keys.
+ *
+ * Key layout, most significant bits first:
+ *   opaque:       layer:4 | state:4 | texture:12 | depth:24 | material:20
+ *   transparent:  layer:4 | ~depth:24 | state:4 | texture:12 | material:20
+ * so opaque packets group by state and texture and run front to back
+ * inside a group, while transparent ones run strictly back to front.
+ * Texture 0 means untextured; other values are TextureHandler slots + 1.
+ *
+ * Sort() is an LSD radix sort over the key bytes, skipping bytes every
+ * packet shares. Execute() draws one layer, setting each packet's state
+ * and texture through GLStateCache, so runs of equal keys cost nothing.
+ */
+class RenderQueue {
+public:
+    struct Packet {
+        uint64_t key;
+        IQueuedRenderer* drawer;
+        uint32_t item;
+    };
+
+    struct Stats {
+        size_t packets;
+    };
+
+    static const int DEPTH_BITS = 24;
+    static const int TEXTURE_BITS = 12;
+    static const int MATERIAL_BITS = 20;
+    static const float MAX_DEPTH;           // Distances beyond this share the last bucket
+
+    static uint64_t MakeKey(RenderLayer layer, DrawState state, uint32_t texture, float distance, uint32_t material);
+    static uint64_t SetDistance(uint64_t key, float distance);
+    static RenderLayer GetLayer(uint64_t key) { return static_cast<RenderLayer>(key >> 60); }
+    static DrawState GetState(uint64_t key);
+    static uint32_t GetTexture(uint64_t key);
+    static float Distance(const Vector3& eye, float x, float y, float z);
+
+    void Clear();
+    void Submit(uint64_t key, IQueuedRenderer* drawer, uint32_t item);
+    void Sort();
+
+    /**
+     * Draw the packets of one layer (after Sort). textureNames maps
+     * texture slots to GL names. Leaves the LIT state, untextured.
+     */
+    void Execute(RenderLayer layer, const unsigned int* textureNames);
+
+    const std::vector<Packet>& GetPackets() const { return packets; }
+    const Stats& GetStats() const { return stats; }
+
+private:
+    // Kept across frames to reuse capacity
+    std::vector<Packet> packets;
+    std::vector<Packet> scratch;
+    Stats stats = {0};
+
+    void ApplyState(DrawState state);
+    void ApplyTexture(uint32_t texture, const unsigned int* textureNames);
+};
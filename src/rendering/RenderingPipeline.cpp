@@ -1,5 +1,10 @@
 #include "RenderingPipeline.h"
+#include "GLStateCache.h"
+#include "core/CoreGeometry.h"
 #include "../App.h"
+#include "../VideoTask.h"
+#include "../profiling/FrameStats.h"
+#include "../profiling/QualityGovernor.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -13,12 +18,20 @@
 #include <GL/glu.h>
 #endif
 
-#include <algorithm>
 #include <chrono>
+#include "GLProfile.h"
+
+namespace
+{
+    // Perspective of every player view
+    const float FOV_Y = 45.0f;
+    const float Z_NEAR = 0.1f;
+    const float Z_FAR = 1000.0f;
+}
 
 RenderingPipeline::RenderingPipeline(ViewportManager &viewport, CameraManager &camera,
                                      ResourceManager &resources)
-    : viewportManager(viewport), cameraManager(camera), resourceManager(resources), renderStats{0, 0, 0, 0, 0.0f}
+    : viewportManager(viewport), cameraManager(camera), resourceManager(resources), renderStats{0, 0, 0, 0, 0.0f, 0, 0, 0, 0, 1.0f, 0, {}}
 {
 }
 
@@ -47,6 +60,14 @@ bool RenderingPipeline::Initialize()
     {
         success = false;
     }
+
+    // Without framebuffer objects the scene simply stays at window size
+    dynamicResolution.Configure(VideoTask::targetFrameMs, VideoTask::minResolutionScale);
+    if (dynamicResolution.IsEnabled() &&
+        !sceneTarget.Initialize(viewportManager.GetScreenWidth(), viewportManager.GetScreenHeight()))
+    {
+        Logger::Get().Write("RenderingPipeline: dynamic resolution disabled\n");
+    }
     Logger::Get().Write("RenderingPipeline Initialized Successfully: %b\n", success);
     return success;
 }
@@ -64,6 +85,7 @@ void RenderingPipeline::Cleanup()
     hudRenderer.Cleanup();
     menuRenderer.Cleanup();
 
+    sceneTarget.Cleanup();
     itemRenderer.Cleanup();
     effectRenderer.Cleanup();
     bulletRenderer.Cleanup();
@@ -76,21 +98,21 @@ void RenderingPipeline::SetupRenderState()
     PushRenderState();
 
     // Enable depth testing for 3D rendering
-    glEnable(GL_DEPTH_TEST);
-    glDepthFunc(GL_LESS);
-    glDepthMask(GL_TRUE);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().DepthFunc(GL_LESS);
+    GLStateCache::Get().DepthMask(GL_TRUE);
 
     // Enable back-face culling for performance
-    glEnable(GL_CULL_FACE);
-    glCullFace(GL_BACK);
-    glFrontFace(GL_CCW);
+    GLStateCache::Get().Enable(GL_CULL_FACE);
+    GLStateCache::Get().CullFace(GL_BACK);
+    GLStateCache::Get().FrontFace(GL_CCW);
 
     // Setup alpha blending for transparency
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Enable smooth shading
-    glShadeModel(GL_SMOOTH);
+    GLStateCache::Get().ShadeModel(GL_SMOOTH);
 
     // Set clear color (dark blue/black for space-like background)
     glClearColor(0.0f, 0.0f, 0.2f, 1.0f);
@@ -104,39 +126,129 @@ void RenderingPipeline::CleanupRenderState()
 
 void RenderingPipeline::RenderScene(const SceneData &scene, int playerIndex)
 {
-    auto startTime = std::chrono::high_resolution_clock::now();
+    RenderView(scene, playerIndex, 1.0f);
+    RenderPlayerHUD(scene, playerIndex);
+}
 
+void RenderingPipeline::RenderView(const SceneData &scene, int playerIndex, float scale)
+{
     // Setup scene for specific player
-    SetupSceneForPlayer(scene, playerIndex);
-
-    // Clear buffers
-    ClearBuffers();
+    SetupSceneForPlayer(scene, playerIndex, scale);
 
     // Render in proper order for correct depth and transparency
     RenderSkybox(scene);
-    RenderTerrain(scene.terrain);
-    RenderGameObjects(scene);
-    RenderTransparentObjects(scene);
-    RenderUIElements(scene, playerIndex);
+    RenderWorld(scene, playerIndex);
+}
+
+void RenderingPipeline::RenderAllPlayerViews(const SceneData &scene)
+{
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    GLStateCache::Get().ResetCounters();
+    GLCounters::Get().BeginFrame();
+    PrepareFrame(scene);
+
+    // Each view only culls, sets its camera and draws its part of the world
+    const float scale = BeginSceneTarget();
+    int objectsDrawn = 0;
+    int packetsDrawn = 0;
+    int viewCount = 0;
+    for (int i = 0; i < scene.numPlayers && i < viewportManager.GetNumViewports() && i < MAX_VIEWS; ++i)
+    {
+        GL_COUNTER_VIEW(i);
+        RenderView(scene, i, scale);
+        objectsDrawn += renderStats.views[i].objectsVisible;
+        packetsDrawn += static_cast<int>(renderQueue.GetStats().packets);
+        viewCount++;
+    }
+    GL_COUNTER_VIEW(GLCounters::NO_VIEW);
+    ResolveSceneTarget(scale);
+
+    // HUDs and overlays stay sharp at window resolution
+    for (int i = 0; i < viewCount; ++i)
+    {
+        GL_COUNTER_VIEW(i);
+        viewportManager.SetActiveViewport(i);
+        RenderPlayerHUD(scene, i);
+    }
+    GL_COUNTER_VIEW(GLCounters::NO_VIEW);
+    RenderOverlays(scene);
 
     // Update rendering statistics
     auto endTime = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime);
     renderStats.renderTime = duration.count() / 1000.0f; // Convert to milliseconds
+    UpdateResolutionScale(scale);
 
     UpdateRenderStats(scene);
+    renderStats.viewCount = viewCount;
+    renderStats.objectsDrawn = objectsDrawn;
+    renderStats.packetsDrawn = packetsDrawn;
+
+    const GLStateCache::Counters &stateCounters = GLStateCache::Get().GetCounters();
+    renderStats.glStateIssued = static_cast<int>(stateCounters.issued);
+    renderStats.glStateElided = static_cast<int>(stateCounters.elided);
+    EndGLCounterFrame(renderStats);
+    FrameStats::Get().SetObjectsDrawn(objectsDrawn);
 }
 
-void RenderingPipeline::RenderAllPlayerViews(const SceneData &scene)
+void RenderingPipeline::PrepareFrame(const SceneData &scene)
+{
+    // Terrain chunks and object packets, culled and depth-sorted per view
+    terrainRenderer.BuildChunks(scene.terrain);
+
+    renderList.Clear();
+    itemRenderer.Prepare(scene.items, renderList);
+    bulletRenderer.Prepare(scene.bullets, renderList);
+    effectRenderer.Prepare(scene.effects, renderList);
+    tanksPrepared = tankRenderer && tankRenderer->Prepare(scene.tanks, renderList);
+
+    textureNames = nullptr;
+    if (App::GetSingleton().graphicsTask)
+    {
+        textureNames = App::GetSingleton().graphicsTask->textureHandler.GetTextureArray();
+    }
+
+    // glClear ignores the viewport, so the whole window is cleared once
+    ClearBuffers();
+    SetupLighting(scene);
+}
+
+float RenderingPipeline::BeginSceneTarget()
 {
-    // Render for each active player
-    for (int i = 0; i < scene.numPlayers && i < viewportManager.GetNumViewports(); ++i)
+    if (!sceneTarget.IsReady())
     {
-        RenderScene(scene, i);
+        return 1.0f;
     }
+
+    sceneTarget.Begin();
+    return dynamicResolution.GetScale();
 }
 
-void RenderingPipeline::SetupSceneForPlayer(const SceneData &scene, int playerIndex)
+void RenderingPipeline::ResolveSceneTarget(float scale)
+{
+    if (sceneTarget.IsReady())
+    {
+        const Viewport scene = Viewport(0, 0, sceneTarget.GetWidth(), sceneTarget.GetHeight()).Scaled(scale);
+        sceneTarget.Resolve(scene.width, scene.height);
+    }
+}
+
+void RenderingPipeline::UpdateResolutionScale(float scale)
+{
+    renderStats.resolutionScale = scale;
+    if (!sceneTarget.IsReady())
+    {
+        return;
+    }
+
+    // GPU time of the scene when timer queries work; the CPU side of the
+    // render otherwise, which at least sees the driver blocking on the GPU
+    const float gpuTimeMs = sceneTarget.GetGpuTimeMs();
+    dynamicResolution.AddFrame(gpuTimeMs >= 0.0f ? gpuTimeMs : renderStats.renderTime);
+}
+
+void RenderingPipeline::SetupSceneForPlayer(const SceneData &scene, int playerIndex, float scale)
 {
     // Validate player index
     if (playerIndex < 0 || playerIndex >= scene.numPlayers)
@@ -144,10 +256,11 @@ void RenderingPipeline::SetupSceneForPlayer(const SceneData &scene, int playerIn
         return;
     }
 
-    // Setup viewport for this player
-    viewportManager.SetActiveViewport(playerIndex);
+    // Setup viewport for this player, in the scene target's scaled corner
+    viewportManager.SetActiveViewport(playerIndex, scale);
 
-    // Setup camera for this player
+    // Setup camera for this player; without one nothing is culled
+    viewFrustum = Frustum();
     if (playerIndex < static_cast<int>(scene.cameras.size()))
     {
         const CameraData &camData = scene.cameras[playerIndex];
@@ -159,7 +272,7 @@ void RenderingPipeline::SetupSceneForPlayer(const SceneData &scene, int playerIn
         // Setup perspective projection
         const Viewport &viewport = viewportManager.GetViewport(playerIndex);
         float aspect = viewport.GetAspectRatio();
-        gluPerspective(45.0, aspect, 0.1, 1000.0);
+        gluPerspective(FOV_Y, aspect, Z_NEAR, Z_FAR);
 
         // Setup view matrix
         glMatrixMode(GL_MODELVIEW);
@@ -169,10 +282,12 @@ void RenderingPipeline::SetupSceneForPlayer(const SceneData &scene, int playerIn
             camData.focus.x, camData.focus.y, camData.focus.z,
             0.0f, 1.0f, 0.0f // Standard up vector
         );
+
+        UpdateViewFrustum(camData, aspect);
     }
 
-    // Setup lighting for the scene
-    SetupLighting(scene);
+    // The light direction goes through this view's camera
+    PositionLight();
 }
 
 void RenderingPipeline::ClearBuffers()
@@ -183,20 +298,18 @@ void RenderingPipeline::ClearBuffers()
 void RenderingPipeline::SetupLighting(const SceneData &scene)
 {
     // Enable lighting
-    glEnable(GL_LIGHTING);
-    glEnable(GL_LIGHT0);
+    GLStateCache::Get().Enable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_LIGHT0);
 
     // Enable color material so renderers can set material colors with glColor3f
-    glEnable(GL_COLOR_MATERIAL);
+    GLStateCache::Get().Enable(GL_COLOR_MATERIAL);
     glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
 
-    // Setup main directional light (sun)
-    GLfloat lightPos[] = {0.5f, 1.0f, 0.5f, 0.0f}; // Directional light
+    // Setup main directional light (sun); PositionLight aims it per view
     GLfloat lightAmbient[] = {0.2f, 0.2f, 0.2f, 1.0f};
     GLfloat lightDiffuse[] = {0.8f, 0.8f, 0.8f, 1.0f};
     GLfloat lightSpecular[] = {1.0f, 1.0f, 1.0f, 1.0f};
 
-    glLightfv(GL_LIGHT0, GL_POSITION, lightPos);
     glLightfv(GL_LIGHT0, GL_AMBIENT, lightAmbient);
     glLightfv(GL_LIGHT0, GL_DIFFUSE, lightDiffuse);
     glLightfv(GL_LIGHT0, GL_SPECULAR, lightSpecular);
@@ -205,45 +318,83 @@ void RenderingPipeline::SetupLighting(const SceneData &scene)
     // Let the terrain colors from JSON metadata be the primary color source
 }
 
+void RenderingPipeline::PositionLight()
+{
+    // Transformed by the modelview matrix current at the call
+    GLfloat lightPos[] = {0.5f, 1.0f, 0.5f, 0.0f}; // Directional light
+    glLightfv(GL_LIGHT0, GL_POSITION, lightPos);
+}
+
 void RenderingPipeline::RenderSkybox(const SceneData &scene)
 {
     if (scene.drawSky)
     {
+        GL_COUNTER_SCOPE(RenderSource::SKY);
+
         // Disable depth testing for skybox
-        glDisable(GL_DEPTH_TEST);
-        glDepthMask(GL_FALSE);
+        GLStateCache::Get().Disable(GL_DEPTH_TEST);
+        GLStateCache::Get().DepthMask(GL_FALSE);
 
         // Delegate to GraphicsTask's DrawSky method for now
         // TODO: Move sky rendering to a dedicated SkyRenderer
         App::GetSingleton().graphicsTask->DrawSky();
 
         // Re-enable depth testing
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_TRUE);
+        GLStateCache::Get().Enable(GL_DEPTH_TEST);
+        GLStateCache::Get().DepthMask(GL_TRUE);
     }
 }
 
-void RenderingPipeline::RenderTerrain(const TerrainRenderData &terrain)
+void RenderingPipeline::UpdateViewFrustum(const CameraData &camera, float aspect)
 {
-    // Delegate to terrain renderer - let it handle its own state management
-    terrainRenderer.RenderTerrain(terrain);
+    // The same matrices gluPerspective and gluLookAt produced
+    const Mat4 viewProjection = Mat4::Perspective(FOV_Y, aspect, Z_NEAR, Z_FAR) *
+                                Mat4::LookAt(camera.position, camera.focus, Vector3(0.0f, 1.0f, 0.0f));
+    viewFrustum.Extract(viewProjection.m);
 }
 
-void RenderingPipeline::RenderGameObjects(const SceneData &scene)
+void RenderingPipeline::RenderWorld(const SceneData &scene, int playerIndex)
 {
-    // Render opaque objects in front-to-back order for early Z rejection
-    RenderTanks(scene.tanks);
-    RenderItems(scene.items);
-    RenderBullets(scene.bullets);
+    Vector3 eye;
+    if (playerIndex >= 0 && playerIndex < static_cast<int>(scene.cameras.size()))
+    {
+        eye = scene.cameras[playerIndex].position;
+    }
+
+    // Everything but the tanks of a non-queueing renderer goes through the
+    // queue: opaque packets grouped by state and texture, front to back,
+    // then blended packets back to front. Only what is inside the view
+    // frustum is submitted.
+    ViewStats scratch;
+    ViewStats &view = playerIndex >= 0 && playerIndex < MAX_VIEWS ? renderStats.views[playerIndex] : scratch;
+    view.objectsTotal = static_cast<int>(scene.tanks.size() + scene.bullets.size() +
+                                         scene.effects.size() + scene.items.size());
+    view.chunksTotal = terrainRenderer.GetChunkCount();
+
+    renderQueue.Clear();
+    view.chunksVisible = terrainRenderer.Submit(renderQueue, eye, viewFrustum,
+                                                QualityGovernor::Get().GetBudget().terrainDrawDistance);
+    view.objectsVisible = renderList.Submit(renderQueue, eye, viewFrustum);
+    renderQueue.Sort();
+
+    renderQueue.Execute(RenderLayer::OPAQUE, textureNames);
+    if (!tanksPrepared)
+    {
+        view.objectsVisible += RenderTanks(scene.tanks);
+    }
+    renderQueue.Execute(RenderLayer::TRANSPARENT, textureNames);
 }
 
-void RenderingPipeline::RenderTransparentObjects(const SceneData &scene)
+void RenderingPipeline::RenderPlayerHUD(const SceneData &scene, int playerIndex)
 {
-    // Render transparent objects in back-to-front order for correct blending
-    RenderEffects(scene.effects);
+    if (scene.uiData && playerIndex >= 0 && playerIndex < static_cast<int>(scene.uiData->playerHUDs.size()))
+    {
+        GL_COUNTER_SCOPE(RenderSource::HUD);
+        hudRenderer.RenderPlayerHUD(scene.uiData->playerHUDs[playerIndex]);
+    }
 }
 
-void RenderingPipeline::RenderUIElements(const SceneData &scene, int playerIndex)
+void RenderingPipeline::RenderOverlays(const SceneData &scene)
 {
     // Only render UI if we have UI data
     if (!scene.uiData) {
@@ -251,73 +402,46 @@ void RenderingPipeline::RenderUIElements(const SceneData &scene, int playerIndex
     }
     
     const UIRenderData& uiData = *scene.uiData;
-    
-    // Render player-specific HUD if we have HUD data for this player
-    if (playerIndex >= 0 && playerIndex < static_cast<int>(uiData.playerHUDs.size())) {
-        hudRenderer.RenderPlayerHUD(uiData.playerHUDs[playerIndex]);
+    if (!uiData.menu.isVisible && !uiData.debug.showDebugInfo && !uiData.frameStats.visible) {
+        return;
     }
-    
-    // Render menu if visible (menu is global, not player-specific)
+
+    // Menu, debug info and frame stats are global: drawn once over the whole window
+    viewportManager.SetFullScreenViewport();
+
     if (uiData.menu.isVisible) {
+        GL_COUNTER_SCOPE(RenderSource::MENU);
         menuRenderer.RenderMenu(uiData.menu);
     }
-    
-    // Render debug info if enabled (only for player 0 to avoid duplication)
-    if (playerIndex == 0 && uiData.debug.showDebugInfo) {
+
+    GL_COUNTER_SCOPE(RenderSource::HUD);
+    if (uiData.debug.showDebugInfo) {
         hudRenderer.RenderDebugInfo(uiData.debug);
     }
-}
-
-void RenderingPipeline::RenderTanks(const std::vector<TankRenderData> &tanks)
-{
-    if (tanks.empty() || !tankRenderer)
-    {
-        return;
+    if (uiData.frameStats.visible) {
+        hudRenderer.RenderFrameStats(uiData.frameStats);
     }
-
-    tankRenderer->RenderMultiple(tanks);
-    renderStats.tanksRendered = static_cast<int>(tanks.size());
 }
 
-void RenderingPipeline::RenderBullets(const std::vector<BulletRenderData> &bullets)
+int RenderingPipeline::RenderTanks(const FrameVector<TankRenderData> &tanks)
 {
-    if (bullets.empty())
-    {
-        return;
-    }
-
-    bulletRenderer.SetupRenderState();
-    bulletRenderer.RenderBullets(bullets);
-    bulletRenderer.CleanupRenderState();
-
-    renderStats.bulletsRendered = static_cast<int>(bullets.size());
-}
-
-void RenderingPipeline::RenderEffects(const std::vector<EffectRenderData> &effects)
-{
-    if (effects.empty())
+    if (tanks.empty() || !tankRenderer)
     {
-        return;
+        return 0;
     }
 
-    effectRenderer.SetupRenderState();
-    effectRenderer.RenderEffects(effects);
-    effectRenderer.CleanupRenderState();
-
-    renderStats.effectsRendered = static_cast<int>(effects.size());
-}
-
-void RenderingPipeline::RenderItems(const std::vector<ItemRenderData> &items)
-{
-    if (items.empty())
+    GL_COUNTER_SCOPE(RenderSource::TANKS);
+    visibleTanks.clear();
+    for (const TankRenderData &tank : tanks)
     {
-        return;
+        if (ITankRenderer::IsVisible(tank, viewFrustum))
+        {
+            visibleTanks.push_back(tank);
+        }
     }
 
-    // Let the ItemRenderer handle its own state management internally
-    itemRenderer.RenderItems(items);
-
-    renderStats.itemsRendered = static_cast<int>(items.size());
+    tankRenderer->RenderMultiple(visibleTanks);
+    return static_cast<int>(visibleTanks.size());
 }
 
 void RenderingPipeline::UpdateRenderStats(const SceneData &scene)
@@ -331,7 +455,7 @@ void RenderingPipeline::UpdateRenderStats(const SceneData &scene)
 void RenderingPipeline::PushRenderState()
 {
     // Save current OpenGL state
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
+    GLStateCache::Get().PushState();
     glPushMatrix();
 }
 
@@ -339,41 +463,7 @@ void RenderingPipeline::PopRenderState()
 {
     // Restore previous OpenGL state
     glPopMatrix();
-    glPopAttrib();
-}
-
-bool RenderingPipeline::ShouldRenderObject(const Vector3 &position, const Vector3 &cameraPos, float maxDistance)
-{
-    // Simple distance-based culling
-    float dx = position.x - cameraPos.x;
-    float dy = position.y - cameraPos.y;
-    float dz = position.z - cameraPos.z;
-    float distance = dx * dx + dy * dy + dz * dz; // Squared distance for performance
-
-    return distance <= (maxDistance * maxDistance);
-}
-
-void RenderingPipeline::OptimizeRenderOrder(std::vector<TankRenderData> &tanks, const Vector3 &cameraPos)
-{
-    // Sort tanks by distance from camera (front to back for opaque objects)
-    std::sort(tanks.begin(), tanks.end(),
-              [&cameraPos](const TankRenderData &a, const TankRenderData &b)
-              {
-                  float distA = (a.position.x - cameraPos.x) * (a.position.x - cameraPos.x) +
-                                (a.position.y - cameraPos.y) * (a.position.y - cameraPos.y) +
-                                (a.position.z - cameraPos.z) * (a.position.z - cameraPos.z);
-                  float distB = (b.position.x - cameraPos.x) * (b.position.x - cameraPos.x) +
-                                (b.position.y - cameraPos.y) * (b.position.y - cameraPos.y) +
-                                (b.position.z - cameraPos.z) * (b.position.z - cameraPos.z);
-                  return distA < distB; // Front to back
-              });
-}
-
-void RenderingPipeline::PerformFrustumCulling(const SceneData &scene, int playerIndex)
-{
-    // TODO: Implement view frustum culling
-    // This would test objects against the camera frustum and remove those outside the view
-    // For now, this is a placeholder for future optimization
+    GLStateCache::Get().PopState();
 }
 
 void RenderingPipeline::ConfigureViewports(int numPlayers, int screenWidth, int screenHeight)
@@ -384,4 +474,9 @@ void RenderingPipeline::ConfigureViewports(int numPlayers, int screenWidth, int
     } else {
         viewportManager.SetupSinglePlayer(screenWidth, screenHeight);
     }
+
+    if (sceneTarget.IsReady() && !sceneTarget.Resize(screenWidth, screenHeight))
+    {
+        Logger::Get().Write("RenderingPipeline: dynamic resolution disabled\n");
+    }
 }
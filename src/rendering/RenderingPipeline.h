@@ -1,6 +1,6 @@
 #pragma once
 
-#include "IRenderer.h"
+#include "IRenderingPipeline.h"
 #include "RenderData.h"
 #include "ViewportManager.h"
 #include "CameraManager.h"
@@ -12,6 +12,11 @@
 #include "ITankRenderer.h"
 #include "TankRendererFactory.h"
 #include "HUDRenderer.h"
+#include "RenderQueue.h"
+#include "RenderList.h"
+#include "Frustum.h"
+#include "DynamicResolution.h"
+#include "SceneRenderTarget.h"
 #include "MenuRenderer.h"
 #include <memory>
 
@@ -29,7 +34,7 @@
  * - Performance oriented: Minimizes state changes and optimizes rendering order
  * - Extensible: Easy to add new rendering stages or object types
  */
-class RenderingPipeline : public IRenderer {
+class RenderingPipeline : public IRenderingPipeline {
 public:
     /**
      * Constructor with injected dependencies.
@@ -50,44 +55,40 @@ public:
     void CleanupRenderState() override;
     
     /**
-     * Renders a complete scene for the specified player.
-     * Handles viewport setup, camera positioning, and rendering all objects.
+     * Renders the view of one player at window resolution: viewport, camera,
+     * culling, world and that player's HUD. Draws the frame data PrepareFrame
+     * built.
      * 
      * @param scene Complete scene data containing all objects to render
-     * @param playerIndex Index of the player whose view to render (0 or 1)
+     * @param playerIndex Index of the player whose view to render (0 to 3)
      */
     void RenderScene(const SceneData& scene, int playerIndex);
     
     /**
      * Renders scenes for all players (split-screen support).
+     * Prepares the view-independent data once and renders each view's world,
+     * into the scaled scene target when dynamic resolution is on. The HUDs,
+     * menu and overlays are drawn after it at window resolution.
      * 
      * @param scene Complete scene data containing all objects to render
      */
-    void RenderAllPlayerViews(const SceneData& scene);
+    void RenderAllPlayerViews(const SceneData& scene) override;
     
     /**
      * Get the current rendering statistics.
      * Useful for performance monitoring and debugging.
      */
-    struct RenderStats {
-        int tanksRendered;
-        int bulletsRendered;
-        int effectsRendered;
-        int itemsRendered;
-        float renderTime;
-    };
-    
-    const RenderStats& GetRenderStats() const { return renderStats; }
+    const RenderStats& GetRenderStats() const override { return renderStats; }
     
     /**
      * Configure viewports for the given number of players.
      * Handles single-player and split-screen setup.
      * 
-     * @param numPlayers Number of active players (1 or 2)
+     * @param numPlayers Number of active players (1 to 4)
      * @param screenWidth Screen width in pixels
      * @param screenHeight Screen height in pixels
      */
-    void ConfigureViewports(int numPlayers, int screenWidth, int screenHeight);
+    void ConfigureViewports(int numPlayers, int screenWidth, int screenHeight) override;
     
 private:
     // Injected dependencies
@@ -102,6 +103,24 @@ private:
     ItemRenderer itemRenderer;
     std::unique_ptr<ITankRenderer> tankRenderer;
     
+    // World geometry of the current view, sorted by state and depth
+    RenderQueue renderQueue;
+    
+    // Packets of the frame's objects, shared by all views
+    RenderList renderList;
+    bool tanksPrepared = false;
+    const unsigned int* textureNames = nullptr;
+    
+    // Clip planes of the current view, set with its camera
+    Frustum viewFrustum;
+    
+    // Visible tanks of a renderer that does not queue, kept to reuse capacity
+    FrameVector<TankRenderData> visibleTanks;
+    
+    // Dynamic resolution: the scale of the world views and where they go
+    DynamicResolution dynamicResolution;
+    SceneRenderTarget sceneTarget;
+    
     // UI renderers
     HUDRenderer hudRenderer;
     MenuRenderer menuRenderer;
@@ -110,30 +129,35 @@ private:
     mutable RenderStats renderStats;
     
     // Main rendering stages
-    void SetupSceneForPlayer(const SceneData& scene, int playerIndex);
+    void PrepareFrame(const SceneData& scene);
+    void RenderView(const SceneData& scene, int playerIndex, float scale);
+    void SetupSceneForPlayer(const SceneData& scene, int playerIndex, float scale);
     void RenderSkybox(const SceneData& scene);
-    void RenderTerrain(const TerrainRenderData& terrain);
-    void RenderGameObjects(const SceneData& scene);
-    void RenderTransparentObjects(const SceneData& scene);
-    void RenderUIElements(const SceneData& scene, int playerIndex);
+    void RenderWorld(const SceneData& scene, int playerIndex);
+    void RenderPlayerHUD(const SceneData& scene, int playerIndex);
+    void RenderOverlays(const SceneData& scene);
     
-    // Object-specific rendering methods
-    void RenderTanks(const std::vector<TankRenderData>& tanks);
-    void RenderBullets(const std::vector<BulletRenderData>& bullets);
-    void RenderEffects(const std::vector<EffectRenderData>& effects);
-    void RenderItems(const std::vector<ItemRenderData>& items);
+    // Visible tanks of a renderer that does not queue; returns how many
+    int RenderTanks(const FrameVector<TankRenderData>& tanks);
     
     // Rendering utilities
     void ClearBuffers();
     void SetupLighting(const SceneData& scene);
-    void OptimizeRenderOrder(std::vector<TankRenderData>& tanks, const Vector3& cameraPos);
+    void PositionLight();
     void UpdateRenderStats(const SceneData& scene);
     
+    // Binds the scene target when dynamic resolution is on and returns the
+    // scale of this frame's world views (1 without the target)
+    float BeginSceneTarget();
+    void ResolveSceneTarget(float scale);
+    
+    // Feeds the frame's scene time to the controller for the next frames
+    void UpdateResolutionScale(float scale);
+    
     // State management
     void PushRenderState();
     void PopRenderState();
     
-    // Performance optimization
-    bool ShouldRenderObject(const Vector3& position, const Vector3& cameraPos, float maxDistance = 100.0f);
-    void PerformFrustumCulling(const SceneData& scene, int playerIndex);
+    // Extracts viewFrustum from the matrices SetupSceneForPlayer loads
+    void UpdateViewFrustum(const CameraData& camera, float aspect);
 };
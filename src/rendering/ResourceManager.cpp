@@ -1,5 +1,6 @@
 #include "ResourceManager.h"
 #include "../App.h"
+#include "../VideoTask.h"
 
 #ifdef _WIN32
 #include <windows.h>
@@ -10,6 +11,8 @@
 #include <GL/gl.h>
 #endif
 
+#include "GLProfile.h"
+
 ResourceManager::ResourceManager() 
     : defaultFont(nullptr)
     , isInitialized(false)
@@ -27,10 +30,18 @@ bool ResourceManager::Initialize() {
     // Initialize all resource subsystems
     bool success = true;
     
+    // A core-profile context has neither display lists nor the legacy
+    // texture upload; CoreRenderingPipeline builds its own buffers
+    const bool legacyContext = VideoTask::activeBackend == VideoTask::RenderBackend::LEGACY;
+    
     success &= InitializeFonts();
-    success &= InitializeTextures();
+    if (legacyContext) {
+        success &= InitializeTextures();
+    }
     success &= InitializeMeshes();
-    success &= InitializeDisplayLists();
+    if (legacyContext) {
+        success &= InitializeDisplayLists();
+    }
     
     if (success) {
         isInitialized = true;
@@ -113,6 +124,7 @@ bool ResourceManager::InitializeDisplayLists() {
         BuildTankDisplayLists();
         BuildItemList();
         BuildSquareLists();
+        BuildEnemyTankLists();
         
         displayListsBuilt = true;
     } catch (...) {
@@ -336,6 +348,29 @@ void ResourceManager::BuildSquareLists() {
     squareList2.EndNewList();
 }
 
+void ResourceManager::BuildEnemyTankLists() {
+    // Compiled once; TankRenderer only sets a transform and a tint per part
+    for (int part = 0; part < EnemyTankGeometry::PART_COUNT; part++) {
+        if (part == 0) {
+            enemyTankLists.BeginNewList();
+        } else {
+            enemyTankLists.NextNewList();
+        }
+
+        const MeshData& mesh = EnemyTankGeometry::Get(static_cast<EnemyTankGeometry::Part>(part));
+        glBegin(GL_TRIANGLES);
+        for (int i = 0; i < mesh.triangleCount; i++) {
+            const MeshTriangle& triangle = mesh.triangles[i];
+            glNormal3fv(triangle.normal);
+            glVertex3fv(triangle.positions[0]);
+            glVertex3fv(triangle.positions[1]);
+            glVertex3fv(triangle.positions[2]);
+        }
+        glEnd();
+    }
+    enemyTankLists.EndNewList();
+}
+
 void ResourceManager::PrepareMesh(igtl_QGLMesh& mesh, const char* fileName) {
     // Load mesh using proper method name
     mesh.LoadOBJ(fileName);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IRenderer.h"
+#include "EnemyTankGeometry.h"
 #include "../DisplayList.h"
 #include "../TextureHandler.h"
 #include "../igtl_qmesh.h"
@@ -13,7 +14,7 @@
  * that were previously scattered throughout GraphicsTask, including:
  * - Display lists for geometry rendering
  * - Texture management through TextureHandler  
- * - Mesh data for complex geometry
+ * - Mesh data for complex geometry, including the baked enemy tank parts
  * - Font resources for text rendering
  * 
  * Design Principles:
@@ -51,6 +52,9 @@ public:
     const DisplayList& GetBodyListEx2() const { return bodyListEx2; }
     const DisplayList& GetTurretListEx2() const { return turretListEx2; }
     const DisplayList& GetCannonListEx2() const { return cannonListEx2; }
+
+    // Enemy tank parts, one list per EnemyTankGeometry::Part
+    const DisplayList& GetEnemyTankLists() const { return enemyTankLists; }
     
     // Texture management (delegate to existing TextureHandler)
     TextureHandler& GetTextureHandler() { return textureHandler; }
@@ -90,6 +94,8 @@ private:
     DisplayList bodyListEx2;
     DisplayList turretListEx2;
     DisplayList cannonListEx2;
+
+    DisplayList enemyTankLists{EnemyTankGeometry::PART_COUNT};
     
     // Resource managers
     TextureHandler textureHandler;
@@ -122,6 +128,7 @@ private:
     void BuildTankDisplayLists();
     void BuildItemList();
     void BuildSquareLists();
+    void BuildEnemyTankLists();
     
     // Mesh processing methods (moved from GraphicsTask)
     void FixMesh(igtl_QGLMesh& mesh);
@@ -2,6 +2,8 @@
 #include "../App.h"
 #include "../GameWorld.h"
 #include "../PlayerManager.h"
+#include "../profiling/QualityGovernor.h"
+#include <algorithm>
 
 SceneDataBuilder::SceneDataBuilder(const TankHandler& tanks, const LevelHandler& level, 
                                  const GameWorld* world, const PlayerManager* playerMgr)
@@ -12,19 +14,24 @@ SceneDataBuilder::SceneDataBuilder(const TankHandler& tanks, const LevelHandler&
 }
 
 SceneData SceneDataBuilder::BuildScene() const {
-    SceneData scene;
+    // New arena frame; the scene built before the last one is released
+    frameArenas.Flip();
+    SceneData scene(&frameArenas.Current());
     
     // Extract all rendering data from game objects
-    scene.tanks = ExtractTankData();
-    scene.bullets = ExtractBulletData();
-    scene.effects = ExtractEffectData();
-    scene.items = ExtractItemData();
+    ExtractEntityData(scene);
     scene.terrain = ExtractTerrainData();
     scene.cameras = ExtractCameraData();
     
     // Extract UI data for HUD/Menu/Debug rendering
-    auto uiDataPtr = ExtractUIData();
-    scene.uiData = uiDataPtr.release();
+    scene.uiData = ExtractUIData();
+    FrameStatsRenderData& frameStats = scene.uiData->frameStats;
+    if (frameStats.visible) {
+        frameStats.tanks = static_cast<int>(scene.tanks.size());
+        frameStats.bullets = static_cast<int>(scene.bullets.size());
+        frameStats.effects = static_cast<int>(scene.effects.size());
+        frameStats.items = static_cast<int>(scene.items.size());
+    }
     
     // Extract game state information
     ExtractGameState(scene);
@@ -42,28 +49,40 @@ SceneData SceneDataBuilder::BuildSceneForPlayer(int playerIndex) const {
     return scene;
 }
 
+void SceneDataBuilder::BuildEntityData(SceneData& scene) const {
+    frameArenas.Flip();
+    FrameArena* arena = &frameArenas.Current();
+    scene.tanks = FrameVector<TankRenderData>(ArenaAllocator<TankRenderData>(arena));
+    scene.bullets = FrameVector<BulletRenderData>(ArenaAllocator<BulletRenderData>(arena));
+    scene.effects = FrameVector<EffectRenderData>(ArenaAllocator<EffectRenderData>(arena));
+    scene.items = FrameVector<ItemRenderData>(ArenaAllocator<ItemRenderData>(arena));
+    ExtractEntityData(scene);
+}
+
+void SceneDataBuilder::ExtractEntityData(SceneData& scene) const {
+    ExtractTankData(scene.tanks);
+    ExtractBulletData(scene.bullets);
+    ExtractEffectData(scene.effects);
+    ExtractItemData(scene.items);
+}
+
 bool SceneDataBuilder::IsReady() const {
     // Check if all required game objects are in a valid state
     // This is a basic check - could be expanded with more validation
     return true; // For now, assume dependencies are always valid
 }
 
-std::vector<TankRenderData> SceneDataBuilder::ExtractTankData() const {
-    std::vector<TankRenderData> allTanks;
-    
+void SceneDataBuilder::ExtractTankData(FrameVector<TankRenderData>& allTanks) const {
     // Extract player tank data from PlayerManager
     auto playerTankPtrs = playerManager ? playerManager->GetPlayerTanks() : std::array<Tank*, 2>{nullptr, nullptr};
-    auto special = playerManager ? playerManager->GetSpecialCharges() : std::array<float, 2>{0.0f, 0.0f};
-    int numPlayers = playerManager ? playerManager->GetNumPlayers() : 0;
+    int numPlayers = playerManager ? std::min(playerManager->GetNumPlayers(), static_cast<int>(TankHandler::MAX_PLAYERS)) : 0;
     
-    auto playerTanks = TankDataExtractor::ExtractPlayerDataFromPointers(
-        playerTankPtrs, 
-        special, 
-        numPlayers
-    );
-    
-    allTanks.reserve(playerTanks.size() + 20); // Reserve space for players + expected enemies
-    allTanks.insert(allTanks.end(), playerTanks.begin(), playerTanks.end());
+    allTanks.reserve(numPlayers + 20); // Reserve space for players + expected enemies
+    for (int i = 0; i < numPlayers; ++i) {
+        if (playerTankPtrs[i] && playerTankPtrs[i]->alive) {
+            allTanks.push_back(TankDataExtractor::ExtractRenderData(*playerTankPtrs[i]));
+        }
+    }
     
     // Extract enemy tanks from GameWorld (if available)
     if (gameWorld) {
@@ -76,75 +95,31 @@ std::vector<TankRenderData> SceneDataBuilder::ExtractTankData() const {
         }
     } else {
         // Fallback: Extract enemy tanks from TankHandler legacy system
-        auto enemyTanks = TankDataExtractor::ExtractEnemyData(
-            tankHandler.GetAllEnemyTanks()
-        );
-        allTanks.insert(allTanks.end(), enemyTanks.begin(), enemyTanks.end());
+        for (const Tank* tank : tankHandler.GetAllEnemyTanks()) {
+            allTanks.push_back(TankDataExtractor::ExtractRenderData(*tank));
+        }
     }
-    
-    return allTanks;
 }
 
-std::vector<BulletRenderData> SceneDataBuilder::ExtractBulletData() const {
-    // Extract bullets directly from GameWorld
-    if (!gameWorld) {
-        return {}; // Return empty if no GameWorld
-    }
-    
-    const auto& worldBullets = gameWorld->GetBullets();
-    std::vector<Bullet> bulletRefs;
-    bulletRefs.reserve(worldBullets.size());
-    
-    for (const auto& bulletPtr : worldBullets) {
-        if (bulletPtr && bulletPtr->IsAlive()) {
-            bulletRefs.push_back(*bulletPtr);
-        }
+void SceneDataBuilder::ExtractBulletData(FrameVector<BulletRenderData>& bullets) const {
+    // Extract bullets directly from GameWorld, reading them in place
+    if (gameWorld) {
+        BulletDataExtractor::ExtractBulletRenderData(gameWorld->GetBullets(), bullets);
     }
-    
-    return BulletDataExtractor::ExtractBulletRenderData(bulletRefs);
 }
 
-std::vector<EffectRenderData> SceneDataBuilder::ExtractEffectData() const {
-    // Extract FX directly from GameWorld
-    if (!gameWorld) {
-        return {};
-    }
-    
-    const auto& worldFX = gameWorld->GetFX();
-    std::vector<FX> fxRefs;
-    fxRefs.reserve(worldFX.size());
-    
-    for (const auto& fxPtr : worldFX) {
-        if (fxPtr && fxPtr->IsAlive()) {
-            fxRefs.push_back(*fxPtr);
-        }
+void SceneDataBuilder::ExtractEffectData(FrameVector<EffectRenderData>& effects) const {
+    // Extract particles directly from GameWorld
+    if (gameWorld) {
+        EffectDataExtractor::ExtractEffectRenderData(gameWorld->GetParticles(), effects);
     }
-    
-    return EffectDataExtractor::ExtractEffectRenderData(fxRefs);
 }
 
-std::vector<ItemRenderData> SceneDataBuilder::ExtractItemData() const {
+void SceneDataBuilder::ExtractItemData(FrameVector<ItemRenderData>& items) const {
     // Extract items directly from GameWorld
-    if (!gameWorld) {
-        return {};
-    }
-    
-    const auto& worldItems = gameWorld->GetItems();
-    std::vector<ItemRenderData> itemData;
-    itemData.reserve(worldItems.size());
-    
-    for (const auto& itemPtr : worldItems) {
-        if (itemPtr && itemPtr->IsAlive()) {
-            ItemRenderData data;
-            data.position = Vector3{itemPtr->x, itemPtr->y, itemPtr->z};
-            data.rotationY = itemPtr->ry; // Use only Y rotation for spinning
-            data.itemType = itemPtr->type;
-            data.visible = true;
-            itemData.push_back(data);
-        }
+    if (gameWorld) {
+        ItemDataExtractor::ExtractRenderData(gameWorld->GetRegistry(), items);
     }
-    
-    return itemData;
 }
 
 TerrainRenderData SceneDataBuilder::ExtractTerrainData() const {
@@ -166,8 +141,8 @@ TerrainRenderData SceneDataBuilder::ExtractTerrainData() const {
     return terrain;
 }
 
-std::vector<CameraData> SceneDataBuilder::ExtractCameraData() const {
-    std::vector<CameraData> cameras;
+FrameVector<CameraData> SceneDataBuilder::ExtractCameraData() const {
+    FrameVector<CameraData> cameras(ArenaAllocator<CameraData>(&frameArenas.Current()));
     
     int numPlayers = playerManager->GetNumPlayers();
     cameras.reserve(numPlayers);
@@ -225,31 +200,10 @@ void SceneDataBuilder::OptimizeForPlayer(SceneData& scene, int playerIndex) cons
 }
 
 void SceneDataBuilder::PerformFrustumCulling(SceneData& scene, int playerIndex) const {
-    // TODO: Implement frustum culling based on player camera
-    // This would remove objects outside the player's view to improve performance
-    
-    // For now, this is a placeholder - all objects are kept
-    // In a full implementation, this would:
-    // 1. Get the player's camera frustum
-    // 2. Test each object against the frustum
-    // 3. Remove objects that are completely outside the view
-    
-    // Example structure:
-    // if (playerIndex < scene.cameras.size()) {
-    //     const CameraData& camera = scene.cameras[playerIndex];
-    //     Frustum frustum = CalculateFrustum(camera);
-    //     
-    //     // Remove tanks outside frustum
-    //     scene.tanks.erase(
-    //         std::remove_if(scene.tanks.begin(), scene.tanks.end(),
-    //             [&frustum](const TankRenderData& tank) {
-    //                 return !frustum.Contains(tank.position);
-    //             }),
-    //         scene.tanks.end()
-    //     );
-    //     
-    //     // Same for bullets, effects, items...
-    // }
+    // Nothing to do here: RenderingPipeline culls against each view's
+    // frustum at submit time, so split-screen views can share one scene.
+    (void)scene;
+    (void)playerIndex;
 }
 
 void SceneDataBuilder::SortObjectsByDistance(SceneData& scene, int playerIndex) const {
@@ -278,7 +232,7 @@ void SceneDataBuilder::SortObjectsByDistance(SceneData& scene, int playerIndex)
     // }
 }
 
-std::unique_ptr<UIRenderData> SceneDataBuilder::ExtractUIData() const {
+UIRenderData* SceneDataBuilder::ExtractUIData() const {
     // Use the comprehensive UI data extraction method
     bool gameStarted = App::GetSingleton().gameTask->IsGameStarted();
     bool isPaused = App::GetSingleton().gameTask->IsPaused();
@@ -288,11 +242,26 @@ std::unique_ptr<UIRenderData> SceneDataBuilder::ExtractUIData() const {
     
     // Use PlayerManager if available, otherwise create empty UI data
     if (playerManager) {
+        // Over budget the player HUDs are only refreshed every few frames
+        const int interval = QualityGovernor::Get().GetBudget().hudUpdateInterval;
+        const std::vector<HUDRenderData>* held = nullptr;
+        if (interval > 1) {
+            const int numPlayers = playerManager->GetNumPlayers();
+            if (heldHUDPlayers != numPlayers || ++hudFramesHeld >= interval) {
+                heldHUDs = HUDDataExtractor::ExtractAllPlayerHUDs(playerManager->GetPlayerTanks(), numPlayers);
+                heldHUDPlayers = numPlayers;
+                hudFramesHeld = 0;
+            }
+            held = &heldHUDs;
+        } else {
+            heldHUDPlayers = 0;
+        }
+        
         UIRenderData uiData = HUDDataExtractor::ExtractCompleteUIData(
-            *playerManager, gameStarted, isPaused, showMenu, menuState, showDebug);
-        return std::make_unique<UIRenderData>(std::move(uiData));
+            *playerManager, gameStarted, isPaused, showMenu, menuState, showDebug, held);
+        return frameArenas.Current().New<UIRenderData>(std::move(uiData));
     }
     
     // Fallback: return empty UI data
-    return std::make_unique<UIRenderData>();
+    return frameArenas.Current().New<UIRenderData>();
 }
@@ -24,6 +24,10 @@ class GameWorld;
  * - Consistent interface: Always returns SceneData in same format
  * - Performance oriented: Minimizes data copying and allocations
  * - Dependency injection: Receives game objects as constructor parameters
+ *
+ * Scene data lives in the builder's double-buffered frame arena: each build
+ * starts a new arena frame, and a scene stays valid until the build after
+ * next.
  */
 class SceneDataBuilder {
 public:
@@ -55,6 +59,19 @@ public:
      */
     SceneData BuildSceneForPlayer(int playerIndex) const;
     
+    /**
+     * Extracts only the per-entity data (tanks, bullets, effects, items).
+     * Needs no camera, task or GL state, so headless tools can time it.
+     * 
+     * @param scene SceneData whose entity vectors are replaced
+     */
+    void BuildEntityData(SceneData& scene) const;
+    
+    /**
+     * Arenas holding the built scenes (for size and overflow statistics).
+     */
+    const DoubleFrameArena& GetFrameArenas() const { return frameArenas; }
+    
     /**
      * Check if the builder is ready to extract data.
      * 
@@ -67,7 +84,7 @@ public:
      * 
      * @return Vector of CameraData for all active players
      */
-    std::vector<CameraData> ExtractCameraData() const;
+    FrameVector<CameraData> ExtractCameraData() const;
 
 private:
     // Game object references (injected dependencies)
@@ -76,13 +93,22 @@ private:
     const class GameWorld* gameWorld;
     const class PlayerManager* playerManager;
     
+    // Storage of the scenes built (building is logically const)
+    mutable DoubleFrameArena frameArenas;
+    
+    // Player HUDs kept while the quality budget spaces out their extraction
+    mutable std::vector<HUDRenderData> heldHUDs;
+    mutable int heldHUDPlayers = 0;
+    mutable int hudFramesHeld = 0;
+    
     // Individual data extraction methods
-    std::vector<TankRenderData> ExtractTankData() const;
-    std::vector<BulletRenderData> ExtractBulletData() const;
-    std::vector<EffectRenderData> ExtractEffectData() const;
-    std::vector<ItemRenderData> ExtractItemData() const;
+    void ExtractEntityData(SceneData& scene) const;
+    void ExtractTankData(FrameVector<TankRenderData>& tanks) const;
+    void ExtractBulletData(FrameVector<BulletRenderData>& bullets) const;
+    void ExtractEffectData(FrameVector<EffectRenderData>& effects) const;
+    void ExtractItemData(FrameVector<ItemRenderData>& items) const;
     TerrainRenderData ExtractTerrainData() const;
-    std::unique_ptr<UIRenderData> ExtractUIData() const;
+    UIRenderData* ExtractUIData() const;
     
     // Game state extraction methods
     void ExtractGameState(SceneData& scene) const;
@@ -0,0 +1,209 @@
+#include "SceneRenderTarget.h"
+#include "../Logger.h"
+
+#include <SDL2/SDL.h>
+#include <string>
+
+namespace
+{
+    // Core (ARB_framebuffer_object) name first, then the EXT one
+    template <typename T>
+    bool LoadFunction(T &function, const char *name)
+    {
+        function = reinterpret_cast<T>(SDL_GL_GetProcAddress(name));
+        if (!function)
+        {
+            const std::string extName = std::string(name) + "EXT";
+            function = reinterpret_cast<T>(SDL_GL_GetProcAddress(extName.c_str()));
+        }
+        return function != nullptr;
+    }
+}
+
+bool SceneRenderTarget::LoadEntryPoints()
+{
+    const bool framebuffers =
+        LoadFunction(genFramebuffers, "glGenFramebuffers") &&
+        LoadFunction(deleteFramebuffers, "glDeleteFramebuffers") &&
+        LoadFunction(bindFramebuffer, "glBindFramebuffer") &&
+        LoadFunction(framebufferRenderbuffer, "glFramebufferRenderbuffer") &&
+        LoadFunction(checkFramebufferStatus, "glCheckFramebufferStatus") &&
+        LoadFunction(genRenderbuffers, "glGenRenderbuffers") &&
+        LoadFunction(deleteRenderbuffers, "glDeleteRenderbuffers") &&
+        LoadFunction(bindRenderbuffer, "glBindRenderbuffer") &&
+        LoadFunction(renderbufferStorage, "glRenderbufferStorage") &&
+        LoadFunction(blitFramebuffer, "glBlitFramebuffer");
+    if (!framebuffers)
+    {
+        return false;
+    }
+
+    timerQueries =
+        LoadFunction(genQueries, "glGenQueries") &&
+        LoadFunction(deleteQueries, "glDeleteQueries") &&
+        LoadFunction(beginQuery, "glBeginQuery") &&
+        LoadFunction(endQuery, "glEndQuery") &&
+        LoadFunction(getQueryObjectiv, "glGetQueryObjectiv") &&
+        LoadFunction(getQueryObjectui64v, "glGetQueryObjectui64v");
+    return true;
+}
+
+bool SceneRenderTarget::Initialize(int targetWidth, int targetHeight)
+{
+    if (!LoadEntryPoints())
+    {
+        Logger::Get().Write("SceneRenderTarget: framebuffer objects are not available\n");
+        return false;
+    }
+
+    width = targetWidth;
+    height = targetHeight;
+    if (!Allocate())
+    {
+        Cleanup();
+        return false;
+    }
+
+    if (timerQueries)
+    {
+        genQueries(QUERY_COUNT, queries);
+    }
+    else
+    {
+        Logger::Get().Write("SceneRenderTarget: no timer queries, scaling from CPU time\n");
+    }
+    return true;
+}
+
+bool SceneRenderTarget::Allocate()
+{
+    genFramebuffers(1, &framebuffer);
+    genRenderbuffers(1, &colorBuffer);
+    genRenderbuffers(1, &depthBuffer);
+
+    bindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    bindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    bindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    const GLenum status = checkFramebufferStatus(GL_FRAMEBUFFER);
+    bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        Logger::Get().Write("SceneRenderTarget: %dx%d framebuffer incomplete (0x%x)\n", width, height, status);
+        return false;
+    }
+    return true;
+}
+
+bool SceneRenderTarget::Resize(int targetWidth, int targetHeight)
+{
+    if (!IsReady() || (targetWidth == width && targetHeight == height))
+    {
+        return IsReady();
+    }
+
+    deleteFramebuffers(1, &framebuffer);
+    deleteRenderbuffers(1, &colorBuffer);
+    deleteRenderbuffers(1, &depthBuffer);
+    framebuffer = colorBuffer = depthBuffer = 0;
+
+    width = targetWidth;
+    height = targetHeight;
+    if (!Allocate())
+    {
+        Cleanup();
+        return false;
+    }
+    return true;
+}
+
+void SceneRenderTarget::Cleanup()
+{
+    if (framebuffer)
+    {
+        deleteFramebuffers(1, &framebuffer);
+    }
+    if (colorBuffer)
+    {
+        deleteRenderbuffers(1, &colorBuffer);
+    }
+    if (depthBuffer)
+    {
+        deleteRenderbuffers(1, &depthBuffer);
+    }
+    if (timerQueries && queries[0])
+    {
+        deleteQueries(QUERY_COUNT, queries);
+    }
+    framebuffer = colorBuffer = depthBuffer = 0;
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+        queries[i] = 0;
+        queryPending[i] = false;
+    }
+    gpuTimeMs = -1.0f;
+}
+
+void SceneRenderTarget::Begin()
+{
+    bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, width, height);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    if (timerQueries)
+    {
+        CollectTimerResults();
+
+        // All queries still in flight: skip timing this frame rather than wait
+        if (!queryPending[nextQuery])
+        {
+            beginQuery(GL_TIME_ELAPSED, queries[nextQuery]);
+        }
+    }
+}
+
+void SceneRenderTarget::Resolve(int sceneWidth, int sceneHeight)
+{
+    if (timerQueries && !queryPending[nextQuery])
+    {
+        endQuery(GL_TIME_ELAPSED);
+        queryPending[nextQuery] = true;
+        nextQuery = (nextQuery + 1) % QUERY_COUNT;
+    }
+
+    bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    blitFramebuffer(0, 0, sceneWidth, sceneHeight, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    bindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void SceneRenderTarget::CollectTimerResults()
+{
+    // Oldest first, so gpuTimeMs ends up with the latest finished frame
+    for (int i = 0; i < QUERY_COUNT; i++)
+    {
+        const int query = (nextQuery + i) % QUERY_COUNT;
+        if (!queryPending[query])
+        {
+            continue;
+        }
+
+        GLint available = 0;
+        getQueryObjectiv(queries[query], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            break;
+        }
+
+        GLuint64 nanoseconds = 0;
+        getQueryObjectui64v(queries[query], GL_QUERY_RESULT, &nanoseconds);
+        gpuTimeMs = static_cast<float>(nanoseconds) / 1000000.0f;
+        queryPending[query] = false;
+    }
+}
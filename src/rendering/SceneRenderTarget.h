@@ -0,0 +1,86 @@
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <SDL2/SDL_opengl.h>
+
+/**
+ * Offscreen framebuffer the legacy pipeline draws the 3D scene into when
+ * dynamic resolution is on.
+ *
+ * Storage is allocated once at window size; a lower scale only renders
+ * into the bottom left part of it, so changing the scale never reallocates.
+ * Resolve() stretches that part over the window with linear filtering and
+ * leaves the window's framebuffer bound for the HUD.
+ *
+ * The GL 2.1 context exposes framebuffers through ARB_framebuffer_object
+ * (or the EXT pair of framebuffer_object and framebuffer_blit); without
+ * them Initialize() fails and the pipeline keeps rendering at native
+ * resolution. Scene GPU time comes from timer queries when the driver has
+ * them, read a few frames late so the CPU never waits on the GPU.
+ */
+class SceneRenderTarget
+{
+public:
+    SceneRenderTarget() = default;
+    ~SceneRenderTarget() = default;
+
+    bool Initialize(int width, int height);
+    void Cleanup();
+
+    // Reallocate for a new window size (no-op if unchanged)
+    bool Resize(int width, int height);
+
+    bool IsReady() const { return framebuffer != 0; }
+    int GetWidth() const { return width; }
+    int GetHeight() const { return height; }
+
+    // Bind the target, clear it and start timing the scene
+    void Begin();
+
+    // Stop timing and stretch the sceneWidth x sceneHeight corner over the window
+    void Resolve(int sceneWidth, int sceneHeight);
+
+    // Latest finished GPU time of the scene in milliseconds, or a negative
+    // value if timer queries are unavailable or none has finished yet
+    float GetGpuTimeMs() const { return gpuTimeMs; }
+
+private:
+    static const int QUERY_COUNT = 3;
+
+    bool LoadEntryPoints();
+    bool Allocate();
+    void CollectTimerResults();
+
+    int width = 0;
+    int height = 0;
+
+    GLuint framebuffer = 0;
+    GLuint colorBuffer = 0;
+    GLuint depthBuffer = 0;
+
+    GLuint queries[QUERY_COUNT] = {};
+    bool queryPending[QUERY_COUNT] = {};
+    int nextQuery = 0;
+    bool timerQueries = false;
+    float gpuTimeMs = -1.0f;
+
+    PFNGLGENFRAMEBUFFERSPROC genFramebuffers = nullptr;
+    PFNGLDELETEFRAMEBUFFERSPROC deleteFramebuffers = nullptr;
+    PFNGLBINDFRAMEBUFFERPROC bindFramebuffer = nullptr;
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC framebufferRenderbuffer = nullptr;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC checkFramebufferStatus = nullptr;
+    PFNGLGENRENDERBUFFERSPROC genRenderbuffers = nullptr;
+    PFNGLDELETERENDERBUFFERSPROC deleteRenderbuffers = nullptr;
+    PFNGLBINDRENDERBUFFERPROC bindRenderbuffer = nullptr;
+    PFNGLRENDERBUFFERSTORAGEPROC renderbufferStorage = nullptr;
+    PFNGLBLITFRAMEBUFFERPROC blitFramebuffer = nullptr;
+
+    PFNGLGENQUERIESPROC genQueries = nullptr;
+    PFNGLDELETEQUERIESPROC deleteQueries = nullptr;
+    PFNGLBEGINQUERYPROC beginQuery = nullptr;
+    PFNGLENDQUERYPROC endQuery = nullptr;
+    PFNGLGETQUERYOBJECTIVPROC getQueryObjectiv = nullptr;
+    PFNGLGETQUERYOBJECTUI64VPROC getQueryObjectui64v = nullptr;
+};
@@ -15,7 +15,7 @@ TankRenderData TankDataExtractor::ExtractRenderData(const Tank& tank) {
     data.maxHealth = tank.maxHealth;
     data.charge = tank.energy;      // Charge field now represents energy for actions
     data.maxCharge = tank.maxEnergy;
-    data.fireCost = tank.fireCost;
+    data.fireCost = tank.Cold().fireCost;
     
     // Extract colors
     // Get colors dynamically from tank types
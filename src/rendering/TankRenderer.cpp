@@ -9,7 +9,10 @@
 
 #include "TankRenderer.h"
 #include "PlayerTankRenderer.h"
+#include "EnemyTankGeometry.h"
+#include "ResourceManager.h"
 #include "../App.h"
+#include "GLProfile.h"
 
 TankRenderer::TankRenderer() {
     // Constructor - base class handles initialization
@@ -46,39 +49,78 @@ void TankRenderer::Render(const TankRenderData& data) {
     }
 }
 
-void TankRenderer::RenderMultiple(const std::vector<TankRenderData>& tanks) {
+void TankRenderer::RenderMultiple(const FrameVector<TankRenderData>& tanks) {
     if (tanks.empty()) {
         return;
     }
     
     SetupRenderState();
     
-    // Use default implementation but with proper state management
-    ITankRenderer::RenderMultiple(tanks);
+    // Enemies first: they all use the state set above and differ only in
+    // transform and tint. Player tanks manage their own state.
+    for (const auto& tank : tanks) {
+        if (tank.alive && !tank.isPlayer) {
+            RenderEnemyTank(tank);
+        }
+    }
+    for (const auto& tank : tanks) {
+        if (tank.alive && tank.isPlayer) {
+            RenderPlayerTank(tank);
+        }
+    }
     
     CleanupRenderState();
 }
 
+bool TankRenderer::Prepare(const FrameVector<TankRenderData>& tanks, RenderList& list) {
+    submittedTanks = &tanks;
+    for (size_t i = 0; i < tanks.size(); i++) {
+        const TankRenderData& tank = tanks[i];
+        if (!tank.alive) {
+            continue;
+        }
+        // Enemies share the lit state; player tanks set up their own
+        const DrawState state = tank.isPlayer ? DrawState::CUSTOM : DrawState::LIT;
+        list.BeginObject(tank.position, BOUNDING_RADIUS);
+        list.Add(RenderLayer::OPAQUE, state, 0, 0, this, static_cast<uint32_t>(i));
+    }
+    return true;
+}
+
+void TankRenderer::DrawPacket(uint32_t item) {
+    const TankRenderData& tank = (*submittedTanks)[item];
+    if (!tank.isPlayer) {
+        RenderEnemyTank(tank);
+        return;
+    }
+    
+    GLStateCache& state = GLStateCache::Get();
+    state.PushState();
+    state.DepthMask(GL_TRUE);
+    state.Disable(GL_BLEND);
+    state.Disable(GL_TEXTURE_2D);
+    state.FrontFace(GL_CW);
+    RenderPlayerTank(tank);
+    state.PopState();
+}
+
 void TankRenderer::SetupRenderState() {
+    // Saves the current state (GLStateCache::PushState)
     BaseRenderer::SetupRenderState();
     
-    // Save current OpenGL state
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-    
     // Set up OpenGL state for tank rendering
-    glEnable(GL_LIGHTING);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
-    glDisable(GL_BLEND);
-    glDisable(GL_TEXTURE_2D);
-    glFrontFace(GL_CW);
+    GLStateCache& state = GLStateCache::Get();
+    state.Enable(GL_LIGHTING);
+    state.Enable(GL_DEPTH_TEST);
+    state.DepthMask(GL_TRUE);
+    state.DepthFunc(GL_LESS);
+    state.Disable(GL_BLEND);
+    state.Disable(GL_TEXTURE_2D);
+    state.FrontFace(GL_CW);
 }
 
 void TankRenderer::CleanupRenderState() {
-    // Restore all OpenGL state
-    glPopAttrib();
-    
+    // Restores whatever the tanks changed, player tanks included
     BaseRenderer::CleanupRenderState();
 }
 
@@ -100,336 +142,45 @@ void TankRenderer::RenderPlayerTank(const TankRenderData& tank) {
 }
 
 void TankRenderer::RenderEnemyTank(const TankRenderData& tank) {
-    // Enemy tanks use TankRenderer::Draw logic (hardcoded geometry)
-    // Save state before enemy tank rendering
-    glPushAttrib(GL_ALL_ATTRIB_BITS);
-    
-    // Setup enemy tank render state
-    glEnable(GL_LIGHTING);
-    glDisable(GL_BLEND);
-    glDisable(GL_TEXTURE_2D);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
-    glFrontFace(GL_CW);
-    
+    // Parts are baked into ResourceManager's display lists; per tank this
+    // is a transform, two tints and three list calls. Render state comes
+    // from SetupRenderState or the render queue's LIT state.
+    const std::unique_ptr<ResourceManager>& resources = App::GetSingleton().graphicsTask->resourceManager;
+    if (!resources || !resources->AreDisplayListsReady()) {
+        return;
+    }
+    const DisplayList& parts = resources->GetEnemyTankLists();
+
     glPushMatrix();
     
-    // Replicate TankRenderer::Draw() logic exactly
     // SetupBodyTransform
     glTranslatef(tank.position.x, tank.position.y, tank.position.z);
     glRotatef(tank.bodyRotation.x, 1, 0, 0);
     glRotatef(-tank.bodyRotation.y, 0, 1, 0);
     glRotatef(tank.bodyRotation.z, 0, 0, 1);
     
-    // DrawBody with energy-based health coloring (secondary colors)
-    DrawEnemyTankBody(tank.secondaryColor.r, tank.secondaryColor.g, tank.secondaryColor.b, tank.health, tank.maxHealth);
+    // Body with health-based tint (secondary colors)
+    SetEnemyTankColor(tank.secondaryColor, tank.health, tank.maxHealth);
+    parts.Call(EnemyTankGeometry::BODY);
     
     // SetupBarrelTransform
     glRotatef(tank.turretRotation.x, 1, 0, 0);
     glRotatef(-tank.turretRotation.y, 0, 1, 0);
     glRotatef(tank.turretRotation.z, 0, 0, 1);
     
-    // DrawBarrel with energy-based health coloring (primary colors)
-    DrawEnemyTankBarrel(tank.primaryColor.r, tank.primaryColor.g, tank.primaryColor.b, tank.health, tank.maxHealth);
+    // Barrel and turret with health-based tint (primary colors)
+    SetEnemyTankColor(tank.primaryColor, tank.health, tank.maxHealth);
+    parts.Call(EnemyTankGeometry::BARREL);
     
     // SetupTurretTransform
     glTranslatef(0.1f, 0, 0);
-    
-    // DrawTurret (uses current color from barrel)
-    DrawEnemyTankTurret();
+    parts.Call(EnemyTankGeometry::TURRET);
     
     glPopMatrix();
-    
-    // Restore state
-    glPopAttrib();
 }
 
-void TankRenderer::DrawEnemyTankBody(float r, float g, float b, float energy, float maxEnergy) {
-    // Exact copy from TankRenderer::DrawBody
-    glColor3f((4 * r + (maxEnergy / energy)) / 2, (4 * g + (maxEnergy / energy)) / 2, (4 * b + (maxEnergy / energy)) / 2);
-    
-    glScalef(.06f, .06f, .06f);
-    glBegin(GL_TRIANGLES);
-    
-    // Tank body geometry (exact copy from TankRenderer.cpp)
-    glNormal3f(0.894427f, -0.447214f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(4, 0, -4);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(4, 0, 4);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(5, 2, 3);
-    
-    glNormal3f(0.894427f, -0.447214f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(4, 0, -4);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(5, 2, 3);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(5, 2, -3);
-    
-    glNormal3f(-0.894427f, -0.447214f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(-4, 0, -4);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(-5, 2, -5);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-5, 2, 5);
-    
-    glNormal3f(-0.894427f, -0.447214f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(-4, 0, -4);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-5, 2, 5);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-4, 0, 4);
-    
-    glNormal3f(0.182574f, 0.365148f, -0.912871f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(4, 0, -4);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(5, 2, -3);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(-5, 2, -5);
-    
-    glNormal3f(0.000000f, -0.447214f, -0.894427f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(4, 0, -4);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(-5, 2, -5);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(-4, 0, -4);
-    
-    glNormal3f(0.000000f, -0.447214f, 0.894427f);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(4, 0, 4);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-4, 0, 4);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-5, 2, 5);
-    
-    glNormal3f(0.182574f, 0.365148f, 0.912871f);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(4, 0, 4);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-5, 2, 5);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(5, 2, 3);
-    
-    glNormal3f(0.000000f, 1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(5, 2, -3);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(5, 2, 3);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-5, 2, 5);
-    
-    glNormal3f(0.000000f, 1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(5, 2, -3);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-5, 2, 5);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(-5, 2, -5);
-    
-    glNormal3f(0.000000f, -1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(4, 0, -4);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(-4, 0, -4);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-4, 0, 4);
-    
-    glNormal3f(0.000000f, -1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(4, 0, -4);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-4, 0, 4);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(4, 0, 4);
-    
-    glEnd();
-    glScalef(10, 10, 10);
-}
-
-void TankRenderer::DrawEnemyTankBarrel(float r, float g, float b, float energy, float maxEnergy) {
-    // Exact copy from TankRenderer::DrawBarrel
-    glColor3f((4 * r + (maxEnergy / energy)) / 2, (4 * g + (maxEnergy / energy)) / 2, (4 * b + (maxEnergy / energy)) / 2);
-    
-    glScalef(.1f, .1f, .1f);
-    glBegin(GL_TRIANGLES);
-    
-    // Tank barrel geometry (exact copy from TankRenderer.cpp)
-    glNormal3f(0.163846f, -0.081923f, 0.983078f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, 2);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-3, 2, 3);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, 3);
-    
-    glNormal3f(0.180156f, -0.041001f, 0.982783f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, 2);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, 3);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(3, 4, 2);
-    
-    glNormal3f(0.196116f, 0.000000f, -0.980581f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, -2);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(3, 4, -2);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, -3);
-    
-    glNormal3f(0.180156f, -0.041001f, -0.982783f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, -2);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, -3);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-3, 2, -3);
-    
-    glNormal3f(1.000000f, 0.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, 2);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(3, 4, 2);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(3, 4, -2);
-    
-    glNormal3f(1.000000f, 0.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, 2);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(3, 4, -2);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, -2);
-    
-    glNormal3f(-0.894427f, 0.447214f, 0.000000f);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-3, 2, 3);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-3, 2, -3);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, -3);
-    
-    glNormal3f(-0.894427f, 0.447214f, 0.000000f);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-3, 2, 3);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, -3);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, 3);
-    
-    glNormal3f(0.000000f, 1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(3, 4, 2);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, 3);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, -3);
-    
-    glNormal3f(0.000000f, 1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(3, 4, 2);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-2, 4, -3);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(3, 4, -2);
-    
-    glNormal3f(0.000000f, -1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, 2);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, -2);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-3, 2, -3);
-    
-    glNormal3f(0.000000f, -1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(3, 2, 2);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-3, 2, -3);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(-3, 2, 3);
-    
-    glEnd();
-    glScalef(10, 10, 10);
-}
-
-void TankRenderer::DrawEnemyTankTurret() {
-    // Exact copy from TankRenderer::DrawTurret
-    glScalef(.1f, .1f, .1f);
-    glBegin(GL_TRIANGLES);
-    
-    // Tank turret geometry (exact copy from TankRenderer.cpp)
-    glNormal3f(0.000000f, 1.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, -0.707107f);
-    glVertex3f(-3, 4, -0.25f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3f(5, 4, -0.25f);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3f(5, 4, 0.25f);
-    
-    glNormal3f(0.000000f, 1.000000f, 0.000000f);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3f(-3, 4, -0.25f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3f(5, 4, 0.25f);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3f(-3, 4, 0.25f);
-    
-    glNormal3f(0.000000f, -0.707107f, -0.707107f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3f(-3, 4, -0.25f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(-3, 3, 0);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(5, 3, 0);
-    
-    glNormal3f(0.000000f, -0.707107f, -0.707107f);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3f(-3, 4, -0.25f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3i(5, 3, 0);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3f(5, 4, -0.25f);
-    
-    glNormal3f(-1.000000f, 0.000000f, 0.000000f);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3f(-3, 4, -0.25f);
-    glTexCoord2f(0.000000f, 0.000000f);
-    glVertex3f(-3, 4, 0.25f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(-3, 3, 0);
-    
-    glNormal3f(1.000000f, 0.000000f, 0.000000f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3f(5, 4, -0.25f);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3i(5, 3, 0);
-    glTexCoord2f(1.000000f, 0.000000f);
-    glVertex3f(5, 4, 0.25f);
-    
-    glNormal3f(0.000000f, -0.707107f, 0.707107f);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3f(-3, 4, 0.25f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3f(5, 4, 0.25f);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(5, 3, 0);
-    
-    glNormal3f(0.000000f, -0.707107f, 0.707107f);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3f(-3, 4, 0.25f);
-    glTexCoord2f(0.000000f, 1.000000f);
-    glVertex3i(5, 3, 0);
-    glTexCoord2f(1.000000f, 1.000000f);
-    glVertex3i(-3, 3, 0);
-    
-    glEnd();
-    glScalef(10, 10, 10);
+void TankRenderer::SetEnemyTankColor(const Color& color, float health, float maxHealth) {
+    // Brighter as the tank loses health
+    const float damage = maxHealth / health;
+    glColor3f((4 * color.r + damage) / 2, (4 * color.g + damage) / 2, (4 * color.b + damage) / 2);
 }
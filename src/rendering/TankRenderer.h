@@ -13,7 +13,7 @@
  * Implements the ITankRenderer interface while inheriting from BaseRenderer
  * for common rendering functionality.
  */
-class TankRenderer : public BaseRenderer, public ITankRenderer {
+class TankRenderer : public BaseRenderer, public ITankRenderer, public IQueuedRenderer {
 public:
     TankRenderer();
     virtual ~TankRenderer() = default;
@@ -22,10 +22,15 @@ public:
     bool Initialize() override;
     void Cleanup() override;
     void Render(const TankRenderData& data) override;
-    void RenderMultiple(const std::vector<TankRenderData>& tanks) override;
+    void RenderMultiple(const FrameVector<TankRenderData>& tanks) override;
+    bool Prepare(const FrameVector<TankRenderData>& tanks, RenderList& list) override;
     void SetupRenderState() override;
     void CleanupRenderState() override;
     
+    // IQueuedRenderer interface implementation
+    void DrawPacket(uint32_t item) override;
+    RenderSource GetRenderSource() const override { return RenderSource::TANKS; }
+    
 protected:
     
 private:
@@ -37,13 +42,13 @@ private:
     void RenderPlayerTank(const TankRenderData& tank);
     
     /**
-     * Renders an enemy tank with basic rendering.
+     * Renders an enemy tank from the display lists baked by ResourceManager.
+     * Expects the state set by SetupRenderState.
      * @param tank Tank render data for an enemy tank
      */
     void RenderEnemyTank(const TankRenderData& tank);
     
-    // Hardcoded geometry methods (from TankRenderer.cpp)
-    void DrawEnemyTankBody(float r, float g, float b, float energy, float maxEnergy);
-    void DrawEnemyTankBarrel(float r, float g, float b, float energy, float maxEnergy);
-    void DrawEnemyTankTurret();
+    void SetEnemyTankColor(const Color& color, float health, float maxHealth);
+    
+    const FrameVector<TankRenderData>* submittedTanks = nullptr;
 };
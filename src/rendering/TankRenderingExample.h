@@ -39,7 +39,7 @@ namespace TankRenderingExample {
         }
         
         // Example tank data
-        std::vector<TankRenderData> tanks;
+        FrameVector<TankRenderData> tanks;
         
         // Create a player tank
         TankRenderData playerTank = {};
@@ -90,7 +90,7 @@ namespace TankRenderingExample {
     /**
      * Example function showing advanced usage with custom rendering pipeline.
      */
-    void AdvancedTankRenderingExample(const std::vector<TankRenderData>& tanks) {
+    void AdvancedTankRenderingExample(const FrameVector<TankRenderData>& tanks) {
         // Create renderer based on performance requirements
         auto renderer = TankRendererFactory::CreateRenderer(
             TankRendererFactory::RendererType::UNIFIED
@@ -105,8 +105,8 @@ namespace TankRenderingExample {
         renderer->SetupRenderState();
         
         // Render tanks in batches for efficiency
-        std::vector<TankRenderData> playerTanks;
-        std::vector<TankRenderData> enemyTanks;
+        FrameVector<TankRenderData> playerTanks;
+        FrameVector<TankRenderData> enemyTanks;
         
         // Separate tanks by type for optimized rendering
         for (const auto& tank : tanks) {
@@ -148,7 +148,7 @@ namespace TankRenderingExample {
         
         // In GraphicsTask::Update(), you would use it like this:
         // 1. Extract tank data from game objects
-        // std::vector<TankRenderData> tankData = sceneBuilder->ExtractTankData();
+        // FrameVector<TankRenderData> tankData = sceneBuilder->ExtractTankData();
         
         // 2. Render tanks using the new interface
         // tankRenderer->RenderMultiple(tankData);
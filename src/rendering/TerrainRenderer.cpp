@@ -7,11 +7,88 @@
 #include <GL/gl.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
 #include "TerrainRenderer.h"
 #include "RenderData.h"
 #include "../App.h"
 #include "../Logger.h"
+#include "GLProfile.h"
+
+namespace
+{
+    // Calls visit(ix, iz, lastY, currentY) for every wall step of cells
+    // [begin, end) of a row, in the order and with the edge rules of a full
+    // row: a segment starts from its neighbouring cell's height.
+    template <typename Visitor>
+    void ForEachWallQuad(const TerrainRenderData &terrain, int direction, int row, int begin, int end,
+                         Visitor visit)
+    {
+        const int sx = terrain.sizeX - 1;
+        const int sz = terrain.sizeZ - 1;
+
+        switch (direction)
+        {
+        case 0: // X direction, front faces
+        {
+            int lastY = begin > 0 ? terrain.heightMap[row][begin - 1] : 0;
+            for (int iz = begin; iz < end && iz <= sz; iz++)
+            {
+                if (terrain.heightMap[row][iz] != lastY && iz != sz && row != 0)
+                {
+                    visit(row, iz, lastY, terrain.heightMap[row][iz]);
+                }
+                lastY = terrain.heightMap[row][iz];
+            }
+            break;
+        }
+
+        case 1: // X direction, back faces, walked from the far end
+        {
+            const int first = std::min(end - 1, sz - 1);
+            int lastY = first < sz - 1 ? terrain.heightMap[row][first + 1] : 0;
+            for (int iz = first; iz >= begin && iz > 0; iz--)
+            {
+                if (terrain.heightMap[row][iz] != lastY && row != sx)
+                {
+                    visit(row, iz, lastY, terrain.heightMap[row][iz]);
+                }
+                lastY = terrain.heightMap[row][iz];
+            }
+            break;
+        }
+
+        case 2: // Z direction, left faces
+        {
+            int lastY = begin > 0 ? terrain.heightMap[begin - 1][row] : 0;
+            for (int ix = begin; ix < end && ix <= sx; ix++)
+            {
+                if (terrain.heightMap[ix][row] != lastY && ix != sx && row != 0)
+                {
+                    visit(ix, row, lastY, terrain.heightMap[ix][row]);
+                }
+                lastY = terrain.heightMap[ix][row];
+            }
+            break;
+        }
+
+        case 3: // Z direction, right faces, walked from the far end
+        {
+            const int first = std::min(end - 1, sx);
+            int lastY = first < sx ? terrain.heightMap[first + 1][row] : 0;
+            for (int ix = first; ix >= begin && ix >= 0; ix--)
+            {
+                if (terrain.heightMap[ix][row] != lastY && ix != 0)
+                {
+                    visit(ix, row, lastY, terrain.heightMap[ix][row]);
+                }
+                lastY = terrain.heightMap[ix][row];
+            }
+            break;
+        }
+        }
+    }
+}
 
 TerrainRenderer::TerrainRenderer() : BaseRenderer(),
                                      currentTerrainData(nullptr),
@@ -44,7 +121,7 @@ void TerrainRenderer::Setup3DRenderState()
     // so we don't need to set it here
     
     // Ensure lighting is enabled (should already be enabled by RenderingPipeline)
-    glEnable(GL_LIGHTING);
+    GLStateCache::Get().Enable(GL_LIGHTING);
     
     // Set texture environment to modulate texture with material color
     glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
@@ -73,9 +150,9 @@ void TerrainRenderer::RenderTerrain(const TerrainRenderData &terrainData)
     {
         SetupTerrainColors(terrainData);
 
-        glEnable(GL_DEPTH_TEST);
+        GLStateCache::Get().Enable(GL_DEPTH_TEST);
         // Re-enable texturing now that we've fixed the lighting issue
-        glEnable(GL_TEXTURE_2D);
+        GLStateCache::Get().Enable(GL_TEXTURE_2D);
 
         // Render terrain components in order
         RenderFloatingElements(terrainData);
@@ -93,9 +170,244 @@ void TerrainRenderer::RenderTerrain(const TerrainRenderData &terrainData)
     CleanupRenderState();
 }
 
+void TerrainRenderer::BuildChunks(const TerrainRenderData &terrainData)
+{
+    const TerrainRenderData &terrain = terrainData;
+    currentTerrainData = &terrain;
+    pieces.clear();
+    chunks.clear();
+
+    for (int x0 = 0; x0 < terrain.sizeX; x0 += CHUNK_SIZE)
+    {
+        for (int z0 = 0; z0 < terrain.sizeZ; z0 += CHUNK_SIZE)
+        {
+            BuildChunk(terrain, x0, z0, std::min(x0 + CHUNK_SIZE, terrain.sizeX),
+                       std::min(z0 + CHUNK_SIZE, terrain.sizeZ));
+        }
+    }
+
+    // Boundary walls and water span the whole level and are never culled
+    firstSharedPiece = static_cast<uint32_t>(pieces.size());
+    const Vector3 middle((terrain.sizeX - 1) * 0.5f, 0.0f, (terrain.sizeZ - 1) * 0.5f);
+
+    QueuedPiece boundary = { PIECE_BOUNDARY, 0, TEXTURE_BLACK,
+                             terrain.levelNumber == 48 ? DrawState::LIT_CCW : DrawState::LIT,
+                             0, 0, 0, 0, middle };
+    pieces.push_back(boundary);
+
+    for (int direction = 0; direction < 4; direction++)
+    {
+        QueuedPiece water = { PIECE_WATER, (uint8_t)direction, TEXTURE_BLEND, DrawState::ADDITIVE,
+                              0, 0, 0, 0, middle };
+        pieces.push_back(water);
+    }
+}
+
+void TerrainRenderer::BuildChunk(const TerrainRenderData &terrain, int x0, int z0, int x1, int z1)
+{
+    const int sx = terrain.sizeX - 1;
+    const int sz = terrain.sizeZ - 1;
+
+    // Height range of the chunk. Wall steps start from the neighbouring
+    // cell (or from 0 at the level edge), so the border cells count too.
+    int minY = 0;
+    int maxY = 0;
+    for (int x = std::max(x0 - 1, 0); x < std::min(x1 + 1, terrain.sizeX); x++)
+    {
+        for (int z = std::max(z0 - 1, 0); z < std::min(z1 + 1, terrain.sizeZ); z++)
+        {
+            minY = std::min(minY, terrain.heightMap[x][z]);
+            maxY = std::max(maxY, terrain.heightMap[x][z]);
+        }
+    }
+    for (int x = x0; x < x1; x++)
+    {
+        for (int z = z0; z < z1; z++)
+        {
+            if (terrain.floatMap[x][z] != 0)
+            {
+                minY = std::min(minY, terrain.floatMap[x][z] - 1);
+                maxY = std::max(maxY, terrain.floatMap[x][z]);
+            }
+        }
+    }
+    const float midY = (minY + maxY) * 0.5f;
+
+    Chunk chunk;
+    chunk.boundsMin = Vector3((float)x0, (float)minY, (float)z0);
+    chunk.boundsMax = Vector3((float)x1, (float)maxY, (float)z1);
+    chunk.firstPiece = static_cast<uint32_t>(pieces.size());
+
+    // Surface strips: runs of equal height along z, split at the chunk edge
+    const int stripEnd = std::min(z1, sz);
+    for (int jx = x0; jx < std::min(x1, sx); jx++)
+    {
+        int start = z0;
+        for (int jz = z0; jz < stripEnd; jz++)
+        {
+            const int height = terrain.heightMap[jx][jz];
+            if (jz + 1 < stripEnd && terrain.heightMap[jx][jz + 1] == height)
+            {
+                continue;
+            }
+
+            // RenderTerrainQuad draws nothing for the others
+            if (height >= 0 && height < 25)
+            {
+                QueuedPiece piece = { PIECE_SURFACE_STRIP, 0, (uint8_t)GetSurfaceTexture(terrain.levelNumber, height),
+                                      DrawState::LIT, (int16_t)jx, (int16_t)(jz + 1), (int16_t)height,
+                                      (int16_t)(jz + 1 - start), Vector3(jx + 0.5f, (float)height, (start + jz + 1) * 0.5f) };
+                pieces.push_back(piece);
+            }
+            start = jz + 1;
+        }
+    }
+
+    // Wall segments of the rows crossing the chunk, skipping those without a step
+    for (int direction = 0; direction < 4; direction++)
+    {
+        const bool rowsAlongZ = direction < 2;
+        const int rowBegin = rowsAlongZ ? x0 : z0;
+        const int rowEnd = rowsAlongZ ? x1 : z1;
+        const int begin = rowsAlongZ ? z0 : x0;
+        const int end = rowsAlongZ ? z1 : x1;
+
+        for (int row = rowBegin; row < rowEnd; row++)
+        {
+            bool hasWalls = false;
+            ForEachWallQuad(terrain, direction, row, begin, end,
+                            [&hasWalls](int, int, int, int) { hasWalls = true; });
+            if (!hasWalls)
+            {
+                continue;
+            }
+
+            const Vector3 center = rowsAlongZ ? Vector3(row + 0.5f, midY, (begin + end) * 0.5f)
+                                              : Vector3((begin + end) * 0.5f, midY, row + 0.5f);
+            QueuedPiece piece = { PIECE_WALL_SEGMENT, (uint8_t)direction, TEXTURE_BLACK, DrawState::LIT,
+                                  (int16_t)(rowsAlongZ ? row : 0), (int16_t)(rowsAlongZ ? 0 : row),
+                                  (int16_t)begin, (int16_t)end, center };
+            pieces.push_back(piece);
+        }
+    }
+
+    // Floating blocks
+    for (int q = x0; q < x1; q++)
+    {
+        for (int w = z0; w < z1; w++)
+        {
+            if (terrain.floatMap[q][w] != 0)
+            {
+                QueuedPiece piece = { PIECE_FLOATING_BLOCK, 0, TEXTURE_BLACK, DrawState::LIT_CCW,
+                                      (int16_t)q, (int16_t)w, (int16_t)terrain.floatMap[q][w], 0,
+                                      Vector3(q + 0.5f, terrain.floatMap[q][w] - 0.5f, w + 0.5f) };
+                pieces.push_back(piece);
+            }
+        }
+    }
+
+    chunk.pieceCount = static_cast<uint32_t>(pieces.size()) - chunk.firstPiece;
+    if (chunk.pieceCount > 0)
+    {
+        chunks.push_back(chunk);
+    }
+}
+
+int TerrainRenderer::Submit(RenderQueue &queue, const Vector3 &eye, const Frustum &frustum, float drawDistance)
+{
+    const float maxDistanceSquared = drawDistance * drawDistance;
+    int visibleChunks = 0;
+    for (const Chunk &chunk : chunks)
+    {
+        if (!frustum.IntersectsBox(chunk.boundsMin, chunk.boundsMax))
+        {
+            continue;
+        }
+        if (drawDistance > 0.0f)
+        {
+            // Nearest point of the chunk's footprint
+            const float dx = eye.x - std::min(std::max(eye.x, chunk.boundsMin.x), chunk.boundsMax.x);
+            const float dz = eye.z - std::min(std::max(eye.z, chunk.boundsMin.z), chunk.boundsMax.z);
+            if (dx * dx + dz * dz > maxDistanceSquared)
+            {
+                continue;
+            }
+        }
+        visibleChunks++;
+        for (uint32_t i = chunk.firstPiece; i < chunk.firstPiece + chunk.pieceCount; i++)
+        {
+            QueuePiece(queue, i, eye);
+        }
+    }
+
+    for (uint32_t i = firstSharedPiece; i < pieces.size(); i++)
+    {
+        QueuePiece(queue, i, eye);
+    }
+    return visibleChunks;
+}
+
+void TerrainRenderer::QueuePiece(RenderQueue &queue, uint32_t index, const Vector3 &eye)
+{
+    const QueuedPiece &piece = pieces[index];
+    const RenderLayer layer = piece.kind == PIECE_WATER ? RenderLayer::TRANSPARENT : RenderLayer::OPAQUE;
+
+    // Boundary walls enclose the view, so they go last among the opaque pieces
+    const float distance = piece.kind == PIECE_BOUNDARY
+                               ? RenderQueue::MAX_DEPTH
+                               : RenderQueue::Distance(eye, piece.center.x, piece.center.y, piece.center.z);
+    queue.Submit(RenderQueue::MakeKey(layer, piece.state, piece.texture + 1, distance, piece.kind), this, index);
+}
+
+void TerrainRenderer::DrawPacket(uint32_t item)
+{
+    const QueuedPiece &piece = pieces[item];
+    const TerrainRenderData &terrain = *currentTerrainData;
+
+    // Other queued geometry may have left any normal behind
+    glNormal3f(0, 1, 0);
+
+    switch (piece.kind)
+    {
+    case PIECE_SURFACE_STRIP:
+        RenderTerrainQuad(piece.x, piece.z, piece.height, piece.length);
+        break;
+
+    case PIECE_WALL_SEGMENT:
+        RenderWallRow(terrain, piece.direction, piece.direction < 2 ? piece.x : piece.z, piece.height, piece.length);
+        break;
+
+    case PIECE_FLOATING_BLOCK:
+        glColor3f(terrain.colors.blockColor.x, terrain.colors.blockColor.y, terrain.colors.blockColor.z);
+        glPushMatrix();
+        glTranslatef(piece.x + 0.5f, piece.height - 0.5f, piece.z + 0.5f);
+        if (App::GetSingleton().graphicsTask)
+        {
+            App::GetSingleton().graphicsTask->cubelist1.Call(0);
+        }
+        glPopMatrix();
+        break;
+
+    case PIECE_BOUNDARY:
+        glPushMatrix();
+        if (terrain.levelNumber == 48)
+        {
+            glTranslatef(0, -30, 0);
+        }
+        RenderBoundaryGeometry(terrain);
+        glPopMatrix();
+        break;
+
+    case PIECE_WATER:
+        glColor4f(terrain.colors.defaultColor.x, terrain.colors.defaultColor.y, terrain.colors.defaultColor.z, 0.5f);
+        RenderWaterDirection(terrain, piece.direction);
+        break;
+    }
+}
+
 void TerrainRenderer::RenderFloatingElements(const TerrainRenderData &terrain)
 {
-    glFrontFace(GL_CCW);
+    GLStateCache::Get().FrontFace(GL_CCW);
     glColor3f(terrain.colors.blockColor.x, terrain.colors.blockColor.y, terrain.colors.blockColor.z);
 
     // Use surface texture for floating elements to match the terrain surface
@@ -121,7 +433,7 @@ void TerrainRenderer::RenderFloatingElements(const TerrainRenderData &terrain)
         }
     }
 
-    glFrontFace(GL_CW);
+    GLStateCache::Get().FrontFace(GL_CW);
 }
 
 void TerrainRenderer::RenderTerrainSurface(const TerrainRenderData &terrain)
@@ -167,74 +479,60 @@ void TerrainRenderer::RenderTerrainWalls(const TerrainRenderData &terrain)
     // Render walls in X direction (front faces)
     for (int ix = 0; ix <= sx; ix++)
     {
-        int lastY = 0;
-        for (int iz = 0; iz <= sz; iz++)
-        {
-            if (terrain.heightMap[ix][iz] != lastY && iz != sz && ix != 0)
-            {
-                RenderWallQuad(ix, iz, lastY, terrain.heightMap[ix][iz], 0);
-            }
-            lastY = terrain.heightMap[ix][iz];
-        }
+        RenderWallRow(terrain, 0, ix, 0, terrain.sizeZ);
     }
 
     // Render walls in X direction (back faces)
     for (int ix = sx; ix > 0; ix--)
     {
-        int lastY = 0;
-        for (int iz = sz - 1; iz > 0; iz--)
-        {
-            if (terrain.heightMap[ix][iz] != lastY && ix != sx)
-            {
-                RenderWallQuad(ix, iz, lastY, terrain.heightMap[ix][iz], 1);
-            }
-            lastY = terrain.heightMap[ix][iz];
-        }
+        RenderWallRow(terrain, 1, ix, 0, terrain.sizeZ);
     }
 
     // Render walls in Z direction (left faces)
     for (int iz = 0; iz < sz; iz++)
     {
-        int lastY = 0;
-        for (int ix = 0; ix <= sx; ix++)
-        {
-            if (terrain.heightMap[ix][iz] != lastY && ix != sx && iz != 0)
-            {
-                RenderWallQuad(ix, iz, lastY, terrain.heightMap[ix][iz], 2);
-            }
-            lastY = terrain.heightMap[ix][iz];
-        }
+        RenderWallRow(terrain, 2, iz, 0, terrain.sizeX);
     }
 
     // Render walls in Z direction (right faces)
     for (int iz = sz; iz > 0; iz--)
     {
-        int lastY = 0;
-        for (int ix = sx; ix >= 0; ix--)
-        {
-            if (terrain.heightMap[ix][iz] != lastY && ix != 0)
-            {
-                RenderWallQuad(ix, iz, lastY, terrain.heightMap[ix][iz], 3);
-            }
-            lastY = terrain.heightMap[ix][iz];
-        }
+        RenderWallRow(terrain, 3, iz, 0, terrain.sizeX);
     }
 }
 
-void TerrainRenderer::RenderBoundaryWalls(const TerrainRenderData &terrain)
+void TerrainRenderer::RenderWallRow(const TerrainRenderData &terrain, int direction, int row, int begin, int end)
 {
-    int sx = terrain.sizeX - 1;
-    int sz = terrain.sizeZ - 1;
-
-    glColor3f(terrain.colors.defaultColor.x, terrain.colors.defaultColor.y, terrain.colors.defaultColor.z);
+    ForEachWallQuad(terrain, direction, row, begin, end,
+                    [this, direction](int ix, int iz, int lastY, int currentY)
+                    { RenderWallQuad(ix, iz, lastY, currentY, direction); });
+}
 
+void TerrainRenderer::RenderBoundaryWalls(const TerrainRenderData &terrain)
+{
     // Special handling for level 48 (underground level)
     if (terrain.levelNumber == 48)
     {
         glTranslatef(0, -30, 0);
-        glFrontFace(GL_CCW);
+        GLStateCache::Get().FrontFace(GL_CCW);
     }
 
+    RenderBoundaryGeometry(terrain);
+
+    // Restore translation for level 48
+    if (terrain.levelNumber == 48)
+    {
+        glTranslatef(0, 30, 0);
+    }
+}
+
+void TerrainRenderer::RenderBoundaryGeometry(const TerrainRenderData &terrain)
+{
+    int sx = terrain.sizeX - 1;
+    int sz = terrain.sizeZ - 1;
+
+    glColor3f(terrain.colors.defaultColor.x, terrain.colors.defaultColor.y, terrain.colors.defaultColor.z);
+
     // Top ceiling (for non-open levels)
     if (terrain.levelNumber != 48)
     {
@@ -306,30 +604,21 @@ void TerrainRenderer::RenderBoundaryWalls(const TerrainRenderData &terrain)
     glTexCoord2f(0, 0);
     glVertex3f(1.0f, 0.0f, sz);
     glEnd();
-
-    // Restore translation for level 48
-    if (terrain.levelNumber == 48)
-    {
-        glTranslatef(0, 30, 0);
-    }
 }
 
 void TerrainRenderer::RenderWaterEffects(const TerrainRenderData &terrain)
 {
-    int sx = terrain.sizeX - 1;
-    int sz = terrain.sizeZ - 1;
-
     // Enable blending for water effects
-    glEnable(GL_BLEND);
-    glEnable(GL_DEPTH_TEST);
-    glDisable(GL_CULL_FACE);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-    glDepthMask(GL_FALSE);
+    GLStateCache::Get().Enable(GL_BLEND);
+    GLStateCache::Get().Enable(GL_DEPTH_TEST);
+    GLStateCache::Get().Disable(GL_CULL_FACE);
+    GLStateCache::Get().BlendFunc(GL_SRC_ALPHA, GL_ONE);
+    GLStateCache::Get().DepthMask(GL_FALSE);
 
     // Bind water texture
     if (App::GetSingleton().graphicsTask)
     {
-        glBindTexture(GL_TEXTURE_2D,
+        GLStateCache::Get().BindTexture(
                       App::GetSingleton().graphicsTask->textureHandler.GetTextureArray()[TEXTURE_BLEND]);
     }
 
@@ -338,87 +627,95 @@ void TerrainRenderer::RenderWaterEffects(const TerrainRenderData &terrain)
     // Render water effects for negative height areas
     for (int direction = 0; direction < 4; direction++)
     {
-        int lastY = 0;
+        RenderWaterDirection(terrain, direction);
+    }
+
+    // Restore OpenGL state
+    glColor3f(terrain.colors.defaultColor.x, terrain.colors.defaultColor.y, terrain.colors.defaultColor.z);
+    GLStateCache::Get().Disable(GL_BLEND);
+    GLStateCache::Get().DepthMask(GL_TRUE);
+    GLStateCache::Get().Enable(GL_CULL_FACE);
+}
+
+void TerrainRenderer::RenderWaterDirection(const TerrainRenderData &terrain, int direction)
+{
+    int sx = terrain.sizeX - 1;
+    int sz = terrain.sizeZ - 1;
 
-        if (direction == 0)
+    int lastY = 0;
+
+    if (direction == 0)
+    {
+        // X direction forward
+        for (int ix = 0; ix <= sx; ix++)
         {
-            // X direction forward
-            for (int ix = 0; ix <= sx; ix++)
+            for (int iz = 0; iz <= sz; iz++)
             {
-                for (int iz = 0; iz <= sz; iz++)
+                if (terrain.heightMap[ix][iz] != lastY && iz != sz)
                 {
-                    if (terrain.heightMap[ix][iz] != lastY && iz != sz)
+                    if (terrain.heightMap[ix][iz] < 0)
                     {
-                        if (terrain.heightMap[ix][iz] < 0)
-                        {
-                            RenderBlendQuad(ix, iz, lastY, direction);
-                        }
+                        RenderBlendQuad(ix, iz, lastY, direction);
                     }
-                    lastY = terrain.heightMap[ix][iz];
                 }
+                lastY = terrain.heightMap[ix][iz];
             }
         }
-        else if (direction == 1)
+    }
+    else if (direction == 1)
+    {
+        // X direction backward
+        for (int ix = sx; ix > 0; ix--)
         {
-            // X direction backward
-            for (int ix = sx; ix > 0; ix--)
+            for (int iz = sz - 1; iz > 0; iz--)
             {
-                for (int iz = sz - 1; iz > 0; iz--)
+                if (terrain.heightMap[ix][iz] != lastY)
                 {
-                    if (terrain.heightMap[ix][iz] != lastY)
+                    if (terrain.heightMap[ix][iz] < 0)
                     {
-                        if (terrain.heightMap[ix][iz] < 0)
-                        {
-                            RenderBlendQuad(ix, iz, lastY, direction);
-                        }
+                        RenderBlendQuad(ix, iz, lastY, direction);
                     }
-                    lastY = terrain.heightMap[ix][iz];
                 }
+                lastY = terrain.heightMap[ix][iz];
             }
         }
-        else if (direction == 2)
+    }
+    else if (direction == 2)
+    {
+        // Z direction forward
+        for (int iz = 0; iz < sz; iz++)
         {
-            // Z direction forward
-            for (int iz = 0; iz < sz; iz++)
+            for (int ix = 0; ix <= sx; ix++)
             {
-                for (int ix = 0; ix <= sx; ix++)
+                if (terrain.heightMap[ix][iz] != lastY && ix != sx)
                 {
-                    if (terrain.heightMap[ix][iz] != lastY && ix != sx)
+                    if (terrain.heightMap[ix][iz] < 0)
                     {
-                        if (terrain.heightMap[ix][iz] < 0)
-                        {
-                            RenderBlendQuad(ix, iz, lastY, direction);
-                        }
+                        RenderBlendQuad(ix, iz, lastY, direction);
                     }
-                    lastY = terrain.heightMap[ix][iz];
                 }
+                lastY = terrain.heightMap[ix][iz];
             }
         }
-        else if (direction == 3)
+    }
+    else if (direction == 3)
+    {
+        // Z direction backward
+        for (int iz = sz; iz > 0; iz--)
         {
-            // Z direction backward
-            for (int iz = sz; iz > 0; iz--)
+            for (int ix = sx; ix >= 0; ix--)
             {
-                for (int ix = sx; ix >= 0; ix--)
+                if (terrain.heightMap[ix][iz] != lastY && ix != 0)
                 {
-                    if (terrain.heightMap[ix][iz] != lastY && ix != 0)
+                    if (terrain.heightMap[ix][iz] < 0)
                     {
-                        if (terrain.heightMap[ix][iz] < 0)
-                        {
-                            RenderBlendQuad(ix, iz, lastY, direction);
-                        }
+                        RenderBlendQuad(ix, iz, lastY, direction);
                     }
-                    lastY = terrain.heightMap[ix][iz];
                 }
+                lastY = terrain.heightMap[ix][iz];
             }
         }
     }
-
-    // Restore OpenGL state
-    glColor3f(terrain.colors.defaultColor.x, terrain.colors.defaultColor.y, terrain.colors.defaultColor.z);
-    glDisable(GL_BLEND);
-    glDepthMask(GL_TRUE);
-    glEnable(GL_CULL_FACE);
 }
 
 void TerrainRenderer::SetupTerrainColors(const TerrainRenderData &terrain)
@@ -504,35 +801,22 @@ void TerrainRenderer::BindSurfaceTexture(int levelNumber, int currentHeight)
     }
 
     auto *textureArray = App::GetSingleton().graphicsTask->textureHandler.GetTextureArray();
+    GLStateCache::Get().BindTexture(textureArray[GetSurfaceTexture(levelNumber, currentHeight)]);
+}
 
+int TerrainRenderer::GetSurfaceTexture(int levelNumber, int currentHeight)
+{
     // Select surface texture based on level
     // For title screen (level 0 and some others), use checker pattern for top surface
     if (levelNumber == 0 || levelNumber == 50 || levelNumber == 56 || levelNumber == 57 || levelNumber == 58)
     {
-        if(currentHeight == 0)
-        {
-            glBindTexture(GL_TEXTURE_2D, textureArray[TEXTURE_BLACK]);
-        }
-        else
-        {
-            glBindTexture(GL_TEXTURE_2D, textureArray[TEXTURE_CHECKER]);
-        }
+        return currentHeight == 0 ? TEXTURE_BLACK : TEXTURE_CHECKER;
     }
     else if (levelNumber == 48 || levelNumber == 70 || levelNumber == 69)
     {
-        if(currentHeight == 0)
-        {
-            glBindTexture(GL_TEXTURE_2D, textureArray[TEXTURE_BLACK]);
-        }
-        else
-        {
-            glBindTexture(GL_TEXTURE_2D, textureArray[TEXTURE_WHITE]);
-        }
-    }
-    else
-    {
-        glBindTexture(GL_TEXTURE_2D, textureArray[TEXTURE_BLACK]);
+        return currentHeight == 0 ? TEXTURE_BLACK : TEXTURE_WHITE;
     }
+    return TEXTURE_BLACK;
 }
 
 void TerrainRenderer::BindWallTexture(int levelNumber)
@@ -544,7 +828,7 @@ void TerrainRenderer::BindWallTexture(int levelNumber)
 
     auto *textureArray = App::GetSingleton().graphicsTask->textureHandler.GetTextureArray();
     
-    glBindTexture(GL_TEXTURE_2D, textureArray[TEXTURE_BLACK]);
+    GLStateCache::Get().BindTexture(textureArray[TEXTURE_BLACK]);
 
 }
 
@@ -2,6 +2,10 @@
 #define TERRAINRENDERER_H
 
 #include "BaseRenderer.h"
+#include "RenderQueue.h"
+#include "Frustum.h"
+#include <cstdint>
+#include <vector>
 
 // Forward declaration
 struct TerrainRenderData;
@@ -14,7 +18,7 @@ struct TerrainRenderData;
  * found in LevelHandler::DrawTerrain(), providing a clean separation
  * between game logic and rendering.
  */
-class TerrainRenderer : public BaseRenderer
+class TerrainRenderer : public BaseRenderer, public IQueuedRenderer
 {
 public:
     TerrainRenderer();
@@ -27,6 +31,23 @@ public:
     // Terrain-specific rendering method
     void RenderTerrain(const TerrainRenderData &terrainData);
 
+    // Split the terrain into CHUNK_SIZE x CHUNK_SIZE chunks of surface
+    // strips, wall segments and floating blocks with their bounding boxes.
+    // Once per frame, before the views submit; the terrain data must stay
+    // alive until the last view has executed.
+    void BuildChunks(const TerrainRenderData &terrainData);
+
+    // Queue the chunks inside the frustum and, with a positive drawDistance,
+    // within that ground distance of the eye; then the boundary walls and
+    // the water. Returns the number of chunks queued.
+    int Submit(RenderQueue &queue, const Vector3 &eye, const Frustum &frustum, float drawDistance = 0.0f);
+    void DrawPacket(uint32_t item) override;
+    RenderSource GetRenderSource() const override { return RenderSource::TERRAIN; }
+
+    int GetChunkCount() const { return static_cast<int>(chunks.size()); }
+
+    static constexpr int CHUNK_SIZE = 16;
+
 protected:
     // Override render state setup to disable lighting for terrain
     void Setup3DRenderState();
@@ -38,10 +59,14 @@ private:
     void RenderTerrainWalls(const TerrainRenderData &terrain);
     void RenderBoundaryWalls(const TerrainRenderData &terrain);
     void RenderWaterEffects(const TerrainRenderData &terrain);
+    void RenderWallRow(const TerrainRenderData &terrain, int direction, int row, int begin, int end);
+    void RenderWaterDirection(const TerrainRenderData &terrain, int direction);
+    void RenderBoundaryGeometry(const TerrainRenderData &terrain);
 
     // Utility functions
     void SetupTerrainColors(const TerrainRenderData &terrain);
     void BindSurfaceTexture(int levelNumber,int currentHeight);
+    static int GetSurfaceTexture(int levelNumber, int currentHeight);
     void BindWallTexture(int levelNumber);
     void RenderTerrainQuad(int x, int z, int height, int strips, bool isLast = false);
     void RenderWallQuad(int ix, int iz, int lastY, int currentY, int direction);
@@ -68,6 +93,46 @@ private:
         TEXTURE_BLEND = 12
     };
 
+    // A piece of terrain; DrawPacket items index pieces
+    enum PieceKind : uint8_t
+    {
+        PIECE_SURFACE_STRIP,
+        PIECE_WALL_SEGMENT,
+        PIECE_FLOATING_BLOCK,
+        PIECE_BOUNDARY,
+        PIECE_WATER
+    };
+
+    struct QueuedPiece
+    {
+        PieceKind kind;
+        uint8_t direction;      // Walls and water
+        uint8_t texture;        // TextureHandler slot
+        DrawState state;
+        int16_t x;              // Strip column, wall row (directions 0, 1), block cell
+        int16_t z;              // Strip end, wall row (directions 2, 3), block cell
+        int16_t height;         // Strip and block height, first wall cell
+        int16_t length;         // Strip cells, wall cell after the last
+        Vector3 center;         // Sort depth is measured from here
+    };
+
+    struct Chunk
+    {
+        Vector3 boundsMin;
+        Vector3 boundsMax;
+        uint32_t firstPiece;
+        uint32_t pieceCount;
+    };
+
+    // Rebuilt by every BuildChunks, kept to reuse capacity. The pieces
+    // past the last chunk's are drawn by every view.
+    std::vector<QueuedPiece> pieces;
+    std::vector<Chunk> chunks;
+    uint32_t firstSharedPiece = 0;
+
+    void BuildChunk(const TerrainRenderData &terrain, int x0, int z0, int x1, int z1);
+    void QueuePiece(RenderQueue &queue, uint32_t index, const Vector3 &eye);
+
     // Cached display list for cube rendering (floating elements)
     bool displayListInitialized;
 
@@ -15,7 +15,7 @@ ViewportManager::ViewportManager()
 {
     // Initialize with single default viewport
     viewports.clear();
-    viewports.reserve(2); // Maximum 2 players supported
+    viewports.reserve(MAX_VIEWPORTS);
 }
 
 void ViewportManager::SetupSinglePlayer(int screenWidth, int screenHeight)
@@ -43,30 +43,38 @@ void ViewportManager::SetupSplitScreen(int numPlayers, int screenWidth, int scre
         return;
     }
 
-    // Currently support up to 2 players
-    numPlayers = std::min(numPlayers, 2);
+    numPlayers = std::min(numPlayers, static_cast<int>(MAX_VIEWPORTS));
 
     if (numPlayers == 2)
     {
         CreateHorizontalSplitViewports(screenWidth, screenHeight);
     }
+    else
+    {
+        CreateQuadViewports(numPlayers, screenWidth, screenHeight);
+    }
 
     currentViewport = 0;
     ValidateViewports();
 }
 
-void ViewportManager::SetActiveViewport(int playerIndex)
+void ViewportManager::SetActiveViewport(int playerIndex, float scale)
 {
     if (playerIndex >= 0 && playerIndex < static_cast<int>(viewports.size()))
     {
         currentViewport = playerIndex;
-        const Viewport &viewport = viewports[playerIndex];
+        const Viewport viewport = scale < 1.0f ? viewports[playerIndex].Scaled(scale) : viewports[playerIndex];
 
         // Set OpenGL viewport
         glViewport(viewport.x, viewport.y, viewport.width, viewport.height);
     }
 }
 
+void ViewportManager::SetFullScreenViewport()
+{
+    glViewport(0, 0, screenWidth, screenHeight);
+}
+
 const Viewport &ViewportManager::GetViewport(int playerIndex) const
 {
     assert(playerIndex >= 0 && playerIndex < static_cast<int>(viewports.size()));
@@ -104,6 +112,21 @@ void ViewportManager::CreateVerticalSplitViewports(int screenWidth, int screenHe
     viewports.emplace_back(halfWidth, 0, halfWidth, screenHeight);
 }
 
+void ViewportManager::CreateQuadViewports(int numPlayers, int screenWidth, int screenHeight)
+{
+    // Screen quarters in reading order: players 0 and 1 on top, 2 and 3
+    // below. With three players the bottom right quarter stays empty.
+    int halfWidth = screenWidth / 2;
+    int halfHeight = screenHeight / 2;
+
+    for (int i = 0; i < numPlayers; i++)
+    {
+        int column = i % 2;
+        int row = i / 2;
+        viewports.emplace_back(column * halfWidth, (1 - row) * halfHeight, halfWidth, halfHeight);
+    }
+}
+
 void ViewportManager::ValidateViewports()
 {
     // Remove any invalid viewports
@@ -1,6 +1,7 @@
 #ifndef VIEWPORTMANAGER_H
 #define VIEWPORTMANAGER_H
 
+#include <algorithm>
 #include <vector>
 
 /**
@@ -27,6 +28,16 @@ struct Viewport
     {
         return width > 0 && height > 0;
     }
+
+    // The same region of a render target scale times the window's size
+    Viewport Scaled(float scale) const
+    {
+        const int left = static_cast<int>(x * scale + 0.5f);
+        const int bottom = static_cast<int>(y * scale + 0.5f);
+        return Viewport(left, bottom,
+                        std::max(1, static_cast<int>((x + width) * scale + 0.5f) - left),
+                        std::max(1, static_cast<int>((y + height) * scale + 0.5f) - bottom));
+    }
 };
 
 /**
@@ -36,6 +47,8 @@ struct Viewport
 class ViewportManager
 {
 public:
+    static constexpr int MAX_VIEWPORTS = 4;
+
     ViewportManager();
     ~ViewportManager() = default;
 
@@ -43,8 +56,12 @@ public:
     void SetupSinglePlayer(int screenWidth, int screenHeight);
     void SetupSplitScreen(int numPlayers, int screenWidth, int screenHeight);
 
-    // Set the active viewport for OpenGL rendering
-    void SetActiveViewport(int playerIndex);
+    // Set the active viewport for OpenGL rendering; a scale below 1 maps it
+    // into the matching corner of a smaller scene render target
+    void SetActiveViewport(int playerIndex, float scale = 1.0f);
+
+    // Cover the whole window, for overlays shared by all players
+    void SetFullScreenViewport();
 
     // Get viewport information
     const Viewport &GetViewport(int playerIndex) const;
@@ -66,6 +83,7 @@ private:
     // Helper methods for viewport calculation
     void CreateHorizontalSplitViewports(int screenWidth, int screenHeight);
     void CreateVerticalSplitViewports(int screenWidth, int screenHeight);
+    void CreateQuadViewports(int numPlayers, int screenWidth, int screenHeight);
     void ValidateViewports();
 };
 
@@ -0,0 +1,39 @@
+#include "CoreGL.h"
+#include "../../Logger.h"
+
+#include <SDL2/SDL.h>
+
+namespace CoreGL {
+#define CORE_GL_DEFINE(type, name) type name = nullptr;
+    CORE_GL_FUNCTIONS(CORE_GL_DEFINE)
+#undef CORE_GL_DEFINE
+
+    namespace {
+        bool loaded = false;
+    }
+
+    bool Load(ProcAddressLoader loader)
+    {
+        loaded = false;
+        if (!loader)
+        {
+            loader = SDL_GL_GetProcAddress;
+        }
+#define CORE_GL_LOAD(type, name) \
+        name = reinterpret_cast<type>(loader("gl" #name)); \
+        if (!name) \
+        { \
+            Logger::Get().Write("CoreGL: gl%s is not available\n", #name); \
+            return false; \
+        }
+        CORE_GL_FUNCTIONS(CORE_GL_LOAD)
+#undef CORE_GL_LOAD
+        loaded = true;
+        return true;
+    }
+
+    bool IsLoaded()
+    {
+        return loaded;
+    }
+}
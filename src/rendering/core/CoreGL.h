@@ -0,0 +1,66 @@
+#pragma once
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <SDL2/SDL_opengl.h>
+
+/**
+ * OpenGL 3.3 core entry points used by the core-profile backend.
+ *
+ * Only GL 1.1 is exported by every platform's GL library; everything newer
+ * (buffers, vertex arrays, shaders, uniform blocks, instancing) has to be
+ * looked up from the current context. Load() does that once after the
+ * context exists and reports whether all of them were found.
+ *
+ * Calls read like the GL names without the prefix: CoreGL::BindBuffer(...).
+ */
+#define CORE_GL_FUNCTIONS(X) \
+    X(PFNGLGENVERTEXARRAYSPROC, GenVertexArrays) \
+    X(PFNGLDELETEVERTEXARRAYSPROC, DeleteVertexArrays) \
+    X(PFNGLBINDVERTEXARRAYPROC, BindVertexArray) \
+    X(PFNGLGENBUFFERSPROC, GenBuffers) \
+    X(PFNGLDELETEBUFFERSPROC, DeleteBuffers) \
+    X(PFNGLBINDBUFFERPROC, BindBuffer) \
+    X(PFNGLBUFFERDATAPROC, BufferData) \
+    X(PFNGLBUFFERSUBDATAPROC, BufferSubData) \
+    X(PFNGLBINDBUFFERBASEPROC, BindBufferBase) \
+    X(PFNGLVERTEXATTRIBPOINTERPROC, VertexAttribPointer) \
+    X(PFNGLENABLEVERTEXATTRIBARRAYPROC, EnableVertexAttribArray) \
+    X(PFNGLVERTEXATTRIBDIVISORPROC, VertexAttribDivisor) \
+    X(PFNGLDRAWARRAYSINSTANCEDPROC, DrawArraysInstanced) \
+    X(PFNGLCREATESHADERPROC, CreateShader) \
+    X(PFNGLSHADERSOURCEPROC, ShaderSource) \
+    X(PFNGLCOMPILESHADERPROC, CompileShader) \
+    X(PFNGLGETSHADERIVPROC, GetShaderiv) \
+    X(PFNGLGETSHADERINFOLOGPROC, GetShaderInfoLog) \
+    X(PFNGLDELETESHADERPROC, DeleteShader) \
+    X(PFNGLCREATEPROGRAMPROC, CreateProgram) \
+    X(PFNGLATTACHSHADERPROC, AttachShader) \
+    X(PFNGLBINDATTRIBLOCATIONPROC, BindAttribLocation) \
+    X(PFNGLBINDFRAGDATALOCATIONPROC, BindFragDataLocation) \
+    X(PFNGLLINKPROGRAMPROC, LinkProgram) \
+    X(PFNGLGETPROGRAMIVPROC, GetProgramiv) \
+    X(PFNGLGETPROGRAMINFOLOGPROC, GetProgramInfoLog) \
+    X(PFNGLDELETEPROGRAMPROC, DeleteProgram) \
+    X(PFNGLUSEPROGRAMPROC, UseProgram) \
+    X(PFNGLGETUNIFORMLOCATIONPROC, GetUniformLocation) \
+    X(PFNGLUNIFORM2FPROC, Uniform2f) \
+    X(PFNGLUNIFORM1FPROC, Uniform1f) \
+    X(PFNGLGETUNIFORMBLOCKINDEXPROC, GetUniformBlockIndex) \
+    X(PFNGLUNIFORMBLOCKBINDINGPROC, UniformBlockBinding)
+
+namespace CoreGL {
+#define CORE_GL_DECLARE(type, name) extern type name;
+    CORE_GL_FUNCTIONS(CORE_GL_DECLARE)
+#undef CORE_GL_DECLARE
+
+    // Entry point lookup of the context's GL library
+    typedef void* (*ProcAddressLoader)(const char* name);
+
+    // Look up every entry point from the current context, through SDL
+    // unless another loader is given (headless EGL contexts); false (and a
+    // log line naming the first missing one) if any is absent
+    bool Load(ProcAddressLoader loader = nullptr);
+    bool IsLoaded();
+}
@@ -0,0 +1,279 @@
+#include "CoreGeometry.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Heights at or above this are solid rock reaching the ceiling; their
+    // tops are never seen (TerrainRenderer skips them too)
+    const int SOLID_HEIGHT = 25;
+    const float BOUNDARY_HEIGHT = 30.0f;
+    const float CEILING_HEIGHT = 26.0f;
+    const int OPEN_LEVEL = 48;          // Open sky, walls lowered by BOUNDARY_HEIGHT
+
+    Vector3 Sub(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    Vector3 Cross(const Vector3& a, const Vector3& b)
+    {
+        return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+    }
+
+    float Dot(const Vector3& a, const Vector3& b)
+    {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    Vector3 Normalize(const Vector3& v)
+    {
+        const float length = std::sqrt(Dot(v, v));
+        return length > 0.0f ? Vector3(v.x / length, v.y / length, v.z / length) : v;
+    }
+
+    uint8_t ToByte(float channel)
+    {
+        return static_cast<uint8_t>(std::min(std::max(channel, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    Color ToColor(const Vector3& rgb)
+    {
+        return Color(rgb.x, rgb.y, rgb.z, 1.0f);
+    }
+}
+
+Mat4 Mat4::Identity()
+{
+    Mat4 result;
+    for (int i = 0; i < 16; i++)
+    {
+        result.m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+    return result;
+}
+
+Mat4 Mat4::Perspective(float fovYDegrees, float aspect, float zNear, float zFar)
+{
+    // Same matrix as gluPerspective
+    const float f = 1.0f / std::tan(fovYDegrees * PI / 360.0f);
+    Mat4 result = Identity();
+    result.m[0] = f / aspect;
+    result.m[5] = f;
+    result.m[10] = (zFar + zNear) / (zNear - zFar);
+    result.m[11] = -1.0f;
+    result.m[14] = 2.0f * zFar * zNear / (zNear - zFar);
+    result.m[15] = 0.0f;
+    return result;
+}
+
+Mat4 Mat4::LookAt(const Vector3& eye, const Vector3& focus, const Vector3& up)
+{
+    // Same matrix as gluLookAt
+    const Vector3 f = Normalize(Sub(focus, eye));
+    const Vector3 s = Normalize(Cross(f, up));
+    const Vector3 u = Cross(s, f);
+
+    Mat4 result = Identity();
+    result.m[0] = s.x;  result.m[4] = s.y;  result.m[8] = s.z;
+    result.m[1] = u.x;  result.m[5] = u.y;  result.m[9] = u.z;
+    result.m[2] = -f.x; result.m[6] = -f.y; result.m[10] = -f.z;
+    result.m[12] = -Dot(s, eye);
+    result.m[13] = -Dot(u, eye);
+    result.m[14] = Dot(f, eye);
+    return result;
+}
+
+Mat4 Mat4::operator*(const Mat4& other) const
+{
+    Mat4 result;
+    for (int column = 0; column < 4; column++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++)
+            {
+                sum += m[k * 4 + row] * other.m[column * 4 + k];
+            }
+            result.m[column * 4 + row] = sum;
+        }
+    }
+    return result;
+}
+
+Mat4& Mat4::Translate(float x, float y, float z)
+{
+    for (int row = 0; row < 4; row++)
+    {
+        m[12 + row] += m[row] * x + m[4 + row] * y + m[8 + row] * z;
+    }
+    return *this;
+}
+
+Mat4& Mat4::Rotate(float degrees, float x, float y, float z)
+{
+    if (degrees == 0.0f)
+    {
+        return *this;
+    }
+
+    const Vector3 axis = Normalize(Vector3(x, y, z));
+    const float c = std::cos(degrees * PI / 180.0f);
+    const float s = std::sin(degrees * PI / 180.0f);
+    const float t = 1.0f - c;
+
+    Mat4 rotation = Identity();
+    rotation.m[0] = axis.x * axis.x * t + c;
+    rotation.m[1] = axis.y * axis.x * t + axis.z * s;
+    rotation.m[2] = axis.x * axis.z * t - axis.y * s;
+    rotation.m[4] = axis.x * axis.y * t - axis.z * s;
+    rotation.m[5] = axis.y * axis.y * t + c;
+    rotation.m[6] = axis.y * axis.z * t + axis.x * s;
+    rotation.m[8] = axis.x * axis.z * t + axis.y * s;
+    rotation.m[9] = axis.y * axis.z * t - axis.x * s;
+    rotation.m[10] = axis.z * axis.z * t + c;
+
+    *this = *this * rotation;
+    return *this;
+}
+
+Mat4& Mat4::Scale(float x, float y, float z)
+{
+    for (int row = 0; row < 4; row++)
+    {
+        m[row] *= x;
+        m[4 + row] *= y;
+        m[8 + row] *= z;
+    }
+    return *this;
+}
+
+void Mat4::TransformPoint(const Vector3& point, float out[4]) const
+{
+    for (int row = 0; row < 4; row++)
+    {
+        out[row] = m[row] * point.x + m[4 + row] * point.y + m[8 + row] * point.z + m[12 + row];
+    }
+}
+
+void CoreMeshBuilder::AddVertex(const Vector3& position, const Vector3& normal, const Color& color)
+{
+    CoreVertex vertex;
+    vertex.position[0] = position.x;
+    vertex.position[1] = position.y;
+    vertex.position[2] = position.z;
+    vertex.normal[0] = normal.x;
+    vertex.normal[1] = normal.y;
+    vertex.normal[2] = normal.z;
+    vertex.color[0] = ToByte(color.r);
+    vertex.color[1] = ToByte(color.g);
+    vertex.color[2] = ToByte(color.b);
+    vertex.color[3] = ToByte(color.a);
+    vertices.push_back(vertex);
+}
+
+void CoreMeshBuilder::AddTriangle(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& normal, const Color& color)
+{
+    AddVertex(a, normal, color);
+    if (Dot(Cross(Sub(b, a), Sub(c, a)), normal) < 0.0f)
+    {
+        AddVertex(c, normal, color);
+        AddVertex(b, normal, color);
+    }
+    else
+    {
+        AddVertex(b, normal, color);
+        AddVertex(c, normal, color);
+    }
+}
+
+void CoreMeshBuilder::AddQuad(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& d,
+                              const Vector3& normal, const Color& color)
+{
+    AddTriangle(a, b, c, normal, color);
+    AddTriangle(a, c, d, normal, color);
+}
+
+void CoreMeshBuilder::AddBox(const Vector3& min, const Vector3& max, const Color& color)
+{
+    const Vector3 p[8] = {
+        Vector3(min.x, min.y, min.z), Vector3(max.x, min.y, min.z),
+        Vector3(max.x, max.y, min.z), Vector3(min.x, max.y, min.z),
+        Vector3(min.x, min.y, max.z), Vector3(max.x, min.y, max.z),
+        Vector3(max.x, max.y, max.z), Vector3(min.x, max.y, max.z)};
+
+    AddQuad(p[3], p[2], p[6], p[7], Vector3(0, 1, 0), color);      // Top
+    AddQuad(p[0], p[1], p[5], p[4], Vector3(0, -1, 0), color);     // Bottom
+    AddQuad(p[1], p[2], p[6], p[5], Vector3(1, 0, 0), color);      // +X
+    AddQuad(p[0], p[3], p[7], p[4], Vector3(-1, 0, 0), color);     // -X
+    AddQuad(p[4], p[5], p[6], p[7], Vector3(0, 0, 1), color);      // +Z
+    AddQuad(p[0], p[1], p[2], p[3], Vector3(0, 0, -1), color);     // -Z
+}
+
+void CoreMeshBuilder::AddTerrain(const TerrainRenderData& terrain)
+{
+    const int sizeX = std::min(terrain.sizeX, static_cast<int>(TerrainRenderData::MAX_SIZE_X));
+    const int sizeZ = std::min(terrain.sizeZ, static_cast<int>(TerrainRenderData::MAX_SIZE_Z));
+    const Color surface = ToColor(terrain.colors.defaultColor);
+    const Color block = ToColor(terrain.colors.blockColor);
+
+    for (int x = 0; x < sizeX; x++)
+    {
+        for (int z = 0; z < sizeZ; z++)
+        {
+            const int height = terrain.heightMap[x][z];
+            const float y = static_cast<float>(height);
+
+            // Cell top; the ground level takes the block color like TerrainRenderer
+            if (height < SOLID_HEIGHT)
+            {
+                AddQuad(Vector3(x, y, z), Vector3(x + 1, y, z), Vector3(x + 1, y, z + 1), Vector3(x, y, z + 1),
+                        Vector3(0, 1, 0), height == 0 ? block : surface);
+            }
+
+            // Steps to the +X and +Z neighbours, facing the lower side
+            if (x + 1 < sizeX && terrain.heightMap[x + 1][z] != height)
+            {
+                const float other = static_cast<float>(terrain.heightMap[x + 1][z]);
+                const float facing = other < y ? 1.0f : -1.0f;
+                AddQuad(Vector3(x + 1, y, z), Vector3(x + 1, y, z + 1), Vector3(x + 1, other, z + 1), Vector3(x + 1, other, z),
+                        Vector3(facing, 0, 0), surface);
+            }
+            if (z + 1 < sizeZ && terrain.heightMap[x][z + 1] != height)
+            {
+                const float other = static_cast<float>(terrain.heightMap[x][z + 1]);
+                const float facing = other < y ? 1.0f : -1.0f;
+                AddQuad(Vector3(x, y, z + 1), Vector3(x + 1, y, z + 1), Vector3(x + 1, other, z + 1), Vector3(x, other, z + 1),
+                        Vector3(0, 0, facing), surface);
+            }
+
+            if (terrain.floatMap[x][z] != 0)
+            {
+                const float top = static_cast<float>(terrain.floatMap[x][z]);
+                AddBox(Vector3(x, top - 1.0f, z), Vector3(x + 1, top, z + 1), block);
+            }
+        }
+    }
+
+    // Boundary walls facing inwards, and the ceiling of closed levels
+    const float lastX = static_cast<float>(sizeX - 1);
+    const float lastZ = static_cast<float>(sizeZ - 1);
+    const float base = terrain.levelNumber == OPEN_LEVEL ? -BOUNDARY_HEIGHT : 0.0f;
+    const float top = base + BOUNDARY_HEIGHT;
+
+    AddQuad(Vector3(1, base, 1), Vector3(lastX, base, 1), Vector3(lastX, top, 1), Vector3(1, top, 1),
+            Vector3(0, 0, 1), surface);
+    AddQuad(Vector3(1, base, lastZ), Vector3(lastX, base, lastZ), Vector3(lastX, top, lastZ), Vector3(1, top, lastZ),
+            Vector3(0, 0, -1), surface);
+    AddQuad(Vector3(1, base, 1), Vector3(1, base, lastZ), Vector3(1, top, lastZ), Vector3(1, top, 1),
+            Vector3(1, 0, 0), surface);
+    AddQuad(Vector3(lastX, base, 1), Vector3(lastX, base, lastZ), Vector3(lastX, top, lastZ), Vector3(lastX, top, 1),
+            Vector3(-1, 0, 0), surface);
+
+    if (terrain.levelNumber != OPEN_LEVEL)
+    {
+        AddQuad(Vector3(1, CEILING_HEIGHT, 1), Vector3(lastX, CEILING_HEIGHT, 1),
+                Vector3(lastX, CEILING_HEIGHT, lastZ), Vector3(1, CEILING_HEIGHT, lastZ),
+                Vector3(0, -1, 0), surface);
+    }
+}
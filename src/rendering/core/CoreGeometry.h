@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../RenderData.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * Column-major 4x4 matrix for the core-profile backend (the layout GL and
+ * std140 expect). The chaining helpers multiply on the right like
+ * glTranslatef/glRotatef/glScalef, so fixed-function transform sequences
+ * port over call for call.
+ */
+struct Mat4 {
+    float m[16];
+
+    static Mat4 Identity();
+    static Mat4 Perspective(float fovYDegrees, float aspect, float zNear, float zFar);
+    static Mat4 LookAt(const Vector3& eye, const Vector3& focus, const Vector3& up);
+
+    Mat4 operator*(const Mat4& other) const;
+
+    Mat4& Translate(float x, float y, float z);
+    Mat4& Rotate(float degrees, float x, float y, float z);
+    Mat4& Scale(float x, float y, float z);
+
+    // Transform a point (w = 1); returns clip coordinates in out[4]
+    void TransformPoint(const Vector3& point, float out[4]) const;
+};
+
+/**
+ * Vertex of the retained meshes: position, normal and an 8-bit color that
+ * the shader multiplies with the per-instance color. A zero normal marks
+ * geometry that is drawn unlit (outlines, glows).
+ */
+struct CoreVertex {
+    float position[3];
+    float normal[3];
+    uint8_t color[4];
+};
+
+/**
+ * Per-instance data streamed each frame: model matrix and color.
+ */
+struct CoreInstance {
+    Mat4 model;
+    float color[4];
+};
+
+/**
+ * Builds triangle lists for the core-profile backend on the CPU. Faces are
+ * emitted counter-clockwise seen from the side their normal points to,
+ * whatever order the corners come in.
+ */
+class CoreMeshBuilder {
+public:
+    explicit CoreMeshBuilder(std::vector<CoreVertex>& vertices) : vertices(vertices) {}
+
+    void AddTriangle(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& normal, const Color& color);
+    void AddQuad(const Vector3& a, const Vector3& b, const Vector3& c, const Vector3& d,
+                 const Vector3& normal, const Color& color);
+    void AddBox(const Vector3& min, const Vector3& max, const Color& color);
+
+    // Top faces, height steps, floating blocks and the boundary walls of a
+    // level, in world space
+    void AddTerrain(const TerrainRenderData& terrain);
+
+private:
+    std::vector<CoreVertex>& vertices;
+
+    void AddVertex(const Vector3& position, const Vector3& normal, const Color& color);
+};
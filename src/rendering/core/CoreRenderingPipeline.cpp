@@ -0,0 +1,1003 @@
+#include "CoreRenderingPipeline.h"
+#include "../EnemyTankGeometry.h"
+#include "../MenuRenderer.h"
+#include "../../Logger.h"
+#include "../../profiling/FrameStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include "../GLProfile.h"
+
+namespace {
+    // Attribute locations shared by the shaders and the vertex array setup
+    enum : GLuint {
+        ATTRIB_POSITION = 0,
+        ATTRIB_NORMAL = 1,
+        ATTRIB_COLOR = 2,
+        ATTRIB_INSTANCE_MODEL = 3,      // Four columns: 3..6
+        ATTRIB_INSTANCE_COLOR = 7
+    };
+
+    const GLuint FRAME_BLOCK_BINDING = 0;
+
+    const char* MESH_VERTEX_SHADER = R"(#version 330 core
+layout(std140) uniform Frame {
+    mat4 viewProjection;
+    vec4 lightDirection;    // xyz: towards the light
+    vec4 lightColor;        // rgb: diffuse, a: ambient
+};
+in vec3 position;
+in vec3 normal;
+in vec4 color;
+in mat4 instanceModel;
+in vec4 instanceColor;
+out vec4 vertexColor;
+void main()
+{
+    vec3 worldNormal = mat3(instanceModel) * normal;
+    vec4 shaded = color * instanceColor;
+    // Zero normals mark unlit geometry (outlines, glows)
+    if (dot(worldNormal, worldNormal) > 0.0)
+    {
+        float diffuse = max(dot(normalize(worldNormal), lightDirection.xyz), 0.0);
+        shaded.rgb *= min(vec3(lightColor.a) + diffuse * lightColor.rgb, vec3(1.0));
+    }
+    vertexColor = shaded;
+    gl_Position = viewProjection * instanceModel * vec4(position, 1.0);
+}
+)";
+
+    const char* UI_VERTEX_SHADER = R"(#version 330 core
+uniform vec2 scale;
+in vec2 position;
+in vec4 color;
+out vec4 vertexColor;
+void main()
+{
+    vertexColor = color;
+    gl_Position = vec4(position * scale, 0.0, 1.0);
+}
+)";
+
+    const char* COLOR_FRAGMENT_SHADER = R"(#version 330 core
+in vec4 vertexColor;
+out vec4 fragColor;
+void main()
+{
+    fragColor = vertexColor;
+}
+)";
+
+    const CoreAttribute MESH_ATTRIBUTES[] = {
+        {"position", ATTRIB_POSITION},
+        {"normal", ATTRIB_NORMAL},
+        {"color", ATTRIB_COLOR},
+        {"instanceModel", ATTRIB_INSTANCE_MODEL},
+        {"instanceColor", ATTRIB_INSTANCE_COLOR}};
+
+    const CoreAttribute UI_ATTRIBUTES[] = {
+        {"position", ATTRIB_POSITION},
+        {"color", ATTRIB_NORMAL}};
+
+    // Layout of the Frame uniform block (std140)
+    struct FrameUniforms {
+        Mat4 viewProjection;
+        float lightDirection[4];
+        float lightColor[4];
+    };
+
+    // Same light as RenderingPipeline::SetupLighting: directional from
+    // (0.5, 1, 0.5), 0.8 diffuse plus the fixed-function ambient terms
+    const float LIGHT_DIRECTION[3] = {0.408248f, 0.816497f, 0.408248f};
+    const float LIGHT_DIFFUSE = 0.8f;
+    const float LIGHT_AMBIENT = 0.4f;
+
+    // Vertical half-extent of the menu plane at z = -1 under the 45 degree
+    // projection MenuRenderer draws it with
+    const float MENU_HALF_HEIGHT = 0.414214f;
+
+    const float FOV_Y = 45.0f;
+    const float Z_NEAR = 0.1f;
+    const float Z_FAR = 1000.0f;
+
+    const Color WHITE(1.0f, 1.0f, 1.0f, 1.0f);
+    const Vector3 NO_NORMAL(0.0f, 0.0f, 0.0f);
+
+    void ItemColor(TankType type, float& r, float& g, float& b)
+    {
+        // Same palette as ItemRenderer::SetItemColor
+        switch (type)
+        {
+        case TankType::TYPE_RED:    r = 1.0f; g = 0.0f; b = 0.0f; break;
+        case TankType::TYPE_BLUE:   r = 0.0f; g = 0.0f; b = 1.0f; break;
+        case TankType::TYPE_YELLOW: r = 1.0f; g = 1.0f; b = 0.0f; break;
+        case TankType::TYPE_PURPLE: r = 1.0f; g = 0.0f; b = 1.0f; break;
+        default:                    r = 0.5f; g = 0.5f; b = 0.5f; break;
+        }
+    }
+
+    float HealthTint(float channel, float health, float maxHealth)
+    {
+        // Same tint as the fixed-function tank body
+        if (maxHealth > 0.0f && health > 0.0f)
+        {
+            return (4.0f * channel + maxHealth / health) / 2.0f;
+        }
+        return channel;
+    }
+
+    uint8_t ToByte(float channel)
+    {
+        return static_cast<uint8_t>(std::min(std::max(channel, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+CoreRenderingPipeline::CoreRenderingPipeline(ViewportManager& viewport, CameraManager& camera,
+                                             ResourceManager& resources)
+    : viewportManager(viewport), cameraManager(camera), resourceManager(resources), renderStats{0, 0, 0, 0, 0.0f, 0, 0, 0, 0, 1.0f, 0, {}}
+{
+}
+
+bool CoreRenderingPipeline::Initialize()
+{
+    Logger::Get().Write("CoreRenderingPipeline initializing... \n");
+
+    if (!CoreGL::IsLoaded() && !CoreGL::Load())
+    {
+        Logger::Get().Write("ERROR: CoreRenderingPipeline needs an OpenGL 3.3 context\n");
+        return false;
+    }
+
+    // Drop errors raised before this backend owned the context (bounded in
+    // case the context itself is broken)
+    for (int i = 0; i < 32 && glGetError() != GL_NO_ERROR; i++)
+    {
+    }
+
+    if (!meshShader.Build("mesh", MESH_VERTEX_SHADER, COLOR_FRAGMENT_SHADER, MESH_ATTRIBUTES, 5) ||
+        !uiShader.Build("ui", UI_VERTEX_SHADER, COLOR_FRAGMENT_SHADER, UI_ATTRIBUTES, 2) ||
+        !meshShader.BindUniformBlock("Frame", FRAME_BLOCK_BINDING))
+    {
+        Cleanup();
+        return false;
+    }
+    uiScaleLocation = uiShader.GetUniform("scale");
+
+    CoreGL::GenBuffers(1, &instanceBuffer);
+    CoreGL::GenBuffers(1, &frameUniformBuffer);
+    CoreGL::BindBuffer(GL_UNIFORM_BUFFER, frameUniformBuffer);
+    CoreGL::BufferData(GL_UNIFORM_BUFFER, sizeof(FrameUniforms), nullptr, GL_STREAM_DRAW);
+    CoreGL::BindBuffer(GL_UNIFORM_BUFFER, 0);
+    CoreGL::BindBufferBase(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, frameUniformBuffer);
+
+    CreateVertexStream(meshes, sizeof(CoreVertex), true);
+    CreateVertexStream(terrain, sizeof(CoreVertex), true);
+    CreateVertexStream(worldLines, sizeof(CoreVertex), true);
+    CreateVertexStream(ui, sizeof(UIVertex), false);
+    BuildMeshes();
+
+    const GLenum error = glGetError();
+    if (error != GL_NO_ERROR)
+    {
+        Logger::Get().Write("ERROR: CoreRenderingPipeline setup raised GL error 0x%x\n", error);
+        Cleanup();
+        return false;
+    }
+
+    isInitialized = true;
+    Logger::Get().Write("CoreRenderingPipeline initialized (%s)\n",
+                        reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    return true;
+}
+
+void CoreRenderingPipeline::Cleanup()
+{
+    if (!CoreGL::IsLoaded())
+    {
+        return;
+    }
+
+    ReleaseVertexStream(meshes);
+    ReleaseVertexStream(terrain);
+    ReleaseVertexStream(worldLines);
+    ReleaseVertexStream(ui);
+    if (instanceBuffer)
+    {
+        CoreGL::DeleteBuffers(1, &instanceBuffer);
+        instanceBuffer = 0;
+    }
+    if (frameUniformBuffer)
+    {
+        CoreGL::DeleteBuffers(1, &frameUniformBuffer);
+        frameUniformBuffer = 0;
+    }
+    meshShader.Release();
+    uiShader.Release();
+    terrainBuilt = false;
+    isInitialized = false;
+}
+
+void CoreRenderingPipeline::SetupRenderState()
+{
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LESS);
+    glDepthMask(GL_TRUE);
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+    glFrontFace(GL_CCW);
+    glDisable(GL_BLEND);
+    glClearColor(0.0f, 0.0f, 0.2f, 1.0f);
+}
+
+void CoreRenderingPipeline::CleanupRenderState()
+{
+    CoreGL::BindVertexArray(0);
+    CoreGL::UseProgram(0);
+}
+
+void CoreRenderingPipeline::ConfigureViewports(int numPlayers, int screenWidth, int screenHeight)
+{
+    if (numPlayers > 1) {
+        viewportManager.SetupSplitScreen(numPlayers, screenWidth, screenHeight);
+    } else {
+        viewportManager.SetupSinglePlayer(screenWidth, screenHeight);
+    }
+}
+
+void CoreRenderingPipeline::CreateVertexStream(VertexStream& stream, size_t vertexSize, bool instanced)
+{
+    CoreGL::GenVertexArrays(1, &stream.vertexArray);
+    CoreGL::GenBuffers(1, &stream.vertexBuffer);
+    CoreGL::BindVertexArray(stream.vertexArray);
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, stream.vertexBuffer);
+
+    const GLsizei stride = static_cast<GLsizei>(vertexSize);
+    if (instanced)
+    {
+        CoreGL::EnableVertexAttribArray(ATTRIB_POSITION);
+        CoreGL::VertexAttribPointer(ATTRIB_POSITION, 3, GL_FLOAT, GL_FALSE, stride,
+                                    reinterpret_cast<void*>(offsetof(CoreVertex, position)));
+        CoreGL::EnableVertexAttribArray(ATTRIB_NORMAL);
+        CoreGL::VertexAttribPointer(ATTRIB_NORMAL, 3, GL_FLOAT, GL_FALSE, stride,
+                                    reinterpret_cast<void*>(offsetof(CoreVertex, normal)));
+        CoreGL::EnableVertexAttribArray(ATTRIB_COLOR);
+        CoreGL::VertexAttribPointer(ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                                    reinterpret_cast<void*>(offsetof(CoreVertex, color)));
+
+        // Instance attributes advance once per instance; their offsets are
+        // set per batch by BindInstances()
+        for (GLuint i = ATTRIB_INSTANCE_MODEL; i <= ATTRIB_INSTANCE_COLOR; i++)
+        {
+            CoreGL::EnableVertexAttribArray(i);
+            CoreGL::VertexAttribDivisor(i, 1);
+        }
+        CoreGL::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        BindInstances(0);
+    }
+    else
+    {
+        CoreGL::EnableVertexAttribArray(ATTRIB_POSITION);
+        CoreGL::VertexAttribPointer(ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, stride,
+                                    reinterpret_cast<void*>(offsetof(UIVertex, position)));
+        CoreGL::EnableVertexAttribArray(ATTRIB_NORMAL);
+        CoreGL::VertexAttribPointer(ATTRIB_NORMAL, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride,
+                                    reinterpret_cast<void*>(offsetof(UIVertex, color)));
+    }
+
+    CoreGL::BindVertexArray(0);
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CoreRenderingPipeline::ReleaseVertexStream(VertexStream& stream)
+{
+    if (stream.vertexBuffer)
+    {
+        CoreGL::DeleteBuffers(1, &stream.vertexBuffer);
+    }
+    if (stream.vertexArray)
+    {
+        CoreGL::DeleteVertexArrays(1, &stream.vertexArray);
+    }
+    stream = VertexStream();
+}
+
+void CoreRenderingPipeline::BuildMeshes()
+{
+    std::vector<CoreVertex> vertices;
+    CoreMeshBuilder builder(vertices);
+
+    auto beginMesh = [&](MeshId id, GLenum mode) {
+        meshRanges[id].mode = mode;
+        meshRanges[id].first = static_cast<GLint>(vertices.size());
+    };
+    auto endMesh = [&](MeshId id) {
+        meshRanges[id].count = static_cast<GLsizei>(vertices.size()) - meshRanges[id].first;
+    };
+
+    // Enemy tank parts, shared with the fixed-function display lists
+    const MeshId tankMeshes[EnemyTankGeometry::PART_COUNT] = {MESH_TANK_BODY, MESH_TANK_TURRET, MESH_TANK_BARREL};
+    for (int part = 0; part < EnemyTankGeometry::PART_COUNT; part++)
+    {
+        beginMesh(tankMeshes[part], GL_TRIANGLES);
+        AddTankPart(builder, EnemyTankGeometry::Get(static_cast<EnemyTankGeometry::Part>(part)));
+        endMesh(tankMeshes[part]);
+    }
+
+    beginMesh(MESH_ITEM, GL_TRIANGLES);
+    builder.AddBox(Vector3(-0.15f, -0.02f, -0.15f), Vector3(0.15f, 0.02f, 0.15f), WHITE);
+    endMesh(MESH_ITEM);
+
+    // The squares of GraphicsTask's squarelist and squarelist2
+    const Vector3 corners[4] = {Vector3(-0.5f, 0.0f, -0.5f), Vector3(0.5f, 0.0f, -0.5f),
+                                Vector3(0.5f, 0.0f, 0.5f), Vector3(-0.5f, 0.0f, 0.5f)};
+    beginMesh(MESH_SQUARE, GL_TRIANGLES);
+    builder.AddQuad(corners[0], corners[1], corners[2], corners[3], NO_NORMAL, WHITE);
+    endMesh(MESH_SQUARE);
+
+    beginMesh(MESH_SQUARE_OUTLINE, GL_LINE_LOOP);
+    for (const Vector3& corner : corners)
+    {
+        builder.AddTriangle(corner, corner, corner, NO_NORMAL, WHITE);
+        vertices.resize(vertices.size() - 2);
+    }
+    endMesh(MESH_SQUARE_OUTLINE);
+
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, meshes.vertexBuffer);
+    CoreGL::BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(CoreVertex), vertices.data(), GL_STATIC_DRAW);
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, 0);
+    meshes.vertexCount = static_cast<GLsizei>(vertices.size());
+}
+
+void CoreRenderingPipeline::AddTankPart(CoreMeshBuilder& builder, const MeshData& mesh)
+{
+    // The legacy normals are not all consistent with the faces; recompute
+    // them facing away from the part's center (the parts are convex)
+    Vector3 center(0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < mesh.triangleCount; i++)
+    {
+        for (const float* p : mesh.triangles[i].positions)
+        {
+            center.x += p[0];
+            center.y += p[1];
+            center.z += p[2];
+        }
+    }
+    const float numCorners = 3.0f * mesh.triangleCount;
+    center = Vector3(center.x / numCorners, center.y / numCorners, center.z / numCorners);
+
+    for (int i = 0; i < mesh.triangleCount; i++)
+    {
+        const auto& positions = mesh.triangles[i].positions;
+        Vector3 p[3];
+        for (int k = 0; k < 3; k++)
+        {
+            p[k] = Vector3(positions[k][0], positions[k][1], positions[k][2]);
+        }
+        const Vector3 u(p[1].x - p[0].x, p[1].y - p[0].y, p[1].z - p[0].z);
+        const Vector3 v(p[2].x - p[0].x, p[2].y - p[0].y, p[2].z - p[0].z);
+        Vector3 normal(u.y * v.z - u.z * v.y, u.z * v.x - u.x * v.z, u.x * v.y - u.y * v.x);
+        const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y + normal.z * normal.z);
+        if (length == 0.0f)
+        {
+            continue;
+        }
+        const Vector3 outwards((p[0].x + p[1].x + p[2].x) / 3.0f - center.x,
+                               (p[0].y + p[1].y + p[2].y) / 3.0f - center.y,
+                               (p[0].z + p[1].z + p[2].z) / 3.0f - center.z);
+        const float sign = (normal.x * outwards.x + normal.y * outwards.y + normal.z * outwards.z) < 0.0f ? -1.0f : 1.0f;
+        normal = Vector3(sign * normal.x / length, sign * normal.y / length, sign * normal.z / length);
+        builder.AddTriangle(p[0], p[1], p[2], normal, WHITE);
+    }
+}
+
+void CoreRenderingPipeline::UpdateTerrain(const TerrainRenderData& terrainData)
+{
+    if (terrainBuilt &&
+        builtTerrain.levelNumber == terrainData.levelNumber &&
+        builtTerrain.sizeX == terrainData.sizeX &&
+        builtTerrain.sizeZ == terrainData.sizeZ &&
+        std::memcmp(&builtTerrain.colors, &terrainData.colors, sizeof(terrainData.colors)) == 0 &&
+        std::memcmp(builtTerrain.heightMap, terrainData.heightMap, sizeof(terrainData.heightMap)) == 0 &&
+        std::memcmp(builtTerrain.floatMap, terrainData.floatMap, sizeof(terrainData.floatMap)) == 0)
+    {
+        return;
+    }
+
+    std::vector<CoreVertex> vertices;
+    CoreMeshBuilder(vertices).AddTerrain(terrainData);
+
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, terrain.vertexBuffer);
+    CoreGL::BufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(CoreVertex), vertices.data(), GL_STATIC_DRAW);
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, 0);
+    terrain.vertexCount = static_cast<GLsizei>(vertices.size());
+
+    builtTerrain = terrainData;
+    terrainBuilt = true;
+    Logger::Get().Write("CoreRenderingPipeline: level %d terrain built, %d vertices\n",
+                        terrainData.levelNumber, terrain.vertexCount);
+}
+
+void CoreRenderingPipeline::RenderAllPlayerViews(const SceneData& scene)
+{
+    if (!isInitialized)
+    {
+        return;
+    }
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+    GLCounters::Get().BeginFrame();
+
+    // Everything that does not depend on the camera is prepared once
+    UpdateTerrain(scene.terrain);
+    BuildInstances(scene);
+    UploadInstances();
+
+    SetupRenderState();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    int objectsDrawn = 0;
+    for (int i = 0; i < scene.numPlayers && i < viewportManager.GetNumViewports(); ++i)
+    {
+        GL_COUNTER_VIEW(i);
+        RenderView(scene, i);
+        objectsDrawn += static_cast<int>(scene.tanks.size() + scene.bullets.size() +
+                                         scene.effects.size() + scene.items.size());
+    }
+    GL_COUNTER_VIEW(GLCounters::NO_VIEW);
+
+    CleanupRenderState();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    renderStats.renderTime = std::chrono::duration_cast<std::chrono::microseconds>(endTime - startTime).count() / 1000.0f;
+    renderStats.tanksRendered = static_cast<int>(scene.tanks.size());
+    renderStats.bulletsRendered = static_cast<int>(scene.bullets.size());
+    renderStats.effectsRendered = static_cast<int>(scene.effects.size());
+    renderStats.itemsRendered = static_cast<int>(scene.items.size());
+    renderStats.objectsDrawn = objectsDrawn;
+    EndGLCounterFrame(renderStats);
+    FrameStats::Get().SetObjectsDrawn(objectsDrawn);
+}
+
+void CoreRenderingPipeline::BuildInstances(const SceneData& scene)
+{
+    for (auto& pass : passInstances)
+    {
+        for (auto& meshList : pass)
+        {
+            meshList.clear();
+        }
+    }
+
+    for (const auto& tank : scene.tanks)
+    {
+        AddTankInstances(tank);
+    }
+    for (const auto& item : scene.items)
+    {
+        AddItemInstance(item);
+    }
+    for (const auto& bullet : scene.bullets)
+    {
+        AddBulletInstances(bullet);
+    }
+    for (const auto& effect : scene.effects)
+    {
+        AddEffectInstances(effect);
+    }
+}
+
+void CoreRenderingPipeline::AddInstance(MeshId mesh, bool additive, const Mat4& model, float r, float g, float b, float a)
+{
+    CoreInstance instance;
+    instance.model = model;
+    instance.color[0] = r;
+    instance.color[1] = g;
+    instance.color[2] = b;
+    instance.color[3] = a;
+    passInstances[additive ? 1 : 0][mesh].push_back(instance);
+}
+
+void CoreRenderingPipeline::AddTankInstances(const TankRenderData& tank)
+{
+    if (!tank.alive)
+    {
+        return;
+    }
+
+    // Transform chain of the fixed-function tank renderer
+    Mat4 body = Mat4::Identity();
+    body.Translate(tank.position.x, tank.position.y, tank.position.z)
+        .Rotate(tank.bodyRotation.x, 1, 0, 0)
+        .Rotate(-tank.bodyRotation.y, 0, 1, 0)
+        .Rotate(tank.bodyRotation.z, 0, 0, 1);
+    AddInstance(MESH_TANK_BODY, false, body,
+                HealthTint(tank.secondaryColor.r, tank.health, tank.maxHealth),
+                HealthTint(tank.secondaryColor.g, tank.health, tank.maxHealth),
+                HealthTint(tank.secondaryColor.b, tank.health, tank.maxHealth));
+
+    Mat4 turret = body;
+    turret.Rotate(tank.turretRotation.x, 1, 0, 0)
+        .Rotate(-tank.turretRotation.y, 0, 1, 0)
+        .Rotate(tank.turretRotation.z, 0, 0, 1);
+    const float r = HealthTint(tank.primaryColor.r, tank.health, tank.maxHealth);
+    const float g = HealthTint(tank.primaryColor.g, tank.health, tank.maxHealth);
+    const float b = HealthTint(tank.primaryColor.b, tank.health, tank.maxHealth);
+    AddInstance(MESH_TANK_TURRET, false, turret, r, g, b);
+
+    Mat4 barrel = turret;
+    barrel.Translate(0.1f, 0.0f, 0.0f);
+    AddInstance(MESH_TANK_BARREL, false, barrel, r, g, b);
+}
+
+void CoreRenderingPipeline::AddBulletInstances(const BulletRenderData& bullet)
+{
+    // Pieces as in BulletRenderer: y offset, z offset, x rotation, z scale
+    struct Piece { float yOffset, zOffset, rotationX, scaleZ; };
+    static const Piece standard[] = {{-0.05f, 0.0f, 0.0f, 0.2f}};
+    static const Piece blue[] = {{-0.07f, 0.0f, 0.0f, 0.15f}, {0.03f, -0.06f, -60.0f, 0.2f}, {0.03f, 0.06f, 60.0f, 0.2f}};
+
+    const bool isBlue = bullet.type1 == TankType::TYPE_BLUE;
+    const Piece* pieces = isBlue ? blue : standard;
+    const int numPieces = isBlue ? 3 : 1;
+    const float alpha = 0.1f + bullet.power / (isBlue ? 500.0f : 1000.0f);
+
+    for (int i = 0; i < numPieces; i++)
+    {
+        Mat4 model = Mat4::Identity();
+        model.Translate(bullet.position.x, bullet.position.y + pieces[i].yOffset, bullet.position.z)
+            .Rotate(bullet.rotation.x, 1, 0, 0)
+            .Rotate(-bullet.rotation.y, 0, 1, 0)
+            .Rotate(bullet.rotation.z, 0, 0, 1)
+            .Translate(0.0f, 0.0f, pieces[i].zOffset)
+            .Rotate(pieces[i].rotationX, 1, 0, 0)
+            .Scale(1.0f, 1.0f, pieces[i].scaleZ);
+
+        AddInstance(MESH_SQUARE_OUTLINE, false, model, bullet.primaryColor.r, bullet.primaryColor.g, bullet.primaryColor.b);
+        AddInstance(MESH_SQUARE, true, model, bullet.secondaryColor.r, bullet.secondaryColor.g, bullet.secondaryColor.b, alpha);
+    }
+}
+
+void CoreRenderingPipeline::AddEffectInstances(const EffectRenderData& effect)
+{
+    Mat4 model = Mat4::Identity();
+    model.Translate(effect.position.x, effect.position.y + 0.2f, effect.position.z)
+        .Rotate(effect.rotation.x, 1, 0, 0)
+        .Rotate(-effect.rotation.y, 0, 1, 0)
+        .Rotate(effect.rotation.z, 0, 0, 1);
+
+    // Scales of EffectRenderer::ApplyEffectScale
+    switch (effect.type)
+    {
+    case FxType::TYPE_ZERO:
+    case FxType::TYPE_JUMP:
+        model.Scale(effect.scale, 1.0f, effect.scale);
+        break;
+    case FxType::TYPE_SMOKE:
+        model.Scale(effect.scale, 0.25f, effect.scale);
+        break;
+    case FxType::TYPE_SMALL_SQUARE:
+        model.Scale(effect.scale, 0.5f, effect.scale);
+        break;
+    case FxType::TYPE_STAR:
+        model.Scale(effect.scale, 0.3f, effect.scale);
+        break;
+    case FxType::TYPE_SMALL_RECTANGLE:
+        model.Scale(0.02f, 1.0f, 0.2f);
+        break;
+    default:
+        break;
+    }
+
+    if (effect.type == FxType::TYPE_DEATH || effect.type == FxType::TYPE_ZERO)
+    {
+        AddInstance(MESH_SQUARE_OUTLINE, false, model, effect.r, effect.g, effect.b);
+    }
+    AddInstance(MESH_SQUARE, true, model, effect.r, effect.g, effect.b, effect.alpha);
+}
+
+void CoreRenderingPipeline::AddItemInstance(const ItemRenderData& item)
+{
+    if (!item.visible)
+    {
+        return;
+    }
+
+    Mat4 model = Mat4::Identity();
+    model.Translate(item.position.x, item.position.y, item.position.z)
+        .Rotate(-item.rotationY, 0, 1, 0)
+        .Rotate(90.0f, 0, 0, 1);
+
+    float r, g, b;
+    ItemColor(item.itemType, r, g, b);
+    AddInstance(MESH_ITEM, false, model, r, g, b);
+}
+
+void CoreRenderingPipeline::UploadInstances()
+{
+    // Instance 0 is the identity for world-space streams (terrain, lines)
+    instances.clear();
+    batches.clear();
+    CoreInstance identity;
+    identity.model = Mat4::Identity();
+    std::fill(identity.color, identity.color + 4, 1.0f);
+    instances.push_back(identity);
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (int mesh = 0; mesh < MESH_COUNT; mesh++)
+        {
+            const auto& meshList = passInstances[pass][mesh];
+            if (meshList.empty())
+            {
+                continue;
+            }
+            InstanceBatch batch;
+            batch.mesh = static_cast<MeshId>(mesh);
+            batch.additive = (pass == 1);
+            batch.firstInstance = instances.size();
+            batch.count = meshList.size();
+            batches.push_back(batch);
+            instances.insert(instances.end(), meshList.begin(), meshList.end());
+        }
+    }
+
+    // Orphan the old storage so the driver need not wait for last frame's draws
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    CoreGL::BufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(CoreInstance), nullptr, GL_STREAM_DRAW);
+    CoreGL::BufferSubData(GL_ARRAY_BUFFER, 0, instances.size() * sizeof(CoreInstance), instances.data());
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void CoreRenderingPipeline::BindInstances(size_t firstInstance)
+{
+    // Expects the instance buffer bound to GL_ARRAY_BUFFER
+    const GLsizei stride = sizeof(CoreInstance);
+    const size_t base = firstInstance * sizeof(CoreInstance);
+    for (GLuint column = 0; column < 4; column++)
+    {
+        CoreGL::VertexAttribPointer(ATTRIB_INSTANCE_MODEL + column, 4, GL_FLOAT, GL_FALSE, stride,
+                                    reinterpret_cast<void*>(base + offsetof(CoreInstance, model) + column * 4 * sizeof(float)));
+    }
+    CoreGL::VertexAttribPointer(ATTRIB_INSTANCE_COLOR, 4, GL_FLOAT, GL_FALSE, stride,
+                                reinterpret_cast<void*>(base + offsetof(CoreInstance, color)));
+}
+
+void CoreRenderingPipeline::RenderView(const SceneData& scene, int playerIndex)
+{
+    viewportManager.SetActiveViewport(playerIndex);
+
+    if (playerIndex < static_cast<int>(scene.cameras.size()))
+    {
+        const CameraData& camData = scene.cameras[playerIndex];
+        const float aspect = viewportManager.GetViewport(playerIndex).GetAspectRatio();
+
+        FrameUniforms frame;
+        frame.viewProjection = Mat4::Perspective(FOV_Y, aspect, Z_NEAR, Z_FAR) *
+                               Mat4::LookAt(camData.position, camData.focus, Vector3(0.0f, 1.0f, 0.0f));
+        std::copy(LIGHT_DIRECTION, LIGHT_DIRECTION + 3, frame.lightDirection);
+        frame.lightDirection[3] = 0.0f;
+        std::fill(frame.lightColor, frame.lightColor + 3, LIGHT_DIFFUSE);
+        frame.lightColor[3] = LIGHT_AMBIENT;
+
+        CoreGL::BindBuffer(GL_UNIFORM_BUFFER, frameUniformBuffer);
+        CoreGL::BufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameUniforms), &frame);
+        CoreGL::BindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    meshShader.Use();
+
+    // Opaque: terrain, then the retained meshes. Instanced batches mix
+    // tanks, bullets, effects and items, so their calls stay with OTHER.
+    {
+        GL_COUNTER_SCOPE(RenderSource::TERRAIN);
+        DrawStream(terrain, GL_TRIANGLES);
+    }
+    DrawBatches(false);
+
+    // Targeting line of this view's player
+    if (scene.uiData && playerIndex < static_cast<int>(scene.uiData->playerHUDs.size()) &&
+        scene.uiData->playerHUDs[playerIndex].showTargeting)
+    {
+        RenderTargetingLine(scene.uiData->playerHUDs[playerIndex]);
+    }
+
+    // Glows: additive, unsorted (the blend is order independent), no depth writes
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+    glDepthMask(GL_FALSE);
+    glDisable(GL_CULL_FACE);
+    DrawBatches(true);
+    glDepthMask(GL_TRUE);
+    glEnable(GL_CULL_FACE);
+    glDisable(GL_BLEND);
+
+    RenderUI(scene, playerIndex);
+}
+
+void CoreRenderingPipeline::DrawStream(const VertexStream& stream, GLenum mode)
+{
+    if (stream.vertexCount == 0)
+    {
+        return;
+    }
+    CoreGL::BindVertexArray(stream.vertexArray);
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    BindInstances(0);
+    GL_COUNT(DRAW);
+    CoreGL::DrawArraysInstanced(mode, 0, stream.vertexCount, 1);
+}
+
+void CoreRenderingPipeline::DrawBatches(bool additive)
+{
+    CoreGL::BindVertexArray(meshes.vertexArray);
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    for (const InstanceBatch& batch : batches)
+    {
+        if (batch.additive != additive)
+        {
+            continue;
+        }
+        const MeshRange& range = meshRanges[batch.mesh];
+        BindInstances(batch.firstInstance);
+        GL_COUNT(DRAW);
+        CoreGL::DrawArraysInstanced(range.mode, range.first, range.count, static_cast<GLsizei>(batch.count));
+    }
+}
+
+void CoreRenderingPipeline::RenderTargetingLine(const HUDRenderData& hudData)
+{
+    // Unstippled version of HUDRenderer::RenderTargetingLine
+    const float angle = hudData.playerRotation.y * (3.14159265f / 180.0f);
+    const float distance = 32.0f;
+    const Vector3 start(hudData.playerPosition.x, hudData.playerPosition.y + 0.1f, hudData.playerPosition.z);
+    const Vector3 end(start.x + distance * std::cos(angle), start.y, start.z + distance * std::sin(angle));
+
+    lineVertices.clear();
+    CoreMeshBuilder builder(lineVertices);
+    const Vector3& color = hudData.targetingColor;
+    builder.AddTriangle(start, start, start, NO_NORMAL, Color(color.x, color.y, color.z, 1.0f));
+    lineVertices.resize(1);
+    builder.AddTriangle(end, end, end, NO_NORMAL, Color(0.0f, 0.0f, 0.0f, 1.0f));
+    lineVertices.resize(2);
+
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, worldLines.vertexBuffer);
+    CoreGL::BufferData(GL_ARRAY_BUFFER, lineVertices.size() * sizeof(CoreVertex), lineVertices.data(), GL_STREAM_DRAW);
+    worldLines.vertexCount = static_cast<GLsizei>(lineVertices.size());
+    DrawStream(worldLines, GL_LINES);
+}
+
+void CoreRenderingPipeline::RenderUI(const SceneData& scene, int playerIndex)
+{
+    if (!scene.uiData)
+    {
+        return;
+    }
+    const UIRenderData& uiData = *scene.uiData;
+    GL_COUNTER_SCOPE(RenderSource::HUD);
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_CULL_FACE);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    uiShader.Use();
+
+    // HUD and overlays in viewport space
+    uiTriangles.clear();
+    uiLines.clear();
+    if (playerIndex >= 0 && playerIndex < static_cast<int>(uiData.playerHUDs.size()))
+    {
+        AddPlayerHUD(uiData.playerHUDs[playerIndex]);
+    }
+    if (playerIndex == 0 && uiData.frameStats.visible)
+    {
+        AddFrameStats(uiData.frameStats);
+    }
+    DrawUI(1.0f, 1.0f);
+
+    // The menu lives on the z = -1 plane of the perspective projection
+    if (uiData.menu.isVisible)
+    {
+        GL_COUNTER_SCOPE(RenderSource::MENU);
+        uiTriangles.clear();
+        uiLines.clear();
+        AddMenu(uiData.menu);
+        const float aspect = viewportManager.GetViewport(playerIndex).GetAspectRatio();
+        DrawUI(1.0f / (MENU_HALF_HEIGHT * aspect), 1.0f / MENU_HALF_HEIGHT);
+    }
+
+    glDisable(GL_BLEND);
+    glEnable(GL_CULL_FACE);
+    glEnable(GL_DEPTH_TEST);
+    meshShader.Use();
+}
+
+void CoreRenderingPipeline::DrawUI(float scaleX, float scaleY)
+{
+    if (uiTriangles.empty() && uiLines.empty())
+    {
+        return;
+    }
+
+    // Triangles then lines in one buffer
+    const size_t numTriangleVertices = uiTriangles.size();
+    uiTriangles.insert(uiTriangles.end(), uiLines.begin(), uiLines.end());
+
+    CoreGL::Uniform2f(uiScaleLocation, scaleX, scaleY);
+    CoreGL::BindVertexArray(ui.vertexArray);
+    CoreGL::BindBuffer(GL_ARRAY_BUFFER, ui.vertexBuffer);
+    CoreGL::BufferData(GL_ARRAY_BUFFER, uiTriangles.size() * sizeof(UIVertex), uiTriangles.data(), GL_STREAM_DRAW);
+    if (numTriangleVertices > 0)
+    {
+        glDrawArrays(GL_TRIANGLES, 0, static_cast<GLsizei>(numTriangleVertices));
+    }
+    if (!uiLines.empty())
+    {
+        glDrawArrays(GL_LINES, static_cast<GLint>(numTriangleVertices), static_cast<GLsizei>(uiLines.size()));
+    }
+}
+
+void CoreRenderingPipeline::AddUIQuad(float x, float y, float width, float height, const Vector3& color, float alpha)
+{
+    UIVertex corners[4];
+    const float xs[4] = {x, x + width, x + width, x};
+    const float ys[4] = {y, y, y + height, y + height};
+    for (int i = 0; i < 4; i++)
+    {
+        corners[i].position[0] = xs[i];
+        corners[i].position[1] = ys[i];
+        corners[i].color[0] = ToByte(color.x);
+        corners[i].color[1] = ToByte(color.y);
+        corners[i].color[2] = ToByte(color.z);
+        corners[i].color[3] = ToByte(alpha);
+    }
+    const int order[6] = {0, 1, 2, 0, 2, 3};
+    for (int index : order)
+    {
+        uiTriangles.push_back(corners[index]);
+    }
+}
+
+void CoreRenderingPipeline::AddUILine(float x0, float y0, float x1, float y1, const Vector3& color, float alpha)
+{
+    UIVertex vertex;
+    vertex.color[0] = ToByte(color.x);
+    vertex.color[1] = ToByte(color.y);
+    vertex.color[2] = ToByte(color.z);
+    vertex.color[3] = ToByte(alpha);
+    vertex.position[0] = x0;
+    vertex.position[1] = y0;
+    uiLines.push_back(vertex);
+    vertex.position[0] = x1;
+    vertex.position[1] = y1;
+    uiLines.push_back(vertex);
+}
+
+void CoreRenderingPipeline::AddUIOutline(float x, float y, float width, float height, const Vector3& color)
+{
+    AddUILine(x, y, x + width, y, color);
+    AddUILine(x + width, y, x + width, y + height, color);
+    AddUILine(x + width, y + height, x, y + height, color);
+    AddUILine(x, y + height, x, y, color);
+}
+
+void CoreRenderingPipeline::AddPlayerHUD(const HUDRenderData& hudData)
+{
+    // Layout of HUDRenderer (without its icon textures)
+    auto fraction = [](float value, float maximum) {
+        return maximum > 0.0f ? std::min(std::max(value / maximum, 0.0f), 1.0f) : 0.0f;
+    };
+
+    if (hudData.showHealthBar)
+    {
+        AddUIQuad(-0.95f, 0.90f, 0.40f, 0.04f, Vector3(0.2f, 0.2f, 0.2f));
+        AddUIQuad(-0.95f, 0.90f, 0.40f * fraction(hudData.health, hudData.maxHealth), 0.04f, hudData.healthColor);
+        AddUIOutline(-0.95f, 0.90f, 0.40f, 0.04f, Vector3(1.0f, 0.8f, 0.8f));
+    }
+
+    if (hudData.showEnergyBar)
+    {
+        AddUIQuad(-0.95f, 0.85f, 0.40f, 0.04f, Vector3(0.2f, 0.2f, 0.2f));
+        AddUIQuad(-0.95f, 0.85f, 0.40f * fraction(hudData.energy, hudData.maxEnergy), 0.04f, hudData.energyColor);
+        AddUIOutline(-0.95f, 0.85f, 0.40f, 0.04f, Vector3(0.5f, 1.0f, 1.0f));
+    }
+
+    // Action cost indicators
+    if (hudData.maxEnergy > 0.0f)
+    {
+        const float x = -0.95f + 0.29f * (hudData.fireCost / hudData.maxEnergy);
+        AddUILine(x, 0.86f, x, 0.89f, hudData.canFire ? Vector3(1.0f, 0.8f, 0.2f) : Vector3(0.8f, 0.4f, 0.4f));
+        if (hudData.jumpCost != hudData.fireCost)
+        {
+            const float jumpX = -0.95f + 0.29f * (hudData.jumpCost / hudData.maxEnergy);
+            AddUILine(jumpX, 0.86f, jumpX, 0.89f, Vector3(0.2f, 1.0f, 0.8f));
+        }
+    }
+
+    if (hudData.showComboMeter)
+    {
+        AddUIQuad(0.50f, -0.37f, 0.01f, hudData.combo / 100.0f, hudData.comboColor);
+    }
+
+    if (hudData.showSpecialMeter)
+    {
+        const float specialPercent = hudData.special / 100.0f;
+        AddUIQuad(0.52f, -0.37f, 0.01f, specialPercent, hudData.specialColor,
+                  hudData.hasSpecialAvailable ? 1.0f : 0.5f);
+
+        const float costPercentage = hudData.fireCost / 500.0f;
+        const int numIndicators = costPercentage > 0.0f ? static_cast<int>(specialPercent / costPercentage) : 0;
+        for (int i = 0; i <= numIndicators; ++i)
+        {
+            const float y = -0.37f + costPercentage * i;
+            AddUILine(0.52f, y, 0.53f, y, Vector3(1.0f, 1.0f, 1.0f));
+        }
+    }
+
+    if (hudData.showDebugInfo)
+    {
+        const float debugValue = 2.0f * hudData.deltaTime;
+        AddUIQuad(0.50f, -0.30f, 0.01f, debugValue, Vector3(1.0f, debugValue, 1.0f));
+    }
+}
+
+void CoreRenderingPipeline::AddFrameStats(const FrameStatsRenderData& statsData)
+{
+    // Same panel as HUDRenderer::RenderFrameStats
+    const float left = 0.40f, right = 0.95f, bottom = 0.55f, top = 0.90f;
+    const float target = statsData.targetFrameMs;
+    const float scaleMs = std::max(2.0f * target, statsData.summary.maxMs);
+    auto graphY = [&](float ms) { return bottom + (top - bottom) * std::min(ms / scaleMs, 1.0f); };
+
+    AddUIQuad(left - 0.02f, 0.45f, right - left + 0.04f, top - 0.43f, Vector3(0.0f, 0.0f, 0.0f), 0.5f);
+    AddUILine(left, graphY(target), right, graphY(target), Vector3(0.2f, 0.6f, 0.2f));
+    AddUILine(left, graphY(2.0f * target), right, graphY(2.0f * target), Vector3(0.6f, 0.6f, 0.2f));
+
+    const float step = (right - left - 0.03f) / (FrameStats::WINDOW - 1);
+    for (size_t i = 1; i < statsData.historyCount; i++)
+    {
+        const float ms = statsData.history[i];
+        const Vector3 color = ms <= target ? Vector3(0.3f, 1.0f, 0.3f)
+                              : ms <= 2.0f * target ? Vector3(1.0f, 1.0f, 0.3f) : Vector3(1.0f, 0.3f, 0.3f);
+        const float x = left + step * (FrameStats::WINDOW - statsData.historyCount + i);
+        AddUILine(x - step, graphY(statsData.history[i - 1]), x, graphY(ms), color);
+    }
+
+    const float percentileMs[] = {statsData.summary.p50Ms, statsData.summary.p95Ms,
+                                  statsData.summary.p99Ms, statsData.summary.maxMs};
+    const Vector3 percentileColors[] = {Vector3(1.0f, 1.0f, 1.0f), Vector3(1.0f, 1.0f, 0.3f),
+                                        Vector3(1.0f, 0.6f, 0.2f), Vector3(1.0f, 0.3f, 0.3f)};
+    for (int i = 0; i < 4; i++)
+    {
+        AddUILine(right - 0.025f, graphY(percentileMs[i]), right, graphY(percentileMs[i]), percentileColors[i]);
+    }
+
+    const Vector3 stageColors[] = {Vector3(0.9f, 0.4f, 0.4f), Vector3(0.4f, 0.9f, 0.4f), Vector3(0.4f, 0.5f, 1.0f),
+                                   Vector3(0.9f, 0.9f, 0.4f), Vector3(0.9f, 0.4f, 0.9f), Vector3(0.4f, 0.9f, 0.9f),
+                                   Vector3(0.9f, 0.6f, 0.3f), Vector3(0.7f, 0.7f, 0.7f)};
+    float x = left;
+    for (size_t i = 0; i < statsData.stageCount; i++)
+    {
+        const float width = (right - left) * std::min(statsData.stages[i].averageMs / scaleMs, 1.0f);
+        AddUIQuad(x, 0.48f, std::min(width, right - x), 0.03f, stageColors[i % 8]);
+        x = std::min(x + width, right);
+    }
+}
+
+void CoreRenderingPipeline::AddMenu(const MenuRenderData& menuData)
+{
+    // Only the selected option is drawn, as in MenuRenderer
+    if (menuData.selectedOption < 0 || menuData.selectedOption >= menuData.numOptions)
+    {
+        return;
+    }
+
+    float x, y, width, height;
+    MenuRenderer::GetOptionPosition(menuData.selectedOption, x, y, width, height);
+    const float* line = MenuRenderer::SELECTED_LINE_COLOR;
+    const float* fill = MenuRenderer::SELECTED_FILL_COLOR;
+    AddUIQuad(x, y - height, width, height, Vector3(fill[0], fill[1], fill[2]), fill[3]);
+    AddUIOutline(x, y - height, width, height, Vector3(line[0], line[1], line[2]));
+}
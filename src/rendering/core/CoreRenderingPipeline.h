@@ -0,0 +1,151 @@
+#pragma once
+
+#include "../IRenderingPipeline.h"
+#include "../ViewportManager.h"
+#include "../CameraManager.h"
+#include "../ResourceManager.h"
+#include "../HUDData.h"
+#include "CoreGL.h"
+#include "CoreGeometry.h"
+#include "CoreShader.h"
+#include "../EnemyTankGeometry.h"
+#include <vector>
+
+/**
+ * Rendering backend for an OpenGL 3.3 core-profile context.
+ *
+ * Draws the same SceneData as RenderingPipeline without any fixed-function
+ * state: geometry lives in vertex buffers behind vertex array objects, the
+ * camera and light in a std140 uniform block, and every object is an
+ * instance (model matrix and color) of one of a few retained meshes. The
+ * terrain is built into its own buffer when the level changes.
+ *
+ * A frame fills one instance buffer for all views, so each view costs a
+ * uniform update and one instanced draw per mesh kind, whatever the number
+ * of tanks, bullets or effects. Only GL 3.3 features are used (no explicit
+ * binding layouts, no base-instance draws), which Mesa's llvmpipe and
+ * softpipe rasterizers both provide; tests/test_core_smoke.cpp draws a
+ * match frame on llvmpipe.
+ *
+ * Approximations against the fixed-function path: item pickups are boxes
+ * and textures are not applied. HUD text is not drawn (the fixed-function
+ * HUDRenderer draws it from an SDL_ttf font atlas).
+ */
+class CoreRenderingPipeline : public IRenderingPipeline {
+public:
+    CoreRenderingPipeline(ViewportManager& viewport, CameraManager& camera,
+                          ResourceManager& resources);
+    ~CoreRenderingPipeline() override = default;
+
+    // IRenderer interface implementation
+    bool Initialize() override;
+    void Cleanup() override;
+    void SetupRenderState() override;
+    void CleanupRenderState() override;
+
+    // IRenderingPipeline interface implementation
+    void RenderAllPlayerViews(const SceneData& scene) override;
+    void ConfigureViewports(int numPlayers, int screenWidth, int screenHeight) override;
+    const RenderStats& GetRenderStats() const override { return renderStats; }
+
+private:
+    enum MeshId {
+        MESH_TANK_BODY,
+        MESH_TANK_TURRET,       // EnemyTankGeometry::BARREL, the block on the hull
+        MESH_TANK_BARREL,       // EnemyTankGeometry::TURRET, the gun
+        MESH_ITEM,
+        MESH_SQUARE,            // Unit quad in the XZ plane (glows)
+        MESH_SQUARE_OUTLINE,    // Its outline as a line loop
+        MESH_COUNT
+    };
+
+    struct MeshRange {
+        GLenum mode;
+        GLint first;
+        GLsizei count;
+    };
+
+    // Instances of one mesh drawn with one call
+    struct InstanceBatch {
+        MeshId mesh;
+        bool additive;          // Glow pass: blended, no depth writes
+        size_t firstInstance;
+        size_t count;
+    };
+
+    // A vertex buffer with its vertex array object
+    struct VertexStream {
+        GLuint vertexArray = 0;
+        GLuint vertexBuffer = 0;
+        GLsizei vertexCount = 0;
+    };
+
+    struct UIVertex {
+        float position[2];
+        uint8_t color[4];
+    };
+
+    // Injected dependencies
+    ViewportManager& viewportManager;
+    CameraManager& cameraManager;
+    ResourceManager& resourceManager;
+
+    CoreShader meshShader;
+    CoreShader uiShader;
+    GLint uiScaleLocation = -1;
+
+    VertexStream meshes;            // All retained meshes, ranges in meshRanges
+    VertexStream terrain;
+    VertexStream worldLines;        // Targeting lines, rebuilt per view
+    VertexStream ui;
+    MeshRange meshRanges[MESH_COUNT];
+    GLuint instanceBuffer = 0;
+    GLuint frameUniformBuffer = 0;
+
+    // Terrain buffer contents, rebuilt when the level data differs
+    TerrainRenderData builtTerrain;
+    bool terrainBuilt = false;
+
+    // Per-frame scratch, kept to reuse capacity
+    std::vector<CoreInstance> instances;
+    std::vector<InstanceBatch> batches;
+    std::vector<CoreVertex> lineVertices;
+    std::vector<UIVertex> uiTriangles;
+    std::vector<UIVertex> uiLines;
+    std::vector<CoreInstance> passInstances[2][MESH_COUNT];    // [additive][mesh]
+
+    RenderStats renderStats;
+
+    // Setup
+    void BuildMeshes();
+    void AddTankPart(CoreMeshBuilder& builder, const MeshData& mesh);
+    void CreateVertexStream(VertexStream& stream, size_t vertexSize, bool instanced);
+    void ReleaseVertexStream(VertexStream& stream);
+    void UpdateTerrain(const TerrainRenderData& terrainData);
+
+    // View-independent frame data
+    void BuildInstances(const SceneData& scene);
+    void AddTankInstances(const TankRenderData& tank);
+    void AddBulletInstances(const BulletRenderData& bullet);
+    void AddEffectInstances(const EffectRenderData& effect);
+    void AddItemInstance(const ItemRenderData& item);
+    void AddInstance(MeshId mesh, bool additive, const Mat4& model, float r, float g, float b, float a = 1.0f);
+    void UploadInstances();
+
+    // Per view
+    void RenderView(const SceneData& scene, int playerIndex);
+    void DrawBatches(bool additive);
+    void DrawStream(const VertexStream& stream, GLenum mode);
+    void BindInstances(size_t firstInstance);
+    void RenderTargetingLine(const HUDRenderData& hudData);
+    void RenderUI(const SceneData& scene, int playerIndex);
+    void AddPlayerHUD(const HUDRenderData& hudData);
+    void AddFrameStats(const FrameStatsRenderData& statsData);
+    void AddMenu(const MenuRenderData& menuData);
+    void DrawUI(float scaleX, float scaleY);
+
+    // UI geometry in the HUD's -1..1 space
+    void AddUIQuad(float x, float y, float width, float height, const Vector3& color, float alpha = 1.0f);
+    void AddUILine(float x0, float y0, float x1, float y1, const Vector3& color, float alpha = 1.0f);
+    void AddUIOutline(float x, float y, float width, float height, const Vector3& color);
+};
@@ -0,0 +1,99 @@
+#include "CoreShader.h"
+#include "../../Logger.h"
+
+namespace {
+    const int MAX_LOG = 1024;
+}
+
+GLuint CoreShader::Compile(GLenum type, const char* source)
+{
+    GLuint shader = CoreGL::CreateShader(type);
+    CoreGL::ShaderSource(shader, 1, &source, nullptr);
+    CoreGL::CompileShader(shader);
+
+    GLint compiled = GL_FALSE;
+    CoreGL::GetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (compiled != GL_TRUE)
+    {
+        char log[MAX_LOG];
+        CoreGL::GetShaderInfoLog(shader, MAX_LOG, nullptr, log);
+        Logger::Get().Write("CoreShader %s: %s shader failed to compile:\n%s\n", name,
+                            type == GL_VERTEX_SHADER ? "vertex" : "fragment", log);
+        CoreGL::DeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool CoreShader::Build(const char* shaderName, const char* vertexSource, const char* fragmentSource,
+                       const CoreAttribute* attributes, int numAttributes)
+{
+    Release();
+    name = shaderName;
+
+    GLuint vertexShader = Compile(GL_VERTEX_SHADER, vertexSource);
+    GLuint fragmentShader = Compile(GL_FRAGMENT_SHADER, fragmentSource);
+    if (!vertexShader || !fragmentShader)
+    {
+        if (vertexShader) CoreGL::DeleteShader(vertexShader);
+        if (fragmentShader) CoreGL::DeleteShader(fragmentShader);
+        return false;
+    }
+
+    program = CoreGL::CreateProgram();
+    CoreGL::AttachShader(program, vertexShader);
+    CoreGL::AttachShader(program, fragmentShader);
+    for (int i = 0; i < numAttributes; i++)
+    {
+        CoreGL::BindAttribLocation(program, attributes[i].location, attributes[i].name);
+    }
+    CoreGL::BindFragDataLocation(program, 0, "fragColor");
+    CoreGL::LinkProgram(program);
+
+    // The program keeps the compiled stages alive
+    CoreGL::DeleteShader(vertexShader);
+    CoreGL::DeleteShader(fragmentShader);
+
+    GLint linked = GL_FALSE;
+    CoreGL::GetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE)
+    {
+        char log[MAX_LOG];
+        CoreGL::GetProgramInfoLog(program, MAX_LOG, nullptr, log);
+        Logger::Get().Write("CoreShader %s: link failed:\n%s\n", name, log);
+        Release();
+        return false;
+    }
+    return true;
+}
+
+void CoreShader::Release()
+{
+    if (program)
+    {
+        CoreGL::DeleteProgram(program);
+        program = 0;
+    }
+}
+
+void CoreShader::Use() const
+{
+    CoreGL::UseProgram(program);
+}
+
+GLint CoreShader::GetUniform(const char* uniformName) const
+{
+    return CoreGL::GetUniformLocation(program, uniformName);
+}
+
+bool CoreShader::BindUniformBlock(const char* blockName, GLuint binding) const
+{
+    GLuint index = CoreGL::GetUniformBlockIndex(program, blockName);
+    if (index == GL_INVALID_INDEX)
+    {
+        Logger::Get().Write("CoreShader %s: no uniform block %s\n", name, blockName);
+        return false;
+    }
+    CoreGL::UniformBlockBinding(program, index, binding);
+    return true;
+}
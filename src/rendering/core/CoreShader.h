@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreGL.h"
+
+/**
+ * Vertex attribute name and the location it is bound to.
+ */
+struct CoreAttribute {
+    const char* name;
+    GLuint location;
+};
+
+/**
+ * A linked GLSL program of the core-profile backend.
+ *
+ * Attribute locations are bound from the list given to Build() before
+ * linking, so vertex array layouts can be set up without querying
+ * the program. Compile and link errors are logged with the program name.
+ */
+class CoreShader {
+public:
+    CoreShader() = default;
+    ~CoreShader() = default;
+
+    CoreShader(const CoreShader&) = delete;
+    CoreShader& operator=(const CoreShader&) = delete;
+
+    bool Build(const char* name, const char* vertexSource, const char* fragmentSource,
+               const CoreAttribute* attributes, int numAttributes);
+    void Release();
+
+    void Use() const;
+    GLint GetUniform(const char* uniformName) const;
+    // Attach a std140 uniform block to a binding point
+    bool BindUniformBlock(const char* blockName, GLuint binding) const;
+
+    bool IsValid() const { return program != 0; }
+
+private:
+    GLuint program = 0;
+    const char* name = "";
+
+    GLuint Compile(GLenum type, const char* source);
+};
@@ -0,0 +1,168 @@
+#include "BatchSimulator.h"
+#include "../GameWorld.h"
+#include "../Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+BatchSimulator::BatchSimulator(const BatchSettings& settings)
+    : settings(settings)
+{
+}
+
+void BatchSimulator::SetUpHeadlessMatch(GameWorld& world, const BatchSettings& settings)
+{
+    world.SetVersusMode(settings.versus);
+
+    LevelHandler& level = world.GetLevelHandler();
+    level.Init();
+    if (!level.Load(settings.levelPath.c_str()))
+    {
+        Logger::Get().Write("BatchSimulator: failed to load level %s\n", settings.levelPath.c_str());
+    }
+    world.GetTankHandler().Init();
+
+    PlayerManager& playerManager = world.GetPlayerManager();
+    playerManager.Initialize(&world);
+
+    // Headless players have no input device: their tanks idle until driven
+    // by an agent (InputTask state is never populated without a window)
+    for (int i = 0; i < PlayerManager::MAX_PLAYERS; i++)
+    {
+        if (Player* player = playerManager.GetPlayer(i))
+        {
+            player->SetInputHandler(nullptr);
+        }
+    }
+
+    playerManager.SpawnPlayerTanks();
+}
+
+void BatchSimulator::RestartHeadlessMatch(GameWorld& world, const LevelHandler::Layout& layout)
+{
+    // Players keep their input handlers; only the tanks they drive go
+    PlayerManager& playerManager = world.GetPlayerManager();
+    for (int i = 0; i < PlayerManager::MAX_PLAYERS; i++)
+    {
+        if (Player* player = playerManager.GetPlayer(i))
+        {
+            player->ReleaseTank();
+        }
+    }
+    world.Clear();
+
+    world.GetLevelHandler().RestoreLayout(layout);
+    world.GetTankHandler().Init();
+    playerManager.SpawnPlayerTanks();
+}
+
+bool BatchSimulator::IsMatchOver(const GameWorld& world)
+{
+    const Player* player = world.GetPlayerManager().GetPlayer(0);
+    if (!player || !player->GetControlledTank() || !player->GetControlledTank()->alive)
+    {
+        return true;
+    }
+
+    for (const auto& tank : world.GetTanks())
+    {
+        if (tank->alive && !tank->isPlayer)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+unsigned long BatchSimulator::RunMatch(const BatchSettings& settings)
+{
+    GameWorld world;
+    world.Initialize();
+    SetUpHeadlessMatch(world, settings);
+
+    unsigned long ticks = 0;
+    while (ticks < static_cast<unsigned long>(settings.maxTicksPerMatch) && !IsMatchOver(world))
+    {
+        world.Simulate(settings.timeStep);
+        ticks++;
+    }
+
+    world.Shutdown();
+    return ticks;
+}
+
+BatchResult BatchSimulator::Run()
+{
+    const int numThreads = std::max(1, settings.numThreads);
+
+    std::atomic<int> nextMatch(0);
+    std::atomic<int> matchesCompleted(0);
+    std::atomic<unsigned long long> totalTicks(0);
+
+    // Per-entity logging would dominate the run (and serialize the threads)
+    const bool wasLogging = Logger::Get().IsEnabled();
+    Logger::Get().SetEnabled(false);
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    workers.reserve(numThreads);
+    for (int t = 0; t < numThreads; t++)
+    {
+        workers.emplace_back([&]() {
+            while (nextMatch.fetch_add(1) < settings.numMatches)
+            {
+                totalTicks += RunMatch(settings);
+                matchesCompleted++;
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    Logger::Get().SetEnabled(wasLogging);
+
+    BatchResult result;
+    result.matchesCompleted = matchesCompleted;
+    result.totalTicks = totalTicks;
+    result.elapsedSeconds = std::chrono::duration<double>(end - start).count();
+
+    Logger::Get().Write("BatchSimulator: %d matches, %d threads, %llu ticks in %.3f s -> %.2f matches/s, %.0f ticks/s\n",
+                        result.matchesCompleted, numThreads, result.totalTicks, result.elapsedSeconds,
+                        result.MatchesPerSecond(), result.TicksPerSecond());
+    return result;
+}
+
+bool BatchSimulator::ParseCommandLine(int argc, char* argv[], BatchSettings& settings)
+{
+    bool batch = false;
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--batch") == 0 && hasValue)
+        {
+            batch = true;
+            settings.numMatches = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+        {
+            settings.numThreads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue)
+        {
+            settings.maxTicksPerMatch = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--level") == 0 && hasValue)
+        {
+            settings.levelPath = argv[++i];
+        }
+    }
+    return batch;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../LevelHandler.h"
+#include <string>
+
+class GameWorld;
+
+/**
+ * Settings for a headless batch run.
+ */
+struct BatchSettings {
+    int numThreads = 4;
+    int numMatches = 32;
+    int maxTicksPerMatch = 60 * 60;      // One minute of game time at 60 Hz
+    float timeStep = 1.0f / 60.0f;       // Fixed simulation step (seconds)
+    std::string levelPath = "levels/level0@@.txt";
+    bool versus = false;
+};
+
+/**
+ * Throughput summary of a batch run.
+ */
+struct BatchResult {
+    int matchesCompleted = 0;
+    unsigned long long totalTicks = 0;
+    double elapsedSeconds = 0.0;
+
+    double MatchesPerSecond() const { return elapsedSeconds > 0.0 ? matchesCompleted / elapsedSeconds : 0.0; }
+    double TicksPerSecond() const { return elapsedSeconds > 0.0 ? totalTicks / elapsedSeconds : 0.0; }
+};
+
+/**
+ * Runs many independent headless matches on worker threads.
+ * Every match owns a private GameWorld (event bus, clock, level, enemies,
+ * players); threads share nothing but the read-only tank type tables and
+ * the logger. No window, GL context or audio device is required.
+ */
+class BatchSimulator {
+public:
+    explicit BatchSimulator(const BatchSettings& settings);
+
+    // Simulate settings.numMatches matches across settings.numThreads threads
+    BatchResult Run();
+
+    // Load the level, spawn enemies and an idle player into an initialized world
+    static void SetUpHeadlessMatch(GameWorld& world, const BatchSettings& settings);
+
+    // Put a match set up above back to its start in place: entities are
+    // cleared and respawned on the saved layout, the level file is not read
+    static void RestartHeadlessMatch(GameWorld& world, const LevelHandler::Layout& layout);
+
+    // Play one match to the end on the calling thread; returns the ticks simulated
+    static unsigned long RunMatch(const BatchSettings& settings);
+
+    // True once the player tank is dead or no enemy tanks remain
+    static bool IsMatchOver(const GameWorld& world);
+
+    // Parses --batch <matches> [--threads <n>] [--ticks <n>] [--level <path>];
+    // returns false when batch mode was not requested
+    static bool ParseCommandLine(int argc, char* argv[], BatchSettings& settings);
+
+private:
+    BatchSettings settings;
+};
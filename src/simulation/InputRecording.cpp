@@ -0,0 +1,488 @@
+#include "InputRecording.h"
+#include "../GameWorld.h"
+#include "../Logger.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    const char MAGIC[4] = {'T', 'G', 'I', 'R'};
+    const uint16_t FORMAT_VERSION = 1;
+
+    enum RecordTag : uint8_t {
+        RECORD_TICK = 1,
+        RECORD_HASH = 2,
+        RECORD_END = 3
+    };
+
+    enum FrameSection : uint8_t {
+        SECTION_KEYS = 1 << 0,
+        SECTION_MOUSE = 1 << 1,
+        SECTION_JOYSTICKS = 1 << 2
+    };
+
+    template<typename T>
+    void Put(std::vector<uint8_t>& out, const T& value)
+    {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // Bounds-checked reader over an in-memory recording
+    class Reader {
+    public:
+        Reader(const std::vector<uint8_t>& data, size_t& position) : data(data), position(position) {}
+
+        template<typename T>
+        bool Get(T& value)
+        {
+            if (position + sizeof(T) > data.size())
+            {
+                return false;
+            }
+            std::memcpy(&value, &data[position], sizeof(T));
+            position += sizeof(T);
+            return true;
+        }
+
+        bool Peek(uint8_t& value) const
+        {
+            if (position >= data.size())
+            {
+                return false;
+            }
+            value = data[position];
+            return true;
+        }
+
+    private:
+        const std::vector<uint8_t>& data;
+        size_t& position;
+    };
+
+    bool SameJoysticks(const InputFrame& a, const InputFrame& b)
+    {
+        return std::memcmp(a.axes, b.axes, sizeof(a.axes)) == 0 &&
+               std::memcmp(a.joystickButtons, b.joystickButtons, sizeof(a.joystickButtons)) == 0 &&
+               std::memcmp(a.hats, b.hats, sizeof(a.hats)) == 0;
+    }
+
+    // Device state relative to the previous frame (dT is written separately)
+    void EncodeFrame(std::vector<uint8_t>& out, const InputFrame& frame, const InputFrame& previous)
+    {
+        uint16_t toggled = 0;
+        for (int i = 0; i < InputFrame::KEY_COUNT; i++)
+        {
+            toggled += frame.KeyPressed(i) != previous.KeyPressed(i);
+        }
+        const bool mouseChanged = frame.mouseDX != previous.mouseDX || frame.mouseDY != previous.mouseDY ||
+                                  frame.mouseButtons != previous.mouseButtons;
+        const bool joysticksChanged = !SameJoysticks(frame, previous);
+
+        uint8_t sections = 0;
+        sections |= toggled ? SECTION_KEYS : 0;
+        sections |= mouseChanged ? SECTION_MOUSE : 0;
+        sections |= joysticksChanged ? SECTION_JOYSTICKS : 0;
+        Put(out, sections);
+
+        if (toggled)
+        {
+            Put(out, toggled);
+            for (int i = 0; i < InputFrame::KEY_COUNT; i++)
+            {
+                if (frame.KeyPressed(i) != previous.KeyPressed(i))
+                {
+                    Put(out, static_cast<uint16_t>(i));
+                }
+            }
+        }
+        if (mouseChanged)
+        {
+            Put(out, frame.mouseDX);
+            Put(out, frame.mouseDY);
+            Put(out, frame.mouseButtons);
+        }
+        if (joysticksChanged)
+        {
+            Put(out, frame.axes);
+            Put(out, frame.joystickButtons);
+            Put(out, frame.hats);
+        }
+    }
+
+    bool DecodeFrame(Reader& reader, InputFrame& frame, const InputFrame& previous)
+    {
+        const float dT = frame.dT;
+        frame = previous;
+        frame.dT = dT;
+
+        uint8_t sections = 0;
+        if (!reader.Get(sections))
+        {
+            return false;
+        }
+        if (sections & SECTION_KEYS)
+        {
+            uint16_t toggled = 0;
+            if (!reader.Get(toggled))
+            {
+                return false;
+            }
+            for (uint16_t k = 0; k < toggled; k++)
+            {
+                uint16_t scancode = 0;
+                if (!reader.Get(scancode) || scancode >= InputFrame::KEY_COUNT)
+                {
+                    return false;
+                }
+                frame.SetKey(scancode, !frame.KeyPressed(scancode));
+            }
+        }
+        if (sections & SECTION_MOUSE)
+        {
+            if (!reader.Get(frame.mouseDX) || !reader.Get(frame.mouseDY) || !reader.Get(frame.mouseButtons))
+            {
+                return false;
+            }
+        }
+        if (sections & SECTION_JOYSTICKS)
+        {
+            if (!reader.Get(frame.axes) || !reader.Get(frame.joystickButtons) || !reader.Get(frame.hats))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+InputRecorder::~InputRecorder()
+{
+    Close();
+}
+
+bool InputRecorder::Open(const std::string& path, const ReplayHeader& header, const GameWorld& world)
+{
+    Close();
+
+    file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        Logger::Get().Write("InputRecorder: could not open %s for writing\n", path.c_str());
+        return false;
+    }
+
+    buffer.clear();
+    buffer.insert(buffer.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    Put(buffer, FORMAT_VERSION);
+    Put(buffer, static_cast<uint16_t>(header.levelPath.size()));
+    buffer.insert(buffer.end(), header.levelPath.begin(), header.levelPath.end());
+    Put(buffer, static_cast<uint8_t>(header.versus));
+    Put(buffer, static_cast<uint8_t>(header.debug));
+    Put(buffer, static_cast<uint8_t>(header.numPlayers));
+    for (int i = 0; i < PlayerManager::MAX_PLAYERS; i++)
+    {
+        Put(buffer, static_cast<uint8_t>(header.inputModes[i]));
+    }
+    Put(buffer, header.seed);
+    Put(buffer, header.hashInterval);
+    EncodeFrame(buffer, header.initialState, InputFrame());
+
+    hashInterval = header.hashInterval;
+    ticks = 0;
+    previous = header.initialState;
+
+    // Tick 0: the freshly set up match, so a mismatched start is caught at once
+    WriteHash(world);
+    Flush();
+
+    Logger::Get().Write("InputRecorder: recording to %s (level %s, %d players)\n",
+                        path.c_str(), header.levelPath.c_str(), header.numPlayers);
+    return true;
+}
+
+void InputRecorder::Close()
+{
+    if (!file)
+    {
+        return;
+    }
+    Put(buffer, static_cast<uint8_t>(RECORD_END));
+    Flush();
+    std::fclose(file);
+    file = nullptr;
+    Logger::Get().Write("InputRecorder: recorded %lu ticks\n", ticks);
+}
+
+void InputRecorder::RecordTick(const InputFrame& frame)
+{
+    if (!file)
+    {
+        return;
+    }
+    Put(buffer, static_cast<uint8_t>(RECORD_TICK));
+    Put(buffer, frame.dT);
+    EncodeFrame(buffer, frame, previous);
+    previous = frame;
+    ticks++;
+
+    if (buffer.size() >= 64 * 1024)
+    {
+        Flush();
+    }
+}
+
+void InputRecorder::AfterTick(const GameWorld& world)
+{
+    if (file && hashInterval > 0 && ticks % hashInterval == 0)
+    {
+        WriteHash(world);
+    }
+}
+
+void InputRecorder::WriteHash(const GameWorld& world)
+{
+    Put(buffer, static_cast<uint8_t>(RECORD_HASH));
+    Put(buffer, static_cast<uint32_t>(ticks));
+    Put(buffer, world.ComputeStateHash());
+}
+
+void InputRecorder::Flush()
+{
+    if (file && !buffer.empty())
+    {
+        std::fwrite(buffer.data(), 1, buffer.size(), file);
+        buffer.clear();
+    }
+}
+
+bool InputReplay::Open(const std::string& path)
+{
+    data.clear();
+    position = 0;
+    ticks = 0;
+    hashesChecked = 0;
+    mismatches = 0;
+    firstMismatchTick = -1;
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        Logger::Get().Write("InputReplay: could not open %s\n", path.c_str());
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+
+    Reader reader(data, position);
+    char magic[4];
+    uint16_t version = 0;
+    uint16_t levelPathLength = 0;
+    if (!reader.Get(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !reader.Get(version) || version != FORMAT_VERSION ||
+        !reader.Get(levelPathLength) || position + levelPathLength > data.size())
+    {
+        Logger::Get().Write("InputReplay: %s is not a version %u recording\n", path.c_str(), FORMAT_VERSION);
+        return false;
+    }
+    header.levelPath.assign(reinterpret_cast<const char*>(&data[position]), levelPathLength);
+    position += levelPathLength;
+
+    uint8_t versus = 0, debug = 0, numPlayers = 0;
+    bool ok = reader.Get(versus) && reader.Get(debug) && reader.Get(numPlayers);
+    for (int i = 0; ok && i < PlayerManager::MAX_PLAYERS; i++)
+    {
+        uint8_t mode = 0;
+        ok = reader.Get(mode) && mode < static_cast<uint8_t>(InputMode::INPUT_MODE_COUNT);
+        header.inputModes[i] = static_cast<InputMode>(mode);
+    }
+    ok = ok && reader.Get(header.seed) && reader.Get(header.hashInterval);
+    header.initialState = InputFrame();
+    ok = ok && DecodeFrame(reader, header.initialState, InputFrame());
+    if (!ok)
+    {
+        Logger::Get().Write("InputReplay: %s has a truncated header\n", path.c_str());
+        return false;
+    }
+    header.versus = versus != 0;
+    header.debug = debug != 0;
+    header.numPlayers = numPlayers;
+    previous = header.initialState;
+
+    Logger::Get().Write("InputReplay: loaded %s (%zu bytes, level %s, %d players)\n",
+                        path.c_str(), data.size(), header.levelPath.c_str(), header.numPlayers);
+    return true;
+}
+
+bool InputReplay::NextTick(InputFrame& frame)
+{
+    Reader reader(data, position);
+    uint8_t tag = 0;
+    while (reader.Get(tag))
+    {
+        if (tag == RECORD_HASH)
+        {
+            // Not verifying (or already verified): skip
+            uint32_t tick;
+            uint64_t hash;
+            if (!reader.Get(tick) || !reader.Get(hash))
+            {
+                return false;
+            }
+            continue;
+        }
+        if (tag != RECORD_TICK || !reader.Get(frame.dT) || !DecodeFrame(reader, frame, previous))
+        {
+            return false;
+        }
+        previous = frame;
+        ticks++;
+        return true;
+    }
+    return false;
+}
+
+bool InputReplay::VerifyTick(const GameWorld& world)
+{
+    Reader reader(data, position);
+    uint8_t tag = 0;
+    if (!reader.Peek(tag) || tag != RECORD_HASH)
+    {
+        return true;
+    }
+
+    const size_t start = position;
+    uint32_t tick = 0;
+    uint64_t expected = 0;
+    reader.Get(tag);
+    if (!reader.Get(tick) || !reader.Get(expected) || tick != ticks)
+    {
+        position = start;
+        return true;
+    }
+
+    hashesChecked++;
+    const uint64_t actual = world.ComputeStateHash();
+    if (actual == expected)
+    {
+        return true;
+    }
+
+    mismatches++;
+    if (firstMismatchTick < 0)
+    {
+        firstMismatchTick = static_cast<long>(ticks);
+        Logger::Get().Write("InputReplay: state diverged at tick %lu (expected %016llx, got %016llx)\n",
+                            ticks, static_cast<unsigned long long>(expected), static_cast<unsigned long long>(actual));
+    }
+    return false;
+}
+
+void InputReplay::SetUpMatch(GameWorld& world, const ReplayHeader& header)
+{
+    world.GetEventBus().Clear();
+    world.SetVersusMode(header.versus);
+    world.SetDebugMode(header.debug);
+
+    LevelHandler& level = world.GetLevelHandler();
+    level.Init();
+    if (!level.Load(header.levelPath.c_str()))
+    {
+        Logger::Get().Write("InputReplay: failed to load level %s\n", header.levelPath.c_str());
+    }
+    world.GetTankHandler().Init();
+
+    PlayerManager& playerManager = world.GetPlayerManager();
+    playerManager.SetNumPlayers(header.numPlayers);
+    for (int i = 0; i < playerManager.GetNumPlayers(); i++)
+    {
+        playerManager.SetPlayerInputMode(i, header.inputModes[i]);
+    }
+    playerManager.SpawnPlayerTanks();
+}
+
+ReplayResult InputReplay::RunHeadless(const std::string& path, bool verify)
+{
+    ReplayResult result;
+    InputReplay replay;
+    if (!replay.Open(path))
+    {
+        return result;
+    }
+    result.loaded = true;
+
+    // Per-entity logging would dominate the run
+    const bool wasLogging = Logger::Get().IsEnabled();
+    Logger::Get().SetEnabled(false);
+
+    GameWorld world;
+    world.Initialize();
+    world.GetPlayerManager().Initialize(&world);
+    SetUpMatch(world, replay.GetHeader());
+    InputTask::BeginPlayback(replay.GetHeader().initialState);
+
+    auto start = std::chrono::steady_clock::now();
+    if (verify)
+    {
+        replay.VerifyTick(world);
+    }
+    InputFrame frame;
+    while (replay.NextTick(frame))
+    {
+        InputTask::ApplyFrame(frame);
+        world.Simulate(frame.dT);
+        if (verify)
+        {
+            replay.VerifyTick(world);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    InputTask::EndPlayback();
+    world.Shutdown();
+    Logger::Get().SetEnabled(wasLogging);
+
+    result.ticks = replay.GetTick();
+    result.hashesChecked = replay.GetHashesChecked();
+    result.mismatches = replay.GetMismatches();
+    result.firstMismatchTick = replay.GetFirstMismatchTick();
+    result.elapsedSeconds = std::chrono::duration<double>(end - start).count();
+
+    Logger::Get().Write("InputReplay: %lu ticks in %.3f s -> %.0f ticks/s; %d hashes checked, %d mismatches (first at tick %ld)\n",
+                        result.ticks, result.elapsedSeconds, result.TicksPerSecond(),
+                        result.hashesChecked, result.mismatches, result.firstMismatchTick);
+    return result;
+}
+
+void InputReplay::ParseCommandLine(int argc, char* argv[], ReplaySettings& settings)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--record") == 0 && hasValue)
+        {
+            settings.recordPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && hasValue)
+        {
+            settings.replayPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--hash-interval") == 0 && hasValue)
+        {
+            settings.hashInterval = static_cast<uint32_t>(std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--headless") == 0)
+        {
+            settings.headless = true;
+        }
+        else if (std::strcmp(argv[i], "--verify") == 0)
+        {
+            settings.verify = true;
+        }
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "../InputTask.h"
+#include "../PlayerManager.h"
+
+class GameWorld;
+
+/**
+ * Everything needed to rebuild a recorded match before its first tick.
+ */
+struct ReplayHeader {
+    std::string levelPath = "levels/level0@@.txt";
+    bool versus = false;
+    bool debug = false;
+    int numPlayers = 1;
+    InputMode inputModes[PlayerManager::MAX_PLAYERS] = {InputMode::MODE_KEYBOARD_MOUSE, InputMode::MODE_JOYSTICK_GENERIC};
+    uint32_t seed = 0;              // Scenario seed (the base game itself draws no random numbers)
+    uint32_t hashInterval = 60;     // Ticks between recorded state hashes (0 = none)
+    InputFrame initialState;        // Device state the frame before tick 1 (for KeyDown edges)
+};
+
+/**
+ * Command line options for recording and replaying sessions.
+ */
+struct ReplaySettings {
+    std::string recordPath;         // --record <file>: capture the next game played
+    std::string replayPath;         // --replay <file>: play a recording back
+    bool headless = false;          // --headless: replay without window, GL or audio
+    bool verify = false;            // --verify: compare state hashes while replaying
+    uint32_t hashInterval = 60;     // --hash-interval <ticks>
+
+    bool IsRecording() const { return !recordPath.empty(); }
+    bool IsReplaying() const { return !replayPath.empty(); }
+};
+
+/**
+ * Summary of a replay run.
+ */
+struct ReplayResult {
+    bool loaded = false;
+    unsigned long ticks = 0;
+    int hashesChecked = 0;
+    int mismatches = 0;
+    long firstMismatchTick = -1;
+    double elapsedSeconds = 0.0;
+
+    double TicksPerSecond() const { return elapsedSeconds > 0.0 ? ticks / elapsedSeconds : 0.0; }
+};
+
+/**
+ * Writes a session as a compact binary stream: a header, then one record
+ * per simulation tick holding the tick's time step and only the parts of
+ * the device state that changed (toggled keys, mouse, joysticks), with a
+ * GameWorld state hash every hashInterval ticks. Values are stored in host
+ * byte order.
+ */
+class InputRecorder {
+public:
+    InputRecorder() = default;
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    // Start a recording of a match that has just been set up in world
+    bool Open(const std::string& path, const ReplayHeader& header, const GameWorld& world);
+    void Close();
+    bool IsOpen() const { return file != nullptr; }
+
+    // Call with the tick's input before GameWorld::Simulate ...
+    void RecordTick(const InputFrame& frame);
+    // ... and with the world after it
+    void AfterTick(const GameWorld& world);
+
+    unsigned long GetTickCount() const { return ticks; }
+
+private:
+    void WriteHash(const GameWorld& world);
+    void Flush();
+
+    std::FILE* file = nullptr;
+    uint32_t hashInterval = 0;
+    unsigned long ticks = 0;
+    InputFrame previous;
+    std::vector<uint8_t> buffer;
+};
+
+/**
+ * Reads a recording back tick by tick. Feed each frame to
+ * InputTask::ApplyFrame and GameWorld::Simulate(frame.dT) so the players'
+ * own input handlers drive the match again.
+ */
+class InputReplay {
+public:
+    // Load a whole recording into memory
+    bool Open(const std::string& path);
+    const ReplayHeader& GetHeader() const { return header; }
+
+    // Next tick's input; false once the recording ends
+    bool NextTick(InputFrame& frame);
+
+    // Compare world with the hash recorded after the current tick (if one
+    // was); returns false on divergence
+    bool VerifyTick(const GameWorld& world);
+
+    unsigned long GetTick() const { return ticks; }
+    int GetHashesChecked() const { return hashesChecked; }
+    int GetMismatches() const { return mismatches; }
+    long GetFirstMismatchTick() const { return firstMismatchTick; }
+
+    // Configure an initialized world (players already created) like the
+    // game did when the recording started
+    static void SetUpMatch(GameWorld& world, const ReplayHeader& header);
+
+    // Replay a recording headless on the calling thread
+    static ReplayResult RunHeadless(const std::string& path, bool verify);
+
+    // Parses --record/--replay/--headless/--verify/--hash-interval
+    static void ParseCommandLine(int argc, char* argv[], ReplaySettings& settings);
+
+private:
+    std::vector<uint8_t> data;
+    size_t position = 0;
+    ReplayHeader header;
+    InputFrame previous;
+    unsigned long ticks = 0;
+    int hashesChecked = 0;
+    int mismatches = 0;
+    long firstMismatchTick = -1;
+};
@@ -0,0 +1,330 @@
+#include "ObservationRasterizer.h"
+#include "../GameWorld.h"
+#include "../math.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+constexpr int ObservationRasterizer::CHANNEL_COUNT;
+constexpr int ObservationRasterizer::HEIGHT_SCALE;
+constexpr int ObservationRasterizer::MAX_LEVEL_SIZE;
+
+namespace {
+    // Terrain sampling runs in 16.16 fixed point; coordinates are biased so
+    // samples left of / above the level stay positive until the bounds test
+    constexpr int FIXED_SHIFT = 16;
+    constexpr float FIXED_ONE = 65536.0f;
+    constexpr int FIXED_BIAS_CELLS = 512;
+
+    constexpr float TANK_RADIUS = 0.5f;      // Level cells
+    constexpr float ITEM_RADIUS = 0.35f;
+    constexpr uint8_t OUTSIDE_TERRAIN = 255;
+
+    uint8_t QuantizeHeight(int height)
+    {
+        return static_cast<uint8_t>(std::min(std::max(height * ObservationRasterizer::HEIGHT_SCALE, 0), 254));
+    }
+
+    uint8_t QuantizeAngle(float degrees)
+    {
+        float wrapped = std::fmod(degrees, 360.0f);
+        if (wrapped < 0.0f)
+        {
+            wrapped += 360.0f;
+        }
+        return static_cast<uint8_t>(static_cast<int>(wrapped * (256.0f / 360.0f)) & 0xFF);
+    }
+}
+
+struct ObservationRasterizer::View {
+    float cx, cz;       // Centre in level cells
+    float ry;           // Heading that maps to "up"
+    float fx, fz;       // Forward (towards row 0)
+    float rx, rz;       // Right (towards the last column)
+    float cellsPerPixel;
+    float pixelsPerCell;
+    float half;         // resolution / 2
+    int resolution;
+
+    // Continuous pixel coordinates of a level position
+    void ToPixel(float x, float z, float& col, float& row) const
+    {
+        const float dx = x - cx;
+        const float dz = z - cz;
+        col = half + (dx * rx + dz * rz) * pixelsPerCell;
+        row = half - (dx * fx + dz * fz) * pixelsPerCell;
+    }
+};
+
+ObservationRasterizer::ObservationRasterizer(const RasterSettings& settings)
+    : settings(settings),
+      cells(MAX_LEVEL_SIZE * MAX_LEVEL_SIZE + 1, OUTSIDE_TERRAIN)
+{
+    this->settings.resolution = std::max(1, settings.resolution);
+    if (this->settings.cellsPerPixel <= 0.0f)
+    {
+        this->settings.cellsPerPixel = 1.0f;
+    }
+}
+
+void ObservationRasterizer::Prepare(const GameWorld& world)
+{
+    const LevelHandler& level = world.GetLevelHandler();
+    const int levelSizeX = std::min(std::max(level.sizeX, 0), MAX_LEVEL_SIZE);
+    const int levelSizeZ = std::min(std::max(level.sizeZ, 0), MAX_LEVEL_SIZE);
+
+    // Revision 0 is a level that was never loaded or edited: always resample
+    if (level.GetTerrainRevision() == 0 || level.GetTerrainRevision() != terrainRevision ||
+        levelSizeX != sizeX || levelSizeZ != sizeZ)
+    {
+        sizeX = levelSizeX;
+        sizeZ = levelSizeZ;
+        terrainRevision = level.GetTerrainRevision();
+        for (int x = 0; x < sizeX; x++)
+        {
+            uint16_t* column = &cells[x * MAX_LEVEL_SIZE];
+            for (int z = 0; z < sizeZ; z++)
+            {
+                const int floatHeight = level.GetFloatHeight(x, z);
+                const uint8_t floatValue = floatHeight > 0 ? std::max<uint8_t>(QuantizeHeight(floatHeight), 1) : 0;
+                column[z] = static_cast<uint16_t>(QuantizeHeight(level.GetTerrainHeight(x, z)) | (floatValue << 8));
+            }
+        }
+    }
+
+    enemies.Clear();
+    players.Clear();
+    for (const auto& tank : world.GetTanks())
+    {
+        if (!tank->alive)
+        {
+            continue;
+        }
+        TankSnapshot& snapshot = tank->isPlayer ? players : enemies;
+        const float health = tank->maxHealth > 0.0f ? std::min(std::max(tank->health / tank->maxHealth, 0.0f), 1.0f) : 1.0f;
+        snapshot.x.push_back(tank->x);
+        snapshot.z.push_back(tank->z);
+        snapshot.value.push_back(static_cast<uint8_t>(1.0f + health * 254.0f));
+        snapshot.identity.push_back(tank->identity);
+    }
+
+    bulletX.clear();
+    bulletZ.clear();
+    bulletRY.clear();
+    bulletOwner.clear();
+    for (const auto& bullet : world.GetBullets())
+    {
+        if (!bullet->IsAlive())
+        {
+            continue;
+        }
+        bulletX.push_back(bullet->GetX());
+        bulletZ.push_back(bullet->GetZ());
+        bulletRY.push_back(bullet->GetRY());
+        bulletOwner.push_back(bullet->GetOwnerIdentity());
+    }
+
+    itemX.clear();
+    itemZ.clear();
+    world.GetRegistry().ForEachChunk<Position, ItemPickup>([this](size_t count, const Position* position, const ItemPickup* pickup) {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!pickup[i].collected)
+            {
+                itemX.push_back(position[i].x);
+                itemZ.push_back(position[i].z);
+            }
+        }
+    });
+}
+
+void ObservationRasterizer::Rasterize(const Tank& tank, uint8_t* out) const
+{
+    Rasterize(tank.x, tank.z, tank.ry, &tank.identity, out);
+}
+
+void ObservationRasterizer::Rasterize(float x, float z, float ry, const TankIdentity* self, uint8_t* out) const
+{
+    View view;
+    view.cx = x;
+    view.cz = z;
+    // World-aligned views put -z at the top, which is heading -90
+    view.ry = settings.rotateToHeading ? ry : -90.0f;
+    view.fx = std::cos(view.ry * DTR);
+    view.fz = std::sin(view.ry * DTR);
+    view.rx = -view.fz;
+    view.rz = view.fx;
+    view.cellsPerPixel = settings.cellsPerPixel;
+    view.pixelsPerCell = 1.0f / settings.cellsPerPixel;
+    view.resolution = settings.resolution;
+    view.half = settings.resolution * 0.5f;
+
+    FillTerrain(view, out + GetChannelOffset(ObservationChannel::TERRAIN_HEIGHT),
+                out + GetChannelOffset(ObservationChannel::FLOAT_BLOCKS));
+
+    // Entity channels are contiguous: clear them in one pass
+    uint8_t* entityChannels = out + GetChannelOffset(ObservationChannel::ENEMY_TANKS);
+    std::memset(entityChannels, 0, out + GetObservationSize() - entityChannels);
+
+    SplatEntities(view, self, out);
+}
+
+void ObservationRasterizer::FillTerrain(const View& view, uint8_t* terrainOut, uint8_t* floatOut) const
+{
+    const int resolution = view.resolution;
+
+    // Level position of the centre of pixel (0, 0) and per-pixel steps
+    const float offset = (0.5f - view.half) * view.cellsPerPixel;
+    const float startX = view.cx + view.rx * offset - view.fx * offset;
+    const float startZ = view.cz + view.rz * offset - view.fz * offset;
+
+    auto toFixed = [](float cells) { return static_cast<int32_t>(std::floor((cells + FIXED_BIAS_CELLS) * FIXED_ONE)); };
+    auto stepToFixed = [](float cells) { return static_cast<int32_t>(std::lround(cells * FIXED_ONE)); };
+
+    const int32_t colStepX = stepToFixed(view.rx * view.cellsPerPixel);
+    const int32_t colStepZ = stepToFixed(view.rz * view.cellsPerPixel);
+    const int32_t rowStepX = stepToFixed(-view.fx * view.cellsPerPixel);
+    const int32_t rowStepZ = stepToFixed(-view.fz * view.cellsPerPixel);
+
+    int32_t rowX = toFixed(startX);
+    int32_t rowZ = toFixed(startZ);
+
+    const unsigned limitX = static_cast<unsigned>(sizeX);
+    const unsigned limitZ = static_cast<unsigned>(sizeZ);
+    const unsigned outsideIndex = MAX_LEVEL_SIZE * MAX_LEVEL_SIZE;
+    const uint16_t* levelCells = cells.data();
+
+    for (int row = 0; row < resolution; row++)
+    {
+        uint8_t* terrainRow = terrainOut + row * resolution;
+        uint8_t* floatRow = floatOut + row * resolution;
+        int32_t px = rowX;
+        int32_t pz = rowZ;
+
+        // The level is convex, so a row whose end samples are inside is
+        // inside throughout and can skip the per-pixel bounds test
+        const int32_t lastX = px + colStepX * (resolution - 1);
+        const int32_t lastZ = pz + colStepZ * (resolution - 1);
+        if (static_cast<unsigned>((px >> FIXED_SHIFT) - FIXED_BIAS_CELLS) < limitX &&
+            static_cast<unsigned>((pz >> FIXED_SHIFT) - FIXED_BIAS_CELLS) < limitZ &&
+            static_cast<unsigned>((lastX >> FIXED_SHIFT) - FIXED_BIAS_CELLS) < limitX &&
+            static_cast<unsigned>((lastZ >> FIXED_SHIFT) - FIXED_BIAS_CELLS) < limitZ)
+        {
+            const int32_t bias = FIXED_BIAS_CELLS * MAX_LEVEL_SIZE + FIXED_BIAS_CELLS;
+            for (int col = 0; col < resolution; col++)
+            {
+                const uint16_t cell = levelCells[(px >> FIXED_SHIFT) * MAX_LEVEL_SIZE + (pz >> FIXED_SHIFT) - bias];
+                terrainRow[col] = static_cast<uint8_t>(cell);
+                floatRow[col] = static_cast<uint8_t>(cell >> 8);
+                px += colStepX;
+                pz += colStepZ;
+            }
+            rowX += rowStepX;
+            rowZ += rowStepZ;
+            continue;
+        }
+
+        for (int col = 0; col < resolution; col++)
+        {
+            const unsigned cellX = static_cast<unsigned>((px >> FIXED_SHIFT) - FIXED_BIAS_CELLS);
+            const unsigned cellZ = static_cast<unsigned>((pz >> FIXED_SHIFT) - FIXED_BIAS_CELLS);
+            const unsigned index = (cellX < limitX && cellZ < limitZ) ? cellX * MAX_LEVEL_SIZE + cellZ : outsideIndex;
+            const uint16_t cell = levelCells[index];
+            terrainRow[col] = static_cast<uint8_t>(cell);
+            floatRow[col] = static_cast<uint8_t>(cell >> 8);
+            px += colStepX;
+            pz += colStepZ;
+        }
+        rowX += rowStepX;
+        rowZ += rowStepZ;
+    }
+}
+
+void ObservationRasterizer::SplatDisc(const View& view, float x, float z, float radius, uint8_t value, uint8_t* plane) const
+{
+    float col, row;
+    view.ToPixel(x, z, col, row);
+
+    const float pixelRadius = radius * view.pixelsPerCell;
+    const int resolution = view.resolution;
+    if (col < -pixelRadius || row < -pixelRadius || col >= resolution + pixelRadius || row >= resolution + pixelRadius)
+    {
+        return;
+    }
+
+    // Smaller than a pixel: mark the pixel containing the centre
+    if (pixelRadius < 0.71f)
+    {
+        const int c = static_cast<int>(std::floor(col));
+        const int r = static_cast<int>(std::floor(row));
+        if (c >= 0 && r >= 0 && c < resolution && r < resolution)
+        {
+            uint8_t& pixel = plane[r * resolution + c];
+            pixel = std::max(pixel, value);
+        }
+        return;
+    }
+
+    const int minCol = std::max(0, static_cast<int>(std::floor(col - pixelRadius)));
+    const int maxCol = std::min(resolution - 1, static_cast<int>(std::floor(col + pixelRadius)));
+    const int minRow = std::max(0, static_cast<int>(std::floor(row - pixelRadius)));
+    const int maxRow = std::min(resolution - 1, static_cast<int>(std::floor(row + pixelRadius)));
+    const float radius2 = pixelRadius * pixelRadius;
+
+    for (int r = minRow; r <= maxRow; r++)
+    {
+        const float dr = r + 0.5f - row;
+        uint8_t* line = plane + r * resolution;
+        for (int c = minCol; c <= maxCol; c++)
+        {
+            const float dc = c + 0.5f - col;
+            if (dc * dc + dr * dr <= radius2)
+            {
+                line[c] = std::max(line[c], value);
+            }
+        }
+    }
+}
+
+void ObservationRasterizer::SplatEntities(const View& view, const TankIdentity* self, uint8_t* out) const
+{
+    uint8_t* enemyPlane = out + GetChannelOffset(ObservationChannel::ENEMY_TANKS);
+    for (size_t i = 0; i < enemies.x.size(); i++)
+    {
+        SplatDisc(view, enemies.x[i], enemies.z[i], TANK_RADIUS, enemies.value[i], enemyPlane);
+    }
+
+    uint8_t* playerPlane = out + GetChannelOffset(ObservationChannel::PLAYER_TANKS);
+    for (size_t i = 0; i < players.x.size(); i++)
+    {
+        const bool isSelf = self && players.identity[i] == *self;
+        SplatDisc(view, players.x[i], players.z[i], TANK_RADIUS, isSelf ? 255 : 128, playerPlane);
+    }
+
+    uint8_t* bulletPlane = out + GetChannelOffset(ObservationChannel::BULLETS);
+    uint8_t* headingPlane = out + GetChannelOffset(ObservationChannel::BULLET_HEADING);
+    const int resolution = view.resolution;
+    for (size_t i = 0; i < bulletX.size(); i++)
+    {
+        float col, row;
+        view.ToPixel(bulletX[i], bulletZ[i], col, row);
+        if (col < 0.0f || row < 0.0f || col >= resolution || row >= resolution)
+        {
+            continue;
+        }
+        const int index = static_cast<int>(row) * resolution + static_cast<int>(col);
+        const bool own = self && bulletOwner[i] == *self;
+        const uint8_t value = own ? 128 : 255;
+        if (value >= bulletPlane[index])
+        {
+            bulletPlane[index] = value;
+            headingPlane[index] = QuantizeAngle(bulletRY[i] - view.ry);
+        }
+    }
+
+    uint8_t* itemPlane = out + GetChannelOffset(ObservationChannel::ITEMS);
+    for (size_t i = 0; i < itemX.size(); i++)
+    {
+        SplatDisc(view, itemX[i], itemZ[i], ITEM_RADIUS, 255, itemPlane);
+    }
+}
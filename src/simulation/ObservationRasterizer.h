@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../TankIdentity.h"
+
+class GameWorld;
+class Tank;
+
+/**
+ * Channels of a top-down observation, stored planar (channel-major,
+ * then row-major) so each channel is one contiguous resolution^2 block.
+ */
+enum class ObservationChannel {
+    TERRAIN_HEIGHT = 0,   // Ground height * HEIGHT_SCALE, 255 outside the level
+    FLOAT_BLOCKS,         // Floating block height * HEIGHT_SCALE, 0 where none
+    ENEMY_TANKS,          // AI tanks, value = remaining health (1..255)
+    PLAYER_TANKS,         // Player tanks, 255 for the observing tank, 128 otherwise
+    BULLETS,              // 255 hostile, 128 fired by the observing tank
+    BULLET_HEADING,       // Bullet heading relative to the view, 0..255 = 0..360 degrees
+    ITEMS,                // 255 where an item lies
+    COUNT
+};
+
+/**
+ * Settings for ObservationRasterizer.
+ */
+struct RasterSettings {
+    int resolution = 64;            // Output is resolution x resolution pixels per channel
+    float cellsPerPixel = 1.0f;     // Level cells covered by one pixel (zoom)
+    bool rotateToHeading = true;    // Tank forward is "up" (row 0); otherwise world-aligned
+};
+
+/**
+ * CPU rasterizer for compact top-down views of a GameWorld, for agents and
+ * minimaps that cannot (or should not) go through OpenGL.
+ *
+ * Prepare() snapshots the entity positions of a world once per tick into
+ * flat arrays (and the heightmaps only when the level changed); Rasterize()
+ * then produces a view centred on any tank in that world without touching
+ * the world again. The terrain
+ * channels are filled with a fixed-point incremental walk (no trig or
+ * division per pixel), entities are splatted afterwards. Buffers are
+ * caller-owned, and once capacities settle neither call allocates.
+ */
+class ObservationRasterizer {
+public:
+    static constexpr int CHANNEL_COUNT = static_cast<int>(ObservationChannel::COUNT);
+    static constexpr int HEIGHT_SCALE = 8;
+    static constexpr int MAX_LEVEL_SIZE = 128;
+
+    explicit ObservationRasterizer(const RasterSettings& settings = RasterSettings());
+
+    // Snapshot level and entities of a world (call after each Simulate)
+    void Prepare(const GameWorld& world);
+
+    // Bytes written by one Rasterize call
+    size_t GetObservationSize() const { return static_cast<size_t>(settings.resolution) * settings.resolution * CHANNEL_COUNT; }
+    size_t GetChannelOffset(ObservationChannel channel) const
+    {
+        return static_cast<size_t>(channel) * settings.resolution * settings.resolution;
+    }
+
+    // View centred on a tank of the prepared world, facing its body heading
+    void Rasterize(const Tank& tank, uint8_t* out) const;
+
+    // View centred on (x, z) facing ry; self marks the observer's own tank and bullets
+    void Rasterize(float x, float z, float ry, const TankIdentity* self, uint8_t* out) const;
+
+    const RasterSettings& GetSettings() const { return settings; }
+
+private:
+    struct View;
+
+    void FillTerrain(const View& view, uint8_t* terrainOut, uint8_t* floatOut) const;
+    void SplatEntities(const View& view, const TankIdentity* self, uint8_t* out) const;
+    void SplatDisc(const View& view, float x, float z, float radius, uint8_t value, uint8_t* plane) const;
+
+    RasterSettings settings;
+
+    // Level snapshot, indexed [x * MAX_LEVEL_SIZE + z], terrain in the low
+    // byte and float block in the high byte so one load serves both
+    // channels; the extra last cell is what every out-of-level sample reads
+    std::vector<uint16_t> cells;
+    int sizeX = 0;
+    int sizeZ = 0;
+    unsigned long terrainRevision = 0;  // LevelHandler revision the cells came from
+
+    // Entity snapshot (structure of arrays)
+    struct TankSnapshot {
+        std::vector<float> x, z;
+        std::vector<uint8_t> value;
+        std::vector<TankIdentity> identity;
+        void Clear() { x.clear(); z.clear(); value.clear(); identity.clear(); }
+    };
+    TankSnapshot enemies;
+    TankSnapshot players;
+
+    std::vector<float> bulletX, bulletZ, bulletRY;
+    std::vector<TankIdentity> bulletOwner;
+    std::vector<float> itemX, itemZ;
+};
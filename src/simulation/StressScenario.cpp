@@ -0,0 +1,346 @@
+#include "StressScenario.h"
+#include "BatchSimulator.h"
+#include "../Bullet.h"
+#include "../FX.h"
+#include "../Logger.h"
+#include "../Tank.h"
+#include "../math.h"
+#include "../TankTypeManager.h"
+#include "../rendering/SceneDataBuilder.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+namespace {
+    const int LOOPING_BOUNCES = 1 << 30;
+    const float GOLDEN_ANGLE = 137.50776f;
+
+    struct Emitter {
+        float x, y, z;
+        FxType type;
+        Color color;
+        float accumulator;
+        float heading;
+    };
+
+    // Spawned enemies cycle through the four combat types
+    TankType StressTankType(int index)
+    {
+        return static_cast<TankType>(1 + index % 4);
+    }
+
+    double Seconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    int CountEnemies(const std::vector<std::unique_ptr<Tank>>& tanks)
+    {
+        int count = 0;
+        for (const auto& tank : tanks)
+        {
+            count += (tank->alive && !tank->isPlayer) ? 1 : 0;
+        }
+        return count;
+    }
+}
+
+StressScenario::StressScenario(const StressSettings& settings)
+    : settings(settings)
+{
+}
+
+std::vector<std::pair<int, int>> StressScenario::FindWalkableCells(const LevelHandler& level)
+{
+    int wallHeight = 0;
+    for (int x = 0; x < level.sizeX; x++)
+    {
+        for (int z = 0; z < level.sizeZ; z++)
+        {
+            wallHeight = std::max(wallHeight, level.GetTerrainHeight(x, z));
+        }
+    }
+
+    std::vector<std::pair<int, int>> cells;
+    for (int x = 1; x < level.sizeX - 1; x++)
+    {
+        for (int z = 1; z < level.sizeZ - 1; z++)
+        {
+            const int height = level.GetTerrainHeight(x, z);
+            if (height >= wallHeight || level.GetFloatHeight(x, z) != 0)
+            {
+                continue;
+            }
+
+            const bool flat = std::abs(level.GetTerrainHeight(x + 1, z) - height) <= 1 &&
+                              std::abs(level.GetTerrainHeight(x - 1, z) - height) <= 1 &&
+                              std::abs(level.GetTerrainHeight(x, z + 1) - height) <= 1 &&
+                              std::abs(level.GetTerrainHeight(x, z - 1) - height) <= 1;
+            if (flat)
+            {
+                cells.emplace_back(x, z);
+            }
+        }
+    }
+    return cells;
+}
+
+StressSample StressScenario::RunStep(int tankCount) const
+{
+    StressSample sample;
+    sample.tanks = tankCount;
+    sample.bullets = static_cast<int>(tankCount * settings.bulletsPerTank);
+    sample.emitters = static_cast<int>(tankCount * settings.emittersPerTank);
+
+    GameWorld world;
+    world.Initialize();
+    BatchSettings match;
+    match.levelPath = settings.levelPath;
+    BatchSimulator::SetUpHeadlessMatch(world, match);
+
+    LevelHandler& level = world.GetLevelHandler();
+    const std::vector<std::pair<int, int>> cells = FindWalkableCells(level);
+    if (cells.empty())
+    {
+        Logger::Get().Write("StressScenario: no walkable cells in %s\n", settings.levelPath.c_str());
+        world.Shutdown();
+        return sample;
+    }
+
+    // Same seed for every step: tank placements of a smaller step are a
+    // prefix of those of a larger one
+    std::mt19937 rng(settings.seed);
+    auto randomCell = [&]() { return cells[rng() % cells.size()]; };
+    auto randomAngle = [&]() { return static_cast<float>(rng() % 360); };
+
+    const int firstEnemyIndex = level.GetEnemyCountForLevel(level.levelNumber);
+    int nextEnemyIndex = firstEnemyIndex;
+    auto spawnTank = [&]() {
+        Tank* tank = world.CreateTank();
+        if (!tank)
+        {
+            return;
+        }
+        const std::pair<int, int> cell = randomCell();
+        const int index = nextEnemyIndex++;
+        tank->Init();
+        tank->isPlayer = false;
+        tank->identity = TankIdentity::Enemy(index);
+        tank->x = cell.first + 0.5f;
+        tank->z = cell.second + 0.5f;
+        tank->y = static_cast<float>(level.GetTerrainHeight(cell.first, cell.second));
+        tank->ry = randomAngle();
+        tank->SetType(StressTankType(index), TankType::TYPE_GREY);
+        tank->Cold().jumpCost = 0;
+    };
+    for (int i = 0; i < tankCount; i++)
+    {
+        spawnTank();
+    }
+    const int enemyTarget = CountEnemies(world.GetTanks());
+
+    auto spawnBullet = [&]() {
+        const std::pair<int, int> cell = randomCell();
+        const int owner = firstEnemyIndex + static_cast<int>(rng() % std::max(1, tankCount));
+        const TankType type = StressTankType(owner);
+        const Color color = TankTypeManager::GetTankTypeColor(type);
+        world.CreateBullet(TankIdentity::Enemy(owner), 1.0f, type, TankType::TYPE_GREY, LOOPING_BOUNCES, 0.0f,
+                           color, color,
+                           cell.first + 0.5f, level.GetTerrainHeight(cell.first, cell.second) + 0.25f, cell.second + 0.5f,
+                           0.0f, randomAngle(), 0.0f);
+    };
+
+    static const FxType emitterTypes[] = {FxType::TYPE_SMOKE, FxType::TYPE_STAR, FxType::TYPE_SMALL_SQUARE, FxType::TYPE_JUMP};
+    std::vector<Emitter> emitters;
+    emitters.reserve(sample.emitters);
+    for (int i = 0; i < sample.emitters; i++)
+    {
+        const std::pair<int, int> cell = randomCell();
+        const Color color = TankTypeManager::GetTankTypeColor(StressTankType(i));
+        emitters.push_back({cell.first + 0.5f, level.GetTerrainHeight(cell.first, cell.second) + 0.5f, cell.second + 0.5f,
+                            emitterTypes[i % 4], color, 0.0f, randomAngle()});
+    }
+
+    auto updateEmitters = [&]() {
+        for (Emitter& emitter : emitters)
+        {
+            emitter.accumulator += settings.emitterRate * settings.timeStep;
+            while (emitter.accumulator >= 1.0f)
+            {
+                emitter.accumulator -= 1.0f;
+                emitter.heading += GOLDEN_ANGLE;
+                const float dx = 0.02f * std::cos(emitter.heading * DTR);
+                const float dz = 0.02f * std::sin(emitter.heading * DTR);
+                world.CreateFX(emitter.type, emitter.x, emitter.y, emitter.z, dx, 0.03f, dz,
+                               0.0f, emitter.heading, 0.0f,
+                               emitter.color.r, emitter.color.g, emitter.color.b, 1.0f);
+            }
+        }
+    };
+
+    // The idle player is the AI's target and must survive every volley:
+    // its death would restart the level and wipe the scenario
+    auto keepPlayerAlive = [&]() {
+        const Player* player = world.GetPlayerManager().GetPlayer(0);
+        Tank* tank = player ? player->GetControlledTank() : nullptr;
+        if (tank && tank->alive)
+        {
+            tank->health = tank->maxHealth * 1000.0f;
+        }
+    };
+
+    SceneDataBuilder sceneBuilder(world.GetTankHandler(), level, &world, &world.GetPlayerManager());
+    SceneData scene;
+
+    const int totalTicks = settings.warmupTicks + settings.ticks;
+    for (int tick = 0; tick < totalTicks; tick++)
+    {
+        const bool measured = tick >= settings.warmupTicks;
+        world.SetProfile(measured ? &sample.profile : nullptr);
+
+        // Replace destroyed tanks and bullets that found something to hit,
+        // then emit effects
+        for (int liveTanks = CountEnemies(world.GetTanks()); liveTanks < enemyTarget; liveTanks++)
+        {
+            spawnTank();
+        }
+        int liveBullets = static_cast<int>(world.GetBullets().size());
+        for (; liveBullets < sample.bullets; liveBullets++)
+        {
+            spawnBullet();
+        }
+        updateEmitters();
+        keepPlayerAlive();
+
+        world.Simulate(settings.timeStep);
+
+        auto start = std::chrono::steady_clock::now();
+        sceneBuilder.BuildEntityData(scene);
+        if (measured)
+        {
+            sample.sceneExtraction += Seconds(start);
+            sample.liveTanks += CountEnemies(world.GetTanks());
+            sample.liveBullets += world.GetBullets().size();
+            sample.liveEffects += world.GetParticles().GetCount();
+        }
+    }
+    world.SetProfile(nullptr);
+    world.Shutdown();
+
+    if (settings.ticks > 0)
+    {
+        sample.liveTanks /= settings.ticks;
+        sample.liveBullets /= settings.ticks;
+        sample.liveEffects /= settings.ticks;
+    }
+    return sample;
+}
+
+std::vector<StressSample> StressScenario::Run()
+{
+    // Per-entity logging would dominate the timings
+    const bool wasLogging = Logger::Get().IsEnabled();
+    Logger::Get().SetEnabled(false);
+
+    std::vector<StressSample> samples;
+    for (int tankCount : settings.tankCounts)
+    {
+        samples.push_back(RunStep(tankCount));
+    }
+    Logger::Get().SetEnabled(wasLogging);
+
+    std::FILE* file = settings.csvPath.empty() ? stdout : std::fopen(settings.csvPath.c_str(), "w");
+    if (file)
+    {
+        WriteCsv(file, samples);
+        if (file != stdout)
+        {
+            std::fclose(file);
+        }
+    }
+    else
+    {
+        Logger::Get().Write("StressScenario: could not write %s\n", settings.csvPath.c_str());
+    }
+
+    for (const StressSample& sample : samples)
+    {
+        const double ticks = std::max<unsigned long>(1, sample.profile.ticks);
+        Logger::Get().Write("StressScenario: %d tanks, %d bullets, %d emitters -> %.3f ms/tick simulate, %.3f ms/tick scene\n",
+                            sample.tanks, sample.bullets, sample.emitters,
+                            1000.0 * sample.profile.Total() / ticks, 1000.0 * sample.sceneExtraction / ticks);
+    }
+    return samples;
+}
+
+void StressScenario::WriteCsv(std::FILE* file, const std::vector<StressSample>& samples)
+{
+    // Times are microseconds per tick
+    std::fprintf(file, "tanks,bullets,emitters,live_tanks,live_bullets,live_effects,"
+                       "events_us,collision_us,tanks_ai_us,bullets_us,effects_us,items_us,players_us,"
+                       "scene_extraction_us,total_us\n");
+    for (const StressSample& sample : samples)
+    {
+        const SimulationProfile& p = sample.profile;
+        const double scale = 1.0e6 / std::max<unsigned long>(1, p.ticks);
+        std::fprintf(file, "%d,%d,%d,%.1f,%.1f,%.1f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n",
+                     sample.tanks, sample.bullets, sample.emitters,
+                     sample.liveTanks, sample.liveBullets, sample.liveEffects,
+                     p.events * scale, p.collision * scale, p.tanks * scale, p.bullets * scale,
+                     p.effects * scale, p.items * scale, p.players * scale,
+                     sample.sceneExtraction * scale, (p.Total() + sample.sceneExtraction) * scale);
+    }
+}
+
+bool StressScenario::ParseCommandLine(int argc, char* argv[], StressSettings& settings)
+{
+    bool stress = false;
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--stress") == 0 && hasValue)
+        {
+            stress = true;
+            settings.tankCounts.clear();
+            for (const char* p = argv[++i]; *p; )
+            {
+                char* end = nullptr;
+                const long count = std::strtol(p, &end, 10);
+                if (end == p)
+                {
+                    break;
+                }
+                settings.tankCounts.push_back(static_cast<int>(count));
+                p = (*end == ',') ? end + 1 : end;
+            }
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && hasValue)
+        {
+            settings.ticks = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--level") == 0 && hasValue)
+        {
+            settings.levelPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+        {
+            settings.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0 && hasValue)
+        {
+            settings.csvPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--bullets-per-tank") == 0 && hasValue)
+        {
+            settings.bulletsPerTank = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--emitters-per-tank") == 0 && hasValue)
+        {
+            settings.emittersPerTank = static_cast<float>(std::atof(argv[++i]));
+        }
+    }
+    return stress;
+}
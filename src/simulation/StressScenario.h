@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../GameWorld.h"
+
+/**
+ * Settings for a stress scenario sweep.
+ */
+struct StressSettings {
+    std::string levelPath = "levels/level0@@.txt";
+    uint32_t seed = 1;                  // Placement seed (same for every step of the sweep)
+    int ticks = 600;                    // Measured ticks per step
+    int warmupTicks = 60;               // Unmeasured ticks first (lets effects reach steady state)
+    float timeStep = 1.0f / 60.0f;
+    std::vector<int> tankCounts = {16, 64, 256, 1024};  // Extra enemy tanks per step
+    float bulletsPerTank = 4.0f;        // Looping bullets kept alive, per extra tank
+    float emittersPerTank = 0.5f;       // Effect emitters, per extra tank
+    float emitterRate = 30.0f;          // Effects spawned per emitter per second
+    std::string csvPath = "stress.csv"; // Empty = stdout
+};
+
+/**
+ * Measurements of one step of the sweep. Times are summed over the
+ * measured ticks; entity counts are averages over them.
+ */
+struct StressSample {
+    int tanks = 0;
+    int bullets = 0;
+    int emitters = 0;
+    double liveTanks = 0.0;             // Enemy tanks (level's own plus spawned)
+    double liveBullets = 0.0;
+    double liveEffects = 0.0;
+    SimulationProfile profile;
+    double sceneExtraction = 0.0;       // SceneDataBuilder::BuildEntityData
+};
+
+/**
+ * Loads a level, adds the requested numbers of enemy tanks, looping
+ * bullets (effectively unlimited bounces) and effect emitters on seeded
+ * random walkable cells, and times the phases of GameWorld::Simulate plus
+ * render scene extraction for a fixed number of ticks. Destroyed tanks and
+ * bullets are replaced every tick so the load stays constant. One fresh world per step; the results go to a CSV with one row
+ * per step, so the curves show where each subsystem stops scaling.
+ *
+ * Headless: no window, GL context or audio device is required.
+ */
+class StressScenario {
+public:
+    explicit StressScenario(const StressSettings& settings);
+
+    // Run every step of settings.tankCounts and write the CSV
+    std::vector<StressSample> Run();
+
+    // Run one step on the calling thread
+    StressSample RunStep(int tankCount) const;
+
+    // Cells a tank can stand on: inside the level, below the wall height,
+    // level with their neighbours and free of floating blocks
+    static std::vector<std::pair<int, int>> FindWalkableCells(const LevelHandler& level);
+
+    static void WriteCsv(std::FILE* file, const std::vector<StressSample>& samples);
+
+    // Parses --stress <n>[,<n>...] [--ticks <n>] [--level <path>] [--seed <n>]
+    // [--csv <path>] [--bullets-per-tank <f>] [--emitters-per-tank <f>];
+    // returns false when the stress scenario was not requested
+    static bool ParseCommandLine(int argc, char* argv[], StressSettings& settings);
+
+private:
+    StressSettings settings;
+};
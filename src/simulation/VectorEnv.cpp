@@ -0,0 +1,558 @@
+#include "VectorEnv.h"
+#include "BatchSimulator.h"
+#include "ObservationRasterizer.h"
+#include "../GameWorld.h"
+#include "../Logger.h"
+#include "../math.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+constexpr int VectorEnv::SELF_FEATURES;
+constexpr int VectorEnv::MAX_OBSERVED_ENEMIES;
+constexpr int VectorEnv::ENEMY_FEATURES;
+constexpr int VectorEnv::MAX_OBSERVED_BULLETS;
+constexpr int VectorEnv::BULLET_FEATURES;
+constexpr int VectorEnv::MAX_OBSERVED_ITEMS;
+constexpr int VectorEnv::ITEM_FEATURES;
+constexpr int VectorEnv::OBSERVATION_SIZE;
+constexpr float VectorEnv::OBSERVATION_RANGE;
+
+namespace {
+
+    // Keeps the K smallest distances seen so far on the stack (insertion
+    // order), each with what it belongs to (an index or a row pointer)
+    template <int K, typename T = int>
+    struct NearestK {
+        float distance2[K];
+        T index[K];
+        int count = 0;
+
+        void Offer(float d2, T i)
+        {
+            if (count == K && d2 >= distance2[K - 1])
+            {
+                return;
+            }
+            int slot = (count < K) ? count++ : K - 1;
+            while (slot > 0 && distance2[slot - 1] > d2)
+            {
+                distance2[slot] = distance2[slot - 1];
+                index[slot] = index[slot - 1];
+                slot--;
+            }
+            distance2[slot] = d2;
+            index[slot] = i;
+        }
+    };
+
+    // World offset rotated into a tank's body frame (x forward, z left/right)
+    struct LocalFrame {
+        float ox, oz, c, s;
+
+        LocalFrame(float x, float z, float ry)
+            : ox(x), oz(z), c(cosDeg(ry)), s(sinDeg(ry)) {}
+
+        void ToLocal(float wx, float wz, float& lx, float& lz) const
+        {
+            const float dx = wx - ox;
+            const float dz = wz - oz;
+            lx = (dx * c + dz * s) / VectorEnv::OBSERVATION_RANGE;
+            lz = (dz * c - dx * s) / VectorEnv::OBSERVATION_RANGE;
+        }
+    };
+
+    float Fraction(float value, float max)
+    {
+        return max > 0.0f ? value / max : 0.0f;
+    }
+
+    int CountLivingEnemies(const GameWorld& world)
+    {
+        int count = 0;
+        for (const auto& tank : world.GetTanks())
+        {
+            if (tank->alive && !tank->isPlayer)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    Tank* AgentTank(GameWorld& world)
+    {
+        Player* player = world.GetPlayerManager().GetPlayer(0);
+        return player ? player->GetControlledTank() : nullptr;
+    }
+
+    const Tank* AgentTank(const GameWorld& world)
+    {
+        const Player* player = world.GetPlayerManager().GetPlayer(0);
+        return player ? player->GetControlledTank() : nullptr;
+    }
+}
+
+VectorEnv::VectorEnv(const EnvSettings& settings)
+    : settings(settings)
+{
+    this->settings.numWorlds = std::max(1, settings.numWorlds);
+    this->settings.numThreads = std::max(1, std::min(settings.numThreads, this->settings.numWorlds));
+    this->settings.frameSkip = std::max(1, settings.frameSkip);
+
+    slots.resize(this->settings.numWorlds);
+    for (auto& slot : slots)
+    {
+        BuildSlot(slot);
+    }
+
+    for (int partition = 1; partition < this->settings.numThreads; partition++)
+    {
+        workers.emplace_back(&VectorEnv::WorkerLoop, this, partition);
+    }
+}
+
+VectorEnv::~VectorEnv()
+{
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        stopping = true;
+    }
+    startCondition.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    for (auto& slot : slots)
+    {
+        if (slot.world)
+        {
+            slot.world->Shutdown();
+        }
+    }
+}
+
+void VectorEnv::Reset(unsigned int seed)
+{
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        ResetSlot(slots[i], seed + static_cast<unsigned int>(i));
+        slots[i].episode = 0;
+    }
+    totalSteps = 0;
+    stepSeconds = 0.0;
+}
+
+bool VectorEnv::BuildSlot(Slot& slot)
+{
+    slot.world.reset(new GameWorld());
+    slot.world->Initialize();
+
+    BatchSettings match;
+    match.levelPath = settings.levelPath;
+    match.timeStep = settings.timeStep;
+    BatchSimulator::SetUpHeadlessMatch(*slot.world, match);
+
+    slot.layout.reset(new LevelHandler::Layout());
+    slot.world->GetLevelHandler().SaveLayout(*slot.layout);
+
+    Player* player = slot.world->GetPlayerManager().GetPlayer(0);
+    if (!player)
+    {
+        Logger::Get().Write("VectorEnv: world has no player to drive\n");
+        return false;
+    }
+    std::unique_ptr<AgentInputHandler> input(new AgentInputHandler());
+    AgentInputHandler* handler = input.get();
+    player->SetInputHandler(std::move(input));
+    slot.input = handler;
+    return true;
+}
+
+bool VectorEnv::ResetSlot(Slot& slot, unsigned int seed)
+{
+    if (!slot.input)
+    {
+        return false;
+    }
+    BatchSimulator::RestartHeadlessMatch(*slot.world, *slot.layout);
+    slot.input->SetAction(TankAction());
+
+    // The seed varies the start so episodes from one level are not identical
+    std::mt19937 rng(seed);
+    Tank* tank = AgentTank(*slot.world);
+    if (tank)
+    {
+        tank->ry = std::uniform_real_distribution<float>(0.0f, 360.0f)(rng);
+        tank->rty = 0.0f;
+    }
+
+    slot.seed = seed;
+    slot.ticks = 0;
+    slot.enemiesAlive = CountLivingEnemies(*slot.world);
+    slot.health = tank ? tank->health : 0.0f;
+    return true;
+}
+
+void VectorEnv::Step(const TankAction* actions, float* rewards, uint8_t* dones)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    if (workers.empty())
+    {
+        stepActions = actions;
+        stepRewards = rewards;
+        stepDones = dones;
+        StepPartition(0);
+    }
+    else
+    {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            stepActions = actions;
+            stepRewards = rewards;
+            stepDones = dones;
+            pendingWorkers = static_cast<int>(workers.size());
+            generation++;
+        }
+        startCondition.notify_all();
+
+        StepPartition(0);
+
+        std::unique_lock<std::mutex> lock(poolMutex);
+        doneCondition.wait(lock, [this]() { return pendingWorkers == 0; });
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    stepSeconds += std::chrono::duration<double>(end - start).count();
+    totalSteps += slots.size();
+}
+
+void VectorEnv::StepPartition(int partition)
+{
+    for (size_t i = partition; i < slots.size(); i += settings.numThreads)
+    {
+        StepSlot(slots[i], stepActions[i], stepRewards[i], stepDones[i]);
+    }
+}
+
+void VectorEnv::WorkerLoop(int partition)
+{
+    unsigned long seen = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(poolMutex);
+            startCondition.wait(lock, [&]() { return stopping || generation != seen; });
+            if (stopping)
+            {
+                return;
+            }
+            seen = generation;
+        }
+
+        StepPartition(partition);
+
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (--pendingWorkers == 0)
+        {
+            doneCondition.notify_one();
+        }
+    }
+}
+
+void VectorEnv::StepSlot(Slot& slot, const TankAction& action, float& reward, uint8_t& done)
+{
+    if (!slot.input)
+    {
+        reward = 0.0f;
+        done = 1;
+        return;
+    }
+
+    GameWorld& world = *slot.world;
+    slot.input->SetAction(action);
+
+    bool over = false;
+    for (int frame = 0; frame < settings.frameSkip && !over; frame++)
+    {
+        world.Simulate(settings.timeStep);
+        slot.ticks++;
+        over = BatchSimulator::IsMatchOver(world);
+    }
+
+    reward = 0.0f;
+
+    const int enemiesAlive = CountLivingEnemies(world);
+    if (enemiesAlive < slot.enemiesAlive)
+    {
+        reward += static_cast<float>(slot.enemiesAlive - enemiesAlive);
+    }
+    slot.enemiesAlive = enemiesAlive;
+
+    const Tank* tank = AgentTank(world);
+    if (tank)
+    {
+        if (tank->health < slot.health)
+        {
+            reward -= Fraction(slot.health - tank->health, tank->maxHealth);
+        }
+        slot.health = tank->health;
+    }
+
+    if (!tank || !tank->alive)
+    {
+        reward -= 1.0f;
+    }
+    else if (enemiesAlive == 0)
+    {
+        reward += 1.0f;
+    }
+
+    done = (over || slot.ticks >= static_cast<unsigned long>(settings.maxEpisodeTicks)) ? 1 : 0;
+    if (done)
+    {
+        slot.episode++;
+        ResetSlot(slot, slot.seed + slot.episode * static_cast<unsigned int>(slots.size()));
+    }
+}
+
+void VectorEnv::Observe(float* observations) const
+{
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        ObserveSlot(slots[i], observations + i * OBSERVATION_SIZE);
+    }
+}
+
+void VectorEnv::ObserveSlot(const Slot& slot, float* out) const
+{
+    std::fill(out, out + OBSERVATION_SIZE, 0.0f);
+
+    const GameWorld& world = *slot.world;
+    const Tank* self = AgentTank(world);
+    if (!self)
+    {
+        return;
+    }
+
+    const LevelHandler& level = world.GetLevelHandler();
+    const LocalFrame frame(self->x, self->z, self->ry);
+
+    float* selfOut = out;
+    selfOut[0] = Fraction(self->x, static_cast<float>(level.sizeX));
+    selfOut[1] = self->y / OBSERVATION_RANGE;
+    selfOut[2] = Fraction(self->z, static_cast<float>(level.sizeZ));
+    selfOut[3] = frame.c;
+    selfOut[4] = frame.s;
+    sinCosDeg(self->rty, selfOut[6], selfOut[5]);
+    selfOut[7] = Fraction(self->health, self->maxHealth);
+    selfOut[8] = Fraction(self->energy, self->maxEnergy);
+    selfOut[9] = (self->fireTimer >= self->fireRate && self->energy >= self->Cold().fireCost) ? 1.0f : 0.0f;
+    selfOut[10] = self->isGrounded ? 1.0f : 0.0f;
+    selfOut[11] = self->alive ? 1.0f : 0.0f;
+
+    const float range2 = OBSERVATION_RANGE * OBSERVATION_RANGE;
+
+    const auto& tanks = world.GetTanks();
+    NearestK<MAX_OBSERVED_ENEMIES> enemies;
+    for (size_t i = 0; i < tanks.size(); i++)
+    {
+        const Tank& tank = *tanks[i];
+        if (!tank.alive || &tank == self || tank.isPlayer)
+        {
+            continue;
+        }
+        const float dx = tank.x - self->x;
+        const float dz = tank.z - self->z;
+        const float d2 = dx * dx + dz * dz;
+        if (d2 < range2)
+        {
+            enemies.Offer(d2, static_cast<int>(i));
+        }
+    }
+    float* enemyOut = selfOut + SELF_FEATURES;
+    for (int k = 0; k < enemies.count; k++)
+    {
+        const Tank& tank = *tanks[enemies.index[k]];
+        float* e = enemyOut + k * ENEMY_FEATURES;
+        frame.ToLocal(tank.x, tank.z, e[0], e[1]);
+        e[2] = std::sqrt(enemies.distance2[k]) / OBSERVATION_RANGE;
+        e[3] = Fraction(tank.health, tank.maxHealth);
+        e[4] = 1.0f;
+    }
+
+    const auto& bullets = world.GetBullets();
+    NearestK<MAX_OBSERVED_BULLETS> nearBullets;
+    for (size_t i = 0; i < bullets.size(); i++)
+    {
+        const Bullet& bullet = *bullets[i];
+        if (!bullet.IsAlive())
+        {
+            continue;
+        }
+        const float dx = bullet.GetX() - self->x;
+        const float dz = bullet.GetZ() - self->z;
+        const float d2 = dx * dx + dz * dz;
+        if (d2 < range2)
+        {
+            nearBullets.Offer(d2, static_cast<int>(i));
+        }
+    }
+    float* bulletOut = enemyOut + MAX_OBSERVED_ENEMIES * ENEMY_FEATURES;
+    for (int k = 0; k < nearBullets.count; k++)
+    {
+        const Bullet& bullet = *bullets[nearBullets.index[k]];
+        float* b = bulletOut + k * BULLET_FEATURES;
+        frame.ToLocal(bullet.GetX(), bullet.GetZ(), b[0], b[1]);
+        sinCosDeg(bullet.GetRY() - self->ry, b[3], b[2]);
+        b[4] = (bullet.GetOwnerIdentity() == self->identity) ? -1.0f : 1.0f;
+    }
+
+    // Items come straight from their component columns; the winners keep
+    // their row's position, which stays put while the world is observed
+    const ArchetypeRegistry& registry = world.GetRegistry();
+    NearestK<MAX_OBSERVED_ITEMS, const Position*> nearItems;
+    registry.ForEachChunk<Position, ItemPickup>([&](size_t count, const Position* position, const ItemPickup* pickup) {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (pickup[i].collected)
+            {
+                continue;
+            }
+            const float dx = position[i].x - self->x;
+            const float dz = position[i].z - self->z;
+            const float d2 = dx * dx + dz * dz;
+            if (d2 < range2)
+            {
+                nearItems.Offer(d2, &position[i]);
+            }
+        }
+    });
+    float* itemOut = bulletOut + MAX_OBSERVED_BULLETS * BULLET_FEATURES;
+    for (int k = 0; k < nearItems.count; k++)
+    {
+        float* it = itemOut + k * ITEM_FEATURES;
+        frame.ToLocal(nearItems.index[k]->x, nearItems.index[k]->z, it[0], it[1]);
+        it[2] = 1.0f;
+    }
+}
+
+void VectorEnv::ObserveRaster(ObservationRasterizer& rasterizer, uint8_t* observations) const
+{
+    const size_t size = rasterizer.GetObservationSize();
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        uint8_t* out = observations + i * size;
+        const Tank* self = AgentTank(*slots[i].world);
+        if (!self)
+        {
+            std::memset(out, 0, size);
+            continue;
+        }
+        rasterizer.Prepare(*slots[i].world);
+        rasterizer.Rasterize(*self, out);
+    }
+}
+
+double VectorEnv::GetStepsPerSecond() const
+{
+    return stepSeconds > 0.0 ? totalSteps / stepSeconds : 0.0;
+}
+
+bool VectorEnv::ParseCommandLine(int argc, char* argv[], EnvSettings& settings, int& benchmarkSteps)
+{
+    bool env = false;
+    for (int i = 1; i < argc; i++)
+    {
+        const bool hasValue = (i + 1 < argc);
+        if (std::strcmp(argv[i], "--env") == 0 && hasValue)
+        {
+            env = true;
+            settings.numWorlds = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+        {
+            settings.numThreads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--steps") == 0 && hasValue)
+        {
+            benchmarkSteps = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--level") == 0 && hasValue)
+        {
+            settings.levelPath = argv[++i];
+        }
+    }
+    return env;
+}
+
+double VectorEnv::RunBenchmark(const EnvSettings& settings, int benchmarkSteps, unsigned int seed)
+{
+    const bool wasLogging = Logger::Get().IsEnabled();
+    Logger::Get().SetEnabled(false);
+
+    VectorEnv env(settings);
+    env.Reset(seed);
+
+    const int numWorlds = env.GetNumWorlds();
+    std::vector<TankAction> actions(numWorlds);
+    std::vector<float> rewards(numWorlds);
+    std::vector<uint8_t> dones(numWorlds);
+    std::vector<float> observations(static_cast<size_t>(numWorlds) * OBSERVATION_SIZE);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+    unsigned long long episodes = 0;
+
+    for (int step = 0; step < benchmarkSteps; step++)
+    {
+        for (auto& action : actions)
+        {
+            action.move = axis(rng);
+            action.rotate = axis(rng);
+            action.turret = axis(rng);
+            action.fire = axis(rng) > 0.5f;
+        }
+        env.Step(actions.data(), rewards.data(), dones.data());
+        env.Observe(observations.data());
+        episodes += std::count(dones.begin(), dones.end(), static_cast<uint8_t>(1));
+    }
+
+    // Rasterize a view for every living tank of every world; Prepare (one
+    // per world and tick) is timed apart from the per-view cost
+    ObservationRasterizer rasterizer;
+    std::vector<uint8_t> raster(rasterizer.GetObservationSize());
+    unsigned long long views = 0;
+    double prepareMs = 0.0;
+    double rasterMs = 0.0;
+    for (int i = 0; i < numWorlds; i++)
+    {
+        const GameWorld& world = env.GetWorld(i);
+        auto prepareStart = std::chrono::steady_clock::now();
+        rasterizer.Prepare(world);
+        auto rasterStart = std::chrono::steady_clock::now();
+        for (const auto& tank : world.GetTanks())
+        {
+            if (tank->alive)
+            {
+                rasterizer.Rasterize(*tank, raster.data());
+                views++;
+            }
+        }
+        auto rasterEnd = std::chrono::steady_clock::now();
+        prepareMs += std::chrono::duration<double, std::milli>(rasterStart - prepareStart).count();
+        rasterMs += std::chrono::duration<double, std::milli>(rasterEnd - rasterStart).count();
+    }
+
+    Logger::Get().SetEnabled(wasLogging);
+    Logger::Get().Write("VectorEnv: %llu %dx%d views in %.3f ms -> %.0f views/ms (+%.3f ms preparing %d worlds)\n",
+                        views, rasterizer.GetSettings().resolution, rasterizer.GetSettings().resolution,
+                        rasterMs, rasterMs > 0.0 ? views / rasterMs : 0.0, prepareMs, numWorlds);
+    Logger::Get().Write("VectorEnv: %d worlds, %d threads, %llu steps (%llu episodes) -> %.0f steps/s\n",
+                        numWorlds, settings.numThreads, env.GetTotalSteps(), episodes, env.GetStepsPerSecond());
+    return env.GetStepsPerSecond();
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../AgentInputHandler.h"
+#include "../LevelHandler.h"
+
+class GameWorld;
+class ObservationRasterizer;
+
+/**
+ * Settings for a vectorized training environment.
+ */
+struct EnvSettings {
+    int numWorlds = 8;
+    int numThreads = 1;                  // Threads stepping worlds (1 = calling thread only)
+    int frameSkip = 1;                   // Simulation ticks per Step (action repeat)
+    float timeStep = 1.0f / 60.0f;       // Fixed simulation step (seconds)
+    int maxEpisodeTicks = 60 * 60 * 2;   // Two minutes of game time at 60 Hz
+    std::string levelPath = "levels/level0@@.txt";
+};
+
+/**
+ * K headless matches advanced in lockstep for bots and training agents.
+ *
+ * Each world is a GameWorld whose first player is driven by an
+ * AgentInputHandler. Step() takes one TankAction per world and writes one
+ * reward and one done flag per world; Observe() writes OBSERVATION_SIZE
+ * floats per world. All buffers are caller-owned and contiguous.
+ *
+ * Every world is built and its level loaded once, in the constructor.
+ * Worlds whose episode ends are restarted in place from the saved level
+ * layout: only the tanks of the new episode are allocated, nothing is
+ * read from disk, and steps in between allocate nothing.
+ *
+ * Observation layout per world. Self x and z are world-axis fractions of
+ * the level size and self y is divided by OBSERVATION_RANGE; the enemy,
+ * bullet and item x/z are in the tank's body frame, divided by
+ * OBSERVATION_RANGE:
+ *   self     x, y, z, cos/sin body, cos/sin turret, health, energy,
+ *            fire ready, grounded, alive
+ *   enemies  nearest first: x, z, distance, health, present
+ *   bullets  nearest first: x, z, heading x/z, owner (+1 hostile, -1 own)
+ *   items    nearest first: x, z, present
+ *
+ * Rewards: +1 per enemy destroyed, +1 for clearing the level, minus the
+ * fraction of max health lost, -1 when the player tank dies.
+ */
+class VectorEnv {
+public:
+    static constexpr int SELF_FEATURES = 12;
+    static constexpr int MAX_OBSERVED_ENEMIES = 8;
+    static constexpr int ENEMY_FEATURES = 5;
+    static constexpr int MAX_OBSERVED_BULLETS = 8;
+    static constexpr int BULLET_FEATURES = 5;
+    static constexpr int MAX_OBSERVED_ITEMS = 4;
+    static constexpr int ITEM_FEATURES = 3;
+    static constexpr int OBSERVATION_SIZE = SELF_FEATURES
+        + MAX_OBSERVED_ENEMIES * ENEMY_FEATURES
+        + MAX_OBSERVED_BULLETS * BULLET_FEATURES
+        + MAX_OBSERVED_ITEMS * ITEM_FEATURES;
+    static constexpr float OBSERVATION_RANGE = 32.0f;
+
+    explicit VectorEnv(const EnvSettings& settings);
+    ~VectorEnv();
+
+    VectorEnv(const VectorEnv&) = delete;
+    VectorEnv& operator=(const VectorEnv&) = delete;
+
+    // Restart every world; world i uses seed + i
+    void Reset(unsigned int seed);
+
+    // Apply actions[numWorlds] and advance every world by frameSkip ticks
+    void Step(const TankAction* actions, float* rewards, uint8_t* dones);
+
+    // Write numWorlds * OBSERVATION_SIZE floats
+    void Observe(float* observations) const;
+
+    // Write numWorlds top-down views centred on each agent tank
+    // (numWorlds * rasterizer.GetObservationSize() bytes)
+    void ObserveRaster(ObservationRasterizer& rasterizer, uint8_t* observations) const;
+
+    int GetNumWorlds() const { return static_cast<int>(slots.size()); }
+    GameWorld& GetWorld(int index) { return *slots[index].world; }
+
+    // Throughput since the last Reset (one step = one world advanced once)
+    unsigned long long GetTotalSteps() const { return totalSteps; }
+    double GetStepsPerSecond() const;
+
+    // Parses --env <worlds> [--threads <n>] [--steps <n>] [--level <path>];
+    // returns false when the environment benchmark was not requested
+    static bool ParseCommandLine(int argc, char* argv[], EnvSettings& settings, int& benchmarkSteps);
+
+    // Step random actions for benchmarkSteps steps and log steps/sec
+    // (plus top-down rasterization throughput over every tank)
+    static double RunBenchmark(const EnvSettings& settings, int benchmarkSteps, unsigned int seed);
+
+private:
+    struct Slot {
+        std::unique_ptr<GameWorld> world;
+        std::unique_ptr<LevelHandler::Layout> layout;  // The level as loaded
+        AgentInputHandler* input = nullptr;  // Owned by the world's first player; null if it has none
+        unsigned int seed = 0;
+        unsigned int episode = 0;
+        unsigned long ticks = 0;
+        int enemiesAlive = 0;
+        float health = 0.0f;
+    };
+
+    // Build the world and hand the agent's input handler to its first player
+    bool BuildSlot(Slot& slot);
+    // Restart the episode in place; false for a slot without an agent
+    bool ResetSlot(Slot& slot, unsigned int seed);
+    void StepSlot(Slot& slot, const TankAction& action, float& reward, uint8_t& done);
+    void StepPartition(int partition);
+    void ObserveSlot(const Slot& slot, float* out) const;
+    void WorkerLoop(int partition);
+
+    EnvSettings settings;
+    std::vector<Slot> slots;
+
+    // Lockstep worker pool (partition 0 runs on the calling thread)
+    std::vector<std::thread> workers;
+    std::mutex poolMutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+    unsigned long generation = 0;
+    int pendingWorkers = 0;
+    bool stopping = false;
+    const TankAction* stepActions = nullptr;
+    float* stepRewards = nullptr;
+    uint8_t* stepDones = nullptr;
+
+    unsigned long long totalSteps = 0;
+    double stepSeconds = 0.0;
+};
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../src/collision/NarrowphaseGrid.h"
+#include <random>
+#include <vector>
+
+TEST(NarrowphaseGridTest, Run_MatchesScalarSphereTest) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-4.0f, 132.0f);
+    std::uniform_real_distribution<float> height(0.0f, 3.0f);
+    std::uniform_real_distribution<float> reach(0.2f, 6.0f);
+
+    NarrowphaseGrid grid;
+    grid.Reset(128.0f, 128.0f);
+    std::vector<float> px, py, pz, sx, sy, sz, sr;
+    for (int i = 0; i < 3001; i++) {
+        px.push_back(position(rng));
+        py.push_back(height(rng));
+        pz.push_back(position(rng));
+        grid.AddPoint(px.back(), py.back(), pz.back());
+    }
+    for (int i = 0; i < 40; i++) {
+        sx.push_back(position(rng));
+        sy.push_back(height(rng));
+        sz.push_back(position(rng));
+        sr.push_back(reach(rng));
+        grid.AddSphere(sx.back(), sy.back(), sz.back(), sr.back());
+    }
+    // A point exactly on a sphere's surface counts as inside
+    sx.push_back(px[0] + 2.0f);
+    sy.push_back(py[0]);
+    sz.push_back(pz[0]);
+    sr.push_back(2.0f);
+    grid.AddSphere(sx.back(), sy.back(), sz.back(), sr.back());
+
+    std::vector<NarrowphaseHit> hits;
+    grid.Run(hits);
+
+    std::vector<NarrowphaseHit> expected;
+    for (size_t p = 0; p < px.size(); p++) {
+        for (size_t s = 0; s < sx.size(); s++) {
+            const float dx = px[p] - sx[s];
+            const float dy = py[p] - sy[s];
+            const float dz = pz[p] - sz[s];
+            if (dx * dx + dy * dy + dz * dz <= sr[s] * sr[s]) {
+                expected.push_back({static_cast<uint32_t>(p), static_cast<uint32_t>(s)});
+            }
+        }
+    }
+
+    ASSERT_EQ(hits.size(), expected.size());
+    for (size_t i = 0; i < hits.size(); i++) {
+        EXPECT_EQ(hits[i].point, expected[i].point) << i;
+        EXPECT_EQ(hits[i].sphere, expected[i].sphere) << i;
+    }
+    EXPECT_GT(hits.size(), 100u);
+    EXPECT_EQ(hits[0].point, 0u);
+}
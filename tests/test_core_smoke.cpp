@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include "../src/GameWorld.h"
+#include "../src/rendering/HUDData.h"
+#include "../src/rendering/SceneDataBuilder.h"
+#include "../src/rendering/core/CoreRenderingPipeline.h"
+#include "../src/simulation/BatchSimulator.h"
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <vector>
+
+// Smoke test of the core-profile backend on a headless OpenGL 3.3 core
+// context. ctest runs it on Mesa's software rasterizer (llvmpipe), so it
+// needs neither a GPU nor a display; where no such context can be made the
+// test is skipped rather than failed.
+
+namespace {
+    const int WIDTH = 320;
+    const int HEIGHT = 240;
+
+    void* GetEGLProcAddress(const char* name) {
+        return reinterpret_cast<void*>(eglGetProcAddress(name));
+    }
+}
+
+class CoreSmokeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (getPlatformDisplay) {
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        }
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+            display = EGL_NO_DISPLAY;
+            GTEST_SKIP() << "no surfaceless EGL display";
+        }
+
+        eglBindAPI(EGL_OPENGL_API);
+        const EGLint configAttributes[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_SURFACE_TYPE, 0, EGL_NONE};
+        EGLConfig config = nullptr;
+        EGLint numConfigs = 0;
+        eglChooseConfig(display, configAttributes, &config, 1, &numConfigs);
+        const EGLint contextAttributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 3,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+        context = eglCreateContext(display, numConfigs > 0 ? config : nullptr, EGL_NO_CONTEXT, contextAttributes);
+        if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+            GTEST_SKIP() << "no OpenGL 3.3 core context (EGL error 0x" << std::hex << eglGetError() << ")";
+        }
+
+        // No window: the frame goes to an offscreen colour and depth target
+        genFramebuffers = reinterpret_cast<PFNGLGENFRAMEBUFFERSPROC>(GetEGLProcAddress("glGenFramebuffers"));
+        bindFramebuffer = reinterpret_cast<PFNGLBINDFRAMEBUFFERPROC>(GetEGLProcAddress("glBindFramebuffer"));
+        deleteFramebuffers = reinterpret_cast<PFNGLDELETEFRAMEBUFFERSPROC>(GetEGLProcAddress("glDeleteFramebuffers"));
+        genRenderbuffers = reinterpret_cast<PFNGLGENRENDERBUFFERSPROC>(GetEGLProcAddress("glGenRenderbuffers"));
+        bindRenderbuffer = reinterpret_cast<PFNGLBINDRENDERBUFFERPROC>(GetEGLProcAddress("glBindRenderbuffer"));
+        renderbufferStorage = reinterpret_cast<PFNGLRENDERBUFFERSTORAGEPROC>(GetEGLProcAddress("glRenderbufferStorage"));
+        framebufferRenderbuffer = reinterpret_cast<PFNGLFRAMEBUFFERRENDERBUFFERPROC>(
+            GetEGLProcAddress("glFramebufferRenderbuffer"));
+        checkFramebufferStatus = reinterpret_cast<PFNGLCHECKFRAMEBUFFERSTATUSPROC>(
+            GetEGLProcAddress("glCheckFramebufferStatus"));
+        deleteRenderbuffers = reinterpret_cast<PFNGLDELETERENDERBUFFERSPROC>(GetEGLProcAddress("glDeleteRenderbuffers"));
+        ASSERT_TRUE(genFramebuffers && bindFramebuffer && deleteFramebuffers && genRenderbuffers && bindRenderbuffer &&
+                    renderbufferStorage && framebufferRenderbuffer && checkFramebufferStatus && deleteRenderbuffers);
+
+        genRenderbuffers(2, renderbuffers);
+        bindRenderbuffer(GL_RENDERBUFFER, renderbuffers[0]);
+        renderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, WIDTH, HEIGHT);
+        bindRenderbuffer(GL_RENDERBUFFER, renderbuffers[1]);
+        renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, WIDTH, HEIGHT);
+        genFramebuffers(1, &framebuffer);
+        bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+        framebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, renderbuffers[0]);
+        framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, renderbuffers[1]);
+        ASSERT_EQ(checkFramebufferStatus(GL_FRAMEBUFFER), static_cast<GLenum>(GL_FRAMEBUFFER_COMPLETE));
+    }
+
+    void TearDown() override {
+        if (framebuffer) {
+            deleteFramebuffers(1, &framebuffer);
+            deleteRenderbuffers(2, renderbuffers);
+        }
+        if (context != EGL_NO_CONTEXT) {
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            eglDestroyContext(display, context);
+        }
+        if (display != EGL_NO_DISPLAY) {
+            eglTerminate(display);
+        }
+    }
+
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+    GLuint framebuffer = 0;
+    GLuint renderbuffers[2] = {};
+
+    PFNGLGENFRAMEBUFFERSPROC genFramebuffers = nullptr;
+    PFNGLBINDFRAMEBUFFERPROC bindFramebuffer = nullptr;
+    PFNGLDELETEFRAMEBUFFERSPROC deleteFramebuffers = nullptr;
+    PFNGLGENRENDERBUFFERSPROC genRenderbuffers = nullptr;
+    PFNGLBINDRENDERBUFFERPROC bindRenderbuffer = nullptr;
+    PFNGLRENDERBUFFERSTORAGEPROC renderbufferStorage = nullptr;
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC framebufferRenderbuffer = nullptr;
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC checkFramebufferStatus = nullptr;
+    PFNGLDELETERENDERBUFFERSPROC deleteRenderbuffers = nullptr;
+};
+
+TEST_F(CoreSmokeTest, DrawsAMatchFrameWithoutGLErrors) {
+    ASSERT_TRUE(CoreGL::Load(GetEGLProcAddress));
+
+    // Initialize compiles and links both programs and builds the meshes
+    ViewportManager viewports;
+    CameraManager cameras;
+    ResourceManager resources;
+    CoreRenderingPipeline pipeline(viewports, cameras, resources);
+    ASSERT_TRUE(pipeline.Initialize()) << "shader build or buffer setup failed, see the log";
+    pipeline.ConfigureViewports(1, WIDTH, HEIGHT);
+
+    // A headless match: loaded level, enemy tanks and one player
+    GameWorld world;
+    world.Initialize();
+    BatchSettings settings;
+    BatchSimulator::SetUpHeadlessMatch(world, settings);
+    world.Simulate(1.0f / 60.0f);
+
+    SceneDataBuilder builder(world.GetTankHandler(), world.GetLevelHandler(), &world, &world.GetPlayerManager());
+    SceneData scene;
+    builder.BuildEntityData(scene);
+    world.GetLevelHandler().populateTerrainRenderData(scene.terrain);
+    ASSERT_FALSE(scene.tanks.empty());
+
+    // Above the player's start, looking across the level
+    const LevelHandler& level = world.GetLevelHandler();
+    CameraData camera;
+    camera.position = Vector3(static_cast<float>(level.start[0]), 30.0f, static_cast<float>(level.start[1]) - 20.0f);
+    camera.focus = Vector3(static_cast<float>(level.start[0]), 0.0f, static_cast<float>(level.start[1]));
+    scene.cameras.push_back(camera);
+
+    // The UI program draws the player's HUD
+    UIRenderData ui;
+    ui.playerHUDs.push_back(HUDRenderData());
+    ui.numPlayers = 1;
+    ui.gameStarted = true;
+    scene.uiData = &ui;
+    scene.gameStarted = true;
+
+    pipeline.RenderAllPlayerViews(scene);
+    glFinish();
+    EXPECT_EQ(glGetError(), static_cast<GLenum>(GL_NO_ERROR));
+
+    // More than the clear colour reached the target
+    std::vector<unsigned char> pixels(WIDTH * HEIGHT * 4);
+    glReadPixels(0, 0, WIDTH, HEIGHT, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    int drawn = 0;
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        if (pixels[i] != 0 || pixels[i + 1] != 0 || pixels[i + 2] != 51) {
+            drawn++;
+        }
+    }
+    EXPECT_GT(drawn, WIDTH * HEIGHT / 10);
+
+    pipeline.Cleanup();
+    world.Shutdown();
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include "../src/ecs/ArchetypeRegistry.h"
+#include "../src/ecs/Components.h"
+#include <vector>
+
+TEST(ArchetypeRegistryTest, ColumnsStayDenseAcrossArchetypes) {
+    ArchetypeRegistry registry;
+    std::vector<EntityHandle> moving;
+    std::vector<EntityHandle> still;
+    for (int i = 0; i < 3000; i++) {
+        const float f = static_cast<float>(i);
+        moving.push_back(registry.Create(Position{f, 0.0f, 0.0f}, Rotation{0.0f, f, 0.0f}));
+        still.push_back(registry.Create(Position{-f, 0.0f, 0.0f}));
+    }
+    EXPECT_EQ(registry.GetArchetypeCount(), 2u);
+    EXPECT_EQ(registry.Count<Position>(), 6000u);
+    EXPECT_EQ(registry.Count<Rotation>(), 3000u);
+
+    // Drop every other moving entity; the survivors keep their data
+    for (size_t i = 0; i < moving.size(); i += 2) {
+        registry.Destroy(moving[i]);
+    }
+    for (size_t i = 0; i < moving.size(); i++) {
+        if (i % 2 == 0) {
+            EXPECT_FALSE(registry.IsAlive(moving[i]));
+            EXPECT_EQ(registry.Get<Position>(moving[i]), nullptr);
+        } else {
+            ASSERT_NE(registry.Get<Rotation>(moving[i]), nullptr);
+            EXPECT_FLOAT_EQ(registry.Get<Position>(moving[i])->x, static_cast<float>(i));
+            EXPECT_FLOAT_EQ(registry.Get<Rotation>(moving[i])->ry, static_cast<float>(i));
+        }
+    }
+    EXPECT_EQ(registry.Get<Rotation>(still[0]), nullptr);
+
+    // Chunks of the moving archetype are packed: their rows add up to the live count
+    size_t rows = 0;
+    float sum = 0.0f;
+    registry.ForEachChunk<Position, Rotation>([&](size_t count, Position* position, Rotation* rotation) {
+        rows += count;
+        for (size_t i = 0; i < count; i++) {
+            sum += rotation[i].ry - position[i].x;
+        }
+    });
+    EXPECT_EQ(rows, 1500u);
+    EXPECT_FLOAT_EQ(sum, 0.0f);
+
+    // A reused index never revives an old handle
+    const EntityHandle reused = registry.Create(Position{1.0f, 2.0f, 3.0f});
+    const EntityHandle& previous = moving[2998];     // Last index freed
+    EXPECT_EQ(reused.index, previous.index);
+    EXPECT_NE(reused, previous);
+    EXPECT_FALSE(registry.IsAlive(previous));
+    EXPECT_TRUE(registry.IsAlive(reused));
+    registry.Clear();
+    EXPECT_FALSE(registry.IsAlive(reused));
+    EXPECT_EQ(registry.Count<Position>(), 0u);
+}
@@ -0,0 +1,355 @@
+#include <gtest/gtest.h>
+#include "../src/GameWorld.h"
+#include "../src/Tank.h"
+#include "../src/Bullet.h"
+#include "../src/Item.h"
+#include "../src/memory/FrameArena.h"
+#include "../src/rendering/ItemDataExtractor.h"
+#include "../src/rendering/SceneDataBuilder.h"
+#include "../src/simulation/ObservationRasterizer.h"
+#include "../src/simulation/StressScenario.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+// Each GameWorld is a self-contained match; these tests check that two
+// worlds in one process never observe each other's state.
+class GameWorldTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        worldA.Initialize();
+        worldB.Initialize();
+    }
+
+    void TearDown() override {
+        worldA.Shutdown();
+        worldB.Shutdown();
+    }
+
+    GameWorld worldA;
+    GameWorld worldB;
+};
+
+TEST_F(GameWorldTest, EventBuses_AreIndependent) {
+    int soundsA = 0;
+    int soundsB = 0;
+    worldA.GetEventBus().Subscribe<PlaySoundEvent>([&](const PlaySoundEvent&) { soundsA++; });
+    worldB.GetEventBus().Subscribe<PlaySoundEvent>([&](const PlaySoundEvent&) { soundsB++; });
+
+    worldA.GetEventBus().Publish(PlaySoundEvent(3));
+
+    EXPECT_EQ(soundsA, 1);
+    EXPECT_EQ(soundsB, 0);
+}
+
+TEST_F(GameWorldTest, Clocks_AreIndependent) {
+    worldA.Update(0.5f);
+    worldA.Update(0.25f);
+
+    EXPECT_FLOAT_EQ(worldA.GetDeltaTime(), 0.25f);
+    EXPECT_FLOAT_EQ(worldA.GetElapsedTime(), 0.75f);
+    EXPECT_EQ(worldA.GetTickCount(), 2u);
+    EXPECT_EQ(worldB.GetTickCount(), 0u);
+}
+
+TEST_F(GameWorldTest, Levels_AreIndependent) {
+    worldA.GetLevelHandler().Flatten(1);
+    worldB.GetLevelHandler().Flatten(1);
+
+    worldA.GetLevelHandler().SetTerrainHeight(10, 10, 7);
+
+    EXPECT_EQ(worldA.GetLevelHandler().GetTerrainHeight(10, 10), 7);
+    EXPECT_EQ(worldB.GetLevelHandler().GetTerrainHeight(10, 10), 1);
+}
+
+TEST_F(GameWorldTest, Tanks_UseTheirOwnWorld) {
+    Tank* tankA = worldA.CreateTank();
+    ASSERT_NE(tankA, nullptr);
+
+    EXPECT_EQ(tankA->GetGameWorld(), &worldA);
+    EXPECT_EQ(worldA.GetTanks().size(), 1u);
+    EXPECT_TRUE(worldB.GetTanks().empty());
+}
+
+TEST_F(GameWorldTest, Rasterizer_WorldAlignedTerrain) {
+    LevelHandler& level = worldA.GetLevelHandler();
+    level.sizeX = 32;
+    level.sizeZ = 32;
+    level.Flatten(1);
+    level.SetTerrainHeight(17, 16, 3);   // Pixel (row 4, col 5) of an 8x8 view centred on (16, 16)
+
+    RasterSettings settings;
+    settings.resolution = 8;
+    settings.rotateToHeading = false;
+    ObservationRasterizer rasterizer(settings);
+    rasterizer.Prepare(worldA);
+
+    std::vector<uint8_t> view(rasterizer.GetObservationSize());
+    rasterizer.Rasterize(16.0f, 16.0f, 0.0f, nullptr, view.data());
+
+    const uint8_t* terrain = view.data() + rasterizer.GetChannelOffset(ObservationChannel::TERRAIN_HEIGHT);
+    EXPECT_EQ(terrain[4 * 8 + 4], 1 * ObservationRasterizer::HEIGHT_SCALE);
+    EXPECT_EQ(terrain[4 * 8 + 5], 3 * ObservationRasterizer::HEIGHT_SCALE);
+
+    // Far outside the level reads as wall
+    rasterizer.Rasterize(-20.0f, -20.0f, 0.0f, nullptr, view.data());
+    EXPECT_EQ(terrain[0], 255);
+}
+
+TEST_F(GameWorldTest, Rasterizer_RotatesToHeading) {
+    LevelHandler& level = worldA.GetLevelHandler();
+    level.sizeX = 32;
+    level.sizeZ = 32;
+    level.Flatten(1);
+
+    Tank* enemy = worldA.CreateTank();
+    ASSERT_NE(enemy, nullptr);
+    enemy->alive = true;
+    enemy->isPlayer = false;
+    enemy->x = 15.2f;            // Ahead of an observer at (10, 10) facing +x
+    enemy->z = 10.2f;
+
+    RasterSettings settings;
+    settings.resolution = 16;
+    ObservationRasterizer rasterizer(settings);
+    rasterizer.Prepare(worldA);
+
+    std::vector<uint8_t> view(rasterizer.GetObservationSize());
+    rasterizer.Rasterize(10.0f, 10.0f, 0.0f, nullptr, view.data());
+
+    const uint8_t* enemies = view.data() + rasterizer.GetChannelOffset(ObservationChannel::ENEMY_TANKS);
+    int hitRow = -1;
+    int hitCol = -1;
+    for (int i = 0; i < 16 * 16; i++) {
+        if (enemies[i]) {
+            hitRow = i / 16;
+            hitCol = i % 16;
+        }
+    }
+    // 5.2 cells ahead lands 5.2 pixels above the centre row, in the centre column
+    EXPECT_EQ(hitRow, 2);
+    EXPECT_EQ(hitCol, 8);
+}
+
+TEST_F(GameWorldTest, Stress_WalkableCellsAvoidWallsAndSlopes) {
+    LevelHandler& level = worldA.GetLevelHandler();
+    level.Flatten(1);
+    level.SetTerrainHeight(10, 10, 5);   // Wall (the level's highest cell)
+
+    auto cells = StressScenario::FindWalkableCells(level);
+    auto contains = [&](int x, int z) {
+        return std::find(cells.begin(), cells.end(), std::make_pair(x, z)) != cells.end();
+    };
+
+    EXPECT_TRUE(contains(20, 20));
+    EXPECT_FALSE(contains(10, 10));      // The wall itself
+    EXPECT_FALSE(contains(11, 10));      // Next to it
+    EXPECT_FALSE(contains(0, 20));       // Level border
+}
+
+TEST_F(GameWorldTest, Bullets_BatchMatchesPerBulletPath) {
+    worldA.GetLevelHandler().Flatten(0);
+    const Color color(1.0f, 0.0f, 1.0f, 1.0f);
+    Bullet* straight = worldA.CreateBullet(TankIdentity::Enemy(0), 1.0f, TankType::TYPE_RED, TankType::TYPE_GREY,
+                                           0, 0.0f, color, color, 60.0f, 0.25f, 60.0f, 0.0f, 37.0f, 0.0f);
+    Bullet* spiral = worldA.CreateBullet(TankIdentity::Enemy(1), 1.0f, TankType::TYPE_PURPLE, TankType::TYPE_GREY,
+                                         0, 0.5f, color, color, 64.0f, 0.25f, 64.0f, 0.0f, 350.0f, 0.0f);
+    ASSERT_EQ(worldA.GetBulletSystem().GetCount(), 2u);
+
+    // Detached copies run the scalar reference path against the same clock
+    Bullet referenceStraight = *straight;
+    Bullet referenceSpiral = *spiral;
+
+    for (int tick = 0; tick < 30; tick++) {
+        worldA.Simulate(1.0f / 60.0f);
+        referenceStraight.NextFrame();
+        referenceSpiral.NextFrame();
+    }
+
+    EXPECT_NEAR(straight->GetX(), referenceStraight.GetX(), 1e-3f);
+    EXPECT_NEAR(straight->GetZ(), referenceStraight.GetZ(), 1e-3f);
+    EXPECT_NEAR(spiral->GetX(), referenceSpiral.GetX(), 1e-3f);
+    EXPECT_NEAR(spiral->GetZ(), referenceSpiral.GetZ(), 1e-3f);
+    EXPECT_NEAR(spiral->GetRY(), referenceSpiral.GetRY(), 1e-3f);
+    EXPECT_FLOAT_EQ(spiral->GetAngularVelocity(), 160.0f);   // 320 * dTpressed, no spin-up unless special
+    EXPECT_FLOAT_EQ(straight->GetDT(), referenceStraight.GetDT());
+}
+
+TEST_F(GameWorldTest, Bullets_BounceOffWalls) {
+    LevelHandler& level = worldA.GetLevelHandler();
+    level.Flatten(0);
+    for (int z = 0; z < level.sizeZ; z++) {
+        level.SetTerrainHeight(70, z, 4);
+    }
+    const Color color(1.0f, 0.0f, 0.0f, 1.0f);
+    Bullet* bullet = worldA.CreateBullet(TankIdentity::Enemy(0), 1.0f, TankType::TYPE_RED, TankType::TYPE_GREY,
+                                         2, 0.0f, color, color, 65.5f, 0.25f, 60.5f, 0.0f, 0.0f, 0.0f);
+
+    for (int tick = 0; tick < 20; tick++) {
+        worldA.Simulate(1.0f / 60.0f);
+    }
+
+    // Reflected off the wall at x = 70 and heading back along -x
+    ASSERT_EQ(worldA.GetBullets().size(), 1u);
+    EXPECT_TRUE(bullet->IsAlive());
+    EXPECT_LT(bullet->GetX(), 70.0f);
+    EXPECT_FLOAT_EQ(bullet->GetRY(), 180.0f);
+}
+
+TEST_F(GameWorldTest, Particles_JumpTrailSinksToTheGround) {
+    LevelHandler& level = worldA.GetLevelHandler();
+    level.Flatten(0);
+    level.SetTerrainHeight(20, 20, 3);
+
+    // One above open ground, one inside a wall column
+    worldA.CreateFX(FxType::TYPE_JUMP, 10.5f, 0.5f, 10.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+    worldA.CreateFX(FxType::TYPE_JUMP, 20.5f, 2.5f, 20.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+    for (int tick = 0; tick < 6; tick++) {
+        worldA.Update(1.0f / 60.0f);
+    }
+
+    const ParticlePool& jump = worldA.GetParticles().GetPool(FxType::TYPE_JUMP);
+    ASSERT_EQ(jump.GetCount(), 2u);
+    EXPECT_NEAR(jump.Get(0).y, 0.0f, 1e-4f);
+    EXPECT_NEAR(jump.Get(0).color.r, 0.95f, 1e-4f);
+    EXPECT_FLOAT_EQ(jump.Get(1).y, 2.5f);
+    EXPECT_FLOAT_EQ(jump.Get(1).color.r, 1.0f);
+}
+
+TEST_F(GameWorldTest, Items_LiveInTheRegistry) {
+    worldA.GetLevelHandler().Flatten(0);
+    Item red = worldA.CreateItem(10.0f, 0.5f, 12.0f, TankType::TYPE_RED);
+    worldA.CreateItem(20.0f, 0.5f, 22.0f, TankType::TYPE_BLUE);
+    ASSERT_EQ(worldA.GetItemCount(), 2u);
+
+    for (int tick = 0; tick < 3; tick++) {
+        worldA.Update(1.0f / 60.0f);
+    }
+    EXPECT_FLOAT_EQ(red.GetRY(), 3.0f);
+    EXPECT_FLOAT_EQ(red.GetColor().r, 1.0f);
+
+    std::vector<ItemRenderData> rendered = ItemDataExtractor::ExtractRenderData(worldA.GetRegistry());
+    ASSERT_EQ(rendered.size(), 2u);
+    EXPECT_FLOAT_EQ(rendered[0].position.x, 10.0f);
+    EXPECT_EQ(rendered[1].itemType, TankType::TYPE_BLUE);
+
+    // Picked up: hidden at once, gone after the next update
+    red.Kill();
+    EXPECT_FALSE(red.IsAlive());
+    int uncollected = 0;
+    worldA.ForEachItem([&uncollected](Item&) { uncollected++; return true; });
+    EXPECT_EQ(uncollected, 1);
+    EXPECT_EQ(ItemDataExtractor::ExtractRenderData(worldA.GetRegistry()).size(), 1u);
+    worldA.Update(1.0f / 60.0f);
+    EXPECT_EQ(worldA.GetItemCount(), 1u);
+    worldA.ForEachItem([](Item& item) {
+        EXPECT_FLOAT_EQ(item.GetX(), 20.0f);
+        return false;
+    });
+}
+
+TEST_F(GameWorldTest, Tanks_ColdStateLivesInASideRecord) {
+    Tank* first = worldA.CreateTank();
+
+    // Costs and wall probes live in the cold record, outside the hot block
+    const char* firstBytes = reinterpret_cast<const char*>(first);
+    const char* probes = reinterpret_cast<const char*>(first->Cold().collisionPoints);
+    EXPECT_TRUE(probes < firstBytes || probes >= firstBytes + sizeof(Tank));
+    EXPECT_FLOAT_EQ(first->Cold().fireCost, 10.0f);
+
+    first->Cold().jid = 3;
+    first->SetInputMode(InputMode::MODE_NINTENDO_GC);
+    Tank moved(std::move(*first));
+    EXPECT_EQ(moved.Cold().jid, 3u);
+    EXPECT_EQ(moved.Cold().inputMode, InputMode::MODE_NINTENDO_GC);
+    EXPECT_NE(moved.Cold().inputHandler, nullptr);
+    EXPECT_EQ(moved.Cold().collisionPoints, reinterpret_cast<const float*>(probes));
+    // The move hands the record over instead of allocating a new one
+    EXPECT_FALSE(first->HasColdData());
+    *first = std::move(moved);
+    EXPECT_TRUE(first->HasColdData());
+}
+
+TEST_F(GameWorldTest, Level_RaycastMatchesDensePointProbes) {
+    LevelHandler& level = worldA.GetLevelHandler();
+    ASSERT_TRUE(level.Load("levels/level3@@.txt"));
+    level.SetTerrainHeight(40, 40, 3);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> position(-2.0f, 130.0f);
+    std::uniform_real_distribution<float> height(0.0f, 6.0f);
+    std::uniform_real_distribution<float> offset(-6.0f, 6.0f);
+    const int PROBES = 8192;
+    int hits = 0;
+    for (int i = 0; i < 2000; i++) {
+        const float x0 = position(rng), y0 = height(rng), z0 = position(rng);
+        const float x1 = x0 + offset(rng), y1 = std::max(0.0f, y0 + offset(rng) * 0.5f), z1 = z0 + offset(rng);
+
+        int firstSolid = -1;
+        for (int k = 0; k <= PROBES && firstSolid < 0; k++) {
+            const float s = static_cast<float>(k) / PROBES;
+            if (level.PointCollision(x0 + (x1 - x0) * s, y0 + (y1 - y0) * s, z0 + (z1 - z0) * s)) {
+                firstSolid = k;
+            }
+        }
+
+        LevelRayHit hit;
+        const bool found = level.Raycast(x0, y0, z0, x1, y1, z1, hit);
+        if (firstSolid >= 0) {
+            ASSERT_TRUE(found) << i;
+            EXPECT_LE(hit.time, static_cast<float>(firstSolid) / PROBES + 1e-5f) << i;
+            EXPECT_GE(hit.time, static_cast<float>(firstSolid - 1) / PROBES - 1e-5f) << i;
+            EXPECT_EQ(std::fabs(hit.normalX) + std::fabs(hit.normalY) + std::fabs(hit.normalZ), hit.time > 0.0f ? 1.0f : 0.0f) << i;
+            hits++;
+        } else if (found) {
+            // Only a sliver thinner than the probe spacing may be missed
+            EXPECT_TRUE(level.PointCollision(hit.x, hit.y, hit.z) ||
+                        level.PointCollision(hit.x + (x1 - x0) * 1e-4f, hit.y + (y1 - y0) * 1e-4f, hit.z + (z1 - z0) * 1e-4f)) << i;
+        }
+        EXPECT_EQ(level.LineOfSight(x0, y0, z0, x1, y1, z1), !found);
+    }
+    EXPECT_GT(hits, 200);
+}
+
+TEST_F(GameWorldTest, Bullets_DoNotTunnelAtLowTickRates) {
+    LevelHandler& level = worldA.GetLevelHandler();
+    level.Flatten(0);
+    for (int z = 0; z < level.sizeZ; z++) {
+        level.SetTerrainHeight(70, z, 4);
+    }
+    const Color color(1.0f, 0.0f, 0.0f, 1.0f);
+    // 33 units per second at 5 ticks per second: 6.6 cells per step
+    Bullet* bullet = worldA.CreateBullet(TankIdentity::Enemy(0), 1.0f, TankType::TYPE_RED, TankType::TYPE_GREY,
+                                         2, 0.0f, color, color, 66.5f, 0.25f, 60.5f, 0.0f, 0.0f, 0.0f);
+    // The hit found in the first tick is resolved at the start of the next
+    worldA.Simulate(0.2f);
+    worldA.Simulate(0.2f);
+
+    ASSERT_EQ(worldA.GetBullets().size(), 1u);
+    EXPECT_LT(bullet->GetX(), 70.0f);
+    EXPECT_FLOAT_EQ(bullet->GetRY(), 180.0f);
+}
+
+TEST_F(GameWorldTest, FrameArena_SceneSurvivesTheNextBuild) {
+    SceneDataBuilder builder(worldA.GetTankHandler(), worldA.GetLevelHandler(), &worldA, &worldA.GetPlayerManager());
+    worldA.CreateItem(10.0f, 0.5f, 12.0f, TankType::TYPE_RED);
+
+    SceneData older;
+    builder.BuildEntityData(older);
+    ASSERT_EQ(older.items.size(), 1u);
+    EXPECT_EQ(older.items.get_allocator().GetArena(), &builder.GetFrameArenas().Current());
+
+    // Double buffered: the previous scene is intact while the next is built
+    SceneData newer;
+    worldA.CreateItem(20.0f, 0.5f, 22.0f, TankType::TYPE_BLUE);
+    builder.BuildEntityData(newer);
+    ASSERT_EQ(newer.items.size(), 2u);
+    EXPECT_EQ(older.items.get_allocator().GetArena(), &builder.GetFrameArenas().Previous());
+    EXPECT_FLOAT_EQ(older.items[0].position.x, 10.0f);
+    EXPECT_NE(older.items.data(), newer.items.data());
+
+    // Sphere queries fill the world's arena
+    FrameVector<Entity*> hits = worldA.GetCollisionSystem().CheckSphereCollision(
+        0.0f, 0.0f, 0.0f, 1.0f, CollisionLayer::ALL_TANKS);
+    EXPECT_EQ(hits.get_allocator().GetArena(), &worldA.GetFrameArena());
+}
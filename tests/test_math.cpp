@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include "../src/math.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+TEST(AngleMathTest, SinCosDeg_TracksLibm) {
+    double worstSin = 0.0, worstCos = 0.0;
+    for (float degrees = -1080.0f; degrees <= 1080.0f; degrees += 0.37f) {
+        float s, c;
+        sinCosDeg(degrees, s, c);
+        const double radians = static_cast<double>(degrees) * DTR;
+        worstSin = std::max(worstSin, std::fabs(s - std::sin(radians)));
+        worstCos = std::max(worstCos, std::fabs(c - std::cos(radians)));
+        EXPECT_EQ(s, sinDeg(degrees));
+        EXPECT_EQ(c, cosDeg(degrees));
+    }
+    EXPECT_LT(worstSin, 2e-6);
+    EXPECT_LT(worstCos, 2e-6);
+
+    // Batch lanes and the scalar tail agree bit for bit with the scalar path
+    std::vector<float> degrees, s(103), c(103);
+    for (int i = 0; i < 103; i++) {
+        degrees.push_back(-400.0f + 7.9f * i);
+    }
+    sinCosDegBatch(degrees.data(), s.data(), c.data(), degrees.size());
+    for (size_t i = 0; i < degrees.size(); i++) {
+        float expectedS, expectedC;
+        sinCosDeg(degrees[i], expectedS, expectedC);
+        EXPECT_EQ(s[i], expectedS);
+        EXPECT_EQ(c[i], expectedC);
+    }
+}
+
+TEST(AngleMathTest, Atan2Deg_TracksLibmWithoutSpecialCases) {
+    double worst = 0.0;
+    for (float y = -5.0f; y <= 5.0f; y += 0.25f) {
+        for (float x = -5.0f; x <= 5.0f; x += 0.25f) {
+            if (x == 0.0f && y == 0.0f) {
+                continue;
+            }
+            const double expected = std::atan2(static_cast<double>(y), static_cast<double>(x)) * 180.0 / 3.14159265358979;
+            double error = std::fabs(atan2Deg(y, x) - expected);
+            error = std::min(error, 360.0 - error);   // -180 and 180 are the same heading
+            worst = std::max(worst, error);
+        }
+    }
+    EXPECT_LT(worst, 2e-4);
+    EXPECT_FLOAT_EQ(atan2Deg(1.0f, 0.0f), 90.0f);
+    EXPECT_FLOAT_EQ(atan2Deg(-1.0f, 0.0f), -90.0f);
+    EXPECT_FLOAT_EQ(atan2Deg(0.0f, -1.0f), 180.0f);
+    EXPECT_EQ(atan2Deg(0.0f, 0.0f), 0.0f);
+}
+
+TEST(AngleMathTest, WrapAndInverseSqrt) {
+    EXPECT_FLOAT_EQ(wrapDegrees(-90.0f), 270.0f);
+    EXPECT_FLOAT_EQ(wrapDegrees(725.0f), 5.0f);
+    EXPECT_FLOAT_EQ(wrapDegreesSigned(270.0f), -90.0f);
+    EXPECT_FLOAT_EQ(wrapDegreesSigned(-190.0f), 170.0f);
+    for (float degrees = -2000.0f; degrees < 2000.0f; degrees += 3.3f) {
+        const float wrapped = wrapDegrees(degrees);
+        EXPECT_GE(wrapped, 0.0f);
+        EXPECT_LT(wrapped, 360.0f);
+    }
+
+    for (float value = 1e-4f; value < 1e6f; value *= 1.7f) {
+        const double expected = 1.0 / std::sqrt(static_cast<double>(value));
+        EXPECT_LT(std::fabs(fastInvSqrt(value) - expected) / expected, 1e-5) << value;
+    }
+    EXPECT_EQ(fastSqrt(0.0f), 0.0f);
+    EXPECT_NEAR(fastSqrt(2.25f), 1.5f, 1e-5f);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "../src/GameWorld.h"
+#include "../src/Logger.h"
+#include "../src/memory/AllocationTracker.h"
+#include "../src/memory/FrameArena.h"
+#include "../src/simulation/BatchSimulator.h"
+#include <vector>
+
+// Runs ticks steady-state gameplay ticks of world, one tracker frame each,
+// and fails if any of them made more than maxPerTick heap allocations
+::testing::AssertionResult TicksAllocateAtMost(GameWorld& world, int ticks, uint64_t maxPerTick) {
+    AllocationTracker& tracker = AllocationTracker::Get();
+    tracker.EndFrame();
+    for (int tick = 0; tick < ticks; tick++) {
+        world.Simulate(1.0f / 60.0f);
+        tracker.EndFrame();
+        if (tracker.GetLastFrame().allocations > maxPerTick) {
+            ::testing::AssertionResult result = ::testing::AssertionFailure()
+                << "tick " << tick << " made " << tracker.GetLastFrame().allocations
+                << " allocations (budget " << maxPerTick << "):";
+            for (const auto& scope : tracker.GetFrameScopes()) {
+                result << " " << scope.scope << "=" << scope.counts.allocations;
+            }
+            return result;
+        }
+    }
+    return ::testing::AssertionSuccess();
+}
+
+TEST(AllocationTrackerTest, CountsPerFrameAndScope) {
+    AllocationTracker& tracker = AllocationTracker::Get();
+    ASSERT_TRUE(AllocationTracker::IsAvailable());
+    tracker.SetCallSiteTracking(true);
+    tracker.EndFrame();
+    {
+        AllocationScope scope("tracker test");
+        std::vector<int>* numbers = new std::vector<int>(100);
+        delete numbers;
+    }
+    tracker.EndFrame();
+    tracker.SetCallSiteTracking(false);
+
+    EXPECT_EQ(tracker.GetLastFrame().allocations, 2u);
+    EXPECT_EQ(tracker.GetLastFrame().frees, 2u);
+    EXPECT_EQ(tracker.GetLastFrame().bytes, sizeof(std::vector<int>) + 100 * sizeof(int));
+
+    const auto scopes = tracker.GetFrameScopes();
+    ASSERT_FALSE(scopes.empty());
+    EXPECT_STREQ(scopes[0].scope, "tracker test");
+    EXPECT_EQ(scopes[0].counts.allocations, 2u);
+
+    uint64_t sited = 0;
+    for (const auto& site : tracker.GetFrameCallSites(16)) {
+        sited += site.counts.allocations;
+    }
+    EXPECT_EQ(sited, 2u);
+
+    // The queries above allocated; a frame without any reads zero
+    tracker.EndFrame();
+    tracker.EndFrame();
+    EXPECT_EQ(tracker.GetLastFrame().allocations, 0u);
+}
+
+TEST(AllocationTrackerTest, SteadyStateTicksStayInBudget) {
+    const bool wasLogging = Logger::Get().IsEnabled();
+    Logger::Get().SetEnabled(false);
+
+    GameWorld world;
+    world.Initialize();
+    BatchSettings settings;
+    BatchSimulator::SetUpHeadlessMatch(world, settings);
+    for (int tick = 0; tick < 120; tick++) {
+        world.Simulate(1.0f / 60.0f);
+    }
+
+    // Today's ceiling (particle pools still growing to their working size);
+    // lower it as that goes, down to zero
+    EXPECT_TRUE(TicksAllocateAtMost(world, 240, 16));
+    world.Shutdown();
+    Logger::Get().SetEnabled(wasLogging);
+}
+
+TEST(FrameArenaTest, BumpsOverflowsGrowsAndPoisons) {
+    FrameArena arena(256);
+    arena.SetPoisoning(true);
+    int destroyed = 0;
+    struct Counted {
+        explicit Counted(int* counter) : destroyed(counter) {}
+        ~Counted() { (*destroyed)++; }
+        int* destroyed;
+    };
+
+    // Allocations are aligned and contiguous until the block runs out
+    char* first = static_cast<char*>(arena.Allocate(3, 1));
+    double* second = static_cast<double*>(arena.Allocate(sizeof(double), alignof(double)));
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % alignof(double), 0u);
+    EXPECT_LT(reinterpret_cast<char*>(second) - first, 16);
+    *second = 1.0;
+    arena.New<Counted>(&destroyed);
+
+    FrameVector<int> numbers{ArenaAllocator<int>(&arena)};
+    for (int i = 0; i < 200; i++) {
+        numbers.push_back(i);
+    }
+    EXPECT_EQ(numbers[199], 199);
+    EXPECT_GT(arena.GetStats().overflows, 0u);
+
+    // Reset runs destructors, frees the overflow and grows to the frame's peak
+    const size_t frameBytes = arena.GetUsed();
+    numbers.clear();
+    arena.Reset();
+    EXPECT_EQ(destroyed, 1);
+    EXPECT_EQ(arena.GetStats().framesOverflowed, 1u);
+    EXPECT_GE(arena.GetCapacity(), frameBytes);
+    EXPECT_EQ(arena.GetStats().peakBytes, frameBytes);
+
+    // The same frame now fits, and what it leaves behind is poisoned
+    const unsigned long overflows = arena.GetStats().overflows;
+    FrameVector<int> again{ArenaAllocator<int>(&arena)};
+    for (int i = 0; i < 200; i++) {
+        again.push_back(i);
+    }
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(again.data());
+    EXPECT_EQ(arena.GetStats().overflows, overflows);
+    arena.Reset();
+    EXPECT_EQ(bytes[0], FrameArena::POISON);
+    EXPECT_EQ(bytes[199 * sizeof(int)], FrameArena::POISON);
+}
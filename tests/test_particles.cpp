@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "../src/effects/ParticleSystem.h"
+
+TEST(ParticleSystemTest, MotionAndLifetimeMatchFxRules) {
+    ParticleSystem particles;
+    const Color grey(0.2f, 0.2f, 0.2f, 1.0f);
+    particles.Spawn(FxType::TYPE_SMOKE, 10.0f, 1.0f, 10.0f, 0.0f, 0.01f, 0.0f, 0.0f, 45.0f, 90.0f, grey);
+    particles.Spawn(FxType::TYPE_SMALL_RECTANGLE, 10.0f, 1.0f, 10.0f, 0.0f, 0.0f, 0.0f, 0.0f, 45.0f, 0.0f, grey);
+    particles.Spawn(FxType::TYPE_DEATH, 10.0f, 1.0f, 10.0f, 3.0f, 0.05f, 0.0f, 2.0f, 90.0f, 0.0f, grey);
+
+    const float dT = 1.0f / 60.0f;
+    for (int tick = 0; tick < 10; tick++) {
+        particles.Update(dT);
+    }
+
+    // dy is per 1/60 s frame, dx per second; smoke fades at 2/s, treads at 0.2/s
+    const ParticleView smoke = particles.GetPool(FxType::TYPE_SMOKE).Get(0);
+    EXPECT_NEAR(smoke.y, 1.1f, 1e-4f);
+    EXPECT_NEAR(smoke.color.a, 1.0f - 2.0f * 10 * dT, 1e-4f);
+    const ParticleView tread = particles.GetPool(FxType::TYPE_SMALL_RECTANGLE).Get(0);
+    EXPECT_NEAR(tread.color.a, 1.0f - 0.2f * 10 * dT, 1e-4f);
+    const ParticleView debris = particles.GetPool(FxType::TYPE_DEATH).Get(0);
+    EXPECT_NEAR(debris.x, 10.5f, 1e-4f);
+    EXPECT_NEAR(debris.y, 1.5f, 1e-4f);
+    EXPECT_NEAR(debris.rz, 150.0f * 10 * dT, 1e-3f);
+    EXPECT_NEAR(debris.ry, 110.0f, 1e-3f);    // Steps of 2 degrees keep the heading even
+
+    // Smoke lives 0.3 s, debris 0.4 s, tread marks 2.5 s
+    for (int tick = 0; tick < 9; tick++) {
+        particles.Update(dT);
+    }
+    EXPECT_EQ(particles.GetPool(FxType::TYPE_SMOKE).GetCount(), 0u);
+    EXPECT_EQ(particles.GetPool(FxType::TYPE_DEATH).GetCount(), 1u);
+    EXPECT_EQ(particles.GetCount(), 2u);
+}
+
+TEST(ParticleSystemTest, FullPoolRecyclesOldest) {
+    ParticleSystem particles(100);
+    const Color white(1.0f, 1.0f, 1.0f, 1.0f);
+    for (int i = 0; i < 150; i++) {
+        particles.Spawn(FxType::TYPE_STAR, static_cast<float>(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, white);
+    }
+
+    const ParticlePool& stars = particles.GetPool(FxType::TYPE_STAR);
+    ASSERT_EQ(stars.GetCount(), 100u);
+    EXPECT_FLOAT_EQ(stars.Get(0).x, 50.0f);
+    EXPECT_FLOAT_EQ(stars.Get(99).x, 149.0f);
+
+    particles.Update(0.01f);
+    EXPECT_EQ(stars.GetCount(), 100u);
+    particles.Update(0.3f);
+    EXPECT_EQ(stars.GetCount(), 0u);
+}
+
+TEST(ParticleSystemTest, EmitterRateIsPerSecond) {
+    ParticleEmitter at60(30.0f);
+    ParticleEmitter at144(30.0f);
+    int spawned60 = 0;
+    int spawned144 = 0;
+    for (int tick = 0; tick < 60; tick++) {
+        spawned60 += at60.Advance(1.0f / 60.0f);
+    }
+    for (int tick = 0; tick < 144; tick++) {
+        spawned144 += at144.Advance(1.0f / 144.0f);
+    }
+    EXPECT_NEAR(spawned60, 30, 1);
+    EXPECT_NEAR(spawned144, 30, 1);
+}
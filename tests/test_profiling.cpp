@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include "../src/FramePacer.h"
+#include "../src/GameWorld.h"
+#include "../src/effects/ParticleSystem.h"
+#include "../src/profiling/FrameStats.h"
+#include "../src/profiling/GLCounters.h"
+#include "../src/profiling/QualityGovernor.h"
+#include "../src/rendering/GLStateCache.h"
+#include "../src/rendering/RenderQueue.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+TEST(FrameStatsTest, PercentilesAndStagesOverTheWindow) {
+    FrameStats stats;
+    EXPECT_EQ(stats.Summarize().frames, 0u);
+
+    // 1..100 ms: nearest-rank percentiles are the values themselves
+    for (int ms = 1; ms <= 100; ms++) {
+        stats.AddStageTime("game", 0.25f);
+        stats.AddStageTime("graphics", 1.0f);
+        stats.AddStageTime("game", 0.25f);
+        stats.EndFrame(static_cast<float>(ms));
+    }
+    FrameTimeSummary summary = stats.Summarize();
+    EXPECT_EQ(summary.frames, 100u);
+    EXPECT_FLOAT_EQ(summary.p50Ms, 50.0f);
+    EXPECT_FLOAT_EQ(summary.p95Ms, 95.0f);
+    EXPECT_FLOAT_EQ(summary.p99Ms, 99.0f);
+    EXPECT_FLOAT_EQ(summary.maxMs, 100.0f);
+    EXPECT_FLOAT_EQ(summary.averageMs, 50.5f);
+
+    ASSERT_EQ(stats.GetStageCount(), 2u);
+    EXPECT_STREQ(stats.GetStage(0).name, "game");
+    EXPECT_FLOAT_EQ(stats.GetStage(0).lastMs, 0.5f);
+    EXPECT_FLOAT_EQ(stats.GetStage(1).lastMs, 1.0f);
+    EXPECT_GT(stats.GetStage(1).averageMs, 0.5f);
+
+    // The window rolls: after WINDOW more 2 ms frames the old ones are gone
+    for (size_t i = 0; i < FrameStats::WINDOW; i++) {
+        stats.EndFrame(2.0f);
+    }
+    summary = stats.Summarize();
+    EXPECT_EQ(summary.frames, FrameStats::WINDOW);
+    EXPECT_FLOAT_EQ(summary.maxMs, 2.0f);
+
+    float history[4];
+    stats.EndFrame(7.0f);
+    ASSERT_EQ(stats.CopyHistory(history, 4), 4u);
+    EXPECT_FLOAT_EQ(history[2], 2.0f);
+    EXPECT_FLOAT_EQ(history[3], 7.0f);
+}
+
+namespace {
+    // Queued renderer that draws each packet in one glBegin/glEnd pair
+    class CountingDrawer : public IQueuedRenderer {
+    public:
+        explicit CountingDrawer(RenderSource from) : source(from) {}
+        void DrawPacket(uint32_t) override { GLCounters::Get().Add(GLCall::BEGIN_END); }
+        RenderSource GetRenderSource() const override { return source; }
+
+    private:
+        RenderSource source;
+    };
+}
+
+TEST(GLCountersTest, ChargesQueuedPacketsToTheirRendererAndView) {
+    CountingDrawer terrain(RenderSource::TERRAIN);
+    CountingDrawer bullets(RenderSource::BULLETS);
+    RenderQueue queue;
+    queue.Submit(RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::LIT, 0, 1.0f, 0), &terrain, 0);
+    queue.Submit(RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::LIT, 0, 2.0f, 0), &terrain, 1);
+    queue.Submit(RenderQueue::MakeKey(RenderLayer::TRANSPARENT, DrawState::ADDITIVE, 0, 3.0f, 0), &bullets, 2);
+    queue.Sort();
+
+    GLStateCache& cache = GLStateCache::Get();
+    cache.Invalidate();
+    cache.ResetCounters();
+    GLCounters& counters = GLCounters::Get();
+    counters.BeginFrame();
+    counters.SetView(1);
+    queue.Execute(RenderLayer::OPAQUE, nullptr);
+    queue.Execute(RenderLayer::TRANSPARENT, nullptr);
+    counters.SetView(GLCounters::NO_VIEW);
+
+    EXPECT_EQ(counters.GetSource(RenderSource::TERRAIN).Get(GLCall::BEGIN_END), 2);
+    EXPECT_EQ(counters.GetSource(RenderSource::BULLETS).Get(GLCall::BEGIN_END), 1);
+
+    // The first packet sets the whole LIT state (cull, face, front, blend,
+    // depth mask, texturing); the second finds it set
+    EXPECT_EQ(counters.GetSource(RenderSource::TERRAIN).Get(GLCall::STATE_CHANGE), 6);
+    EXPECT_GT(counters.GetSource(RenderSource::BULLETS).Get(GLCall::STATE_CHANGE), 0);
+
+    // Every call the state cache let through was counted, all inside view 1
+    const GLCallCounts frame = counters.GetFrame();
+    EXPECT_EQ(static_cast<uint64_t>(frame.Get(GLCall::STATE_CHANGE) + frame.Get(GLCall::TEXTURE_BIND)),
+              cache.GetCounters().issued);
+    EXPECT_EQ(counters.GetView(1).Total(), frame.Total());
+    EXPECT_EQ(counters.GetView(0).Total(), 0);
+
+    // The report averages over the frames recorded while it was asked for
+    counters.SetReportPath("unused.json");
+    counters.EndFrame();
+    counters.EndFrame();
+    EXPECT_EQ(counters.GetReportFrames(), 2u);
+
+    std::FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    counters.WriteJson(file);
+    std::rewind(file);
+    std::string json;
+    char buffer[256];
+    while (std::fgets(buffer, sizeof(buffer), file)) {
+        json += buffer;
+    }
+    std::fclose(file);
+    EXPECT_NE(json.find("\"terrain\": {\"drawCalls\": 0.00, \"beginEnd\": 2.00"), std::string::npos) << json;
+    EXPECT_NE(json.find("\"frames\": 2"), std::string::npos);
+
+    counters.SetReportPath("");
+    counters.BeginFrame();
+    cache.Invalidate();
+    cache.ResetCounters();
+}
+
+TEST(QualityGovernorTest, StepsDownAtOnceAndRecoversOnlyAfterSustainedHeadroom) {
+    QualityGovernor governor;
+    auto feed = [&](float ms) {
+        bool changed = false;
+        for (size_t i = 0; i < QualityGovernor::EVALUATE_INTERVAL; i++) {
+            changed = governor.AddFrame(ms);
+        }
+        return changed;
+    };
+
+    // No target: never governs
+    EXPECT_FALSE(feed(100.0f));
+    EXPECT_EQ(governor.GetLevel(), 0);
+
+    governor.SetTargetFrameMs(10.0f);
+    EXPECT_TRUE(feed(15.0f));
+    EXPECT_EQ(governor.GetLevel(), 1);
+    EXPECT_LT(governor.GetBudget().maxParticlesPerType, QualityGovernor::GetLevelBudget(0).maxParticlesPerType);
+    EXPECT_GT(governor.GetBudget().terrainDrawDistance, 0.0f);
+
+    // A few slow frames inside a window do not count
+    for (size_t i = 0; i < QualityGovernor::EVALUATE_INTERVAL; i++) {
+        governor.AddFrame(i < 2 ? 50.0f : 5.0f);
+    }
+    EXPECT_EQ(governor.GetLevel(), 1);
+
+    // Just under budget holds the level; headroom must last
+    EXPECT_FALSE(feed(9.0f));
+    for (int i = 1; i < QualityGovernor::RECOVER_EVALUATIONS; i++) {
+        EXPECT_FALSE(feed(5.0f));
+    }
+    EXPECT_EQ(governor.GetLevel(), 1);
+    EXPECT_TRUE(feed(5.0f));
+    EXPECT_EQ(governor.GetLevel(), 0);
+
+    governor.SetLevel(QualityGovernor::LEVEL_COUNT - 1);
+    EXPECT_GT(governor.GetBudget().aiDecisionInterval, 1);
+    EXPECT_LT(governor.GetBudget().particleSpawnScale, 1.0f);
+}
+
+TEST(QualityGovernorTest, WorldsKeepFullQualityUntilHandedABudget) {
+    // The interactive governor running slow does not reach other worlds
+    QualityGovernor::Get().SetLevel(QualityGovernor::LEVEL_COUNT - 1);
+    GameWorld world;
+    EXPECT_EQ(world.GetQualityBudget().aiDecisionInterval, 1);
+    EXPECT_EQ(world.GetQualityBudget().maxParticlesPerType, QualityGovernor::GetLevelBudget(0).maxParticlesPerType);
+    QualityGovernor::Get().SetLevel(0);
+
+    // A handed-down budget caps the world's particles
+    world.SetQualityBudget(QualityGovernor::GetLevelBudget(QualityGovernor::LEVEL_COUNT - 1));
+    const size_t limit = world.GetQualityBudget().maxParticlesPerType;
+    for (size_t i = 0; i < limit + 10; i++) {
+        world.CreateFX(FxType::TYPE_STAR, static_cast<float>(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+    }
+    const ParticlePool& stars = world.GetParticles().GetPool(FxType::TYPE_STAR);
+    EXPECT_EQ(stars.GetCount(), limit);
+    EXPECT_FLOAT_EQ(stars.Get(0).x, 0.0f);
+
+    ParticleEmitter smoke(60.0f);
+    EXPECT_EQ(smoke.Advance(1.0f, world.GetQualityBudget().particleSpawnScale), 15);
+}
+
+TEST(FramePacerTest, CappedModeNeverStartsAFrameEarly) {
+    EXPECT_EQ(FramePacer::ModeFromSetting(3), FramePacer::Mode::CAPPED);
+    EXPECT_EQ(FramePacer::ModeFromSetting(7), FramePacer::Mode::VSYNC);
+
+    // 250 FPS: ten waits after the schedule starts span at least 40 ms
+    FramePacer pacer;
+    pacer.Configure(FramePacer::Mode::CAPPED, 250.0f);
+    pacer.WaitForNextFrame();
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; i++) {
+        pacer.WaitForNextFrame();
+    }
+    const float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(elapsedMs, 39.0f);
+    EXPECT_GE(pacer.GetSpinMarginMs(), FramePacer::MIN_SPIN_MARGIN_MS);
+    EXPECT_LE(pacer.GetSpinMarginMs(), FramePacer::MAX_SPIN_MARGIN_MS);
+
+    // Other modes leave the pace to the swap
+    pacer.Configure(FramePacer::Mode::UNCAPPED, 250.0f);
+    const auto uncapped = std::chrono::steady_clock::now();
+    for (int i = 0; i < 10; i++) {
+        pacer.WaitForNextFrame();
+    }
+    const float uncappedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - uncapped).count();
+    EXPECT_LT(uncappedMs, 5.0f);
+}
@@ -0,0 +1,322 @@
+#include <gtest/gtest.h>
+#include "../src/rendering/DynamicResolution.h"
+#include "../src/rendering/EnemyTankGeometry.h"
+#include "../src/rendering/Frustum.h"
+#include "../src/rendering/GLStateCache.h"
+#include "../src/rendering/RenderData.h"
+#include "../src/rendering/RenderList.h"
+#include "../src/rendering/RenderQueue.h"
+#include "../src/rendering/ViewportManager.h"
+#include "../src/rendering/core/CoreGeometry.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+TEST(CoreGeometryTest, MatricesMatchFixedFunctionConventions) {
+    // The camera focus lands in the middle of the view, in front of it
+    const Mat4 viewProjection = Mat4::Perspective(45.0f, 4.0f / 3.0f, 0.1f, 1000.0f) *
+                                Mat4::LookAt(Vector3(5.0f, 8.0f, 5.0f), Vector3(10.0f, 0.0f, 12.0f), Vector3(0.0f, 1.0f, 0.0f));
+    float clip[4];
+    viewProjection.TransformPoint(Vector3(10.0f, 0.0f, 12.0f), clip);
+    ASSERT_GT(clip[3], 0.0f);
+    EXPECT_NEAR(clip[0] / clip[3], 0.0f, 1e-4f);
+    EXPECT_NEAR(clip[1] / clip[3], 0.0f, 1e-4f);
+    EXPECT_GT(clip[2] / clip[3], -1.0f);
+    EXPECT_LT(clip[2] / clip[3], 1.0f);
+
+    // Chained calls apply right to left, like glTranslatef then glRotatef
+    Mat4 model = Mat4::Identity();
+    model.Translate(1.0f, 2.0f, 3.0f).Rotate(90.0f, 0.0f, 1.0f, 0.0f).Scale(2.0f, 1.0f, 1.0f);
+    model.TransformPoint(Vector3(1.0f, 0.0f, 0.0f), clip);
+    EXPECT_NEAR(clip[0], 1.0f, 1e-5f);
+    EXPECT_NEAR(clip[1], 2.0f, 1e-5f);
+    EXPECT_NEAR(clip[2], 1.0f, 1e-5f);
+    EXPECT_FLOAT_EQ(clip[3], 1.0f);
+}
+
+TEST(CoreGeometryTest, TerrainFacesWindTowardsTheirNormals) {
+    std::unique_ptr<TerrainRenderData> terrain(new TerrainRenderData());
+    terrain->levelNumber = 1;
+    terrain->sizeX = 4;
+    terrain->sizeZ = 4;
+    terrain->heightMap[1][1] = 2;
+    terrain->heightMap[2][1] = 1;
+    terrain->floatMap[2][2] = 5;
+
+    std::vector<CoreVertex> vertices;
+    CoreMeshBuilder(vertices).AddTerrain(*terrain);
+
+    // 16 tops, 7 height steps (3 along X, 4 along Z), one floating box,
+    // four walls and the ceiling
+    ASSERT_EQ(vertices.size() % 3, 0u);
+    EXPECT_EQ(vertices.size(), static_cast<size_t>((16 + 7 + 6 + 4 + 1) * 6));
+
+    for (size_t i = 0; i < vertices.size(); i += 3) {
+        const float* a = vertices[i].position;
+        const float* b = vertices[i + 1].position;
+        const float* c = vertices[i + 2].position;
+        const float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        const float cross[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+        const float* n = vertices[i].normal;
+        EXPECT_GT(cross[0] * n[0] + cross[1] * n[1] + cross[2] * n[2], 0.0f) << "triangle " << i / 3;
+    }
+}
+
+TEST(EnemyTankGeometryTest, PartsKeepTheLegacyScaleAndExtents) {
+    const int expectedTriangles[EnemyTankGeometry::PART_COUNT] = {12, 12, 8};
+    // x extents after the 0.06 (hull) and 0.1 (block, gun) scales
+    const float expectedMinX[EnemyTankGeometry::PART_COUNT] = {-0.3f, -0.3f, -0.3f};
+    const float expectedMaxX[EnemyTankGeometry::PART_COUNT] = {0.3f, 0.3f, 0.5f};
+
+    for (int part = 0; part < EnemyTankGeometry::PART_COUNT; part++) {
+        const MeshData& mesh = EnemyTankGeometry::Get(static_cast<EnemyTankGeometry::Part>(part));
+        ASSERT_EQ(mesh.triangleCount, expectedTriangles[part]) << "part " << part;
+
+        float minX = 1e9f, maxX = -1e9f;
+        for (int i = 0; i < mesh.triangleCount; i++) {
+            const float* n = mesh.triangles[i].normal;
+            EXPECT_NEAR(n[0] * n[0] + n[1] * n[1] + n[2] * n[2], 1.0f, 1e-4f);
+            for (const float* p : mesh.triangles[i].positions) {
+                minX = std::min(minX, p[0]);
+                maxX = std::max(maxX, p[0]);
+            }
+        }
+        EXPECT_FLOAT_EQ(minX, expectedMinX[part]);
+        EXPECT_FLOAT_EQ(maxX, expectedMaxX[part]);
+    }
+}
+
+TEST(RenderQueueTest, KeysOrderOpaqueByStateThenDepthAndBlendedBackToFront) {
+    // Opaque: state, then texture, then front to back
+    const uint64_t litNear = RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::LIT, 12, 1.0f, 0);
+    const uint64_t litFar = RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::LIT, 12, 50.0f, 0);
+    const uint64_t litOtherTexture = RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::LIT, 16, 0.5f, 0);
+    const uint64_t ccwNear = RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::LIT_CCW, 0, 0.1f, 0);
+    EXPECT_LT(litNear, litFar);
+    EXPECT_LT(litFar, litOtherTexture);
+    EXPECT_LT(litOtherTexture, ccwNear);
+
+    // Blended: after every opaque packet, back to front whatever the state
+    const uint64_t glowFar = RenderQueue::MakeKey(RenderLayer::TRANSPARENT, DrawState::ADDITIVE, 20, 80.0f, 0);
+    const uint64_t glowNear = RenderQueue::MakeKey(RenderLayer::TRANSPARENT, DrawState::ADDITIVE_CULLED, 0, 2.0f, 0);
+    const uint64_t farthestOpaque = RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::CUSTOM, 4095, 1e6f, 0xFFFFF);
+    EXPECT_LT(farthestOpaque, glowFar);
+    EXPECT_LT(glowFar, glowNear);
+
+    // Fields read back from either layout
+    EXPECT_EQ(RenderQueue::GetLayer(glowNear), RenderLayer::TRANSPARENT);
+    EXPECT_EQ(RenderQueue::GetState(glowNear), DrawState::ADDITIVE_CULLED);
+    EXPECT_EQ(RenderQueue::GetTexture(glowFar), 20u);
+    EXPECT_EQ(RenderQueue::GetState(ccwNear), DrawState::LIT_CCW);
+    EXPECT_EQ(RenderQueue::GetTexture(litOtherTexture), 16u);
+}
+
+TEST(RenderQueueTest, RadixSortMatchesStableSortAcrossFrames) {
+    RenderQueue queue;
+    uint32_t seed = 12345;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+
+    // Reused across frames, like the pipeline's per-view queue
+    for (int frame = 0; frame < 3; frame++) {
+        queue.Clear();
+        std::vector<RenderQueue::Packet> expected;
+        const int count = 500 + frame * 300;
+        for (int i = 0; i < count; i++) {
+            const RenderLayer layer = next() % 4 == 0 ? RenderLayer::TRANSPARENT : RenderLayer::OPAQUE;
+            const DrawState state = static_cast<DrawState>(next() % static_cast<uint32_t>(DrawState::COUNT));
+            const uint64_t key = RenderQueue::MakeKey(layer, state, next() % 4, (next() % 20000) * 0.01f, next() % 8);
+            queue.Submit(key, nullptr, static_cast<uint32_t>(i));
+            RenderQueue::Packet packet = {key, nullptr, static_cast<uint32_t>(i)};
+            expected.push_back(packet);
+        }
+
+        queue.Sort();
+        std::stable_sort(expected.begin(), expected.end(),
+            [](const RenderQueue::Packet& a, const RenderQueue::Packet& b) { return a.key < b.key; });
+
+        const std::vector<RenderQueue::Packet>& sorted = queue.GetPackets();
+        ASSERT_EQ(sorted.size(), expected.size());
+        for (size_t i = 0; i < sorted.size(); i++) {
+            ASSERT_EQ(sorted[i].key, expected[i].key) << "frame " << frame << " packet " << i;
+            // LSD passes are stable: equal keys keep their submit order
+            ASSERT_EQ(sorted[i].item, expected[i].item) << "frame " << frame << " packet " << i;
+        }
+    }
+}
+
+TEST(GLStateCacheTest, ElidesNoOpsAndPopsOnlyTheDifferences) {
+    GLStateCache& cache = GLStateCache::Get();
+    cache.Invalidate();
+    cache.ResetCounters();
+
+    cache.Enable(GL_BLEND);
+    cache.Enable(GL_BLEND);
+    cache.BlendFunc(GL_SRC_ALPHA, GL_ONE);
+    cache.BlendFunc(GL_SRC_ALPHA, GL_ONE);
+    cache.BindTexture(7);
+    cache.BindTexture(7);
+    EXPECT_EQ(cache.GetCounters().issued, 3u);
+    EXPECT_EQ(cache.GetCounters().elided, 3u);
+
+    cache.PushState();
+    cache.Disable(GL_BLEND);
+    cache.BlendFunc(GL_ONE, GL_ONE);
+    cache.FrontFace(GL_CCW);
+    EXPECT_EQ(cache.GetCounters().issued, 6u);
+
+    // Blend and its function come back; the texture never changed, and the
+    // front face was unknown at push so it stays unknown
+    cache.PopState();
+    EXPECT_EQ(cache.GetCounters().issued, 8u);
+    cache.Enable(GL_BLEND);
+    cache.BindTexture(7);
+    EXPECT_EQ(cache.GetCounters().issued, 8u);
+    cache.FrontFace(GL_CCW);
+    EXPECT_EQ(cache.GetCounters().issued, 9u);
+
+    // Untracked capabilities always reach GL
+    cache.Enable(GL_FOG);
+    cache.Enable(GL_FOG);
+    EXPECT_EQ(cache.GetCounters().issued, 11u);
+
+    cache.Invalidate();
+    cache.ResetCounters();
+}
+
+TEST(FrustumTest, CullsSpheresAndBoxesOutsideTheView) {
+    // Looking down +z from above the origin
+    const Mat4 viewProjection = Mat4::Perspective(45.0f, 1.0f, 0.1f, 100.0f) *
+                                Mat4::LookAt(Vector3(0.0f, 5.0f, 0.0f), Vector3(0.0f, 5.0f, 10.0f), Vector3(0.0f, 1.0f, 0.0f));
+    Frustum frustum;
+    EXPECT_TRUE(frustum.IntersectsSphere(Vector3(0.0f, 5.0f, -50.0f), 1.0f));
+    frustum.Extract(viewProjection.m);
+
+    EXPECT_TRUE(frustum.IntersectsSphere(Vector3(0.0f, 5.0f, 20.0f), 1.0f));
+    EXPECT_FALSE(frustum.IntersectsSphere(Vector3(0.0f, 5.0f, -5.0f), 1.0f));
+    EXPECT_FALSE(frustum.IntersectsSphere(Vector3(0.0f, 5.0f, 150.0f), 1.0f));
+    EXPECT_FALSE(frustum.IntersectsSphere(Vector3(30.0f, 5.0f, 20.0f), 1.0f));
+    // Just outside the left plane, but the radius reaches in
+    EXPECT_TRUE(frustum.IntersectsSphere(Vector3(9.0f, 5.0f, 20.0f), 2.0f));
+
+    // A terrain chunk under the view and one behind the camera
+    EXPECT_TRUE(frustum.IntersectsBox(Vector3(-8.0f, 0.0f, 16.0f), Vector3(8.0f, 2.0f, 32.0f)));
+    EXPECT_FALSE(frustum.IntersectsBox(Vector3(-8.0f, 0.0f, -32.0f), Vector3(8.0f, 2.0f, -16.0f)));
+    // Straddling the near plane
+    EXPECT_TRUE(frustum.IntersectsBox(Vector3(-1.0f, 4.0f, -1.0f), Vector3(1.0f, 6.0f, 1.0f)));
+}
+
+namespace {
+    struct NullDrawer : IQueuedRenderer {
+        void DrawPacket(uint32_t) override {}
+    };
+}
+
+TEST(RenderListTest, ViewsQueueTheirVisibleObjectsWithTheirOwnDepth) {
+    NullDrawer drawer;
+    RenderList list;
+    list.BeginObject(Vector3(0.0f, 0.0f, 10.0f), 1.0f);
+    list.Add(RenderLayer::OPAQUE, DrawState::LIT, 0, 1, &drawer, 0);
+    list.Add(RenderLayer::TRANSPARENT, DrawState::ADDITIVE, 0, 1, &drawer, 1);
+    list.BeginObject(Vector3(0.0f, 0.0f, -10.0f), 1.0f);
+    list.Add(RenderLayer::OPAQUE, DrawState::LIT, 0, 2, &drawer, 2);
+    ASSERT_EQ(list.GetObjectCount(), 2);
+
+    // Facing +z: only the first object is in view
+    const Mat4 viewProjection = Mat4::Perspective(45.0f, 1.0f, 0.1f, 100.0f) *
+                                Mat4::LookAt(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 1.0f, 0.0f));
+    Frustum frustum;
+    frustum.Extract(viewProjection.m);
+
+    RenderQueue queue;
+    EXPECT_EQ(list.Submit(queue, Vector3(0.0f, 0.0f, 0.0f), frustum), 1);
+    ASSERT_EQ(queue.GetPackets().size(), 2u);
+    const uint64_t opaqueKey = queue.GetPackets()[0].key;
+    EXPECT_EQ(opaqueKey, RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::LIT, 0, 10.0f, 1));
+    EXPECT_EQ(queue.GetPackets()[1].key, RenderQueue::MakeKey(RenderLayer::TRANSPARENT, DrawState::ADDITIVE, 0, 10.0f, 1));
+
+    // Another view of the same list: both objects, depth from its own eye
+    queue.Clear();
+    EXPECT_EQ(list.Submit(queue, Vector3(0.0f, 0.0f, 20.0f), Frustum()), 2);
+    ASSERT_EQ(queue.GetPackets().size(), 3u);
+    EXPECT_EQ(queue.GetPackets()[2].key, RenderQueue::MakeKey(RenderLayer::OPAQUE, DrawState::LIT, 0, 30.0f, 2));
+}
+
+TEST(ViewportManagerTest, LaysOutUpToFourPlayersInQuarters) {
+    ViewportManager viewports;
+    viewports.SetupSplitScreen(4, 800, 600);
+    ASSERT_EQ(viewports.GetNumViewports(), 4);
+    EXPECT_EQ(viewports.GetViewport(0).x, 0);
+    EXPECT_EQ(viewports.GetViewport(0).y, 300);
+    EXPECT_EQ(viewports.GetViewport(1).x, 400);
+    EXPECT_EQ(viewports.GetViewport(1).y, 300);
+    EXPECT_EQ(viewports.GetViewport(2).y, 0);
+    EXPECT_EQ(viewports.GetViewport(3).x, 400);
+    EXPECT_EQ(viewports.GetViewport(3).width, 400);
+    EXPECT_EQ(viewports.GetViewport(3).height, 300);
+
+    viewports.SetupSplitScreen(3, 800, 600);
+    EXPECT_EQ(viewports.GetNumViewports(), 3);
+
+    // Two players keep the halves, more than four are capped
+    viewports.SetupSplitScreen(2, 800, 600);
+    EXPECT_EQ(viewports.GetNumViewports(), 2);
+    EXPECT_EQ(viewports.GetViewport(1).width, 800);
+    viewports.SetupSplitScreen(6, 800, 600);
+    EXPECT_EQ(viewports.GetNumViewports(), static_cast<int>(ViewportManager::MAX_VIEWPORTS));
+}
+
+TEST(DynamicResolutionTest, ScalesDownAtOnceAndClimbsBackInSteps) {
+    DynamicResolution resolution(10.0f, 0.6f);
+    auto feed = [&](float ms) {
+        bool changed = false;
+        for (int i = 0; i < DynamicResolution::ADJUST_INTERVAL; i++) {
+            changed = resolution.AddFrame(ms);
+        }
+        return changed;
+    };
+
+    // Twice the budget halves the pixels, then the minimum holds
+    EXPECT_TRUE(feed(20.0f));
+    EXPECT_NEAR(resolution.GetScale(), 0.7071f, 0.001f);
+    feed(20.0f);
+    EXPECT_FLOAT_EQ(resolution.GetScale(), 0.6f);
+    EXPECT_EQ(resolution.Scale(1280), 768);
+
+    // Just under budget is left alone, well under climbs one step
+    EXPECT_FALSE(feed(9.0f));
+    EXPECT_TRUE(feed(5.0f));
+    EXPECT_NEAR(resolution.GetScale(), 0.65f, 0.001f);
+    for (int i = 0; i < 10; i++) {
+        feed(5.0f);
+    }
+    EXPECT_FLOAT_EQ(resolution.GetScale(), 1.0f);
+
+    DynamicResolution disabled;
+    EXPECT_FALSE(disabled.IsEnabled());
+    for (int i = 0; i < 100; i++) {
+        EXPECT_FALSE(disabled.AddFrame(100.0f));
+    }
+    EXPECT_FLOAT_EQ(disabled.GetScale(), 1.0f);
+}
+
+TEST(ViewportManagerTest, ScaledViewportsTileTheSmallerTarget) {
+    ViewportManager viewports;
+    viewports.SetupSplitScreen(4, 801, 601);
+    int area = 0;
+    for (int i = 0; i < viewports.GetNumViewports(); i++) {
+        const Viewport scaled = viewports.GetViewport(i).Scaled(0.5f);
+        area += scaled.width * scaled.height;
+    }
+    // Half-size quarters tile the target without gaps or overlap
+    EXPECT_EQ(area, 400 * 300);
+
+    const Viewport topRight = viewports.GetViewport(1).Scaled(0.5f);
+    EXPECT_EQ(topRight.x, 200);
+    EXPECT_EQ(topRight.y, 150);
+    EXPECT_EQ(topRight.width, 200);
+    EXPECT_EQ(topRight.height, 150);
+}
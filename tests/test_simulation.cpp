@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+#include "../src/App.h"
+#include "../src/GameWorld.h"
+#include "../src/InputTask.h"
+#include "../src/LevelHandler.h"
+#include "../src/simulation/BatchSimulator.h"
+#include "../src/simulation/InputRecording.h"
+#include "../src/simulation/StressScenario.h"
+#include "../src/simulation/VectorEnv.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+
+TEST(BatchSimulatorTest, ConcurrentMatches_AllComplete) {
+    BatchSettings settings;
+    settings.numThreads = 2;
+    settings.numMatches = 4;
+    settings.maxTicksPerMatch = 120;
+
+    BatchResult result = BatchSimulator(settings).Run();
+
+    EXPECT_EQ(result.matchesCompleted, 4);
+    EXPECT_GT(result.totalTicks, 0u);
+    EXPECT_LE(result.totalTicks, 4u * 120u);
+}
+
+TEST(VectorEnvTest, Step_FillsCallerBuffers) {
+    EnvSettings settings;
+    settings.numWorlds = 3;
+    VectorEnv env(settings);
+    env.Reset(7);
+
+    std::vector<TankAction> actions(3);
+    actions[0].move = 1.0f;
+    actions[1].fire = true;
+    actions[2].rotate = -1.0f;
+    std::vector<float> rewards(3, 99.0f);
+    std::vector<uint8_t> dones(3, 2);
+    std::vector<float> observations(3 * VectorEnv::OBSERVATION_SIZE, -99.0f);
+
+    env.Step(actions.data(), rewards.data(), dones.data());
+    env.Observe(observations.data());
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_LE(rewards[i], 2.0f);
+        EXPECT_LE(dones[i], 1);
+        // Self "alive" feature
+        EXPECT_FLOAT_EQ(observations[i * VectorEnv::OBSERVATION_SIZE + 11], 1.0f);
+    }
+    EXPECT_EQ(env.GetTotalSteps(), 3u);
+}
+
+TEST(VectorEnvTest, ThreadedStep_MatchesSingleThreaded) {
+    EnvSettings settings;
+    settings.numWorlds = 4;
+    VectorEnv serial(settings);
+    settings.numThreads = 2;
+    VectorEnv threaded(settings);
+    serial.Reset(42);
+    threaded.Reset(42);
+
+    std::vector<TankAction> actions(4);
+    for (int i = 0; i < 4; i++) {
+        actions[i].move = 0.25f * i;
+        actions[i].turret = 1.0f;
+        actions[i].fire = (i % 2) == 0;
+    }
+    std::vector<float> rewardsA(4), rewardsB(4);
+    std::vector<uint8_t> donesA(4), donesB(4);
+    std::vector<float> obsA(4 * VectorEnv::OBSERVATION_SIZE), obsB(4 * VectorEnv::OBSERVATION_SIZE);
+
+    for (int step = 0; step < 30; step++) {
+        serial.Step(actions.data(), rewardsA.data(), donesA.data());
+        threaded.Step(actions.data(), rewardsB.data(), donesB.data());
+    }
+    serial.Observe(obsA.data());
+    threaded.Observe(obsB.data());
+
+    EXPECT_EQ(rewardsA, rewardsB);
+    EXPECT_EQ(donesA, donesB);
+    EXPECT_EQ(obsA, obsB);
+}
+
+TEST(VectorEnvTest, Observe_ItemFeaturesFollowTheirOwnRows) {
+    EnvSettings settings;
+    settings.numWorlds = 1;
+    VectorEnv env(settings);
+    env.Reset(5);
+
+    GameWorld& world = env.GetWorld(0);
+    const Tank* tank = world.GetPlayerManager().GetPlayer(0)->GetControlledTank();
+    ASSERT_NE(tank, nullptr);
+
+    // A Position-only row next to the items must not shift their features
+    world.GetRegistry().Create(Position{tank->x + 5.0f, 0.0f, tank->z});
+    world.CreateItem(tank->x, tank->y, tank->z, TankType::TYPE_RED);
+
+    std::vector<float> observation(VectorEnv::OBSERVATION_SIZE);
+    env.Observe(observation.data());
+
+    // The item under the tank is the nearest: local (0, 0), present
+    const float* item = observation.data() + VectorEnv::OBSERVATION_SIZE
+        - VectorEnv::MAX_OBSERVED_ITEMS * VectorEnv::ITEM_FEATURES;
+    EXPECT_NEAR(item[0], 0.0f, 1e-5f);
+    EXPECT_NEAR(item[1], 0.0f, 1e-5f);
+    EXPECT_FLOAT_EQ(item[2], 1.0f);
+}
+
+TEST(VectorEnvTest, EpisodeEnd_RestartsTheSameWorldOnTheLoadedLevel) {
+    EnvSettings settings;
+    settings.numWorlds = 1;
+    settings.maxEpisodeTicks = 2;
+    VectorEnv env(settings);
+    env.Reset(3);
+
+    GameWorld* world = &env.GetWorld(0);
+    LevelHandler& level = world->GetLevelHandler();
+    const int height = level.GetTerrainHeight(20, 20);
+    const size_t tanks = world->GetTanks().size();
+    level.SetTerrainHeight(20, 20, height + 5);
+
+    TankAction action;
+    float reward = 0.0f;
+    uint8_t done = 0;
+    env.Step(&action, &reward, &done);
+    EXPECT_EQ(done, 0);
+    env.Step(&action, &reward, &done);
+    ASSERT_EQ(done, 1);
+
+    // Same world, terrain back as loaded, a fresh agent tank and enemies
+    EXPECT_EQ(&env.GetWorld(0), world);
+    EXPECT_EQ(level.GetTerrainHeight(20, 20), height);
+    EXPECT_EQ(world->GetTanks().size(), tanks);
+    ASSERT_NE(world->GetPlayerManager().GetPlayer(0)->GetControlledTank(), nullptr);
+    EXPECT_TRUE(world->GetPlayerManager().GetPlayer(0)->GetControlledTank()->alive);
+
+    env.Step(&action, &reward, &done);
+    EXPECT_EQ(done, 0);
+}
+
+TEST(InputRecordingTest, HeadlessReplay_MatchesRecordedHashes) {
+    const std::string path = testing::TempDir() + "tankgame_replay_test.bin";
+
+    ReplayHeader header;
+    header.numPlayers = 1;
+    header.inputModes[0] = InputMode::MODE_KEYBOARD_MOUSE;
+    header.hashInterval = 10;
+
+    // The input handlers look for a camera to steer; a bare App has none
+    App::Create();
+
+    // Drive a match through the players' own input handlers and record it
+    GameWorld world;
+    world.Initialize();
+    world.GetPlayerManager().Initialize(&world);
+    InputReplay::SetUpMatch(world, header);
+    InputTask::BeginPlayback(header.initialState);
+
+    InputRecorder recorder;
+    ASSERT_TRUE(recorder.Open(path, header, world));
+    for (int tick = 0; tick < 60; tick++)
+    {
+        InputFrame frame;
+        frame.dT = 1.0f / 60.0f;
+        frame.SetKey(SDL_SCANCODE_W, tick >= 10 && tick < 40);
+        frame.SetKey(SDL_SCANCODE_SPACE, tick == 20);
+        frame.mouseDX = (tick % 7) - 3;
+
+        InputTask::ApplyFrame(frame);
+        recorder.RecordTick(frame);
+        world.Simulate(frame.dT);
+        recorder.AfterTick(world);
+    }
+    recorder.Close();
+    InputTask::EndPlayback();
+    const uint64_t recordedHash = world.ComputeStateHash();
+    world.Shutdown();
+
+    ReplayResult result = InputReplay::RunHeadless(path, true);
+
+    EXPECT_TRUE(result.loaded);
+    EXPECT_EQ(result.ticks, 60u);
+    EXPECT_EQ(result.hashesChecked, 7);   // Tick 0, then every 10 ticks
+    EXPECT_EQ(result.mismatches, 0);
+    EXPECT_NE(recordedHash, 0u);
+    std::remove(path.c_str());
+    App::Destroy();
+}
+
+TEST(StressScenarioTest, Step_KeepsRequestedLoad) {
+    StressSettings settings;
+    settings.ticks = 20;
+    settings.warmupTicks = 5;
+    settings.bulletsPerTank = 2.0f;
+    settings.emittersPerTank = 0.5f;
+
+    StressSample sample = StressScenario(settings).RunStep(8);
+
+    EXPECT_EQ(sample.profile.ticks, 20u);
+    EXPECT_GE(sample.liveTanks, 8.0);
+    EXPECT_GE(sample.liveBullets, 14.0);
+    EXPECT_GT(sample.liveEffects, 0.0);
+    EXPECT_GT(sample.profile.bullets, 0.0);
+}